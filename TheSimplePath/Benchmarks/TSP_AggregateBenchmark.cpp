@@ -0,0 +1,195 @@
+/****************************************************************************
+ * ==> TSP_AggregateBenchmark ----------------------------------------------*
+ ****************************************************************************
+ * Description:  Measures the attribute aggregation kernels and queries,    *
+ *               against the values read one by one from the attributes     *
+ * Contained in: Benchmarks                                                 *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// core classes
+#include "Core\TSP_Atlas.h"
+#include "Core\TSP_Box.h"
+#include "Core\TSP_AttributeKernels.h"
+
+// benchmark
+#include "TSP_Benchmark.h"
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+const std::size_t g_ValueCount        = 10000000;
+const std::size_t g_PageCount         = 100;
+const std::size_t g_ComponentsPerPage = 10000;
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Aggregates attributes one by one, reading each value through the attribute format switch
+*@param attributes - attributes to aggregate
+*@return the aggregate
+*/
+TSP_AttributeKernels::IAggregate AggregateAttributes(const std::vector<TSP_Attribute>& attributes)
+{
+    TSP_AttributeKernels::IAggregate aggregate;
+
+    for each (const auto& attribute in attributes)
+    {
+        if (attribute.GetFormat() == TSP_Attribute::IEFormat::IE_Undefined)
+            continue;
+
+        const double value = attribute.Get(0.0);
+
+        aggregate.m_Min = aggregate.m_Count ? std::min(aggregate.m_Min, value) : value;
+        aggregate.m_Max = aggregate.m_Count ? std::max(aggregate.m_Max, value) : value;
+        aggregate.m_Sum += value;
+        ++aggregate.m_Count;
+    }
+
+    return aggregate;
+}
+//---------------------------------------------------------------------------
+/**
+* Aggregates a dense column with each instruction set supported by the processor
+*@param name - column name
+*@param values - column values
+*@param validity - column validity bitmap
+*/
+template <class T>
+void MeasureKernels(const std::string& name, const std::vector<T>& values, const std::vector<std::uint64_t>& validity)
+{
+    const char* instructionSetNames[] = {"scalar", "SSE4.2", "AVX2"};
+
+    const TSP_AttributeKernels::IEInstructionSet supported = TSP_AttributeKernels::GetSupportedInstructionSet();
+
+    for (std::size_t i = 0; i <= std::size_t(supported); ++i)
+    {
+        TSP_AttributeKernels::SetInstructionSet(TSP_AttributeKernels::IEInstructionSet(i));
+
+        const double duration = TSP_Benchmark::Measure([&]()
+        {
+            TSP_AttributeKernels::IAggregate aggregate;
+
+            TSP_AttributeKernels::Aggregate(values.data(),
+                                            validity.data(),
+                                            values.size(),
+                                           -std::numeric_limits<double>::infinity(),
+                                            std::numeric_limits<double>::infinity(),
+                                            aggregate);
+
+            TSP_Benchmark::Keep(aggregate.m_Sum);
+        });
+
+        TSP_Benchmark::Report(name + " - kernel, " + instructionSetNames[i], duration, values.size() * sizeof(T));
+    }
+
+    TSP_AttributeKernels::SetInstructionSet(supported);
+}
+//---------------------------------------------------------------------------
+int main()
+{
+    std::printf("%zu values, fastest of 5 runs\n", g_ValueCount);
+
+    // the values, one attribute per value, as before the attribute columns
+    {
+        std::vector<TSP_Attribute> attributes(g_ValueCount);
+
+        for (std::size_t i = 0; i < g_ValueCount; ++i)
+            attributes[i].Set(double(i % 1000) * 0.5);
+
+        const double duration = TSP_Benchmark::Measure([&]()
+        {
+            TSP_Benchmark::Keep(AggregateAttributes(attributes).m_Sum);
+        });
+
+        TSP_Benchmark::Report("Double - attribute Get(double)", duration, g_ValueCount * sizeof(double));
+    }
+
+    // the same values, stored in dense columns
+    {
+        std::vector<double>        doubles(g_ValueCount);
+        std::vector<std::int32_t>  ints(g_ValueCount);
+        std::vector<std::uint64_t> validity((g_ValueCount + 63) / 64, ~std::uint64_t(0));
+
+        for (std::size_t i = 0; i < g_ValueCount; ++i)
+        {
+            doubles[i] = double(i % 1000) * 0.5;
+            ints[i]    = std::int32_t(i % 1000);
+        }
+
+        MeasureKernels("Double", doubles, validity);
+        MeasureKernels("Int32",  ints,    validity);
+    }
+
+    // the document query, which reduces the page columns in parallel
+    {
+        std::unique_ptr<TSP_Atlas> pAtlas(new TSP_Atlas(nullptr));
+        std::vector<TSP_Box*>      boxes;
+        boxes.reserve(g_PageCount * g_ComponentsPerPage);
+
+        for (std::size_t i = 0; i < g_PageCount; ++i)
+        {
+            TSP_Page* pPage = pAtlas->CreateAndAddPage(L"Page " + std::to_wstring(i));
+            pPage->Reserve(g_ComponentsPerPage);
+
+            for (std::size_t j = 0; j < g_ComponentsPerPage; ++j)
+            {
+                TSP_Box* pBox = pPage->CreateAndAddBox(L"", L"", L"");
+                pBox->SetAttribute(TSP_Attribute::IEKey::IE_K_Duration, TSP_Attribute(double(j % 1000) * 0.5));
+                boxes.push_back(pBox);
+            }
+        }
+
+        std::printf("%zu pages of %zu components\n", g_PageCount, g_ComponentsPerPage);
+
+        const double componentDuration = TSP_Benchmark::Measure([&]()
+        {
+            double sum = 0.0;
+
+            for each (auto pBox in boxes)
+                sum += pBox->GetAttribute(TSP_Attribute::IEKey::IE_K_Duration).Get(0.0);
+
+            TSP_Benchmark::Keep(sum);
+        });
+
+        TSP_Benchmark::Report("Atlas - component GetAttribute()", componentDuration);
+
+        const double queryDuration = TSP_Benchmark::Measure([&]()
+        {
+            TSP_Benchmark::Keep(pAtlas->Aggregate(TSP_Attribute::IEKey::IE_K_Duration).m_Sum);
+        });
+
+        TSP_Benchmark::Report("Atlas - Aggregate() query", queryDuration);
+    }
+
+    return 0;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,193 @@
+/****************************************************************************
+ * ==> TSP_ArenaBenchmark --------------------------------------------------*
+ ****************************************************************************
+ * Description:  Measures the page components creation, iteration and      *
+ *               destruction, inside the page arena and on the heap         *
+ * Contained in: Benchmarks                                                 *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <memory>
+#include <vector>
+
+// core classes
+#include "Core\TSP_Atlas.h"
+#include "Core\TSP_Box.h"
+#include "Core\TSP_Link.h"
+#include "Core\TSP_Process.h"
+
+// benchmark
+#include "TSP_Benchmark.h"
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+const std::size_t g_ComponentCount = 100000;
+const std::size_t g_RunCount       = 5;
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Gets the name of the component to create, long enough to not fit in the string inline buffer
+*@param index - component index
+*@return the component name
+*/
+std::wstring GetName(std::size_t index)
+{
+    return L"Component name long enough to be allocated - " + std::to_wstring(index);
+}
+//---------------------------------------------------------------------------
+/**
+* Visits the components of a page, as a view or a query would
+*@param components - components to visit
+*@return a value computed from the visited components
+*/
+std::size_t Iterate(const std::vector<TSP_Component*>& components)
+{
+    std::size_t result = 0;
+
+    for each (auto pComponent in components)
+        result += std::size_t(pComponent->GetType()) + pComponent->GetContainerIndex() + pComponent->IsModified();
+
+    return result;
+}
+//---------------------------------------------------------------------------
+/**
+* Creates a component on the heap, without adding it to its page
+*@param pPage - component page
+*@param index - component index
+*@return the component
+*/
+TSP_Component* CreateOnHeap(TSP_Page* pPage, std::size_t index)
+{
+    // 80% of boxes, 10% of links and 10% of processes
+    switch (index % 10)
+    {
+        case 8:  return new TSP_Link(GetName(index), L"", L"", pPage);
+        case 9:  return new TSP_Process(GetName(index), L"", L"", pPage);
+        default: return new TSP_Box(GetName(index), L"", L"", pPage);
+    }
+}
+//---------------------------------------------------------------------------
+/**
+* Creates a component inside the page arena, and adds it to the page
+*@param pPage - component page
+*@param index - component index
+*@return the component
+*/
+TSP_Component* CreateInPage(TSP_Page* pPage, std::size_t index)
+{
+    // 80% of boxes, 10% of links and 10% of processes
+    switch (index % 10)
+    {
+        case 8:  return pPage->CreateAndAddLink(GetName(index), L"", L"");
+        case 9:  return pPage->CreateAndAddProcess(GetName(index), L"", L"");
+        default: return pPage->CreateAndAddBox(GetName(index), L"", L"");
+    }
+}
+//---------------------------------------------------------------------------
+int main()
+{
+    double heapCreate   = 0.0;
+    double heapIterate  = 0.0;
+    double heapDestroy  = 0.0;
+    double arenaCreate  = 0.0;
+    double arenaIterate = 0.0;
+    double arenaDestroy = 0.0;
+
+    for (std::size_t run = 0; run < g_RunCount; ++run)
+    {
+        // components allocated one by one on the heap, as before the page arenas
+        {
+            std::unique_ptr<TSP_Atlas>  pAtlas(new TSP_Atlas(nullptr));
+            TSP_Page*                   pPage = pAtlas->CreateAndAddPage(L"Heap");
+            std::vector<TSP_Component*> components;
+            components.reserve(g_ComponentCount);
+
+            const double create = TSP_Benchmark::Measure([&]()
+            {
+                for (std::size_t i = 0; i < g_ComponentCount; ++i)
+                    components.push_back(CreateOnHeap(pPage, i));
+            }, 1);
+
+            const double iterate = TSP_Benchmark::Measure([&]()
+            {
+                TSP_Benchmark::Keep(Iterate(components));
+            }, 1);
+
+            const double destroy = TSP_Benchmark::Measure([&]()
+            {
+                for each (auto pComponent in components)
+                    delete pComponent;
+            }, 1);
+
+            heapCreate  = run ? std::min(heapCreate,  create)  : create;
+            heapIterate = run ? std::min(heapIterate, iterate) : iterate;
+            heapDestroy = run ? std::min(heapDestroy, destroy) : destroy;
+        }
+
+        // components allocated inside the page arena, and released in bulk with their page
+        {
+            std::unique_ptr<TSP_Atlas>  pAtlas(new TSP_Atlas(nullptr));
+            TSP_Page*                   pPage = pAtlas->CreateAndAddPage(L"Arena");
+            std::vector<TSP_Component*> components;
+            components.reserve(g_ComponentCount);
+
+            const double create = TSP_Benchmark::Measure([&]()
+            {
+                pPage->Reserve(g_ComponentCount);
+
+                for (std::size_t i = 0; i < g_ComponentCount; ++i)
+                    components.push_back(CreateInPage(pPage, i));
+            }, 1);
+
+            const double iterate = TSP_Benchmark::Measure([&]()
+            {
+                TSP_Benchmark::Keep(Iterate(components));
+            }, 1);
+
+            const double destroy = TSP_Benchmark::Measure([&]()
+            {
+                pAtlas->RemovePage(pPage);
+            }, 1);
+
+            arenaCreate  = run ? std::min(arenaCreate,  create)  : create;
+            arenaIterate = run ? std::min(arenaIterate, iterate) : iterate;
+            arenaDestroy = run ? std::min(arenaDestroy, destroy) : destroy;
+        }
+    }
+
+    std::printf("%zu components, fastest of %zu runs\n", g_ComponentCount, g_RunCount);
+
+    TSP_Benchmark::Report("Heap - create",    heapCreate);
+    TSP_Benchmark::Report("Heap - iterate",   heapIterate);
+    TSP_Benchmark::Report("Heap - destroy",   heapDestroy);
+    TSP_Benchmark::Report("Arena - create",   arenaCreate);
+    TSP_Benchmark::Report("Arena - iterate",  arenaIterate);
+    TSP_Benchmark::Report("Arena - destroy",  arenaDestroy);
+
+    return 0;
+}
+//---------------------------------------------------------------------------
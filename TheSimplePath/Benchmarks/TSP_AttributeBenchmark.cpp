@@ -0,0 +1,180 @@
+/****************************************************************************
+ * ==> TSP_AttributeBenchmark ----------------------------------------------*
+ ****************************************************************************
+ * Description:  Measures the attribute set, get, copy and compare          *
+ *               operations, for each value format                          *
+ * Contained in: Benchmarks                                                 *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+// core classes
+#include "Core\TSP_Attribute.h"
+
+// benchmark
+#include "TSP_Benchmark.h"
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+const std::size_t g_OperationCount = 1000000;
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Measures the operations of an attribute format
+*@param name - format name
+*@param values - 2 different values of the format, set in turn
+*/
+template <class T>
+void Measure(const std::string& name, const T (&values)[2])
+{
+    TSP_Attribute attribute;
+    TSP_Attribute other(values[1]);
+
+    // set a value over the previous one
+    const double setDuration = TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+            attribute.Set(values[i & 1]);
+    });
+
+    TSP_Benchmark::Report(name + " - set",     setDuration);
+
+    // get the value as its own type
+    const double getDuration = TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+            TSP_Benchmark::Keep(attribute.Get(values[i & 1]));
+    });
+
+    TSP_Benchmark::Report(name + " - get",     getDuration);
+
+    // copy another attribute of the same format
+    const double copyDuration = TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+        {
+            attribute = other;
+            TSP_Benchmark::Keep(attribute.GetFormat());
+        }
+    });
+
+    TSP_Benchmark::Report(name + " - copy",    copyDuration);
+
+    TSP_Attribute first(values[0]);
+    TSP_Attribute second(values[1]);
+
+    // compare to an equal, then a different, attribute
+    const double compareDuration = TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+            TSP_Benchmark::Keep(attribute == ((i & 1) ? first : second));
+    });
+
+    TSP_Benchmark::Report(name + " - compare", compareDuration);
+}
+//---------------------------------------------------------------------------
+int main()
+{
+    std::tm first  = {};
+    first.tm_year  = 124;
+    first.tm_mon   = 2;
+    first.tm_mday  = 14;
+
+    std::tm second = first;
+    second.tm_hour = 12;
+
+    const bool          boolValues[]    = {false, true};
+    const std::int8_t   int8Values[]    = {-8, 8};
+    const std::uint8_t  uint8Values[]   = {8, 16};
+    const std::int16_t  int16Values[]   = {-16, 16};
+    const std::uint16_t uint16Values[]  = {16, 32};
+    const std::int32_t  int32Values[]   = {-32, 32};
+    const std::uint32_t uint32Values[]  = {32, 64};
+    const std::int64_t  int64Values[]   = {-64, 64};
+    const std::uint64_t uint64Values[]  = {64, 128};
+    const float         floatValues[]   = {1.5f, 2.5f};
+    const double        doubleValues[]  = {1.25, 2.25};
+    const std::string   stringValues[]  = {"Short", "A string long enough to be allocated on the heap"};
+    const std::wstring  wstringValues[] = {L"Short", L"A string long enough to be allocated on the heap"};
+    const std::tm       timeValues[]    = {first, second};
+
+    std::printf("%zu operations, fastest of 5 runs\n", g_OperationCount);
+
+    Measure("Bool",          boolValues);
+    Measure("Int8",          int8Values);
+    Measure("UInt8",         uint8Values);
+    Measure("Int16",         int16Values);
+    Measure("UInt16",        uint16Values);
+    Measure("Int32",         int32Values);
+    Measure("UInt32",        uint32Values);
+    Measure("Int64",         int64Values);
+    Measure("UInt64",        uint64Values);
+    Measure("Float",         floatValues);
+    Measure("Double",        doubleValues);
+    Measure("String",        stringValues);
+    Measure("UnicodeString", wstringValues);
+    Measure("DateTime",      timeValues);
+
+    const std::wstring formulas[] = {L"duration * resources", L"sum(cost) + 1"};
+    TSP_Attribute      formula;
+    TSP_Attribute      otherFormula;
+    otherFormula.SetFormula(formulas[1]);
+
+    // the formulas are set from their text, and are never read as a value
+    const double setDuration = TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+            formula.SetFormula(formulas[i & 1]);
+    });
+
+    TSP_Benchmark::Report("Formula - set", setDuration);
+
+    const double copyDuration = TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+        {
+            formula = otherFormula;
+            TSP_Benchmark::Keep(formula.GetFormat());
+        }
+    });
+
+    TSP_Benchmark::Report("Formula - copy", copyDuration);
+
+    const double compareDuration = TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+            TSP_Benchmark::Keep(formula == otherFormula);
+    });
+
+    TSP_Benchmark::Report("Formula - compare", compareDuration);
+
+    return 0;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,126 @@
+/****************************************************************************
+ * ==> TSP_Benchmark -------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Benchmark timer and report                                 *
+ * Contained in: Benchmarks                                                 *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+/**
+* Benchmark timer and report
+*@note Each benchmark is a standalone console program, built by its own project against the TSP_Classes
+*      library, which should be run in release mode. The results are written on the standard output
+*@author Jean-Milost Reymond
+*/
+class TSP_Benchmark
+{
+    public:
+        /**
+        * Benchmark task
+        */
+        typedef std::function<void()> ITask;
+
+        /**
+        * Measures a task, which is run several times
+        *@param task - task to measure
+        *@param runCount - number of times the task is run
+        *@return the fastest run duration, in milliseconds
+        */
+        static inline double Measure(const ITask& task, std::size_t runCount = 5);
+
+        /**
+        * Writes a duration on the standard output
+        *@param name - measured task name
+        *@param duration - duration, in milliseconds
+        */
+        static inline void Report(const std::string& name, double duration);
+
+        /**
+        * Writes a duration and the matching throughput on the standard output
+        *@param name - measured task name
+        *@param duration - duration, in milliseconds
+        *@param size - processed data size, in bytes
+        */
+        static inline void Report(const std::string& name, double duration, std::size_t size);
+
+        /**
+        * Keeps a result, so the compiler can't remove the code computing it
+        *@param value - value to keep
+        */
+        template <class T>
+        static inline void Keep(const T& value);
+
+    private:
+        static inline volatile char m_Sink = 0;
+};
+
+//---------------------------------------------------------------------------
+// TSP_Benchmark
+//---------------------------------------------------------------------------
+double TSP_Benchmark::Measure(const ITask& task, std::size_t runCount)
+{
+    double fastest = 0.0;
+
+    for (std::size_t i = 0; i < runCount; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        task();
+
+        const double duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        fastest = i ? std::min(fastest, duration) : duration;
+    }
+
+    return fastest;
+}
+//---------------------------------------------------------------------------
+void TSP_Benchmark::Report(const std::string& name, double duration)
+{
+    std::printf("%-48s %10.3f ms\n", name.c_str(), duration);
+}
+//---------------------------------------------------------------------------
+void TSP_Benchmark::Report(const std::string& name, double duration, std::size_t size)
+{
+    const double throughput = duration > 0.0 ? (double(size) / (1024.0 * 1024.0)) / (duration / 1000.0) : 0.0;
+
+    std::printf("%-48s %10.3f ms %10.1f MB/s\n", name.c_str(), duration, throughput);
+}
+//---------------------------------------------------------------------------
+template <class T>
+void TSP_Benchmark::Keep(const T& value)
+{
+    m_Sink = *reinterpret_cast<const volatile char*>(&value);
+}
+//---------------------------------------------------------------------------
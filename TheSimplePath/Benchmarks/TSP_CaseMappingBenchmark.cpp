@@ -0,0 +1,249 @@
+/****************************************************************************
+ * ==> TSP_CaseMappingBenchmark --------------------------------------------*
+ ****************************************************************************
+ * Description:  Measures the case mapping and folding, for each            *
+ *               instruction set, against the previous locale based mapping *
+ * Contained in: Benchmarks                                                 *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <clocale>
+#include <cctype>
+#include <cwctype>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// common classes
+#include "Common\TSP_StringHelper.h"
+
+// benchmark
+#include "TSP_Benchmark.h"
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+const std::size_t g_TextLength  = 256 * 1024;
+const std::size_t g_ThreadCount = 8;
+const std::size_t g_TitleCount  = 50000;
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Converts a string to lower case, as the previous TSP_StringHelper::ToLowerCase() did
+*@param str - string to convert
+*@return converted string
+*/
+std::string LocaleToLowerCase(const std::string& str)
+{
+    std::string lowerStr;
+
+    // save current locale
+    const std::string loc = TSP_StringHelper::SetLocale_ThreadSafe(LC_ALL, nullptr);
+
+    for each (auto c in str)
+        lowerStr += char(::tolower(c));
+
+    // restore locale
+    TSP_StringHelper::SetLocale_ThreadSafe(LC_ALL, loc.c_str());
+
+    return lowerStr;
+}
+//---------------------------------------------------------------------------
+/**
+* Converts a string to lower case, as the previous TSP_StringHelper::ToLowerCase() did
+*@param str - string to convert
+*@return converted string
+*/
+std::wstring LocaleToLowerCase(const std::wstring& str)
+{
+    std::wstring lowerStr;
+
+    // save current locale
+    const std::string loc = TSP_StringHelper::SetLocale_ThreadSafe(LC_ALL, nullptr);
+
+    for each (auto c in str)
+        lowerStr += wchar_t(::towlower(c));
+
+    // restore locale
+    TSP_StringHelper::SetLocale_ThreadSafe(LC_ALL, loc.c_str());
+
+    return lowerStr;
+}
+//---------------------------------------------------------------------------
+/**
+* Generates a wide text
+*@param asciiPercent - percentage of ASCII chars in the text, the others are Latin, Greek and Cyrillic
+*@param length - text length, in chars
+*@return generated text
+*/
+std::wstring Generate(std::size_t asciiPercent, std::size_t length)
+{
+    const std::wstring ascii    = L"The Quick Brown Fox Jumps Over The Lazy Dog. ";
+    const std::wstring nonAscii = L"\x00C9\x00E9\x00C7\x0391\x03B2\x03A3\x0416\x0436\x0419";
+
+    std::wstring text;
+    text.reserve(length);
+
+    for (std::size_t i = 0; i < length; ++i)
+        if ((i * 37) % 100 < asciiPercent)
+            text += ascii[i % ascii.length()];
+        else
+            text += nonAscii[i % nonAscii.length()];
+
+    return text;
+}
+//---------------------------------------------------------------------------
+/**
+* Measures the case mappings of a text
+*@param name - text name
+*@param text - text to convert
+*/
+void Measure(const std::string& name, const std::wstring& text)
+{
+    const char* instructionSetNames[] = {"scalar", "SSE2", "AVX2"};
+
+    const std::string utf8 = TSP_StringHelper::Utf16ToUtf8(text);
+
+    std::printf("%s - %zu chars, %zu UTF-8 bytes\n", name.c_str(), text.length(), utf8.length());
+
+    // the previous mapping, char by char with the C locale functions
+    TSP_Benchmark::Report("Lower - wide, locale, previous", TSP_Benchmark::Measure([&]()
+    {
+        TSP_Benchmark::Keep(LocaleToLowerCase(text).length());
+    }));
+
+    TSP_Benchmark::Report("Lower - UTF-8, locale, previous", TSP_Benchmark::Measure([&]()
+    {
+        TSP_Benchmark::Keep(LocaleToLowerCase(utf8).length());
+    }));
+
+    const TSP_StringHelper::IEInstructionSet supported = TSP_StringHelper::GetSupportedInstructionSet();
+
+    for (std::size_t i = 0; i <= std::size_t(supported); ++i)
+    {
+        TSP_StringHelper::SetInstructionSet(TSP_StringHelper::IEInstructionSet(i));
+
+        const std::string suffix = std::string(", ") + instructionSetNames[i];
+
+        TSP_Benchmark::Report("Lower - wide, ToLowerCase()" + suffix, TSP_Benchmark::Measure([&]()
+        {
+            TSP_Benchmark::Keep(TSP_StringHelper::ToLowerCase(text).length());
+        }));
+
+        TSP_Benchmark::Report("Lower - wide, ToLowerCase_InPlace()" + suffix, TSP_Benchmark::Measure([&]()
+        {
+            std::wstring str = text;
+            TSP_StringHelper::ToLowerCase_InPlace(str);
+            TSP_Benchmark::Keep(str.length());
+        }));
+
+        TSP_Benchmark::Report("Fold - wide, FoldCase()" + suffix, TSP_Benchmark::Measure([&]()
+        {
+            TSP_Benchmark::Keep(TSP_StringHelper::FoldCase(text).length());
+        }));
+
+        TSP_Benchmark::Report("Lower - UTF-8, ToLowerCase()" + suffix, TSP_Benchmark::Measure([&]()
+        {
+            TSP_Benchmark::Keep(TSP_StringHelper::ToLowerCase(utf8).length());
+        }));
+
+        TSP_Benchmark::Report("Lower - UTF-8, ToLowerCase_InPlace()" + suffix, TSP_Benchmark::Measure([&]()
+        {
+            std::string str = utf8;
+            TSP_StringHelper::ToLowerCase_InPlace(str);
+            TSP_Benchmark::Keep(str.length());
+        }));
+
+        TSP_Benchmark::Report("Fold - UTF-8, FoldCase()" + suffix, TSP_Benchmark::Measure([&]()
+        {
+            TSP_Benchmark::Keep(TSP_StringHelper::FoldCase(utf8).length());
+        }));
+    }
+
+    TSP_StringHelper::SetInstructionSet(supported);
+}
+//---------------------------------------------------------------------------
+/**
+* Maps short titles to lower case from several threads at once
+*@param titles - titles to map
+*@param toLowerCase - case mapping function
+*@return the duration of the fastest run, in milliseconds
+*/
+double MeasureThreads(const std::vector<std::wstring>&                        titles,
+                      const std::function<std::wstring(const std::wstring&)>& toLowerCase)
+{
+    return TSP_Benchmark::Measure([&]()
+    {
+        std::vector<std::thread> threads;
+
+        for (std::size_t i = 0; i < g_ThreadCount; ++i)
+            threads.push_back(std::thread([&]()
+            {
+                std::size_t length = 0;
+
+                for each (const auto& title in titles)
+                    length += toLowerCase(title).length();
+
+                TSP_Benchmark::Keep(length);
+            }));
+
+        for each (auto& thread in threads)
+            thread.join();
+    });
+}
+//---------------------------------------------------------------------------
+int main()
+{
+    std::printf("Fastest of 5 runs\n");
+
+    Measure("ASCII only", Generate(100, g_TextLength));
+    Measure("95% ASCII",  Generate(95,  g_TextLength));
+    Measure("30% ASCII",  Generate(30,  g_TextLength));
+
+    // the short strings, as the page and box titles, mapped concurrently. The previous mapping changed
+    // the global locale under a mutex, so the threads ran one after the other
+    std::vector<std::wstring> titles;
+    titles.reserve(g_TitleCount);
+
+    for (std::size_t i = 0; i < g_TitleCount; ++i)
+        titles.push_back(Generate(95, 16 + i % 32));
+
+    std::printf("%zu threads mapping %zu titles each\n", g_ThreadCount, g_TitleCount);
+
+    TSP_Benchmark::Report("Threads - locale, previous", MeasureThreads(titles, [](const std::wstring& title)
+    {
+        return LocaleToLowerCase(title);
+    }));
+
+    TSP_Benchmark::Report("Threads - ToLowerCase()", MeasureThreads(titles, [](const std::wstring& title)
+    {
+        return TSP_StringHelper::ToLowerCase(title);
+    }));
+
+    return 0;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,326 @@
+/****************************************************************************
+ * ==> TSP_FileBufferBenchmark ---------------------------------------------*
+ ****************************************************************************
+ * Description:  Measures the file buffers write and read throughput,       *
+ *               against the previous char by char read                     *
+ * Contained in: Benchmarks                                                 *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// common classes
+#include "Common\TSP_StdFileBuffer.h"
+#include "Common\TSP_MappedFileBuffer.h"
+
+// benchmark
+#include "TSP_Benchmark.h"
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+const std::size_t g_FileSize  = 100 * 1024 * 1024;
+const std::size_t g_BlockSize = 4096;
+const std::size_t g_RunCount  = 3;
+const std::size_t g_SizeCount = 1000000;
+const char*       g_FileName  = "TSP_FileBufferBenchmark.bin";
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Reads a block char by char, as the previous TSP_StdFileBuffer::Read() did
+*@param pFile - file to read from
+*@param pBuffer - buffer to copy the read data to
+*@param length - length to read, in bytes
+*@return read length, in bytes
+*/
+std::size_t GetcRead(std::FILE* pFile, void* pBuffer, std::size_t length)
+{
+    if (!length)
+        return 0;
+
+    std::vector<std::uint8_t> data(length);
+
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        const std::int32_t c = std::getc(pFile);
+
+        // end of file reached?
+        if (c == EOF)
+        {
+            std::memcpy(pBuffer, data.data(), i);
+            return i;
+        }
+
+        data[i] = std::uint8_t(c);
+    }
+
+    std::memcpy(pBuffer, data.data(), length);
+
+    return length;
+}
+//---------------------------------------------------------------------------
+/**
+* Gets the file size by seeking to its end, as the previous TSP_StdFileBuffer::GetSize() did
+*@param pFile - file to get the size from
+*@return file size, in bytes
+*/
+std::size_t SeekGetSize(std::FILE* pFile)
+{
+    const long curPos = std::ftell(pFile);
+
+    std::fseek(pFile, 0, SEEK_END);
+    const std::size_t fileSize = std::size_t(std::ftell(pFile));
+    std::fseek(pFile, curPos, SEEK_SET);
+
+    return fileSize;
+}
+//---------------------------------------------------------------------------
+/**
+* Reads the benchmark file by blocks with a standard file buffer
+*@param cacheSize - stream cache size, in bytes, 0 for the std library default cache
+*@return true on success, otherwise false
+*/
+bool ReadBlocks(std::size_t cacheSize)
+{
+    TSP_StdFileBuffer file;
+    file.SetCacheSize(cacheSize);
+
+    if (!file.Open(std::string(g_FileName), TSP_FileBuffer::IEMode::IE_M_Read))
+        return false;
+
+    std::uint8_t block[g_BlockSize];
+    std::size_t  total = 0;
+
+    while (const std::size_t read = file.Read(block, g_BlockSize))
+    {
+        TSP_Benchmark::Keep(block[0]);
+        total += read;
+    }
+
+    return total == g_FileSize;
+}
+//---------------------------------------------------------------------------
+int main()
+{
+    std::vector<std::uint8_t> content(g_FileSize);
+
+    for (std::size_t i = 0; i < g_FileSize; ++i)
+        content[i] = std::uint8_t((i * 31) ^ (i >> 8));
+
+    bool success = true;
+
+    std::printf("%zu MB file, %zu bytes blocks, fastest of %zu runs\n", g_FileSize / (1024 * 1024), g_BlockSize, g_RunCount);
+
+    // write the whole content by blocks
+    const double writeDuration = TSP_Benchmark::Measure([&]()
+    {
+        TSP_StdFileBuffer file;
+
+        if (!file.Open(std::string(g_FileName), TSP_FileBuffer::IEMode::IE_M_Write))
+        {
+            success = false;
+            return;
+        }
+
+        for (std::size_t offset = 0; offset < g_FileSize; offset += g_BlockSize)
+            success &= file.Write(&content[offset], g_BlockSize) == g_BlockSize;
+
+        success &= file.Flush();
+    },
+    g_RunCount);
+
+    if (!success)
+    {
+        std::printf("Could not write the benchmark file\n");
+        return -1;
+    }
+
+    TSP_Benchmark::Report("Write blocks - TSP_StdFileBuffer", writeDuration, g_FileSize);
+
+    // the previous read, char by char through a temporary copy
+    const double getcBlockDuration = TSP_Benchmark::Measure([&]()
+    {
+        std::FILE* pFile = std::fopen(g_FileName, "rb");
+
+        if (!pFile)
+        {
+            success = false;
+            return;
+        }
+
+        std::uint8_t block[g_BlockSize];
+        std::size_t  total = 0;
+
+        while (const std::size_t read = GetcRead(pFile, block, g_BlockSize))
+        {
+            TSP_Benchmark::Keep(block[0]);
+            total += read;
+        }
+
+        success &= total == g_FileSize;
+
+        std::fclose(pFile);
+    },
+    g_RunCount);
+
+    TSP_Benchmark::Report("Read blocks - getc, previous", getcBlockDuration, g_FileSize);
+
+    // the block read, with several stream cache sizes
+    const std::size_t cacheSizes[]     = {0, 16 * 1024, TSP_StdFileBuffer::m_DefCacheSize, 1024 * 1024};
+    const char*       cacheSizeNames[] = {"default cache", "16 KB cache", "64 KB cache", "1 MB cache"};
+
+    for (std::size_t i = 0; i < sizeof(cacheSizes) / sizeof(cacheSizes[0]); ++i)
+    {
+        const double duration = TSP_Benchmark::Measure([&]()
+        {
+            success &= ReadBlocks(cacheSizes[i]);
+        },
+        g_RunCount);
+
+        TSP_Benchmark::Report(std::string("Read blocks - TSP_StdFileBuffer, ") + cacheSizeNames[i], duration, g_FileSize);
+    }
+
+    // the whole file at once, as the documents are loaded
+    const double getcWholeDuration = TSP_Benchmark::Measure([&]()
+    {
+        std::FILE* pFile = std::fopen(g_FileName, "rb");
+
+        if (!pFile)
+        {
+            success = false;
+            return;
+        }
+
+        std::string str;
+        str.resize(SeekGetSize(pFile));
+
+        success &= GetcRead(pFile, &str[0], str.length()) == g_FileSize;
+
+        std::fclose(pFile);
+    },
+    g_RunCount);
+
+    TSP_Benchmark::Report("Read whole file - getc, previous", getcWholeDuration, g_FileSize);
+
+    const double stdWholeDuration = TSP_Benchmark::Measure([&]()
+    {
+        TSP_StdFileBuffer file;
+
+        if (!file.Open(std::string(g_FileName), TSP_FileBuffer::IEMode::IE_M_Read))
+        {
+            success = false;
+            return;
+        }
+
+        success &= file.ToStr().length() == g_FileSize;
+    },
+    g_RunCount);
+
+    TSP_Benchmark::Report("Read whole file - TSP_StdFileBuffer::ToStr()", stdWholeDuration, g_FileSize);
+
+    const double mappedWholeDuration = TSP_Benchmark::Measure([&]()
+    {
+        TSP_MappedFileBuffer file;
+
+        if (!file.Open(std::string(g_FileName), TSP_FileBuffer::IEMode::IE_M_Read))
+        {
+            success = false;
+            return;
+        }
+
+        file.Advise(TSP_MappedFileBuffer::IEAccess::IE_A_Sequential);
+
+        success &= file.ToStr().length() == g_FileSize;
+    },
+    g_RunCount);
+
+    TSP_Benchmark::Report("Read whole file - TSP_MappedFileBuffer::ToStr()", mappedWholeDuration, g_FileSize);
+
+    // the mapped data, read in place
+    const double mappedScanDuration = TSP_Benchmark::Measure([&]()
+    {
+        TSP_MappedFileBuffer file;
+
+        if (!file.Open(std::string(g_FileName), TSP_FileBuffer::IEMode::IE_M_Read))
+        {
+            success = false;
+            return;
+        }
+
+        file.Advise(TSP_MappedFileBuffer::IEAccess::IE_A_Sequential);
+
+        const std::uint8_t* pData = static_cast<const std::uint8_t*>(file.GetData());
+              std::uint64_t sum   = 0;
+
+        for (std::size_t i = 0; i < file.GetSize(); i += g_BlockSize)
+            sum += pData[i];
+
+        TSP_Benchmark::Keep(sum);
+    },
+    g_RunCount);
+
+    TSP_Benchmark::Report("Scan in place - TSP_MappedFileBuffer::GetData()", mappedScanDuration, g_FileSize);
+
+    // the file size, which was queried by seeking to the file end
+    {
+        std::FILE* pFile = std::fopen(g_FileName, "rb");
+
+        if (pFile)
+        {
+            TSP_Benchmark::Report("GetSize() - seek, previous", TSP_Benchmark::Measure([&]()
+            {
+                for (std::size_t i = 0; i < g_SizeCount; ++i)
+                    TSP_Benchmark::Keep(SeekGetSize(pFile));
+            }));
+
+            std::fclose(pFile);
+        }
+
+        TSP_StdFileBuffer file;
+
+        if (file.Open(std::string(g_FileName), TSP_FileBuffer::IEMode::IE_M_Read))
+            TSP_Benchmark::Report("GetSize() - TSP_StdFileBuffer", TSP_Benchmark::Measure([&]()
+            {
+                for (std::size_t i = 0; i < g_SizeCount; ++i)
+                    TSP_Benchmark::Keep(file.GetSize());
+            }));
+    }
+
+    std::remove(g_FileName);
+
+    if (!success)
+    {
+        std::printf("Could not read the benchmark file\n");
+        return -1;
+    }
+
+    return 0;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,232 @@
+/****************************************************************************
+ * ==> TSP_LoadBenchmark ---------------------------------------------------*
+ ****************************************************************************
+ * Description:  Measures the document loading throughput and peak memory  *
+ * Contained in: Benchmarks                                                 *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <ctime>
+#include <memory>
+#include <string>
+
+// common classes
+#include "Common\TSP_StdFileBuffer.h"
+#include "Common\TSP_StringHelper.h"
+
+// core classes
+#include "Core\TSP_Document.h"
+#include "Core\TSP_Atlas.h"
+#include "Core\TSP_Box.h"
+#include "Core\TSP_Link.h"
+
+// benchmark
+#include "TSP_Benchmark.h"
+
+// system
+#if defined (_WIN32)
+    #include <windows.h>
+    #include <psapi.h>
+
+    #pragma comment(lib, "psapi.lib")
+#else
+    #include <sys/resource.h>
+#endif
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+const std::size_t g_PageCount       = 200;
+const std::size_t g_BoxesPerPage    = 500;
+const std::size_t g_LinksPerPage    = 250;
+const wchar_t*    g_DefaultFileName = L"TSP_LoadBenchmark.tsp";
+//---------------------------------------------------------------------------
+// TSP_BenchmarkDocument
+//---------------------------------------------------------------------------
+/**
+* Document without view
+*@author Jean-Milost Reymond
+*/
+class TSP_BenchmarkDocument : public TSP_Document
+{
+    public:
+        /**
+        * Creates an empty document
+        *@return true on success, otherwise false
+        */
+        virtual bool Create()
+        {
+            Close();
+            SetStatus(IEDocStatus::IE_DS_Opened);
+            return true;
+        }
+};
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Gets the process peak memory
+*@return the process peak resident memory, in bytes, 0 on error
+*/
+std::size_t GetPeakMemory()
+{
+    #if defined (_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+
+        if (!::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters)))
+            return 0;
+
+        return counters.PeakWorkingSetSize;
+    #else
+        rusage usage;
+
+        if (::getrusage(RUSAGE_SELF, &usage))
+            return 0;
+
+        // the peak memory is in bytes on Apple systems, and in kilobytes elsewhere
+        #if defined (__APPLE__)
+            return std::size_t(usage.ru_maxrss);
+        #else
+            return std::size_t(usage.ru_maxrss) * 1024;
+        #endif
+    #endif
+}
+//---------------------------------------------------------------------------
+/**
+* Generates a document, and saves it
+*@param fileName - document file name
+*@return true on success, otherwise false
+*/
+bool Generate(const std::wstring& fileName)
+{
+    TSP_BenchmarkDocument document;
+
+    if (!document.Create())
+        return false;
+
+    TSP_Atlas* pAtlas = document.CreateAndAddAtlas(L"Root atlas");
+
+    std::tm startDate = {};
+    startDate.tm_year = 124;
+    startDate.tm_mday = 1;
+
+    for (std::size_t i = 0; i < g_PageCount; ++i)
+    {
+        TSP_Page* pPage = pAtlas->CreateAndAddPage(L"Page " + std::to_wstring(i));
+        pPage->Reserve(g_BoxesPerPage + g_LinksPerPage);
+
+        for (std::size_t j = 0; j < g_BoxesPerPage; ++j)
+        {
+            TSP_Box* pBox = pPage->CreateAndAddBox(L"Box " + std::to_wstring(j),
+                                                   L"Box description, long enough to be allocated",
+                                                   L"");
+
+            pBox->SetAttribute(TSP_Attribute::IEKey::IE_K_Duration,  TSP_Attribute(double(j % 40) * 0.25));
+            pBox->SetAttribute(TSP_Attribute::IEKey::IE_K_Owner,     TSP_Attribute(std::wstring(L"Owner")));
+            pBox->SetAttribute(TSP_Attribute::IEKey::IE_K_StartDate, TSP_Attribute(startDate));
+        }
+
+        for (std::size_t j = 0; j < g_LinksPerPage; ++j)
+        {
+            TSP_Link* pLink = pPage->CreateAndAddLink(L"Link " + std::to_wstring(j), L"", L"");
+
+            pPage->GetLinkGraph()->SetStart(pLink->GetUID(),
+                                            pPage->GetAt(j * 2)->GetUID(),
+                                            TSP_LinkGraph::IESide::IE_S_Right);
+            pPage->GetLinkGraph()->SetEnd(pLink->GetUID(),
+                                          pPage->GetAt(j * 2 + 1)->GetUID(),
+                                          TSP_LinkGraph::IESide::IE_S_Left);
+        }
+    }
+
+    return document.Save(fileName);
+}
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    std::wstring fileName;
+
+    // an existing document may be loaded, otherwise a document is generated first. NOTE the peak memory
+    // then includes the generated document, so the benchmark should be run again on the generated file
+    // to measure the loading peak memory alone
+    if (argc > 1)
+        fileName = TSP_StringHelper::Utf8ToUtf16(argv[1]);
+    else
+    {
+        fileName = g_DefaultFileName;
+
+        if (!Generate(fileName))
+        {
+            std::printf("Could not generate the document\n");
+            return -1;
+        }
+
+        std::printf("Generated %zu pages of %zu boxes and %zu links - %ls\n",
+                    g_PageCount,
+                    g_BoxesPerPage,
+                    g_LinksPerPage,
+                    g_DefaultFileName);
+    }
+
+    std::size_t fileSize = 0;
+
+    {
+        TSP_StdFileBuffer file;
+
+        if (!file.Open(fileName, TSP_FileBuffer::IEMode::IE_M_Read))
+        {
+            std::printf("Could not open the document\n");
+            return -1;
+        }
+
+        fileSize = file.GetSize();
+    }
+
+    const std::size_t memoryBefore = GetPeakMemory();
+          bool        success      = true;
+
+    const double duration = TSP_Benchmark::Measure([&]()
+    {
+        TSP_BenchmarkDocument document;
+
+        success &= document.Load(fileName);
+    });
+
+    if (!success)
+    {
+        std::printf("Could not load the document\n");
+        return -1;
+    }
+
+    TSP_Benchmark::Report("Load", duration, fileSize);
+
+    std::printf("File size: %.1f MB, peak memory: %.1f MB before loading, %.1f MB after\n",
+                double(fileSize)        / (1024.0 * 1024.0),
+                double(memoryBefore)    / (1024.0 * 1024.0),
+                double(GetPeakMemory()) / (1024.0 * 1024.0));
+
+    return 0;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,170 @@
+/****************************************************************************
+ * ==> TSP_TimeBenchmark ---------------------------------------------------*
+ ****************************************************************************
+ * Description:  Measures the date and time formatting and parsing,         *
+ *               against the previous stream based helpers                  *
+ * Contained in: Benchmarks                                                 *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <ctime>
+#include <iomanip>
+#include <locale>
+#include <sstream>
+#include <string>
+
+// common classes
+#include "Common\TSP_TimeHelper.h"
+
+// benchmark
+#include "TSP_Benchmark.h"
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+const std::size_t g_OperationCount = 100000;
+const char*       g_Format         = "%Y-%m-%dT%H:%M:%S";
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Formats a date and time structure as the previous TSP_TimeHelper::TmToStr() did
+*@param dateTime - date and time structure to format
+*@param format - format to use for the conversion
+*@return string formatted date and time
+*/
+std::string StreamTmToStr(const std::tm& dateTime, const std::string& format)
+{
+    std::ostringstream sstr;
+    sstr.imbue(std::locale(""));
+    sstr << std::put_time(&dateTime, format.c_str());
+    return sstr.str();
+}
+//---------------------------------------------------------------------------
+/**
+* Parses a date and time structure as the previous TSP_TimeHelper::StrToTm() did
+*@param str - string to parse
+*@param format - format to use for the conversion
+*@return date and time structure
+*/
+std::tm StreamStrToTm(const std::string& str, const std::string& format)
+{
+    std::tm dateTime = {};
+
+    std::istringstream ss(str.c_str());
+    ss.imbue(std::locale(""));
+    ss >> std::get_time(&dateTime, format.c_str());
+
+    if (ss.fail())
+        return std::tm() = {};
+
+    return dateTime;
+}
+//---------------------------------------------------------------------------
+int main()
+{
+    const std::time_t start = std::time(nullptr);
+    const std::string format(g_Format);
+
+    std::tm dateTime;
+    TSP_TimeHelper::ToUTCTm(start, dateTime);
+
+    const std::string text = TSP_TimeHelper::TmToStr(dateTime, format);
+
+    std::printf("%zu operations, fastest of 5 runs\n", g_OperationCount);
+
+    TSP_Benchmark::Report("Format - stream, previous", TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+            TSP_Benchmark::Keep(StreamTmToStr(dateTime, format));
+    }));
+
+    TSP_Benchmark::Report("Format - TmToStr()", TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+            TSP_Benchmark::Keep(TSP_TimeHelper::TmToStr(dateTime, format));
+    }));
+
+    TSP_Benchmark::Report("Format - FormatTm(), reused result", TSP_Benchmark::Measure([&]()
+    {
+        std::string result;
+
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+        {
+            result.clear();
+            TSP_TimeHelper::FormatTm(dateTime, format, result);
+            TSP_Benchmark::Keep(result);
+        }
+    }));
+
+    TSP_Benchmark::Report("Parse - stream, previous", TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+            TSP_Benchmark::Keep(StreamStrToTm(text, format));
+    }));
+
+    TSP_Benchmark::Report("Parse - StrToTm()", TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+            TSP_Benchmark::Keep(TSP_TimeHelper::StrToTm(text, format));
+    }));
+
+    TSP_Benchmark::Report("Local time - std::localtime(), previous", TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+        {
+            const std::time_t time = start + std::time_t(i);
+            TSP_Benchmark::Keep(*std::localtime(&time));
+        }
+    }));
+
+    TSP_Benchmark::Report("Local time - ToLocalTm()", TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+        {
+            std::tm localTime;
+            TSP_TimeHelper::ToLocalTm(start + std::time_t(i), localTime);
+            TSP_Benchmark::Keep(localTime);
+        }
+    }));
+
+    TSP_Benchmark::Report("Local time string - previous", TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+        {
+            const std::time_t time = start + std::time_t(i);
+            TSP_Benchmark::Keep(StreamTmToStr(*std::localtime(&time), format));
+        }
+    }));
+
+    TSP_Benchmark::Report("Local time string - LocalTimeToStr()", TSP_Benchmark::Measure([&]()
+    {
+        for (std::size_t i = 0; i < g_OperationCount; ++i)
+            TSP_Benchmark::Keep(TSP_TimeHelper::LocalTimeToStr(start + std::time_t(i), format));
+    }));
+
+    return 0;
+}
+//---------------------------------------------------------------------------
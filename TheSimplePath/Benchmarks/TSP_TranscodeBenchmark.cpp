@@ -0,0 +1,179 @@
+/****************************************************************************
+ * ==> TSP_TranscodeBenchmark ----------------------------------------------*
+ ****************************************************************************
+ * Description:  Measures the UTF-8 and UTF-16 conversions, for each        *
+ *               instruction set, against the previous std::wstring_convert *
+ * Contained in: Benchmarks                                                 *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <codecvt>
+#include <locale>
+#include <string>
+
+// common classes
+#include "Common\TSP_StringHelper.h"
+
+// benchmark
+#include "TSP_Benchmark.h"
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+const std::size_t g_TextSize = 1024 * 1024;
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Converts an UTF-8 string to UTF-16, as the previous TSP_StringHelper::Utf8ToUtf16() did
+*@param str - string to convert
+*@return converted string
+*/
+std::wstring StdUtf8ToUtf16(const std::string& str)
+{
+    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+    return converter.from_bytes(str.c_str());
+}
+//---------------------------------------------------------------------------
+/**
+* Converts an UTF-16 string to UTF-8, as the previous TSP_StringHelper::Utf16ToUtf8() did
+*@param str - string to convert
+*@return converted string
+*/
+std::string StdUtf16ToUtf8(const std::wstring& str)
+{
+    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+    return converter.to_bytes(str.c_str());
+}
+//---------------------------------------------------------------------------
+/**
+* Generates an UTF-8 text
+*@param asciiPercent - percentage of ASCII chars in the text, the others are 2, 3 and 4 bytes long
+*@return generated text, about g_TextSize bytes long
+*/
+std::string Generate(std::size_t asciiPercent)
+{
+    // latin, cyrillic, CJK and emoji chars, encoded in UTF-8
+    const char*       pSequences[] = {"\xC3\xA9", "\xD0\x96", "\xE4\xB8\xAD", "\xF0\x9F\x98\x80"};
+    const std::string ascii        = "The quick brown fox jumps over the lazy dog. ";
+
+    std::string text;
+    text.reserve(g_TextSize + 4);
+
+    for (std::size_t i = 0; text.length() < g_TextSize; ++i)
+        if ((i * 37) % 100 < asciiPercent)
+            text += ascii[i % ascii.length()];
+        else
+            text += pSequences[i % 4];
+
+    return text;
+}
+//---------------------------------------------------------------------------
+/**
+* Measures the conversions of a text
+*@param name - text name
+*@param text - UTF-8 text to convert
+*/
+void Measure(const std::string& name, const std::string& text)
+{
+    const char* instructionSetNames[] = {"scalar", "SSE2", "AVX2"};
+
+    const std::wstring   wide = StdUtf8ToUtf16(text);
+    const std::u16string utf16(wide.begin(), wide.end());
+
+    std::printf("%s - %zu bytes, %zu UTF-16 units\n", name.c_str(), text.length(), utf16.length());
+
+    // the previous conversions, on UTF-16 in wchar_t strings
+    TSP_Benchmark::Report("From UTF-8 - wstring_convert, previous", TSP_Benchmark::Measure([&]()
+    {
+        TSP_Benchmark::Keep(StdUtf8ToUtf16(text).length());
+    }),
+    text.length());
+
+    TSP_Benchmark::Report("To UTF-8 - wstring_convert, previous", TSP_Benchmark::Measure([&]()
+    {
+        TSP_Benchmark::Keep(StdUtf16ToUtf8(wide).length());
+    }),
+    text.length());
+
+    const TSP_StringHelper::IEInstructionSet supported = TSP_StringHelper::GetSupportedInstructionSet();
+
+    // the wchar_t strings contain UTF-32 where wchar_t is 4 bytes long
+    const std::wstring converted = TSP_StringHelper::Utf8ToUtf16(text);
+
+    for (std::size_t i = 0; i <= std::size_t(supported); ++i)
+    {
+        TSP_StringHelper::SetInstructionSet(TSP_StringHelper::IEInstructionSet(i));
+
+        const std::string suffix = std::string(", ") + instructionSetNames[i];
+
+        TSP_Benchmark::Report("From UTF-8 - Utf8ToUtf16()" + suffix, TSP_Benchmark::Measure([&]()
+        {
+            TSP_Benchmark::Keep(TSP_StringHelper::Utf8ToUtf16(text).length());
+        }),
+        text.length());
+
+        TSP_Benchmark::Report("From UTF-8 - Utf8ToUtf16(), wstring" + suffix, TSP_Benchmark::Measure([&]()
+        {
+            std::wstring result;
+            TSP_Benchmark::Keep(TSP_StringHelper::Utf8ToUtf16(text.data(), text.length(), result));
+        }),
+        text.length());
+
+        TSP_Benchmark::Report("From UTF-8 - Utf8ToUtf16(), u16string" + suffix, TSP_Benchmark::Measure([&]()
+        {
+            std::u16string result;
+            TSP_Benchmark::Keep(TSP_StringHelper::Utf8ToUtf16(text.data(), text.length(), result));
+        }),
+        text.length());
+
+        TSP_Benchmark::Report("To UTF-8 - Utf16ToUtf8()" + suffix, TSP_Benchmark::Measure([&]()
+        {
+            TSP_Benchmark::Keep(TSP_StringHelper::Utf16ToUtf8(converted).length());
+        }),
+        text.length());
+
+        TSP_Benchmark::Report("To UTF-8 - Utf16ToUtf8(), char16_t" + suffix, TSP_Benchmark::Measure([&]()
+        {
+            std::string result;
+            TSP_Benchmark::Keep(TSP_StringHelper::Utf16ToUtf8(utf16.data(), utf16.length(), result));
+        }),
+        text.length());
+    }
+
+    TSP_StringHelper::SetInstructionSet(supported);
+}
+//---------------------------------------------------------------------------
+int main()
+{
+    std::printf("Fastest of 5 runs, throughputs are given in UTF-8 bytes\n");
+
+    Measure("ASCII only", Generate(100));
+    Measure("95% ASCII",  Generate(95));
+    Measure("30% ASCII",  Generate(30));
+
+    return 0;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,423 @@
+/****************************************************************************
+ * ==> TSP_ChunkedBuffer ---------------------------------------------------*
+ ****************************************************************************
+ * Description:  Buffer keeping data in memory chunks                       *
+ * Contained in: Common                                                     *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_ChunkedBuffer.h"
+
+// std
+#include <cstring>
+#include <new>
+
+// common classes
+#include "TSP_StringHelper.h"
+
+// system
+#if defined (_WIN32)
+    #ifndef UNICODE
+        #define UNICODE
+    #endif
+
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <climits>
+    #include <fcntl.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+
+    #ifndef IOV_MAX
+        #define IOV_MAX 1024
+    #endif
+#endif
+
+//---------------------------------------------------------------------------
+// TSP_ChunkedBuffer
+//---------------------------------------------------------------------------
+TSP_ChunkedBuffer::TSP_ChunkedBuffer(std::size_t chunkSize) :
+    TSP_Buffer(),
+    m_ChunkSize(chunkSize ? chunkSize : m_DefChunkSize)
+{}
+//---------------------------------------------------------------------------
+TSP_ChunkedBuffer::~TSP_ChunkedBuffer()
+{}
+//---------------------------------------------------------------------------
+void TSP_ChunkedBuffer::Clear()
+{
+    m_Chunks.clear();
+    std::vector<char>().swap(m_Data);
+
+    m_Size   = 0;
+    m_Offset = 0;
+}
+//---------------------------------------------------------------------------
+bool TSP_ChunkedBuffer::Empty()
+{
+    return !m_Size;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_ChunkedBuffer::GetOffset() const
+{
+    return m_Offset;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_ChunkedBuffer::GetSize() const
+{
+    return m_Size;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_ChunkedBuffer::Seek(std::size_t start, std::size_t delta)
+{
+    const std::size_t offset = start + delta;
+
+    // extend the buffer to contain the offset, keep the previous offset if not possible
+    if (offset > m_Size && !Extend(offset))
+        return m_Offset;
+
+    m_Offset = offset;
+
+    return m_Offset;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_ChunkedBuffer::Read(void* pBuffer, std::size_t length)
+{
+    // no destination buffer or nothing to read?
+    if (!pBuffer || m_Offset >= m_Size)
+        return 0;
+
+    // read at most the remaining data
+    if (length > m_Size - m_Offset)
+        length = m_Size - m_Offset;
+
+    char*       pTarget   = static_cast<char*>(pBuffer);
+    std::size_t remaining = length;
+
+    // copy the data chunk by chunk
+    while (remaining)
+    {
+        const std::size_t chunkOffset = m_Offset % m_ChunkSize;
+              std::size_t size        = m_ChunkSize - chunkOffset;
+
+        if (size > remaining)
+            size = remaining;
+
+        std::memcpy(pTarget, m_Chunks[m_Offset / m_ChunkSize].get() + chunkOffset, size);
+
+        pTarget   += size;
+        m_Offset  += size;
+        remaining -= size;
+    }
+
+    return length;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_ChunkedBuffer::Write(const void* pBuffer, std::size_t length)
+{
+    // no source buffer or nothing to write?
+    if (!pBuffer || !length)
+        return 0;
+
+    // allocate the missing chunks, the existing ones are never moved
+    if (!Reserve(m_Offset + length))
+        return 0;
+
+    // the contiguous copy is no longer valid
+    if (!m_Data.empty())
+        std::vector<char>().swap(m_Data);
+
+    const char* pSource   = static_cast<const char*>(pBuffer);
+    std::size_t remaining = length;
+
+    // copy the data chunk by chunk
+    while (remaining)
+    {
+        const std::size_t chunkOffset = m_Offset % m_ChunkSize;
+              std::size_t size        = m_ChunkSize - chunkOffset;
+
+        if (size > remaining)
+            size = remaining;
+
+        std::memcpy(m_Chunks[m_Offset / m_ChunkSize].get() + chunkOffset, pSource, size);
+
+        pSource   += size;
+        m_Offset  += size;
+        remaining -= size;
+    }
+
+    if (m_Offset > m_Size)
+        m_Size = m_Offset;
+
+    return length;
+}
+//---------------------------------------------------------------------------
+std::string TSP_ChunkedBuffer::ToStr()
+{
+    // seek to start
+    Seek(0, 0);
+
+    std::string str;
+    str.resize(m_Size);
+
+    if (m_Size)
+        Read(&str[0], m_Size);
+
+    return str;
+}
+//---------------------------------------------------------------------------
+void TSP_ChunkedBuffer::GetBlocks(IBlocks& blocks) const
+{
+    blocks.clear();
+    blocks.reserve(m_Chunks.size());
+
+    for (std::size_t offset = 0, i = 0; offset < m_Size; offset += m_ChunkSize, ++i)
+    {
+        IBlock block;
+        block.m_pData = m_Chunks[i].get();
+        block.m_Size  = (m_Size - offset < m_ChunkSize) ? (m_Size - offset) : m_ChunkSize;
+
+        blocks.push_back(block);
+    }
+}
+//---------------------------------------------------------------------------
+const void* TSP_ChunkedBuffer::GetData()
+{
+    if (!m_Size)
+        return nullptr;
+
+    // a single chunk is already contiguous
+    if (m_Size <= m_ChunkSize)
+        return m_Chunks[0].get();
+
+    // copy the chunks once, the copy is kept until the buffer is modified
+    if (m_Data.empty())
+    {
+        m_Data.resize(m_Size);
+
+        for (std::size_t offset = 0, i = 0; offset < m_Size; offset += m_ChunkSize, ++i)
+            std::memcpy(&m_Data[offset],
+                        m_Chunks[i].get(),
+                        (m_Size - offset < m_ChunkSize) ? (m_Size - offset) : m_ChunkSize);
+    }
+
+    return m_Data.data();
+}
+//---------------------------------------------------------------------------
+bool TSP_ChunkedBuffer::WriteToFile(const std::wstring&              fileName,
+                                           bool                       sync,
+                                           std::atomic<std::size_t>* pWritten) const
+{
+    return WriteContent(fileName, 0, true, sync, pWritten);
+}
+//---------------------------------------------------------------------------
+bool TSP_ChunkedBuffer::UpdateFile(const std::wstring&              fileName,
+                                         std::uint64_t              offset,
+                                         bool                       sync,
+                                         std::atomic<std::size_t>* pWritten) const
+{
+    return WriteContent(fileName, offset, false, sync, pWritten);
+}
+//---------------------------------------------------------------------------
+bool TSP_ChunkedBuffer::Extend(std::size_t size)
+{
+    if (!Reserve(size))
+        return false;
+
+    // the contiguous copy is no longer valid
+    if (!m_Data.empty())
+        std::vector<char>().swap(m_Data);
+
+    // fill the new part with zeros, chunk by chunk
+    for (std::size_t offset = m_Size; offset < size;)
+    {
+        const std::size_t chunkOffset = offset % m_ChunkSize;
+              std::size_t length      = m_ChunkSize - chunkOffset;
+
+        if (length > size - offset)
+            length = size - offset;
+
+        std::memset(m_Chunks[offset / m_ChunkSize].get() + chunkOffset, 0, length);
+
+        offset += length;
+    }
+
+    m_Size = size;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_ChunkedBuffer::Reserve(std::size_t size)
+{
+    // size overflow?
+    if (size < m_Offset)
+        return false;
+
+    const std::size_t chunkCount = (size / m_ChunkSize) + ((size % m_ChunkSize) ? 1 : 0);
+
+    try
+    {
+        while (m_Chunks.size() < chunkCount)
+            m_Chunks.push_back(std::unique_ptr<char[]>(new char[m_ChunkSize]));
+    }
+    catch (const std::bad_alloc&)
+    {
+        return false;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_ChunkedBuffer::WriteContent(const std::wstring&              fileName,
+                                           std::uint64_t              offset,
+                                           bool                       create,
+                                           bool                       sync,
+                                           std::atomic<std::size_t>* pWritten) const
+{
+    IBlocks blocks;
+    GetBlocks(blocks);
+
+    #if defined (_WIN32)
+        // an updated file may be mapped in memory, e.g. while its content is still read
+        HANDLE hFile = ::CreateFileW(fileName.c_str(),
+                                     GENERIC_WRITE,
+                                     create ? 0             : FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                     nullptr,
+                                     create ? CREATE_ALWAYS : OPEN_EXISTING,
+                                     FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                     nullptr);
+
+        if (hFile == INVALID_HANDLE_VALUE)
+            return false;
+
+        bool success = true;
+
+        if (!create)
+        {
+            LARGE_INTEGER position;
+            position.QuadPart = LONGLONG(offset);
+
+            success = ::SetFilePointerEx(hFile, position, nullptr, FILE_BEGIN) != 0;
+        }
+
+        // the gathered write requires unbuffered, page aligned blocks, so each chunk is written in turn
+        for (std::size_t i = 0; success && i < blocks.size(); ++i)
+        {
+            const char* pData = static_cast<const char*>(blocks[i].m_pData);
+                  DWORD size  = DWORD(blocks[i].m_Size);
+
+            while (size)
+            {
+                DWORD written = 0;
+
+                if (!::WriteFile(hFile, pData, size, &written, nullptr) || !written)
+                {
+                    success = false;
+                    break;
+                }
+
+                pData += written;
+                size  -= written;
+
+                if (pWritten)
+                    *pWritten += written;
+            }
+        }
+
+        if (success && sync)
+            success = ::FlushFileBuffers(hFile) != 0;
+
+        return ::CloseHandle(hFile) && success;
+    #else
+        const int file = create ? ::open(TSP_StringHelper::Utf16ToUtf8(fileName).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) :
+                                  ::open(TSP_StringHelper::Utf16ToUtf8(fileName).c_str(), O_WRONLY);
+
+        if (file < 0)
+            return false;
+
+        if (!create && ::lseek(file, off_t(offset), SEEK_SET) != off_t(offset))
+        {
+            ::close(file);
+            return false;
+        }
+
+        std::vector<iovec> vectors(blocks.size());
+
+        for (std::size_t i = 0; i < blocks.size(); ++i)
+        {
+            vectors[i].iov_base = const_cast<void*>(blocks[i].m_pData);
+            vectors[i].iov_len  = blocks[i].m_Size;
+        }
+
+        // the chunks are written as many at once as the system allows, or by smaller groups to report
+        // the written size regularly
+        const std::size_t maxCount = pWritten ? m_ReportedChunkCount : std::size_t(IOV_MAX);
+              bool        success  = true;
+              std::size_t index    = 0;
+
+        // write the chunks in place
+        while (index < vectors.size())
+        {
+            const int     count   = int((vectors.size() - index < maxCount) ? (vectors.size() - index) : maxCount);
+                  ssize_t written = ::writev(file, &vectors[index], count);
+
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                success = false;
+                break;
+            }
+
+            if (pWritten)
+                *pWritten += std::size_t(written);
+
+            // skip the fully written chunks, and continue the partially written one
+            while (index < vectors.size() && std::size_t(written) >= vectors[index].iov_len)
+            {
+                written -= ssize_t(vectors[index].iov_len);
+                ++index;
+            }
+
+            if (written)
+            {
+                vectors[index].iov_base  = static_cast<char*>(vectors[index].iov_base) + written;
+                vectors[index].iov_len  -= std::size_t(written);
+            }
+        }
+
+        #if defined (__APPLE__)
+            if (success && sync)
+                success = !::fsync(file);
+        #else
+            if (success && sync)
+                success = !::fdatasync(file);
+        #endif
+
+        return !::close(file) && success;
+    #endif
+}
+//---------------------------------------------------------------------------
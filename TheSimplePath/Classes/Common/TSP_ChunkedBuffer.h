@@ -0,0 +1,228 @@
+/****************************************************************************
+ * ==> TSP_ChunkedBuffer ---------------------------------------------------*
+ ****************************************************************************
+ * Description:  Buffer keeping data in memory chunks                       *
+ * Contained in: Common                                                     *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// common classes
+#include "TSP_Buffer.h"
+
+/**
+* Buffer keeping data in a list of fixed size memory chunks. The data are never moved while the
+* buffer grows, and they may be written to a file without being made contiguous first
+*@author Jean-Milost Reymond
+*/
+class TSP_ChunkedBuffer : public TSP_Buffer
+{
+    public:
+        /**
+        * Memory block, a part of the buffer content
+        */
+        struct IBlock
+        {
+            const void* m_pData = nullptr;
+            std::size_t m_Size  = 0;
+        };
+
+        typedef std::vector<IBlock> IBlocks;
+
+        static const std::size_t m_DefChunkSize = 65536;
+
+        // maximum chunk count written at once if the written size is reported
+        static const std::size_t m_ReportedChunkCount = 64;
+
+        /**
+        * Constructor
+        *@param chunkSize - chunk size, in bytes
+        */
+        TSP_ChunkedBuffer(std::size_t chunkSize = m_DefChunkSize);
+
+        /**
+        * Destructor
+        */
+        virtual ~TSP_ChunkedBuffer();
+
+        /**
+        * Clears buffer completely
+        */
+        virtual void Clear();
+
+        /**
+        * Checks if buffer is empty
+        *@return true if buffer is empty, otherwise false
+        */
+        virtual bool Empty();
+
+        /**
+        * Gets current offset position, in bytes
+        *@return current offset position, in bytes
+        */
+        virtual std::size_t GetOffset() const;
+
+        /**
+        * Gets data size, in bytes
+        *@return data size, in bytes
+        */
+        virtual std::size_t GetSize() const;
+
+        /**
+        * Seeks offset
+        *@param start - absolute start offset to seek from
+        *@param delta - number of bytes to seek from start offset, must be positive
+        *@return new offset position
+        *@note The buffer is extended with zeros if the new offset exceeds its size
+        */
+        virtual std::size_t Seek(std::size_t start, std::size_t delta);
+
+        /**
+        * Reads data from buffer
+        *@param pBuffer - destination buffer that will receive the read data
+        *@param length - length to read in source buffer
+        *@return read data length
+        *@note Data will be read from current offset
+        */
+        virtual std::size_t Read(void* pBuffer, std::size_t length);
+
+        /**
+        * Writes data into buffer
+        *@param pBuffer - source buffer to write from
+        *@param length - length to write from source buffer
+        *@return written data length
+        *@note Data will be written from current offset
+        */
+        virtual std::size_t Write(const void* pBuffer, std::size_t length);
+
+        /**
+        * Reads buffer content as string
+        *@return buffer content as string
+        */
+        virtual std::string ToStr();
+
+        /**
+        * Gets the chunk size
+        *@return the chunk size, in bytes
+        */
+        virtual inline std::size_t GetChunkSize() const;
+
+        /**
+        * Gets the buffer content as a list of memory blocks, e.g. to write them at once
+        *@param[out] blocks - memory blocks, in the content order
+        *@note The blocks remain valid until the buffer is cleared or destroyed
+        */
+        virtual void GetBlocks(IBlocks& blocks) const;
+
+        /**
+        * Gets the buffer content as a contiguous memory block
+        *@return the buffer content, GetSize() bytes long, nullptr if the buffer is empty
+        *@note The content is copied in a contiguous block if it spans several chunks, the returned
+        *      block remains valid until the buffer is modified
+        */
+        virtual const void* GetData();
+
+        /**
+        * Writes the buffer content to a file
+        *@param fileName - file name, the file is created or overwritten
+        *@param sync - if true the file content is synchronized on the disk before the file is closed
+        *@param[out] pWritten - if not nullptr, receives the written size while the file is written, in bytes
+        *@return true on success, otherwise false
+        *@note The chunks are written in place, with as few system calls as possible
+        */
+        virtual bool WriteToFile(const std::wstring&              fileName,
+                                       bool                       sync     = false,
+                                       std::atomic<std::size_t>* pWritten = nullptr) const;
+
+        /**
+        * Writes the buffer content in an existing file, at an offset
+        *@param fileName - file name, the file should exist
+        *@param offset - offset at which the content is written, in bytes
+        *@param sync - if true the file content is synchronized on the disk before the file is closed
+        *@param[out] pWritten - if not nullptr, receives the written size while the file is written, in bytes
+        *@return true on success, otherwise false
+        *@note The file content located outside the written part is kept, and the file may be mapped
+        *      in memory meanwhile
+        */
+        virtual bool UpdateFile(const std::wstring&              fileName,
+                                      std::uint64_t              offset,
+                                      bool                       sync,
+                                      std::atomic<std::size_t>* pWritten = nullptr) const;
+
+    private:
+        typedef std::vector<std::unique_ptr<char[]>> IChunks;
+
+        IChunks           m_Chunks;
+        std::vector<char> m_Data;
+        std::size_t       m_ChunkSize = m_DefChunkSize;
+        std::size_t       m_Size      = 0;
+        std::size_t       m_Offset    = 0;
+
+        /**
+        * Extends the buffer with zeros
+        *@param size - new buffer size, in bytes
+        *@return true on success, otherwise false
+        */
+        bool Extend(std::size_t size);
+
+        /**
+        * Allocates the chunks required to contain data
+        *@param size - data size, in bytes
+        *@return true on success, otherwise false
+        */
+        bool Reserve(std::size_t size);
+
+        /**
+        * Writes the buffer content to a file
+        *@param fileName - file name
+        *@param offset - offset at which the content is written, ignored if the file is created
+        *@param create - if true the file is created or overwritten, otherwise it should exist
+        *@param sync - if true the file content is synchronized on the disk before the file is closed
+        *@param[out] pWritten - if not nullptr, receives the written size while the file is written, in bytes
+        *@return true on success, otherwise false
+        */
+        bool WriteContent(const std::wstring&              fileName,
+                                std::uint64_t              offset,
+                                bool                       create,
+                                bool                       sync,
+                                std::atomic<std::size_t>* pWritten) const;
+};
+
+//---------------------------------------------------------------------------
+// TSP_ChunkedBuffer
+//---------------------------------------------------------------------------
+std::size_t TSP_ChunkedBuffer::GetChunkSize() const
+{
+    return m_ChunkSize;
+}
+//---------------------------------------------------------------------------
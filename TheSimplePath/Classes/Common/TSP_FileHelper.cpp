@@ -29,6 +29,9 @@
 
 #include "TSP_FileHelper.h"
 
+// std
+#include <cstdio>
+
 // common classes
 #include "TSP_StringHelper.h"
 #include "TSP_Exception.h"
@@ -45,6 +48,9 @@
 
     #include <windows.h>
     #include <Shlobj.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
 #endif
 
 //---------------------------------------------------------------------------
@@ -200,6 +206,46 @@ bool TSP_FileHelper::FileExists(const std::wstring& name)
     return (_wstat(name.c_str(), &buffer) == 0);
 }
 //---------------------------------------------------------------------------
+bool TSP_FileHelper::RenameFile(const std::wstring& source, const std::wstring& target)
+{
+    #if defined (_WIN32)
+        return ::MoveFileExW(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    #else
+        const std::string targetName = TSP_StringHelper::Utf16ToUtf8(target);
+
+        if (std::rename(TSP_StringHelper::Utf16ToUtf8(source).c_str(), targetName.c_str()))
+            return false;
+
+        std::string dirName = GetFileDir(targetName, false);
+
+        // file contained in the root or in the current dir?
+        if (dirName.empty())
+            dirName = targetName[0] == M_DirDelim ? std::string(1, M_DirDelim) : ".";
+
+        // the renamed entry is only on the disk once its dir is synchronized, otherwise a power
+        // failure could still restore the previous file
+        const int dir = ::open(dirName.c_str(), O_RDONLY | O_DIRECTORY);
+
+        if (dir < 0)
+            return false;
+
+        const bool success = !::fsync(dir);
+
+        ::close(dir);
+
+        return success;
+    #endif
+}
+//---------------------------------------------------------------------------
+bool TSP_FileHelper::RemoveFile(const std::wstring& name)
+{
+    #if defined (_WIN32)
+        return ::DeleteFileW(name.c_str());
+    #else
+        return !std::remove(TSP_StringHelper::Utf16ToUtf8(name).c_str());
+    #endif
+}
+//---------------------------------------------------------------------------
 bool TSP_FileHelper::DirExists(const std::string& name)
 {
     struct stat statbuf;
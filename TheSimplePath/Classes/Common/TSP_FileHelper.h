@@ -152,6 +152,23 @@ class TSP_FileHelper
         static bool FileExists(const std::string&  name);
         static bool FileExists(const std::wstring& name);
 
+        /**
+        * Renames a file
+        *@param source - file to rename
+        *@param target - new file name
+        *@return true on success, otherwise false
+        *@note If the target file exists, it is replaced atomically, so it contains either its previous
+        *      or its new content. The rename is synchronized on the disk before the function returns
+        */
+        static bool RenameFile(const std::wstring& source, const std::wstring& target);
+
+        /**
+        * Removes a file
+        *@param name - file name to remove
+        *@return true on success, otherwise false
+        */
+        static bool RemoveFile(const std::wstring& name);
+
         /**
         * Checks if a directory exists
         *@param dirName - dir name to check
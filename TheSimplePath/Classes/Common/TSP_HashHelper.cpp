@@ -0,0 +1,149 @@
+/****************************************************************************
+ * ==> TSP_HashHelper ------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Helper class for hashes                                    *
+ * Contained in: Common                                                     *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_HashHelper.h"
+
+// std
+#include <cstring>
+
+//---------------------------------------------------------------------------
+// TSP_HashHelper
+//---------------------------------------------------------------------------
+TSP_HashHelper::IHash128 TSP_HashHelper::Hash128(const void* pData, std::size_t size, std::uint64_t seed)
+{
+    const std::uint64_t c1 = 0x87c37b91114253d5ULL;
+    const std::uint64_t c2 = 0x4cf5ad432745937fULL;
+
+    const std::uint8_t* pBytes     = static_cast<const std::uint8_t*>(pData);
+    const std::size_t   blockCount = size / 16;
+          std::uint64_t h1         = seed;
+          std::uint64_t h2         = seed;
+
+    // hash the 16 bytes blocks. NOTE the blocks are copied, as the content may not be aligned
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+        std::uint64_t k[2];
+        std::memcpy(k, pBytes + i * 16, 16);
+
+        k[0] *= c1; k[0] = RotateLeft(k[0], 31); k[0] *= c2; h1 ^= k[0];
+        h1    = RotateLeft(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k[1] *= c2; k[1] = RotateLeft(k[1], 33); k[1] *= c1; h2 ^= k[1];
+        h2    = RotateLeft(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    // hash the remaining bytes
+    const std::uint8_t* pTail = pBytes + blockCount * 16;
+    const std::size_t   rest  = size & 15;
+          std::uint64_t k1    = 0;
+          std::uint64_t k2    = 0;
+
+    for (std::size_t i = rest; i > 8; --i)
+        k2 |= std::uint64_t(pTail[i - 1]) << ((i - 9) * 8);
+
+    for (std::size_t i = (rest < 8 ? rest : 8); i > 0; --i)
+        k1 |= std::uint64_t(pTail[i - 1]) << ((i - 1) * 8);
+
+    if (rest > 8)
+    {
+        k2 *= c2; k2 = RotateLeft(k2, 33); k2 *= c1; h2 ^= k2;
+    }
+
+    if (rest)
+    {
+        k1 *= c1; k1 = RotateLeft(k1, 31); k1 *= c2; h1 ^= k1;
+    }
+
+    // finalize the hash
+    h1 ^= std::uint64_t(size);
+    h2 ^= std::uint64_t(size);
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = Mix(h1);
+    h2 = Mix(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    IHash128 hash;
+    hash.m_Low  = h1;
+    hash.m_High = h2;
+
+    return hash;
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_HashHelper::ToStr(const IHash128& hash)
+{
+    static const wchar_t digits[] = L"0123456789abcdef";
+
+    std::wstring str(32, L'0');
+
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        str[15 - i] = digits[(hash.m_High >> (i * 4)) & 0xf];
+        str[31 - i] = digits[(hash.m_Low  >> (i * 4)) & 0xf];
+    }
+
+    return str;
+}
+//---------------------------------------------------------------------------
+bool TSP_HashHelper::FromStr(const std::wstring& str, IHash128& hash)
+{
+    if (str.length() != 32)
+        return false;
+
+    IHash128 result;
+
+    for (std::size_t i = 0; i < 32; ++i)
+    {
+        const wchar_t c = str[i];
+        std::uint64_t digit;
+
+        if (c >= L'0' && c <= L'9')
+            digit = c - L'0';
+        else
+        if (c >= L'a' && c <= L'f')
+            digit = c - L'a' + 10;
+        else
+        if (c >= L'A' && c <= L'F')
+            digit = c - L'A' + 10;
+        else
+            return false;
+
+        std::uint64_t& part = (i < 16) ? result.m_High : result.m_Low;
+        part                = (part << 4) | digit;
+    }
+
+    hash = result;
+
+    return true;
+}
+//---------------------------------------------------------------------------
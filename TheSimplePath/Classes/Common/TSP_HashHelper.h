@@ -0,0 +1,131 @@
+/****************************************************************************
+ * ==> TSP_HashHelper ------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Helper class for hashes                                    *
+ * Contained in: Common                                                     *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+* Helper class for hashes
+*@note The hashes aren't cryptographic, they are designed to identify contents quickly, e.g. to find
+*      which pages changed between two revisions, not to resist to an attacker
+*@author Jean-Milost Reymond
+*/
+class TSP_HashHelper
+{
+    public:
+        /**
+        * 128 bit hash
+        */
+        struct IHash128
+        {
+            std::uint64_t m_Low  = 0;
+            std::uint64_t m_High = 0;
+
+            inline bool operator == (const IHash128& other) const;
+            inline bool operator != (const IHash128& other) const;
+        };
+
+        /**
+        * Calculates the 128 bit hash of a content
+        *@param pData - content
+        *@param size - content size, in bytes
+        *@param seed - hash seed
+        *@return the hash
+        *@note The hash is MurmurHash3 x64 128, and the content is read in the platform byte order, which
+        *      is little endian on all the supported platforms
+        */
+        static IHash128 Hash128(const void* pData, std::size_t size, std::uint64_t seed = 0);
+
+        /**
+        * Converts a 128 bit hash to a string
+        *@param hash - hash to convert
+        *@return the hash as 32 lower case hexadecimal digits, high part first
+        */
+        static std::wstring ToStr(const IHash128& hash);
+
+        /**
+        * Converts a string to a 128 bit hash
+        *@param str - string to convert, should contain 32 hexadecimal digits, high part first
+        *@param[out] hash - converted hash
+        *@return true on success, otherwise false
+        */
+        static bool FromStr(const std::wstring& str, IHash128& hash);
+
+    private:
+        /**
+        * Mixes the final hash bits
+        *@param value - value to mix
+        *@return mixed value
+        */
+        static inline std::uint64_t Mix(std::uint64_t value);
+
+        /**
+        * Rotates a value to the left
+        *@param value - value to rotate
+        *@param count - bit count to rotate by
+        *@return rotated value
+        */
+        static inline std::uint64_t RotateLeft(std::uint64_t value, int count);
+};
+
+//---------------------------------------------------------------------------
+// TSP_HashHelper::IHash128
+//---------------------------------------------------------------------------
+bool TSP_HashHelper::IHash128::operator == (const IHash128& other) const
+{
+    return (m_Low == other.m_Low && m_High == other.m_High);
+}
+//---------------------------------------------------------------------------
+bool TSP_HashHelper::IHash128::operator != (const IHash128& other) const
+{
+    return !(*this == other);
+}
+//---------------------------------------------------------------------------
+// TSP_HashHelper
+//---------------------------------------------------------------------------
+std::uint64_t TSP_HashHelper::Mix(std::uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+
+    return value;
+}
+//---------------------------------------------------------------------------
+std::uint64_t TSP_HashHelper::RotateLeft(std::uint64_t value, int count)
+{
+    return (value << count) | (value >> (64 - count));
+}
+//---------------------------------------------------------------------------
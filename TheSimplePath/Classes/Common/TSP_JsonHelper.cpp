@@ -38,3 +38,28 @@ TSP_JsonHelper::TSP_JsonHelper()
 TSP_JsonHelper::~TSP_JsonHelper()
 {}
 //---------------------------------------------------------------------------
+// TSP_JsonHelper::IBufferStream
+//---------------------------------------------------------------------------
+TSP_JsonHelper::IBufferStream::IBufferStream(TSP_Buffer* pBuffer, std::size_t cacheSize) :
+    m_pBuffer(pBuffer),
+    m_Cache(cacheSize ? cacheSize : 1)
+{}
+//---------------------------------------------------------------------------
+TSP_JsonHelper::IBufferStream::~IBufferStream()
+{
+    Flush();
+}
+//---------------------------------------------------------------------------
+void TSP_JsonHelper::IBufferStream::Flush()
+{
+    // nothing to write?
+    if (!m_Size)
+        return;
+
+    // write the cache content in one block
+    if (!m_pBuffer || m_pBuffer->Write(m_Cache.data(), m_Size) != m_Size)
+        m_Failed = true;
+
+    m_Size = 0;
+}
+//---------------------------------------------------------------------------
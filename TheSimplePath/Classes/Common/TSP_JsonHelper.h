@@ -29,13 +29,21 @@
 
 #pragma once
 
+// std
+#include <string>
+#include <vector>
+
  // rapid json
 #include "rapidjson/encodings.h"
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
+#include "rapidjson/reader.h"
 //REM #include "rapidjson/ostreamwrapper.h"
 #include "rapidjson/writer.h"
 
+// common classes
+#include "TSP_Buffer.h"
+
 /**
 * Json helper
 *@author Jean-Milost Reymond
@@ -43,6 +51,55 @@
 class TSP_JsonHelper
 {
     public:
+        /**
+        * Json output stream writing to a buffer through a write-behind cache
+        *@note The content is only written to the buffer when the cache is full or when flushed, so
+        *      the buffer receives a few large blocks instead of one write per char
+        */
+        class IBufferStream
+        {
+            public:
+                typedef char Ch;
+
+                static const std::size_t m_DefaultCacheSize = 1024 * 1024;
+
+                /**
+                * Constructor
+                *@param pBuffer - buffer to write to
+                *@param cacheSize - cache size, in bytes
+                */
+                IBufferStream(TSP_Buffer* pBuffer, std::size_t cacheSize = m_DefaultCacheSize);
+
+                /**
+                * Destructor
+                *@note The remaining cache content is flushed to the buffer
+                */
+                virtual ~IBufferStream();
+
+                /**
+                * Writes a char
+                *@param c - char to write
+                */
+                inline void Put(Ch c);
+
+                /**
+                * Writes the cache content to the buffer
+                */
+                void Flush();
+
+                /**
+                * Checks if a write to the buffer failed
+                *@return true if a write failed, otherwise false
+                */
+                inline bool HasFailed() const;
+
+            private:
+                TSP_Buffer*     m_pBuffer = nullptr;
+                std::vector<Ch> m_Cache;
+                std::size_t     m_Size    = 0;
+                bool            m_Failed  = false;
+        };
+
         typedef rapidjson::Document                                                         IDocument;
         typedef rapidjson::GenericDocument<rapidjson::UTF16<>>                              IDocumentW;
         typedef rapidjson::Value                                                            IValue;
@@ -51,7 +108,10 @@ class TSP_JsonHelper
         typedef rapidjson::GenericStringBuffer<rapidjson::UTF16<>, rapidjson::CrtAllocator> IStringBufferW;
         typedef rapidjson::Writer<IStringBuffer>                                            IStringBufferWriter;
         typedef rapidjson::Writer<IStringBufferW, rapidjson::UTF16<>, rapidjson::UTF16<>>   IStringBufferWriterW;
+        typedef rapidjson::Writer<IBufferStream, rapidjson::UTF16<>, rapidjson::UTF8<>>     IBufferWriterW;
         typedef rapidjson::GenericStringRef<wchar_t>                                        IStringRefW;
+        typedef rapidjson::Reader                                                           IReader;
+        typedef rapidjson::InsituStringStream                                               IInsituStream;
 
         /**
         * Constructor
@@ -62,4 +122,64 @@ class TSP_JsonHelper
         * Destructor
         */
         virtual ~TSP_JsonHelper();
+
+        /**
+        * Writes a string value
+        *@param writer - json writer
+        *@param value - value to write
+        *@return true on success, otherwise false
+        */
+        static inline bool Write(IBufferWriterW& writer, const std::wstring& value);
+
+        /**
+        * Writes a member name
+        *@param writer - json writer
+        *@param name - member name
+        *@return true on success, otherwise false
+        */
+        static inline bool WriteKey(IBufferWriterW& writer, const std::wstring& name);
+
+        /**
+        * Writes a string member
+        *@param writer - json writer
+        *@param pName - member name
+        *@param value - member value
+        *@return true on success, otherwise false
+        */
+        static inline bool WriteMember(IBufferWriterW& writer, const wchar_t* pName, const std::wstring& value);
 };
+
+//---------------------------------------------------------------------------
+// TSP_JsonHelper::IBufferStream
+//---------------------------------------------------------------------------
+void TSP_JsonHelper::IBufferStream::Put(Ch c)
+{
+    if (m_Size == m_Cache.size())
+        Flush();
+
+    m_Cache[m_Size] = c;
+    ++m_Size;
+}
+//---------------------------------------------------------------------------
+bool TSP_JsonHelper::IBufferStream::HasFailed() const
+{
+    return m_Failed;
+}
+//---------------------------------------------------------------------------
+// TSP_JsonHelper
+//---------------------------------------------------------------------------
+bool TSP_JsonHelper::Write(IBufferWriterW& writer, const std::wstring& value)
+{
+    return writer.String(value.c_str(), rapidjson::SizeType(value.length()));
+}
+//---------------------------------------------------------------------------
+bool TSP_JsonHelper::WriteKey(IBufferWriterW& writer, const std::wstring& name)
+{
+    return writer.Key(name.c_str(), rapidjson::SizeType(name.length()));
+}
+//---------------------------------------------------------------------------
+bool TSP_JsonHelper::WriteMember(IBufferWriterW& writer, const wchar_t* pName, const std::wstring& value)
+{
+    return (writer.Key(pName) && Write(writer, value));
+}
+//---------------------------------------------------------------------------
@@ -30,6 +30,11 @@
 #include "TSP_Logger.h"
 
 // std
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <deque>
 #include <locale>
 #include <sstream>
 
@@ -38,139 +43,334 @@
 #include "TSP_StringHelper.h"
 #include "TSP_TimeHelper.h"
 #include "TSP_FileHelper.h"
+#include "TSP_StdFileBuffer.h"
 
 //---------------------------------------------------------------------------
 // Static members
 //---------------------------------------------------------------------------
-std::unique_ptr<TSP_Logger::IInstance> TSP_Logger::m_pLogger;
-std::mutex                             TSP_Logger::m_Mutex;
+#ifdef _DEBUG
+    std::atomic<std::uint8_t> TSP_Logger::m_Levels[] = {0, 0, 0, 0};
+#else
+    std::atomic<std::uint8_t> TSP_Logger::m_Levels[] = {1, 1, 1, 1};
+#endif
+TSP_Logger::IFormatInfos                 TSP_Logger::m_Formats;
+std::mutex                               TSP_Logger::m_FormatMutex;
+std::unique_ptr<TSP_Logger::IInstance>   TSP_Logger::m_pLogger;
+std::atomic<TSP_Logger*>                 TSP_Logger::m_pCurrent(nullptr);
+std::atomic<std::uint64_t>               TSP_Logger::m_LastID(0);
+std::mutex                               TSP_Logger::m_Mutex;
+thread_local TSP_Logger::ITimeStampCache TSP_Logger::m_TimeStampCache;
+thread_local TSP_Logger::IThreadState    TSP_Logger::m_ThreadState;
 //---------------------------------------------------------------------------
-// TSP_Logger::IInstance
+// TSP_Logger::IMessage
 //---------------------------------------------------------------------------
-TSP_Logger::IInstance::IInstance()
+TSP_Logger::IMessage::IMessage(bool timeStamp)
 {
-    m_pInstance = new TSP_Logger();
+    IThreadState& state = m_ThreadState;
+
+    // the thread text is reused, unless a message is built while another one is, e.g. if a value
+    // logs a message while it is converted
+    if (!state.m_Busy)
+    {
+        state.m_Busy = true;
+        m_pText      = &state.m_Text;
+        m_pText->clear();
+    }
+    else
+        m_pText = &m_Text;
+
+    // the time stamp is formatted later, by the logger
+    if (timeStamp)
+        m_Time = GetTime();
 }
 //---------------------------------------------------------------------------
-TSP_Logger::IInstance::~IInstance()
+TSP_Logger::IMessage::~IMessage()
 {
-    if (m_pInstance)
-        delete m_pInstance;
-}
-//---------------------------------------------------------------------------
-// TSP_Logger
-//---------------------------------------------------------------------------
-TSP_Logger::TSP_Logger()
-{}
-//---------------------------------------------------------------------------
-TSP_Logger::TSP_Logger(const TSP_Logger& other)
-{
-    M_THROW_EXCEPTION("Cannot create a copy of a singleton class");
+    try
+    {
+        TSP_Logger::Instance()->Push(*m_pText, m_Time);
+    }
+    catch (...)
+    {}
+
+    if (m_pText != &m_Text)
+        m_ThreadState.m_Busy = false;
 }
 //---------------------------------------------------------------------------
-TSP_Logger::~TSP_Logger()
-{}
-//---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (bool value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (bool value)
 {
-    m_Log += std::to_wstring(value);
+    AppendNumber(int(value));
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (std::int8_t value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (std::int8_t value)
 {
-    m_Log += std::to_wstring(value);
+    AppendNumber(int(value));
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (std::uint8_t value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (std::uint8_t value)
 {
-    m_Log += std::to_wstring(value);
+    AppendNumber(unsigned(value));
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (std::int16_t value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (std::int16_t value)
 {
-    m_Log += std::to_wstring(value);
+    AppendNumber(value);
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (std::uint16_t value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (std::uint16_t value)
 {
-    m_Log += std::to_wstring(value);
+    AppendNumber(value);
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (std::int32_t value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (std::int32_t value)
 {
-    m_Log += std::to_wstring(value);
+    AppendNumber(value);
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (std::uint32_t value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (std::uint32_t value)
 {
-    m_Log += std::to_wstring(value);
+    AppendNumber(value);
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (std::int64_t value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (std::int64_t value)
 {
-    m_Log += std::to_wstring(value);
+    AppendNumber(value);
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (std::uint64_t value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (std::uint64_t value)
 {
-    m_Log += std::to_wstring(value);
+    AppendNumber(value);
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (float value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (float value)
 {
-    m_Log += std::to_wstring(value);
+    *m_pText += std::to_wstring(value);
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (double value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (double value)
 {
-    m_Log += std::to_wstring(value);
+    *m_pText += std::to_wstring(value);
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (const char* pValue)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (const char* pValue)
 {
     if (pValue)
-        m_Log += TSP_StringHelper::Utf8ToUtf16(std::string(pValue));
+        Append(pValue, std::strlen(pValue));
 
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (const wchar_t* pValue)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (const wchar_t* pValue)
 {
     if (pValue)
-        m_Log += std::wstring(pValue);
+        m_pText->append(pValue);
 
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (const std::string& value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (const std::string& value)
 {
-    m_Log += TSP_StringHelper::Utf8ToUtf16(value);
+    Append(value.data(), value.length());
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (const std::wstring& value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (const std::wstring& value)
 {
-    m_Log += value;
+    m_pText->append(value);
     return *this;
 }
 //---------------------------------------------------------------------------
-TSP_Logger& TSP_Logger::operator << (const std::tm& value)
+TSP_Logger::IMessage& TSP_Logger::IMessage::operator << (const std::tm& value)
 {
-    m_Log += TSP_StringHelper::Utf8ToUtf16(TSP_TimeHelper::TmToStr(value, "%F %T", ""));
+    const std::string dateTime = TSP_TimeHelper::TmToStr(value, "%F %T", "");
+
+    Append(dateTime.data(), dateTime.length());
     return *this;
 }
 //---------------------------------------------------------------------------
+void TSP_Logger::IMessage::Append(const char* pValue, std::size_t length)
+{
+    AppendUtf8(*m_pText, pValue, length);
+}
+//---------------------------------------------------------------------------
+template <class T>
+void TSP_Logger::IMessage::AppendNumber(T value)
+{
+    char buffer[24];
+
+    // converted without any memory allocation
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+    m_pText->append(buffer, result.ptr);
+}
+//---------------------------------------------------------------------------
+// TSP_Logger::IFormat
+//---------------------------------------------------------------------------
+TSP_Logger::IFormat::IFormat(IECategory category, IELevel level, const char* pFile, std::uint32_t line) :
+    m_pFile(pFile),
+    m_Line(line),
+    m_Category(category),
+    m_Level(level),
+    m_ID(0)
+{}
+//---------------------------------------------------------------------------
+std::uint32_t TSP_Logger::IFormat::Register(const char* pFormat)
+{
+    try
+    {
+        // lock up the thread
+        std::unique_lock<std::mutex> lock(m_FormatMutex);
+
+        // registered meanwhile by another thread?
+        const std::uint32_t id = m_ID.load(std::memory_order_relaxed);
+
+        if (id)
+            return id;
+
+        IFormatInfo info;
+        info.m_pFormat  = pFormat ? pFormat : "";
+        info.m_pFile    = m_pFile ? m_pFile : "";
+        info.m_Line     = m_Line;
+        info.m_Category = m_Category;
+        info.m_Level    = m_Level;
+
+        m_Formats.push_back(info);
+
+        // the identifiers start from 1, 0 is reserved for the text messages
+        const std::uint32_t newID = std::uint32_t(m_Formats.size());
+
+        m_ID.store(newID, std::memory_order_release);
+
+        return newID;
+    }
+    catch (...)
+    {
+        return 0;
+    }
+}
+//---------------------------------------------------------------------------
+// TSP_Logger::IInstance
+//---------------------------------------------------------------------------
+TSP_Logger::IInstance::IInstance()
+{
+    m_pInstance = new TSP_Logger();
+}
+//---------------------------------------------------------------------------
+TSP_Logger::IInstance::~IInstance()
+{
+    if (m_pInstance)
+        delete m_pInstance;
+}
+//---------------------------------------------------------------------------
+// TSP_Logger::IRing
+//---------------------------------------------------------------------------
+TSP_Logger::IRing::IRing() :
+    m_pData(new std::uint64_t[m_Size / sizeof(std::uint64_t)]),
+    m_Head(0),
+    m_Tail(0),
+    m_Abandoned(false)
+{}
+//---------------------------------------------------------------------------
+bool TSP_Logger::IRing::Write(      std::uint64_t sequence,
+                                    std::int64_t  time,
+                                    std::uint32_t format,
+                              const void*         pData,
+                                    std::size_t   dataSize,
+                                    bool&         halfFull)
+{
+    // the records are aligned on 8 bytes
+    const std::size_t size = (sizeof(IRecord) + dataSize + 7) & ~std::size_t(7);
+
+    if (size > m_Size / 2)
+        return false;
+
+    const std::uint64_t head   = m_Head.load(std::memory_order_relaxed);
+    const std::uint64_t tail   = m_Tail.load(std::memory_order_acquire);
+    const std::size_t   offset = std::size_t(head % m_Size);
+    const std::size_t   toEnd  = m_Size - offset;
+
+    // a record is never split, so the buffer end is skipped if the record doesn't fit before it
+    const std::size_t skip = (toEnd < size) ? toEnd : 0;
+
+    // buffer full?
+    if (m_Size - std::size_t(head - tail) < skip + size)
+        return false;
+
+    char* pBuffer = reinterpret_cast<char*>(m_pData.get());
+
+    // mark the skipped buffer end, if a record header fits in it
+    if (skip >= sizeof(IRecord))
+    {
+        IRecord marker;
+        marker.m_Size = m_Skip;
+
+        std::memcpy(pBuffer + offset, &marker, sizeof(IRecord));
+    }
+
+    const std::size_t start = skip ? 0 : offset;
+
+    IRecord record;
+    record.m_Sequence = sequence;
+    record.m_Time     = time;
+    record.m_Size     = std::uint32_t(dataSize);
+    record.m_Format   = format;
+
+    std::memcpy(pBuffer + start,                   &record, sizeof(IRecord));
+    std::memcpy(pBuffer + start + sizeof(IRecord), pData,   dataSize);
+
+    // publish the record to the logger
+    m_Head.store(head + skip + size, std::memory_order_release);
+
+    halfFull = std::size_t(head + skip + size - tail) > m_Size / 2;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+// TSP_Logger::IThreadState
+//---------------------------------------------------------------------------
+TSP_Logger::IThreadState::~IThreadState()
+{
+    // the logger may release the ring buffer once it read its last messages
+    if (m_pRing)
+        m_pRing->m_Abandoned.store(true, std::memory_order_release);
+}
+//---------------------------------------------------------------------------
+// TSP_Logger
+//---------------------------------------------------------------------------
+TSP_Logger::TSP_Logger() :
+    m_ID(++m_LastID),
+    m_Sequence(0),
+    m_Dropped(0),
+    m_WakeRequested(false)
+{}
+//---------------------------------------------------------------------------
+TSP_Logger::TSP_Logger(const TSP_Logger& other)
+{
+    M_THROW_EXCEPTION("Cannot create a copy of a singleton class");
+}
+//---------------------------------------------------------------------------
+TSP_Logger::~TSP_Logger()
+{
+    Stop();
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_DrainMutex);
+
+    // write the remaining messages
+    Drain();
+}
+//---------------------------------------------------------------------------
 const TSP_Logger& TSP_Logger::operator = (const TSP_Logger& other)
 {
     M_THROW_EXCEPTION("Cannot create a copy of a singleton class");
@@ -181,8 +381,12 @@ const TSP_Logger& TSP_Logger::operator = (const TSP_Logger& other)
 //---------------------------------------------------------------------------
 TSP_Logger* TSP_Logger::Instance()
 {
-    // check instance out of the thread lock (double check lock)
-    if (!m_pLogger)
+    // the instance is read without locking, as it is queried for each logged message
+    TSP_Logger* pInstance = m_pCurrent.load(std::memory_order_acquire);
+
+    if (pInstance)
+        return pInstance;
+
     {
         // lock up the thread
         std::unique_lock<std::mutex> lock(m_Mutex);
@@ -190,6 +394,9 @@ TSP_Logger* TSP_Logger::Instance()
         // create the instance
         if (!m_pLogger)
             m_pLogger.reset(new (std::nothrow)IInstance());
+
+        if (m_pLogger)
+            m_pCurrent.store(m_pLogger->m_pInstance, std::memory_order_release);
     }
 
     // still not created?
@@ -207,19 +414,46 @@ void TSP_Logger::Release()
     if (!m_pLogger)
         return;
 
+    m_pCurrent.store(nullptr, std::memory_order_release);
+
     // delete the instance
     m_pLogger.reset(nullptr);
 }
 //---------------------------------------------------------------------------
+void TSP_Logger::SetLevel(IECategory category, IELevel level)
+{
+    if (category >= IECategory::IE_C_Count)
+        return;
+
+    m_Levels[std::size_t(category)].store(std::uint8_t(level), std::memory_order_relaxed);
+}
+//---------------------------------------------------------------------------
 void TSP_Logger::Clear()
 {
-    m_Log.clear();
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_DrainMutex);
+
+    Drain();
+    m_Tail.clear();
 }
 //---------------------------------------------------------------------------
-void TSP_Logger::Open(const IHeader& header)
+void TSP_Logger::Open(const IHeader& header, const std::wstring& fileName, IEFileFormat fileFormat)
 {
+    Stop();
     Clear();
 
+    {
+        // lock up the thread
+        std::unique_lock<std::mutex> lock(m_DrainMutex);
+
+        m_pFile.reset();
+        m_FileName   = fileName;
+        m_FileFormat = fileFormat;
+
+        if (!m_FileName.empty())
+            OpenFile();
+    }
+
     // get the locale. NOTE double call is required because the locale will returns an empty value
     std::setlocale(LC_ALL, "");
     const char*        pLocale       = std::setlocale(LC_ALL, "");
@@ -235,41 +469,803 @@ void TSP_Logger::Open(const IHeader& header)
                         << L" - DPI - "    << header.m_ScreenDPI  << M_WEOL;
     sstr << L"Start date time - "          << GetTimeStamp(false) << M_WEOL;
     sstr << M_WEOL;
-    sstr << L"Log start" << M_WEOL;
+    sstr << L"Log start";
 
-    m_Log = sstr.str();
+    Push(sstr.str(), -1);
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_WakeMutex);
+
+    m_Running = true;
+
+    try
+    {
+        m_Writer = std::thread(&TSP_Logger::Run, this);
+    }
+    catch (...)
+    {
+        // no writer thread, the messages are written each time the log is read or flushed
+        m_Running = false;
+    }
 }
 //---------------------------------------------------------------------------
 void TSP_Logger::Close()
 {
-    std::wostringstream sstr;
-    sstr << L"Log end." << M_WEOL;
+    Push(L"Log end.", -1);
+    Stop();
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_DrainMutex);
 
-    m_Log += sstr.str();
+    Drain();
+    m_pFile.reset();
 }
 //---------------------------------------------------------------------------
-std::wstring TSP_Logger::Get() const
+void TSP_Logger::Flush()
 {
-    return m_Log;
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_DrainMutex);
+
+    Drain();
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_Logger::Get()
+{
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_DrainMutex);
+
+    Drain();
+
+    return m_Tail;
 }
 //---------------------------------------------------------------------------
 std::wstring TSP_Logger::GetTimeStamp(bool timeOnly) const
 {
-    // get the current time
-    std::time_t time;
-    std::time(&time);
+    return GetTimeStamp(std::time(nullptr), timeOnly);
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_Logger::GetFileName(const std::wstring& appName, const std::wstring& extension) const
+{
+    return TSP_FileHelper::EscapeForbiddenChars(appName + L"_" + GetTimeStamp(false) + extension, L'\'');
+}
+//---------------------------------------------------------------------------
+bool TSP_Logger::Decode(const std::wstring& fileName, std::wstring& log)
+{
+    std::string data;
+
+    {
+        TSP_StdFileBuffer file;
+
+        if (!file.Open(fileName, TSP_FileBuffer::IEMode::IE_M_Read))
+            return false;
+
+        data.resize(file.GetSize());
+
+        if (!data.empty() && file.Read(&data[0], data.length()) != data.length())
+            return false;
+    }
+
+    IBinary::IHeader header;
+
+    if (data.length() < sizeof(header))
+        return false;
+
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (header.m_Magic != IBinary::m_Magic || header.m_Version != IBinary::m_Version)
+        return false;
+
+    if (header.m_CharSize != 2 && header.m_CharSize != 4)
+        return false;
+
+    // the format identifiers are written in sequence from 1, each in its own block, so a valid file can't
+    // contain an identifier above this count. NOTE the identifiers are read from the file, so they should
+    // be checked before the format list is grown
+    const std::size_t maxFormatCount = (data.length() - sizeof(header)) /
+                                       (sizeof(IBinary::IBlock) + sizeof(IBinary::IFormat));
+
+    // the format strings are kept by a deque, so they are never moved while new ones are added
+    IFormatInfos             formats;
+    std::vector<bool>        defined;
+    std::deque<std::string>  strings;
+    std::size_t              offset = sizeof(header);
+
+    while (offset + sizeof(IBinary::IBlock) <= data.length())
+    {
+        IBinary::IBlock block;
+        std::memcpy(&block, data.data() + offset, sizeof(block));
+        offset += sizeof(block);
+
+        // truncated file, e.g. if the application crashed while the log was written
+        if (block.m_Size > data.length() - offset)
+        {
+            log += L"<warning>Logger - the log file is truncated</warning>";
+            log += M_WEOL;
+            break;
+        }
+
+        const char* pBlock = data.data() + offset;
+
+        switch (IBinary::IEBlock(block.m_Type))
+        {
+            case IBinary::IEBlock::IE_B_Format:
+            {
+                IBinary::IFormat format;
+
+                if (block.m_Size < sizeof(format))
+                    break;
+
+                std::memcpy(&format, pBlock, sizeof(format));
+
+                if (!format.m_ID || std::size_t(format.m_FileLength) + format.m_FormatLength > block.m_Size - sizeof(format))
+                    break;
+
+                if (format.m_ID > maxFormatCount)
+                {
+                    log += L"<error>Logger - invalid message format - " + std::to_wstring(format.m_ID) + L"</error>";
+                    log += M_WEOL;
+                    break;
+                }
+
+                if (format.m_ID > formats.size())
+                {
+                    formats.resize(format.m_ID);
+                    defined.resize(format.m_ID, false);
+                }
+
+                strings.push_back(std::string(pBlock + sizeof(format), format.m_FileLength));
+
+                IFormatInfo& info = formats[format.m_ID - 1];
+                info.m_pFile      = strings.back().c_str();
+
+                strings.push_back(std::string(pBlock + sizeof(format) + format.m_FileLength, format.m_FormatLength));
+
+                info.m_pFormat  = strings.back().c_str();
+                info.m_Line     = format.m_Line;
+                info.m_Category = IECategory(format.m_Category);
+                info.m_Level    = IELevel(format.m_Level);
+
+                defined[format.m_ID - 1] = true;
+                break;
+            }
+
+            case IBinary::IEBlock::IE_B_Message:
+            {
+                IBinary::IMessage message;
+
+                if (block.m_Size < sizeof(message))
+                    break;
+
+                std::memcpy(&message, pBlock, sizeof(message));
+
+                if (message.m_Format && (message.m_Format > formats.size() || !defined[message.m_Format - 1]))
+                {
+                    log += L"<error>Logger - unknown message format - " + std::to_wstring(message.m_Format) + L"</error>";
+                    log += M_WEOL;
+                    break;
+                }
+
+                Format(message.m_Format ? &formats[message.m_Format - 1] : nullptr,
+                       message.m_Time,
+                       pBlock + sizeof(message),
+                       block.m_Size - sizeof(message),
+                       header.m_CharSize,
+                       log);
+
+                break;
+            }
+
+            // unknown blocks are skipped
+            default:
+                break;
+        }
+
+        offset += block.m_Size;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::Push(const std::wstring& text, std::int64_t time)
+{
+    // the too long messages are truncated, so several messages always fit in a ring buffer
+    const std::size_t maxLength = (IRing::m_Size / 4 - sizeof(IRecord)) / sizeof(wchar_t);
+
+    Push(text.data(), std::min(text.length(), maxLength) * sizeof(wchar_t), 0, time);
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::Push(const void* pData, std::size_t size, std::uint32_t format, std::int64_t time)
+{
+    // the too large structured messages are dropped, as their values cannot be truncated
+    if (size > IRing::m_Size / 4 - sizeof(IRecord))
+    {
+        m_Dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    try
+    {
+        IRing* pRing = GetRing();
+
+        // the messages logged by several threads are ordered by their sequence number
+        const std::uint64_t sequence = m_Sequence.fetch_add(1, std::memory_order_relaxed);
+
+        bool halfFull = false;
+
+        if (pRing->Write(sequence, time, format, pData, size, halfFull))
+        {
+            // wake up the writer, once, without locking. NOTE a notification may be missed while the
+            // writer is busy, it then wakes up after its usual delay
+            if (halfFull && !m_WakeRequested.exchange(true, std::memory_order_relaxed))
+                m_Wake.notify_one();
+
+            return;
+        }
+    }
+    catch (...)
+    {}
+
+    // the message is dropped, rather than waiting for the ring buffer to be read
+    m_Dropped.fetch_add(1, std::memory_order_relaxed);
+}
+//---------------------------------------------------------------------------
+TSP_Logger::IRing* TSP_Logger::GetRing()
+{
+    IThreadState& state = m_ThreadState;
+
+    if (state.m_pRing && state.m_LoggerID == m_ID)
+        return state.m_pRing.get();
+
+    // the ring buffer used with a previous logger instance is no longer read
+    if (state.m_pRing)
+        state.m_pRing->m_Abandoned.store(true, std::memory_order_release);
+
+    std::shared_ptr<IRing> pRing = std::make_shared<IRing>();
+
+    {
+        // lock up the thread
+        std::unique_lock<std::mutex> lock(m_RingMutex);
+
+        m_Rings.push_back(pRing);
+    }
+
+    state.m_pRing    = pRing;
+    state.m_LoggerID = m_ID;
+
+    return pRing.get();
+}
+//---------------------------------------------------------------------------
+const std::wstring& TSP_Logger::GetTimeStamp(std::time_t time, bool timeOnly)
+{
+    ITimeStampCache& cache = m_TimeStampCache;
+
+    // time stamps are only rebuilt once per second
+    if (!cache.m_Valid || cache.m_Time != time)
+    {
+        std::tm dateTime;
+
+        // convert to date and time structure
+        if (TSP_TimeHelper::ToLocalTm(time, dateTime))
+        {
+            cache.m_TimeOnly = TSP_StringHelper::Utf8ToUtf16(TSP_TimeHelper::TmToStr(dateTime, "%T",    ""));
+            cache.m_DateTime = TSP_StringHelper::Utf8ToUtf16(TSP_TimeHelper::TmToStr(dateTime, "%F %T", ""));
+        }
+        else
+        {
+            cache.m_TimeOnly = L"Unknown";
+            cache.m_DateTime = L"Unknown";
+        }
+
+        cache.m_Time  = time;
+        cache.m_Valid = true;
+    }
+
+    return timeOnly ? cache.m_TimeOnly : cache.m_DateTime;
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::EncodeString(      std::string& data,
+                                    IEValue      type,
+                              const void*        pValue,
+                                    std::size_t  length,
+                                    std::size_t  charSize)
+{
+    // the too long strings are truncated, so the message fits in a ring buffer
+    const std::uint32_t stringLength = std::uint32_t(std::min(length, IRing::m_Size / 8 / charSize));
+
+    data.push_back(char(type));
+    data.append(reinterpret_cast<const char*>(&stringLength), sizeof(stringLength));
+    data.append(static_cast<const char*>(pValue), stringLength * charSize);
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::AppendUtf8(std::wstring& text, const char* pValue, std::size_t length)
+{
+    // an invalid text is kept byte per byte rather than lost, the text may come from anywhere
+    if (!TSP_StringHelper::Utf8ToUtf16(pValue, length, text))
+        for (std::size_t i = 0; i < length; ++i)
+            text += wchar_t(static_cast<unsigned char>(pValue[i]));
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::AppendChars(std::wstring& text, const char* pValue, std::size_t length, std::size_t charSize)
+{
+    if (charSize == sizeof(wchar_t))
+    {
+        const std::size_t start = text.length();
+
+        text.resize(start + length);
+        std::memcpy(&text[start], pValue, length * sizeof(wchar_t));
+        return;
+    }
+
+    // the log was written on a platform using another wide char size, the chars are converted one by one
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        std::uint32_t c = 0;
+
+        if (charSize == sizeof(std::uint16_t))
+        {
+            std::uint16_t c16;
+            std::memcpy(&c16, pValue + i * charSize, sizeof(c16));
+            c = c16;
+        }
+        else
+            std::memcpy(&c, pValue + i * charSize, sizeof(c));
+
+        text.push_back(wchar_t(c));
+    }
+}
+//---------------------------------------------------------------------------
+bool TSP_Logger::AppendValue(      std::wstring& text,
+                             const char*         pData,
+                                   std::size_t   size,
+                                   std::size_t&  offset,
+                                   std::size_t   charSize)
+{
+    if (offset >= size)
+        return false;
+
+    const IEValue type = IEValue(pData[offset]);
+    ++offset;
+
+    char buffer[32];
+
+    switch (type)
+    {
+        case IEValue::IE_V_Bool:
+            if (size - offset < sizeof(std::uint8_t))
+                return false;
+
+            text.push_back(pData[offset] ? L'1' : L'0');
+            offset += sizeof(std::uint8_t);
+            return true;
+
+        case IEValue::IE_V_Int:
+        case IEValue::IE_V_UInt:
+        case IEValue::IE_V_Double:
+        {
+            if (size - offset < sizeof(std::uint64_t))
+                return false;
+
+            std::to_chars_result result;
+
+            if (type == IEValue::IE_V_Int)
+            {
+                std::int64_t value;
+                std::memcpy(&value, pData + offset, sizeof(value));
+                result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            }
+            else
+            if (type == IEValue::IE_V_UInt)
+            {
+                std::uint64_t value;
+                std::memcpy(&value, pData + offset, sizeof(value));
+                result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            }
+            else
+            {
+                double value;
+                std::memcpy(&value, pData + offset, sizeof(value));
+                result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            }
+
+            text.append(buffer, result.ptr);
+            offset += sizeof(std::uint64_t);
+            return true;
+        }
+
+        case IEValue::IE_V_String:
+        case IEValue::IE_V_WString:
+        {
+            std::uint32_t length;
+
+            if (size - offset < sizeof(length))
+                return false;
+
+            std::memcpy(&length, pData + offset, sizeof(length));
+            offset += sizeof(length);
+
+            const std::size_t stringCharSize = (type == IEValue::IE_V_String) ? sizeof(char) : charSize;
+
+            if ((size - offset) / stringCharSize < length)
+                return false;
+
+            if (type == IEValue::IE_V_String)
+                AppendUtf8(text, pData + offset, length);
+            else
+                AppendChars(text, pData + offset, length, charSize);
+
+            offset += length * stringCharSize;
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::Format(const IFormatInfo*  pFormat,
+                              std::int64_t  time,
+                        const char*         pData,
+                              std::size_t   size,
+                              std::size_t   charSize,
+                              std::wstring& text)
+{
+    if (time >= 0)
+    {
+        text += L"[";
+        text += GetTimeStamp(std::time_t(time / 1000000000), true);
+        text += L"] ";
+    }
+
+    // text message?
+    if (!pFormat)
+    {
+        AppendChars(text, pData, size / charSize, charSize);
+        text += M_WEOL;
+        return;
+    }
+
+    if (pFormat->m_Level == IELevel::IE_L_Warning)
+        text += L"<warning>";
+    else
+    if (pFormat->m_Level == IELevel::IE_L_Error)
+        text += L"<error>";
+
+    const char* pFormatText = pFormat->m_pFormat;
+    std::size_t start       = 0;
+    std::size_t offset      = 0;
+    std::size_t i           = 0;
+
+    // replace each {} by the next value, while values remain
+    for (; pFormatText[i]; ++i)
+        if (pFormatText[i] == '{' && pFormatText[i + 1] == '}' && offset < size)
+        {
+            AppendUtf8(text, pFormatText + start, i - start);
+
+            if (!AppendValue(text, pData, size, offset, charSize))
+            {
+                text  += L"<invalid value>";
+                offset = size;
+            }
+
+            start = i + 2;
+            ++i;
+        }
+
+    AppendUtf8(text, pFormatText + start, i - start);
+
+    if (pFormat->m_Level == IELevel::IE_L_Warning)
+        text += L"</warning>";
+    else
+    if (pFormat->m_Level == IELevel::IE_L_Error)
+        text += L"</error>";
+
+    text += M_WEOL;
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::UpdateFormatCache()
+{
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_FormatMutex);
+
+    // the formats are never unregistered, so only the new ones are copied
+    if (m_FormatCache.size() < m_Formats.size())
+        m_FormatCache.insert(m_FormatCache.end(), m_Formats.begin() + m_FormatCache.size(), m_Formats.end());
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::WriteFormats(std::string& data, std::size_t fromIndex) const
+{
+    for (std::size_t i = fromIndex; i < m_FormatCache.size(); ++i)
+    {
+        const IFormatInfo& info = m_FormatCache[i];
+
+        IBinary::IFormat format;
+        format.m_ID           = std::uint32_t(i + 1);
+        format.m_Line         = info.m_Line;
+        format.m_Category     = std::uint32_t(info.m_Category);
+        format.m_Level        = std::uint32_t(info.m_Level);
+        format.m_FileLength   = std::uint32_t(std::strlen(info.m_pFile));
+        format.m_FormatLength = std::uint32_t(std::strlen(info.m_pFormat));
+
+        IBinary::IBlock block;
+        block.m_Type = std::uint32_t(IBinary::IEBlock::IE_B_Format);
+        block.m_Size = std::uint32_t(sizeof(format) + format.m_FileLength + format.m_FormatLength);
+
+        data.append(reinterpret_cast<const char*>(&block),  sizeof(block));
+        data.append(reinterpret_cast<const char*>(&format), sizeof(format));
+        data.append(info.m_pFile,   format.m_FileLength);
+        data.append(info.m_pFormat, format.m_FormatLength);
+    }
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::Drain()
+{
+    IRings rings;
+
+    {
+        // lock up the thread
+        std::unique_lock<std::mutex> lock(m_RingMutex);
+
+        rings = m_Rings;
+    }
+
+    m_Entries.clear();
+    m_Data.clear();
+
+    IRings abandoned;
+
+    // read the messages from all the ring buffers
+    for (std::size_t i = 0; i < rings.size(); ++i)
+    {
+        IRing* pRing = rings[i].get();
+
+        // NOTE should be checked before the messages are read, so the last ones are read
+        const bool          isAbandoned = pRing->m_Abandoned.load(std::memory_order_acquire);
+        const std::uint64_t head        = pRing->m_Head.load(std::memory_order_acquire);
+              std::uint64_t tail        = pRing->m_Tail.load(std::memory_order_relaxed);
+        const char*         pData       = reinterpret_cast<const char*>(pRing->m_pData.get());
+
+        while (tail < head)
+        {
+            const std::size_t offset = std::size_t(tail % IRing::m_Size);
+            const std::size_t toEnd  = IRing::m_Size - offset;
+
+            // skipped buffer end?
+            if (toEnd < sizeof(IRecord))
+            {
+                tail += toEnd;
+                continue;
+            }
+
+            IRecord record;
+            std::memcpy(&record, pData + offset, sizeof(IRecord));
+
+            if (record.m_Size == IRing::m_Skip)
+            {
+                tail += toEnd;
+                continue;
+            }
+
+            IEntry entry;
+            entry.m_Sequence = record.m_Sequence;
+            entry.m_Time     = record.m_Time;
+            entry.m_Format   = record.m_Format;
+            entry.m_Offset   = m_Data.length();
+            entry.m_Size     = record.m_Size;
+
+            m_Data.append(pData + offset + sizeof(IRecord), record.m_Size);
+            m_Entries.push_back(entry);
+
+            tail += (sizeof(IRecord) + record.m_Size + 7) & ~std::size_t(7);
+        }
+
+        // release the read messages to the writing thread
+        pRing->m_Tail.store(tail, std::memory_order_release);
+
+        if (isAbandoned)
+            abandoned.push_back(rings[i]);
+    }
+
+    // release the ring buffers of the ended threads
+    if (!abandoned.empty())
+    {
+        // lock up the thread
+        std::unique_lock<std::mutex> lock(m_RingMutex);
+
+        for (std::size_t i = 0; i < abandoned.size(); ++i)
+            m_Rings.erase(std::remove(m_Rings.begin(), m_Rings.end(), abandoned[i]), m_Rings.end());
+    }
+
+    const std::size_t dropped = m_Dropped.exchange(0, std::memory_order_relaxed);
+
+    if (m_Entries.empty() && !dropped)
+        return;
+
+    // restore the order in which the messages were logged
+    std::sort(m_Entries.begin(), m_Entries.end(), [](const IEntry& left, const IEntry& right)
+    {
+        return left.m_Sequence < right.m_Sequence;
+    });
+
+    UpdateFormatCache();
+
+    // the messages are formatted in both modes, so the most recent part of the log can always be read
+    std::wstring text;
+    text.reserve(m_Data.length() / sizeof(wchar_t) + m_Entries.size() * 16);
+
+    for (std::size_t i = 0; i < m_Entries.size(); ++i)
+    {
+        const std::uint32_t format = m_Entries[i].m_Format;
+
+        // the format is always registered before its first message is recorded
+        if (format > m_FormatCache.size())
+            continue;
+
+        // the structured messages are formatted here, on the logger thread
+        Format(format ? &m_FormatCache[format - 1] : nullptr,
+                m_Entries[i].m_Time,
+                m_Data.data() + m_Entries[i].m_Offset,
+                m_Entries[i].m_Size,
+                sizeof(wchar_t),
+                text);
+    }
+
+    if (dropped)
+        text += L"<warning>Logger - " + std::to_wstring(dropped) + L" messages were dropped</warning>" + M_WEOL;
+
+    m_Tail += text;
+
+    // keep only the most recent part of the log in memory, from a line start
+    if (m_Tail.length() > m_TailSize)
+    {
+        const std::size_t start   = m_Tail.length() - m_TailSize;
+        const std::size_t lineEnd = m_Tail.find(L'\n', start);
+
+        m_Tail.erase(0, lineEnd == std::wstring::npos ? start : lineEnd + 1);
+    }
+
+    if (!m_pFile)
+        return;
+
+    // binary mode? Write the messages as is, they will be formatted again while the log is decoded
+    if (m_FileFormat == IEFileFormat::IE_FF_Binary)
+    {
+        std::string data;
+        data.reserve(m_Data.length() + m_Entries.size() * (sizeof(IBinary::IBlock) + sizeof(IBinary::IMessage)));
 
-    // convert to date and time structure
-    const std::tm* pDateTime = std::localtime(&time);
+        // define the formats before the first message using them
+        WriteFormats(data, m_FormatsWritten);
+        m_FormatsWritten = m_FormatCache.size();
 
-    if (timeOnly)
-        return pDateTime ? TSP_StringHelper::Utf8ToUtf16(TSP_TimeHelper::TmToStr(*pDateTime, "%T", "")) : L"Unknown";
+        for (std::size_t i = 0; i < m_Entries.size(); ++i)
+        {
+            IBinary::IBlock block;
+            block.m_Type = std::uint32_t(IBinary::IEBlock::IE_B_Message);
+            block.m_Size = std::uint32_t(sizeof(IBinary::IMessage) + m_Entries[i].m_Size);
 
-    return pDateTime ? TSP_StringHelper::Utf8ToUtf16(TSP_TimeHelper::TmToStr(*pDateTime, "%F %T", "")) : L"Unknown";
+            IBinary::IMessage message;
+            message.m_Sequence = m_Entries[i].m_Sequence;
+            message.m_Time     = m_Entries[i].m_Time;
+            message.m_Format   = m_Entries[i].m_Format;
+
+            data.append(reinterpret_cast<const char*>(&block),   sizeof(block));
+            data.append(reinterpret_cast<const char*>(&message), sizeof(message));
+            data.append(m_Data, m_Entries[i].m_Offset, m_Entries[i].m_Size);
+        }
+
+        if (dropped)
+        {
+            const std::wstring warning = L"<warning>Logger - " + std::to_wstring(dropped) + L" messages were dropped</warning>";
+
+            IBinary::IBlock block;
+            block.m_Type = std::uint32_t(IBinary::IEBlock::IE_B_Message);
+            block.m_Size = std::uint32_t(sizeof(IBinary::IMessage) + warning.length() * sizeof(wchar_t));
+
+            IBinary::IMessage message;
+
+            data.append(reinterpret_cast<const char*>(&block),   sizeof(block));
+            data.append(reinterpret_cast<const char*>(&message), sizeof(message));
+            data.append(reinterpret_cast<const char*>(warning.data()), warning.length() * sizeof(wchar_t));
+        }
+
+        WriteToFile(data);
+        return;
+    }
+
+    WriteToFile(TSP_StringHelper::Utf16ToUtf8(text));
 }
 //---------------------------------------------------------------------------
-std::wstring TSP_Logger::GetFileName(const std::wstring& appName) const
+bool TSP_Logger::OpenFile()
 {
-    return TSP_FileHelper::EscapeForbiddenChars(appName + L"_" + GetTimeStamp(false) + L".txt", L'\'');
+    std::unique_ptr<TSP_StdFileBuffer> pFile(new TSP_StdFileBuffer());
+
+    if (!pFile->Open(m_FileName, TSP_FileBuffer::IEMode::IE_M_Write))
+        return false;
+
+    m_pFile    = std::move(pFile);
+    m_FileSize = 0;
+
+    if (m_FileFormat != IEFileFormat::IE_FF_Binary)
+        return true;
+
+    IBinary::IHeader header;
+    header.m_Magic    = IBinary::m_Magic;
+    header.m_Version  = IBinary::m_Version;
+    header.m_CharSize = sizeof(wchar_t);
+
+    std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // a rotated file should be readable alone, so it defines all the formats known until now
+    WriteFormats(data, 0);
+    m_FormatsWritten = m_FormatCache.size();
+
+    m_FileSize = m_pFile->Write(data.data(), data.length());
+
+    return true;
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::WriteToFile(const std::string& data)
+{
+    if (!m_pFile)
+        return;
+
+    // file too large? Rotate it, e.g. the log.txt file becomes log.txt.1, and log.txt.1 becomes log.txt.2
+    if (m_FileSize && m_FileSize + data.length() > m_MaxFileSize)
+    {
+        m_pFile.reset();
+
+        TSP_FileHelper::RemoveFile(m_FileName + L"." + std::to_wstring(m_MaxFileCount));
+
+        for (std::size_t i = m_MaxFileCount - 1; i > 0; --i)
+            TSP_FileHelper::RenameFile(m_FileName + L"." + std::to_wstring(i), m_FileName + L"." + std::to_wstring(i + 1));
+
+        TSP_FileHelper::RenameFile(m_FileName, m_FileName + L".1");
+
+        if (!OpenFile())
+            return;
+    }
+
+    m_FileSize += m_pFile->Write(data.data(), data.length());
+
+    // the messages should be on the disk if the application crashes
+    m_pFile->Flush();
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::Stop()
+{
+    {
+        // lock up the thread
+        std::unique_lock<std::mutex> lock(m_WakeMutex);
+
+        m_Running = false;
+    }
+
+    m_Wake.notify_all();
+
+    if (m_Writer.joinable())
+        m_Writer.join();
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::Run()
+{
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_WakeMutex);
+
+    while (m_Running)
+    {
+        // the messages are written periodically, or as soon as a ring buffer is half full
+        m_Wake.wait_for(lock, std::chrono::milliseconds(std::int64_t(m_FlushDelay)), [this]()
+        {
+            return !m_Running || m_WakeRequested.load(std::memory_order_relaxed);
+        });
+
+        if (!m_Running)
+            break;
+
+        m_WakeRequested.store(false, std::memory_order_relaxed);
+
+        lock.unlock();
+        Flush();
+        lock.lock();
+    }
 }
 //---------------------------------------------------------------------------
@@ -31,35 +31,137 @@
 
 // std
 #include <iostream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
 #include <string>
 #include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 // common classes
 #include "TSP_StringHelper.h"
 #include "TSP_Version.h"
 #include "TSP_Exception.h"
 
+// class prototypes
+class TSP_StdFileBuffer;
+
 //---------------------------------------------------------------------------
 // Global defines
 //---------------------------------------------------------------------------
-#define M_GetTimeStamp            L"[" << TSP_Logger::Instance()->GetTimeStamp(true) << L"] "
-#define M_Log(msg)                *TSP_Logger::Instance()                   << msg << M_WEOL
-#define M_LogT(msg)               *TSP_Logger::Instance() << M_GetTimeStamp << msg << M_WEOL
-#define M_LogWarn(msg)            M_Log (L"<warning>" << msg << L"</warning>")
-#define M_LogWarnT(msg)           M_LogT(L"<warning>" << msg << L"</warning>")
-#define M_LogError(msg)           M_Log (L"<error>"   << msg << L"</error>")
-#define M_LogErrorT(msg)          M_LogT(L"<error>"   << msg << L"</error>")
-#define M_LogException(type, msg) M_Log (M_FORMAT_EXCEPTION(type, msg))
+// minimum level of the logged messages, the messages below it are removed while compiling
+#ifndef M_LogMinLevel
+    #ifdef _DEBUG
+        #define M_LogMinLevel 0 // debug
+    #else
+        #define M_LogMinLevel 1 // info
+    #endif
+#endif
+
+// the message is only built, and its values evaluated, if its level is enabled for its category. NOTE the
+// test is wrapped in a statement, so a macro used as the body of an if can't take its else
+#define M_LogMsg(category, level, timeStamp, msg)\
+    do\
+    {\
+        if (int(TSP_Logger::IELevel::IE_L_##level) >= M_LogMinLevel &&\
+            TSP_Logger::IsEnabled(TSP_Logger::IECategory::IE_C_##category, TSP_Logger::IELevel::IE_L_##level))\
+            TSP_Logger::IMessage(timeStamp) << msg;\
+    }\
+    while (false)
+
+#define M_Log(msg)                     M_LogMsg(Core,     Info,    false, msg)
+#define M_LogT(msg)                    M_LogMsg(Core,     Info,    true,  msg)
+#define M_LogDebug(msg)                M_LogMsg(Core,     Debug,   false, msg)
+#define M_LogDebugT(msg)               M_LogMsg(Core,     Debug,   true,  msg)
+#define M_LogWarn(msg)                 M_LogMsg(Core,     Warning, false, L"<warning>" << msg << L"</warning>")
+#define M_LogWarnT(msg)                M_LogMsg(Core,     Warning, true,  L"<warning>" << msg << L"</warning>")
+#define M_LogError(msg)                M_LogMsg(Core,     Error,   false, L"<error>"   << msg << L"</error>")
+#define M_LogErrorT(msg)               M_LogMsg(Core,     Error,   true,  L"<error>"   << msg << L"</error>")
+#define M_LogException(type, msg)      M_LogMsg(Core,     Error,   false, M_FORMAT_EXCEPTION(type, msg))
+#define M_LogCatT(category, msg)       M_LogMsg(category, Info,    true,  msg)
+#define M_LogCatDebug(category, msg)   M_LogMsg(category, Debug,   false, msg)
+#define M_LogCatDebugT(category, msg)  M_LogMsg(category, Debug,   true,  msg)
+#define M_LogCatWarnT(category, msg)   M_LogMsg(category, Warning, true,  L"<warning>" << msg << L"</warning>")
+#define M_LogCatErrorT(category, msg)  M_LogMsg(category, Error,   true,  L"<error>"   << msg << L"</error>")
+
+// structured message, only its format identifier and its raw values are recorded by the calling thread
+#define M_LogFmtMsg(category, level, timeStamp, ...)\
+    do\
+    {\
+        if (int(TSP_Logger::IELevel::IE_L_##level) >= M_LogMinLevel &&\
+            TSP_Logger::IsEnabled(TSP_Logger::IECategory::IE_C_##category, TSP_Logger::IELevel::IE_L_##level))\
+        {\
+            static TSP_Logger::IFormat logFormatSite(TSP_Logger::IECategory::IE_C_##category,\
+                                                     TSP_Logger::IELevel::IE_L_##level,\
+                                                     __FILE__,\
+                                                     __LINE__);\
+            TSP_Logger::Record(logFormatSite, timeStamp, __VA_ARGS__);\
+        }\
+    }\
+    while (false)
+
+#define M_LogFmt(category, level, ...)  M_LogFmtMsg(category, level, false, __VA_ARGS__)
+#define M_LogFmtT(category, level, ...) M_LogFmtMsg(category, level, true,  __VA_ARGS__)
 //---------------------------------------------------------------------------
 
 /**
 * Provides a logger
+*@note Each thread writes its messages in its own ring buffer, without lock nor memory allocation
+*      once its first message was logged. A background thread drains the ring buffers, formats the
+*      time stamps, and writes the messages to the log file, which is rotated once it became too
+*      large. The background thread is woken up early if a ring buffer is half full, and a message is
+*      dropped if its ring buffer is full, so the used memory remains bounded
+*@note Each message has a level and a category, e.g. M_LogCatWarnT(IO, L"Message"). The messages below
+*      M_LogMinLevel are removed while compiling, and the messages below the minimum level of their
+*      category are skipped without evaluating their values
+*@note A structured message, e.g. M_LogFmtT(IO, Info, "Save document - {} pages", count), only records
+*      its format identifier and its raw values, which are formatted later by the logger thread. In
+*      binary mode they are never formatted while the application runs, the log file is decoded
+*      offline with Decode()
 *@author Jean-Milost Reymond
 */
 class TSP_Logger
 {
     public:
+        /**
+        * Message level
+        */
+        enum class IELevel : std::uint8_t
+        {
+            IE_L_Debug = 0,
+            IE_L_Info,
+            IE_L_Warning,
+            IE_L_Error,
+            IE_L_None
+        };
+
+        /**
+        * Message category
+        */
+        enum class IECategory : std::uint8_t
+        {
+            IE_C_Core = 0,
+            IE_C_IO,
+            IE_C_Qml,
+            IE_C_Proxy,
+            IE_C_Count
+        };
+
+        /**
+        * Log file format
+        */
+        enum class IEFileFormat
+        {
+            IE_FF_Text,
+            IE_FF_Binary
+        };
+
         /**
         * Logger header
         */
@@ -72,6 +174,104 @@ class TSP_Logger
             std::size_t  m_ScreenDPI    = 0;
         };
 
+        /**
+        * Log message, built on the calling thread and added to the log as a text message when it is deleted
+        *@note Used by the M_Log macros, e.g. M_Log(L"Value - " << value). The text is formatted by the calling
+        *      thread, the M_LogFmt macros should be preferred on the hot paths
+        */
+        class IMessage
+        {
+            public:
+                /**
+                * Constructor
+                *@param timeStamp - if true, the message is preceded by its time stamp
+                */
+                IMessage(bool timeStamp);
+
+                ~IMessage();
+
+                /**
+                * Input stream operator
+                *@param value - value to add to the message
+                *@returns reference to itself
+                */
+                IMessage& operator << (bool                value);
+                IMessage& operator << (std::int8_t         value);
+                IMessage& operator << (std::uint8_t        value);
+                IMessage& operator << (std::int16_t        value);
+                IMessage& operator << (std::uint16_t       value);
+                IMessage& operator << (std::int32_t        value);
+                IMessage& operator << (std::uint32_t       value);
+                IMessage& operator << (std::int64_t        value);
+                IMessage& operator << (std::uint64_t       value);
+                IMessage& operator << (float               value);
+                IMessage& operator << (double              value);
+                IMessage& operator << (const char*         pValue);
+                IMessage& operator << (const wchar_t*      pValue);
+                IMessage& operator << (const std::string&  value);
+                IMessage& operator << (const std::wstring& value);
+                IMessage& operator << (const std::tm&      value);
+
+            private:
+                std::wstring* m_pText = nullptr;
+                std::wstring  m_Text;
+                std::int64_t  m_Time  = -1;
+
+                IMessage(const IMessage& other) = delete;
+                const IMessage& operator = (const IMessage& other) = delete;
+
+                /**
+                * Appends an UTF-8 string to the message
+                *@param pValue - string to append
+                *@param length - string length, in bytes
+                */
+                void Append(const char* pValue, std::size_t length);
+
+                /**
+                * Appends an integral number to the message
+                *@param value - number to append
+                */
+                template <class T>
+                void AppendNumber(T value);
+        };
+
+        /**
+        * Structured message call site, declared as a static variable by the M_LogFmt macros
+        */
+        class IFormat
+        {
+            public:
+                /**
+                * Constructor
+                *@param category - message category
+                *@param level - message level
+                *@param pFile - source file name
+                *@param line - source line
+                */
+                IFormat(IECategory category, IELevel level, const char* pFile, std::uint32_t line);
+
+                /**
+                * Gets the format identifier, registers the format on the first call
+                *@param pFormat - message format, should be a string literal
+                *@return the format identifier, 0 on error
+                */
+                inline std::uint32_t GetID(const char* pFormat);
+
+            private:
+                const char*                m_pFile;
+                std::uint32_t              m_Line;
+                IECategory                 m_Category;
+                IELevel                    m_Level;
+                std::atomic<std::uint32_t> m_ID;
+
+                /**
+                * Registers the format
+                *@param pFormat - message format
+                *@return the format identifier, 0 on error
+                */
+                std::uint32_t Register(const char* pFormat);
+        };
+
         /**
         * Gets the logger instance, creates it if still not exists
         *@return the logger instance
@@ -85,48 +285,81 @@ class TSP_Logger
         static void Release();
 
         /**
-        * Input stream operator
-        *@param value - value to add to the log
-        *@returns reference to itself
-        */
-        TSP_Logger& operator << (bool                value);
-        TSP_Logger& operator << (std::int8_t         value);
-        TSP_Logger& operator << (std::uint8_t        value);
-        TSP_Logger& operator << (std::int16_t        value);
-        TSP_Logger& operator << (std::uint16_t       value);
-        TSP_Logger& operator << (std::int32_t        value);
-        TSP_Logger& operator << (std::uint32_t       value);
-        TSP_Logger& operator << (std::int64_t        value);
-        TSP_Logger& operator << (std::uint64_t       value);
-        TSP_Logger& operator << (float               value);
-        TSP_Logger& operator << (double              value);
-        TSP_Logger& operator << (const char*         pValue);
-        TSP_Logger& operator << (const wchar_t*      pValue);
-        TSP_Logger& operator << (const std::string&  value);
-        TSP_Logger& operator << (const std::wstring& value);
-        TSP_Logger& operator << (const std::tm&      value);
+        * Sets the minimum level of the messages to log for a category
+        *@param category - message category
+        *@param level - minimum level, IE_L_None to log nothing
+        *@note The messages below M_LogMinLevel are never logged, whatever the level
+        */
+        static void SetLevel(IECategory category, IELevel level);
+
+        /**
+        * Gets the minimum level of the messages to log for a category
+        *@param category - message category
+        *@return the minimum level
+        */
+        static inline IELevel GetLevel(IECategory category);
+
+        /**
+        * Records a structured message
+        *@param format - message call site
+        *@param timeStamp - if true, the message is preceded by its time stamp
+        *@param pFormat - message format, each {} is replaced by the next value, should be a string literal
+        *@param args - message values, numbers and strings are supported
+        *@note Used by the M_LogFmt macros, the values are copied as is and formatted later
+        */
+        template <class... IArgs>
+        static void Record(IFormat& format, bool timeStamp, const char* pFormat, const IArgs&... args);
+
+        /**
+        * Decodes a binary log file
+        *@param fileName - binary log file name
+        *@param[out] log - decoded log
+        *@return true on success, otherwise false
+        */
+        static bool Decode(const std::wstring& fileName, std::wstring& log);
+
+        /**
+        * Checks if the messages of a level are logged for a category
+        *@param category - message category
+        *@param level - message level
+        *@return true if the messages are logged, otherwise false
+        *@note Called before each message is built, should remain cheap
+        */
+        static inline bool IsEnabled(IECategory category, IELevel level);
 
         /**
         * Clears the logger content
+        *@note The messages already written to the log file are kept
         */
         void Clear();
 
         /**
         * Opens the logger
         *@param header - header containing application info to log
+        *@param fileName - file to write the log to, the log is only kept in memory if empty
+        *@param fileFormat - log file format
         */
-        void Open(const IHeader& header);
+        void Open(const IHeader&      header,
+                  const std::wstring& fileName   = L"",
+                        IEFileFormat  fileFormat = IEFileFormat::IE_FF_Text);
 
         /**
         * Closes the log
+        *@note Waits until all the logged messages are written to the log file
         */
         void Close();
 
+        /**
+        * Writes the logged messages to the log file
+        */
+        void Flush();
+
         /**
         * Gets the log
-        *@return the log
+        *@return the most recent part of the log
+        *@note The messages logged until now are written to the log file before
         */
-        std::wstring Get() const;
+        std::wstring Get();
 
         /**
         * Gets a time stamp
@@ -138,8 +371,9 @@ class TSP_Logger
         /**
         * Gets a file name for the log
         *@param appName - application name
+        *@param extension - file extension
         */
-        std::wstring GetFileName(const std::wstring& appName) const;
+        std::wstring GetFileName(const std::wstring& appName, const std::wstring& extension = L".txt") const;
 
     private:
         /**
@@ -154,9 +388,216 @@ class TSP_Logger
             virtual ~IInstance();
         };
 
-        static std::unique_ptr<IInstance> m_pLogger;
-        static std::mutex                 m_Mutex;
-               std::wstring               m_Log;
+        /**
+        * Time stamp cache, the time stamps only change once per second
+        */
+        struct ITimeStampCache
+        {
+            std::time_t  m_Time  = 0;
+            std::wstring m_TimeOnly;
+            std::wstring m_DateTime;
+            bool         m_Valid = false;
+        };
+
+        /**
+        * Structured message value type
+        */
+        enum class IEValue : std::uint8_t
+        {
+            IE_V_Bool = 0,
+            IE_V_Int,
+            IE_V_UInt,
+            IE_V_Double,
+            IE_V_String, // UTF-8 string, preceded by its length in bytes
+            IE_V_WString // wide string, preceded by its length in chars
+        };
+
+        /**
+        * Registered structured message format
+        */
+        struct IFormatInfo
+        {
+            const char*   m_pFormat  = nullptr;
+            const char*   m_pFile    = nullptr;
+            std::uint32_t m_Line     = 0;
+            IECategory    m_Category = IECategory::IE_C_Core;
+            IELevel       m_Level    = IELevel::IE_L_Info;
+        };
+
+        typedef std::vector<IFormatInfo> IFormatInfos;
+
+        /**
+        * Message record, written in a ring buffer and followed by the message data, which are the
+        * message chars for a text message, or the message values for a structured message
+        */
+        struct IRecord
+        {
+            std::uint64_t m_Sequence = 0;
+            std::int64_t  m_Time     = -1; // in nanoseconds since epoch, -1 if the message has no time stamp
+            std::uint32_t m_Size     = 0;  // data size, in bytes, m_Skip if the next record is at the buffer start
+            std::uint32_t m_Format   = 0;  // structured message format identifier, 0 for a text message
+        };
+
+        /**
+        * Binary log file format. The file starts with a file header, followed by blocks, each one
+        * starting with a block header. A format block defines a structured message format, and is
+        * written before the first message using it, a message block contains a message record data
+        *@note The numbers are written in the platform byte order
+        */
+        struct IBinary
+        {
+            static const std::uint32_t m_Magic   = 0x4C505354; // "TSPL"
+            static const std::uint32_t m_Version = 1;
+
+            /**
+            * Block type
+            */
+            enum class IEBlock : std::uint32_t
+            {
+                IE_B_Format = 1,
+                IE_B_Message
+            };
+
+            /**
+            * File header
+            */
+            struct IHeader
+            {
+                std::uint32_t m_Magic    = 0;
+                std::uint32_t m_Version  = 0;
+                std::uint32_t m_CharSize = 0; // wide char size, in bytes
+                std::uint32_t m_Reserved = 0;
+            };
+
+            /**
+            * Block header
+            */
+            struct IBlock
+            {
+                std::uint32_t m_Type = 0;
+                std::uint32_t m_Size = 0; // block size, in bytes, without its header
+            };
+
+            /**
+            * Format block, followed by the source file name and the format, in UTF-8
+            */
+            struct IFormat
+            {
+                std::uint32_t m_ID           = 0;
+                std::uint32_t m_Line         = 0;
+                std::uint32_t m_Category     = 0;
+                std::uint32_t m_Level        = 0;
+                std::uint32_t m_FileLength   = 0;
+                std::uint32_t m_FormatLength = 0;
+            };
+
+            /**
+            * Message block, followed by the message data
+            */
+            struct IMessage
+            {
+                std::uint64_t m_Sequence = 0;
+                std::int64_t  m_Time     = -1;
+                std::uint32_t m_Format   = 0;
+                std::uint32_t m_Reserved = 0;
+            };
+        };
+
+        /**
+        * Ring buffer, written by a single thread and read by the logger
+        */
+        struct IRing
+        {
+            static const std::size_t   m_Size = 262144;
+            static const std::uint32_t m_Skip = 0xFFFFFFFF;
+
+            std::unique_ptr<std::uint64_t[]> m_pData;
+            alignas(64) std::atomic<std::uint64_t> m_Head; // write position, only modified by the writing thread
+            alignas(64) std::atomic<std::uint64_t> m_Tail; // read position, only modified by the logger
+                        std::atomic<bool>          m_Abandoned;
+
+            IRing();
+
+            /**
+            * Writes a message
+            *@param sequence - message sequence number
+            *@param time - message time, -1 if the message has no time stamp
+            *@param format - message format identifier, 0 for a text message
+            *@param pData - message data
+            *@param dataSize - message data size, in bytes
+            *@param[out] halfFull - if true, the buffer is more than half full after the message was written
+            *@return true on success, false if the buffer is full
+            */
+            bool Write(      std::uint64_t sequence,
+                             std::int64_t  time,
+                             std::uint32_t format,
+                       const void*         pData,
+                             std::size_t   dataSize,
+                             bool&         halfFull);
+        };
+
+        /**
+        * Logging state of a thread
+        */
+        struct IThreadState
+        {
+            std::shared_ptr<IRing> m_pRing;
+            std::uint64_t          m_LoggerID = 0;
+            std::wstring           m_Text;
+            std::string            m_Data;
+            bool                   m_Busy     = false;
+
+            ~IThreadState();
+        };
+
+        /**
+        * Message read from a ring buffer
+        */
+        struct IEntry
+        {
+            std::uint64_t m_Sequence = 0;
+            std::int64_t  m_Time     = -1;
+            std::uint32_t m_Format   = 0;
+            std::size_t   m_Offset   = 0;
+            std::size_t   m_Size     = 0;
+        };
+
+        typedef std::vector<std::shared_ptr<IRing>> IRings;
+
+        static const std::size_t m_TailSize     = 65536;
+        static const std::size_t m_MaxFileSize  = 8 * 1024 * 1024;
+        static const std::size_t m_MaxFileCount = 4;
+        static const std::size_t m_FlushDelay   = 100;
+
+        static std::atomic<std::uint8_t>             m_Levels[std::size_t(IECategory::IE_C_Count)];
+        static IFormatInfos                          m_Formats;
+        static std::mutex                            m_FormatMutex;
+        static std::unique_ptr<IInstance>            m_pLogger;
+        static std::atomic<TSP_Logger*>              m_pCurrent;
+        static std::atomic<std::uint64_t>            m_LastID;
+        static std::mutex                            m_Mutex;
+        static thread_local ITimeStampCache          m_TimeStampCache;
+        static thread_local IThreadState             m_ThreadState;
+               std::uint64_t                         m_ID;
+               std::atomic<std::uint64_t>            m_Sequence;
+               std::atomic<std::size_t>              m_Dropped;
+               IRings                                m_Rings;
+               std::mutex                            m_RingMutex;
+               std::vector<IEntry>                   m_Entries;
+               std::string                           m_Data;
+               std::wstring                          m_Tail;
+               IFormatInfos                          m_FormatCache;
+               std::size_t                           m_FormatsWritten = 0;
+               IEFileFormat                          m_FileFormat     = IEFileFormat::IE_FF_Text;
+               std::unique_ptr<TSP_StdFileBuffer>    m_pFile;
+               std::wstring                          m_FileName;
+               std::size_t                           m_FileSize       = 0;
+               std::mutex                            m_DrainMutex;
+               std::thread                           m_Writer;
+               std::mutex                            m_WakeMutex;
+               std::condition_variable               m_Wake;
+               std::atomic<bool>                     m_WakeRequested;
+               bool                                  m_Running        = false;
 
         TSP_Logger();
 
@@ -173,4 +614,282 @@ class TSP_Logger
         *@param other - other logger to copy from
         */
         const TSP_Logger& operator = (const TSP_Logger& other);
+
+        /**
+        * Adds a text message to the log
+        *@param text - message text
+        *@param time - message time, -1 if the message has no time stamp
+        *@note Never blocks once the calling thread logged its first message
+        */
+        void Push(const std::wstring& text, std::int64_t time);
+
+        /**
+        * Adds a message to the log
+        *@param pData - message data
+        *@param size - message data size, in bytes
+        *@param format - message format identifier, 0 for a text message
+        *@param time - message time, -1 if the message has no time stamp
+        *@note Never blocks once the calling thread logged its first message
+        */
+        void Push(const void* pData, std::size_t size, std::uint32_t format, std::int64_t time);
+
+        /**
+        * Gets the ring buffer of the calling thread, creates it if still not exists
+        *@return the ring buffer, nullptr on error
+        */
+        IRing* GetRing();
+
+        /**
+        * Gets a time stamp
+        *@param time - time
+        *@param timeOnly - if true, only the time will be returned
+        *@return the time stamp
+        */
+        static const std::wstring& GetTimeStamp(std::time_t time, bool timeOnly);
+
+        /**
+        * Gets the current time
+        *@return the current time, in nanoseconds since epoch
+        */
+        static inline std::int64_t GetTime();
+
+        /**
+        * Adds a value to a structured message data
+        *@param[in, out] data - message data
+        *@param value - value to add
+        */
+        template <class T>
+        static inline void Encode(std::string& data, T value);
+        static inline void Encode(std::string& data, const char*         pValue);
+        static inline void Encode(std::string& data, const wchar_t*      pValue);
+        static inline void Encode(std::string& data, const std::string&  value);
+        static inline void Encode(std::string& data, const std::wstring& value);
+
+        /**
+        * Adds a raw value to a structured message data
+        *@param[in, out] data - message data
+        *@param type - value type
+        *@param pValue - value
+        *@param size - value size, in bytes
+        */
+        static inline void Encode(std::string& data, IEValue type, const void* pValue, std::size_t size);
+
+        /**
+        * Adds a string to a structured message data
+        *@param[in, out] data - message data
+        *@param type - string type
+        *@param pValue - string chars
+        *@param length - string length, in chars
+        *@param charSize - char size, in bytes
+        */
+        static void EncodeString(      std::string& data,
+                                       IEValue      type,
+                                 const void*        pValue,
+                                       std::size_t  length,
+                                       std::size_t  charSize);
+
+        /**
+        * Appends an UTF-8 string to a text
+        *@param[in, out] text - text to append to
+        *@param pValue - string to append
+        *@param length - string length, in bytes
+        */
+        static void AppendUtf8(std::wstring& text, const char* pValue, std::size_t length);
+
+        /**
+        * Appends wide chars to a text
+        *@param[in, out] text - text to append to
+        *@param pValue - chars to append
+        *@param length - char count
+        *@param charSize - char size, in bytes
+        */
+        static void AppendChars(std::wstring& text, const char* pValue, std::size_t length, std::size_t charSize);
+
+        /**
+        * Appends a structured message value to a text
+        *@param[in, out] text - text to append to
+        *@param pData - message data
+        *@param size - message data size, in bytes
+        *@param[in, out] offset - value offset in the message data, next value offset on success
+        *@param charSize - wide char size in the message data, in bytes
+        *@return true on success, false if the value is invalid
+        */
+        static bool AppendValue(      std::wstring& text,
+                                const char*         pData,
+                                      std::size_t   size,
+                                      std::size_t&  offset,
+                                      std::size_t   charSize);
+
+        /**
+        * Formats a message
+        *@param pFormat - message format, nullptr for a text message
+        *@param time - message time, -1 if the message has no time stamp
+        *@param pData - message data
+        *@param size - message data size, in bytes
+        *@param charSize - wide char size in the message data, in bytes
+        *@param[in, out] text - text to append the formatted message to
+        */
+        static void Format(const IFormatInfo*  pFormat,
+                                 std::int64_t  time,
+                           const char*         pData,
+                                 std::size_t   size,
+                                 std::size_t   charSize,
+                                 std::wstring& text);
+
+        /**
+        * Gets the registered formats which are still not cached
+        *@note The drain mutex should be locked
+        */
+        void UpdateFormatCache();
+
+        /**
+        * Writes the format blocks of the formats still not written to the binary log file
+        *@param[in, out] data - data to append the blocks to
+        *@param fromIndex - index of the first format to write in the format cache
+        */
+        void WriteFormats(std::string& data, std::size_t fromIndex) const;
+
+        /**
+        * Reads all the messages from the ring buffers, and writes them to the log
+        *@note The drain mutex should be locked
+        */
+        void Drain();
+
+        /**
+        * Opens the log file, overwrites it if it already exists
+        *@return true on success, otherwise false
+        *@note The drain mutex should be locked. In binary mode, the file header and all the known
+        *      formats are written to the file
+        */
+        bool OpenFile();
+
+        /**
+        * Writes data to the log file, rotates the file if it became too large
+        *@param data - data to write
+        *@note The drain mutex should be locked
+        */
+        void WriteToFile(const std::string& data);
+
+        /**
+        * Stops the writer thread
+        */
+        void Stop();
+
+        /**
+        * Writer thread, writes the logged messages periodically
+        */
+        void Run();
 };
+
+//---------------------------------------------------------------------------
+// TSP_Logger
+//---------------------------------------------------------------------------
+TSP_Logger::IELevel TSP_Logger::GetLevel(IECategory category)
+{
+    return IELevel(m_Levels[std::size_t(category)].load(std::memory_order_relaxed));
+}
+//---------------------------------------------------------------------------
+bool TSP_Logger::IsEnabled(IECategory category, IELevel level)
+{
+    return std::uint8_t(level) >= m_Levels[std::size_t(category)].load(std::memory_order_relaxed);
+}
+//---------------------------------------------------------------------------
+// TSP_Logger::IFormat
+//---------------------------------------------------------------------------
+std::uint32_t TSP_Logger::IFormat::GetID(const char* pFormat)
+{
+    const std::uint32_t id = m_ID.load(std::memory_order_acquire);
+
+    if (id)
+        return id;
+
+    return Register(pFormat);
+}
+//---------------------------------------------------------------------------
+// TSP_Logger
+//---------------------------------------------------------------------------
+template <class... IArgs>
+void TSP_Logger::Record(IFormat& format, bool timeStamp, const char* pFormat, const IArgs&... args)
+{
+    try
+    {
+        const std::uint32_t id = format.GetID(pFormat);
+
+        if (!id)
+            return;
+
+        // the thread data are reused, so no memory is allocated once the thread logged its first messages
+        std::string& data = m_ThreadState.m_Data;
+        data.clear();
+
+        (Encode(data, args), ...);
+
+        Instance()->Push(data.data(), data.length(), id, timeStamp ? GetTime() : -1);
+    }
+    catch (...)
+    {}
+}
+//---------------------------------------------------------------------------
+std::int64_t TSP_Logger::GetTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>
+            (std::chrono::system_clock::now().time_since_epoch()).count();
+}
+//---------------------------------------------------------------------------
+template <class T>
+void TSP_Logger::Encode(std::string& data, T value)
+{
+    static_assert(std::is_arithmetic<T>::value, "Unsupported structured message value type");
+
+    if constexpr (std::is_same<T, bool>::value)
+    {
+        const std::uint8_t boolValue = value ? 1 : 0;
+        Encode(data, IEValue::IE_V_Bool, &boolValue, sizeof(boolValue));
+    }
+    else
+    if constexpr (std::is_floating_point<T>::value)
+    {
+        const double doubleValue = double(value);
+        Encode(data, IEValue::IE_V_Double, &doubleValue, sizeof(doubleValue));
+    }
+    else
+    if constexpr (std::is_signed<T>::value)
+    {
+        const std::int64_t intValue = std::int64_t(value);
+        Encode(data, IEValue::IE_V_Int, &intValue, sizeof(intValue));
+    }
+    else
+    {
+        const std::uint64_t uintValue = std::uint64_t(value);
+        Encode(data, IEValue::IE_V_UInt, &uintValue, sizeof(uintValue));
+    }
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::Encode(std::string& data, const char* pValue)
+{
+    const char* pString = pValue ? pValue : "";
+    EncodeString(data, IEValue::IE_V_String, pString, std::char_traits<char>::length(pString), sizeof(char));
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::Encode(std::string& data, const wchar_t* pValue)
+{
+    const wchar_t* pString = pValue ? pValue : L"";
+    EncodeString(data, IEValue::IE_V_WString, pString, std::char_traits<wchar_t>::length(pString), sizeof(wchar_t));
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::Encode(std::string& data, const std::string& value)
+{
+    EncodeString(data, IEValue::IE_V_String, value.data(), value.length(), sizeof(char));
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::Encode(std::string& data, const std::wstring& value)
+{
+    EncodeString(data, IEValue::IE_V_WString, value.data(), value.length(), sizeof(wchar_t));
+}
+//---------------------------------------------------------------------------
+void TSP_Logger::Encode(std::string& data, IEValue type, const void* pValue, std::size_t size)
+{
+    data.push_back(char(type));
+    data.append(static_cast<const char*>(pValue), size);
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,308 @@
+/****************************************************************************
+ * ==> TSP_MappedFileBuffer ------------------------------------------------*
+ ****************************************************************************
+ * Description:  File buffer mapped in memory                               *
+ * Contained in: Common                                                     *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_MappedFileBuffer.h"
+
+// std
+#include <cstdint>
+#include <cstring>
+
+// common classes
+#include "TSP_StringHelper.h"
+
+// system
+#if defined (_WIN32)
+    #ifndef UNICODE
+        #define UNICODE
+    #endif
+
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+//---------------------------------------------------------------------------
+// TSP_MappedFileBuffer
+//---------------------------------------------------------------------------
+TSP_MappedFileBuffer::TSP_MappedFileBuffer() :
+    TSP_FileBuffer()
+{}
+//---------------------------------------------------------------------------
+TSP_MappedFileBuffer::~TSP_MappedFileBuffer()
+{
+    Close();
+}
+//---------------------------------------------------------------------------
+bool TSP_MappedFileBuffer::Open(const std::string& fileName, IEMode mode)
+{
+    return Open(TSP_StringHelper::Utf8ToUtf16(fileName), mode);
+}
+//---------------------------------------------------------------------------
+bool TSP_MappedFileBuffer::Open(const std::wstring& fileName, IEMode mode)
+{
+    // the mapping is read only
+    if (mode != IEMode::IE_M_Read)
+        return false;
+
+    // close the previously opened file
+    Close();
+
+    // call base function to execute common stuffs
+    if (!TSP_FileBuffer::Open(fileName, mode))
+        return false;
+
+    #if defined (_WIN32)
+        // the file may be written while mapped, e.g. a binary document is updated in place without
+        // overwriting its mapped content
+        HANDLE hFile = ::CreateFileW(fileName.c_str(),
+                                     GENERIC_READ,
+                                     FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                     nullptr,
+                                     OPEN_EXISTING,
+                                     FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS,
+                                     nullptr);
+
+        if (hFile == INVALID_HANDLE_VALUE)
+            return false;
+
+        m_hFile = hFile;
+
+        LARGE_INTEGER size;
+
+        if (!::GetFileSizeEx(hFile, &size) || size.QuadPart < 0 || std::uint64_t(size.QuadPart) > SIZE_MAX)
+        {
+            Close();
+            return false;
+        }
+
+        m_Size = std::size_t(size.QuadPart);
+
+        // an empty file cannot be mapped, but it is still a valid file
+        if (!m_Size)
+            return true;
+
+        m_hMapping = ::CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (!m_hMapping)
+        {
+            Close();
+            return false;
+        }
+
+        m_pData = static_cast<const char*>(::MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+    #else
+        m_File = ::open(TSP_StringHelper::Utf16ToUtf8(fileName).c_str(), O_RDONLY);
+
+        if (m_File < 0)
+            return false;
+
+        struct stat info;
+
+        if (::fstat(m_File, &info) || info.st_size < 0)
+        {
+            Close();
+            return false;
+        }
+
+        m_Size = std::size_t(info.st_size);
+
+        // an empty file cannot be mapped, but it is still a valid file
+        if (!m_Size)
+            return true;
+
+        void* pData = ::mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_File, 0);
+
+        m_pData = (pData == MAP_FAILED) ? nullptr : static_cast<const char*>(pData);
+    #endif
+
+    if (!m_pData)
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+void TSP_MappedFileBuffer::Clear()
+{
+    Close();
+}
+//---------------------------------------------------------------------------
+bool TSP_MappedFileBuffer::Empty()
+{
+    return !m_Size;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_MappedFileBuffer::GetOffset() const
+{
+    return m_Offset;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_MappedFileBuffer::GetSize() const
+{
+    return m_Size;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_MappedFileBuffer::Seek(std::size_t start, std::size_t delta)
+{
+    // the offset cannot exceed the file end
+    if (start > m_Size || delta > m_Size - start)
+        m_Offset = m_Size;
+    else
+        m_Offset = start + delta;
+
+    return m_Offset;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_MappedFileBuffer::Read(void* pBuffer, std::size_t length)
+{
+    // no opened file or no destination buffer?
+    if (!m_pData || !pBuffer)
+        return 0;
+
+    // read at most the remaining data
+    if (length > m_Size - m_Offset)
+        length = m_Size - m_Offset;
+
+    std::memcpy(pBuffer, m_pData + m_Offset, length);
+    m_Offset += length;
+
+    return length;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_MappedFileBuffer::Write(const void*, std::size_t)
+{
+    // the file is always mapped read only, as Open() refuses the other modes, so nothing can be written.
+    // A writable mapping couldn't grow past the file size anyway, the files are written with the
+    // TSP_StdFileBuffer instead
+    return 0;
+}
+//---------------------------------------------------------------------------
+std::string TSP_MappedFileBuffer::ToStr()
+{
+    if (!m_pData)
+        return "";
+
+    return std::string(m_pData, m_Size);
+}
+//---------------------------------------------------------------------------
+bool TSP_MappedFileBuffer::Advise(IEAccess access)
+{
+    if (!m_pData)
+        return false;
+
+    #if defined (_WIN32)
+        // the system has no access pattern for a mapping, only the sequential content may be read ahead
+        if (access == IEAccess::IE_A_Sequential)
+            return WillNeed(0, m_Size);
+
+        return true;
+    #else
+        int advice;
+
+        switch (access)
+        {
+            case IEAccess::IE_A_Random:     advice = MADV_RANDOM;     break;
+            case IEAccess::IE_A_Sequential: advice = MADV_SEQUENTIAL; break;
+            default:                        advice = MADV_NORMAL;     break;
+        }
+
+        if (::madvise(const_cast<char*>(m_pData), m_Size, advice))
+            return false;
+
+        if (access == IEAccess::IE_A_Sequential)
+            return WillNeed(0, m_Size);
+
+        return true;
+    #endif
+}
+//---------------------------------------------------------------------------
+bool TSP_MappedFileBuffer::WillNeed(std::size_t offset, std::size_t length)
+{
+    if (!m_pData || offset >= m_Size)
+        return false;
+
+    // limit the part to the file end
+    if (length > m_Size - offset)
+        length = m_Size - offset;
+
+    #if defined (_WIN32)
+        #if defined (_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+            WIN32_MEMORY_RANGE_ENTRY range;
+            range.VirtualAddress = const_cast<char*>(m_pData + offset);
+            range.NumberOfBytes  = length;
+
+            return ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0) != 0;
+        #else
+            // not supported before Windows 8
+            return true;
+        #endif
+    #else
+        // the advised address should be aligned on a memory page
+        const std::size_t pageSize = std::size_t(::sysconf(_SC_PAGESIZE));
+        const std::size_t start    = offset - (offset % pageSize);
+
+        return !::madvise(const_cast<char*>(m_pData + start), length + (offset - start), MADV_WILLNEED);
+    #endif
+}
+//---------------------------------------------------------------------------
+void TSP_MappedFileBuffer::Close()
+{
+    #if defined (_WIN32)
+        if (m_pData)
+            ::UnmapViewOfFile(m_pData);
+
+        if (m_hMapping)
+            ::CloseHandle(m_hMapping);
+
+        if (m_hFile)
+            ::CloseHandle(m_hFile);
+
+        m_hMapping = nullptr;
+        m_hFile    = nullptr;
+    #else
+        if (m_pData)
+            ::munmap(const_cast<char*>(m_pData), m_Size);
+
+        if (m_File >= 0)
+            ::close(m_File);
+
+        m_File = -1;
+    #endif
+
+    m_pData  = nullptr;
+    m_Size   = 0;
+    m_Offset = 0;
+    m_Mode   = IEMode::IE_M_Unknown;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,174 @@
+/****************************************************************************
+ * ==> TSP_MappedFileBuffer ------------------------------------------------*
+ ****************************************************************************
+ * Description:  File buffer mapped in memory                               *
+ * Contained in: Common                                                     *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <string>
+
+// common classes
+#include "TSP_FileBuffer.h"
+
+/**
+* File buffer mapped in memory. The file content is read in place, without being copied, and the
+* system only loads the parts which are really accessed
+*@note The mapping is read only, the file should not be modified while it is opened
+*@author Jean-Milost Reymond
+*/
+class TSP_MappedFileBuffer : public TSP_FileBuffer
+{
+    public:
+        /**
+        * Content access patterns
+        */
+        enum class IEAccess
+        {
+            IE_A_Normal = 0,
+            IE_A_Random,
+            IE_A_Sequential
+        };
+
+        TSP_MappedFileBuffer();
+        virtual ~TSP_MappedFileBuffer();
+
+        /**
+        * Opens file in specified mode
+        *@param fileName - file name
+        *@param mode - opening mode, only IE_M_Read is supported
+        *@return true on success, otherwise false
+        */
+        virtual bool Open(const std::string&  fileName, IEMode mode);
+        virtual bool Open(const std::wstring& fileName, IEMode mode);
+
+        /**
+        * Clears buffer completely
+        */
+        virtual void Clear();
+
+        /**
+        * Checks if buffer is empty
+        *@return true if buffer is empty, otherwise false
+        */
+        virtual bool Empty();
+
+        /**
+        * Gets current offset position, in bytes
+        *@return current offset position, in bytes
+        */
+        virtual std::size_t GetOffset() const;
+
+        /**
+        * Gets data size, in bytes
+        *@return data size, in bytes
+        */
+        virtual std::size_t GetSize() const;
+
+        /**
+        * Seeks offset
+        *@param start - absolute start offset to seek from
+        *@param delta - number of bytes to seek from start offset, must be positive
+        *@return new offset position
+        */
+        virtual std::size_t Seek(std::size_t start, std::size_t delta);
+
+        /**
+        * Reads data from buffer
+        *@param pBuffer - destination buffer that will receive the read data
+        *@param length - length to read in source buffer
+        *@return read data length
+        *@note Data will be read from current offset
+        */
+        virtual std::size_t Read(void* pBuffer, std::size_t length);
+
+        /**
+        * Writes data into buffer
+        *@param pBuffer - source buffer to write from
+        *@param length - length to write from source buffer
+        *@return written data length, always 0 as the mapping is read only
+        */
+        virtual std::size_t Write(const void* pBuffer, std::size_t length);
+
+        /**
+        * Reads buffer content as string
+        *@return buffer content as string
+        */
+        virtual std::string ToStr();
+
+        /**
+        * Gets the mapped file content
+        *@return the file content, GetSize() bytes long, nullptr if no file is opened or if it is empty
+        *@note The content remains valid until the file is closed
+        */
+        virtual inline const void* GetData() const;
+
+        /**
+        * Advises the system how the content will be accessed
+        *@param access - access pattern
+        *@return true on success, otherwise false
+        *@note A sequential access also starts to read the whole content ahead
+        */
+        virtual bool Advise(IEAccess access);
+
+        /**
+        * Advises the system that a part of the content will be accessed soon, so it may be read ahead
+        *@param offset - part offset, in bytes
+        *@param length - part length, in bytes
+        *@return true on success, otherwise false
+        */
+        virtual bool WillNeed(std::size_t offset, std::size_t length);
+
+    protected:
+        /**
+        * Closes file
+        */
+        virtual void Close();
+
+    private:
+        const char* m_pData  = nullptr;
+        std::size_t m_Size   = 0;
+        std::size_t m_Offset = 0;
+
+        // the platform handles are kept opaque, so the system headers aren't required here
+        #if defined (_WIN32)
+            void* m_hFile    = nullptr;
+            void* m_hMapping = nullptr;
+        #else
+            int   m_File     = -1;
+        #endif
+};
+
+//---------------------------------------------------------------------------
+// TSP_MappedFileBuffer
+//---------------------------------------------------------------------------
+const void* TSP_MappedFileBuffer::GetData() const
+{
+    return m_pData;
+}
+//---------------------------------------------------------------------------
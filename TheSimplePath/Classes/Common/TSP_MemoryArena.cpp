@@ -0,0 +1,160 @@
+/****************************************************************************
+ * ==> TSP_MemoryArena -----------------------------------------------------*
+ ****************************************************************************
+ * Description:  Memory arena allocating small objects in contiguous blocks *
+ * Contained in: Common                                                     *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_MemoryArena.h"
+
+// std
+#include <algorithm>
+#include <new>
+
+//---------------------------------------------------------------------------
+// TSP_MemoryArena
+//---------------------------------------------------------------------------
+TSP_MemoryArena::TSP_MemoryArena(std::size_t blockSize) :
+    m_BlockSize(RoundSize(blockSize < 1024 ? 1024 : blockSize))
+{
+    // bigger chunks would waste too much memory at the end of each block, allocate them apart
+    m_MaxChunkSize = m_BlockSize / 8;
+    m_FreeLists.resize((m_MaxChunkSize / m_Alignment) + 1, nullptr);
+}
+//---------------------------------------------------------------------------
+TSP_MemoryArena::~TSP_MemoryArena()
+{
+    Clear();
+}
+//---------------------------------------------------------------------------
+void* TSP_MemoryArena::Allocate(std::size_t size)
+{
+    const std::size_t chunkSize = RoundSize(size ? size : 1);
+
+    // too big to be packed in a block?
+    if (chunkSize > m_MaxChunkSize)
+    {
+        char* pLargeBlock = static_cast<char*>(::operator new(chunkSize));
+
+        try
+        {
+            m_LargeBlocks.push_back(pLargeBlock);
+        }
+        catch (...)
+        {
+            ::operator delete(pLargeBlock);
+            throw;
+        }
+
+        m_Reserved += chunkSize;
+        return pLargeBlock;
+    }
+
+    const std::size_t sizeClass = chunkSize / m_Alignment;
+
+    // reuse a previously released chunk of the same size, if any
+    if (m_FreeLists[sizeClass])
+    {
+        IFreeChunk* pChunk      = m_FreeLists[sizeClass];
+        m_FreeLists[sizeClass] = pChunk->m_pNext;
+        return pChunk;
+    }
+
+    // no more room in the current block?
+    if (m_Remaining < chunkSize)
+    {
+        char* pBlock = static_cast<char*>(::operator new(m_BlockSize));
+
+        // release the block if it cannot be added to the list, otherwise it would leak
+        try
+        {
+            m_Blocks.push_back(pBlock);
+        }
+        catch (...)
+        {
+            ::operator delete(pBlock);
+            throw;
+        }
+
+        m_pCursor   = pBlock;
+        m_Remaining = m_BlockSize;
+        m_Reserved += m_BlockSize;
+    }
+
+    void* pData  = m_pCursor;
+    m_pCursor   += chunkSize;
+    m_Remaining -= chunkSize;
+
+    return pData;
+}
+//---------------------------------------------------------------------------
+void TSP_MemoryArena::Release(void* pData, std::size_t size)
+{
+    if (!pData)
+        return;
+
+    const std::size_t chunkSize = RoundSize(size ? size : 1);
+
+    // large chunks are returned to the system immediately
+    if (chunkSize > m_MaxChunkSize)
+    {
+        for (std::size_t i = 0; i < m_LargeBlocks.size(); ++i)
+            if (m_LargeBlocks[i] == pData)
+            {
+                m_LargeBlocks[i] = m_LargeBlocks.back();
+                m_LargeBlocks.pop_back();
+                m_Reserved -= chunkSize;
+                ::operator delete(pData);
+                return;
+            }
+
+        return;
+    }
+
+    const std::size_t sizeClass = chunkSize / m_Alignment;
+
+    // keep the chunk for the next allocation of the same size
+    IFreeChunk* pChunk      = new (pData) IFreeChunk();
+    pChunk->m_pNext         = m_FreeLists[sizeClass];
+    m_FreeLists[sizeClass] = pChunk;
+}
+//---------------------------------------------------------------------------
+void TSP_MemoryArena::Clear()
+{
+    for each (auto pBlock in m_Blocks)
+        ::operator delete(pBlock);
+
+    for each (auto pBlock in m_LargeBlocks)
+        ::operator delete(pBlock);
+
+    m_Blocks.clear();
+    m_LargeBlocks.clear();
+    std::fill(m_FreeLists.begin(), m_FreeLists.end(), nullptr);
+
+    m_pCursor   = nullptr;
+    m_Remaining = 0;
+    m_Reserved  = 0;
+}
+//---------------------------------------------------------------------------
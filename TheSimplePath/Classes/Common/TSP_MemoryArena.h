@@ -0,0 +1,128 @@
+/****************************************************************************
+ * ==> TSP_MemoryArena -----------------------------------------------------*
+ ****************************************************************************
+ * Description:  Memory arena allocating small objects in contiguous blocks *
+ * Contained in: Common                                                     *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <vector>
+
+/**
+* Memory arena, allocates small objects in large contiguous blocks and releases them all at once
+*@note Released memory is kept in a free list per size class and reused by the next allocations
+*      of the same size. The blocks are only returned to the system when the arena is cleared or
+*      destroyed. This class isn't thread safe
+*@author Jean-Milost Reymond
+*/
+class TSP_MemoryArena
+{
+    public:
+        /**
+        * Constructor
+        *@param blockSize - size of a memory block, in bytes
+        */
+        TSP_MemoryArena(std::size_t blockSize = 65536);
+
+        /**
+        * Destructor
+        */
+        virtual ~TSP_MemoryArena();
+
+        /**
+        * Allocates memory
+        *@param size - size to allocate, in bytes
+        *@return allocated memory, aligned on std::max_align_t
+        *@throw std::bad_alloc if memory could not be allocated
+        */
+        virtual void* Allocate(std::size_t size);
+
+        /**
+        * Releases memory previously allocated by this arena
+        *@param pData - memory to release
+        *@param size - size which was requested while the memory was allocated, in bytes
+        */
+        virtual void Release(void* pData, std::size_t size);
+
+        /**
+        * Releases all the blocks at once
+        *@note All the memory allocated by this arena becomes invalid, so any object living inside
+        *      should be destroyed before
+        */
+        virtual void Clear();
+
+        /**
+        * Gets the size of the memory currently reserved from the system
+        *@return reserved size, in bytes
+        */
+        virtual inline std::size_t GetReservedSize() const;
+
+    private:
+        /**
+        * Free memory chunk, linked in the free list of its size class
+        */
+        struct IFreeChunk
+        {
+            IFreeChunk* m_pNext = nullptr;
+        };
+
+        typedef std::vector<char*>       IBlocks;
+        typedef std::vector<IFreeChunk*> IFreeLists;
+
+        static const std::size_t m_Alignment = alignof(std::max_align_t);
+
+        IBlocks     m_Blocks;
+        IBlocks     m_LargeBlocks;
+        IFreeLists  m_FreeLists;
+        char*       m_pCursor      = nullptr;
+        std::size_t m_Remaining    = 0;
+        std::size_t m_BlockSize    = 0;
+        std::size_t m_MaxChunkSize = 0;
+        std::size_t m_Reserved     = 0;
+
+        /**
+        * Rounds a size to the next alignment boundary
+        *@param size - size to round
+        *@return rounded size
+        */
+        static inline std::size_t RoundSize(std::size_t size);
+};
+
+//---------------------------------------------------------------------------
+// TSP_MemoryArena
+//---------------------------------------------------------------------------
+std::size_t TSP_MemoryArena::GetReservedSize() const
+{
+    return m_Reserved;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_MemoryArena::RoundSize(std::size_t size)
+{
+    return (size + m_Alignment - 1) & ~(m_Alignment - 1);
+}
+//---------------------------------------------------------------------------
@@ -84,9 +84,9 @@ std::size_t TSP_MemoryBuffer::Seek(std::size_t start, std::size_t delta)
     const std::size_t dataSize = m_Data.size();
 
     // is offset out of bounds?
-    if (m_Offset >= dataSize)
+    if (m_Offset > dataSize)
         // extend data buffer to be able to contain data up to the offset
-        m_Data.resize((m_Offset + 1) - dataSize);
+        m_Data.resize(m_Offset);
 
     return m_Offset;
 }
@@ -150,7 +150,7 @@ std::size_t TSP_MemoryBuffer::Write(const void* pBuffer, std::size_t length)
     // is end offset out of bounds?
     if (endOffset > dataSize)
         // extend buffer to contain new data to write
-        m_Data.resize(endOffset - dataSize);
+        m_Data.resize(endOffset);
 
     // calculate length to copy
     const std::size_t lengthToCopy = endOffset - m_Offset;
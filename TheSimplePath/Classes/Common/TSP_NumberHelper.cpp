@@ -0,0 +1,101 @@
+/****************************************************************************
+ * ==> TSP_NumberHelper ----------------------------------------------------*
+ ****************************************************************************
+ * Description:  Helper class for numbers                                   *
+ * Contained in: Common                                                     *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_NumberHelper.h"
+
+//---------------------------------------------------------------------------
+// TSP_NumberHelper
+//---------------------------------------------------------------------------
+const char* TSP_NumberHelper::SkipPrefix(const char* pBegin, const char* pEnd)
+{
+    // skip the leading spaces, as std::stoi() does
+    while (pBegin < pEnd && (*pBegin == ' ' || (*pBegin >= '\t' && *pBegin <= '\r')))
+        ++pBegin;
+
+    // std::from_chars() doesn't accept the plus sign, skip it unless another sign follows
+    if (pBegin + 1 < pEnd && *pBegin == '+' && pBegin[1] != '+' && pBegin[1] != '-')
+        ++pBegin;
+
+    return pBegin;
+}
+//---------------------------------------------------------------------------
+bool TSP_NumberHelper::Narrow(const wchar_t*     pBegin,
+                              const wchar_t*     pEnd,
+                                    char*        pBuffer,
+                                    std::size_t& length,
+                              const wchar_t*&    pStart)
+{
+    length = 0;
+    pStart = pBegin;
+
+    if (!pBegin)
+        return true;
+
+    // skip the leading spaces
+    while (pBegin < pEnd && (*pBegin == L' ' || (*pBegin >= L'\t' && *pBegin <= L'\r')))
+        ++pBegin;
+
+    pStart = pBegin;
+
+    for (; pBegin < pEnd; ++pBegin)
+    {
+        const wchar_t c = *pBegin;
+
+        // stop on the first char which cannot belong to a number (digits, signs, decimal point,
+        // exponent, hexadecimal digits and inf or nan literals)
+        if (!((c >= L'0' && c <= L'9') ||
+              (c >= L'a' && c <= L'z') ||
+              (c >= L'A' && c <= L'Z') ||
+               c == L'+'               ||
+               c == L'-'               ||
+               c == L'.'))
+            break;
+
+        if (length == m_MaxLiteralLength)
+            return false;
+
+        pBuffer[length] = (char)c;
+        ++length;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+TSP_NumberHelper::IEResult TSP_NumberHelper::ToResult(std::errc error)
+{
+    // NOTE std::errc() isn't an enumerator, so it cannot be a case of a switch without a warning
+    if (error == std::errc())
+        return IEResult::IE_R_Success;
+
+    if (error == std::errc::result_out_of_range)
+        return IEResult::IE_R_OutOfRange;
+
+    return IEResult::IE_R_Invalid;
+}
+//---------------------------------------------------------------------------
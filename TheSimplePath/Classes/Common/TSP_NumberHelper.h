@@ -0,0 +1,213 @@
+/****************************************************************************
+ * ==> TSP_NumberHelper ----------------------------------------------------*
+ ****************************************************************************
+ * Description:  Helper class for numbers                                   *
+ * Contained in: Common                                                     *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <charconv>
+#include <string>
+#include <system_error>
+
+/**
+* Helper class for numbers
+*@note The conversions never throw, never allocate and never log, so they may be used to convert
+*      large amounts of text data, e.g. while importing or recomputing attributes
+*@author Jean-Milost Reymond
+*/
+class TSP_NumberHelper
+{
+    public:
+        /**
+        * Conversion result
+        */
+        enum class IEResult
+        {
+            IE_R_Success,
+            IE_R_Invalid,
+            IE_R_OutOfRange
+        };
+
+        /**
+        * Parses a number from a string
+        *@param pBegin - first char to parse
+        *@param pEnd - char following the last char to parse
+        *@param[out] value - parsed value, unchanged if the conversion failed
+        *@return conversion result
+        *@note Like the std::stoi() functions, the leading spaces and plus sign are skipped, and the
+        *      parsing stops on the first char which cannot belong to the number. The chars which may
+        *      follow the number are ignored, use the overload returning the end of the number to
+        *      reject them
+        */
+        template <class T>
+        static inline IEResult Parse(const char* pBegin, const char* pEnd, T& value);
+        template <class T>
+        static inline IEResult Parse(const wchar_t* pBegin, const wchar_t* pEnd, T& value);
+
+        /**
+        * Parses a number from a string, and gets where the number ends
+        *@param pBegin - first char to parse
+        *@param pEnd - char following the last char to parse
+        *@param[out] value - parsed value, unchanged if the conversion failed
+        *@param[out] pNext - char following the last char of the number, pBegin if no number was found
+        *@return conversion result
+        *@note The whole string is a valid number if the conversion succeeded and pNext equals pEnd
+        */
+        template <class T>
+        static IEResult Parse(const char* pBegin, const char* pEnd, T& value, const char*& pNext);
+        template <class T>
+        static IEResult Parse(const wchar_t* pBegin, const wchar_t* pEnd, T& value, const wchar_t*& pNext);
+
+        /**
+        * Parses a number from a string
+        *@param str - string to parse
+        *@param[out] value - parsed value, unchanged if the conversion failed
+        *@return conversion result
+        */
+        template <class T, class U>
+        static inline IEResult Parse(const std::basic_string<U>& str, T& value);
+
+        /**
+        * Converts a string to a number
+        *@param str - string to convert
+        *@param defVal - default value to return if the conversion failed
+        *@return converted number, default value on error
+        */
+        template <class T, class U>
+        static inline T StrToNum(const std::basic_string<U>& str, T defVal);
+
+    private:
+        static const std::size_t m_MaxLiteralLength = 128;
+
+        /**
+        * Skips the leading spaces and plus sign
+        *@param pBegin - first char to parse
+        *@param pEnd - char following the last char to parse
+        *@return first char belonging to the number
+        */
+        static const char* SkipPrefix(const char* pBegin, const char* pEnd);
+
+        /**
+        * Narrows an UTF-16 number literal to ASCII
+        *@param pBegin - first char to narrow
+        *@param pEnd - char following the last char to narrow
+        *@param[out] pBuffer - buffer to narrow to, should contain at least m_MaxLiteralLength chars
+        *@param[out] length - narrowed literal length
+        *@param[out] pStart - first narrowed char, after the leading spaces
+        *@return true on success, false if the literal is too long to be a number
+        *@note Only the leading chars which may belong to a number are narrowed, the conversion
+        *      itself is left to the char version, which validates them
+        */
+        static bool Narrow(const wchar_t*     pBegin,
+                           const wchar_t*     pEnd,
+                                 char*        pBuffer,
+                                 std::size_t& length,
+                           const wchar_t*&    pStart);
+
+        /**
+        * Gets the conversion result matching with a std::from_chars() error
+        *@param error - error to convert
+        *@return conversion result
+        */
+        static IEResult ToResult(std::errc error);
+};
+
+//---------------------------------------------------------------------------
+// TSP_NumberHelper
+//---------------------------------------------------------------------------
+template <class T>
+TSP_NumberHelper::IEResult TSP_NumberHelper::Parse(const char* pBegin, const char* pEnd, T& value)
+{
+    const char* pNext;
+    return Parse(pBegin, pEnd, value, pNext);
+}
+//---------------------------------------------------------------------------
+template <class T>
+TSP_NumberHelper::IEResult TSP_NumberHelper::Parse(const wchar_t* pBegin, const wchar_t* pEnd, T& value)
+{
+    const wchar_t* pNext;
+    return Parse(pBegin, pEnd, value, pNext);
+}
+//---------------------------------------------------------------------------
+template <class T>
+TSP_NumberHelper::IEResult TSP_NumberHelper::Parse(const char* pBegin, const char* pEnd, T& value, const char*& pNext)
+{
+    pNext = pBegin;
+
+    if (!pBegin || pBegin >= pEnd)
+        return IEResult::IE_R_Invalid;
+
+    const std::from_chars_result result = std::from_chars(SkipPrefix(pBegin, pEnd), pEnd, value);
+    const IEResult               status = ToResult(result.ec);
+
+    // on error, std::from_chars() only reports where the number ends if it was out of range
+    if (status != IEResult::IE_R_Invalid)
+        pNext = result.ptr;
+
+    return status;
+}
+//---------------------------------------------------------------------------
+template <class T>
+TSP_NumberHelper::IEResult TSP_NumberHelper::Parse(const wchar_t* pBegin, const wchar_t* pEnd, T& value, const wchar_t*& pNext)
+{
+    pNext = pBegin;
+
+    char           buffer[m_MaxLiteralLength];
+    std::size_t    length;
+    const wchar_t* pStart;
+
+    if (!Narrow(pBegin, pEnd, buffer, length, pStart))
+        return IEResult::IE_R_Invalid;
+
+    const char*    pNarrowNext;
+    const IEResult status = Parse(buffer, buffer + length, value, pNarrowNext);
+
+    // each narrowed char matches with one wide char
+    if (status != IEResult::IE_R_Invalid)
+        pNext = pStart + (pNarrowNext - buffer);
+
+    return status;
+}
+//---------------------------------------------------------------------------
+template <class T, class U>
+TSP_NumberHelper::IEResult TSP_NumberHelper::Parse(const std::basic_string<U>& str, T& value)
+{
+    return Parse(str.data(), str.data() + str.length(), value);
+}
+//---------------------------------------------------------------------------
+template <class T, class U>
+T TSP_NumberHelper::StrToNum(const std::basic_string<U>& str, T defVal)
+{
+    T value = defVal;
+
+    if (Parse(str, value) != IEResult::IE_R_Success)
+        return defVal;
+
+    return value;
+}
+//---------------------------------------------------------------------------
@@ -35,6 +35,10 @@
 // common classes
 #include "TSP_StringHelper.h"
 
+// system
+#include <sys/types.h>
+#include <sys/stat.h>
+
 //---------------------------------------------------------------------------
 // TSP_StdFileBuffer
 //---------------------------------------------------------------------------
@@ -54,19 +58,30 @@ bool TSP_StdFileBuffer::Open(const std::wstring& fileName, IEMode mode)
 //---------------------------------------------------------------------------
 bool TSP_StdFileBuffer::Open(const std::string& fileName, IEMode mode)
 {
+    // close the previously opened file
+    Close();
+
     // call base function to execute common stuffs
     if (!TSP_FileBuffer::Open(fileName, mode))
         return false;
 
     // open file stream
     #ifdef _MSC_VER
+        errno_t result;
+
         switch (m_Mode)
         {
-            case IEMode::IE_M_Read:  return !fopen_s(&m_FileBuffer, fileName.c_str(), "r+b");
-            case IEMode::IE_M_Write: return !fopen_s(&m_FileBuffer, fileName.c_str(), "w+b");
-            case IEMode::IE_M_RW:    return !fopen_s(&m_FileBuffer, fileName.c_str(), "rw+b");
+            case IEMode::IE_M_Read:  result = fopen_s(&m_FileBuffer, fileName.c_str(), "r+b");  break;
+            case IEMode::IE_M_Write: result = fopen_s(&m_FileBuffer, fileName.c_str(), "w+b");  break;
+            case IEMode::IE_M_RW:    result = fopen_s(&m_FileBuffer, fileName.c_str(), "rw+b"); break;
             default:                 return false;
         }
+
+        if (result)
+        {
+            m_FileBuffer = nullptr;
+            return false;
+        }
     #else
         switch (m_Mode)
         {
@@ -76,8 +91,36 @@ bool TSP_StdFileBuffer::Open(const std::string& fileName, IEMode mode)
             default:                 return false;
         }
 
-        return m_FileBuffer;
+        if (!m_FileBuffer)
+            return false;
+    #endif
+
+    // the stream cache should be set before the first read or write
+    if (m_CacheSize)
+    {
+        m_Cache.resize(m_CacheSize);
+        std::setvbuf(m_FileBuffer, m_Cache.data(), _IOFBF, m_Cache.size());
+    }
+
+    // get the file size once, it is then updated while the file is written
+    #ifdef _MSC_VER
+        struct _stat64 info;
+
+        if (_fstat64(_fileno(m_FileBuffer), &info) || info.st_size < 0)
+    #else
+        struct stat info;
+
+        if (::fstat(fileno(m_FileBuffer), &info) || info.st_size < 0)
     #endif
+    {
+        Close();
+        return false;
+    }
+
+    m_Size   = std::size_t(info.st_size);
+    m_Offset = 0;
+
+    return true;
 }
 //---------------------------------------------------------------------------
 void TSP_StdFileBuffer::Clear()
@@ -87,42 +130,17 @@ void TSP_StdFileBuffer::Clear()
 //---------------------------------------------------------------------------
 bool TSP_StdFileBuffer::Empty()
 {
-    return (!m_FileBuffer || !GetSize());
+    return (!m_FileBuffer || !m_Size);
 }
 //---------------------------------------------------------------------------
 std::size_t TSP_StdFileBuffer::GetOffset() const
 {
-    // is file opened?
-    if (!m_FileBuffer)
-        return 0;
-
-    // get current offset
-    return std::ftell(m_FileBuffer);
+    return m_Offset;
 }
 //---------------------------------------------------------------------------
 std::size_t TSP_StdFileBuffer::GetSize() const
 {
-    // is file opened?
-    if (!m_FileBuffer)
-        return 0;
-
-    // keep current position
-    const std::size_t curPos = std::ftell(m_FileBuffer);
-
-    // get file size
-    #ifdef _MSC_VER
-        _fseeki64(m_FileBuffer, 0, SEEK_END);
-    #else
-        std::fseek(m_FileBuffer, 0, SEEK_END);
-    #endif
-    const std::size_t fileSize = std::ftell(m_FileBuffer);
-    #ifdef _MSC_VER
-        _fseeki64(m_FileBuffer, curPos, SEEK_SET);
-    #else
-        std::fseek(m_FileBuffer, curPos, SEEK_SET);
-    #endif
-
-    return fileSize;
+    return m_Size;
 }
 //---------------------------------------------------------------------------
 std::size_t TSP_StdFileBuffer::Seek(std::size_t start, std::size_t delta)
@@ -131,58 +149,22 @@ std::size_t TSP_StdFileBuffer::Seek(std::size_t start, std::size_t delta)
     if (!m_FileBuffer)
         return 0;
 
-    // from file start?
-    if (!start)
-    {
-        // no delta to seek to?
-        if (!delta)
-        {
-            // seek to file beginning
-            #ifdef _MSC_VER
-                _fseeki64(m_FileBuffer, 0, SEEK_SET);
-            #else
-                std::fseek(m_FileBuffer, 0, SEEK_SET);
-            #endif
-            return 0L;
-        }
+    const std::size_t offset = start + delta;
 
-        // seek to final position
-        #ifdef _MSC_VER
-            _fseeki64(m_FileBuffer, delta, SEEK_SET);
-        #else
-            std::fseek(m_FileBuffer, delta, SEEK_SET);
-        #endif
-        return delta;
-    }
-
-    // get current offset
-    const std::size_t offset = GetOffset();
-
-    std::size_t startDelta;
-
-    // do seek to start position?
-    if (offset != start)
-    {
-        // calculate seek to start delta
-        startDelta = start - offset;
-
-        #ifdef _MSC_VER
-            _fseeki64(m_FileBuffer, startDelta, SEEK_CUR);
-        #else
-            std::fseek(m_FileBuffer, startDelta, SEEK_CUR);
-        #endif
-    }
-    else
-        startDelta = 0;
-
-    // seek to final position
+    // seek to final position. NOTE the seek is always done, even if the offset doesn't change, as
+    // it is required between a read and a write
     #ifdef _MSC_VER
-        _fseeki64(m_FileBuffer, delta, SEEK_CUR);
+        if (_fseeki64(m_FileBuffer, offset, SEEK_SET))
+            return m_Offset;
     #else
-        std::fseek(m_FileBuffer, delta, SEEK_CUR);
+        // NOTE fseek() takes a long offset, which may be 32 bit and would truncate the offsets above 2GB
+        if (::fseeko(m_FileBuffer, off_t(offset), SEEK_SET))
+            return m_Offset;
     #endif
 
-    return offset + startDelta + delta;
+    m_Offset = offset;
+
+    return m_Offset;
 }
 //---------------------------------------------------------------------------
 std::size_t TSP_StdFileBuffer::Read(void* pBuffer, std::size_t length)
@@ -199,52 +181,12 @@ std::size_t TSP_StdFileBuffer::Read(void* pBuffer, std::size_t length)
     if (!pBuffer)
         return 0;
 
-    // no length to copy?
-    if (!length)
-        return 0;
-
-    // create temporary data buffer
-    std::uint8_t* pData = new std::uint8_t[length];
-
-    try
-    {
-        // iterate through char to copy
-        for (std::size_t i = 0; i < length; ++i)
-        {
-            // read next char
-            std::int32_t c = std::getc(m_FileBuffer);
-
-            // end of file reached?
-            if (c == EOF)
-            {
-                if (!i)
-                    return 0;
-
-                // copy to final buffer
-                std::memcpy(pBuffer, pData, i);
-
-                return i;
-            }
-
-            // read next char and copy to buffer
-            pData[i] = c;
-        }
-
-        // copy to final buffer
-        std::memcpy(pBuffer, pData, length);
-    }
-    catch (...)
-    {
-        if (pData)
-            delete[] pData;
-
-        return 0;
-    }
+    // read the whole block at once, the stream reads the large blocks directly in the destination
+    const std::size_t read = std::fread(pBuffer, 1, length, m_FileBuffer);
 
-    if (pData)
-        delete[] pData;
+    m_Offset += read;
 
-    return length;
+    return read;
 }
 //---------------------------------------------------------------------------
 std::size_t TSP_StdFileBuffer::Write(const void* pBuffer, std::size_t length)
@@ -257,8 +199,20 @@ std::size_t TSP_StdFileBuffer::Write(const void* pBuffer, std::size_t length)
     if (m_Mode != IEMode::IE_M_Write && m_Mode != IEMode::IE_M_RW)
         return 0;
 
-    // write buffer and return successfully written bytes
-    return std::fwrite(pBuffer, length, 1, m_FileBuffer);
+    // no source buffer?
+    if (!pBuffer)
+        return 0;
+
+    // write buffer and get successfully written bytes
+    const std::size_t written = std::fwrite(pBuffer, 1, length, m_FileBuffer);
+
+    m_Offset += written;
+
+    // update the cached size if the file grew
+    if (m_Offset > m_Size)
+        m_Size = m_Offset;
+
+    return written;
 }
 //---------------------------------------------------------------------------
 std::string TSP_StdFileBuffer::ToStr()
@@ -271,20 +225,27 @@ std::string TSP_StdFileBuffer::ToStr()
     if (m_Mode != IEMode::IE_M_Read && m_Mode != IEMode::IE_M_RW)
         return "";
 
-    // get buffer size
-    const std::size_t size = GetSize();
-
     // seek to start
     Seek(0, 0);
 
     std::string str;
-    str.resize(size);
+    str.resize(m_Size);
 
-    Read(&str[0], size);
+    // the file may be shorter than expected, e.g. if it was modified meanwhile
+    str.resize(Read(&str[0], m_Size));
 
     return str;
 }
 //---------------------------------------------------------------------------
+bool TSP_StdFileBuffer::Flush()
+{
+    // is file open?
+    if (!m_FileBuffer)
+        return false;
+
+    return !std::fflush(m_FileBuffer);
+}
+//---------------------------------------------------------------------------
 void TSP_StdFileBuffer::Close()
 {
     // is file open?
@@ -293,5 +254,8 @@ void TSP_StdFileBuffer::Close()
 
     // close file
     std::fclose(m_FileBuffer);
+    m_FileBuffer = nullptr;
+    m_Size       = 0;
+    m_Offset     = 0;
 }
 //---------------------------------------------------------------------------
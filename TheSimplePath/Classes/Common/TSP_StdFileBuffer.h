@@ -31,17 +31,22 @@
 
 // std
 #include <cstdio>
+#include <vector>
 
 // common classes
 #include "TSP_FileBuffer.h"
 
 /**
 * File buffer based on std library
+*@note The file is read and written by blocks through the stream cache, and its size is cached
+*      while it is opened
 *@author Jean-Milost Reymond
 */
 class TSP_StdFileBuffer : public TSP_FileBuffer
 {
     public:
+        static const std::size_t m_DefCacheSize = 65536;
+
         /**
         * Constructor
         */
@@ -116,6 +121,19 @@ class TSP_StdFileBuffer : public TSP_FileBuffer
         */
         virtual std::string ToStr();
 
+        /**
+        * Sets the stream cache size
+        *@param size - cache size, in bytes, 0 to use the std library default cache
+        *@note Applied the next time a file is opened
+        */
+        virtual inline void SetCacheSize(std::size_t size);
+
+        /**
+        * Flushes the stream cache to the file
+        *@return true on success, otherwise false
+        */
+        virtual bool Flush();
+
     protected:
         std::FILE* m_FileBuffer = nullptr;
 
@@ -123,4 +141,19 @@ class TSP_StdFileBuffer : public TSP_FileBuffer
         * Closes file
         */
         virtual void Close();
+
+    private:
+        std::vector<char> m_Cache;
+        std::size_t       m_CacheSize = m_DefCacheSize;
+        std::size_t       m_Size      = 0;
+        std::size_t       m_Offset    = 0;
 };
+
+//---------------------------------------------------------------------------
+// TSP_StdFileBuffer
+//---------------------------------------------------------------------------
+void TSP_StdFileBuffer::SetCacheSize(std::size_t size)
+{
+    m_CacheSize = size;
+}
+//---------------------------------------------------------------------------
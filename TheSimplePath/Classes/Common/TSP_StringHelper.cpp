@@ -30,137 +30,2115 @@
 #include "TSP_StringHelper.h"
 
 // std
+#include <algorithm>
 #include <clocale>
-#include <codecvt>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
- //---------------------------------------------------------------------------
- // TSP_StringHelper
- //---------------------------------------------------------------------------
-std::string TSP_StringHelper::SetLocale_ThreadSafe(std::int32_t category, const char* pLocale)
+//---------------------------------------------------------------------------
+// Global defines
+//---------------------------------------------------------------------------
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define M_X86_StringHelper
+
+    #ifdef _MSC_VER
+        #include <intrin.h>
+
+        // MSVC accepts the intrinsics of any instruction set without special function attributes
+        #define M_Target_Sse2
+        #define M_Target_Avx2
+    #else
+        #include <immintrin.h>
+
+        #define M_Target_Sse2 __attribute__((target("sse2")))
+        #define M_Target_Avx2 __attribute__((target("avx2")))
+    #endif
+#endif
+
+//---------------------------------------------------------------------------
+// TSP_StringHelper::IScalar
+//---------------------------------------------------------------------------
+/**
+* Scalar string functions, used when no vector instruction set is available, and for the chars
+* remaining after the last vector block
+*/
+class TSP_StringHelper::IScalar
 {
-    static std::mutex lockMutex;
+    public:
+        /**
+        * Unsigned integer type matching a char type
+        */
+        template <class T>
+        using IUnit = typename std::conditional<sizeof(T) == 1, std::uint8_t,
+                      typename std::conditional<sizeof(T) == 2, std::uint16_t, std::uint32_t>::type>::type;
 
-    // lock up the thread
-    std::unique_lock<std::mutex> lock(lockMutex);
+        /**
+        * Widens the ASCII chars starting an UTF-8 string
+        *@param pStr - UTF-8 string
+        *@param length - string length, in bytes
+        *@param[out] pResult - result receiving the widened chars
+        *@return widened char count, i.e. the index of the first non-ASCII char
+        */
+        template <class T>
+        static std::size_t WidenAscii(const char* pStr, std::size_t length, T* pResult);
 
-    // change the locale and get the previous one
-    const char* pRes = std::setlocale(category, pLocale);
+        /**
+        * Narrows the ASCII chars starting an UTF-16 or UTF-32 string
+        *@param pStr - string
+        *@param length - string length, in chars
+        *@param[out] pResult - result receiving the narrowed chars
+        *@return narrowed char count, i.e. the index of the first non-ASCII char
+        */
+        template <class T>
+        static std::size_t NarrowAscii(const T* pStr, std::size_t length, char* pResult);
 
-    return pRes ? std::string(pRes) : std::string();
+        /**
+        * Counts the sequences contained in an UTF-8 string
+        *@param pStr - UTF-8 string
+        *@param length - string length, in bytes
+        *@param[in, out] leadCount - lead byte count, i.e. the code point count
+        *@param[in, out] longCount - count of the 4 bytes long sequences, encoded as surrogate pairs in UTF-16
+        */
+        static void CountUtf8(const char*        pStr,
+                                    std::size_t  length,
+                                    std::size_t& leadCount,
+                                    std::size_t& longCount);
+
+        /**
+        * Gets the length of an UTF-16 or UTF-32 string once converted to UTF-8
+        *@param pStr - string
+        *@param length - string length, in chars
+        *@return the converted string length, in bytes
+        */
+        template <class T>
+        static std::size_t GetUtf8Length(const T* pStr, std::size_t length);
+
+        /**
+        * Converts the ASCII chars starting a string to lower or upper case, in place
+        *@param[in, out] pStr - string
+        *@param length - string length, in chars
+        *@param upper - if true, the chars are converted to upper case, otherwise to lower case
+        *@return converted char count, i.e. the index of the first non-ASCII char
+        */
+        template <class T>
+        static std::size_t MapAscii(T* pStr, std::size_t length, bool upper);
+
+        /**
+        * Counts the bits set in a mask
+        *@param mask - mask
+        *@return set bit count
+        */
+        static inline std::size_t PopCount(std::uint32_t mask);
+};
+//---------------------------------------------------------------------------
+template <class T>
+std::size_t TSP_StringHelper::IScalar::WidenAscii(const char* pStr, std::size_t length, T* pResult)
+{
+    const std::uint8_t* pBytes = reinterpret_cast<const std::uint8_t*>(pStr);
+          std::size_t   i      = 0;
+
+    // check 8 chars at once
+    for (; i + 8 <= length; i += 8)
+    {
+        std::uint64_t block;
+        std::memcpy(&block, pBytes + i, sizeof(block));
+
+        if (block & 0x8080808080808080ULL)
+            break;
+
+        for (std::size_t j = 0; j < 8; ++j)
+            pResult[i + j] = T(pBytes[i + j]);
+    }
+
+    for (; i < length && pBytes[i] < 0x80; ++i)
+        pResult[i] = T(pBytes[i]);
+
+    return i;
 }
 //---------------------------------------------------------------------------
-std::string TSP_StringHelper::ToLowerCase(const std::string& str)
+template <class T>
+std::size_t TSP_StringHelper::IScalar::NarrowAscii(const T* pStr, std::size_t length, char* pResult)
 {
-    std::string lowerStr;
+    std::size_t i = 0;
 
-    // save current locale
-    const std::string loc = SetLocale_ThreadSafe(LC_ALL, nullptr);
+    for (; i < length && IUnit<T>(pStr[i]) < 0x80; ++i)
+        pResult[i] = char(pStr[i]);
+
+    return i;
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::IScalar::CountUtf8(const char*        pStr,
+                                                std::size_t  length,
+                                                std::size_t& leadCount,
+                                                std::size_t& longCount)
+{
+    const std::uint8_t* pBytes = reinterpret_cast<const std::uint8_t*>(pStr);
 
-    try
+    for (std::size_t i = 0; i < length; ++i)
     {
-        for each (auto c in str)
-            lowerStr += ::tolower(c);
+        // every byte which isn't a continuation one starts a new code point
+        leadCount += (pBytes[i] & 0xC0) != 0x80;
+        longCount +=  pBytes[i] >= 0xF0;
     }
-    catch (...)
+}
+//---------------------------------------------------------------------------
+template <class T>
+std::size_t TSP_StringHelper::IScalar::GetUtf8Length(const T* pStr, std::size_t length)
+{
+    std::size_t result = length;
+
+    for (std::size_t i = 0; i < length; ++i)
     {
-        // restore locale
-        SetLocale_ThreadSafe(LC_ALL, loc.c_str());
-        throw;
+        const std::uint32_t c = IUnit<T>(pStr[i]);
+
+        result += (c >= 0x80) + (c >= 0x800);
+
+        // a surrogate pair is converted to 4 bytes, i.e 2 bytes per surrogate
+        if (sizeof(T) == 2)
+            result -= (c & 0xF800) == 0xD800;
+        else
+            result += c >= 0x10000;
     }
 
-    // restore locale
-    SetLocale_ThreadSafe(LC_ALL, loc.c_str());
+    return result;
+}
+//---------------------------------------------------------------------------
+template <class T>
+std::size_t TSP_StringHelper::IScalar::MapAscii(T* pStr, std::size_t length, bool upper)
+{
+    const std::uint32_t first = upper ? 'a' : 'A';
+          std::size_t   i     = 0;
+
+    for (; i < length; ++i)
+    {
+        const std::uint32_t c = IUnit<T>(pStr[i]);
+
+        if (c >= 0x80)
+            break;
 
-    return lowerStr;
+        // the ASCII letter case is given by the bit 5
+        if (c - first < 26)
+            pStr[i] = T(c ^ 0x20);
+    }
+
+    return i;
 }
 //---------------------------------------------------------------------------
-std::wstring TSP_StringHelper::ToLowerCase(const std::wstring& str)
+inline std::size_t TSP_StringHelper::IScalar::PopCount(std::uint32_t mask)
 {
-    std::wstring lowerStr;
+    mask = mask - ((mask >> 1) & 0x55555555);
+    mask = (mask & 0x33333333) + ((mask >> 2) & 0x33333333);
+    mask = (mask + (mask >> 4)) & 0x0F0F0F0F;
 
-    // save current locale
-    const std::string loc = SetLocale_ThreadSafe(LC_ALL, nullptr);
+    return (mask * 0x01010101) >> 24;
+}
+//---------------------------------------------------------------------------
+#ifdef M_X86_StringHelper
+//---------------------------------------------------------------------------
+// TSP_StringHelper::ISse2
+//---------------------------------------------------------------------------
+/**
+* SSE2 string functions, process 16 bytes at once
+*/
+class TSP_StringHelper::ISse2
+{
+    public:
+        /**
+        * Widens the ASCII chars starting an UTF-8 string
+        *@param pStr - UTF-8 string
+        *@param length - string length, in bytes
+        *@param[out] pResult - result receiving the widened chars
+        *@return widened char count, i.e. the index of the first non-ASCII char
+        *@note A whole block is always written, the result should be large enough to receive 16 chars
+        *      more than the string length
+        */
+        template <class T>
+        M_Target_Sse2 static std::size_t WidenAscii(const char* pStr, std::size_t length, T* pResult);
+
+        /**
+        * Narrows the ASCII chars starting an UTF-16 or UTF-32 string
+        *@param pStr - string
+        *@param length - string length, in chars
+        *@param[out] pResult - result receiving the narrowed chars
+        *@return narrowed char count, i.e. the index of the first non-ASCII char
+        *@note A whole block is always written, this is safe as long as the result is large enough to
+        *      receive the whole converted string, in which each non-ASCII char takes 2 bytes or more
+        */
+        template <class T>
+        M_Target_Sse2 static std::size_t NarrowAscii(const T* pStr, std::size_t length, char* pResult);
+
+        /**
+        * Counts the sequences contained in an UTF-8 string
+        *@param pStr - UTF-8 string
+        *@param length - string length, in bytes
+        *@param[in, out] leadCount - lead byte count, i.e. the code point count
+        *@param[in, out] longCount - count of the 4 bytes long sequences, encoded as surrogate pairs in UTF-16
+        */
+        M_Target_Sse2 static void CountUtf8(const char*        pStr,
+                                                  std::size_t  length,
+                                                  std::size_t& leadCount,
+                                                  std::size_t& longCount);
+
+        /**
+        * Gets the length of an UTF-16 or UTF-32 string once converted to UTF-8
+        *@param pStr - string
+        *@param length - string length, in chars
+        *@return the converted string length, in bytes
+        */
+        template <class T>
+        M_Target_Sse2 static std::size_t GetUtf8Length(const T* pStr, std::size_t length);
+
+        /**
+        * Converts the ASCII chars starting a string to lower or upper case, in place
+        *@param[in, out] pStr - string
+        *@param length - string length, in chars
+        *@param upper - if true, the chars are converted to upper case, otherwise to lower case
+        *@return converted char count, i.e. the index of the first non-ASCII char
+        *@note The ASCII letters following the first non-ASCII char in the same block are also converted
+        */
+        template <class T>
+        M_Target_Sse2 static std::size_t MapAscii(T* pStr, std::size_t length, bool upper);
 
-    try
+        /**
+        * Gets the index of the lowest bit set in a mask
+        *@param mask - mask, should not be 0
+        *@return the lowest set bit index
+        */
+        static inline std::size_t CountTrailingZeros(std::uint32_t mask);
+};
+//---------------------------------------------------------------------------
+template <class T>
+std::size_t TSP_StringHelper::ISse2::WidenAscii(const char* pStr, std::size_t length, T* pResult)
+{
+    const __m128i     zero = _mm_setzero_si128();
+          std::size_t i    = 0;
+
+    for (; i + 16 <= length; i += 16)
     {
-        for each (auto c in str)
-            lowerStr += ::towlower(c);
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + i));
+        const __m128i low   = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i high  = _mm_unpackhi_epi8(bytes, zero);
+
+        // the block is written before being checked, the chars following the first non-ASCII one
+        // will be overwritten by the caller
+        if (sizeof(T) == 2)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pResult + i),     low);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pResult + i + 8), high);
+        }
+        else
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pResult + i),      _mm_unpacklo_epi16(low,  zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pResult + i + 4),  _mm_unpackhi_epi16(low,  zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pResult + i + 8),  _mm_unpacklo_epi16(high, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pResult + i + 12), _mm_unpackhi_epi16(high, zero));
+        }
+
+        const std::uint32_t mask = std::uint32_t(_mm_movemask_epi8(bytes));
+
+        if (mask)
+            return i + CountTrailingZeros(mask);
     }
-    catch (...)
+
+    return i + IScalar::WidenAscii(pStr + i, length - i, pResult + i);
+}
+//---------------------------------------------------------------------------
+template <class T>
+std::size_t TSP_StringHelper::ISse2::NarrowAscii(const T* pStr, std::size_t length, char* pResult)
+{
+    const __m128i     nonAscii = _mm_set1_epi16(short(0xFF80));
+    const __m128i     zero     = _mm_setzero_si128();
+          std::size_t i        = 0;
+
+    for (; i + 16 <= length; i += 16)
     {
-        // restore locale
-        SetLocale_ThreadSafe(LC_ALL, loc.c_str());
-        throw;
+        __m128i low;
+        __m128i high;
+
+        if (sizeof(T) == 2)
+        {
+            low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + i));
+            high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + i + 8));
+        }
+        else
+        {
+            // the signed saturation keeps the non-ASCII chars out of the ASCII range
+            low  = _mm_packs_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + i)),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + i + 4)));
+            high = _mm_packs_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + i + 8)),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + i + 12)));
+        }
+
+        // the block is written before being checked, the chars following the first non-ASCII one
+        // will be overwritten by the caller, and will take at least 2 bytes once converted
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pResult + i), _mm_packus_epi16(low, high));
+
+        const std::uint32_t mask =  std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(low,  nonAscii), zero))) |
+                                   (std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(high, nonAscii), zero))) << 16);
+
+        if (mask != 0xFFFFFFFF)
+            return i + (CountTrailingZeros(~mask) >> 1);
     }
 
-    // restore locale
-    SetLocale_ThreadSafe(LC_ALL, loc.c_str());
+    return i + IScalar::NarrowAscii(pStr + i, length - i, pResult + i);
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::ISse2::CountUtf8(const char*        pStr,
+                                              std::size_t  length,
+                                              std::size_t& leadCount,
+                                              std::size_t& longCount)
+{
+    // as signed bytes, the continuation bytes are below -64 and the 4 bytes leads above -17
+    const __m128i     continuation = _mm_set1_epi8(-65);
+    const __m128i     longLead     = _mm_set1_epi8(-17);
+    const __m128i     zero         = _mm_setzero_si128();
+          std::size_t i            = 0;
+
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + i));
+        const __m128i leads = _mm_cmpgt_epi8(bytes, continuation);
+        const __m128i longs = _mm_and_si128(_mm_cmpgt_epi8(bytes, longLead), _mm_cmplt_epi8(bytes, zero));
+
+        leadCount += IScalar::PopCount(std::uint32_t(_mm_movemask_epi8(leads)));
+        longCount += IScalar::PopCount(std::uint32_t(_mm_movemask_epi8(longs)));
+    }
 
-    return lowerStr;
+    IScalar::CountUtf8(pStr + i, length - i, leadCount, longCount);
 }
 //---------------------------------------------------------------------------
-std::string TSP_StringHelper::ToUpperCase(const std::string& str)
+template <class T>
+std::size_t TSP_StringHelper::ISse2::GetUtf8Length(const T* pStr, std::size_t length)
 {
-    std::string upperStr;
+    const __m128i     zero   = _mm_setzero_si128();
+          std::size_t i      = 0;
+          std::size_t result = 0;
 
-    // save current locale
-    const std::string loc = SetLocale_ThreadSafe(LC_ALL, nullptr);
+    // the comparison masks contain one bit per byte, their bit counts are divided by the char size
+    if (sizeof(T) == 2)
+    {
+        const __m128i oneByte   = _mm_set1_epi16(short(0xFF80));
+        const __m128i twoBytes  = _mm_set1_epi16(short(0xF800));
+        const __m128i surrogate = _mm_set1_epi16(short(0xD800));
+
+        for (; i + 8 <= length; i += 8)
+        {
+            const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + i));
+            const __m128i high  = _mm_and_si128(chars, twoBytes);
 
-    try
+            const std::size_t ascii       = IScalar::PopCount(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chars, oneByte), zero)));
+            const std::size_t twoBytesMax = IScalar::PopCount(_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)));
+            const std::size_t surrogates  = IScalar::PopCount(_mm_movemask_epi8(_mm_cmpeq_epi16(high, surrogate)));
+
+            // 3 bytes per char, minus 1 per char below 0x800, 1 more per ASCII char and 1 per surrogate
+            result += 24 - ((ascii + twoBytesMax + surrogates) >> 1);
+        }
+    }
+    else
     {
-        for each (auto c in str)
-            upperStr += ::toupper(c);
+        const __m128i oneByte    = _mm_set1_epi32(int(0xFFFFFF80));
+        const __m128i twoBytes   = _mm_set1_epi32(int(0xFFFFF800));
+        const __m128i threeBytes = _mm_set1_epi32(int(0xFFFF0000));
+
+        for (; i + 4 <= length; i += 4)
+        {
+            const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + i));
+
+            const std::size_t ascii = IScalar::PopCount(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(chars, oneByte),    zero)));
+            const std::size_t two   = IScalar::PopCount(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(chars, twoBytes),   zero)));
+            const std::size_t three = IScalar::PopCount(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(chars, threeBytes), zero)));
+
+            result += 16 - ((ascii + two + three) >> 2);
+        }
     }
-    catch (...)
+
+    return result + IScalar::GetUtf8Length(pStr + i, length - i);
+}
+//---------------------------------------------------------------------------
+template <class T>
+std::size_t TSP_StringHelper::ISse2::MapAscii(T* pStr, std::size_t length, bool upper)
+{
+    const std::size_t count   = 16 / sizeof(T);
+    const int         first   = upper ? 'a' : 'A';
+    const __m128i     caseBit = sizeof(T) == 1 ? _mm_set1_epi8(0x20) :
+                                (sizeof(T) == 2 ? _mm_set1_epi16(0x20) : _mm_set1_epi32(0x20));
+    const __m128i     zero    = _mm_setzero_si128();
+          std::size_t i       = 0;
+
+    for (; i + count <= length; i += count)
     {
-        // restore locale
-        SetLocale_ThreadSafe(LC_ALL, loc.c_str());
-        throw;
+        const __m128i       chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pStr + i));
+              __m128i       letters;
+              std::uint32_t ascii;
+
+        // as signed values, the non-ASCII chars are never between the first and last letter
+        if (sizeof(T) == 1)
+        {
+            letters = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(char(first - 1))),
+                                    _mm_cmplt_epi8(chars, _mm_set1_epi8(char(first + 26))));
+            ascii   = ~std::uint32_t(_mm_movemask_epi8(chars)) & 0xFFFF;
+        }
+        else
+        if (sizeof(T) == 2)
+        {
+            letters = _mm_and_si128(_mm_cmpgt_epi16(chars, _mm_set1_epi16(short(first - 1))),
+                                    _mm_cmplt_epi16(chars, _mm_set1_epi16(short(first + 26))));
+            ascii   = std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chars, _mm_set1_epi16(short(0xFF80))), zero)));
+        }
+        else
+        {
+            letters = _mm_and_si128(_mm_cmpgt_epi32(chars, _mm_set1_epi32(first - 1)),
+                                    _mm_cmplt_epi32(chars, _mm_set1_epi32(first + 26)));
+            ascii   = std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(chars, _mm_set1_epi32(int(0xFFFFFF80))), zero)));
+        }
+
+        // the ASCII letter case is given by the bit 5, the non-ASCII chars are written unchanged
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pStr + i), _mm_xor_si128(chars, _mm_and_si128(letters, caseBit)));
+
+        if (ascii != 0xFFFF)
+            return i + CountTrailingZeros(~ascii) / sizeof(T);
     }
 
-    // restore locale
-    SetLocale_ThreadSafe(LC_ALL, loc.c_str());
+    return i + IScalar::MapAscii(pStr + i, length - i, upper);
+}
+//---------------------------------------------------------------------------
+inline std::size_t TSP_StringHelper::ISse2::CountTrailingZeros(std::uint32_t mask)
+{
+    #ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+    #else
+        return __builtin_ctz(mask);
+    #endif
+}
+//---------------------------------------------------------------------------
+// TSP_StringHelper::IAvx2
+//---------------------------------------------------------------------------
+/**
+* AVX2 string functions, process 32 bytes at once
+*/
+class TSP_StringHelper::IAvx2
+{
+    public:
+        /**
+        * Widens the ASCII chars starting an UTF-8 string
+        *@param pStr - UTF-8 string
+        *@param length - string length, in bytes
+        *@param[out] pResult - result receiving the widened chars
+        *@return widened char count, i.e. the index of the first non-ASCII char
+        *@note A whole block is always written, the result should be large enough to receive 32 chars
+        *      more than the string length
+        */
+        template <class T>
+        M_Target_Avx2 static std::size_t WidenAscii(const char* pStr, std::size_t length, T* pResult);
+
+        /**
+        * Narrows the ASCII chars starting an UTF-16 or UTF-32 string
+        *@param pStr - string
+        *@param length - string length, in chars
+        *@param[out] pResult - result receiving the narrowed chars
+        *@return narrowed char count, i.e. the index of the first non-ASCII char
+        *@note A whole block is always written, this is safe as long as the result is large enough to
+        *      receive the whole converted string, in which each non-ASCII char takes 2 bytes or more
+        */
+        template <class T>
+        M_Target_Avx2 static std::size_t NarrowAscii(const T* pStr, std::size_t length, char* pResult);
+
+        /**
+        * Counts the sequences contained in an UTF-8 string
+        *@param pStr - UTF-8 string
+        *@param length - string length, in bytes
+        *@param[in, out] leadCount - lead byte count, i.e. the code point count
+        *@param[in, out] longCount - count of the 4 bytes long sequences, encoded as surrogate pairs in UTF-16
+        */
+        M_Target_Avx2 static void CountUtf8(const char*        pStr,
+                                                  std::size_t  length,
+                                                  std::size_t& leadCount,
+                                                  std::size_t& longCount);
+
+        /**
+        * Gets the length of an UTF-16 or UTF-32 string once converted to UTF-8
+        *@param pStr - string
+        *@param length - string length, in chars
+        *@return the converted string length, in bytes
+        */
+        template <class T>
+        M_Target_Avx2 static std::size_t GetUtf8Length(const T* pStr, std::size_t length);
+
+        /**
+        * Converts the ASCII chars starting a string to lower or upper case, in place
+        *@param[in, out] pStr - string
+        *@param length - string length, in chars
+        *@param upper - if true, the chars are converted to upper case, otherwise to lower case
+        *@return converted char count, i.e. the index of the first non-ASCII char
+        *@note The ASCII letters following the first non-ASCII char in the same block are also converted
+        */
+        template <class T>
+        M_Target_Avx2 static std::size_t MapAscii(T* pStr, std::size_t length, bool upper);
+};
+//---------------------------------------------------------------------------
+template <class T>
+std::size_t TSP_StringHelper::IAvx2::WidenAscii(const char* pStr, std::size_t length, T* pResult)
+{
+    std::size_t i = 0;
+
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pStr + i));
+        const __m128i low   = _mm256_castsi256_si128(bytes);
+        const __m128i high  = _mm256_extracti128_si256(bytes, 1);
+
+        // the block is written before being checked, the chars following the first non-ASCII one
+        // will be overwritten by the caller
+        if (sizeof(T) == 2)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pResult + i),      _mm256_cvtepu8_epi16(low));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pResult + i + 16), _mm256_cvtepu8_epi16(high));
+        }
+        else
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pResult + i),      _mm256_cvtepu8_epi32(low));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pResult + i + 8),  _mm256_cvtepu8_epi32(_mm_srli_si128(low,  8)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pResult + i + 16), _mm256_cvtepu8_epi32(high));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pResult + i + 24), _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+        }
 
-    return upperStr;
+        const std::uint32_t mask = std::uint32_t(_mm256_movemask_epi8(bytes));
+
+        if (mask)
+            return i + ISse2::CountTrailingZeros(mask);
+    }
+
+    return i + ISse2::WidenAscii(pStr + i, length - i, pResult + i);
 }
 //---------------------------------------------------------------------------
-std::wstring TSP_StringHelper::ToUpperCase(const std::wstring& str)
+template <class T>
+std::size_t TSP_StringHelper::IAvx2::NarrowAscii(const T* pStr, std::size_t length, char* pResult)
+{
+    const __m256i     nonAscii = _mm256_set1_epi16(short(0xFF80));
+    const __m256i     zero     = _mm256_setzero_si256();
+          std::size_t i        = 0;
+
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i low;
+        __m256i high;
+
+        if (sizeof(T) == 2)
+        {
+            low  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pStr + i));
+            high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pStr + i + 16));
+        }
+        else
+        {
+            // the signed saturation keeps the non-ASCII chars out of the ASCII range. The packing works
+            // on each 128 bit lane, the 64 bit parts should be reordered
+            low  = _mm256_packs_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pStr + i)),
+                                      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pStr + i + 8)));
+            high = _mm256_packs_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pStr + i + 16)),
+                                      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pStr + i + 24)));
+            low  = _mm256_permute4x64_epi64(low,  0xD8);
+            high = _mm256_permute4x64_epi64(high, 0xD8);
+        }
+
+        // the block is written before being checked, the chars following the first non-ASCII one
+        // will be overwritten by the caller, and will take at least 2 bytes once converted
+        const __m256i packed = _mm256_packus_epi16(low, high);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pResult + i), _mm256_permute4x64_epi64(packed, 0xD8));
+
+        const std::uint32_t lowMask  = std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(low,  nonAscii), zero)));
+        const std::uint32_t highMask = std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(high, nonAscii), zero)));
+
+        if (lowMask != 0xFFFFFFFF)
+            return i + (ISse2::CountTrailingZeros(~lowMask) >> 1);
+
+        if (highMask != 0xFFFFFFFF)
+            return i + 16 + (ISse2::CountTrailingZeros(~highMask) >> 1);
+    }
+
+    return i + ISse2::NarrowAscii(pStr + i, length - i, pResult + i);
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::IAvx2::CountUtf8(const char*        pStr,
+                                              std::size_t  length,
+                                              std::size_t& leadCount,
+                                              std::size_t& longCount)
+{
+    // as signed bytes, the continuation bytes are below -64 and the 4 bytes leads above -17
+    const __m256i     continuation = _mm256_set1_epi8(-65);
+    const __m256i     longLead     = _mm256_set1_epi8(-17);
+    const __m256i     zero         = _mm256_setzero_si256();
+          std::size_t i            = 0;
+
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pStr + i));
+        const __m256i leads = _mm256_cmpgt_epi8(bytes, continuation);
+        const __m256i longs = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, longLead), _mm256_cmpgt_epi8(zero, bytes));
+
+        leadCount += IScalar::PopCount(std::uint32_t(_mm256_movemask_epi8(leads)));
+        longCount += IScalar::PopCount(std::uint32_t(_mm256_movemask_epi8(longs)));
+    }
+
+    ISse2::CountUtf8(pStr + i, length - i, leadCount, longCount);
+}
+//---------------------------------------------------------------------------
+template <class T>
+std::size_t TSP_StringHelper::IAvx2::GetUtf8Length(const T* pStr, std::size_t length)
 {
-    std::wstring upperStr;
+    const __m256i     zero   = _mm256_setzero_si256();
+          std::size_t i      = 0;
+          std::size_t result = 0;
+
+    // the comparison masks contain one bit per byte, their bit counts are divided by the char size
+    if (sizeof(T) == 2)
+    {
+        const __m256i oneByte   = _mm256_set1_epi16(short(0xFF80));
+        const __m256i twoBytes  = _mm256_set1_epi16(short(0xF800));
+        const __m256i surrogate = _mm256_set1_epi16(short(0xD800));
+
+        for (; i + 16 <= length; i += 16)
+        {
+            const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pStr + i));
+            const __m256i high  = _mm256_and_si256(chars, twoBytes);
 
-    // save current locale
-    const std::string loc = SetLocale_ThreadSafe(LC_ALL, nullptr);
+            const std::size_t ascii       = IScalar::PopCount(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(chars, oneByte), zero)));
+            const std::size_t twoBytesMax = IScalar::PopCount(_mm256_movemask_epi8(_mm256_cmpeq_epi16(high, zero)));
+            const std::size_t surrogates  = IScalar::PopCount(_mm256_movemask_epi8(_mm256_cmpeq_epi16(high, surrogate)));
 
-    try
+            // 3 bytes per char, minus 1 per char below 0x800, 1 more per ASCII char and 1 per surrogate
+            result += 48 - ((ascii + twoBytesMax + surrogates) >> 1);
+        }
+    }
+    else
     {
-        for each (auto c in str)
-            upperStr += ::towupper(c);
+        const __m256i oneByte    = _mm256_set1_epi32(int(0xFFFFFF80));
+        const __m256i twoBytes   = _mm256_set1_epi32(int(0xFFFFF800));
+        const __m256i threeBytes = _mm256_set1_epi32(int(0xFFFF0000));
+
+        for (; i + 8 <= length; i += 8)
+        {
+            const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pStr + i));
+
+            const std::size_t ascii = IScalar::PopCount(_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(chars, oneByte),    zero)));
+            const std::size_t two   = IScalar::PopCount(_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(chars, twoBytes),   zero)));
+            const std::size_t three = IScalar::PopCount(_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(chars, threeBytes), zero)));
+
+            result += 32 - ((ascii + two + three) >> 2);
+        }
     }
-    catch (...)
+
+    return result + ISse2::GetUtf8Length(pStr + i, length - i);
+}
+//---------------------------------------------------------------------------
+template <class T>
+std::size_t TSP_StringHelper::IAvx2::MapAscii(T* pStr, std::size_t length, bool upper)
+{
+    const std::size_t count   = 32 / sizeof(T);
+    const int         first   = upper ? 'a' : 'A';
+    const __m256i     caseBit = sizeof(T) == 1 ? _mm256_set1_epi8(0x20) :
+                                (sizeof(T) == 2 ? _mm256_set1_epi16(0x20) : _mm256_set1_epi32(0x20));
+    const __m256i     zero    = _mm256_setzero_si256();
+          std::size_t i       = 0;
+
+    for (; i + count <= length; i += count)
     {
-        // restore locale
-        SetLocale_ThreadSafe(LC_ALL, loc.c_str());
-        throw;
+        const __m256i       chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pStr + i));
+              __m256i       letters;
+              std::uint32_t ascii;
+
+        // as signed values, the non-ASCII chars are never between the first and last letter
+        if (sizeof(T) == 1)
+        {
+            letters = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8(char(first - 1))),
+                                       _mm256_cmpgt_epi8(_mm256_set1_epi8(char(first + 26)), chars));
+            ascii   = ~std::uint32_t(_mm256_movemask_epi8(chars));
+        }
+        else
+        if (sizeof(T) == 2)
+        {
+            letters = _mm256_and_si256(_mm256_cmpgt_epi16(chars, _mm256_set1_epi16(short(first - 1))),
+                                       _mm256_cmpgt_epi16(_mm256_set1_epi16(short(first + 26)), chars));
+            ascii   = std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(chars, _mm256_set1_epi16(short(0xFF80))), zero)));
+        }
+        else
+        {
+            letters = _mm256_and_si256(_mm256_cmpgt_epi32(chars, _mm256_set1_epi32(first - 1)),
+                                       _mm256_cmpgt_epi32(_mm256_set1_epi32(first + 26), chars));
+            ascii   = std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(chars, _mm256_set1_epi32(int(0xFFFFFF80))), zero)));
+        }
+
+        // the ASCII letter case is given by the bit 5, the non-ASCII chars are written unchanged
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pStr + i), _mm256_xor_si256(chars, _mm256_and_si256(letters, caseBit)));
+
+        if (ascii != 0xFFFFFFFF)
+            return i + ISse2::CountTrailingZeros(~ascii) / sizeof(T);
+    }
+
+    return i + ISse2::MapAscii(pStr + i, length - i, upper);
+}
+//---------------------------------------------------------------------------
+#endif
+//---------------------------------------------------------------------------
+// TSP_StringHelper::ITranscoder
+//---------------------------------------------------------------------------
+/**
+* Validating UTF-8 <-> UTF-16 (or UTF-32) transcoder. The ASCII chars are converted by blocks using the
+* selected instruction set, the other sequences are decoded and validated one by one
+*/
+class TSP_StringHelper::ITranscoder
+{
+    public:
+        /**
+        * Converts an UTF-8 string and appends it to a result
+        *@param pStr - UTF-8 string
+        *@param length - string length, in bytes
+        *@param[in, out] result - result to which the converted string is appended
+        *@return true on success, otherwise false, the result is unchanged in this case
+        */
+        template <class T>
+        static bool FromUtf8(const char* pStr, std::size_t length, std::basic_string<T>& result);
+
+        /**
+        * Converts a string to UTF-8 and appends it to a result
+        *@param pStr - UTF-16 or UTF-32 string, depending on the char size
+        *@param length - string length, in chars
+        *@param[in, out] result - result to which the converted string is appended
+        *@return true on success, otherwise false, the result is unchanged in this case
+        */
+        template <class T>
+        static bool ToUtf8(const T* pStr, std::size_t length, std::string& result);
+
+        /**
+        * Counts the sequences contained in an UTF-8 string
+        *@param pStr - UTF-8 string
+        *@param length - string length, in bytes
+        *@param[out] leadCount - lead byte count, i.e. the code point count
+        *@param[out] longCount - count of the 4 bytes long sequences, encoded as surrogate pairs in UTF-16
+        */
+        static void CountUtf8(const char*        pStr,
+                                    std::size_t  length,
+                                    std::size_t& leadCount,
+                                    std::size_t& longCount);
+
+        /**
+        * Gets the length of an UTF-16 or UTF-32 string once converted to UTF-8
+        *@param pStr - string
+        *@param length - string length, in chars
+        *@return the converted string length, in bytes
+        */
+        template <class T>
+        static std::size_t GetUtf8Length(const T* pStr, std::size_t length);
+
+        /**
+        * Decodes a non-ASCII UTF-8 sequence
+        *@param pBytes - UTF-8 string
+        *@param length - string length, in bytes
+        *@param[in, out] index - sequence index, set to the next sequence index on success
+        *@param[out] codePoint - decoded code point
+        *@return true on success, false if the sequence is truncated, overlong, encodes a surrogate or
+        *        a code point above U+10FFFF
+        */
+        static inline bool Decode(const std::uint8_t*  pBytes,
+                                        std::size_t    length,
+                                        std::size_t&   index,
+                                        std::uint32_t& codePoint);
+
+        /**
+        * Encodes a code point to UTF-8
+        *@param codePoint - valid code point to encode
+        *@param[out] pResult - result receiving the sequence, should be at least 4 bytes long
+        *@return sequence length, in bytes
+        */
+        static inline std::size_t Encode(std::uint32_t codePoint, char* pResult);
+
+    private:
+        // room the vector functions may write after the converted string
+        static const std::size_t m_BlockPadding = 32;
+
+        /**
+        * Converts an UTF-8 string
+        *@param pStr - UTF-8 string
+        *@param length - string length, in bytes
+        *@param[out] pResult - result receiving the converted string
+        *@param[out] count - converted char count
+        *@return true on success, otherwise false
+        */
+        template <class ISet, class T>
+        static bool FromUtf8(const char* pStr, std::size_t length, T* pResult, std::size_t& count);
+
+        /**
+        * Converts a string to UTF-8
+        *@param pStr - UTF-16 or UTF-32 string, depending on the char size
+        *@param length - string length, in chars
+        *@param[out] pResult - result receiving the converted string
+        *@param[out] count - converted byte count
+        *@return true on success, otherwise false
+        */
+        template <class ISet, class T>
+        static bool ToUtf8(const T* pStr, std::size_t length, char* pResult, std::size_t& count);
+};
+//---------------------------------------------------------------------------
+template <class T>
+bool TSP_StringHelper::ITranscoder::FromUtf8(const char* pStr, std::size_t length, std::basic_string<T>& result)
+{
+    if (!length)
+        return true;
+
+    if (!pStr)
+        return false;
+
+    std::size_t leadCount = 0;
+    std::size_t longCount = 0;
+
+    // the count is exact for a valid string, and always large enough for its valid part
+    CountUtf8(pStr, length, leadCount, longCount);
+
+    const std::size_t offset = result.length();
+    const std::size_t count  = sizeof(T) == 2 ? leadCount + longCount : leadCount;
+
+    result.resize(offset + count + m_BlockPadding);
+
+    T*          pResult = &result[offset];
+    std::size_t written = 0;
+    bool        success;
+
+    switch (m_InstructionSet.load(std::memory_order_relaxed))
+    {
+        #ifdef M_X86_StringHelper
+            case IEInstructionSet::IE_IS_Avx2: success = FromUtf8<IAvx2>  (pStr, length, pResult, written); break;
+            case IEInstructionSet::IE_IS_Sse2: success = FromUtf8<ISse2>  (pStr, length, pResult, written); break;
+        #endif
+
+        default:                               success = FromUtf8<IScalar>(pStr, length, pResult, written); break;
+    }
+
+    result.resize(success ? offset + written : offset);
+
+    return success;
+}
+//---------------------------------------------------------------------------
+template <class T>
+bool TSP_StringHelper::ITranscoder::ToUtf8(const T* pStr, std::size_t length, std::string& result)
+{
+    if (!length)
+        return true;
+
+    if (!pStr)
+        return false;
+
+    const std::size_t offset = result.length();
+
+    result.resize(offset + GetUtf8Length(pStr, length));
+
+    char*       pResult = &result[offset];
+    std::size_t written = 0;
+    bool        success;
+
+    switch (m_InstructionSet.load(std::memory_order_relaxed))
+    {
+        #ifdef M_X86_StringHelper
+            case IEInstructionSet::IE_IS_Avx2: success = ToUtf8<IAvx2>  (pStr, length, pResult, written); break;
+            case IEInstructionSet::IE_IS_Sse2: success = ToUtf8<ISse2>  (pStr, length, pResult, written); break;
+        #endif
+
+        default:                               success = ToUtf8<IScalar>(pStr, length, pResult, written); break;
     }
 
-    // restore locale
-    SetLocale_ThreadSafe(LC_ALL, loc.c_str());
+    result.resize(success ? offset + written : offset);
+
+    return success;
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::ITranscoder::CountUtf8(const char*        pStr,
+                                                    std::size_t  length,
+                                                    std::size_t& leadCount,
+                                                    std::size_t& longCount)
+{
+    leadCount = 0;
+    longCount = 0;
+
+    if (!pStr)
+        return;
+
+    switch (m_InstructionSet.load(std::memory_order_relaxed))
+    {
+        #ifdef M_X86_StringHelper
+            case IEInstructionSet::IE_IS_Avx2: IAvx2::CountUtf8  (pStr, length, leadCount, longCount); return;
+            case IEInstructionSet::IE_IS_Sse2: ISse2::CountUtf8  (pStr, length, leadCount, longCount); return;
+        #endif
+
+        default:                               IScalar::CountUtf8(pStr, length, leadCount, longCount); return;
+    }
+}
+//---------------------------------------------------------------------------
+template <class T>
+std::size_t TSP_StringHelper::ITranscoder::GetUtf8Length(const T* pStr, std::size_t length)
+{
+    if (!pStr)
+        return 0;
+
+    switch (m_InstructionSet.load(std::memory_order_relaxed))
+    {
+        #ifdef M_X86_StringHelper
+            case IEInstructionSet::IE_IS_Avx2: return IAvx2::GetUtf8Length  (pStr, length);
+            case IEInstructionSet::IE_IS_Sse2: return ISse2::GetUtf8Length  (pStr, length);
+        #endif
+
+        default:                               return IScalar::GetUtf8Length(pStr, length);
+    }
+}
+//---------------------------------------------------------------------------
+template <class ISet, class T>
+bool TSP_StringHelper::ITranscoder::FromUtf8(const char* pStr, std::size_t length, T* pResult, std::size_t& count)
+{
+    const std::uint8_t* pBytes = reinterpret_cast<const std::uint8_t*>(pStr);
+          std::size_t   i      = 0;
+          std::size_t   j      = 0;
+
+    while (i < length)
+    {
+        if (pBytes[i] < 0x80)
+        {
+            pResult[j++] = T(pBytes[i++]);
+
+            // convert the following ASCII chars by blocks, if any
+            if (i < length && pBytes[i] < 0x80)
+            {
+                const std::size_t asciiCount = ISet::WidenAscii(pStr + i, length - i, pResult + j);
+
+                i += asciiCount;
+                j += asciiCount;
+            }
+
+            continue;
+        }
+
+        std::uint32_t codePoint;
+
+        if (!Decode(pBytes, length, i, codePoint))
+            return false;
+
+        // encode the code points above the basic plane as surrogate pairs in UTF-16
+        if (sizeof(T) == 2 && codePoint >= 0x10000)
+        {
+            codePoint   -= 0x10000;
+            pResult[j++] = T(0xD800 + (codePoint >> 10));
+            pResult[j++] = T(0xDC00 + (codePoint & 0x3FF));
+        }
+        else
+            pResult[j++] = T(codePoint);
+    }
+
+    count = j;
+    return true;
+}
+//---------------------------------------------------------------------------
+template <class ISet, class T>
+bool TSP_StringHelper::ITranscoder::ToUtf8(const T* pStr, std::size_t length, char* pResult, std::size_t& count)
+{
+    std::size_t i = 0;
+    std::size_t j = 0;
+
+    while (i < length)
+    {
+        std::uint32_t codePoint = IScalar::IUnit<T>(pStr[i]);
+
+        ++i;
+
+        if (codePoint < 0x80)
+        {
+            pResult[j++] = char(codePoint);
+
+            // convert the following ASCII chars by blocks, if any
+            if (i < length && IScalar::IUnit<T>(pStr[i]) < 0x80)
+            {
+                const std::size_t asciiCount = ISet::NarrowAscii(pStr + i, length - i, pResult + j);
+
+                i += asciiCount;
+                j += asciiCount;
+            }
+
+            continue;
+        }
+
+        if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+        {
+            // only a high surrogate followed by a low one is valid, and only in UTF-16
+            if (sizeof(T) != 2 || codePoint > 0xDBFF || i >= length)
+                return false;
+
+            const std::uint32_t low = IScalar::IUnit<T>(pStr[i]);
+
+            if (low < 0xDC00 || low > 0xDFFF)
+                return false;
+
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            ++i;
+        }
+        else
+        if (codePoint > 0x10FFFF)
+            return false;
+
+        j += Encode(codePoint, pResult + j);
+    }
+
+    count = j;
+    return true;
+}
+//---------------------------------------------------------------------------
+inline bool TSP_StringHelper::ITranscoder::Decode(const std::uint8_t*  pBytes,
+                                                        std::size_t    length,
+                                                        std::size_t&   index,
+                                                        std::uint32_t& codePoint)
+{
+    const std::uint32_t lead = pBytes[index];
+
+    // 2 bytes sequence, the leads below 0xC2 are continuation bytes or start overlong sequences
+    if (lead < 0xE0)
+    {
+        if (lead < 0xC2 || length - index < 2 || (pBytes[index + 1] & 0xC0) != 0x80)
+            return false;
+
+        codePoint  = ((lead & 0x1F) << 6) | (pBytes[index + 1] & 0x3F);
+        index     += 2;
+        return true;
+    }
+
+    // 3 bytes sequence, the second byte range is restricted to reject the overlong sequences and
+    // the surrogates
+    if (lead < 0xF0)
+    {
+        if (length - index < 3)
+            return false;
+
+        const std::uint32_t second = pBytes[index + 1];
+        const std::uint32_t third  = pBytes[index + 2];
+
+        if (second < (lead == 0xE0 ? 0xA0 : 0x80) || second > (lead == 0xED ? 0x9F : 0xBF) || (third & 0xC0) != 0x80)
+            return false;
+
+        codePoint  = ((lead & 0x0F) << 12) | ((second & 0x3F) << 6) | (third & 0x3F);
+        index     += 3;
+        return true;
+    }
+
+    // 4 bytes sequence, the second byte range is restricted to reject the overlong sequences and
+    // the code points above U+10FFFF
+    if (lead > 0xF4 || length - index < 4)
+        return false;
+
+    const std::uint32_t second = pBytes[index + 1];
+    const std::uint32_t third  = pBytes[index + 2];
+    const std::uint32_t fourth = pBytes[index + 3];
+
+    if (second < (lead == 0xF0 ? 0x90 : 0x80) || second > (lead == 0xF4 ? 0x8F : 0xBF) ||
+       (third & 0xC0) != 0x80 || (fourth & 0xC0) != 0x80)
+        return false;
 
-    return upperStr;
+    codePoint  = ((lead & 0x07) << 18) | ((second & 0x3F) << 12) | ((third & 0x3F) << 6) | (fourth & 0x3F);
+    index     += 4;
+    return true;
+}
+//---------------------------------------------------------------------------
+inline std::size_t TSP_StringHelper::ITranscoder::Encode(std::uint32_t codePoint, char* pResult)
+{
+    if (codePoint < 0x80)
+    {
+        pResult[0] = char(codePoint);
+        return 1;
+    }
+
+    if (codePoint < 0x800)
+    {
+        pResult[0] = char(0xC0 |  (codePoint >> 6));
+        pResult[1] = char(0x80 |  (codePoint & 0x3F));
+        return 2;
+    }
+
+    if (codePoint < 0x10000)
+    {
+        pResult[0] = char(0xE0 |  (codePoint >> 12));
+        pResult[1] = char(0x80 | ((codePoint >> 6) & 0x3F));
+        pResult[2] = char(0x80 |  (codePoint       & 0x3F));
+        return 3;
+    }
+
+    pResult[0] = char(0xF0 |  (codePoint >> 18));
+    pResult[1] = char(0x80 | ((codePoint >> 12) & 0x3F));
+    pResult[2] = char(0x80 | ((codePoint >> 6)  & 0x3F));
+    pResult[3] = char(0x80 |  (codePoint        & 0x3F));
+    return 4;
+}
+//---------------------------------------------------------------------------
+// TSP_StringHelper::ICaseMapper
+//---------------------------------------------------------------------------
+/**
+* Locale independent case mapper, based on the Unicode simple case mappings. The ASCII chars are
+* converted by blocks using the selected instruction set, the other chars are looked up in tables
+*/
+class TSP_StringHelper::ICaseMapper
+{
+    public:
+        /**
+        * Case mapping
+        */
+        enum class IEMapping
+        {
+            IE_M_Lower,
+            IE_M_Upper,
+            IE_M_Fold
+        };
+
+        /**
+        * Maps the case of an UTF-8 string, in place
+        *@param[in, out] str - string to map
+        *@param offset - index from which the string is mapped
+        *@param mapping - case mapping to apply
+        *@note The string length may change, as a few chars are mapped to chars encoded on more or
+        *      less bytes. The invalid sequences are kept as is
+        */
+        static void Map(std::string& str, std::size_t offset, IEMapping mapping);
+
+        /**
+        * Maps the case of a wide string, in place
+        *@param[in, out] str - string to map
+        *@param offset - index from which the string is mapped
+        *@param mapping - case mapping to apply
+        *@note The lone surrogates are kept as is
+        */
+        static void Map(std::wstring& str, std::size_t offset, IEMapping mapping);
+
+    private:
+        /**
+        * Range of code points sharing the same mapping, every stride code point is mapped by adding
+        * the delta to it
+        */
+        struct IRange
+        {
+            std::uint32_t m_First;
+            std::uint32_t m_Last;
+            std::int32_t  m_Delta;
+            std::uint32_t m_Stride;
+        };
+
+        /**
+        * Direct mapping table, built from the ranges. The code points are grouped by blocks of 64, each
+        * block points to the 64 deltas to add to its code points, shared by the blocks having the same
+        */
+        struct ITable
+        {
+            std::vector<std::uint16_t> m_Blocks;
+            std::vector<std::int32_t>  m_Deltas;
+        };
+
+        // mapping ranges, generated from the Unicode 14.0 database
+        static const IRange m_LowerCase[];
+        static const IRange m_UpperCase[];
+        static const IRange m_FoldCase[];
+
+        /**
+        * Gets the direct mapping table matching a case mapping, builds it on the first use
+        *@param mapping - case mapping
+        *@return the mapping table
+        */
+        static const ITable& GetTable(IEMapping mapping);
+
+        /**
+        * Builds a direct mapping table
+        *@param pRanges - mapping ranges, sorted by code point
+        *@param count - range count
+        *@return the mapping table
+        */
+        static ITable BuildTable(const IRange* pRanges, std::size_t count);
+
+        /**
+        * Maps the case of an UTF-8 string, in place
+        *@param[in, out] str - string to map
+        *@param offset - index from which the string is mapped
+        *@param mapping - case mapping to apply
+        */
+        template <class ISet>
+        static void MapUtf8(std::string& str, std::size_t offset, IEMapping mapping);
+
+        /**
+        * Maps the case of an UTF-16 or UTF-32 string, in place
+        *@param[in, out] pStr - string to map
+        *@param length - string length, in chars
+        *@param mapping - case mapping to apply
+        */
+        template <class ISet, class T>
+        static void MapWide(T* pStr, std::size_t length, IEMapping mapping);
+
+        /**
+        * Maps a code point
+        *@param codePoint - code point to map
+        *@param table - mapping table to use
+        *@return mapped code point, the code point itself if it has no mapping
+        */
+        static inline std::uint32_t Map(std::uint32_t codePoint, const ITable& table);
+};
+//---------------------------------------------------------------------------
+const TSP_StringHelper::ICaseMapper::IRange TSP_StringHelper::ICaseMapper::m_LowerCase[] =
+{
+    {0x000C0, 0x000D6,     32, 1}, {0x000D8, 0x000DE,     32, 1},
+    {0x00100, 0x0012E,      1, 2}, {0x00130, 0x00130,   -199, 1},
+    {0x00132, 0x00136,      1, 2}, {0x00139, 0x00147,      1, 2},
+    {0x0014A, 0x00176,      1, 2}, {0x00178, 0x00178,   -121, 1},
+    {0x00179, 0x0017D,      1, 2}, {0x00181, 0x00181,    210, 1},
+    {0x00182, 0x00184,      1, 2}, {0x00186, 0x00186,    206, 1},
+    {0x00187, 0x00187,      1, 1}, {0x00189, 0x0018A,    205, 1},
+    {0x0018B, 0x0018B,      1, 1}, {0x0018E, 0x0018E,     79, 1},
+    {0x0018F, 0x0018F,    202, 1}, {0x00190, 0x00190,    203, 1},
+    {0x00191, 0x00191,      1, 1}, {0x00193, 0x00193,    205, 1},
+    {0x00194, 0x00194,    207, 1}, {0x00196, 0x00196,    211, 1},
+    {0x00197, 0x00197,    209, 1}, {0x00198, 0x00198,      1, 1},
+    {0x0019C, 0x0019C,    211, 1}, {0x0019D, 0x0019D,    213, 1},
+    {0x0019F, 0x0019F,    214, 1}, {0x001A0, 0x001A4,      1, 2},
+    {0x001A6, 0x001A6,    218, 1}, {0x001A7, 0x001A7,      1, 1},
+    {0x001A9, 0x001A9,    218, 1}, {0x001AC, 0x001AC,      1, 1},
+    {0x001AE, 0x001AE,    218, 1}, {0x001AF, 0x001AF,      1, 1},
+    {0x001B1, 0x001B2,    217, 1}, {0x001B3, 0x001B5,      1, 2},
+    {0x001B7, 0x001B7,    219, 1}, {0x001B8, 0x001B8,      1, 1},
+    {0x001BC, 0x001BC,      1, 1}, {0x001C4, 0x001C4,      2, 1},
+    {0x001C5, 0x001C5,      1, 1}, {0x001C7, 0x001C7,      2, 1},
+    {0x001C8, 0x001C8,      1, 1}, {0x001CA, 0x001CA,      2, 1},
+    {0x001CB, 0x001DB,      1, 2}, {0x001DE, 0x001EE,      1, 2},
+    {0x001F1, 0x001F1,      2, 1}, {0x001F2, 0x001F4,      1, 2},
+    {0x001F6, 0x001F6,    -97, 1}, {0x001F7, 0x001F7,    -56, 1},
+    {0x001F8, 0x0021E,      1, 2}, {0x00220, 0x00220,   -130, 1},
+    {0x00222, 0x00232,      1, 2}, {0x0023A, 0x0023A,  10795, 1},
+    {0x0023B, 0x0023B,      1, 1}, {0x0023D, 0x0023D,   -163, 1},
+    {0x0023E, 0x0023E,  10792, 1}, {0x00241, 0x00241,      1, 1},
+    {0x00243, 0x00243,   -195, 1}, {0x00244, 0x00244,     69, 1},
+    {0x00245, 0x00245,     71, 1}, {0x00246, 0x0024E,      1, 2},
+    {0x00370, 0x00372,      1, 2}, {0x00376, 0x00376,      1, 1},
+    {0x0037F, 0x0037F,    116, 1}, {0x00386, 0x00386,     38, 1},
+    {0x00388, 0x0038A,     37, 1}, {0x0038C, 0x0038C,     64, 1},
+    {0x0038E, 0x0038F,     63, 1}, {0x00391, 0x003A1,     32, 1},
+    {0x003A3, 0x003AB,     32, 1}, {0x003CF, 0x003CF,      8, 1},
+    {0x003D8, 0x003EE,      1, 2}, {0x003F4, 0x003F4,    -60, 1},
+    {0x003F7, 0x003F7,      1, 1}, {0x003F9, 0x003F9,     -7, 1},
+    {0x003FA, 0x003FA,      1, 1}, {0x003FD, 0x003FF,   -130, 1},
+    {0x00400, 0x0040F,     80, 1}, {0x00410, 0x0042F,     32, 1},
+    {0x00460, 0x00480,      1, 2}, {0x0048A, 0x004BE,      1, 2},
+    {0x004C0, 0x004C0,     15, 1}, {0x004C1, 0x004CD,      1, 2},
+    {0x004D0, 0x0052E,      1, 2}, {0x00531, 0x00556,     48, 1},
+    {0x010A0, 0x010C5,   7264, 1}, {0x010C7, 0x010C7,   7264, 1},
+    {0x010CD, 0x010CD,   7264, 1}, {0x013A0, 0x013EF,  38864, 1},
+    {0x013F0, 0x013F5,      8, 1}, {0x01C90, 0x01CBA,  -3008, 1},
+    {0x01CBD, 0x01CBF,  -3008, 1}, {0x01E00, 0x01E94,      1, 2},
+    {0x01E9E, 0x01E9E,  -7615, 1}, {0x01EA0, 0x01EFE,      1, 2},
+    {0x01F08, 0x01F0F,     -8, 1}, {0x01F18, 0x01F1D,     -8, 1},
+    {0x01F28, 0x01F2F,     -8, 1}, {0x01F38, 0x01F3F,     -8, 1},
+    {0x01F48, 0x01F4D,     -8, 1}, {0x01F59, 0x01F5F,     -8, 2},
+    {0x01F68, 0x01F6F,     -8, 1}, {0x01F88, 0x01F8F,     -8, 1},
+    {0x01F98, 0x01F9F,     -8, 1}, {0x01FA8, 0x01FAF,     -8, 1},
+    {0x01FB8, 0x01FB9,     -8, 1}, {0x01FBA, 0x01FBB,    -74, 1},
+    {0x01FBC, 0x01FBC,     -9, 1}, {0x01FC8, 0x01FCB,    -86, 1},
+    {0x01FCC, 0x01FCC,     -9, 1}, {0x01FD8, 0x01FD9,     -8, 1},
+    {0x01FDA, 0x01FDB,   -100, 1}, {0x01FE8, 0x01FE9,     -8, 1},
+    {0x01FEA, 0x01FEB,   -112, 1}, {0x01FEC, 0x01FEC,     -7, 1},
+    {0x01FF8, 0x01FF9,   -128, 1}, {0x01FFA, 0x01FFB,   -126, 1},
+    {0x01FFC, 0x01FFC,     -9, 1}, {0x02126, 0x02126,  -7517, 1},
+    {0x0212A, 0x0212A,  -8383, 1}, {0x0212B, 0x0212B,  -8262, 1},
+    {0x02132, 0x02132,     28, 1}, {0x02160, 0x0216F,     16, 1},
+    {0x02183, 0x02183,      1, 1}, {0x024B6, 0x024CF,     26, 1},
+    {0x02C00, 0x02C2F,     48, 1}, {0x02C60, 0x02C60,      1, 1},
+    {0x02C62, 0x02C62, -10743, 1}, {0x02C63, 0x02C63,  -3814, 1},
+    {0x02C64, 0x02C64, -10727, 1}, {0x02C67, 0x02C6B,      1, 2},
+    {0x02C6D, 0x02C6D, -10780, 1}, {0x02C6E, 0x02C6E, -10749, 1},
+    {0x02C6F, 0x02C6F, -10783, 1}, {0x02C70, 0x02C70, -10782, 1},
+    {0x02C72, 0x02C72,      1, 1}, {0x02C75, 0x02C75,      1, 1},
+    {0x02C7E, 0x02C7F, -10815, 1}, {0x02C80, 0x02CE2,      1, 2},
+    {0x02CEB, 0x02CED,      1, 2}, {0x02CF2, 0x02CF2,      1, 1},
+    {0x0A640, 0x0A66C,      1, 2}, {0x0A680, 0x0A69A,      1, 2},
+    {0x0A722, 0x0A72E,      1, 2}, {0x0A732, 0x0A76E,      1, 2},
+    {0x0A779, 0x0A77B,      1, 2}, {0x0A77D, 0x0A77D, -35332, 1},
+    {0x0A77E, 0x0A786,      1, 2}, {0x0A78B, 0x0A78B,      1, 1},
+    {0x0A78D, 0x0A78D, -42280, 1}, {0x0A790, 0x0A792,      1, 2},
+    {0x0A796, 0x0A7A8,      1, 2}, {0x0A7AA, 0x0A7AA, -42308, 1},
+    {0x0A7AB, 0x0A7AB, -42319, 1}, {0x0A7AC, 0x0A7AC, -42315, 1},
+    {0x0A7AD, 0x0A7AD, -42305, 1}, {0x0A7AE, 0x0A7AE, -42308, 1},
+    {0x0A7B0, 0x0A7B0, -42258, 1}, {0x0A7B1, 0x0A7B1, -42282, 1},
+    {0x0A7B2, 0x0A7B2, -42261, 1}, {0x0A7B3, 0x0A7B3,    928, 1},
+    {0x0A7B4, 0x0A7C2,      1, 2}, {0x0A7C4, 0x0A7C4,    -48, 1},
+    {0x0A7C5, 0x0A7C5, -42307, 1}, {0x0A7C6, 0x0A7C6, -35384, 1},
+    {0x0A7C7, 0x0A7C9,      1, 2}, {0x0A7D0, 0x0A7D0,      1, 1},
+    {0x0A7D6, 0x0A7D8,      1, 2}, {0x0A7F5, 0x0A7F5,      1, 1},
+    {0x0FF21, 0x0FF3A,     32, 1}, {0x10400, 0x10427,     40, 1},
+    {0x104B0, 0x104D3,     40, 1}, {0x10570, 0x1057A,     39, 1},
+    {0x1057C, 0x1058A,     39, 1}, {0x1058C, 0x10592,     39, 1},
+    {0x10594, 0x10595,     39, 1}, {0x10C80, 0x10CB2,     64, 1},
+    {0x118A0, 0x118BF,     32, 1}, {0x16E40, 0x16E5F,     32, 1},
+    {0x1E900, 0x1E921,     34, 1}
+};
+//---------------------------------------------------------------------------
+const TSP_StringHelper::ICaseMapper::IRange TSP_StringHelper::ICaseMapper::m_UpperCase[] =
+{
+    {0x000B5, 0x000B5,    743, 1}, {0x000E0, 0x000F6,    -32, 1},
+    {0x000F8, 0x000FE,    -32, 1}, {0x000FF, 0x000FF,    121, 1},
+    {0x00101, 0x0012F,     -1, 2}, {0x00131, 0x00131,   -232, 1},
+    {0x00133, 0x00137,     -1, 2}, {0x0013A, 0x00148,     -1, 2},
+    {0x0014B, 0x00177,     -1, 2}, {0x0017A, 0x0017E,     -1, 2},
+    {0x0017F, 0x0017F,   -300, 1}, {0x00180, 0x00180,    195, 1},
+    {0x00183, 0x00185,     -1, 2}, {0x00188, 0x00188,     -1, 1},
+    {0x0018C, 0x0018C,     -1, 1}, {0x00192, 0x00192,     -1, 1},
+    {0x00195, 0x00195,     97, 1}, {0x00199, 0x00199,     -1, 1},
+    {0x0019A, 0x0019A,    163, 1}, {0x0019E, 0x0019E,    130, 1},
+    {0x001A1, 0x001A5,     -1, 2}, {0x001A8, 0x001A8,     -1, 1},
+    {0x001AD, 0x001AD,     -1, 1}, {0x001B0, 0x001B0,     -1, 1},
+    {0x001B4, 0x001B6,     -1, 2}, {0x001B9, 0x001B9,     -1, 1},
+    {0x001BD, 0x001BD,     -1, 1}, {0x001BF, 0x001BF,     56, 1},
+    {0x001C5, 0x001C5,     -1, 1}, {0x001C6, 0x001C6,     -2, 1},
+    {0x001C8, 0x001C8,     -1, 1}, {0x001C9, 0x001C9,     -2, 1},
+    {0x001CB, 0x001CB,     -1, 1}, {0x001CC, 0x001CC,     -2, 1},
+    {0x001CE, 0x001DC,     -1, 2}, {0x001DD, 0x001DD,    -79, 1},
+    {0x001DF, 0x001EF,     -1, 2}, {0x001F2, 0x001F2,     -1, 1},
+    {0x001F3, 0x001F3,     -2, 1}, {0x001F5, 0x001F5,     -1, 1},
+    {0x001F9, 0x0021F,     -1, 2}, {0x00223, 0x00233,     -1, 2},
+    {0x0023C, 0x0023C,     -1, 1}, {0x0023F, 0x00240,  10815, 1},
+    {0x00242, 0x00242,     -1, 1}, {0x00247, 0x0024F,     -1, 2},
+    {0x00250, 0x00250,  10783, 1}, {0x00251, 0x00251,  10780, 1},
+    {0x00252, 0x00252,  10782, 1}, {0x00253, 0x00253,   -210, 1},
+    {0x00254, 0x00254,   -206, 1}, {0x00256, 0x00257,   -205, 1},
+    {0x00259, 0x00259,   -202, 1}, {0x0025B, 0x0025B,   -203, 1},
+    {0x0025C, 0x0025C,  42319, 1}, {0x00260, 0x00260,   -205, 1},
+    {0x00261, 0x00261,  42315, 1}, {0x00263, 0x00263,   -207, 1},
+    {0x00265, 0x00265,  42280, 1}, {0x00266, 0x00266,  42308, 1},
+    {0x00268, 0x00268,   -209, 1}, {0x00269, 0x00269,   -211, 1},
+    {0x0026A, 0x0026A,  42308, 1}, {0x0026B, 0x0026B,  10743, 1},
+    {0x0026C, 0x0026C,  42305, 1}, {0x0026F, 0x0026F,   -211, 1},
+    {0x00271, 0x00271,  10749, 1}, {0x00272, 0x00272,   -213, 1},
+    {0x00275, 0x00275,   -214, 1}, {0x0027D, 0x0027D,  10727, 1},
+    {0x00280, 0x00280,   -218, 1}, {0x00282, 0x00282,  42307, 1},
+    {0x00283, 0x00283,   -218, 1}, {0x00287, 0x00287,  42282, 1},
+    {0x00288, 0x00288,   -218, 1}, {0x00289, 0x00289,    -69, 1},
+    {0x0028A, 0x0028B,   -217, 1}, {0x0028C, 0x0028C,    -71, 1},
+    {0x00292, 0x00292,   -219, 1}, {0x0029D, 0x0029D,  42261, 1},
+    {0x0029E, 0x0029E,  42258, 1}, {0x00345, 0x00345,     84, 1},
+    {0x00371, 0x00373,     -1, 2}, {0x00377, 0x00377,     -1, 1},
+    {0x0037B, 0x0037D,    130, 1}, {0x003AC, 0x003AC,    -38, 1},
+    {0x003AD, 0x003AF,    -37, 1}, {0x003B1, 0x003C1,    -32, 1},
+    {0x003C2, 0x003C2,    -31, 1}, {0x003C3, 0x003CB,    -32, 1},
+    {0x003CC, 0x003CC,    -64, 1}, {0x003CD, 0x003CE,    -63, 1},
+    {0x003D0, 0x003D0,    -62, 1}, {0x003D1, 0x003D1,    -57, 1},
+    {0x003D5, 0x003D5,    -47, 1}, {0x003D6, 0x003D6,    -54, 1},
+    {0x003D7, 0x003D7,     -8, 1}, {0x003D9, 0x003EF,     -1, 2},
+    {0x003F0, 0x003F0,    -86, 1}, {0x003F1, 0x003F1,    -80, 1},
+    {0x003F2, 0x003F2,      7, 1}, {0x003F3, 0x003F3,   -116, 1},
+    {0x003F5, 0x003F5,    -96, 1}, {0x003F8, 0x003F8,     -1, 1},
+    {0x003FB, 0x003FB,     -1, 1}, {0x00430, 0x0044F,    -32, 1},
+    {0x00450, 0x0045F,    -80, 1}, {0x00461, 0x00481,     -1, 2},
+    {0x0048B, 0x004BF,     -1, 2}, {0x004C2, 0x004CE,     -1, 2},
+    {0x004CF, 0x004CF,    -15, 1}, {0x004D1, 0x0052F,     -1, 2},
+    {0x00561, 0x00586,    -48, 1}, {0x010D0, 0x010FA,   3008, 1},
+    {0x010FD, 0x010FF,   3008, 1}, {0x013F8, 0x013FD,     -8, 1},
+    {0x01C80, 0x01C80,  -6254, 1}, {0x01C81, 0x01C81,  -6253, 1},
+    {0x01C82, 0x01C82,  -6244, 1}, {0x01C83, 0x01C84,  -6242, 1},
+    {0x01C85, 0x01C85,  -6243, 1}, {0x01C86, 0x01C86,  -6236, 1},
+    {0x01C87, 0x01C87,  -6181, 1}, {0x01C88, 0x01C88,  35266, 1},
+    {0x01D79, 0x01D79,  35332, 1}, {0x01D7D, 0x01D7D,   3814, 1},
+    {0x01D8E, 0x01D8E,  35384, 1}, {0x01E01, 0x01E95,     -1, 2},
+    {0x01E9B, 0x01E9B,    -59, 1}, {0x01EA1, 0x01EFF,     -1, 2},
+    {0x01F00, 0x01F07,      8, 1}, {0x01F10, 0x01F15,      8, 1},
+    {0x01F20, 0x01F27,      8, 1}, {0x01F30, 0x01F37,      8, 1},
+    {0x01F40, 0x01F45,      8, 1}, {0x01F51, 0x01F57,      8, 2},
+    {0x01F60, 0x01F67,      8, 1}, {0x01F70, 0x01F71,     74, 1},
+    {0x01F72, 0x01F75,     86, 1}, {0x01F76, 0x01F77,    100, 1},
+    {0x01F78, 0x01F79,    128, 1}, {0x01F7A, 0x01F7B,    112, 1},
+    {0x01F7C, 0x01F7D,    126, 1}, {0x01F80, 0x01F87,      8, 1},
+    {0x01F90, 0x01F97,      8, 1}, {0x01FA0, 0x01FA7,      8, 1},
+    {0x01FB0, 0x01FB1,      8, 1}, {0x01FB3, 0x01FB3,      9, 1},
+    {0x01FBE, 0x01FBE,  -7205, 1}, {0x01FC3, 0x01FC3,      9, 1},
+    {0x01FD0, 0x01FD1,      8, 1}, {0x01FE0, 0x01FE1,      8, 1},
+    {0x01FE5, 0x01FE5,      7, 1}, {0x01FF3, 0x01FF3,      9, 1},
+    {0x0214E, 0x0214E,    -28, 1}, {0x02170, 0x0217F,    -16, 1},
+    {0x02184, 0x02184,     -1, 1}, {0x024D0, 0x024E9,    -26, 1},
+    {0x02C30, 0x02C5F,    -48, 1}, {0x02C61, 0x02C61,     -1, 1},
+    {0x02C65, 0x02C65, -10795, 1}, {0x02C66, 0x02C66, -10792, 1},
+    {0x02C68, 0x02C6C,     -1, 2}, {0x02C73, 0x02C73,     -1, 1},
+    {0x02C76, 0x02C76,     -1, 1}, {0x02C81, 0x02CE3,     -1, 2},
+    {0x02CEC, 0x02CEE,     -1, 2}, {0x02CF3, 0x02CF3,     -1, 1},
+    {0x02D00, 0x02D25,  -7264, 1}, {0x02D27, 0x02D27,  -7264, 1},
+    {0x02D2D, 0x02D2D,  -7264, 1}, {0x0A641, 0x0A66D,     -1, 2},
+    {0x0A681, 0x0A69B,     -1, 2}, {0x0A723, 0x0A72F,     -1, 2},
+    {0x0A733, 0x0A76F,     -1, 2}, {0x0A77A, 0x0A77C,     -1, 2},
+    {0x0A77F, 0x0A787,     -1, 2}, {0x0A78C, 0x0A78C,     -1, 1},
+    {0x0A791, 0x0A793,     -1, 2}, {0x0A794, 0x0A794,     48, 1},
+    {0x0A797, 0x0A7A9,     -1, 2}, {0x0A7B5, 0x0A7C3,     -1, 2},
+    {0x0A7C8, 0x0A7CA,     -1, 2}, {0x0A7D1, 0x0A7D1,     -1, 1},
+    {0x0A7D7, 0x0A7D9,     -1, 2}, {0x0A7F6, 0x0A7F6,     -1, 1},
+    {0x0AB53, 0x0AB53,   -928, 1}, {0x0AB70, 0x0ABBF, -38864, 1},
+    {0x0FF41, 0x0FF5A,    -32, 1}, {0x10428, 0x1044F,    -40, 1},
+    {0x104D8, 0x104FB,    -40, 1}, {0x10597, 0x105A1,    -39, 1},
+    {0x105A3, 0x105B1,    -39, 1}, {0x105B3, 0x105B9,    -39, 1},
+    {0x105BB, 0x105BC,    -39, 1}, {0x10CC0, 0x10CF2,    -64, 1},
+    {0x118C0, 0x118DF,    -32, 1}, {0x16E60, 0x16E7F,    -32, 1},
+    {0x1E922, 0x1E943,    -34, 1}
+};
+//---------------------------------------------------------------------------
+const TSP_StringHelper::ICaseMapper::IRange TSP_StringHelper::ICaseMapper::m_FoldCase[] =
+{
+    {0x000B5, 0x000B5,    775, 1}, {0x000C0, 0x000D6,     32, 1},
+    {0x000D8, 0x000DE,     32, 1}, {0x00100, 0x0012E,      1, 2},
+    {0x00132, 0x00136,      1, 2}, {0x00139, 0x00147,      1, 2},
+    {0x0014A, 0x00176,      1, 2}, {0x00178, 0x00178,   -121, 1},
+    {0x00179, 0x0017D,      1, 2}, {0x0017F, 0x0017F,   -268, 1},
+    {0x00181, 0x00181,    210, 1}, {0x00182, 0x00184,      1, 2},
+    {0x00186, 0x00186,    206, 1}, {0x00187, 0x00187,      1, 1},
+    {0x00189, 0x0018A,    205, 1}, {0x0018B, 0x0018B,      1, 1},
+    {0x0018E, 0x0018E,     79, 1}, {0x0018F, 0x0018F,    202, 1},
+    {0x00190, 0x00190,    203, 1}, {0x00191, 0x00191,      1, 1},
+    {0x00193, 0x00193,    205, 1}, {0x00194, 0x00194,    207, 1},
+    {0x00196, 0x00196,    211, 1}, {0x00197, 0x00197,    209, 1},
+    {0x00198, 0x00198,      1, 1}, {0x0019C, 0x0019C,    211, 1},
+    {0x0019D, 0x0019D,    213, 1}, {0x0019F, 0x0019F,    214, 1},
+    {0x001A0, 0x001A4,      1, 2}, {0x001A6, 0x001A6,    218, 1},
+    {0x001A7, 0x001A7,      1, 1}, {0x001A9, 0x001A9,    218, 1},
+    {0x001AC, 0x001AC,      1, 1}, {0x001AE, 0x001AE,    218, 1},
+    {0x001AF, 0x001AF,      1, 1}, {0x001B1, 0x001B2,    217, 1},
+    {0x001B3, 0x001B5,      1, 2}, {0x001B7, 0x001B7,    219, 1},
+    {0x001B8, 0x001B8,      1, 1}, {0x001BC, 0x001BC,      1, 1},
+    {0x001C4, 0x001C4,      2, 1}, {0x001C5, 0x001C5,      1, 1},
+    {0x001C7, 0x001C7,      2, 1}, {0x001C8, 0x001C8,      1, 1},
+    {0x001CA, 0x001CA,      2, 1}, {0x001CB, 0x001DB,      1, 2},
+    {0x001DE, 0x001EE,      1, 2}, {0x001F1, 0x001F1,      2, 1},
+    {0x001F2, 0x001F4,      1, 2}, {0x001F6, 0x001F6,    -97, 1},
+    {0x001F7, 0x001F7,    -56, 1}, {0x001F8, 0x0021E,      1, 2},
+    {0x00220, 0x00220,   -130, 1}, {0x00222, 0x00232,      1, 2},
+    {0x0023A, 0x0023A,  10795, 1}, {0x0023B, 0x0023B,      1, 1},
+    {0x0023D, 0x0023D,   -163, 1}, {0x0023E, 0x0023E,  10792, 1},
+    {0x00241, 0x00241,      1, 1}, {0x00243, 0x00243,   -195, 1},
+    {0x00244, 0x00244,     69, 1}, {0x00245, 0x00245,     71, 1},
+    {0x00246, 0x0024E,      1, 2}, {0x00345, 0x00345,    116, 1},
+    {0x00370, 0x00372,      1, 2}, {0x00376, 0x00376,      1, 1},
+    {0x0037F, 0x0037F,    116, 1}, {0x00386, 0x00386,     38, 1},
+    {0x00388, 0x0038A,     37, 1}, {0x0038C, 0x0038C,     64, 1},
+    {0x0038E, 0x0038F,     63, 1}, {0x00391, 0x003A1,     32, 1},
+    {0x003A3, 0x003AB,     32, 1}, {0x003C2, 0x003C2,      1, 1},
+    {0x003CF, 0x003CF,      8, 1}, {0x003D0, 0x003D0,    -30, 1},
+    {0x003D1, 0x003D1,    -25, 1}, {0x003D5, 0x003D5,    -15, 1},
+    {0x003D6, 0x003D6,    -22, 1}, {0x003D8, 0x003EE,      1, 2},
+    {0x003F0, 0x003F0,    -54, 1}, {0x003F1, 0x003F1,    -48, 1},
+    {0x003F4, 0x003F4,    -60, 1}, {0x003F5, 0x003F5,    -64, 1},
+    {0x003F7, 0x003F7,      1, 1}, {0x003F9, 0x003F9,     -7, 1},
+    {0x003FA, 0x003FA,      1, 1}, {0x003FD, 0x003FF,   -130, 1},
+    {0x00400, 0x0040F,     80, 1}, {0x00410, 0x0042F,     32, 1},
+    {0x00460, 0x00480,      1, 2}, {0x0048A, 0x004BE,      1, 2},
+    {0x004C0, 0x004C0,     15, 1}, {0x004C1, 0x004CD,      1, 2},
+    {0x004D0, 0x0052E,      1, 2}, {0x00531, 0x00556,     48, 1},
+    {0x010A0, 0x010C5,   7264, 1}, {0x010C7, 0x010C7,   7264, 1},
+    {0x010CD, 0x010CD,   7264, 1}, {0x013F8, 0x013FD,     -8, 1},
+    {0x01C80, 0x01C80,  -6222, 1}, {0x01C81, 0x01C81,  -6221, 1},
+    {0x01C82, 0x01C82,  -6212, 1}, {0x01C83, 0x01C84,  -6210, 1},
+    {0x01C85, 0x01C85,  -6211, 1}, {0x01C86, 0x01C86,  -6204, 1},
+    {0x01C87, 0x01C87,  -6180, 1}, {0x01C88, 0x01C88,  35267, 1},
+    {0x01C90, 0x01CBA,  -3008, 1}, {0x01CBD, 0x01CBF,  -3008, 1},
+    {0x01E00, 0x01E94,      1, 2}, {0x01E9B, 0x01E9B,    -58, 1},
+    {0x01E9E, 0x01E9E,  -7615, 1}, {0x01EA0, 0x01EFE,      1, 2},
+    {0x01F08, 0x01F0F,     -8, 1}, {0x01F18, 0x01F1D,     -8, 1},
+    {0x01F28, 0x01F2F,     -8, 1}, {0x01F38, 0x01F3F,     -8, 1},
+    {0x01F48, 0x01F4D,     -8, 1}, {0x01F59, 0x01F5F,     -8, 2},
+    {0x01F68, 0x01F6F,     -8, 1}, {0x01F88, 0x01F8F,     -8, 1},
+    {0x01F98, 0x01F9F,     -8, 1}, {0x01FA8, 0x01FAF,     -8, 1},
+    {0x01FB8, 0x01FB9,     -8, 1}, {0x01FBA, 0x01FBB,    -74, 1},
+    {0x01FBC, 0x01FBC,     -9, 1}, {0x01FBE, 0x01FBE,  -7173, 1},
+    {0x01FC8, 0x01FCB,    -86, 1}, {0x01FCC, 0x01FCC,     -9, 1},
+    {0x01FD8, 0x01FD9,     -8, 1}, {0x01FDA, 0x01FDB,   -100, 1},
+    {0x01FE8, 0x01FE9,     -8, 1}, {0x01FEA, 0x01FEB,   -112, 1},
+    {0x01FEC, 0x01FEC,     -7, 1}, {0x01FF8, 0x01FF9,   -128, 1},
+    {0x01FFA, 0x01FFB,   -126, 1}, {0x01FFC, 0x01FFC,     -9, 1},
+    {0x02126, 0x02126,  -7517, 1}, {0x0212A, 0x0212A,  -8383, 1},
+    {0x0212B, 0x0212B,  -8262, 1}, {0x02132, 0x02132,     28, 1},
+    {0x02160, 0x0216F,     16, 1}, {0x02183, 0x02183,      1, 1},
+    {0x024B6, 0x024CF,     26, 1}, {0x02C00, 0x02C2F,     48, 1},
+    {0x02C60, 0x02C60,      1, 1}, {0x02C62, 0x02C62, -10743, 1},
+    {0x02C63, 0x02C63,  -3814, 1}, {0x02C64, 0x02C64, -10727, 1},
+    {0x02C67, 0x02C6B,      1, 2}, {0x02C6D, 0x02C6D, -10780, 1},
+    {0x02C6E, 0x02C6E, -10749, 1}, {0x02C6F, 0x02C6F, -10783, 1},
+    {0x02C70, 0x02C70, -10782, 1}, {0x02C72, 0x02C72,      1, 1},
+    {0x02C75, 0x02C75,      1, 1}, {0x02C7E, 0x02C7F, -10815, 1},
+    {0x02C80, 0x02CE2,      1, 2}, {0x02CEB, 0x02CED,      1, 2},
+    {0x02CF2, 0x02CF2,      1, 1}, {0x0A640, 0x0A66C,      1, 2},
+    {0x0A680, 0x0A69A,      1, 2}, {0x0A722, 0x0A72E,      1, 2},
+    {0x0A732, 0x0A76E,      1, 2}, {0x0A779, 0x0A77B,      1, 2},
+    {0x0A77D, 0x0A77D, -35332, 1}, {0x0A77E, 0x0A786,      1, 2},
+    {0x0A78B, 0x0A78B,      1, 1}, {0x0A78D, 0x0A78D, -42280, 1},
+    {0x0A790, 0x0A792,      1, 2}, {0x0A796, 0x0A7A8,      1, 2},
+    {0x0A7AA, 0x0A7AA, -42308, 1}, {0x0A7AB, 0x0A7AB, -42319, 1},
+    {0x0A7AC, 0x0A7AC, -42315, 1}, {0x0A7AD, 0x0A7AD, -42305, 1},
+    {0x0A7AE, 0x0A7AE, -42308, 1}, {0x0A7B0, 0x0A7B0, -42258, 1},
+    {0x0A7B1, 0x0A7B1, -42282, 1}, {0x0A7B2, 0x0A7B2, -42261, 1},
+    {0x0A7B3, 0x0A7B3,    928, 1}, {0x0A7B4, 0x0A7C2,      1, 2},
+    {0x0A7C4, 0x0A7C4,    -48, 1}, {0x0A7C5, 0x0A7C5, -42307, 1},
+    {0x0A7C6, 0x0A7C6, -35384, 1}, {0x0A7C7, 0x0A7C9,      1, 2},
+    {0x0A7D0, 0x0A7D0,      1, 1}, {0x0A7D6, 0x0A7D8,      1, 2},
+    {0x0A7F5, 0x0A7F5,      1, 1}, {0x0AB70, 0x0ABBF, -38864, 1},
+    {0x0FF21, 0x0FF3A,     32, 1}, {0x10400, 0x10427,     40, 1},
+    {0x104B0, 0x104D3,     40, 1}, {0x10570, 0x1057A,     39, 1},
+    {0x1057C, 0x1058A,     39, 1}, {0x1058C, 0x10592,     39, 1},
+    {0x10594, 0x10595,     39, 1}, {0x10C80, 0x10CB2,     64, 1},
+    {0x118A0, 0x118BF,     32, 1}, {0x16E40, 0x16E5F,     32, 1},
+    {0x1E900, 0x1E921,     34, 1}
+};
+//---------------------------------------------------------------------------
+void TSP_StringHelper::ICaseMapper::Map(std::string& str, std::size_t offset, IEMapping mapping)
+{
+    if (offset >= str.length())
+        return;
+
+    switch (m_InstructionSet.load(std::memory_order_relaxed))
+    {
+        #ifdef M_X86_StringHelper
+            case IEInstructionSet::IE_IS_Avx2: MapUtf8<IAvx2>  (str, offset, mapping); return;
+            case IEInstructionSet::IE_IS_Sse2: MapUtf8<ISse2>  (str, offset, mapping); return;
+        #endif
+
+        default:                               MapUtf8<IScalar>(str, offset, mapping); return;
+    }
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::ICaseMapper::Map(std::wstring& str, std::size_t offset, IEMapping mapping)
+{
+    if (offset >= str.length())
+        return;
+
+    wchar_t*          pStr   = &str[offset];
+    const std::size_t length = str.length() - offset;
+
+    switch (m_InstructionSet.load(std::memory_order_relaxed))
+    {
+        #ifdef M_X86_StringHelper
+            case IEInstructionSet::IE_IS_Avx2: MapWide<IAvx2>  (pStr, length, mapping); return;
+            case IEInstructionSet::IE_IS_Sse2: MapWide<ISse2>  (pStr, length, mapping); return;
+        #endif
+
+        default:                               MapWide<IScalar>(pStr, length, mapping); return;
+    }
+}
+//---------------------------------------------------------------------------
+template <class ISet>
+void TSP_StringHelper::ICaseMapper::MapUtf8(std::string& str, std::size_t offset, IEMapping mapping)
+{
+    const std::size_t   length  = str.length();
+    const bool          upper   = mapping == IEMapping::IE_M_Upper;
+    const std::uint32_t first   = upper ? 'a' : 'A';
+    const ITable&       table   = GetTable(mapping);
+          char*         pStr    = &str[0];
+    const std::uint8_t* pBytes  = reinterpret_cast<const std::uint8_t*>(pStr);
+          std::string   result;
+          char*         pResult = nullptr;
+          std::size_t   i       = offset;
+          std::size_t   j       = 0;
+
+    // the string is mapped in place, unless a mapped char is encoded on a different length, e.g.
+    // U+023A mapped to U+2C65, in which case the remaining string is written to a result
+    while (i < length)
+    {
+        if (pBytes[i] < 0x80)
+        {
+            std::size_t asciiCount = 1;
+
+            // the ASCII letter case is given by the bit 5
+            if (pBytes[i] - first < 26)
+                pStr[i] ^= 0x20;
+
+            // convert the following ASCII chars by blocks, if any
+            if (i + 1 < length && pBytes[i + 1] < 0x80)
+                asciiCount += ISet::MapAscii(pStr + i + 1, length - i - 1, upper);
+
+            if (pResult)
+            {
+                std::memcpy(pResult + j, pStr + i, asciiCount);
+                j += asciiCount;
+            }
+
+            i += asciiCount;
+            continue;
+        }
+
+        std::size_t   next = i;
+        std::uint32_t codePoint;
+
+        // the invalid sequences are kept as is
+        if (!ITranscoder::Decode(pBytes, length, next, codePoint))
+        {
+            if (pResult)
+                pResult[j++] = pStr[i];
+
+            ++i;
+            continue;
+        }
+
+        const std::uint32_t mapped = Map(codePoint, table);
+
+        if (mapped == codePoint && !pResult)
+        {
+            i = next;
+            continue;
+        }
+
+        char              sequence[4];
+        const std::size_t size = ITranscoder::Encode(mapped, sequence);
+
+        // a mapped char is at most 1.5 times longer than the original one
+        if (!pResult && size != next - i)
+        {
+            result.resize(i + (length - i) * 3 / 2);
+            pResult = &result[0];
+            std::memcpy(pResult, pStr, i);
+            j = i;
+        }
+
+        if (pResult)
+        {
+            std::memcpy(pResult + j, sequence, size);
+            j += size;
+        }
+        else
+            std::memcpy(pStr + i, sequence, size);
+
+        i = next;
+    }
+
+    if (!pResult)
+        return;
+
+    result.resize(j);
+    str.swap(result);
+}
+//---------------------------------------------------------------------------
+template <class ISet, class T>
+void TSP_StringHelper::ICaseMapper::MapWide(T* pStr, std::size_t length, IEMapping mapping)
+{
+    const bool          upper = mapping == IEMapping::IE_M_Upper;
+    const std::uint32_t first = upper ? 'a' : 'A';
+    const ITable&       table = GetTable(mapping);
+          std::size_t   i     = 0;
+
+    while (i < length)
+    {
+        const std::uint32_t c = IScalar::IUnit<T>(pStr[i]);
+
+        if (c < 0x80)
+        {
+            // the ASCII letter case is given by the bit 5
+            if (c - first < 26)
+                pStr[i] = T(c ^ 0x20);
+
+            ++i;
+
+            // convert the following ASCII chars by blocks, if any
+            if (i < length && IScalar::IUnit<T>(pStr[i]) < 0x80)
+                i += ISet::MapAscii(pStr + i, length - i, upper);
+
+            continue;
+        }
+
+        // surrogate pair, the chars outside the basic plane are always mapped to chars outside it
+        if (sizeof(T) == 2 && c >= 0xD800 && c <= 0xDBFF && i + 1 < length)
+        {
+            const std::uint32_t low = IScalar::IUnit<T>(pStr[i + 1]);
+
+            if (low >= 0xDC00 && low <= 0xDFFF)
+            {
+                const std::uint32_t mapped = Map(0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00), table) - 0x10000;
+
+                pStr[i]     = T(0xD800 + (mapped >> 10));
+                pStr[i + 1] = T(0xDC00 + (mapped & 0x3FF));
+                i          += 2;
+                continue;
+            }
+        }
+
+        // the surrogates and the values above U+10FFFF have no mapping
+        pStr[i] = T(Map(c, table));
+        ++i;
+    }
+}
+//---------------------------------------------------------------------------
+const TSP_StringHelper::ICaseMapper::ITable& TSP_StringHelper::ICaseMapper::GetTable(IEMapping mapping)
+{
+    // the tables are built once, the initialization of the local static variables is thread-safe
+    switch (mapping)
+    {
+        case IEMapping::IE_M_Lower:
+        {
+            static const ITable table = BuildTable(m_LowerCase, sizeof(m_LowerCase) / sizeof(IRange));
+            return table;
+        }
+
+        case IEMapping::IE_M_Upper:
+        {
+            static const ITable table = BuildTable(m_UpperCase, sizeof(m_UpperCase) / sizeof(IRange));
+            return table;
+        }
+
+        default:
+        {
+            static const ITable table = BuildTable(m_FoldCase, sizeof(m_FoldCase) / sizeof(IRange));
+            return table;
+        }
+    }
+}
+//---------------------------------------------------------------------------
+TSP_StringHelper::ICaseMapper::ITable TSP_StringHelper::ICaseMapper::BuildTable(const IRange* pRanges, std::size_t count)
+{
+    ITable table;
+
+    const std::size_t blockCount = (pRanges[count - 1].m_Last >> 6) + 1;
+
+    // the first deltas block is the identity, shared by all the blocks without mapping
+    table.m_Blocks.assign(blockCount, 0);
+    table.m_Deltas.assign(64, 0);
+
+    std::size_t rangeIndex = 0;
+
+    for (std::size_t block = 0; block < blockCount; ++block)
+    {
+        const std::uint32_t first      = std::uint32_t(block << 6);
+        const std::uint32_t last       = first + 63;
+              std::int32_t  deltas[64] = {};
+              bool          mapped     = false;
+
+        // skip the ranges ending before the block
+        while (rangeIndex < count && pRanges[rangeIndex].m_Last < first)
+            ++rangeIndex;
+
+        for (std::size_t i = rangeIndex; i < count && pRanges[i].m_First <= last; ++i)
+        {
+            const IRange& range = pRanges[i];
+
+            for (std::uint32_t c = std::max(range.m_First, first); c <= std::min(range.m_Last, last); ++c)
+                if (!((c - range.m_First) % range.m_Stride))
+                {
+                    deltas[c - first] = range.m_Delta;
+                    mapped            = true;
+                }
+        }
+
+        if (!mapped)
+            continue;
+
+        const std::size_t deltaBlockCount = table.m_Deltas.size() >> 6;
+              std::size_t deltaBlock      = 1;
+
+        // search for an identical block to share
+        for (; deltaBlock < deltaBlockCount; ++deltaBlock)
+            if (std::equal(deltas, deltas + 64, table.m_Deltas.begin() + (deltaBlock << 6)))
+                break;
+
+        if (deltaBlock == deltaBlockCount)
+            table.m_Deltas.insert(table.m_Deltas.end(), deltas, deltas + 64);
+
+        table.m_Blocks[block] = std::uint16_t(deltaBlock);
+    }
+
+    return table;
+}
+//---------------------------------------------------------------------------
+inline std::uint32_t TSP_StringHelper::ICaseMapper::Map(std::uint32_t codePoint, const ITable& table)
+{
+    const std::size_t block = codePoint >> 6;
+
+    if (block >= table.m_Blocks.size())
+        return codePoint;
+
+    return codePoint + std::uint32_t(table.m_Deltas[(std::size_t(table.m_Blocks[block]) << 6) | (codePoint & 0x3F)]);
+}
+//---------------------------------------------------------------------------
+// Static members
+//---------------------------------------------------------------------------
+std::atomic<TSP_StringHelper::IEInstructionSet> TSP_StringHelper::m_InstructionSet
+        (TSP_StringHelper::GetSupportedInstructionSet());
+//---------------------------------------------------------------------------
+// TSP_StringHelper
+//---------------------------------------------------------------------------
+TSP_StringHelper::IEInstructionSet TSP_StringHelper::GetInstructionSet()
+{
+    return m_InstructionSet.load(std::memory_order_relaxed);
+}
+//---------------------------------------------------------------------------
+TSP_StringHelper::IEInstructionSet TSP_StringHelper::SetInstructionSet(IEInstructionSet instructionSet)
+{
+    const IEInstructionSet supported = GetSupportedInstructionSet();
+
+    const IEInstructionSet used = instructionSet > supported ? supported : instructionSet;
+
+    // NOTE the conversions may read the instruction set from other threads in the meantime, they use
+    // either the previous or the new one
+    m_InstructionSet.store(used, std::memory_order_relaxed);
+
+    return used;
+}
+//---------------------------------------------------------------------------
+TSP_StringHelper::IEInstructionSet TSP_StringHelper::GetSupportedInstructionSet()
+{
+    #if defined(M_X86_StringHelper) && defined(_MSC_VER)
+        int info[4];
+
+        __cpuid(info, 1);
+
+        const bool sse2    = (info[3] & (1 << 26)) != 0;
+        const bool osXSave = (info[2] & (1 << 27)) != 0;
+        const bool avx     = (info[2] & (1 << 28)) != 0;
+              bool avx2    = false;
+
+        // AVX2 also requires the operating system to save the extended registers
+        if (osXSave && avx && (_xgetbv(0) & 6) == 6)
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+
+        if (avx2)
+            return IEInstructionSet::IE_IS_Avx2;
+
+        if (sse2)
+            return IEInstructionSet::IE_IS_Sse2;
+    #elif defined(M_X86_StringHelper)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return IEInstructionSet::IE_IS_Avx2;
+
+        if (__builtin_cpu_supports("sse2"))
+            return IEInstructionSet::IE_IS_Sse2;
+    #endif
+
+    return IEInstructionSet::IE_IS_Scalar;
+}
+//---------------------------------------------------------------------------
+std::string TSP_StringHelper::SetLocale_ThreadSafe(std::int32_t category, const char* pLocale)
+{
+    static std::mutex lockMutex;
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(lockMutex);
+
+    // change the locale and get the previous one
+    const char* pRes = std::setlocale(category, pLocale);
+
+    return pRes ? std::string(pRes) : std::string();
+}
+//---------------------------------------------------------------------------
+std::string TSP_StringHelper::ToLowerCase(const std::string& str)
+{
+    std::string result(str);
+    ICaseMapper::Map(result, 0, ICaseMapper::IEMapping::IE_M_Lower);
+    return result;
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_StringHelper::ToLowerCase(const std::wstring& str)
+{
+    std::wstring result(str);
+    ICaseMapper::Map(result, 0, ICaseMapper::IEMapping::IE_M_Lower);
+    return result;
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::ToLowerCase(const char* pStr, std::size_t length, std::string& result)
+{
+    if (!pStr || !length)
+        return;
+
+    const std::size_t offset = result.length();
+
+    // the string is copied first, then mapped in place
+    result.append(pStr, length);
+    ICaseMapper::Map(result, offset, ICaseMapper::IEMapping::IE_M_Lower);
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::ToLowerCase(const wchar_t* pStr, std::size_t length, std::wstring& result)
+{
+    if (!pStr || !length)
+        return;
+
+    const std::size_t offset = result.length();
+
+    // the string is copied first, then mapped in place
+    result.append(pStr, length);
+    ICaseMapper::Map(result, offset, ICaseMapper::IEMapping::IE_M_Lower);
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::ToLowerCase_InPlace(std::string& str)
+{
+    ICaseMapper::Map(str, 0, ICaseMapper::IEMapping::IE_M_Lower);
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::ToLowerCase_InPlace(std::wstring& str)
+{
+    ICaseMapper::Map(str, 0, ICaseMapper::IEMapping::IE_M_Lower);
+}
+//---------------------------------------------------------------------------
+std::string TSP_StringHelper::ToUpperCase(const std::string& str)
+{
+    std::string result(str);
+    ICaseMapper::Map(result, 0, ICaseMapper::IEMapping::IE_M_Upper);
+    return result;
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_StringHelper::ToUpperCase(const std::wstring& str)
+{
+    std::wstring result(str);
+    ICaseMapper::Map(result, 0, ICaseMapper::IEMapping::IE_M_Upper);
+    return result;
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::ToUpperCase(const char* pStr, std::size_t length, std::string& result)
+{
+    if (!pStr || !length)
+        return;
+
+    const std::size_t offset = result.length();
+
+    // the string is copied first, then mapped in place
+    result.append(pStr, length);
+    ICaseMapper::Map(result, offset, ICaseMapper::IEMapping::IE_M_Upper);
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::ToUpperCase(const wchar_t* pStr, std::size_t length, std::wstring& result)
+{
+    if (!pStr || !length)
+        return;
+
+    const std::size_t offset = result.length();
+
+    // the string is copied first, then mapped in place
+    result.append(pStr, length);
+    ICaseMapper::Map(result, offset, ICaseMapper::IEMapping::IE_M_Upper);
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::ToUpperCase_InPlace(std::string& str)
+{
+    ICaseMapper::Map(str, 0, ICaseMapper::IEMapping::IE_M_Upper);
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::ToUpperCase_InPlace(std::wstring& str)
+{
+    ICaseMapper::Map(str, 0, ICaseMapper::IEMapping::IE_M_Upper);
+}
+//---------------------------------------------------------------------------
+std::string TSP_StringHelper::FoldCase(const std::string& str)
+{
+    std::string result(str);
+    ICaseMapper::Map(result, 0, ICaseMapper::IEMapping::IE_M_Fold);
+    return result;
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_StringHelper::FoldCase(const std::wstring& str)
+{
+    std::wstring result(str);
+    ICaseMapper::Map(result, 0, ICaseMapper::IEMapping::IE_M_Fold);
+    return result;
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::FoldCase(const char* pStr, std::size_t length, std::string& result)
+{
+    if (!pStr || !length)
+        return;
+
+    const std::size_t offset = result.length();
+
+    // the string is copied first, then mapped in place
+    result.append(pStr, length);
+    ICaseMapper::Map(result, offset, ICaseMapper::IEMapping::IE_M_Fold);
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::FoldCase(const wchar_t* pStr, std::size_t length, std::wstring& result)
+{
+    if (!pStr || !length)
+        return;
+
+    const std::size_t offset = result.length();
+
+    // the string is copied first, then mapped in place
+    result.append(pStr, length);
+    ICaseMapper::Map(result, offset, ICaseMapper::IEMapping::IE_M_Fold);
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::FoldCase_InPlace(std::string& str)
+{
+    ICaseMapper::Map(str, 0, ICaseMapper::IEMapping::IE_M_Fold);
+}
+//---------------------------------------------------------------------------
+void TSP_StringHelper::FoldCase_InPlace(std::wstring& str)
+{
+    ICaseMapper::Map(str, 0, ICaseMapper::IEMapping::IE_M_Fold);
 }
 //---------------------------------------------------------------------------
 std::wstring TSP_StringHelper::Utf8ToUtf16(const std::string& str)
 {
-    // convert utf8 to utf16
-    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
-    return converter.from_bytes(str.c_str());
+    std::wstring result;
+
+    if (!Utf8ToUtf16(str.data(), str.length(), result))
+        throw std::range_error("Invalid UTF-8 string");
+
+    return result;
+}
+//---------------------------------------------------------------------------
+bool TSP_StringHelper::Utf8ToUtf16(const char* pStr, std::size_t length, std::u16string& result)
+{
+    return ITranscoder::FromUtf8(pStr, length, result);
+}
+//---------------------------------------------------------------------------
+bool TSP_StringHelper::Utf8ToUtf16(const char* pStr, std::size_t length, std::wstring& result)
+{
+    return ITranscoder::FromUtf8(pStr, length, result);
 }
 //---------------------------------------------------------------------------
 std::string TSP_StringHelper::Utf16ToUtf8(const std::wstring& str)
 {
-    // convert utf16 to utf8
-    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
-    return converter.to_bytes(str.c_str());
+    std::string result;
+
+    if (!Utf16ToUtf8(str.data(), str.length(), result))
+        throw std::range_error("Invalid UTF-16 string");
+
+    return result;
+}
+//---------------------------------------------------------------------------
+bool TSP_StringHelper::Utf16ToUtf8(const char16_t* pStr, std::size_t length, std::string& result)
+{
+    return ITranscoder::ToUtf8(pStr, length, result);
+}
+//---------------------------------------------------------------------------
+bool TSP_StringHelper::Utf16ToUtf8(const wchar_t* pStr, std::size_t length, std::string& result)
+{
+    return ITranscoder::ToUtf8(pStr, length, result);
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_StringHelper::GetUtf16Length(const char* pStr, std::size_t length)
+{
+    std::size_t leadCount;
+    std::size_t longCount;
+
+    ITranscoder::CountUtf8(pStr, length, leadCount, longCount);
+
+    return leadCount + longCount;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_StringHelper::GetWideLength(const char* pStr, std::size_t length)
+{
+    std::size_t leadCount;
+    std::size_t longCount;
+
+    ITranscoder::CountUtf8(pStr, length, leadCount, longCount);
+
+    // the 4 bytes long sequences are encoded as surrogate pairs only if wchar_t is 2 bytes long
+    return sizeof(wchar_t) == 2 ? leadCount + longCount : leadCount;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_StringHelper::GetUtf8Length(const char16_t* pStr, std::size_t length)
+{
+    return ITranscoder::GetUtf8Length(pStr, length);
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_StringHelper::GetUtf8Length(const wchar_t* pStr, std::size_t length)
+{
+    return ITranscoder::GetUtf8Length(pStr, length);
 }
 //---------------------------------------------------------------------------
 std::string TSP_StringHelper::BoolToStr(bool value, bool numeric)
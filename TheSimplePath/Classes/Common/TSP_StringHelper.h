@@ -30,6 +30,9 @@
 #pragma once
 
 // std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <mutex>
 
@@ -38,11 +41,44 @@
 
 /**
 * Helper class for strings
+*@note The UTF-8, UTF-16 and UTF-32 conversions and the case mappings use the best instruction set
+*      supported by the processor (AVX2, SSE2 or scalar code), selected at runtime, to process the
+*      ASCII text by blocks
 *@author Jean-Milost Reymond
 */
 class TSP_StringHelper
 {
     public:
+        /**
+        * Instruction set used by the string conversions
+        */
+        enum class IEInstructionSet
+        {
+            IE_IS_Scalar = 0,
+            IE_IS_Sse2,
+            IE_IS_Avx2
+        };
+
+        /**
+        * Gets the instruction set used by the string conversions
+        *@return the instruction set
+        */
+        static IEInstructionSet GetInstructionSet();
+
+        /**
+        * Sets the instruction set used by the string conversions
+        *@param instructionSet - instruction set to use
+        *@return the instruction set really used, which may be lower if the processor doesn't support the requested one
+        *@note Mainly useful to compare the conversions against each other
+        */
+        static IEInstructionSet SetInstructionSet(IEInstructionSet instructionSet);
+
+        /**
+        * Gets the best instruction set supported by the processor
+        *@return the best supported instruction set
+        */
+        static IEInstructionSet GetSupportedInstructionSet();
+
         /**
         * A thread-safe version of the std::setLocale() function
         *@param category - locale category identifier, one of the LC_xxx macros, may be 0
@@ -125,10 +161,28 @@ class TSP_StringHelper
         * Converts string to lower case
         *@param str - string to convert
         *@return converted string
+        *@note The Unicode simple case mappings are used, independently of the current locale. The std::string
+        *      are read as UTF-8 and their invalid sequences are kept as is, their length may change
         */
         static std::string  ToLowerCase(const std::string&  str);
         static std::wstring ToLowerCase(const std::wstring& str);
 
+        /**
+        * Converts a string to lower case, and appends it to a result
+        *@param pStr - string to convert
+        *@param length - string length, in chars
+        *@param[in, out] result - string to which the converted string is appended
+        */
+        static void ToLowerCase(const char*    pStr, std::size_t length, std::string&  result);
+        static void ToLowerCase(const wchar_t* pStr, std::size_t length, std::wstring& result);
+
+        /**
+        * Converts a string to lower case, in place
+        *@param[in, out] str - string to convert
+        */
+        static void ToLowerCase_InPlace(std::string&  str);
+        static void ToLowerCase_InPlace(std::wstring& str);
+
         /**
         * Converts string to upper case
         *@param str - string to convert
@@ -137,20 +191,114 @@ class TSP_StringHelper
         static std::string  ToUpperCase(const std::string&  str);
         static std::wstring ToUpperCase(const std::wstring& str);
 
+        /**
+        * Converts a string to upper case, and appends it to a result
+        *@param pStr - string to convert
+        *@param length - string length, in chars
+        *@param[in, out] result - string to which the converted string is appended
+        */
+        static void ToUpperCase(const char*    pStr, std::size_t length, std::string&  result);
+        static void ToUpperCase(const wchar_t* pStr, std::size_t length, std::wstring& result);
+
+        /**
+        * Converts a string to upper case, in place
+        *@param[in, out] str - string to convert
+        */
+        static void ToUpperCase_InPlace(std::string&  str);
+        static void ToUpperCase_InPlace(std::wstring& str);
+
+        /**
+        * Folds the case of a string, to compare or search it regardless of its case
+        *@param str - string to convert
+        *@return converted string
+        *@note The Unicode simple case folding is used. Unlike the lower case, it maps e.g. the final
+        *      sigma and the sigma to the same char
+        */
+        static std::string  FoldCase(const std::string&  str);
+        static std::wstring FoldCase(const std::wstring& str);
+
+        /**
+        * Folds the case of a string, and appends it to a result
+        *@param pStr - string to convert
+        *@param length - string length, in chars
+        *@param[in, out] result - string to which the converted string is appended
+        */
+        static void FoldCase(const char*    pStr, std::size_t length, std::string&  result);
+        static void FoldCase(const wchar_t* pStr, std::size_t length, std::wstring& result);
+
+        /**
+        * Folds the case of a string, in place
+        *@param[in, out] str - string to convert
+        */
+        static void FoldCase_InPlace(std::string&  str);
+        static void FoldCase_InPlace(std::wstring& str);
+
         /**
         * Converts an Utf8 encoded string to Utf16
         *@param str - string to convert
         *@return converted string
+        *@throw std::range_error if the string isn't a valid UTF-8 string
         */
         static std::wstring Utf8ToUtf16(const std::string& str);
 
+        /**
+        * Converts an UTF-8 string to UTF-16, and appends it to a result
+        *@param pStr - string to convert
+        *@param length - string length, in bytes
+        *@param[in, out] result - string to which the converted string is appended
+        *@return true on success, false if the string isn't a valid UTF-8 string, the result is unchanged in this case
+        *@note The wchar_t strings are converted to UTF-32 on the platforms where wchar_t is 4 bytes long
+        */
+        static bool Utf8ToUtf16(const char* pStr, std::size_t length, std::u16string& result);
+        static bool Utf8ToUtf16(const char* pStr, std::size_t length, std::wstring&   result);
+
         /**
         * Converts an Utf16 encoded string to Utf8
         *@param str - string to convert
         *@return converted string
+        *@throw std::range_error if the string isn't a valid UTF-16 string
         */
         static std::string Utf16ToUtf8(const std::wstring& str);
 
+        /**
+        * Converts an UTF-16 string to UTF-8, and appends it to a result
+        *@param pStr - string to convert
+        *@param length - string length, in chars
+        *@param[in, out] result - string to which the converted string is appended
+        *@return true on success, false if the string isn't a valid UTF-16 string, the result is unchanged in this case
+        *@note The wchar_t strings are read as UTF-32 on the platforms where wchar_t is 4 bytes long
+        */
+        static bool Utf16ToUtf8(const char16_t* pStr, std::size_t length, std::string& result);
+        static bool Utf16ToUtf8(const wchar_t*  pStr, std::size_t length, std::string& result);
+
+        /**
+        * Gets the length of an UTF-8 string once converted to UTF-16
+        *@param pStr - UTF-8 string
+        *@param length - string length, in bytes
+        *@return the converted string length, in chars
+        *@note The string isn't validated, the length is only exact for a valid string
+        */
+        static std::size_t GetUtf16Length(const char* pStr, std::size_t length);
+
+        /**
+        * Gets the length of an UTF-8 string once converted to wchar_t
+        *@param pStr - UTF-8 string
+        *@param length - string length, in bytes
+        *@return the converted string length, in chars
+        *@note The string isn't validated, the length is only exact for a valid string
+        */
+        static std::size_t GetWideLength(const char* pStr, std::size_t length);
+
+        /**
+        * Gets the length of an UTF-16 string once converted to UTF-8
+        *@param pStr - UTF-16 string, UTF-32 for a wchar_t string if wchar_t is 4 bytes long
+        *@param length - string length, in chars
+        *@return the converted string length, in bytes
+        *@note The string isn't validated, the length is only exact for a valid string
+        */
+        static std::size_t GetUtf8Length(const char16_t* pStr, std::size_t length);
+        static std::size_t GetUtf8Length(const wchar_t*  pStr, std::size_t length);
+
         /**
         * Converts a boolean value to string
         *@param value - boolean value to convert
@@ -174,6 +322,15 @@ class TSP_StringHelper
         */
         static bool StrToBool(const std::string&  str);
         static bool StrToBool(const std::wstring& str);
+
+    private:
+        class IScalar;
+        class ISse2;
+        class IAvx2;
+        class ITranscoder;
+        class ICaseMapper;
+
+        static std::atomic<IEInstructionSet> m_InstructionSet;
 };
 
 //---------------------------------------------------------------------------
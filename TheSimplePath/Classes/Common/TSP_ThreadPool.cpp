@@ -0,0 +1,168 @@
+/****************************************************************************
+ * ==> TSP_ThreadPool ------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Pool of worker threads running parallel tasks              *
+ * Contained in: Common                                                     *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_ThreadPool.h"
+
+//---------------------------------------------------------------------------
+// TSP_ThreadPool
+//---------------------------------------------------------------------------
+TSP_ThreadPool::TSP_ThreadPool() :
+    m_NextSlot(0)
+{}
+//---------------------------------------------------------------------------
+TSP_ThreadPool::~TSP_ThreadPool()
+{
+    {
+        // lock up the thread
+        std::unique_lock<std::mutex> lock(m_Mutex);
+
+        m_Stopping = true;
+    }
+
+    m_Wake.notify_all();
+
+    for (std::size_t i = 0; i < m_Workers.size(); ++i)
+        m_Workers[i].join();
+}
+//---------------------------------------------------------------------------
+TSP_ThreadPool* TSP_ThreadPool::Instance()
+{
+    // NOTE the instance is created on the first call, which is thread-safe since C++11
+    static TSP_ThreadPool pool;
+    return &pool;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_ThreadPool::GetSlotCount() const
+{
+    const std::size_t hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads ? hardwareThreads : 1;
+}
+//---------------------------------------------------------------------------
+void TSP_ThreadPool::Run(const ITask& task, std::size_t slotCount)
+{
+    // lock up the pool for the whole run. If it's already running a task, e.g. if called from a
+    // slot, run the slots on the calling thread instead of waiting, which could never end
+    std::unique_lock<std::mutex> runLock(m_RunMutex, std::try_to_lock);
+
+    if (!runLock.owns_lock() || slotCount < 2)
+    {
+        for (std::size_t i = 0; i < slotCount; ++i)
+            task(i);
+
+        return;
+    }
+
+    Start();
+
+    {
+        // lock up the thread
+        std::unique_lock<std::mutex> lock(m_Mutex);
+
+        m_pTask     = &task;
+        m_SlotCount = slotCount;
+        m_NextSlot.store(0);
+        m_Running   = m_Workers.size();
+        ++m_Generation;
+    }
+
+    m_Wake.notify_all();
+
+    // the calling thread runs slots too
+    RunSlots();
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    // wait until all the workers left the task, they may still run their last slot
+    m_Done.wait(lock, [this]() { return !m_Running; });
+
+    m_pTask     = nullptr;
+    m_SlotCount = 0;
+}
+//---------------------------------------------------------------------------
+void TSP_ThreadPool::Start()
+{
+    if (m_Started)
+        return;
+
+    m_Started = true;
+
+    const std::size_t workerCount = GetSlotCount() - 1;
+
+    m_Workers.reserve(workerCount);
+
+    for (std::size_t i = 0; i < workerCount; ++i)
+        try
+        {
+            m_Workers.push_back(std::thread(&TSP_ThreadPool::Work, this));
+        }
+        catch (...)
+        {
+            // not enough resources to start another thread, the started ones will do the work
+            break;
+        }
+}
+//---------------------------------------------------------------------------
+void TSP_ThreadPool::RunSlots()
+{
+    for (std::size_t slot = m_NextSlot++; slot < m_SlotCount; slot = m_NextSlot++)
+        (*m_pTask)(slot);
+}
+//---------------------------------------------------------------------------
+void TSP_ThreadPool::Work()
+{
+    std::uint64_t generation = 0;
+
+    for (;;)
+    {
+        {
+            // lock up the thread
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            // wait for a new task, or for the pool to stop
+            m_Wake.wait(lock, [this, generation]() { return m_Stopping || m_Generation != generation; });
+
+            if (m_Stopping)
+                return;
+
+            generation = m_Generation;
+        }
+
+        RunSlots();
+
+        {
+            // lock up the thread
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            if (!--m_Running)
+                m_Done.notify_all();
+        }
+    }
+}
+//---------------------------------------------------------------------------
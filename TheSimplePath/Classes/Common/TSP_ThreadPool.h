@@ -0,0 +1,124 @@
+/****************************************************************************
+ * ==> TSP_ThreadPool ------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Pool of worker threads running parallel tasks              *
+ * Contained in: Common                                                     *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+* Pool of worker threads, runs the slots of a parallel task without starting new threads each time
+*@note The workers are started on the first run and live until the application ends. Only one task
+*      runs in the pool at once, a task started while the pool is busy, e.g. from another thread or
+*      from inside a running task, is run entirely by its calling thread
+*@author Jean-Milost Reymond
+*/
+class TSP_ThreadPool
+{
+    public:
+        /**
+        * Task, called once per slot with the slot index
+        *@note A task should not throw
+        */
+        typedef std::function<void(std::size_t slot)> ITask;
+
+        /**
+        * Gets the thread pool instance
+        *@return the thread pool instance
+        */
+        static TSP_ThreadPool* Instance();
+
+        /**
+        * Gets the maximum number of slots which may run in parallel
+        *@return the slot count, i.e. the worker count plus the calling thread
+        */
+        virtual std::size_t GetSlotCount() const;
+
+        /**
+        * Runs a task on several slots in parallel, and waits until all the slots are done
+        *@param task - task to run
+        *@param slotCount - number of slots to run, the task is called once for each of them
+        *@note The calling thread also runs slots, so a single slot never wakes a worker
+        */
+        virtual void Run(const ITask& task, std::size_t slotCount);
+
+    private:
+        typedef std::vector<std::thread> IWorkers;
+
+        IWorkers                 m_Workers;
+        const ITask*             m_pTask      = nullptr;
+        std::size_t              m_SlotCount  = 0;
+        std::atomic<std::size_t> m_NextSlot;
+        std::size_t              m_Running    = 0;
+        std::uint64_t            m_Generation = 0;
+        bool                     m_Started    = false;
+        bool                     m_Stopping   = false;
+        std::mutex               m_RunMutex;
+        std::mutex               m_Mutex;
+        std::condition_variable  m_Wake;
+        std::condition_variable  m_Done;
+
+        TSP_ThreadPool();
+        virtual ~TSP_ThreadPool();
+
+        /**
+        * Copy constructor
+        *@param other - other pool to copy from
+        */
+        TSP_ThreadPool(const TSP_ThreadPool& other) = delete;
+
+        /**
+        * Copy operator
+        *@param other - other pool to copy from
+        */
+        const TSP_ThreadPool& operator = (const TSP_ThreadPool& other) = delete;
+
+        /**
+        * Starts the workers, if still not done
+        *@note Called while the run mutex is locked
+        */
+        void Start();
+
+        /**
+        * Runs the next free slots of the current task, until no slot remains
+        */
+        void RunSlots();
+
+        /**
+        * Worker thread main loop, waits for a task and runs its slots
+        */
+        void Work();
+};
@@ -33,10 +33,17 @@
 #include "TSP_StringHelper.h"
 
 // std
+#include <cctype>
+#include <climits>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 
+//---------------------------------------------------------------------------
+// Static members
+//---------------------------------------------------------------------------
+thread_local TSP_TimeHelper::IZoneCache   TSP_TimeHelper::m_ZoneCache;
+thread_local TSP_TimeHelper::ILocaleCache TSP_TimeHelper::m_LocaleCache;
 //---------------------------------------------------------------------------
 // TSP_TimeHelper
 //---------------------------------------------------------------------------
@@ -52,25 +59,25 @@ std::string TSP_TimeHelper::LocalTimeToIso8601(std::time_t time, const std::stri
 //---------------------------------------------------------------------------
 std::time_t TSP_TimeHelper::Iso8601ToTime(const std::string& str, const std::string& localeToUse)
 {
-    return StrToTime(str, "%Y-%b-%d %H:%M:%S", localeToUse);
+    return StrToTime(str, "%F %T", localeToUse);
 }
 //---------------------------------------------------------------------------
 std::string TSP_TimeHelper::UTCTimeToStr(std::time_t time, const std::string& format, const std::string& localeToUse)
 {
-    const std::tm* pUTCTime = std::gmtime(&time);
+    std::tm utcTime;
 
-    if (pUTCTime)
-        return TmToStr(*pUTCTime, format, "");
+    if (ToUTCTm(time, utcTime))
+        return TmToStr(utcTime, format, localeToUse);
 
     return "";
 }
 //---------------------------------------------------------------------------
 std::string TSP_TimeHelper::LocalTimeToStr(std::time_t time, const std::string& format, const std::string& localeToUse)
 {
-    const std::tm* pLocalTime = std::localtime(&time);
+    std::tm localTime;
 
-    if (pLocalTime)
-        return TmToStr(*pLocalTime, format, localeToUse);
+    if (ToLocalTm(time, localTime))
+        return TmToStr(localTime, format, localeToUse);
 
     return "";
 }
@@ -78,13 +85,23 @@ std::string TSP_TimeHelper::LocalTimeToStr(std::time_t time, const std::string&
 std::time_t TSP_TimeHelper::StrToTime(const std::string& str, const std::string& format, const std::string& localeToUse)
 {
     std::tm dateTime = StrToTm(str, format, localeToUse);
+
+    // let the system determine if the daylight saving time applies
+    dateTime.tm_isdst = -1;
+
     return std::mktime(&dateTime);
 }
 //---------------------------------------------------------------------------
 std::string TSP_TimeHelper::TmToStr(const std::tm& dateTime, const std::string& format, const std::string& localeToUse)
 {
+    std::string result;
+
+    // numeric formats don't depend on the locale, format them directly
+    if (FormatNumeric(dateTime, format, result))
+        return result;
+
     std::ostringstream sstr;
-    sstr.imbue(std::locale(localeToUse.c_str()));
+    sstr.imbue(GetLocale(localeToUse));
     sstr << std::put_time(&dateTime, format.c_str());
     return sstr.str();
 }
@@ -92,9 +109,14 @@ std::string TSP_TimeHelper::TmToStr(const std::tm& dateTime, const std::string&
 std::tm TSP_TimeHelper::StrToTm(const std::string& str, const std::string& format, const std::string& localeToUse)
 {
     std::tm dateTime = {};
+    bool    success;
+
+    // numeric formats don't depend on the locale, parse them directly
+    if (ParseNumeric(str, format, dateTime, success))
+        return success ? dateTime : std::tm() = {};
 
     std::istringstream ss(str.c_str());
-    ss.imbue(std::locale(localeToUse.c_str()));
+    ss.imbue(GetLocale(localeToUse));
     ss >> std::get_time(&dateTime, format.c_str());
 
     if (ss.fail())
@@ -103,3 +125,407 @@ std::tm TSP_TimeHelper::StrToTm(const std::string& str, const std::string& forma
     return dateTime;
 }
 //---------------------------------------------------------------------------
+bool TSP_TimeHelper::FormatTm(const std::tm&     dateTime,
+                              const std::string& format,
+                                    std::string& result,
+                              const std::string& localeToUse)
+{
+    // numeric formats don't depend on the locale, format them directly
+    if (FormatNumeric(dateTime, format, result))
+        return true;
+
+    // the other formats need a stream, which may throw if e.g. the locale doesn't exist
+    try
+    {
+        std::ostringstream sstr;
+        sstr.imbue(GetLocale(localeToUse));
+        sstr << std::put_time(&dateTime, format.c_str());
+
+        if (sstr.fail())
+            return false;
+
+        result = sstr.str();
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+//---------------------------------------------------------------------------
+bool TSP_TimeHelper::ParseTm(const std::string& str,
+                             const std::string& format,
+                                   std::tm&     dateTime,
+                             const std::string& localeToUse)
+{
+    std::tm result = {};
+    bool    success;
+
+    // numeric formats don't depend on the locale, parse them directly
+    if (ParseNumeric(str, format, result, success))
+    {
+        if (!success)
+            return false;
+
+        dateTime = result;
+        return true;
+    }
+
+    // the other formats need a stream, which may throw if e.g. the locale doesn't exist
+    try
+    {
+        std::istringstream ss(str.c_str());
+        ss.imbue(GetLocale(localeToUse));
+        ss >> std::get_time(&result, format.c_str());
+
+        if (ss.fail())
+            return false;
+
+        dateTime = result;
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+//---------------------------------------------------------------------------
+bool TSP_TimeHelper::ToUTCTm(std::time_t time, std::tm& dateTime)
+{
+    // split the time in days and seconds, rounding toward the past
+    long long days    = (long long)time / 86400;
+    long long seconds = (long long)time % 86400;
+
+    if (seconds < 0)
+    {
+        seconds += 86400;
+        --days;
+    }
+
+    // convert the days to a civil date, see http://howardhinnant.github.io/date_algorithms.html
+    const long long z     = days + 719468;
+    const long long era   = (z >= 0 ? z : z - 146096) / 146097;
+    const long long doe   = z - era * 146097;
+    const long long yoe   = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const long long doy   = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const long long mp    = (5 * doy + 2) / 153;
+    const long long day   = doy - (153 * mp + 2) / 5 + 1;
+    const long long month = mp < 10 ? mp + 3 : mp - 9;
+    const long long year  = yoe + era * 400 + (month <= 2);
+
+    // out of the std::tm range?
+    if (year - 1900 < INT_MIN || year - 1900 > INT_MAX)
+        return false;
+
+    // 1970-01-01 was a thursday
+    long long weekDay = (days + 4) % 7;
+
+    if (weekDay < 0)
+        weekDay += 7;
+
+    dateTime          = {};
+    dateTime.tm_year  = int(year - 1900);
+    dateTime.tm_mon   = int(month - 1);
+    dateTime.tm_mday  = int(day);
+    dateTime.tm_hour  = int(seconds / 3600);
+    dateTime.tm_min   = int((seconds / 60) % 60);
+    dateTime.tm_sec   = int(seconds % 60);
+    dateTime.tm_wday  = int(weekDay);
+    dateTime.tm_yday  = int(days - DaysFromCivil(year, 1, 1));
+    dateTime.tm_isdst = 0;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_TimeHelper::ToLocalTm(std::time_t time, std::tm& dateTime)
+{
+    IZoneCache& cache = m_ZoneCache;
+
+    // time zone offset unknown for this time?
+    if (time < cache.m_Start || time >= cache.m_End)
+    {
+        std::tm localTime;
+
+        #if defined (_WIN32)
+            if (::localtime_s(&localTime, &time))
+                return false;
+        #else
+            if (!::localtime_r(&time, &localTime))
+                return false;
+        #endif
+
+        // calculate the offset between the local and UTC times
+        const long long localSeconds = DaysFromCivil(localTime.tm_year + 1900LL, localTime.tm_mon + 1, localTime.tm_mday) * 86400 +
+                                       localTime.tm_hour * 3600                                                                 +
+                                       localTime.tm_min  * 60                                                                   +
+                                       localTime.tm_sec;
+
+        // the time zones and daylight saving changes always happen on a quarter of hour, so the
+        // offset remains valid for the whole quarter containing the time
+        long long start = (long long)time - (long long)time % 900;
+
+        if ((long long)time % 900 < 0)
+            start -= 900;
+
+        cache.m_Start  = (std::time_t)start;
+        cache.m_End    = (std::time_t)(start + 900);
+        cache.m_Offset = long(localSeconds - (long long)time);
+        cache.m_IsDST  = localTime.tm_isdst;
+    }
+
+    if (!ToUTCTm(time + cache.m_Offset, dateTime))
+        return false;
+
+    dateTime.tm_isdst = cache.m_IsDST;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+const std::locale& TSP_TimeHelper::GetLocale(const std::string& name)
+{
+    ILocaleCache& cache = m_LocaleCache;
+
+    // building a locale from its name is expensive, so keep the last one
+    if (!cache.m_Valid || cache.m_Name != name)
+    {
+        cache.m_Locale = std::locale(name.c_str());
+        cache.m_Name   = name;
+        cache.m_Valid  = true;
+    }
+
+    return cache.m_Locale;
+}
+//---------------------------------------------------------------------------
+bool TSP_TimeHelper::FormatNumeric(const std::tm& dateTime, const std::string& format, std::string& result)
+{
+    // years out of this range are not zero padded the same way by all the std implementations
+    if (dateTime.tm_year + 1900 < 1000 || dateTime.tm_year + 1900 > 9999)
+        return false;
+
+    // write a 2 digits value, fails if the value cannot be written this way
+    const auto write2 = [&result](int value)
+    {
+        if (value < 0 || value > 99)
+            return false;
+
+        result += char('0' + value / 10);
+        result += char('0' + value % 10);
+
+        return true;
+    };
+
+    // write the 4 digits year
+    const auto writeYear = [&result, &dateTime]()
+    {
+        const int year = dateTime.tm_year + 1900;
+
+        result += char('0' +  year / 1000);
+        result += char('0' + (year / 100) % 10);
+        result += char('0' + (year / 10)  % 10);
+        result += char('0' +  year        % 10);
+
+        return true;
+    };
+
+    result.clear();
+    result.reserve(format.length() + 16);
+
+    const std::size_t length = format.length();
+
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        if (format[i] != '%')
+        {
+            result += format[i];
+            continue;
+        }
+
+        // incomplete specifier?
+        if (++i == length)
+            return false;
+
+        bool success;
+
+        switch (format[i])
+        {
+            case 'Y': success = writeYear();                     break;
+            case 'm': success = write2(dateTime.tm_mon + 1);     break;
+            case 'd': success = write2(dateTime.tm_mday);        break;
+            case 'H': success = write2(dateTime.tm_hour);        break;
+            case 'M': success = write2(dateTime.tm_min);         break;
+            case 'S': success = write2(dateTime.tm_sec);         break;
+            case '%': result += '%'; success = true;             break;
+
+            case 'F':
+                success = writeYear()                    &&
+                          (result += '-', true)          &&
+                          write2(dateTime.tm_mon + 1)    &&
+                          (result += '-', true)          &&
+                          write2(dateTime.tm_mday);
+                break;
+
+            case 'T':
+                success = write2(dateTime.tm_hour)       &&
+                          (result += ':', true)          &&
+                          write2(dateTime.tm_min)        &&
+                          (result += ':', true)          &&
+                          write2(dateTime.tm_sec);
+                break;
+
+            // not a numeric specifier
+            default: return false;
+        }
+
+        if (!success)
+            return false;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_TimeHelper::ParseNumeric(const std::string& str, const std::string& format, std::tm& dateTime, bool& success)
+{
+    success = false;
+
+    // check the format first, so nothing is parsed if it contains a not numeric specifier
+    for (std::size_t i = 0; i < format.length(); ++i)
+        if (format[i] == '%')
+            switch (++i < format.length() ? format[i] : '\0')
+            {
+                case 'Y':
+                case 'm':
+                case 'd':
+                case 'H':
+                case 'M':
+                case 'S':
+                case 'F':
+                case 'T':
+                case '%':
+                    continue;
+
+                default:
+                    return false;
+            }
+
+    const char*       pStr = str.c_str();
+    const char* const pEnd = pStr + str.length();
+
+    // read a number containing up to maxDigits digits and check its range
+    const auto readNumber = [&pStr, pEnd](std::size_t maxDigits, int min, int max, int& value)
+    {
+        std::size_t count = 0;
+
+        value = 0;
+
+        while (pStr < pEnd && count < maxDigits && *pStr >= '0' && *pStr <= '9')
+        {
+            value = value * 10 + (*pStr - '0');
+            ++pStr;
+            ++count;
+        }
+
+        return count && value >= min && value <= max;
+    };
+
+    // read an expected char
+    const auto readChar = [&pStr, pEnd](char c)
+    {
+        if (pStr == pEnd || *pStr != c)
+            return false;
+
+        ++pStr;
+
+        return true;
+    };
+
+    int year   = 1900;
+    int month  = 1;
+    int day    = 0;
+    int hour   = 0;
+    int minute = 0;
+    int second = 0;
+
+    const std::size_t length = format.length();
+
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        const char c = format[i];
+
+        // a space in the format matches any space count in the string
+        if (std::isspace((unsigned char)c))
+        {
+            while (pStr < pEnd && std::isspace((unsigned char)*pStr))
+                ++pStr;
+
+            continue;
+        }
+
+        if (c != '%')
+        {
+            if (!readChar(c))
+                return true;
+
+            continue;
+        }
+
+        bool result;
+
+        switch (format[++i])
+        {
+            case 'Y': result = readNumber(4, 0, 9999, year);   break;
+            case 'm': result = readNumber(2, 1, 12,   month);  break;
+            case 'd': result = readNumber(2, 1, 31,   day);    break;
+            case 'H': result = readNumber(2, 0, 23,   hour);   break;
+            case 'M': result = readNumber(2, 0, 59,   minute); break;
+            case 'S': result = readNumber(2, 0, 60,   second); break;
+            case '%': result = readChar('%');                  break;
+
+            case 'F':
+                result = readNumber(4, 0, 9999, year)  &&
+                         readChar('-')                 &&
+                         readNumber(2, 1, 12, month)   &&
+                         readChar('-')                 &&
+                         readNumber(2, 1, 31, day);
+                break;
+
+            case 'T':
+                result = readNumber(2, 0, 23, hour)    &&
+                         readChar(':')                 &&
+                         readNumber(2, 0, 59, minute)  &&
+                         readChar(':')                 &&
+                         readNumber(2, 0, 60, second);
+                break;
+
+            default:
+                return true;
+        }
+
+        if (!result)
+            return true;
+    }
+
+    dateTime.tm_year = year - 1900;
+    dateTime.tm_mon  = month - 1;
+    dateTime.tm_mday = day;
+    dateTime.tm_hour = hour;
+    dateTime.tm_min  = minute;
+    dateTime.tm_sec  = second;
+
+    success = true;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+long long TSP_TimeHelper::DaysFromCivil(long long year, unsigned month, unsigned day)
+{
+    // see http://howardhinnant.github.io/date_algorithms.html
+    year -= month <= 2;
+
+    const long long era = (year >= 0 ? year : year - 399) / 400;
+    const long long yoe = year - era * 400;
+    const long long doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + doe - 719468;
+}
+//---------------------------------------------------------------------------
@@ -31,10 +31,13 @@
 
 // std
 #include <ctime>
+#include <locale>
 #include <string>
 
 /**
 * Helper class for date and time
+*@note The numeric formats (i.e. using only the %Y, %m, %d, %H, %M, %S, %F and %T specifiers) are
+*      formatted and parsed without streams nor locale, all the functions are thread-safe
 *@author Jean-Milost Reymond
 */
 class TSP_TimeHelper
@@ -107,4 +110,108 @@ class TSP_TimeHelper
         *@return date and time structure
         */
         static std::tm StrToTm(const std::string& str, const std::string& format, const std::string& localeToUse = "");
+
+        /**
+        * Formats a date and time structure to a string, without throwing
+        *@param dateTime - date and time structure to format
+        *@param format - format to use for the conversion
+        *@param[out] result - string formatted date and time, unchanged on error
+        *@param localeToUse - locale to use for the conversion, default if empty
+        *@return true on success, otherwise false
+        */
+        static bool FormatTm(const std::tm&      dateTime,
+                             const std::string&  format,
+                                   std::string&  result,
+                             const std::string&  localeToUse = "");
+
+        /**
+        * Parses a date and time structure from a string, without throwing
+        *@param str - string to parse
+        *@param format - format to use for the conversion
+        *@param[out] dateTime - parsed date and time structure, unchanged on error
+        *@param localeToUse - locale to use for the conversion, default if empty
+        *@return true on success, otherwise false
+        */
+        static bool ParseTm(const std::string& str,
+                            const std::string& format,
+                                  std::tm&     dateTime,
+                            const std::string& localeToUse = "");
+
+        /**
+        * Converts a time value to an UTC date and time structure, thread-safe std::gmtime() replacement
+        *@param time - time value to convert
+        *@param[out] dateTime - UTC date and time structure
+        *@return true on success, otherwise false
+        */
+        static bool ToUTCTm(std::time_t time, std::tm& dateTime);
+
+        /**
+        * Converts a time value to a local date and time structure, thread-safe std::localtime() replacement
+        *@param time - time value to convert
+        *@param[out] dateTime - local date and time structure
+        *@return true on success, otherwise false
+        *@note The time zone offset is cached per thread, and only queried again from the system
+        *      when the time leaves the cached quarter of hour
+        */
+        static bool ToLocalTm(std::time_t time, std::tm& dateTime);
+
+    private:
+        /**
+        * Time zone cache
+        */
+        struct IZoneCache
+        {
+            std::time_t m_Start  = 0;
+            std::time_t m_End    = 0;
+            long        m_Offset = 0;
+            int         m_IsDST  = 0;
+        };
+
+        /**
+        * Locale cache
+        */
+        struct ILocaleCache
+        {
+            std::string m_Name;
+            std::locale m_Locale;
+            bool        m_Valid = false;
+        };
+
+        static thread_local IZoneCache   m_ZoneCache;
+        static thread_local ILocaleCache m_LocaleCache;
+
+        /**
+        * Gets a locale from its name, the last used locale is cached per thread
+        *@param name - locale name, default if empty
+        *@return locale
+        */
+        static const std::locale& GetLocale(const std::string& name);
+
+        /**
+        * Formats a date and time structure using a numeric only format
+        *@param dateTime - date and time structure to format
+        *@param format - format to use
+        *@param[out] result - formatted date and time
+        *@return true on success, false if the format or the date and time cannot be formatted this way
+        */
+        static bool FormatNumeric(const std::tm& dateTime, const std::string& format, std::string& result);
+
+        /**
+        * Parses a date and time structure using a numeric only format
+        *@param str - string to parse
+        *@param format - format to use
+        *@param[out] dateTime - parsed date and time structure
+        *@param[out] success - if true, the string was parsed successfully
+        *@return true if the format could be used, false if it contains not numeric specifiers
+        */
+        static bool ParseNumeric(const std::string& str, const std::string& format, std::tm& dateTime, bool& success);
+
+        /**
+        * Counts the days since the 1970-01-01 epoch
+        *@param year - year
+        *@param month - month, between 1 and 12
+        *@param day - day, between 1 and 31
+        *@return day count, negative before the epoch
+        */
+        static long long DaysFromCivil(long long year, unsigned month, unsigned day);
 };
@@ -34,14 +34,18 @@
 //---------------------------------------------------------------------------
 TSP_Activity::TSP_Activity(TSP_Page* pOwner) :
     TSP_Box(pOwner)
-{}
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Activity::TSP_Activity(const std::wstring& title,
                            const std::wstring& description,
                            const std::wstring& comments,
                                  TSP_Page*     pOwner) :
     TSP_Box(title, description, comments, pOwner)
-{}
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Activity::~TSP_Activity()
 {}
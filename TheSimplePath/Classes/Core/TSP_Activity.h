@@ -43,6 +43,8 @@
 class TSP_Activity : public TSP_Box
 {
     public:
+        static const IEType m_ClassType = IEType::IE_T_Activity;
+
         /**
         * Constructor
         *@param pOwner - the page owner
@@ -42,51 +42,64 @@ TSP_Atlas::TSP_Atlas(TSP_Document* pOwner) :
     TSP_Item(),
     TSP_PageContainer(),
     m_pOwner(pOwner)
-{}
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Atlas::TSP_Atlas(const std::wstring& name, TSP_Document* pOwner) :
     TSP_Item(),
     TSP_PageContainer(),
     m_Name(name),
     m_pOwner(pOwner)
-{}
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Atlas::~TSP_Atlas()
 {}
 //---------------------------------------------------------------------------
 TSP_Page* TSP_Atlas::CreatePage()
 {
-    return new TSP_Page(this);
+    return new (m_pPageArena) TSP_Page(this);
 }
 //---------------------------------------------------------------------------
 TSP_Page* TSP_Atlas::CreatePage(const std::wstring& name)
 {
-    return new TSP_Page(name, this);
+    return new (m_pPageArena) TSP_Page(name, this);
 }
 //---------------------------------------------------------------------------
-bool TSP_Atlas::Load()
+void TSP_Atlas::SetModified()
 {
-    //m_NbrGen;
-    //m_Name
+    // already marked, so its document also is
+    if (IsModified())
+        return;
 
-    /*
-    for each (auto pModel in m_Models)
-        pModel->Load();
-    */
+    TSP_Item::SetModified();
 
-    return true;
+    if (m_pOwner)
+        m_pOwner->SetModified();
 }
 //---------------------------------------------------------------------------
-bool TSP_Atlas::Save() const
+void TSP_Atlas::ClearModified()
 {
-    //m_NbrGen;
-    //m_Name
+    TSP_Item::ClearModified();
+    ClearModifiedPages();
+}
+//---------------------------------------------------------------------------
+bool TSP_Atlas::Save(TSP_JsonHelper::IBufferWriterW& writer) const
+{
+    if (!writer.StartObject())
+        return false;
+
+    if (!writer.Key(L"uid") || !writer.Uint64(GetUID()))
+        return false;
+
+    if (!TSP_JsonHelper::WriteMember(writer, L"name", m_Name))
+        return false;
 
-    /*
-    for each (auto pModel in m_Models)
-        pModel->Save();
-    */
+    if (!writer.Key(L"pages") || !SavePages(writer))
+        return false;
 
-    return true;
+    return writer.EndObject();
 }
 //---------------------------------------------------------------------------
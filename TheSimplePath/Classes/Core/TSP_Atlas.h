@@ -48,6 +48,8 @@ class TSP_Atlas : public TSP_Item,
                   public TSP_PageContainer
 {
     public:
+        static const IEType m_ClassType = IEType::IE_T_Atlas;
+
         /**
         * Constructor
         *@param pOwner - the atlas owner
@@ -63,6 +65,12 @@ class TSP_Atlas : public TSP_Item,
 
         virtual ~TSP_Atlas();
 
+        /**
+        * Gets the atlas owner
+        *@return the atlas owner
+        */
+        virtual inline TSP_Document* GetOwner() const;
+
         /**
         * Gets the atlas name
         *@return the atlas name
@@ -89,16 +97,21 @@ class TSP_Atlas : public TSP_Item,
         virtual TSP_Page* CreatePage(const std::wstring& name);
 
         /**
-        * Loads a model from a file
-        *@return true on success, otherwise false
+        * Marks the atlas, and its document, as modified
         */
-        virtual bool Load();
+        virtual void SetModified();
 
         /**
-        * Saves a model to a file
+        * Marks the atlas and its pages as unmodified
+        */
+        virtual void ClearModified();
+
+        /**
+        * Saves the atlas
+        *@param writer - json writer to save to
         *@return true on success, otherwise false
         */
-        virtual bool Save() const;
+        virtual bool Save(TSP_JsonHelper::IBufferWriterW& writer) const;
 
     protected:
         TSP_Document* m_pOwner = nullptr;
@@ -110,6 +123,11 @@ class TSP_Atlas : public TSP_Item,
 //---------------------------------------------------------------------------
 // TSP_Atlas
 //---------------------------------------------------------------------------
+TSP_Document* TSP_Atlas::GetOwner() const
+{
+    return m_pOwner;
+}
+//---------------------------------------------------------------------------
 std::wstring TSP_Atlas::GetName() const
 {
     return m_Name;
@@ -118,5 +136,6 @@ std::wstring TSP_Atlas::GetName() const
 void TSP_Atlas::SetName(const std::wstring& name)
 {
     m_Name = name;
+    SetModified();
 }
 //---------------------------------------------------------------------------
@@ -30,65 +30,62 @@
 #include "TSP_Attribute.h"
 
 // std
-#include <iomanip>
-#include <sstream>
+#include <cstring>
 
 // common classes
+#include "Common\TSP_NumberHelper.h"
 #include "Common\TSP_StringHelper.h"
 #include "Common\TSP_TimeHelper.h"
 
 //---------------------------------------------------------------------------
-// Global macros
-//---------------------------------------------------------------------------
-#define M_Safe_Conversion(conversion)\
-try\
-{\
-    return conversion;\
-}\
-catch (...)\
-{\
-    M_LogException(TSP_ExceptionFormatter::m_GenericTypeName, "Conversion failed");\
-    return defVal;\
-}\
-//---------------------------------------------------------------------------
-#define M_Safe_Conversion_Ptr(conversion)\
-try\
-{\
-    return conversion;\
-}\
-catch (...)\
-{\
-    M_LogException(TSP_ExceptionFormatter::m_GenericTypeName, "Conversion failed");\
-    return pDefVal;\
-}\
+// Static members
+//---------------------------------------------------------------------------
+std::string TSP_Attribute::m_TimeFormat = "%F %T";
+std::mutex  TSP_Attribute::m_TimeFormatMutex;
 //---------------------------------------------------------------------------
 // TSP_Attribute
 //---------------------------------------------------------------------------
 TSP_Attribute::TSP_Attribute()
 {}
 //---------------------------------------------------------------------------
+TSP_Attribute::TSP_Attribute(const TSP_Attribute& other)
+{
+    Copy(other);
+}
+//---------------------------------------------------------------------------
+TSP_Attribute::TSP_Attribute(TSP_Attribute&& other)
+{
+    Move(other);
+}
+//---------------------------------------------------------------------------
 TSP_Attribute::~TSP_Attribute()
 {
-    if (m_pData)
-        delete m_pData;
+    Clear();
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Clear()
 {
-    if (m_pData)
-        delete m_pData;
+    // only the string formats own a resource, the others are trivially destructible
+    switch (m_Format)
+    {
+        case IEFormat::IE_String:        m_Value.m_String.~basic_string();        break;
+        case IEFormat::IE_UnicodeString:
+        case IEFormat::IE_Formula:       m_Value.m_UnicodeString.~basic_string(); break;
+        default:                                                                  break;
+    }
 
-    m_pData  = nullptr;
     m_Format = IEFormat::IE_Undefined;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::SetTimeFormat(const std::string& timeFormat)
 {
+    std::lock_guard<std::mutex> lock(m_TimeFormatMutex);
     m_TimeFormat = timeFormat;
 }
 //---------------------------------------------------------------------------
 std::string TSP_Attribute::GetTimeFormat() const
 {
+    std::lock_guard<std::mutex> lock(m_TimeFormatMutex);
     return m_TimeFormat;
 }
 //---------------------------------------------------------------------------
@@ -96,119 +93,173 @@ void TSP_Attribute::Set(bool value)
 {
     Clear();
 
-    m_pData  = new bool(value);
-    m_Format = IEFormat::IE_Bool;
+    m_Value.m_Bool = value;
+    m_Format       = IEFormat::IE_Bool;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(std::int8_t value)
 {
     Clear();
 
-    m_pData  = new std::int8_t(value);
-    m_Format = IEFormat::IE_Int8;
+    m_Value.m_Int8 = value;
+    m_Format       = IEFormat::IE_Int8;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(std::uint8_t value)
 {
     Clear();
 
-    m_pData  = new std::uint8_t(value);
-    m_Format = IEFormat::IE_UInt8;
+    m_Value.m_UInt8 = value;
+    m_Format        = IEFormat::IE_UInt8;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(std::int16_t value)
 {
     Clear();
 
-    m_pData  = new std::int16_t(value);
-    m_Format = IEFormat::IE_Int16;
+    m_Value.m_Int16 = value;
+    m_Format        = IEFormat::IE_Int16;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(std::uint16_t value)
 {
     Clear();
 
-    m_pData = new std::uint16_t(value);
-    m_Format = IEFormat::IE_UInt16;
+    m_Value.m_UInt16 = value;
+    m_Format         = IEFormat::IE_UInt16;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(std::int32_t value)
 {
     Clear();
 
-    m_pData  = new std::int32_t(value);
-    m_Format = IEFormat::IE_Int32;
+    m_Value.m_Int32 = value;
+    m_Format        = IEFormat::IE_Int32;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(std::uint32_t value)
 {
     Clear();
 
-    m_pData  = new std::uint32_t(value);
-    m_Format = IEFormat::IE_UInt32;
+    m_Value.m_UInt32 = value;
+    m_Format         = IEFormat::IE_UInt32;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(std::int64_t value)
 {
     Clear();
 
-    m_pData  = new std::int64_t(value);
-    m_Format = IEFormat::IE_Int64;
+    m_Value.m_Int64 = value;
+    m_Format        = IEFormat::IE_Int64;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(std::uint64_t value)
 {
     Clear();
 
-    m_pData  = new std::uint64_t(value);
-    m_Format = IEFormat::IE_UInt64;
+    m_Value.m_UInt64 = value;
+    m_Format         = IEFormat::IE_UInt64;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(float value)
 {
     Clear();
 
-    m_pData  = new float(value);
-    m_Format = IEFormat::IE_Float;
+    m_Value.m_Float = value;
+    m_Format        = IEFormat::IE_Float;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(double value)
 {
     Clear();
 
-    m_pData  = new double(value);
-    m_Format = IEFormat::IE_Double;
+    m_Value.m_Double = value;
+    m_Format         = IEFormat::IE_Double;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(const std::string& value)
 {
+    // already a string? Reuse its buffer
+    if (m_Format == IEFormat::IE_String)
+    {
+        m_Value.m_String = value;
+        return;
+    }
+
+    Clear();
+
+    new (&m_Value.m_String) std::string(value);
+    m_Format = IEFormat::IE_String;
+}
+//---------------------------------------------------------------------------
+void TSP_Attribute::Set(std::string&& value)
+{
+    if (m_Format == IEFormat::IE_String)
+    {
+        m_Value.m_String = std::move(value);
+        return;
+    }
+
     Clear();
 
-    m_pData  = new std::string(value);
+    new (&m_Value.m_String) std::string(std::move(value));
     m_Format = IEFormat::IE_String;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(const std::wstring& value)
 {
+    // already an unicode string? Reuse its buffer
+    if (m_Format == IEFormat::IE_UnicodeString)
+    {
+        m_Value.m_UnicodeString = value;
+        return;
+    }
+
     Clear();
 
-    m_pData  = new std::wstring(value);
+    new (&m_Value.m_UnicodeString) std::wstring(value);
+    m_Format = IEFormat::IE_UnicodeString;
+}
+//---------------------------------------------------------------------------
+void TSP_Attribute::Set(std::wstring&& value)
+{
+    if (m_Format == IEFormat::IE_UnicodeString)
+    {
+        m_Value.m_UnicodeString = std::move(value);
+        return;
+    }
+
+    Clear();
+
+    new (&m_Value.m_UnicodeString) std::wstring(std::move(value));
     m_Format = IEFormat::IE_UnicodeString;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(const char* pDefVal)
 {
+    if (m_Format == IEFormat::IE_String)
+    {
+        m_Value.m_String = pDefVal;
+        return;
+    }
+
     Clear();
 
-    m_pData  = new std::string(pDefVal);
+    new (&m_Value.m_String) std::string(pDefVal);
     m_Format = IEFormat::IE_String;
 }
 //---------------------------------------------------------------------------
 void TSP_Attribute::Set(const wchar_t* pDefVal)
 {
+    if (m_Format == IEFormat::IE_UnicodeString)
+    {
+        m_Value.m_UnicodeString = pDefVal;
+        return;
+    }
+
     Clear();
 
-    m_pData  = new std::wstring(pDefVal);
+    new (&m_Value.m_UnicodeString) std::wstring(pDefVal);
     m_Format = IEFormat::IE_UnicodeString;
 }
 //---------------------------------------------------------------------------
@@ -216,333 +267,405 @@ void TSP_Attribute::Set(const std::tm& value)
 {
     Clear();
 
-    m_pData  = new std::tm(value);
-    m_Format = IEFormat::IE_DateTime;
+    m_Value.m_DateTime = value;
+    m_Format           = IEFormat::IE_DateTime;
+}
+//---------------------------------------------------------------------------
+void TSP_Attribute::SetFormula(const std::wstring& formula)
+{
+    if (m_Format == IEFormat::IE_Formula)
+    {
+        m_Value.m_UnicodeString = formula;
+        return;
+    }
+
+    Clear();
+
+    new (&m_Value.m_UnicodeString) std::wstring(formula);
+    m_Format = IEFormat::IE_Formula;
+}
+//---------------------------------------------------------------------------
+void TSP_Attribute::SetFormula(std::wstring&& formula)
+{
+    if (m_Format == IEFormat::IE_Formula)
+    {
+        m_Value.m_UnicodeString = std::move(formula);
+        return;
+    }
+
+    Clear();
+
+    new (&m_Value.m_UnicodeString) std::wstring(std::move(formula));
+    m_Format = IEFormat::IE_Formula;
 }
 //---------------------------------------------------------------------------
 bool TSP_Attribute::Get(bool defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return *static_cast<bool*>         (m_pData);
-        case IEFormat::IE_Int8:          return *static_cast<std::int8_t*>  (m_pData) ? true : false;
-        case IEFormat::IE_UInt8:         return *static_cast<std::uint8_t*> (m_pData) ? true : false;
-        case IEFormat::IE_Int16:         return *static_cast<std::int16_t*> (m_pData) ? true : false;
-        case IEFormat::IE_UInt16:        return *static_cast<std::uint16_t*>(m_pData) ? true : false;
-        case IEFormat::IE_Int32:         return *static_cast<std::int32_t*> (m_pData) ? true : false;
-        case IEFormat::IE_UInt32:        return *static_cast<std::uint32_t*>(m_pData) ? true : false;
-        case IEFormat::IE_Int64:         return *static_cast<std::int64_t*> (m_pData) ? true : false;
-        case IEFormat::IE_UInt64:        return *static_cast<std::uint64_t*>(m_pData) ? true : false;
-        case IEFormat::IE_Float:         return *static_cast<float*>        (m_pData) ? true : false;
-        case IEFormat::IE_Double:        return *static_cast<double*>       (m_pData) ? true : false;
-        case IEFormat::IE_String:        return TSP_StringHelper::StrToBool(*static_cast<std::string*> (m_pData));
-        case IEFormat::IE_UnicodeString: return TSP_StringHelper::StrToBool(*static_cast<std::wstring*>(m_pData));
+        case IEFormat::IE_Bool:          return m_Value.m_Bool;
+        case IEFormat::IE_Int8:          return m_Value.m_Int8 ? true : false;
+        case IEFormat::IE_UInt8:         return m_Value.m_UInt8 ? true : false;
+        case IEFormat::IE_Int16:         return m_Value.m_Int16 ? true : false;
+        case IEFormat::IE_UInt16:        return m_Value.m_UInt16 ? true : false;
+        case IEFormat::IE_Int32:         return m_Value.m_Int32 ? true : false;
+        case IEFormat::IE_UInt32:        return m_Value.m_UInt32 ? true : false;
+        case IEFormat::IE_Int64:         return m_Value.m_Int64 ? true : false;
+        case IEFormat::IE_UInt64:        return m_Value.m_UInt64 ? true : false;
+        case IEFormat::IE_Float:         return m_Value.m_Float ? true : false;
+        case IEFormat::IE_Double:        return m_Value.m_Double ? true : false;
+        case IEFormat::IE_String:        return TSP_StringHelper::StrToBool(m_Value.m_String);
+        case IEFormat::IE_UnicodeString: return TSP_StringHelper::StrToBool(m_Value.m_UnicodeString);
         default:                         return defVal;
     }
 }
 //---------------------------------------------------------------------------
 std::int8_t TSP_Attribute::Get(std::int8_t defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return (std::int8_t)*static_cast<bool*>         (m_pData);
-        case IEFormat::IE_Int8:          return              *static_cast<std::int8_t*>  (m_pData);
-        case IEFormat::IE_UInt8:         return (std::int8_t)*static_cast<std::uint8_t*> (m_pData);
-        case IEFormat::IE_Int16:         return (std::int8_t)*static_cast<std::int16_t*> (m_pData);
-        case IEFormat::IE_UInt16:        return (std::int8_t)*static_cast<std::uint16_t*>(m_pData);
-        case IEFormat::IE_Int32:         return (std::int8_t)*static_cast<std::int32_t*> (m_pData);
-        case IEFormat::IE_UInt32:        return (std::int8_t)*static_cast<std::uint32_t*>(m_pData);
-        case IEFormat::IE_Int64:         return (std::int8_t)*static_cast<std::int64_t*> (m_pData);
-        case IEFormat::IE_UInt64:        return (std::int8_t)*static_cast<std::uint64_t*>(m_pData);
-        case IEFormat::IE_Float:         return (std::int8_t)*static_cast<float*>        (m_pData);
-        case IEFormat::IE_Double:        return (std::int8_t)*static_cast<double*>       (m_pData);
-        case IEFormat::IE_String:        M_Safe_Conversion((std::int8_t)std::stoi(*static_cast<std::string*> (m_pData)))
-        case IEFormat::IE_UnicodeString: M_Safe_Conversion((std::int8_t)std::stoi(*static_cast<std::wstring*>(m_pData)))
+        case IEFormat::IE_Bool:          return (std::int8_t)m_Value.m_Bool;
+        case IEFormat::IE_Int8:          return              m_Value.m_Int8;
+        case IEFormat::IE_UInt8:         return (std::int8_t)m_Value.m_UInt8;
+        case IEFormat::IE_Int16:         return (std::int8_t)m_Value.m_Int16;
+        case IEFormat::IE_UInt16:        return (std::int8_t)m_Value.m_UInt16;
+        case IEFormat::IE_Int32:         return (std::int8_t)m_Value.m_Int32;
+        case IEFormat::IE_UInt32:        return (std::int8_t)m_Value.m_UInt32;
+        case IEFormat::IE_Int64:         return (std::int8_t)m_Value.m_Int64;
+        case IEFormat::IE_UInt64:        return (std::int8_t)m_Value.m_UInt64;
+        case IEFormat::IE_Float:         return (std::int8_t)m_Value.m_Float;
+        case IEFormat::IE_Double:        return (std::int8_t)m_Value.m_Double;
+        case IEFormat::IE_String:        return TSP_NumberHelper::StrToNum(m_Value.m_String, defVal);
+        case IEFormat::IE_UnicodeString: return TSP_NumberHelper::StrToNum(m_Value.m_UnicodeString, defVal);
         default:                         return defVal;
     }
 }
 //---------------------------------------------------------------------------
 std::uint8_t TSP_Attribute::Get(std::uint8_t defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return (std::uint8_t)*static_cast<bool*>         (m_pData);
-        case IEFormat::IE_Int8:          return (std::uint8_t)*static_cast<std::int8_t*>  (m_pData);
-        case IEFormat::IE_UInt8:         return               *static_cast<std::uint8_t*> (m_pData);
-        case IEFormat::IE_Int16:         return (std::uint8_t)*static_cast<std::int16_t*> (m_pData);
-        case IEFormat::IE_UInt16:        return (std::uint8_t)*static_cast<std::uint16_t*>(m_pData);
-        case IEFormat::IE_Int32:         return (std::uint8_t)*static_cast<std::int32_t*> (m_pData);
-        case IEFormat::IE_UInt32:        return (std::uint8_t)*static_cast<std::uint32_t*>(m_pData);
-        case IEFormat::IE_Int64:         return (std::uint8_t)*static_cast<std::int64_t*> (m_pData);
-        case IEFormat::IE_UInt64:        return (std::uint8_t)*static_cast<std::uint64_t*>(m_pData);
-        case IEFormat::IE_Float:         return (std::uint8_t)*static_cast<float*>        (m_pData);
-        case IEFormat::IE_Double:        return (std::uint8_t)*static_cast<double*>       (m_pData);
-        case IEFormat::IE_String:        M_Safe_Conversion((std::uint8_t)std::stoul(*static_cast<std::string*> (m_pData)))
-        case IEFormat::IE_UnicodeString: M_Safe_Conversion((std::uint8_t)std::stoul(*static_cast<std::wstring*>(m_pData)))
+        case IEFormat::IE_Bool:          return (std::uint8_t)m_Value.m_Bool;
+        case IEFormat::IE_Int8:          return (std::uint8_t)m_Value.m_Int8;
+        case IEFormat::IE_UInt8:         return               m_Value.m_UInt8;
+        case IEFormat::IE_Int16:         return (std::uint8_t)m_Value.m_Int16;
+        case IEFormat::IE_UInt16:        return (std::uint8_t)m_Value.m_UInt16;
+        case IEFormat::IE_Int32:         return (std::uint8_t)m_Value.m_Int32;
+        case IEFormat::IE_UInt32:        return (std::uint8_t)m_Value.m_UInt32;
+        case IEFormat::IE_Int64:         return (std::uint8_t)m_Value.m_Int64;
+        case IEFormat::IE_UInt64:        return (std::uint8_t)m_Value.m_UInt64;
+        case IEFormat::IE_Float:         return (std::uint8_t)m_Value.m_Float;
+        case IEFormat::IE_Double:        return (std::uint8_t)m_Value.m_Double;
+        case IEFormat::IE_String:        return TSP_NumberHelper::StrToNum(m_Value.m_String, defVal);
+        case IEFormat::IE_UnicodeString: return TSP_NumberHelper::StrToNum(m_Value.m_UnicodeString, defVal);
         default:                         return defVal;
     }
 }
 //---------------------------------------------------------------------------
 std::int16_t TSP_Attribute::Get(std::int16_t defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return (std::int16_t)*static_cast<bool*>         (m_pData);
-        case IEFormat::IE_Int8:          return (std::int16_t)*static_cast<std::int8_t*>  (m_pData);
-        case IEFormat::IE_UInt8:         return (std::int16_t)*static_cast<std::uint8_t*> (m_pData);
-        case IEFormat::IE_Int16:         return               *static_cast<std::int16_t*> (m_pData);
-        case IEFormat::IE_UInt16:        return (std::int16_t)*static_cast<std::uint16_t*>(m_pData);
-        case IEFormat::IE_Int32:         return (std::int16_t)*static_cast<std::int32_t*> (m_pData);
-        case IEFormat::IE_UInt32:        return (std::int16_t)*static_cast<std::uint32_t*>(m_pData);
-        case IEFormat::IE_Int64:         return (std::int16_t)*static_cast<std::int64_t*> (m_pData);
-        case IEFormat::IE_UInt64:        return (std::int16_t)*static_cast<std::uint64_t*>(m_pData);
-        case IEFormat::IE_Float:         return (std::int16_t)*static_cast<float*>        (m_pData);
-        case IEFormat::IE_Double:        return (std::int16_t)*static_cast<double*>       (m_pData);
-        case IEFormat::IE_String:        M_Safe_Conversion((std::int16_t)std::stoi(*static_cast<std::string*> (m_pData)))
-        case IEFormat::IE_UnicodeString: M_Safe_Conversion((std::int16_t)std::stoi(*static_cast<std::wstring*>(m_pData)))
+        case IEFormat::IE_Bool:          return (std::int16_t)m_Value.m_Bool;
+        case IEFormat::IE_Int8:          return (std::int16_t)m_Value.m_Int8;
+        case IEFormat::IE_UInt8:         return (std::int16_t)m_Value.m_UInt8;
+        case IEFormat::IE_Int16:         return               m_Value.m_Int16;
+        case IEFormat::IE_UInt16:        return (std::int16_t)m_Value.m_UInt16;
+        case IEFormat::IE_Int32:         return (std::int16_t)m_Value.m_Int32;
+        case IEFormat::IE_UInt32:        return (std::int16_t)m_Value.m_UInt32;
+        case IEFormat::IE_Int64:         return (std::int16_t)m_Value.m_Int64;
+        case IEFormat::IE_UInt64:        return (std::int16_t)m_Value.m_UInt64;
+        case IEFormat::IE_Float:         return (std::int16_t)m_Value.m_Float;
+        case IEFormat::IE_Double:        return (std::int16_t)m_Value.m_Double;
+        case IEFormat::IE_String:        return TSP_NumberHelper::StrToNum(m_Value.m_String, defVal);
+        case IEFormat::IE_UnicodeString: return TSP_NumberHelper::StrToNum(m_Value.m_UnicodeString, defVal);
         default:                         return defVal;
     }
 }
 //---------------------------------------------------------------------------
 std::uint16_t TSP_Attribute::Get(std::uint16_t defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return (std::uint16_t)*static_cast<bool*>         (m_pData);
-        case IEFormat::IE_Int8:          return (std::uint16_t)*static_cast<std::int8_t*>  (m_pData);
-        case IEFormat::IE_UInt8:         return (std::uint16_t)*static_cast<std::uint8_t*> (m_pData);
-        case IEFormat::IE_Int16:         return (std::uint16_t)*static_cast<std::int16_t*> (m_pData);
-        case IEFormat::IE_UInt16:        return                *static_cast<std::uint16_t*>(m_pData);
-        case IEFormat::IE_Int32:         return (std::uint16_t)*static_cast<std::int32_t*> (m_pData);
-        case IEFormat::IE_UInt32:        return (std::uint16_t)*static_cast<std::uint32_t*>(m_pData);
-        case IEFormat::IE_Int64:         return (std::uint16_t)*static_cast<std::int64_t*> (m_pData);
-        case IEFormat::IE_UInt64:        return (std::uint16_t)*static_cast<std::uint64_t*>(m_pData);
-        case IEFormat::IE_Float:         return (std::uint16_t)*static_cast<float*>        (m_pData);
-        case IEFormat::IE_Double:        return (std::uint16_t)*static_cast<double*>       (m_pData);
-        case IEFormat::IE_String:        M_Safe_Conversion((std::uint16_t)std::stoul(*static_cast<std::string*> (m_pData)))
-        case IEFormat::IE_UnicodeString: M_Safe_Conversion((std::uint16_t)std::stoul(*static_cast<std::wstring*>(m_pData)))
+        case IEFormat::IE_Bool:          return (std::uint16_t)m_Value.m_Bool;
+        case IEFormat::IE_Int8:          return (std::uint16_t)m_Value.m_Int8;
+        case IEFormat::IE_UInt8:         return (std::uint16_t)m_Value.m_UInt8;
+        case IEFormat::IE_Int16:         return (std::uint16_t)m_Value.m_Int16;
+        case IEFormat::IE_UInt16:        return                m_Value.m_UInt16;
+        case IEFormat::IE_Int32:         return (std::uint16_t)m_Value.m_Int32;
+        case IEFormat::IE_UInt32:        return (std::uint16_t)m_Value.m_UInt32;
+        case IEFormat::IE_Int64:         return (std::uint16_t)m_Value.m_Int64;
+        case IEFormat::IE_UInt64:        return (std::uint16_t)m_Value.m_UInt64;
+        case IEFormat::IE_Float:         return (std::uint16_t)m_Value.m_Float;
+        case IEFormat::IE_Double:        return (std::uint16_t)m_Value.m_Double;
+        case IEFormat::IE_String:        return TSP_NumberHelper::StrToNum(m_Value.m_String, defVal);
+        case IEFormat::IE_UnicodeString: return TSP_NumberHelper::StrToNum(m_Value.m_UnicodeString, defVal);
         default:                         return defVal;
     }
 }
 //---------------------------------------------------------------------------
 std::int32_t TSP_Attribute::Get(std::int32_t defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return (std::int32_t)*static_cast<bool*>         (m_pData);
-        case IEFormat::IE_Int8:          return (std::int32_t)*static_cast<std::int8_t*>  (m_pData);
-        case IEFormat::IE_UInt8:         return (std::int32_t)*static_cast<std::uint8_t*> (m_pData);
-        case IEFormat::IE_Int16:         return (std::int32_t)*static_cast<std::int16_t*> (m_pData);
-        case IEFormat::IE_UInt16:        return (std::int32_t)*static_cast<std::uint16_t*>(m_pData);
-        case IEFormat::IE_Int32:         return               *static_cast<std::int32_t*> (m_pData);
-        case IEFormat::IE_UInt32:        return (std::int32_t)*static_cast<std::uint32_t*>(m_pData);
-        case IEFormat::IE_Int64:         return (std::int32_t)*static_cast<std::int64_t*> (m_pData);
-        case IEFormat::IE_UInt64:        return (std::int32_t)*static_cast<std::uint64_t*>(m_pData);
-        case IEFormat::IE_Float:         return (std::int32_t)*static_cast<float*>        (m_pData);
-        case IEFormat::IE_Double:        return (std::int32_t)*static_cast<double*>       (m_pData);
-        case IEFormat::IE_String:        M_Safe_Conversion(std::stoi(*static_cast<std::string*>(m_pData)))
-        case IEFormat::IE_UnicodeString: M_Safe_Conversion(std::stoi(*static_cast<std::wstring*>(m_pData)))
-        case IEFormat::IE_DateTime:      M_Safe_Conversion((std::int32_t)std::mktime(static_cast<std::tm*>(m_pData)))
+        case IEFormat::IE_Bool:          return (std::int32_t)m_Value.m_Bool;
+        case IEFormat::IE_Int8:          return (std::int32_t)m_Value.m_Int8;
+        case IEFormat::IE_UInt8:         return (std::int32_t)m_Value.m_UInt8;
+        case IEFormat::IE_Int16:         return (std::int32_t)m_Value.m_Int16;
+        case IEFormat::IE_UInt16:        return (std::int32_t)m_Value.m_UInt16;
+        case IEFormat::IE_Int32:         return               m_Value.m_Int32;
+        case IEFormat::IE_UInt32:        return (std::int32_t)m_Value.m_UInt32;
+        case IEFormat::IE_Int64:         return (std::int32_t)m_Value.m_Int64;
+        case IEFormat::IE_UInt64:        return (std::int32_t)m_Value.m_UInt64;
+        case IEFormat::IE_Float:         return (std::int32_t)m_Value.m_Float;
+        case IEFormat::IE_Double:        return (std::int32_t)m_Value.m_Double;
+        case IEFormat::IE_String:        return TSP_NumberHelper::StrToNum(m_Value.m_String, defVal);
+        case IEFormat::IE_UnicodeString: return TSP_NumberHelper::StrToNum(m_Value.m_UnicodeString, defVal);
+        case IEFormat::IE_DateTime:      return (std::int32_t)GetTime();
         default:                         return defVal;
     }
 }
 //---------------------------------------------------------------------------
 std::uint32_t TSP_Attribute::Get(std::uint32_t defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return (std::uint32_t)*static_cast<bool*>         (m_pData);
-        case IEFormat::IE_Int8:          return (std::uint32_t)*static_cast<std::int8_t*>  (m_pData);
-        case IEFormat::IE_UInt8:         return (std::uint32_t)*static_cast<std::uint8_t*> (m_pData);
-        case IEFormat::IE_Int16:         return (std::uint32_t)*static_cast<std::int16_t*> (m_pData);
-        case IEFormat::IE_UInt16:        return (std::uint32_t)*static_cast<std::uint16_t*>(m_pData);
-        case IEFormat::IE_Int32:         return (std::uint32_t)*static_cast<std::int32_t*> (m_pData);
-        case IEFormat::IE_UInt32:        return                *static_cast<std::uint32_t*>(m_pData);
-        case IEFormat::IE_Int64:         return (std::uint32_t)*static_cast<std::int64_t*> (m_pData);
-        case IEFormat::IE_UInt64:        return (std::uint32_t)*static_cast<std::uint64_t*>(m_pData);
-        case IEFormat::IE_Float:         return (std::uint32_t)*static_cast<float*>        (m_pData);
-        case IEFormat::IE_Double:        return (std::uint32_t)*static_cast<double*>       (m_pData);
-        case IEFormat::IE_String:        M_Safe_Conversion(std::stoul(*static_cast<std::string*>(m_pData)))
-        case IEFormat::IE_UnicodeString: M_Safe_Conversion(std::stoul(*static_cast<std::wstring*>(m_pData)))
-        case IEFormat::IE_DateTime:      M_Safe_Conversion((std::uint32_t)std::mktime(static_cast<std::tm*>(m_pData)))
+        case IEFormat::IE_Bool:          return (std::uint32_t)m_Value.m_Bool;
+        case IEFormat::IE_Int8:          return (std::uint32_t)m_Value.m_Int8;
+        case IEFormat::IE_UInt8:         return (std::uint32_t)m_Value.m_UInt8;
+        case IEFormat::IE_Int16:         return (std::uint32_t)m_Value.m_Int16;
+        case IEFormat::IE_UInt16:        return (std::uint32_t)m_Value.m_UInt16;
+        case IEFormat::IE_Int32:         return (std::uint32_t)m_Value.m_Int32;
+        case IEFormat::IE_UInt32:        return                m_Value.m_UInt32;
+        case IEFormat::IE_Int64:         return (std::uint32_t)m_Value.m_Int64;
+        case IEFormat::IE_UInt64:        return (std::uint32_t)m_Value.m_UInt64;
+        case IEFormat::IE_Float:         return (std::uint32_t)m_Value.m_Float;
+        case IEFormat::IE_Double:        return (std::uint32_t)m_Value.m_Double;
+        case IEFormat::IE_String:        return TSP_NumberHelper::StrToNum(m_Value.m_String, defVal);
+        case IEFormat::IE_UnicodeString: return TSP_NumberHelper::StrToNum(m_Value.m_UnicodeString, defVal);
+        case IEFormat::IE_DateTime:      return (std::uint32_t)GetTime();
         default:                         return defVal;
     }
 }
 //---------------------------------------------------------------------------
 std::int64_t TSP_Attribute::Get(std::int64_t defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return (std::int64_t)*static_cast<bool*>         (m_pData);
-        case IEFormat::IE_Int8:          return (std::int64_t)*static_cast<std::int8_t*>  (m_pData);
-        case IEFormat::IE_UInt8:         return (std::int64_t)*static_cast<std::uint8_t*> (m_pData);
-        case IEFormat::IE_Int16:         return (std::int64_t)*static_cast<std::int16_t*> (m_pData);
-        case IEFormat::IE_UInt16:        return (std::int64_t)*static_cast<std::uint16_t*>(m_pData);
-        case IEFormat::IE_Int32:         return (std::int64_t)*static_cast<std::int32_t*> (m_pData);
-        case IEFormat::IE_UInt32:        return (std::int64_t)*static_cast<std::uint32_t*>(m_pData);
-        case IEFormat::IE_Int64:         return               *static_cast<std::int64_t*> (m_pData);
-        case IEFormat::IE_UInt64:        return (std::int64_t)*static_cast<std::uint64_t*>(m_pData);
-        case IEFormat::IE_Float:         return (std::int64_t)*static_cast<float*>        (m_pData);
-        case IEFormat::IE_Double:        return (std::int64_t)*static_cast<double*>       (m_pData);
-        case IEFormat::IE_String:        M_Safe_Conversion(std::stoll(*static_cast<std::string*>(m_pData)))
-        case IEFormat::IE_UnicodeString: M_Safe_Conversion(std::stoll(*static_cast<std::wstring*>(m_pData)))
-        case IEFormat::IE_DateTime:      M_Safe_Conversion((std::int64_t)std::mktime(static_cast<std::tm*>(m_pData)))
+        case IEFormat::IE_Bool:          return (std::int64_t)m_Value.m_Bool;
+        case IEFormat::IE_Int8:          return (std::int64_t)m_Value.m_Int8;
+        case IEFormat::IE_UInt8:         return (std::int64_t)m_Value.m_UInt8;
+        case IEFormat::IE_Int16:         return (std::int64_t)m_Value.m_Int16;
+        case IEFormat::IE_UInt16:        return (std::int64_t)m_Value.m_UInt16;
+        case IEFormat::IE_Int32:         return (std::int64_t)m_Value.m_Int32;
+        case IEFormat::IE_UInt32:        return (std::int64_t)m_Value.m_UInt32;
+        case IEFormat::IE_Int64:         return               m_Value.m_Int64;
+        case IEFormat::IE_UInt64:        return (std::int64_t)m_Value.m_UInt64;
+        case IEFormat::IE_Float:         return (std::int64_t)m_Value.m_Float;
+        case IEFormat::IE_Double:        return (std::int64_t)m_Value.m_Double;
+        case IEFormat::IE_String:        return TSP_NumberHelper::StrToNum(m_Value.m_String, defVal);
+        case IEFormat::IE_UnicodeString: return TSP_NumberHelper::StrToNum(m_Value.m_UnicodeString, defVal);
+        case IEFormat::IE_DateTime:      return (std::int64_t)GetTime();
         default:                         return defVal;
     }
 }
 //---------------------------------------------------------------------------
 std::uint64_t TSP_Attribute::Get(std::uint64_t defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return (std::uint64_t)*static_cast<bool*>         (m_pData);
-        case IEFormat::IE_Int8:          return (std::uint64_t)*static_cast<std::int8_t*>  (m_pData);
-        case IEFormat::IE_UInt8:         return (std::uint64_t)*static_cast<std::uint8_t*> (m_pData);
-        case IEFormat::IE_Int16:         return (std::uint64_t)*static_cast<std::int16_t*> (m_pData);
-        case IEFormat::IE_UInt16:        return (std::uint64_t)*static_cast<std::uint16_t*>(m_pData);
-        case IEFormat::IE_Int32:         return (std::uint64_t)*static_cast<std::int32_t*> (m_pData);
-        case IEFormat::IE_UInt32:        return (std::uint64_t)*static_cast<std::uint32_t*>(m_pData);
-        case IEFormat::IE_Int64:         return (std::uint64_t)*static_cast<std::int64_t*> (m_pData);
-        case IEFormat::IE_UInt64:        return                *static_cast<std::uint64_t*>(m_pData);
-        case IEFormat::IE_Float:         return (std::uint64_t)*static_cast<float*>        (m_pData);
-        case IEFormat::IE_Double:        return (std::uint64_t)*static_cast<double*>       (m_pData);
-        case IEFormat::IE_String:        M_Safe_Conversion(std::stoull(*static_cast<std::string*>(m_pData)))
-        case IEFormat::IE_UnicodeString: M_Safe_Conversion(std::stoull(*static_cast<std::wstring*>(m_pData)))
-        case IEFormat::IE_DateTime:      M_Safe_Conversion((std::uint64_t)std::mktime(static_cast<std::tm*>(m_pData)))
+        case IEFormat::IE_Bool:          return (std::uint64_t)m_Value.m_Bool;
+        case IEFormat::IE_Int8:          return (std::uint64_t)m_Value.m_Int8;
+        case IEFormat::IE_UInt8:         return (std::uint64_t)m_Value.m_UInt8;
+        case IEFormat::IE_Int16:         return (std::uint64_t)m_Value.m_Int16;
+        case IEFormat::IE_UInt16:        return (std::uint64_t)m_Value.m_UInt16;
+        case IEFormat::IE_Int32:         return (std::uint64_t)m_Value.m_Int32;
+        case IEFormat::IE_UInt32:        return (std::uint64_t)m_Value.m_UInt32;
+        case IEFormat::IE_Int64:         return (std::uint64_t)m_Value.m_Int64;
+        case IEFormat::IE_UInt64:        return                m_Value.m_UInt64;
+        case IEFormat::IE_Float:         return (std::uint64_t)m_Value.m_Float;
+        case IEFormat::IE_Double:        return (std::uint64_t)m_Value.m_Double;
+        case IEFormat::IE_String:        return TSP_NumberHelper::StrToNum(m_Value.m_String, defVal);
+        case IEFormat::IE_UnicodeString: return TSP_NumberHelper::StrToNum(m_Value.m_UnicodeString, defVal);
+        case IEFormat::IE_DateTime:      return (std::uint64_t)GetTime();
         default:                         return defVal;
     }
 }
 //---------------------------------------------------------------------------
 float TSP_Attribute::Get(float defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return (float)*static_cast<bool*>         (m_pData);
-        case IEFormat::IE_Int8:          return (float)*static_cast<std::int8_t*>  (m_pData);
-        case IEFormat::IE_UInt8:         return (float)*static_cast<std::uint8_t*> (m_pData);
-        case IEFormat::IE_Int16:         return (float)*static_cast<std::int16_t*> (m_pData);
-        case IEFormat::IE_UInt16:        return (float)*static_cast<std::uint16_t*>(m_pData);
-        case IEFormat::IE_Int32:         return (float)*static_cast<std::int32_t*> (m_pData);
-        case IEFormat::IE_UInt32:        return (float)*static_cast<std::uint32_t*>(m_pData);
-        case IEFormat::IE_Int64:         return (float)*static_cast<std::int64_t*> (m_pData);
-        case IEFormat::IE_UInt64:        return (float)*static_cast<std::uint64_t*>(m_pData);
-        case IEFormat::IE_Float:         return        *static_cast<float*>        (m_pData);
-        case IEFormat::IE_Double:        return (float)*static_cast<double*>       (m_pData);
-        case IEFormat::IE_String:        M_Safe_Conversion(std::stof(*static_cast<std::string*>(m_pData)))
-        case IEFormat::IE_UnicodeString: M_Safe_Conversion(std::stof(*static_cast<std::wstring*>(m_pData)))
-        case IEFormat::IE_DateTime:      M_Safe_Conversion((float)std::mktime(static_cast<std::tm*>(m_pData)))
+        case IEFormat::IE_Bool:          return (float)m_Value.m_Bool;
+        case IEFormat::IE_Int8:          return (float)m_Value.m_Int8;
+        case IEFormat::IE_UInt8:         return (float)m_Value.m_UInt8;
+        case IEFormat::IE_Int16:         return (float)m_Value.m_Int16;
+        case IEFormat::IE_UInt16:        return (float)m_Value.m_UInt16;
+        case IEFormat::IE_Int32:         return (float)m_Value.m_Int32;
+        case IEFormat::IE_UInt32:        return (float)m_Value.m_UInt32;
+        case IEFormat::IE_Int64:         return (float)m_Value.m_Int64;
+        case IEFormat::IE_UInt64:        return (float)m_Value.m_UInt64;
+        case IEFormat::IE_Float:         return        m_Value.m_Float;
+        case IEFormat::IE_Double:        return (float)m_Value.m_Double;
+        case IEFormat::IE_String:        return TSP_NumberHelper::StrToNum(m_Value.m_String, defVal);
+        case IEFormat::IE_UnicodeString: return TSP_NumberHelper::StrToNum(m_Value.m_UnicodeString, defVal);
+        case IEFormat::IE_DateTime:      return (float)GetTime();
         default:                         return defVal;
     }
 }
 //---------------------------------------------------------------------------
 double TSP_Attribute::Get(double defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return (double)*static_cast<bool*>         (m_pData);
-        case IEFormat::IE_Int8:          return (double)*static_cast<std::int8_t*>  (m_pData);
-        case IEFormat::IE_UInt8:         return (double)*static_cast<std::uint8_t*> (m_pData);
-        case IEFormat::IE_Int16:         return (double)*static_cast<std::int16_t*> (m_pData);
-        case IEFormat::IE_UInt16:        return (double)*static_cast<std::uint16_t*>(m_pData);
-        case IEFormat::IE_Int32:         return (double)*static_cast<std::int32_t*> (m_pData);
-        case IEFormat::IE_UInt32:        return (double)*static_cast<std::uint32_t*>(m_pData);
-        case IEFormat::IE_Int64:         return (double)*static_cast<std::int64_t*> (m_pData);
-        case IEFormat::IE_UInt64:        return (double)*static_cast<std::uint64_t*>(m_pData);
-        case IEFormat::IE_Float:         return (double)*static_cast<float*>        (m_pData);
-        case IEFormat::IE_Double:        return         *static_cast<double*>       (m_pData);
-        case IEFormat::IE_String:        M_Safe_Conversion(std::stod(*static_cast<std::string*>(m_pData)))
-        case IEFormat::IE_UnicodeString: M_Safe_Conversion(std::stod(*static_cast<std::wstring*>(m_pData)))
-        case IEFormat::IE_DateTime:      M_Safe_Conversion((double)std::mktime(static_cast<std::tm*>(m_pData)))
+        case IEFormat::IE_Bool:          return (double)m_Value.m_Bool;
+        case IEFormat::IE_Int8:          return (double)m_Value.m_Int8;
+        case IEFormat::IE_UInt8:         return (double)m_Value.m_UInt8;
+        case IEFormat::IE_Int16:         return (double)m_Value.m_Int16;
+        case IEFormat::IE_UInt16:        return (double)m_Value.m_UInt16;
+        case IEFormat::IE_Int32:         return (double)m_Value.m_Int32;
+        case IEFormat::IE_UInt32:        return (double)m_Value.m_UInt32;
+        case IEFormat::IE_Int64:         return (double)m_Value.m_Int64;
+        case IEFormat::IE_UInt64:        return (double)m_Value.m_UInt64;
+        case IEFormat::IE_Float:         return (double)m_Value.m_Float;
+        case IEFormat::IE_Double:        return         m_Value.m_Double;
+        case IEFormat::IE_String:        return TSP_NumberHelper::StrToNum(m_Value.m_String, defVal);
+        case IEFormat::IE_UnicodeString: return TSP_NumberHelper::StrToNum(m_Value.m_UnicodeString, defVal);
+        case IEFormat::IE_DateTime:      return (double)GetTime();
         default:                         return defVal;
     }
 }
 //---------------------------------------------------------------------------
 std::string TSP_Attribute::Get(const std::string& defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return TSP_StringHelper::BoolToStr(*static_cast<bool*>(m_pData));
-        case IEFormat::IE_Int8:          M_Safe_Conversion(std::to_string(*static_cast<std::int8_t*>  (m_pData)))
-        case IEFormat::IE_UInt8:         M_Safe_Conversion(std::to_string(*static_cast<std::uint8_t*> (m_pData)))
-        case IEFormat::IE_Int16:         M_Safe_Conversion(std::to_string(*static_cast<std::int16_t*> (m_pData)))
-        case IEFormat::IE_UInt16:        M_Safe_Conversion(std::to_string(*static_cast<std::uint16_t*>(m_pData)))
-        case IEFormat::IE_Int32:         M_Safe_Conversion(std::to_string(*static_cast<std::int32_t*> (m_pData)))
-        case IEFormat::IE_UInt32:        M_Safe_Conversion(std::to_string(*static_cast<std::uint32_t*>(m_pData)))
-        case IEFormat::IE_Int64:         M_Safe_Conversion(std::to_string(*static_cast<std::int64_t*> (m_pData)))
-        case IEFormat::IE_UInt64:        M_Safe_Conversion(std::to_string(*static_cast<std::uint64_t*>(m_pData)))
-        case IEFormat::IE_Float:         M_Safe_Conversion(std::to_string(*static_cast<float*>(m_pData)))
-        case IEFormat::IE_Double:        M_Safe_Conversion(std::to_string(*static_cast<double*>(m_pData)))
-        case IEFormat::IE_String:        M_Safe_Conversion(*static_cast<std::string*>(m_pData))
-        case IEFormat::IE_UnicodeString: M_Safe_Conversion(TSP_StringHelper::Utf16ToUtf8(*static_cast<std::wstring*>(m_pData)))
-        case IEFormat::IE_DateTime:      M_Safe_Conversion(TSP_TimeHelper::TmToStr(*static_cast<std::tm*>(m_pData), m_TimeFormat))
-        default:                         return defVal;
+        case IEFormat::IE_Bool:          return TSP_StringHelper::BoolToStr(m_Value.m_Bool);
+        case IEFormat::IE_Int8:          return std::to_string(m_Value.m_Int8);
+        case IEFormat::IE_UInt8:         return std::to_string(m_Value.m_UInt8);
+        case IEFormat::IE_Int16:         return std::to_string(m_Value.m_Int16);
+        case IEFormat::IE_UInt16:        return std::to_string(m_Value.m_UInt16);
+        case IEFormat::IE_Int32:         return std::to_string(m_Value.m_Int32);
+        case IEFormat::IE_UInt32:        return std::to_string(m_Value.m_UInt32);
+        case IEFormat::IE_Int64:         return std::to_string(m_Value.m_Int64);
+        case IEFormat::IE_UInt64:        return std::to_string(m_Value.m_UInt64);
+        case IEFormat::IE_Float:         return std::to_string(m_Value.m_Float);
+        case IEFormat::IE_Double:        return std::to_string(m_Value.m_Double);
+        case IEFormat::IE_String:        return m_Value.m_String;
+
+        case IEFormat::IE_UnicodeString:
+        case IEFormat::IE_Formula:
+        {
+            std::string result;
+
+            if (!TSP_StringHelper::Utf16ToUtf8(m_Value.m_UnicodeString.c_str(), m_Value.m_UnicodeString.length(), result))
+                return defVal;
+
+            return result;
+        }
+
+        case IEFormat::IE_DateTime:
+        {
+            std::string result;
+
+            if (!TSP_TimeHelper::FormatTm(m_Value.m_DateTime, GetTimeFormat(), result))
+                return defVal;
+
+            return result;
+        }
+
+        default: return defVal;
     }
 }
 //---------------------------------------------------------------------------
 std::wstring TSP_Attribute::Get(const std::wstring& defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Bool:          return TSP_StringHelper::BoolToWStr(*static_cast<bool*>(m_pData));
-        case IEFormat::IE_Int8:          M_Safe_Conversion(std::to_wstring(*static_cast<std::int8_t*>  (m_pData)))
-        case IEFormat::IE_UInt8:         M_Safe_Conversion(std::to_wstring(*static_cast<std::uint8_t*> (m_pData)))
-        case IEFormat::IE_Int16:         M_Safe_Conversion(std::to_wstring(*static_cast<std::int16_t*> (m_pData)))
-        case IEFormat::IE_UInt16:        M_Safe_Conversion(std::to_wstring(*static_cast<std::uint16_t*>(m_pData)))
-        case IEFormat::IE_Int32:         M_Safe_Conversion(std::to_wstring(*static_cast<std::int32_t*> (m_pData)))
-        case IEFormat::IE_UInt32:        M_Safe_Conversion(std::to_wstring(*static_cast<std::uint32_t*>(m_pData)))
-        case IEFormat::IE_Int64:         M_Safe_Conversion(std::to_wstring(*static_cast<std::int64_t*> (m_pData)))
-        case IEFormat::IE_UInt64:        M_Safe_Conversion(std::to_wstring(*static_cast<std::uint64_t*>(m_pData)))
-        case IEFormat::IE_Float:         M_Safe_Conversion(std::to_wstring(*static_cast<float*>(m_pData)))
-        case IEFormat::IE_Double:        M_Safe_Conversion(std::to_wstring(*static_cast<double*>(m_pData)))
-        case IEFormat::IE_String:        M_Safe_Conversion(TSP_StringHelper::Utf8ToUtf16(*static_cast<std::string*>(m_pData)))
-        case IEFormat::IE_UnicodeString: return *static_cast<std::wstring*>(m_pData);
-        case IEFormat::IE_DateTime:      M_Safe_Conversion(TSP_StringHelper::Utf8ToUtf16(TSP_TimeHelper::TmToStr(*static_cast<std::tm*>(m_pData), m_TimeFormat)))
-        default:                         return defVal;
+        case IEFormat::IE_Bool:          return TSP_StringHelper::BoolToWStr(m_Value.m_Bool);
+        case IEFormat::IE_Int8:          return std::to_wstring(m_Value.m_Int8);
+        case IEFormat::IE_UInt8:         return std::to_wstring(m_Value.m_UInt8);
+        case IEFormat::IE_Int16:         return std::to_wstring(m_Value.m_Int16);
+        case IEFormat::IE_UInt16:        return std::to_wstring(m_Value.m_UInt16);
+        case IEFormat::IE_Int32:         return std::to_wstring(m_Value.m_Int32);
+        case IEFormat::IE_UInt32:        return std::to_wstring(m_Value.m_UInt32);
+        case IEFormat::IE_Int64:         return std::to_wstring(m_Value.m_Int64);
+        case IEFormat::IE_UInt64:        return std::to_wstring(m_Value.m_UInt64);
+        case IEFormat::IE_Float:         return std::to_wstring(m_Value.m_Float);
+        case IEFormat::IE_Double:        return std::to_wstring(m_Value.m_Double);
+        case IEFormat::IE_UnicodeString: return m_Value.m_UnicodeString;
+        case IEFormat::IE_Formula:       return m_Value.m_UnicodeString;
+
+        case IEFormat::IE_String:
+        {
+            std::wstring result;
+
+            if (!TSP_StringHelper::Utf8ToUtf16(m_Value.m_String.c_str(), m_Value.m_String.length(), result))
+                return defVal;
+
+            return result;
+        }
+
+        case IEFormat::IE_DateTime:
+        {
+            std::string  dateTime;
+            std::wstring result;
+
+            if (!TSP_TimeHelper::FormatTm(m_Value.m_DateTime, GetTimeFormat(), dateTime))
+                return defVal;
+
+            if (!TSP_StringHelper::Utf8ToUtf16(dateTime.c_str(), dateTime.length(), result))
+                return defVal;
+
+            return result;
+        }
+
+        default: return defVal;
     }
 }
 //---------------------------------------------------------------------------
 std::string TSP_Attribute::Get(const char* pDefVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return pDefVal;
 
     return Get(std::string(pDefVal));
@@ -550,7 +673,7 @@ std::string TSP_Attribute::Get(const char* pDefVal) const
 //---------------------------------------------------------------------------
 std::wstring TSP_Attribute::Get(const wchar_t* pDefVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return pDefVal;
 
     return Get(std::wstring(pDefVal));
@@ -558,191 +681,59 @@ std::wstring TSP_Attribute::Get(const wchar_t* pDefVal) const
 //---------------------------------------------------------------------------
 std::tm TSP_Attribute::Get(const std::tm& defVal) const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return defVal;
 
     switch (m_Format)
     {
-        case IEFormat::IE_Int8:
-            try
-            {
-                const std::time_t value     = (std::time_t)(*static_cast<std::int8_t*>(m_pData));
-                      std::tm*    pDateTime = std::gmtime(&value);
-
-                if (pDateTime)
-                    return *pDateTime;
-
-                return defVal;
-            }
-            catch (...)
-            {
-                M_LogException(TSP_ExceptionFormatter::m_GenericTypeName, "Conversion failed");
-                return defVal;
-            }
-
-        case IEFormat::IE_UInt8:
-            try
-            {
-                const std::time_t value     = (std::time_t)(*static_cast<std::uint8_t*>(m_pData));
-                      std::tm*    pDateTime = std::gmtime(&value);
-
-                if (pDateTime)
-                    return *pDateTime;
-
-                return defVal;
-            }
-            catch (...)
-            {
-                M_LogException(TSP_ExceptionFormatter::m_GenericTypeName, "Conversion failed");
-                return defVal;
-            }
-
-        case IEFormat::IE_Int16:
-            try
-            {
-                const std::time_t value     = (std::time_t)(*static_cast<std::int16_t*>(m_pData));
-                      std::tm*    pDateTime = std::gmtime(&value);
-
-                if (pDateTime)
-                    return *pDateTime;
-
-                return defVal;
-            }
-            catch (...)
-            {
-                M_LogException(TSP_ExceptionFormatter::m_GenericTypeName, "Conversion failed");
-                return defVal;
-            }
-
-        case IEFormat::IE_UInt16:
-            try
-            {
-                const std::time_t value     = (std::time_t)(*static_cast<std::uint16_t*>(m_pData));
-                      std::tm*    pDateTime = std::gmtime(&value);
-
-                if (pDateTime)
-                    return *pDateTime;
-
-                return defVal;
-            }
-            catch (...)
-            {
-                M_LogException(TSP_ExceptionFormatter::m_GenericTypeName, "Conversion failed");
-                return defVal;
-            }
-
-        case IEFormat::IE_Int32:
-            try
-            {
-                const std::time_t value     = (std::time_t)(*static_cast<std::int32_t*>(m_pData));
-                      std::tm*    pDateTime = std::gmtime(&value);
-
-                if (pDateTime)
-                    return *pDateTime;
-
-                return defVal;
-            }
-            catch (...)
-            {
-                M_LogException(TSP_ExceptionFormatter::m_GenericTypeName, "Conversion failed");
-                return defVal;
-            }
-
-        case IEFormat::IE_UInt32:
-            try
-            {
-                const std::time_t value     = (std::time_t)(*static_cast<std::uint32_t*>(m_pData));
-                      std::tm*    pDateTime = std::gmtime(&value);
-
-                if (pDateTime)
-                    return *pDateTime;
-
-                return defVal;
-            }
-            catch (...)
-            {
-                M_LogException(TSP_ExceptionFormatter::m_GenericTypeName, "Conversion failed");
-                return defVal;
-            }
-
-        case IEFormat::IE_Int64:
-            try
-            {
-                const std::time_t value     = (std::time_t)(*static_cast<std::int64_t*>(m_pData));
-                      std::tm*    pDateTime = std::gmtime(&value);
-
-                if (pDateTime)
-                    return *pDateTime;
-
-                return defVal;
-            }
-            catch (...)
-            {
-                M_LogException(TSP_ExceptionFormatter::m_GenericTypeName, "Conversion failed");
+        case IEFormat::IE_Int8:          return TimeToTm((std::time_t)m_Value.m_Int8,   defVal);
+        case IEFormat::IE_UInt8:         return TimeToTm((std::time_t)m_Value.m_UInt8,  defVal);
+        case IEFormat::IE_Int16:         return TimeToTm((std::time_t)m_Value.m_Int16,  defVal);
+        case IEFormat::IE_UInt16:        return TimeToTm((std::time_t)m_Value.m_UInt16, defVal);
+        case IEFormat::IE_Int32:         return TimeToTm((std::time_t)m_Value.m_Int32,  defVal);
+        case IEFormat::IE_UInt32:        return TimeToTm((std::time_t)m_Value.m_UInt32, defVal);
+        case IEFormat::IE_Int64:         return TimeToTm((std::time_t)m_Value.m_Int64,  defVal);
+        case IEFormat::IE_UInt64:        return TimeToTm((std::time_t)m_Value.m_UInt64, defVal);
+        case IEFormat::IE_DateTime:      return m_Value.m_DateTime;
+
+        // a float may not fit in a time stamp, converting it would be undefined
+        case IEFormat::IE_Float:
+            if (!(m_Value.m_Float >= -9.2e18f && m_Value.m_Float <= 9.2e18f))
                 return defVal;
-            }
-
-        case IEFormat::IE_UInt64:
-            try
-            {
-                const std::time_t value     = (std::time_t)(*static_cast<std::uint64_t*>(m_pData));
-                      std::tm*    pDateTime = std::gmtime(&value);
 
-                if (pDateTime)
-                    return *pDateTime;
+            return TimeToTm((std::time_t)m_Value.m_Float, defVal);
 
+        case IEFormat::IE_Double:
+            if (!(m_Value.m_Double >= -9.2e18 && m_Value.m_Double <= 9.2e18))
                 return defVal;
-            }
-            catch (...)
-            {
-                M_LogException(TSP_ExceptionFormatter::m_GenericTypeName, "Conversion failed");
-                return defVal;
-            }
 
-        case IEFormat::IE_Float:
-            try
-            {
-                const std::time_t value     = (std::time_t)(*static_cast<float*>(m_pData));
-                      std::tm*    pDateTime = std::gmtime(&value);
+            return TimeToTm((std::time_t)m_Value.m_Double, defVal);
 
-                if (pDateTime)
-                    return *pDateTime;
+        case IEFormat::IE_String:
+        {
+            std::tm result = defVal;
+            TSP_TimeHelper::ParseTm(m_Value.m_String, GetTimeFormat(), result);
+            return result;
+        }
 
-                return defVal;
-            }
-            catch (...)
-            {
-                M_LogException(TSP_ExceptionFormatter::m_GenericTypeName, "Conversion failed");
-                return defVal;
-            }
-
-        case IEFormat::IE_Double:
-            try
-            {
-                const std::time_t value     = (std::time_t)(*static_cast<double*>(m_pData));
-                      std::tm*    pDateTime = std::gmtime(&value);
+        case IEFormat::IE_UnicodeString:
+        {
+            std::string str;
+            std::tm     result = defVal;
 
-                if (pDateTime)
-                    return *pDateTime;
+            if (TSP_StringHelper::Utf16ToUtf8(m_Value.m_UnicodeString.c_str(), m_Value.m_UnicodeString.length(), str))
+                TSP_TimeHelper::ParseTm(str, GetTimeFormat(), result);
 
-                return defVal;
-            }
-            catch (...)
-            {
-                M_LogException(TSP_ExceptionFormatter::m_GenericTypeName, "Conversion failed");
-                return defVal;
-            }
+            return result;
+        }
 
-        case IEFormat::IE_String:        M_Safe_Conversion(TSP_TimeHelper::StrToTm(*static_cast<std::string*>(m_pData), m_TimeFormat))
-        case IEFormat::IE_UnicodeString: M_Safe_Conversion(TSP_TimeHelper::StrToTm(TSP_StringHelper::Utf16ToUtf8(*static_cast<std::wstring*>(m_pData)), m_TimeFormat))
-        case IEFormat::IE_DateTime:      return *static_cast<std::tm*>(m_pData);
-        default:                         return defVal;
+        default: return defVal;
     }
 }
 //---------------------------------------------------------------------------
 std::size_t TSP_Attribute::GetSize() const
 {
-    if (!m_pData)
+    if (m_Format == IEFormat::IE_Undefined)
         return 0;
 
     switch (m_Format)
@@ -758,10 +749,94 @@ std::size_t TSP_Attribute::GetSize() const
         case IEFormat::IE_UInt64:        return sizeof(std::uint64_t);
         case IEFormat::IE_Float:         return sizeof(float);
         case IEFormat::IE_Double:        return sizeof(double);
-        case IEFormat::IE_String:        return                   (*static_cast<std::string*> (m_pData)).length();
-        case IEFormat::IE_UnicodeString: return sizeof(wchar_t) * (*static_cast<std::wstring*>(m_pData)).length();
+        case IEFormat::IE_String:        return                   (m_Value.m_String).length();
+        case IEFormat::IE_UnicodeString: return sizeof(wchar_t) * (m_Value.m_UnicodeString).length();
         case IEFormat::IE_DateTime:      return sizeof(std::tm);
+        case IEFormat::IE_Formula:       return sizeof(wchar_t) * (m_Value.m_UnicodeString).length();
         default:                         return 0;
     }
 }
 //---------------------------------------------------------------------------
+bool TSP_Attribute::IsSameValue(const TSP_Attribute& other) const
+{
+    switch (m_Format)
+    {
+        case IEFormat::IE_Bool:          return (m_Value.m_Bool          == other.m_Value.m_Bool);
+        case IEFormat::IE_Int8:          return (m_Value.m_Int8          == other.m_Value.m_Int8);
+        case IEFormat::IE_UInt8:         return (m_Value.m_UInt8         == other.m_Value.m_UInt8);
+        case IEFormat::IE_Int16:         return (m_Value.m_Int16         == other.m_Value.m_Int16);
+        case IEFormat::IE_UInt16:        return (m_Value.m_UInt16        == other.m_Value.m_UInt16);
+        case IEFormat::IE_Int32:         return (m_Value.m_Int32         == other.m_Value.m_Int32);
+        case IEFormat::IE_UInt32:        return (m_Value.m_UInt32        == other.m_Value.m_UInt32);
+        case IEFormat::IE_Int64:         return (m_Value.m_Int64         == other.m_Value.m_Int64);
+        case IEFormat::IE_UInt64:        return (m_Value.m_UInt64        == other.m_Value.m_UInt64);
+        case IEFormat::IE_Float:         return (m_Value.m_Float         == other.m_Value.m_Float);
+        case IEFormat::IE_Double:        return (m_Value.m_Double        == other.m_Value.m_Double);
+        case IEFormat::IE_String:        return (m_Value.m_String        == other.m_Value.m_String);
+        case IEFormat::IE_UnicodeString:
+        case IEFormat::IE_Formula:       return (m_Value.m_UnicodeString == other.m_Value.m_UnicodeString);
+
+        case IEFormat::IE_DateTime:
+        {
+            const std::tm& dateTime      = m_Value.m_DateTime;
+            const std::tm& otherDateTime = other.m_Value.m_DateTime;
+
+            return (dateTime.tm_year == otherDateTime.tm_year &&
+                    dateTime.tm_mon  == otherDateTime.tm_mon  &&
+                    dateTime.tm_mday == otherDateTime.tm_mday &&
+                    dateTime.tm_hour == otherDateTime.tm_hour &&
+                    dateTime.tm_min  == otherDateTime.tm_min  &&
+                    dateTime.tm_sec  == otherDateTime.tm_sec);
+        }
+
+        default: return true;
+    }
+}
+//---------------------------------------------------------------------------
+void TSP_Attribute::Copy(const TSP_Attribute& other)
+{
+    switch (other.m_Format)
+    {
+        case IEFormat::IE_String:        Set(other.m_Value.m_String);               return;
+        case IEFormat::IE_UnicodeString: Set(other.m_Value.m_UnicodeString);        return;
+        case IEFormat::IE_Formula:       SetFormula(other.m_Value.m_UnicodeString); return;
+        default:                                                                    break;
+    }
+
+    Clear();
+
+    // the remaining formats are trivially copyable
+    std::memcpy(static_cast<void*>(&m_Value), &other.m_Value, sizeof(IValue));
+    m_Format = other.m_Format;
+}
+//---------------------------------------------------------------------------
+void TSP_Attribute::Move(TSP_Attribute& other)
+{
+    switch (other.m_Format)
+    {
+        case IEFormat::IE_String:        Set(std::move(other.m_Value.m_String));               break;
+        case IEFormat::IE_UnicodeString: Set(std::move(other.m_Value.m_UnicodeString));        break;
+        case IEFormat::IE_Formula:       SetFormula(std::move(other.m_Value.m_UnicodeString)); break;
+        default:                         Copy(other);                                          break;
+    }
+
+    other.Clear();
+}
+//---------------------------------------------------------------------------
+std::time_t TSP_Attribute::GetTime() const
+{
+    // mktime() normalizes the structure it receives, so work on a copy
+    std::tm dateTime = m_Value.m_DateTime;
+    return std::mktime(&dateTime);
+}
+//---------------------------------------------------------------------------
+std::tm TSP_Attribute::TimeToTm(std::time_t time, const std::tm& defVal)
+{
+    std::tm dateTime;
+
+    if (!TSP_TimeHelper::ToUTCTm(time, dateTime))
+        return defVal;
+
+    return dateTime;
+}
+//---------------------------------------------------------------------------
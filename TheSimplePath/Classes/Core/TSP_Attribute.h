@@ -32,7 +32,10 @@
 // std
 #include <cstdint>
 #include <ctime>
+#include <mutex>
+#include <new>
 #include <string>
+#include <utility>
 #include <vector>
 
 // common classes
@@ -40,7 +43,8 @@
 #include "Common\TSP_Logger.h"
 
 /**
-* Basic attribute which may be contained in an element
+* Basic attribute which may be contained in an element. The value is kept inline in a tagged union,
+* so only the string formats may allocate memory
 *@author Jean-Milost Reymond
 */
 class TSP_Attribute
@@ -48,10 +52,18 @@ class TSP_Attribute
     public:
         /**
         * Attribute keys
+        *@note The format of each key is declared in TSP_AttributeSchema
         */
         enum class IEKey
         {
-            IE_K_Unknown = 0
+            IE_K_Unknown = 0,
+            IE_K_Duration,
+            IE_K_Cost,
+            IE_K_Frequency,
+            IE_K_Resources,
+            IE_K_Owner,
+            IE_K_StartDate,
+            IE_K_Count
         };
 
         /**
@@ -73,7 +85,8 @@ class TSP_Attribute
             IE_Double,
             IE_String,
             IE_UnicodeString,
-            IE_DateTime
+            IE_DateTime,
+            IE_Formula
         };
 
         /**
@@ -89,6 +102,18 @@ class TSP_Attribute
         template<class T>
         inline TSP_Attribute(const T& value);
 
+        /**
+        * Copy constructor
+        *@param other - other attribute to copy from
+        */
+        TSP_Attribute(const TSP_Attribute& other);
+
+        /**
+        * Move constructor
+        *@param other - other attribute to move from, cleared on return
+        */
+        TSP_Attribute(TSP_Attribute&& other);
+
         virtual ~TSP_Attribute();
 
         /**
@@ -97,6 +122,7 @@ class TSP_Attribute
         *@return this attribute
         */
         virtual inline TSP_Attribute& operator = (const TSP_Attribute& other);
+        virtual inline TSP_Attribute& operator = (TSP_Attribute&&      other);
         virtual inline TSP_Attribute& operator = (const char*          pOther);
         virtual inline TSP_Attribute& operator = (const wchar_t*       pOther);
 
@@ -126,12 +152,14 @@ class TSP_Attribute
         /**
         * Sets the time format to use for conversions
         *@param timeFormat - new time format to use for conversions
+        *@note The time format is shared by all the attributes
         */
         virtual void SetTimeFormat(const std::string& timeFormat);
 
         /**
         * Gets the time format used for conversions
         *@return the time format used for conversions
+        *@note The time format is shared by all the attributes
         */
         virtual std::string GetTimeFormat() const;
 
@@ -151,11 +179,33 @@ class TSP_Attribute
         virtual void Set(float               value);
         virtual void Set(double              value);
         virtual void Set(const std::string&  value);
+        virtual void Set(std::string&&       value);
         virtual void Set(const std::wstring& value);
+        virtual void Set(std::wstring&&      value);
         virtual void Set(const char*         pDefVal);
         virtual void Set(const wchar_t*      pDefVal);
         virtual void Set(const std::tm&      value);
 
+        /**
+        * Sets a formula, whose result will be calculated by the component owning the attribute
+        *@param formula - formula, see TSP_Expression for the syntax
+        */
+        virtual void SetFormula(const std::wstring& formula);
+        virtual void SetFormula(std::wstring&&      formula);
+
+        /**
+        * Gets the attribute value format
+        *@return the attribute value format, IE_Undefined if the attribute is empty
+        */
+        virtual inline IEFormat GetFormat() const;
+
+        /**
+        * Checks if the attribute contains a formula
+        *@return true if the attribute contains a formula, otherwise false
+        *@note A formula has no value by itself, it's only converted to its text
+        */
+        virtual inline bool IsFormula() const;
+
         /**
         * Gets the attribute value
         *@return the attribute value
@@ -192,12 +242,37 @@ class TSP_Attribute
         virtual std::size_t GetSize() const;
 
     private:
-        std::string m_TimeFormat = "%F %T";
-        void*       m_pData      = nullptr;
-        IEFormat    m_Format     = IEFormat::IE_Undefined;
+        /**
+        * Attribute value, the active member matches with the attribute format
+        */
+        union IValue
+        {
+            bool          m_Bool;
+            std::int8_t   m_Int8;
+            std::uint8_t  m_UInt8;
+            std::int16_t  m_Int16;
+            std::uint16_t m_UInt16;
+            std::int32_t  m_Int32;
+            std::uint32_t m_UInt32;
+            std::int64_t  m_Int64;
+            std::uint64_t m_UInt64;
+            float         m_Float;
+            double        m_Double;
+            std::string   m_String;
+            std::wstring  m_UnicodeString; // also contains the formula text
+            std::tm       m_DateTime;
+
+            inline IValue();
+            inline ~IValue();
+        };
+
+        static std::string m_TimeFormat;
+        static std::mutex  m_TimeFormatMutex;
+               IValue      m_Value;
+               IEFormat    m_Format = IEFormat::IE_Undefined;
 
         /**
-        * Checks if an attribute equals another one
+        * Checks if an attribute equals another one, after converting the other value to this attribute format
         *@param other - other attribute to compare with
         *@return true if the attribute equals the other, otherwise false
         */
@@ -205,12 +280,37 @@ class TSP_Attribute
         bool Equals(const TSP_Attribute& other) const;
 
         /**
-        * Checks if an attribute differs from another one
-        *@param other - other attribute to compare with
-        *@return true if the attribute differs from the other, otherwise false
+        * Checks if the attribute value equals the value of another attribute of the same format
+        *@param other - other attribute to compare with, should have the same format as this one
+        *@return true if the values are identical, otherwise false
         */
-        template<class T>
-        bool Differs(const TSP_Attribute& other) const;
+        bool IsSameValue(const TSP_Attribute& other) const;
+
+        /**
+        * Copies the value of another attribute
+        *@param other - other attribute to copy from
+        */
+        void Copy(const TSP_Attribute& other);
+
+        /**
+        * Moves the value of another attribute
+        *@param other - other attribute to move from, cleared on return
+        */
+        void Move(TSP_Attribute& other);
+
+        /**
+        * Gets the date and time value as a time stamp
+        *@return the time stamp
+        */
+        std::time_t GetTime() const;
+
+        /**
+        * Converts a time stamp to an UTC date and time structure
+        *@param time - time stamp to convert
+        *@param defVal - default value to return if the conversion failed
+        *@return date and time structure, default value on error
+        */
+        static std::tm TimeToTm(std::time_t time, const std::tm& defVal);
 };
 
 /**
@@ -229,41 +329,42 @@ TSP_Attribute::TSP_Attribute(const T& value)
 //---------------------------------------------------------------------------
 TSP_Attribute& TSP_Attribute::operator = (const TSP_Attribute& other)
 {
-    switch (other.m_Format)
-    {
-        case IEFormat::IE_Bool:          Set(other.Get<bool>());          break;
-        case IEFormat::IE_Int8:          Set(other.Get<std::int8_t>());   break;
-        case IEFormat::IE_UInt8:         Set(other.Get<std::uint8_t>());  break;
-        case IEFormat::IE_Int16:         Set(other.Get<std::int16_t>());  break;
-        case IEFormat::IE_UInt16:        Set(other.Get<std::uint16_t>()); break;
-        case IEFormat::IE_Int32:         Set(other.Get<std::int32_t>());  break;
-        case IEFormat::IE_UInt32:        Set(other.Get<std::uint32_t>()); break;
-        case IEFormat::IE_Int64:         Set(other.Get<std::int64_t>());  break;
-        case IEFormat::IE_UInt64:        Set(other.Get<std::uint64_t>()); break;
-        case IEFormat::IE_Float:         Set(other.Get<float>());         break;
-        case IEFormat::IE_Double:        Set(other.Get<double>());        break;
-        case IEFormat::IE_String:        Set(other.Get<std::string>());   break;
-        case IEFormat::IE_UnicodeString: Set(other.Get<std::wstring>());  break;
-        default:                         M_THROW_EXCEPTION("Unknown or undefined format - " + std::to_string((int)other.m_Format));
-    }
+    if (this != &other)
+        Copy(other);
+
+    return *this;
+}
+//---------------------------------------------------------------------------
+TSP_Attribute& TSP_Attribute::operator = (TSP_Attribute&& other)
+{
+    if (this != &other)
+        Move(other);
 
     return *this;
 }
 //---------------------------------------------------------------------------
 TSP_Attribute& TSP_Attribute::operator = (const char* pOther)
 {
-    Set(std::string(pOther));
+    Set(pOther);
     return *this;
 }
 //---------------------------------------------------------------------------
 TSP_Attribute& TSP_Attribute::operator = (const wchar_t* pOther)
 {
-    Set(std::wstring(pOther));
+    Set(pOther);
     return *this;
 }
 //---------------------------------------------------------------------------
 bool TSP_Attribute::operator == (const TSP_Attribute& other) const
 {
+    // same format, compare the values in place
+    if (m_Format == other.m_Format)
+        return IsSameValue(other);
+
+    // a formula only equals another formula
+    if (other.m_Format == IEFormat::IE_Formula)
+        return false;
+
     switch (m_Format)
     {
         case IEFormat::IE_Bool:          return Equals<bool>(other);
@@ -279,51 +380,49 @@ bool TSP_Attribute::operator == (const TSP_Attribute& other) const
         case IEFormat::IE_Double:        return Equals<double>(other);
         case IEFormat::IE_String:        return Equals<std::string>(other);
         case IEFormat::IE_UnicodeString: return Equals<std::wstring>(other);
+        default:                         return false;
     }
-
-    return false;
 }
 //---------------------------------------------------------------------------
 bool TSP_Attribute::operator == (const char* pOther) const
 {
-    return Equals<std::string>(std::string(pOther));
+    if (m_Format == IEFormat::IE_String)
+        return (m_Value.m_String == pOther);
+
+    return (Get(std::string()) == pOther);
 }
 //---------------------------------------------------------------------------
 bool TSP_Attribute::operator == (const wchar_t* pOther) const
 {
-    return Equals<std::wstring>(std::wstring(pOther));
+    if (m_Format == IEFormat::IE_UnicodeString)
+        return (m_Value.m_UnicodeString == pOther);
+
+    return (Get(std::wstring()) == pOther);
 }
 //---------------------------------------------------------------------------
 bool TSP_Attribute::operator != (const TSP_Attribute& other) const
 {
-    switch (m_Format)
-    {
-        case IEFormat::IE_Bool:          return Differs<bool>(other);
-        case IEFormat::IE_Int8:          return Differs<std::int8_t>(other);
-        case IEFormat::IE_UInt8:         return Differs<std::uint8_t>(other);
-        case IEFormat::IE_Int16:         return Differs<std::int16_t>(other);
-        case IEFormat::IE_UInt16:        return Differs<std::uint16_t>(other);
-        case IEFormat::IE_Int32:         return Differs<std::int32_t>(other);
-        case IEFormat::IE_UInt32:        return Differs<std::uint32_t>(other);
-        case IEFormat::IE_Int64:         return Differs<std::int64_t>(other);
-        case IEFormat::IE_UInt64:        return Differs<std::uint64_t>(other);
-        case IEFormat::IE_Float:         return Differs<float>(other);
-        case IEFormat::IE_Double:        return Differs<double>(other);
-        case IEFormat::IE_String:        return Differs<std::string>(other);
-        case IEFormat::IE_UnicodeString: return Differs<std::wstring>(other);
-    }
-
-    return false;
+    return !operator == (other);
 }
 //---------------------------------------------------------------------------
 bool TSP_Attribute::operator != (const char* pOther) const
 {
-    return Differs<std::string>(std::string(pOther));
+    return !operator == (pOther);
 }
 //---------------------------------------------------------------------------
 bool TSP_Attribute::operator != (const wchar_t* pOther) const
 {
-    return Differs<std::wstring>(std::wstring(pOther));
+    return !operator == (pOther);
+}
+//---------------------------------------------------------------------------
+TSP_Attribute::IEFormat TSP_Attribute::GetFormat() const
+{
+    return m_Format;
+}
+//---------------------------------------------------------------------------
+bool TSP_Attribute::IsFormula() const
+{
+    return m_Format == IEFormat::IE_Formula;
 }
 //---------------------------------------------------------------------------
 template <class T>
@@ -337,24 +436,14 @@ T TSP_Attribute::Get() const
 template<class T>
 bool TSP_Attribute::Equals(const TSP_Attribute& other) const
 {
-    T value1 = T();
-    T value2 = T();
-
-    Get(value1);
-    other.Get(value2);
-
-    return (value1 == value2);
+    return (Get<T>() == other.Get<T>());
 }
 //---------------------------------------------------------------------------
-template<class T>
-bool TSP_Attribute::Differs(const TSP_Attribute& other) const
-{
-    T value1 = T();
-    T value2 = T();
-
-    Get(value1);
-    other.Get(value2);
-
-    return (value1 != value2);
-}
+// TSP_Attribute::IValue
+//---------------------------------------------------------------------------
+TSP_Attribute::IValue::IValue()
+{}
+//---------------------------------------------------------------------------
+TSP_Attribute::IValue::~IValue()
+{}
 //---------------------------------------------------------------------------
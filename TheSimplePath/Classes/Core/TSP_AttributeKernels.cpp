@@ -0,0 +1,644 @@
+/****************************************************************************
+ * ==> TSP_AttributeKernels ------------------------------------------------*
+ ****************************************************************************
+ * Description:  Vectorized aggregation kernels over attribute columns      *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_AttributeKernels.h"
+
+// std
+#include <cstring>
+#include <limits>
+
+//---------------------------------------------------------------------------
+// Global defines
+//---------------------------------------------------------------------------
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define M_X86_Kernels
+
+    #ifdef _MSC_VER
+        #include <intrin.h>
+
+        // MSVC accepts the intrinsics of any instruction set without special function attributes
+        #define M_Target_Sse42
+        #define M_Target_Avx2
+    #else
+        #include <immintrin.h>
+
+        #define M_Target_Sse42 __attribute__((target("sse4.2")))
+        #define M_Target_Avx2  __attribute__((target("avx2")))
+    #endif
+#endif
+
+//---------------------------------------------------------------------------
+// TSP_AttributeKernels::IScalar
+//---------------------------------------------------------------------------
+/**
+* Scalar kernels, used when no vector instruction set is available, and for the values the vector
+* kernels cannot convert
+*/
+class TSP_AttributeKernels::IScalar
+{
+    public:
+        /**
+        * Aggregates the valid values contained in a range
+        *@param pValues - values
+        *@param pValidity - validity bitmap
+        *@param begin - first value index to aggregate
+        *@param end - value index after the last one to aggregate
+        *@param low - lowest value to aggregate
+        *@param high - highest value to aggregate
+        *@param[in, out] aggregate - aggregate in which the matching values are merged
+        */
+        template <class T>
+        static void Aggregate(const T*             pValues,
+                              const std::uint64_t* pValidity,
+                                    std::size_t    begin,
+                                    std::size_t    end,
+                                    double         low,
+                                    double         high,
+                                    IAggregate&    aggregate);
+};
+//---------------------------------------------------------------------------
+template <class T>
+void TSP_AttributeKernels::IScalar::Aggregate(const T*             pValues,
+                                              const std::uint64_t* pValidity,
+                                                    std::size_t    begin,
+                                                    std::size_t    end,
+                                                    double         low,
+                                                    double         high,
+                                                    IAggregate&    aggregate)
+{
+    IAggregate result;
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const std::uint64_t word = pValidity[i >> 6];
+
+        // no valid value in the whole word? Skip it
+        if (!word && !(i & 63))
+        {
+            i += 63;
+            continue;
+        }
+
+        if (!((word >> (i & 63)) & 1))
+            continue;
+
+        const double value = double(pValues[i]);
+
+        if (!(value >= low && value <= high))
+            continue;
+
+        if (!result.m_Count || value < result.m_Min)
+            result.m_Min = value;
+
+        if (!result.m_Count || value > result.m_Max)
+            result.m_Max = value;
+
+        result.m_Sum += value;
+        ++result.m_Count;
+    }
+
+    aggregate.Merge(result);
+}
+//---------------------------------------------------------------------------
+#ifdef M_X86_Kernels
+//---------------------------------------------------------------------------
+// TSP_AttributeKernels::ISse42
+//---------------------------------------------------------------------------
+/**
+* SSE4.2 kernels, process 2 values at once
+*/
+class TSP_AttributeKernels::ISse42
+{
+    public:
+        /**
+        * Aggregates the valid values contained in a range
+        *@param pValues - values
+        *@param pValidity - validity bitmap
+        *@param count - value count
+        *@param low - lowest value to aggregate
+        *@param high - highest value to aggregate
+        *@param[in, out] aggregate - aggregate in which the matching values are merged
+        */
+        template <class T>
+        M_Target_Sse42 static void Aggregate(const T*             pValues,
+                                             const std::uint64_t* pValidity,
+                                                   std::size_t    count,
+                                                   double         low,
+                                                   double         high,
+                                                   IAggregate&    aggregate);
+
+    private:
+        /**
+        * Loads 2 values and converts them to double
+        *@param pValues - values to load
+        *@return converted values
+        */
+        M_Target_Sse42 static inline __m128d Load(const std::int8_t*   pValues);
+        M_Target_Sse42 static inline __m128d Load(const std::uint8_t*  pValues);
+        M_Target_Sse42 static inline __m128d Load(const std::int16_t*  pValues);
+        M_Target_Sse42 static inline __m128d Load(const std::uint16_t* pValues);
+        M_Target_Sse42 static inline __m128d Load(const std::int32_t*  pValues);
+        M_Target_Sse42 static inline __m128d Load(const float*         pValues);
+        M_Target_Sse42 static inline __m128d Load(const double*        pValues);
+};
+//---------------------------------------------------------------------------
+__m128d TSP_AttributeKernels::ISse42::Load(const std::int8_t* pValues)
+{
+    std::uint16_t packed;
+    std::memcpy(&packed, pValues, sizeof(packed));
+
+    return _mm_cvtepi32_pd(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(packed)));
+}
+//---------------------------------------------------------------------------
+__m128d TSP_AttributeKernels::ISse42::Load(const std::uint8_t* pValues)
+{
+    std::uint16_t packed;
+    std::memcpy(&packed, pValues, sizeof(packed));
+
+    return _mm_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed)));
+}
+//---------------------------------------------------------------------------
+__m128d TSP_AttributeKernels::ISse42::Load(const std::int16_t* pValues)
+{
+    std::int32_t packed;
+    std::memcpy(&packed, pValues, sizeof(packed));
+
+    return _mm_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_cvtsi32_si128(packed)));
+}
+//---------------------------------------------------------------------------
+__m128d TSP_AttributeKernels::ISse42::Load(const std::uint16_t* pValues)
+{
+    std::int32_t packed;
+    std::memcpy(&packed, pValues, sizeof(packed));
+
+    return _mm_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_cvtsi32_si128(packed)));
+}
+//---------------------------------------------------------------------------
+__m128d TSP_AttributeKernels::ISse42::Load(const std::int32_t* pValues)
+{
+    return _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pValues)));
+}
+//---------------------------------------------------------------------------
+__m128d TSP_AttributeKernels::ISse42::Load(const float* pValues)
+{
+    return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pValues))));
+}
+//---------------------------------------------------------------------------
+__m128d TSP_AttributeKernels::ISse42::Load(const double* pValues)
+{
+    return _mm_loadu_pd(pValues);
+}
+//---------------------------------------------------------------------------
+template <class T>
+void TSP_AttributeKernels::ISse42::Aggregate(const T*             pValues,
+                                             const std::uint64_t* pValidity,
+                                                   std::size_t    count,
+                                                   double         low,
+                                                   double         high,
+                                                   IAggregate&    aggregate)
+{
+    const __m128d     lowValue    = _mm_set1_pd(low);
+    const __m128d     highValue   = _mm_set1_pd(high);
+    const __m128d     posInfinity = _mm_set1_pd( std::numeric_limits<double>::infinity());
+    const __m128d     negInfinity = _mm_set1_pd(-std::numeric_limits<double>::infinity());
+    const __m128i     laneBits    = _mm_set_epi64x(2, 1);
+    const std::size_t blockEnd    = count & ~std::size_t(1);
+          __m128d     sum         = _mm_setzero_pd();
+          __m128d     minimum     = posInfinity;
+          __m128d     maximum     = negInfinity;
+          std::size_t matchCount  = 0;
+          std::size_t i           = 0;
+
+    while (i < blockEnd)
+    {
+        const std::uint64_t word = pValidity[i >> 6];
+
+        // no valid value in the whole word? Skip it
+        if (!word && !(i & 63))
+        {
+            i += 64;
+            continue;
+        }
+
+        const std::int64_t bits = (word >> (i & 63)) & 3;
+
+        if (bits)
+        {
+            // build a mask of the lanes which are valid and in range
+            const __m128d values  = Load(pValues + i);
+            const __m128i lanes   = _mm_and_si128(_mm_set1_epi64x(bits), laneBits);
+            const __m128d valid   = _mm_castsi128_pd(_mm_cmpeq_epi64(lanes, laneBits));
+            const __m128d inRange = _mm_and_pd(_mm_cmpge_pd(values, lowValue), _mm_cmple_pd(values, highValue));
+            const __m128d mask    = _mm_and_pd(valid, inRange);
+            const int     matches = _mm_movemask_pd(mask);
+
+            sum         = _mm_add_pd(sum, _mm_and_pd(values, mask));
+            minimum     = _mm_min_pd(minimum, _mm_blendv_pd(posInfinity, values, mask));
+            maximum     = _mm_max_pd(maximum, _mm_blendv_pd(negInfinity, values, mask));
+            matchCount += (matches & 1) + ((matches >> 1) & 1);
+        }
+
+        i += 2;
+    }
+
+    IAggregate result;
+
+    if (matchCount)
+    {
+        double lanes[2];
+
+        result.m_Count = matchCount;
+
+        _mm_storeu_pd(lanes, sum);
+        result.m_Sum = lanes[0] + lanes[1];
+
+        _mm_storeu_pd(lanes, minimum);
+        result.m_Min = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+
+        _mm_storeu_pd(lanes, maximum);
+        result.m_Max = lanes[0] > lanes[1] ? lanes[0] : lanes[1];
+    }
+
+    aggregate.Merge(result);
+
+    // aggregate the remaining value, if any
+    IScalar::Aggregate(pValues, pValidity, i, count, low, high, aggregate);
+}
+//---------------------------------------------------------------------------
+// TSP_AttributeKernels::IAvx2
+//---------------------------------------------------------------------------
+/**
+* AVX2 kernels, process 4 values at once
+*/
+class TSP_AttributeKernels::IAvx2
+{
+    public:
+        /**
+        * Aggregates the valid values contained in a range
+        *@param pValues - values
+        *@param pValidity - validity bitmap
+        *@param count - value count
+        *@param low - lowest value to aggregate
+        *@param high - highest value to aggregate
+        *@param[in, out] aggregate - aggregate in which the matching values are merged
+        */
+        template <class T>
+        M_Target_Avx2 static void Aggregate(const T*             pValues,
+                                            const std::uint64_t* pValidity,
+                                                  std::size_t    count,
+                                                  double         low,
+                                                  double         high,
+                                                  IAggregate&    aggregate);
+
+    private:
+        /**
+        * Loads 4 values and converts them to double
+        *@param pValues - values to load
+        *@return converted values
+        */
+        M_Target_Avx2 static inline __m256d Load(const std::int8_t*   pValues);
+        M_Target_Avx2 static inline __m256d Load(const std::uint8_t*  pValues);
+        M_Target_Avx2 static inline __m256d Load(const std::int16_t*  pValues);
+        M_Target_Avx2 static inline __m256d Load(const std::uint16_t* pValues);
+        M_Target_Avx2 static inline __m256d Load(const std::int32_t*  pValues);
+        M_Target_Avx2 static inline __m256d Load(const float*         pValues);
+        M_Target_Avx2 static inline __m256d Load(const double*        pValues);
+};
+//---------------------------------------------------------------------------
+__m256d TSP_AttributeKernels::IAvx2::Load(const std::int8_t* pValues)
+{
+    std::int32_t packed;
+    std::memcpy(&packed, pValues, sizeof(packed));
+
+    return _mm256_cvtepi32_pd(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(packed)));
+}
+//---------------------------------------------------------------------------
+__m256d TSP_AttributeKernels::IAvx2::Load(const std::uint8_t* pValues)
+{
+    std::int32_t packed;
+    std::memcpy(&packed, pValues, sizeof(packed));
+
+    return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed)));
+}
+//---------------------------------------------------------------------------
+__m256d TSP_AttributeKernels::IAvx2::Load(const std::int16_t* pValues)
+{
+    return _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pValues))));
+}
+//---------------------------------------------------------------------------
+__m256d TSP_AttributeKernels::IAvx2::Load(const std::uint16_t* pValues)
+{
+    return _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pValues))));
+}
+//---------------------------------------------------------------------------
+__m256d TSP_AttributeKernels::IAvx2::Load(const std::int32_t* pValues)
+{
+    return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pValues)));
+}
+//---------------------------------------------------------------------------
+__m256d TSP_AttributeKernels::IAvx2::Load(const float* pValues)
+{
+    return _mm256_cvtps_pd(_mm_loadu_ps(pValues));
+}
+//---------------------------------------------------------------------------
+__m256d TSP_AttributeKernels::IAvx2::Load(const double* pValues)
+{
+    return _mm256_loadu_pd(pValues);
+}
+//---------------------------------------------------------------------------
+template <class T>
+void TSP_AttributeKernels::IAvx2::Aggregate(const T*             pValues,
+                                            const std::uint64_t* pValidity,
+                                                  std::size_t    count,
+                                                  double         low,
+                                                  double         high,
+                                                  IAggregate&    aggregate)
+{
+    const __m256d     lowValue    = _mm256_set1_pd(low);
+    const __m256d     highValue   = _mm256_set1_pd(high);
+    const __m256d     posInfinity = _mm256_set1_pd( std::numeric_limits<double>::infinity());
+    const __m256d     negInfinity = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    const __m256i     laneBits    = _mm256_set_epi64x(8, 4, 2, 1);
+    const std::size_t blockEnd    = count & ~std::size_t(3);
+          __m256d     sum         = _mm256_setzero_pd();
+          __m256d     minimum     = posInfinity;
+          __m256d     maximum     = negInfinity;
+          std::size_t matchCount  = 0;
+          std::size_t i           = 0;
+
+    while (i < blockEnd)
+    {
+        const std::uint64_t word = pValidity[i >> 6];
+
+        // no valid value in the whole word? Skip it
+        if (!word && !(i & 63))
+        {
+            i += 64;
+            continue;
+        }
+
+        const std::int64_t bits = (word >> (i & 63)) & 15;
+
+        if (bits)
+        {
+            // build a mask of the lanes which are valid and in range
+            const __m256d values  = Load(pValues + i);
+            const __m256i lanes   = _mm256_and_si256(_mm256_set1_epi64x(bits), laneBits);
+            const __m256d valid   = _mm256_castsi256_pd(_mm256_cmpeq_epi64(lanes, laneBits));
+            const __m256d inRange = _mm256_and_pd(_mm256_cmp_pd(values, lowValue,  _CMP_GE_OQ),
+                                                  _mm256_cmp_pd(values, highValue, _CMP_LE_OQ));
+            const __m256d mask    = _mm256_and_pd(valid, inRange);
+            const int     matches = _mm256_movemask_pd(mask);
+
+            sum         = _mm256_add_pd(sum, _mm256_and_pd(values, mask));
+            minimum     = _mm256_min_pd(minimum, _mm256_blendv_pd(posInfinity, values, mask));
+            maximum     = _mm256_max_pd(maximum, _mm256_blendv_pd(negInfinity, values, mask));
+            matchCount += (matches & 1) + ((matches >> 1) & 1) + ((matches >> 2) & 1) + ((matches >> 3) & 1);
+        }
+
+        i += 4;
+    }
+
+    IAggregate result;
+
+    if (matchCount)
+    {
+        // reduce the 4 lanes to 2
+        const __m128d sum2     = _mm_add_pd(_mm256_castpd256_pd128(sum),     _mm256_extractf128_pd(sum,     1));
+        const __m128d minimum2 = _mm_min_pd(_mm256_castpd256_pd128(minimum), _mm256_extractf128_pd(minimum, 1));
+        const __m128d maximum2 = _mm_max_pd(_mm256_castpd256_pd128(maximum), _mm256_extractf128_pd(maximum, 1));
+              double  lanes[2];
+
+        result.m_Count = matchCount;
+
+        _mm_storeu_pd(lanes, sum2);
+        result.m_Sum = lanes[0] + lanes[1];
+
+        _mm_storeu_pd(lanes, minimum2);
+        result.m_Min = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+
+        _mm_storeu_pd(lanes, maximum2);
+        result.m_Max = lanes[0] > lanes[1] ? lanes[0] : lanes[1];
+    }
+
+    aggregate.Merge(result);
+
+    // aggregate the remaining values, if any
+    IScalar::Aggregate(pValues, pValidity, i, count, low, high, aggregate);
+}
+//---------------------------------------------------------------------------
+#endif
+//---------------------------------------------------------------------------
+// Static members
+//---------------------------------------------------------------------------
+std::atomic<TSP_AttributeKernels::IEInstructionSet> TSP_AttributeKernels::m_InstructionSet
+        (TSP_AttributeKernels::GetSupportedInstructionSet());
+//---------------------------------------------------------------------------
+// TSP_AttributeKernels
+//---------------------------------------------------------------------------
+TSP_AttributeKernels::IEInstructionSet TSP_AttributeKernels::GetInstructionSet()
+{
+    return m_InstructionSet.load(std::memory_order_relaxed);
+}
+//---------------------------------------------------------------------------
+TSP_AttributeKernels::IEInstructionSet TSP_AttributeKernels::SetInstructionSet(IEInstructionSet instructionSet)
+{
+    const IEInstructionSet supported = GetSupportedInstructionSet();
+
+    const IEInstructionSet used = instructionSet > supported ? supported : instructionSet;
+
+    // NOTE the queries may read the instruction set from other threads in the meantime, they use
+    // either the previous or the new one
+    m_InstructionSet.store(used, std::memory_order_relaxed);
+
+    return used;
+}
+//---------------------------------------------------------------------------
+TSP_AttributeKernels::IEInstructionSet TSP_AttributeKernels::GetSupportedInstructionSet()
+{
+    #if defined(M_X86_Kernels) && defined(_MSC_VER)
+        int info[4];
+
+        __cpuid(info, 1);
+
+        const bool sse42   = (info[2] & (1 << 20)) != 0;
+        const bool osXSave = (info[2] & (1 << 27)) != 0;
+        const bool avx     = (info[2] & (1 << 28)) != 0;
+              bool avx2    = false;
+
+        // AVX2 also requires the operating system to save the extended registers
+        if (osXSave && avx && (_xgetbv(0) & 6) == 6)
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+
+        if (avx2)
+            return IEInstructionSet::IE_IS_Avx2;
+
+        if (sse42)
+            return IEInstructionSet::IE_IS_Sse42;
+    #elif defined(M_X86_Kernels)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return IEInstructionSet::IE_IS_Avx2;
+
+        if (__builtin_cpu_supports("sse4.2"))
+            return IEInstructionSet::IE_IS_Sse42;
+    #endif
+
+    return IEInstructionSet::IE_IS_Scalar;
+}
+//---------------------------------------------------------------------------
+template <class T>
+void TSP_AttributeKernels::Dispatch(const T*             pValues,
+                                    const std::uint64_t* pValidity,
+                                          std::size_t    count,
+                                          double         low,
+                                          double         high,
+                                          IAggregate&    aggregate)
+{
+    if (!pValues || !pValidity || !count)
+        return;
+
+    switch (m_InstructionSet.load(std::memory_order_relaxed))
+    {
+        #ifdef M_X86_Kernels
+            case IEInstructionSet::IE_IS_Avx2:  IAvx2::Aggregate (pValues, pValidity, count, low, high, aggregate); return;
+            case IEInstructionSet::IE_IS_Sse42: ISse42::Aggregate(pValues, pValidity, count, low, high, aggregate); return;
+        #endif
+
+        default: IScalar::Aggregate(pValues, pValidity, 0, count, low, high, aggregate); return;
+    }
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeKernels::Aggregate(const std::int8_t*   pValues,
+                                     const std::uint64_t* pValidity,
+                                           std::size_t    count,
+                                           double         low,
+                                           double         high,
+                                           IAggregate&    aggregate)
+{
+    Dispatch(pValues, pValidity, count, low, high, aggregate);
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeKernels::Aggregate(const std::uint8_t*  pValues,
+                                     const std::uint64_t* pValidity,
+                                           std::size_t    count,
+                                           double         low,
+                                           double         high,
+                                           IAggregate&    aggregate)
+{
+    Dispatch(pValues, pValidity, count, low, high, aggregate);
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeKernels::Aggregate(const std::int16_t*  pValues,
+                                     const std::uint64_t* pValidity,
+                                           std::size_t    count,
+                                           double         low,
+                                           double         high,
+                                           IAggregate&    aggregate)
+{
+    Dispatch(pValues, pValidity, count, low, high, aggregate);
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeKernels::Aggregate(const std::uint16_t* pValues,
+                                     const std::uint64_t* pValidity,
+                                           std::size_t    count,
+                                           double         low,
+                                           double         high,
+                                           IAggregate&    aggregate)
+{
+    Dispatch(pValues, pValidity, count, low, high, aggregate);
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeKernels::Aggregate(const std::int32_t*  pValues,
+                                     const std::uint64_t* pValidity,
+                                           std::size_t    count,
+                                           double         low,
+                                           double         high,
+                                           IAggregate&    aggregate)
+{
+    Dispatch(pValues, pValidity, count, low, high, aggregate);
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeKernels::Aggregate(const std::uint32_t* pValues,
+                                     const std::uint64_t* pValidity,
+                                           std::size_t    count,
+                                           double         low,
+                                           double         high,
+                                           IAggregate&    aggregate)
+{
+    // no unsigned 32 bit to double conversion before AVX-512
+    IScalar::Aggregate(pValues, pValidity, 0, count, low, high, aggregate);
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeKernels::Aggregate(const std::int64_t*  pValues,
+                                     const std::uint64_t* pValidity,
+                                           std::size_t    count,
+                                           double         low,
+                                           double         high,
+                                           IAggregate&    aggregate)
+{
+    // no 64 bit integer to double conversion before AVX-512
+    IScalar::Aggregate(pValues, pValidity, 0, count, low, high, aggregate);
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeKernels::Aggregate(const std::uint64_t* pValues,
+                                     const std::uint64_t* pValidity,
+                                           std::size_t    count,
+                                           double         low,
+                                           double         high,
+                                           IAggregate&    aggregate)
+{
+    // no 64 bit integer to double conversion before AVX-512
+    IScalar::Aggregate(pValues, pValidity, 0, count, low, high, aggregate);
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeKernels::Aggregate(const float*         pValues,
+                                     const std::uint64_t* pValidity,
+                                           std::size_t    count,
+                                           double         low,
+                                           double         high,
+                                           IAggregate&    aggregate)
+{
+    Dispatch(pValues, pValidity, count, low, high, aggregate);
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeKernels::Aggregate(const double*        pValues,
+                                     const std::uint64_t* pValidity,
+                                           std::size_t    count,
+                                           double         low,
+                                           double         high,
+                                           IAggregate&    aggregate)
+{
+    Dispatch(pValues, pValidity, count, low, high, aggregate);
+}
+//---------------------------------------------------------------------------
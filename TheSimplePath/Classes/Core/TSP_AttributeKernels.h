@@ -0,0 +1,167 @@
+/****************************************************************************
+ * ==> TSP_AttributeKernels ------------------------------------------------*
+ ****************************************************************************
+ * Description:  Vectorized aggregation kernels over attribute columns      *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+* Aggregation kernels over the dense numeric arrays of the attribute columns. The best instruction
+* set supported by the processor (AVX2, SSE4.2 or scalar code) is selected at runtime
+*@author Jean-Milost Reymond
+*/
+class TSP_AttributeKernels
+{
+    public:
+        /**
+        * Instruction set used by the kernels
+        */
+        enum class IEInstructionSet
+        {
+            IE_IS_Scalar = 0,
+            IE_IS_Sse42,
+            IE_IS_Avx2
+        };
+
+        /**
+        * Aggregated values
+        */
+        struct IAggregate
+        {
+            std::size_t m_Count = 0;
+            double      m_Sum   = 0.0;
+            double      m_Min   = 0.0;
+            double      m_Max   = 0.0;
+
+            /**
+            * Merges another aggregate into this one
+            *@param other - other aggregate to merge
+            */
+            inline void Merge(const IAggregate& other);
+        };
+
+        /**
+        * Gets the instruction set used by the kernels
+        *@return the instruction set
+        */
+        static IEInstructionSet GetInstructionSet();
+
+        /**
+        * Sets the instruction set used by the kernels
+        *@param instructionSet - instruction set to use
+        *@return the instruction set really used, which may be lower if the processor doesn't support the requested one
+        *@note Mainly useful to compare the kernels against each other
+        */
+        static IEInstructionSet SetInstructionSet(IEInstructionSet instructionSet);
+
+        /**
+        * Gets the best instruction set supported by the processor
+        *@return the best supported instruction set
+        */
+        static IEInstructionSet GetSupportedInstructionSet();
+
+        /**
+        * Aggregates the valid values contained in a range
+        *@param pValues - values
+        *@param pValidity - validity bitmap, the bit (i % 64) of the word (i / 64) is set if the value i is valid
+        *@param count - value count
+        *@param low - lowest value to aggregate
+        *@param high - highest value to aggregate
+        *@param[in, out] aggregate - aggregate in which the matching values are merged
+        *@note The NaN values never match
+        */
+        static void Aggregate(const std::int8_t*   pValues, const std::uint64_t* pValidity, std::size_t count,
+                              double low, double high, IAggregate& aggregate);
+        static void Aggregate(const std::uint8_t*  pValues, const std::uint64_t* pValidity, std::size_t count,
+                              double low, double high, IAggregate& aggregate);
+        static void Aggregate(const std::int16_t*  pValues, const std::uint64_t* pValidity, std::size_t count,
+                              double low, double high, IAggregate& aggregate);
+        static void Aggregate(const std::uint16_t* pValues, const std::uint64_t* pValidity, std::size_t count,
+                              double low, double high, IAggregate& aggregate);
+        static void Aggregate(const std::int32_t*  pValues, const std::uint64_t* pValidity, std::size_t count,
+                              double low, double high, IAggregate& aggregate);
+        static void Aggregate(const std::uint32_t* pValues, const std::uint64_t* pValidity, std::size_t count,
+                              double low, double high, IAggregate& aggregate);
+        static void Aggregate(const std::int64_t*  pValues, const std::uint64_t* pValidity, std::size_t count,
+                              double low, double high, IAggregate& aggregate);
+        static void Aggregate(const std::uint64_t* pValues, const std::uint64_t* pValidity, std::size_t count,
+                              double low, double high, IAggregate& aggregate);
+        static void Aggregate(const float*         pValues, const std::uint64_t* pValidity, std::size_t count,
+                              double low, double high, IAggregate& aggregate);
+        static void Aggregate(const double*        pValues, const std::uint64_t* pValidity, std::size_t count,
+                              double low, double high, IAggregate& aggregate);
+
+    private:
+        class IScalar;
+        class ISse42;
+        class IAvx2;
+
+        static std::atomic<IEInstructionSet> m_InstructionSet;
+
+        /**
+        * Runs the aggregation kernel matching with the selected instruction set
+        *@param pValues - values
+        *@param pValidity - validity bitmap
+        *@param count - value count
+        *@param low - lowest value to aggregate
+        *@param high - highest value to aggregate
+        *@param[in, out] aggregate - aggregate in which the matching values are merged
+        */
+        template <class T>
+        static void Dispatch(const T* pValues, const std::uint64_t* pValidity, std::size_t count,
+                             double low, double high, IAggregate& aggregate);
+};
+
+//---------------------------------------------------------------------------
+// TSP_AttributeKernels::IAggregate
+//---------------------------------------------------------------------------
+void TSP_AttributeKernels::IAggregate::Merge(const IAggregate& other)
+{
+    if (!other.m_Count)
+        return;
+
+    if (!m_Count)
+    {
+        *this = other;
+        return;
+    }
+
+    m_Count += other.m_Count;
+    m_Sum   += other.m_Sum;
+
+    if (other.m_Min < m_Min)
+        m_Min = other.m_Min;
+
+    if (other.m_Max > m_Max)
+        m_Max = other.m_Max;
+}
+//---------------------------------------------------------------------------
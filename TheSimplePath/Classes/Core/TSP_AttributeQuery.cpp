@@ -0,0 +1,112 @@
+/****************************************************************************
+ * ==> TSP_AttributeQuery --------------------------------------------------*
+ ****************************************************************************
+ * Description:  Parallel attribute queries over a set of pages             *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_AttributeQuery.h"
+
+// std
+#include <atomic>
+#include <limits>
+
+// common classes
+#include "Common\TSP_ThreadPool.h"
+
+// core classes
+#include "TSP_Page.h"
+
+//---------------------------------------------------------------------------
+// TSP_AttributeQuery
+//---------------------------------------------------------------------------
+TSP_AttributeStore::IAggregate TSP_AttributeQuery::Aggregate(const IPages& pages, TSP_Attribute::IEKey key)
+{
+    return Aggregate(pages,
+                     key,
+                     -std::numeric_limits<double>::infinity(),
+                      std::numeric_limits<double>::infinity());
+}
+//---------------------------------------------------------------------------
+TSP_AttributeStore::IAggregate TSP_AttributeQuery::Aggregate(const IPages&        pages,
+                                                             TSP_Attribute::IEKey key,
+                                                             double               low,
+                                                             double               high)
+{
+    IBlocks blocks;
+
+    // split the pages containing a value for the key in row blocks
+    for (std::size_t i = 0; i < pages.size(); ++i)
+    {
+        if (!pages[i])
+            continue;
+
+        const TSP_AttributeStore* pStore   = pages[i]->GetAttributes();
+        const std::size_t         rowCount = pStore->GetRowCount();
+
+        if (!pStore->GetValidity(key))
+            continue;
+
+        for (std::size_t firstRow = 0; firstRow < rowCount; firstRow += m_BlockSize)
+        {
+            IBlock block;
+            block.m_pStore   = pStore;
+            block.m_FirstRow = firstRow;
+            block.m_RowCount = rowCount - firstRow < m_BlockSize ? rowCount - firstRow : m_BlockSize;
+            blocks.push_back(block);
+        }
+    }
+
+    TSP_ThreadPool*   pPool     = TSP_ThreadPool::Instance();
+    const std::size_t poolSlots = pPool->GetSlotCount();
+    const std::size_t slotCount = blocks.size() < poolSlots ? blocks.size() : poolSlots;
+
+    std::vector<TSP_AttributeStore::IAggregate> results(slotCount ? slotCount : 1);
+    std::atomic<std::size_t>                    nextBlock(0);
+
+    // each slot takes the next free block, so a large page doesn't leave the other slots idle
+    pPool->Run([&](std::size_t slot)
+               {
+                   for (std::size_t index = nextBlock++; index < blocks.size(); index = nextBlock++)
+                   {
+                       const IBlock& block = blocks[index];
+
+                       results[slot].Merge(block.m_pStore->Aggregate(key,
+                                                                     low,
+                                                                     high,
+                                                                     block.m_FirstRow,
+                                                                     block.m_RowCount));
+                   }
+               },
+               slotCount);
+
+    TSP_AttributeStore::IAggregate aggregate;
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+        aggregate.Merge(results[i]);
+
+    return aggregate;
+}
+//---------------------------------------------------------------------------
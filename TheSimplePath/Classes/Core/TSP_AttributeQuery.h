@@ -0,0 +1,91 @@
+/****************************************************************************
+ * ==> TSP_AttributeQuery --------------------------------------------------*
+ ****************************************************************************
+ * Description:  Parallel attribute queries over a set of pages             *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <vector>
+
+// core classes
+#include "TSP_Attribute.h"
+#include "TSP_AttributeStore.h"
+
+// class prototypes
+class TSP_Page;
+
+/**
+* Attribute query, reduces the attribute columns of a set of pages. The pages are split in row
+* blocks, which are aggregated in parallel by the thread pool
+*@author Jean-Milost Reymond
+*/
+class TSP_AttributeQuery
+{
+    public:
+        typedef std::vector<const TSP_Page*> IPages;
+
+        /**
+        * Aggregates the values of a key over several pages
+        *@param pages - pages to aggregate
+        *@param key - attribute key
+        *@return the count of values, and for the numeric formats their sum, minimum and maximum
+        *@note The pages should not be modified while the query is running
+        */
+        static TSP_AttributeStore::IAggregate Aggregate(const IPages& pages, TSP_Attribute::IEKey key);
+
+        /**
+        * Aggregates the values of a key contained in a range over several pages
+        *@param pages - pages to aggregate
+        *@param key - attribute key
+        *@param low - lowest value to aggregate
+        *@param high - highest value to aggregate
+        *@return the count, sum, minimum and maximum of the values contained in the range
+        *@note The pages should not be modified while the query is running
+        */
+        static TSP_AttributeStore::IAggregate Aggregate(const IPages&        pages,
+                                                        TSP_Attribute::IEKey key,
+                                                        double               low,
+                                                        double               high);
+
+    private:
+        /**
+        * Row block, unit of work given to a thread
+        */
+        struct IBlock
+        {
+            const TSP_AttributeStore* m_pStore   = nullptr;
+            std::size_t               m_FirstRow = 0;
+            std::size_t               m_RowCount = 0;
+        };
+
+        typedef std::vector<IBlock> IBlocks;
+
+        // row count per block, a multiple of 64 to keep the blocks aligned on the validity words
+        static const std::size_t m_BlockSize = 65536;
+};
@@ -0,0 +1,93 @@
+/****************************************************************************
+ * ==> TSP_AttributeSchema -------------------------------------------------*
+ ****************************************************************************
+ * Description:  Declared format of each attribute key                      *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_AttributeSchema.h"
+
+//---------------------------------------------------------------------------
+// Static members
+//---------------------------------------------------------------------------
+const TSP_AttributeSchema::IDeclaration TSP_AttributeSchema::m_Declarations[] =
+{
+    {TSP_Attribute::IEKey::IE_K_Unknown,   TSP_Attribute::IEFormat::IE_Undefined,     L""},
+    {TSP_Attribute::IEKey::IE_K_Duration,  TSP_Attribute::IEFormat::IE_Double,        L"duration"},
+    {TSP_Attribute::IEKey::IE_K_Cost,      TSP_Attribute::IEFormat::IE_Double,        L"cost"},
+    {TSP_Attribute::IEKey::IE_K_Frequency, TSP_Attribute::IEFormat::IE_UInt32,        L"frequency"},
+    {TSP_Attribute::IEKey::IE_K_Resources, TSP_Attribute::IEFormat::IE_UInt32,        L"resources"},
+    {TSP_Attribute::IEKey::IE_K_Owner,     TSP_Attribute::IEFormat::IE_UnicodeString, L"owner"},
+    {TSP_Attribute::IEKey::IE_K_StartDate, TSP_Attribute::IEFormat::IE_DateTime,      L"start_date"}
+};
+//---------------------------------------------------------------------------
+// TSP_AttributeSchema
+//---------------------------------------------------------------------------
+TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormat(TSP_Attribute::IEKey key)
+{
+    if (!IsValid(key))
+        return TSP_Attribute::IEFormat::IE_Undefined;
+
+    return m_Declarations[(std::size_t)key].m_Format;
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_AttributeSchema::GetName(TSP_Attribute::IEKey key)
+{
+    if (!IsValid(key))
+        return L"";
+
+    return m_Declarations[(std::size_t)key].m_pName;
+}
+//---------------------------------------------------------------------------
+TSP_Attribute::IEKey TSP_AttributeSchema::Find(const std::wstring& name)
+{
+    for (std::size_t i = 1; i < (std::size_t)TSP_Attribute::IEKey::IE_K_Count; ++i)
+        if (name == m_Declarations[i].m_pName)
+            return m_Declarations[i].m_Key;
+
+    return TSP_Attribute::IEKey::IE_K_Unknown;
+}
+//---------------------------------------------------------------------------
+TSP_Attribute::IEKey TSP_AttributeSchema::Find(const char* pName, std::size_t length)
+{
+    if (!pName)
+        return TSP_Attribute::IEKey::IE_K_Unknown;
+
+    for (std::size_t i = 1; i < (std::size_t)TSP_Attribute::IEKey::IE_K_Count; ++i)
+    {
+        const wchar_t*    pDeclName = m_Declarations[i].m_pName;
+              std::size_t j         = 0;
+
+        // the declared names are ASCII, so they can be compared char by char
+        while (j < length && pDeclName[j] && pDeclName[j] == wchar_t((unsigned char)pName[j]))
+            ++j;
+
+        if (j == length && !pDeclName[j])
+            return m_Declarations[i].m_Key;
+    }
+
+    return TSP_Attribute::IEKey::IE_K_Unknown;
+}
+//---------------------------------------------------------------------------
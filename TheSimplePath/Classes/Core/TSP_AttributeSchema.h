@@ -0,0 +1,203 @@
+/****************************************************************************
+ * ==> TSP_AttributeSchema -------------------------------------------------*
+ ****************************************************************************
+ * Description:  Declared format of each attribute key                      *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+// core classes
+#include "TSP_Attribute.h"
+
+/**
+* Attribute schema, declares the format and name of each attribute key. All the values stored
+* under a key are converted to its declared format
+*@author Jean-Milost Reymond
+*/
+class TSP_AttributeSchema
+{
+    public:
+        /**
+        * Gets the format declared for a key
+        *@param key - attribute key
+        *@return the declared format, IE_Undefined if the key is unknown
+        */
+        static TSP_Attribute::IEFormat GetFormat(TSP_Attribute::IEKey key);
+
+        /**
+        * Gets the name of a key
+        *@param key - attribute key
+        *@return the key name, empty string if the key is unknown
+        */
+        static std::wstring GetName(TSP_Attribute::IEKey key);
+
+        /**
+        * Finds a key from its name
+        *@param name - key name
+        *@return the key, IE_K_Unknown if not found
+        */
+        static TSP_Attribute::IEKey Find(const std::wstring& name);
+
+        /**
+        * Finds a key from its name
+        *@param pName - key name, in UTF-8
+        *@param length - key name length, in chars
+        *@return the key, IE_K_Unknown if not found
+        *@note Allows to find a key from a parsed name, without converting it first
+        */
+        static TSP_Attribute::IEKey Find(const char* pName, std::size_t length);
+
+        /**
+        * Checks if a key is known by the schema
+        *@param key - attribute key
+        *@return true if the key is known, otherwise false
+        */
+        static inline bool IsValid(TSP_Attribute::IEKey key);
+
+        /**
+        * Gets the format matching with a value type
+        *@return the format, IE_Undefined if the type matches with no format
+        */
+        template <class T>
+        static inline TSP_Attribute::IEFormat GetFormatOf();
+
+    private:
+        /**
+        * Key declaration
+        */
+        struct IDeclaration
+        {
+            TSP_Attribute::IEKey    m_Key;
+            TSP_Attribute::IEFormat m_Format;
+            const wchar_t*          m_pName;
+        };
+
+        static const IDeclaration m_Declarations[(std::size_t)TSP_Attribute::IEKey::IE_K_Count];
+};
+
+//---------------------------------------------------------------------------
+// TSP_AttributeSchema
+//---------------------------------------------------------------------------
+bool TSP_AttributeSchema::IsValid(TSP_Attribute::IEKey key)
+{
+    return (key > TSP_Attribute::IEKey::IE_K_Unknown && key < TSP_Attribute::IEKey::IE_K_Count);
+}
+//---------------------------------------------------------------------------
+template <class T>
+TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf()
+{
+    return TSP_Attribute::IEFormat::IE_Undefined;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<bool>()
+{
+    return TSP_Attribute::IEFormat::IE_Bool;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<std::int8_t>()
+{
+    return TSP_Attribute::IEFormat::IE_Int8;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<std::uint8_t>()
+{
+    return TSP_Attribute::IEFormat::IE_UInt8;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<std::int16_t>()
+{
+    return TSP_Attribute::IEFormat::IE_Int16;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<std::uint16_t>()
+{
+    return TSP_Attribute::IEFormat::IE_UInt16;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<std::int32_t>()
+{
+    return TSP_Attribute::IEFormat::IE_Int32;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<std::uint32_t>()
+{
+    return TSP_Attribute::IEFormat::IE_UInt32;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<std::int64_t>()
+{
+    return TSP_Attribute::IEFormat::IE_Int64;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<std::uint64_t>()
+{
+    return TSP_Attribute::IEFormat::IE_UInt64;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<float>()
+{
+    return TSP_Attribute::IEFormat::IE_Float;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<double>()
+{
+    return TSP_Attribute::IEFormat::IE_Double;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<std::string>()
+{
+    return TSP_Attribute::IEFormat::IE_String;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<std::wstring>()
+{
+    return TSP_Attribute::IEFormat::IE_UnicodeString;
+}
+//---------------------------------------------------------------------------
+template <>
+inline TSP_Attribute::IEFormat TSP_AttributeSchema::GetFormatOf<std::tm>()
+{
+    return TSP_Attribute::IEFormat::IE_DateTime;
+}
+//---------------------------------------------------------------------------
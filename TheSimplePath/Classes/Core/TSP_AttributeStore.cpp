@@ -0,0 +1,472 @@
+/****************************************************************************
+ * ==> TSP_AttributeStore --------------------------------------------------*
+ ****************************************************************************
+ * Description:  Column-wise attribute storage of a page                    *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_AttributeStore.h"
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+//---------------------------------------------------------------------------
+// TSP_AttributeStore::IColumnOf
+//---------------------------------------------------------------------------
+/**
+* Typed column
+*@param T - value type, as read and written through the attributes
+*@param S - storage type
+*/
+template <class T, class S>
+class TSP_AttributeStore::IColumnOf : public TSP_AttributeStore::IColumn
+{
+    public:
+        IColumnOf();
+        virtual ~IColumnOf();
+
+        virtual void                    Resize(std::size_t count);
+        virtual void                    Reserve(std::size_t count);
+        virtual void                    Move(std::size_t from, std::size_t to);
+        virtual void                    Set(std::size_t row, const TSP_Attribute& value);
+        virtual bool                    Assign(const void* pValues, const std::uint64_t* pValidity);
+        virtual void                    Get(std::size_t row, TSP_Attribute& value) const;
+        virtual void                    Release(std::size_t row);
+        virtual const void*             GetData() const;
+        virtual void                    Aggregate(double      low,
+                                                  double      high,
+                                                  std::size_t firstRow,
+                                                  std::size_t rowCount,
+                                                  IAggregate& aggregate) const;
+        virtual TSP_Attribute::IEFormat GetDataFormat() const;
+
+    private:
+        std::vector<S> m_Values;
+
+        /**
+        * Copies the values of a numeric column
+        *@param pValues - value array
+        *@return true
+        */
+        bool AssignValues(const void* pValues, std::true_type);
+
+        /**
+        * Rejects the values of a non-numeric column, which cannot be copied as is
+        *@return false
+        */
+        bool AssignValues(const void*, std::false_type);
+
+        /**
+        * Aggregates the valid values of a numeric column
+        *@param low - lowest value to aggregate
+        *@param high - highest value to aggregate
+        *@param firstRow - first row to aggregate
+        *@param rowCount - row count to aggregate
+        *@param[in, out] aggregate - aggregate to complete
+        */
+        void AggregateValues(double          low,
+                             double          high,
+                             std::size_t     firstRow,
+                             std::size_t     rowCount,
+                             IAggregate&     aggregate,
+                             std::true_type) const;
+
+        /**
+        * Counts the valid values of a non-numeric column, the value range is ignored
+        *@param firstRow - first row to count
+        *@param rowCount - row count to count
+        *@param[in, out] aggregate - aggregate to complete
+        */
+        void AggregateValues(double,
+                             double,
+                             std::size_t     firstRow,
+                             std::size_t     rowCount,
+                             IAggregate&     aggregate,
+                             std::false_type) const;
+};
+//---------------------------------------------------------------------------
+template <class T, class S>
+TSP_AttributeStore::IColumnOf<T, S>::IColumnOf() :
+    IColumn()
+{}
+//---------------------------------------------------------------------------
+template <class T, class S>
+TSP_AttributeStore::IColumnOf<T, S>::~IColumnOf()
+{}
+//---------------------------------------------------------------------------
+template <class T, class S>
+void TSP_AttributeStore::IColumnOf<T, S>::Resize(std::size_t count)
+{
+    m_Values.resize(count);
+    m_Validity.resize((count + 63) >> 6, 0);
+
+    // clear the validity of the removed rows sharing the last word
+    if (count & 63)
+        m_Validity.back() &= (std::uint64_t(1) << (count & 63)) - 1;
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+void TSP_AttributeStore::IColumnOf<T, S>::Reserve(std::size_t count)
+{
+    m_Values.reserve(count);
+    m_Validity.reserve((count + 63) >> 6);
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+void TSP_AttributeStore::IColumnOf<T, S>::Move(std::size_t from, std::size_t to)
+{
+    m_Values[to] = std::move(m_Values[from]);
+    SetValid(to, IsValid(from));
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+void TSP_AttributeStore::IColumnOf<T, S>::Set(std::size_t row, const TSP_Attribute& value)
+{
+    m_Values[row] = S(value.Get<T>());
+    SetValid(row, true);
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+bool TSP_AttributeStore::IColumnOf<T, S>::Assign(const void* pValues, const std::uint64_t* pValidity)
+{
+    if (!AssignValues(pValues, std::is_arithmetic<S>()))
+        return false;
+
+    if (!m_Validity.empty())
+        std::memcpy(m_Validity.data(), pValidity, m_Validity.size() * sizeof(std::uint64_t));
+
+    // clear the bits after the last row, they are expected to be empty
+    if (m_Values.size() & 63)
+        m_Validity.back() &= (std::uint64_t(1) << (m_Values.size() & 63)) - 1;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+void TSP_AttributeStore::IColumnOf<T, S>::Get(std::size_t row, TSP_Attribute& value) const
+{
+    value.Set(T(m_Values[row]));
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+void TSP_AttributeStore::IColumnOf<T, S>::Release(std::size_t row)
+{
+    // the strings release their memory
+    m_Values[row] = S();
+    SetValid(row, false);
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+const void* TSP_AttributeStore::IColumnOf<T, S>::GetData() const
+{
+    return m_Values.data();
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+void TSP_AttributeStore::IColumnOf<T, S>::Aggregate(double      low,
+                                                    double      high,
+                                                    std::size_t firstRow,
+                                                    std::size_t rowCount,
+                                                    IAggregate& aggregate) const
+{
+    AggregateValues(low, high, firstRow, rowCount, aggregate, std::is_arithmetic<S>());
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+TSP_Attribute::IEFormat TSP_AttributeStore::IColumnOf<T, S>::GetDataFormat() const
+{
+    return TSP_AttributeSchema::GetFormatOf<S>();
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+bool TSP_AttributeStore::IColumnOf<T, S>::AssignValues(const void* pValues, std::true_type)
+{
+    if (!m_Values.empty())
+        std::memcpy(m_Values.data(), pValues, m_Values.size() * sizeof(S));
+
+    return true;
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+bool TSP_AttributeStore::IColumnOf<T, S>::AssignValues(const void*, std::false_type)
+{
+    return false;
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+void TSP_AttributeStore::IColumnOf<T, S>::AggregateValues(double          low,
+                                                          double          high,
+                                                          std::size_t     firstRow,
+                                                          std::size_t     rowCount,
+                                                          IAggregate&     aggregate,
+                                                          std::true_type) const
+{
+    const std::size_t offset = firstRow & 63;
+
+    // first row not aligned on a validity word? Aggregate the head rows apart, the kernels expect the
+    // validity bit of their first value to be the bit 0 of the first word, so shift a copy of it
+    if (offset)
+    {
+        const std::size_t   headCount = std::min<std::size_t>(rowCount, 64 - offset);
+        const std::uint64_t headWord  = m_Validity[firstRow >> 6] >> offset;
+
+        TSP_AttributeKernels::Aggregate(m_Values.data() + firstRow, &headWord, headCount, low, high, aggregate);
+
+        firstRow += headCount;
+        rowCount -= headCount;
+
+        if (!rowCount)
+            return;
+    }
+
+    TSP_AttributeKernels::Aggregate(m_Values.data()   +  firstRow,
+                                    m_Validity.data() + (firstRow >> 6),
+                                    rowCount,
+                                    low,
+                                    high,
+                                    aggregate);
+}
+//---------------------------------------------------------------------------
+template <class T, class S>
+void TSP_AttributeStore::IColumnOf<T, S>::AggregateValues(double,
+                                                          double,
+                                                          std::size_t     firstRow,
+                                                          std::size_t     rowCount,
+                                                          IAggregate&     aggregate,
+                                                          std::false_type) const
+{
+    IAggregate result;
+
+    for (std::size_t i = firstRow; i < firstRow + rowCount; ++i)
+        if (IsValid(i))
+            ++result.m_Count;
+
+    aggregate.Merge(result);
+}
+//---------------------------------------------------------------------------
+// TSP_AttributeStore::IColumn
+//---------------------------------------------------------------------------
+TSP_AttributeStore::IColumn::IColumn()
+{}
+//---------------------------------------------------------------------------
+TSP_AttributeStore::IColumn::~IColumn()
+{}
+//---------------------------------------------------------------------------
+// TSP_AttributeStore
+//---------------------------------------------------------------------------
+TSP_AttributeStore::TSP_AttributeStore()
+{}
+//---------------------------------------------------------------------------
+TSP_AttributeStore::~TSP_AttributeStore()
+{}
+//---------------------------------------------------------------------------
+std::size_t TSP_AttributeStore::AddRow()
+{
+    for (std::size_t i = 0; i < (std::size_t)TSP_Attribute::IEKey::IE_K_Count; ++i)
+        if (m_Columns[i])
+            m_Columns[i]->Resize(m_RowCount + 1);
+
+    return m_RowCount++;
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeStore::RemoveRow(std::size_t row)
+{
+    if (row >= m_RowCount)
+        return;
+
+    const std::size_t last = m_RowCount - 1;
+
+    for (std::size_t i = 0; i < (std::size_t)TSP_Attribute::IEKey::IE_K_Count; ++i)
+    {
+        if (!m_Columns[i])
+            continue;
+
+        // move the last row to the removed one place
+        if (row != last)
+            m_Columns[i]->Move(last, row);
+
+        m_Columns[i]->Resize(last);
+    }
+
+    --m_RowCount;
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeStore::Reserve(std::size_t count)
+{
+    if (count <= m_Capacity)
+        return;
+
+    for (std::size_t i = 0; i < (std::size_t)TSP_Attribute::IEKey::IE_K_Count; ++i)
+        if (m_Columns[i])
+            m_Columns[i]->Reserve(count);
+
+    m_Capacity = count;
+}
+//---------------------------------------------------------------------------
+bool TSP_AttributeStore::Set(std::size_t row, TSP_Attribute::IEKey key, const TSP_Attribute& value)
+{
+    if (row >= m_RowCount)
+        return false;
+
+    IColumn* pColumn = GetOrCreateColumn(key);
+
+    if (!pColumn)
+        return false;
+
+    pColumn->Set(row, value);
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_AttributeStore::SetColumn(TSP_Attribute::IEKey key, const void* pValues, const std::uint64_t* pValidity)
+{
+    if (!pValues || !pValidity)
+        return false;
+
+    IColumn* pColumn = GetOrCreateColumn(key);
+
+    if (!pColumn)
+        return false;
+
+    return pColumn->Assign(pValues, pValidity);
+}
+//---------------------------------------------------------------------------
+bool TSP_AttributeStore::Get(std::size_t row, TSP_Attribute::IEKey key, TSP_Attribute& value) const
+{
+    const IColumn* pColumn = GetColumn(key);
+
+    if (!pColumn || row >= m_RowCount || !pColumn->IsValid(row))
+        return false;
+
+    pColumn->Get(row, value);
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_AttributeStore::Has(std::size_t row, TSP_Attribute::IEKey key) const
+{
+    const IColumn* pColumn = GetColumn(key);
+
+    return (pColumn && row < m_RowCount && pColumn->IsValid(row));
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeStore::Reset(std::size_t row, TSP_Attribute::IEKey key)
+{
+    if (!Has(row, key))
+        return;
+
+    m_Columns[(std::size_t)key]->Release(row);
+}
+//---------------------------------------------------------------------------
+const std::uint64_t* TSP_AttributeStore::GetValidity(TSP_Attribute::IEKey key) const
+{
+    const IColumn* pColumn = GetColumn(key);
+
+    if (!pColumn)
+        return nullptr;
+
+    return pColumn->GetValidity();
+}
+//---------------------------------------------------------------------------
+TSP_AttributeStore::IAggregate TSP_AttributeStore::Aggregate(TSP_Attribute::IEKey key) const
+{
+    return Aggregate(key, -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+}
+//---------------------------------------------------------------------------
+TSP_AttributeStore::IAggregate TSP_AttributeStore::Aggregate(TSP_Attribute::IEKey key, double low, double high) const
+{
+    return Aggregate(key, low, high, 0, m_RowCount);
+}
+//---------------------------------------------------------------------------
+TSP_AttributeStore::IAggregate TSP_AttributeStore::Aggregate(TSP_Attribute::IEKey key,
+                                                             double               low,
+                                                             double               high,
+                                                             std::size_t          firstRow,
+                                                             std::size_t          rowCount) const
+{
+    IAggregate aggregate;
+
+    const IColumn* pColumn = GetColumn(key);
+
+    // no value, or rows out of bounds?
+    if (!pColumn || firstRow >= m_RowCount)
+        return aggregate;
+
+    if (rowCount > m_RowCount - firstRow)
+        rowCount = m_RowCount - firstRow;
+
+    pColumn->Aggregate(low, high, firstRow, rowCount, aggregate);
+
+    return aggregate;
+}
+//---------------------------------------------------------------------------
+TSP_AttributeStore::IColumn* TSP_AttributeStore::GetOrCreateColumn(TSP_Attribute::IEKey key)
+{
+    if (!TSP_AttributeSchema::IsValid(key))
+        return nullptr;
+
+    IColumnPtr& pSlot = m_Columns[(std::size_t)key];
+
+    if (pSlot)
+        return pSlot.get();
+
+    IColumnPtr pColumn;
+
+    switch (TSP_AttributeSchema::GetFormat(key))
+    {
+        case TSP_Attribute::IEFormat::IE_Bool:          pColumn.reset(new IColumnOf<bool,          std::uint8_t> ()); break;
+        case TSP_Attribute::IEFormat::IE_Int8:          pColumn.reset(new IColumnOf<std::int8_t,   std::int8_t>  ()); break;
+        case TSP_Attribute::IEFormat::IE_UInt8:         pColumn.reset(new IColumnOf<std::uint8_t,  std::uint8_t> ()); break;
+        case TSP_Attribute::IEFormat::IE_Int16:         pColumn.reset(new IColumnOf<std::int16_t,  std::int16_t> ()); break;
+        case TSP_Attribute::IEFormat::IE_UInt16:        pColumn.reset(new IColumnOf<std::uint16_t, std::uint16_t>()); break;
+        case TSP_Attribute::IEFormat::IE_Int32:         pColumn.reset(new IColumnOf<std::int32_t,  std::int32_t> ()); break;
+        case TSP_Attribute::IEFormat::IE_UInt32:        pColumn.reset(new IColumnOf<std::uint32_t, std::uint32_t>()); break;
+        case TSP_Attribute::IEFormat::IE_Int64:         pColumn.reset(new IColumnOf<std::int64_t,  std::int64_t> ()); break;
+        case TSP_Attribute::IEFormat::IE_UInt64:        pColumn.reset(new IColumnOf<std::uint64_t, std::uint64_t>()); break;
+        case TSP_Attribute::IEFormat::IE_Float:         pColumn.reset(new IColumnOf<float,         float>        ()); break;
+        case TSP_Attribute::IEFormat::IE_Double:        pColumn.reset(new IColumnOf<double,        double>       ()); break;
+        case TSP_Attribute::IEFormat::IE_String:        pColumn.reset(new IColumnOf<std::string,   std::string>  ()); break;
+        case TSP_Attribute::IEFormat::IE_UnicodeString: pColumn.reset(new IColumnOf<std::wstring,  std::wstring> ()); break;
+        case TSP_Attribute::IEFormat::IE_DateTime:      pColumn.reset(new IColumnOf<std::tm,       std::tm>      ()); break;
+        default:                                        return nullptr;
+    }
+
+    // size the column before publishing it, so the stored columns always contain all the rows
+    pColumn->Reserve(m_Capacity);
+    pColumn->Resize(m_RowCount);
+    pSlot = std::move(pColumn);
+
+    return pSlot.get();
+}
+//---------------------------------------------------------------------------
+const TSP_AttributeStore::IColumn* TSP_AttributeStore::GetColumn(TSP_Attribute::IEKey key) const
+{
+    if (!TSP_AttributeSchema::IsValid(key))
+        return nullptr;
+
+    return m_Columns[(std::size_t)key].get();
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,369 @@
+/****************************************************************************
+ * ==> TSP_AttributeStore --------------------------------------------------*
+ ****************************************************************************
+ * Description:  Column-wise attribute storage of a page                    *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// core classes
+#include "TSP_Attribute.h"
+#include "TSP_AttributeSchema.h"
+#include "TSP_AttributeKernels.h"
+
+/**
+* Column-wise attribute storage. Each row matches with a page component, and each attribute key
+* owns a column, which stores its values in a dense array of the key declared format, along with
+* a bitmap telling which rows contain a value. Aggregate queries may thus scan a typed array
+* instead of visiting every component
+*@author Jean-Milost Reymond
+*/
+class TSP_AttributeStore
+{
+    public:
+        /**
+        * Aggregated values of a column
+        */
+        typedef TSP_AttributeKernels::IAggregate IAggregate;
+
+        TSP_AttributeStore();
+        virtual ~TSP_AttributeStore();
+
+        /**
+        * Adds an empty row at the end of the store
+        *@return the row index
+        */
+        virtual std::size_t AddRow();
+
+        /**
+        * Removes a row
+        *@param row - row index to remove
+        *@note The last row is moved to the removed one place, in the same way the page moves its
+        *      last component, so a row index always matches with the container index of its component
+        */
+        virtual void RemoveRow(std::size_t row);
+
+        /**
+        * Reserves memory for a given row count
+        *@param count - row count to reserve for
+        *@note The columns created later are also reserved for this count
+        */
+        virtual void Reserve(std::size_t count);
+
+        /**
+        * Gets the row count
+        *@return the row count
+        */
+        virtual inline std::size_t GetRowCount() const;
+
+        /**
+        * Sets a value
+        *@param row - row index
+        *@param key - attribute key
+        *@param value - value to set, converted to the key declared format
+        *@return true on success, otherwise false
+        */
+        virtual bool Set(std::size_t row, TSP_Attribute::IEKey key, const TSP_Attribute& value);
+
+        /**
+        * Sets all the values of a key in one go
+        *@param key - attribute key
+        *@param pValues - value array, containing GetRowCount() values of the key declared format
+        *@param pValidity - validity bitmap, the bit (row % 64) of the word (row / 64) is set if the row
+        *                   contains a value
+        *@return true on success, false if the key is unknown or if its format isn't numeric
+        *@note The arrays are copied as is, allows to fill a store from a mapped file without converting
+        *      each value. Boolean values are read as bytes
+        */
+        virtual bool SetColumn(TSP_Attribute::IEKey key, const void* pValues, const std::uint64_t* pValidity);
+
+        /**
+        * Gets a value
+        *@param row - row index
+        *@param key - attribute key
+        *@param[out] value - the value, in the key declared format
+        *@return true on success, false if the row contains no value for the key
+        */
+        virtual bool Get(std::size_t row, TSP_Attribute::IEKey key, TSP_Attribute& value) const;
+
+        /**
+        * Checks if a row contains a value for a key
+        *@param row - row index
+        *@param key - attribute key
+        *@return true if the row contains a value, otherwise false
+        */
+        virtual bool Has(std::size_t row, TSP_Attribute::IEKey key) const;
+
+        /**
+        * Removes the value of a key from a row
+        *@param row - row index
+        *@param key - attribute key
+        */
+        virtual void Reset(std::size_t row, TSP_Attribute::IEKey key);
+
+        /**
+        * Gets the dense value array of a key
+        *@param key - attribute key
+        *@return the value array, containing GetRowCount() values, nullptr if no value was ever set for
+        *        the key or if T doesn't match with the key declared format
+        *@note The values of the rows without value are undefined, the validity bitmap should be checked.
+        *      Boolean columns are stored as bytes and are only available as std::uint8_t
+        */
+        template <class T>
+        const T* GetData(TSP_Attribute::IEKey key) const;
+
+        /**
+        * Gets the validity bitmap of a key
+        *@param key - attribute key
+        *@return the bitmap, the bit (row % 64) of the word (row / 64) is set if the row contains a value,
+        *        nullptr if no value was ever set for the key
+        */
+        virtual const std::uint64_t* GetValidity(TSP_Attribute::IEKey key) const;
+
+        /**
+        * Aggregates the values of a key
+        *@param key - attribute key
+        *@return the count of rows containing a value, and for the numeric formats their sum, minimum
+        *        and maximum
+        */
+        virtual IAggregate Aggregate(TSP_Attribute::IEKey key) const;
+
+        /**
+        * Aggregates the values of a key contained in a range
+        *@param key - attribute key
+        *@param low - lowest value to aggregate
+        *@param high - highest value to aggregate
+        *@return the count, sum, minimum and maximum of the values contained in the range
+        *@note The range is ignored for the non-numeric formats, whose values are only counted
+        */
+        virtual IAggregate Aggregate(TSP_Attribute::IEKey key, double low, double high) const;
+
+        /**
+        * Aggregates the values of a key contained in a range, for a range of rows
+        *@param key - attribute key
+        *@param low - lowest value to aggregate
+        *@param high - highest value to aggregate
+        *@param firstRow - first row to aggregate
+        *@param rowCount - row count to aggregate
+        *@return the count, sum, minimum and maximum of the values contained in the range
+        *@note Allows to split a large store between several threads. The rows are aggregated faster
+        *      if the first row is a multiple of 64
+        */
+        virtual IAggregate Aggregate(TSP_Attribute::IEKey key,
+                                     double               low,
+                                     double               high,
+                                     std::size_t          firstRow,
+                                     std::size_t          rowCount) const;
+
+    private:
+        /**
+        * Column, contains the values of a key for all the rows
+        */
+        class IColumn
+        {
+            public:
+                IColumn();
+                virtual ~IColumn();
+
+                /**
+                * Resizes the column, the added rows contain no value
+                *@param count - new row count
+                */
+                virtual void Resize(std::size_t count) = 0;
+
+                /**
+                * Reserves memory for a given row count
+                *@param count - row count to reserve for
+                */
+                virtual void Reserve(std::size_t count) = 0;
+
+                /**
+                * Moves a row to another row place
+                *@param from - row to move
+                *@param to - row to overwrite
+                */
+                virtual void Move(std::size_t from, std::size_t to) = 0;
+
+                /**
+                * Sets a value
+                *@param row - row index
+                *@param value - value to set, converted to the column format
+                */
+                virtual void Set(std::size_t row, const TSP_Attribute& value) = 0;
+
+                /**
+                * Copies all the values and their validity
+                *@param pValues - value array, containing a value for each row
+                *@param pValidity - validity bitmap
+                *@return true on success, false if the column format isn't numeric
+                */
+                virtual bool Assign(const void* pValues, const std::uint64_t* pValidity) = 0;
+
+                /**
+                * Gets a value
+                *@param row - row index
+                *@param[out] value - the value
+                */
+                virtual void Get(std::size_t row, TSP_Attribute& value) const = 0;
+
+                /**
+                * Releases the value of a row
+                *@param row - row index
+                */
+                virtual void Release(std::size_t row) = 0;
+
+                /**
+                * Gets the value array
+                *@return the value array
+                */
+                virtual const void* GetData() const = 0;
+
+                /**
+                * Aggregates the valid values contained in a range
+                *@param low - lowest value to aggregate
+                *@param high - highest value to aggregate
+                *@param firstRow - first row to aggregate, multiple of 64
+                *@param rowCount - row count to aggregate
+                *@param[in, out] aggregate - aggregate in which the values are merged
+                */
+                virtual void Aggregate(double      low,
+                                       double      high,
+                                       std::size_t firstRow,
+                                       std::size_t rowCount,
+                                       IAggregate& aggregate) const = 0;
+
+                /**
+                * Gets the format of the values array
+                *@return the format of the values array
+                */
+                virtual TSP_Attribute::IEFormat GetDataFormat() const = 0;
+
+                /**
+                * Checks if a row contains a value
+                *@param row - row index
+                *@return true if the row contains a value, otherwise false
+                */
+                inline bool IsValid(std::size_t row) const;
+
+                /**
+                * Sets if a row contains a value
+                *@param row - row index
+                *@param value - if true, the row contains a value
+                */
+                inline void SetValid(std::size_t row, bool value);
+
+                /**
+                * Gets the validity bitmap
+                *@return the validity bitmap
+                */
+                inline const std::uint64_t* GetValidity() const;
+
+            protected:
+                typedef std::vector<std::uint64_t> IBitmap;
+
+                IBitmap m_Validity;
+        };
+
+        template <class T, class S>
+        class IColumnOf;
+
+        typedef std::unique_ptr<IColumn> IColumnPtr;
+
+        IColumnPtr  m_Columns[(std::size_t)TSP_Attribute::IEKey::IE_K_Count];
+        std::size_t m_RowCount = 0;
+        std::size_t m_Capacity = 0;
+
+        /**
+        * Gets the column of a key, creates it if still not exists
+        *@param key - attribute key
+        *@return the column, nullptr if the key is unknown
+        */
+        IColumn* GetOrCreateColumn(TSP_Attribute::IEKey key);
+
+        /**
+        * Gets the column of a key
+        *@param key - attribute key
+        *@return the column, nullptr if the key is unknown or no value was ever set for it
+        */
+        const IColumn* GetColumn(TSP_Attribute::IEKey key) const;
+};
+
+//---------------------------------------------------------------------------
+// TSP_AttributeStore::IColumn
+//---------------------------------------------------------------------------
+bool TSP_AttributeStore::IColumn::IsValid(std::size_t row) const
+{
+    const std::size_t word = row >> 6;
+
+    if (word >= m_Validity.size())
+        return false;
+
+    return (m_Validity[word] >> (row & 63)) & 1;
+}
+//---------------------------------------------------------------------------
+void TSP_AttributeStore::IColumn::SetValid(std::size_t row, bool value)
+{
+    const std::uint64_t mask = std::uint64_t(1) << (row & 63);
+
+    if (value)
+        m_Validity[row >> 6] |= mask;
+    else
+        m_Validity[row >> 6] &= ~mask;
+}
+//---------------------------------------------------------------------------
+const std::uint64_t* TSP_AttributeStore::IColumn::GetValidity() const
+{
+    return m_Validity.data();
+}
+//---------------------------------------------------------------------------
+// TSP_AttributeStore
+//---------------------------------------------------------------------------
+std::size_t TSP_AttributeStore::GetRowCount() const
+{
+    return m_RowCount;
+}
+//---------------------------------------------------------------------------
+template <class T>
+const T* TSP_AttributeStore::GetData(TSP_Attribute::IEKey key) const
+{
+    const IColumn* pColumn = GetColumn(key);
+
+    if (!pColumn)
+        return nullptr;
+
+    // does the requested type match with the stored one?
+    if (pColumn->GetDataFormat() != TSP_AttributeSchema::GetFormatOf<T>())
+        return nullptr;
+
+    return static_cast<const T*>(pColumn->GetData());
+}
+//---------------------------------------------------------------------------
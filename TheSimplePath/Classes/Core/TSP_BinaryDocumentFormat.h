@@ -0,0 +1,269 @@
+/****************************************************************************
+ * ==> TSP_BinaryDocumentFormat --------------------------------------------*
+ ****************************************************************************
+ * Description:  Binary document file format                                *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+
+// core classes
+#include "TSP_Attribute.h"
+
+/**
+* Binary document file format. The file is designed to be mapped in memory and read in place, so
+* all its records have a fixed size and are aligned on 8 bytes, and all the references are offsets
+* counted from the file start. The file contains:
+* - a header
+* - for each atlas, a page table, and for each page its content: a component table, the attribute
+*   columns, stored as dense arrays of their declared format with a validity bitmap, and a formula table
+* - an atlas table
+* - a string table, containing all the names, texts and string values in UTF-8
+* A file may be updated in place: the modified page contents, followed by new page, atlas and string
+* tables, are appended to it, then its header is replaced. The unmodified page contents remain where
+* they are, and the new string table starts with the previous one, so their string indexes remain valid
+*@note The numbers are written in the platform byte order, which is little endian on all the supported
+*      platforms. A file written in another byte order is rejected, as its magic number doesn't match
+*@author Jean-Milost Reymond
+*/
+class TSP_BinaryDocumentFormat
+{
+    public:
+        static const std::uint32_t m_Magic     = 0x42505354; // "TSPB"
+        static const std::uint32_t m_Version   = 1;
+        static const std::size_t   m_Alignment = 8;
+
+        /**
+        * Page flags
+        */
+        enum class IEPageFlag : std::uint32_t
+        {
+            IE_PF_None     = 0x0,
+            IE_PF_Formulas = 0x1 // the page, or one of its sub-process pages, contains formulas
+        };
+
+        /**
+        * File header, located at the file start
+        */
+        struct IHeader
+        {
+            std::uint32_t m_Magic       = 0;
+            std::uint32_t m_Version     = 0;
+            std::uint64_t m_FileSize    = 0;
+            std::uint64_t m_Strings     = 0; // offset of the string table
+            std::uint64_t m_StringCount = 0;
+            std::uint64_t m_Atlases     = 0; // offset of the atlas table
+            std::uint64_t m_AtlasCount  = 0;
+            std::uint64_t m_Title       = 0; // string index
+            std::uint64_t m_BaseSize    = 0; // file size when last written in full, 0 if never updated
+        };
+
+        /**
+        * String table entry
+        */
+        struct IString
+        {
+            std::uint64_t m_Offset = 0;
+            std::uint64_t m_Length = 0; // in bytes
+        };
+
+        /**
+        * Atlas table entry
+        */
+        struct IAtlas
+        {
+            std::uint32_t m_Name      = 0; // string index
+            std::uint32_t m_Reserved  = 0;
+            std::uint64_t m_Pages     = 0; // offset of the page table
+            std::uint64_t m_PageCount = 0;
+        };
+
+        /**
+        * Page table entry
+        */
+        struct IPage
+        {
+            std::uint32_t m_Name    = 0; // string index
+            std::uint32_t m_Flags   = 0; // IEPageFlag combination
+            std::uint64_t m_Content = 0; // offset of the page content
+        };
+
+        /**
+        * Page content
+        */
+        struct IPageContent
+        {
+            std::uint64_t m_Components     = 0; // offset of the component table
+            std::uint64_t m_ComponentCount = 0;
+            std::uint64_t m_Columns        = 0; // offset of the column table
+            std::uint64_t m_ColumnCount    = 0;
+            std::uint64_t m_Formulas       = 0; // offset of the formula table
+            std::uint64_t m_FormulaCount   = 0;
+        };
+
+        /**
+        * Component table entry, the component index is also its attribute row
+        */
+        struct IComponent
+        {
+            std::uint32_t m_Type        = 0; // TSP_Item::IEType
+            std::uint32_t m_Title       = 0; // string index
+            std::uint32_t m_Description = 0; // string index
+            std::uint32_t m_Comments    = 0; // string index
+            std::uint32_t m_Start       = 0; // for links, start box index + 1, 0 if not attached
+            std::uint32_t m_StartSide   = 0; // TSP_LinkGraph::IESide
+            std::uint32_t m_End         = 0; // for links, end box index + 1, 0 if not attached
+            std::uint32_t m_EndSide     = 0; // TSP_LinkGraph::IESide
+            std::uint64_t m_Pages       = 0; // for processes, offset of the sub-page table
+            std::uint64_t m_PageCount   = 0;
+        };
+
+        /**
+        * Column table entry
+        *@note The values of the numeric formats are stored as is, the booleans as bytes, the strings as
+        *      32 bit string indexes and the dates as IDateTime
+        */
+        struct IColumn
+        {
+            std::uint32_t m_Name     = 0; // key name string index, the keys are found by name
+            std::uint32_t m_Format   = 0; // TSP_Attribute::IEFormat
+            std::uint64_t m_Validity = 0; // offset of the validity bitmap, one bit per row in 64 bit words
+            std::uint64_t m_Values   = 0; // offset of the value array, one value per row
+        };
+
+        /**
+        * Formula table entry
+        */
+        struct IFormula
+        {
+            std::uint64_t m_Component = 0; // component index
+            std::uint32_t m_Key       = 0; // key name string index
+            std::uint32_t m_Formula   = 0; // string index
+        };
+
+        /**
+        * Date and time value, contains the std::tm fields
+        */
+        struct IDateTime
+        {
+            std::int32_t m_Second   = 0;
+            std::int32_t m_Minute   = 0;
+            std::int32_t m_Hour     = 0;
+            std::int32_t m_Day      = 0;
+            std::int32_t m_Month    = 0;
+            std::int32_t m_Year     = 0;
+            std::int32_t m_WeekDay  = 0;
+            std::int32_t m_YearDay  = 0;
+            std::int32_t m_DST      = 0;
+            std::int32_t m_Reserved = 0;
+        };
+
+        /**
+        * Gets a page content handle
+        *@param offset - page content offset
+        *@param flags - page flags, IEPageFlag combination
+        *@return the page content handle
+        *@note The handle keeps the page content offset and its IE_PF_Formulas flag, in its lowest bit
+        *      which is always 0 in an aligned offset. This allows to reference an unmodified page
+        *      content while the file is updated, without reading it
+        */
+        static inline std::uint64_t ToHandle(std::uint64_t offset, std::uint32_t flags);
+
+        /**
+        * Gets the page content offset from its handle
+        *@param handle - page content handle
+        *@return the page content offset
+        */
+        static inline std::uint64_t GetContentOffset(std::uint64_t handle);
+
+        /**
+        * Gets the page flags from a page content handle
+        *@param handle - page content handle
+        *@return the page flags, IEPageFlag combination
+        */
+        static inline std::uint32_t GetPageFlags(std::uint64_t handle);
+
+        /**
+        * Gets the size of a value stored in a column
+        *@param format - value format
+        *@return the value size in bytes, 0 if the format cannot be stored in a column
+        */
+        static inline std::size_t GetValueSize(TSP_Attribute::IEFormat format);
+
+        static_assert(sizeof(IHeader)      == 64, "Unexpected binary document header size");
+        static_assert(sizeof(IString)      == 16, "Unexpected binary document string size");
+        static_assert(sizeof(IAtlas)       == 24, "Unexpected binary document atlas size");
+        static_assert(sizeof(IPage)        == 16, "Unexpected binary document page size");
+        static_assert(sizeof(IPageContent) == 48, "Unexpected binary document page content size");
+        static_assert(sizeof(IComponent)   == 48, "Unexpected binary document component size");
+        static_assert(sizeof(IColumn)      == 24, "Unexpected binary document column size");
+        static_assert(sizeof(IFormula)     == 16, "Unexpected binary document formula size");
+        static_assert(sizeof(IDateTime)    == 40, "Unexpected binary document date size");
+};
+
+//---------------------------------------------------------------------------
+// TSP_BinaryDocumentFormat
+//---------------------------------------------------------------------------
+std::uint64_t TSP_BinaryDocumentFormat::ToHandle(std::uint64_t offset, std::uint32_t flags)
+{
+    return offset | ((flags & std::uint32_t(IEPageFlag::IE_PF_Formulas)) ? 1 : 0);
+}
+//---------------------------------------------------------------------------
+std::uint64_t TSP_BinaryDocumentFormat::GetContentOffset(std::uint64_t handle)
+{
+    return handle & ~std::uint64_t(1);
+}
+//---------------------------------------------------------------------------
+std::uint32_t TSP_BinaryDocumentFormat::GetPageFlags(std::uint64_t handle)
+{
+    return (handle & 1) ? std::uint32_t(IEPageFlag::IE_PF_Formulas) : std::uint32_t(IEPageFlag::IE_PF_None);
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_BinaryDocumentFormat::GetValueSize(TSP_Attribute::IEFormat format)
+{
+    switch (format)
+    {
+        case TSP_Attribute::IEFormat::IE_Bool:
+        case TSP_Attribute::IEFormat::IE_Int8:
+        case TSP_Attribute::IEFormat::IE_UInt8:         return 1;
+        case TSP_Attribute::IEFormat::IE_Int16:
+        case TSP_Attribute::IEFormat::IE_UInt16:        return 2;
+        case TSP_Attribute::IEFormat::IE_Int32:
+        case TSP_Attribute::IEFormat::IE_UInt32:
+        case TSP_Attribute::IEFormat::IE_Float:
+        case TSP_Attribute::IEFormat::IE_String:
+        case TSP_Attribute::IEFormat::IE_UnicodeString: return 4;
+        case TSP_Attribute::IEFormat::IE_Int64:
+        case TSP_Attribute::IEFormat::IE_UInt64:
+        case TSP_Attribute::IEFormat::IE_Double:        return 8;
+        case TSP_Attribute::IEFormat::IE_DateTime:      return sizeof(IDateTime);
+        default:                                        return 0;
+    }
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,495 @@
+/****************************************************************************
+ * ==> TSP_BinaryDocumentReader --------------------------------------------*
+ ****************************************************************************
+ * Description:  Binary document reader                                     *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_BinaryDocumentReader.h"
+
+// std
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+// common classes
+#include "Common/TSP_StringHelper.h"
+#include "Common/TSP_Logger.h"
+#include "Common/TSP_ThreadPool.h"
+
+// core classes
+#include "TSP_Document.h"
+#include "TSP_Process.h"
+#include "TSP_AttributeSchema.h"
+#include "TSP_Calculator.h"
+
+//---------------------------------------------------------------------------
+// TSP_BinaryDocumentReader
+//---------------------------------------------------------------------------
+TSP_BinaryDocumentReader::TSP_BinaryDocumentReader(TSP_Document* pDocument) :
+    IContentSource(),
+    m_pDocument(pDocument)
+{}
+//---------------------------------------------------------------------------
+TSP_BinaryDocumentReader::~TSP_BinaryDocumentReader()
+{}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentReader::IsBinary(const void* pData, std::size_t size)
+{
+    if (!pData || size < sizeof(IFormat::IHeader))
+        return false;
+
+    std::uint32_t magic;
+    std::memcpy(&magic, pData, sizeof(std::uint32_t));
+
+    return (magic == IFormat::m_Magic);
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentReader::Open(std::unique_ptr<TSP_MappedFileBuffer> pFile)
+{
+    if (!m_pDocument || !OpenFile(std::move(pFile)))
+        return false;
+
+    const IFormat::IAtlas* pAtlases = GetArray<IFormat::IAtlas>(m_pHeader->m_Atlases, m_pHeader->m_AtlasCount);
+
+    if (!pAtlases)
+        return false;
+
+    m_pDocument->SetTitle(GetString(m_pHeader->m_Title));
+
+    // create the atlases and their pages, the page contents are read later
+    for (std::uint64_t i = 0; i < m_pHeader->m_AtlasCount; ++i)
+    {
+        TSP_Atlas* pAtlas = m_pDocument->CreateAndAddAtlas(GetString(pAtlases[i].m_Name));
+
+        if (!CreatePages(pAtlas, pAtlases[i].m_Pages, pAtlases[i].m_PageCount))
+            return false;
+    }
+
+    return ReadPending();
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentReader::OpenPages(std::unique_ptr<TSP_MappedFileBuffer> pFile, TSP_PageContainer* pContainer)
+{
+    if (!m_pDocument || !pContainer || !OpenFile(std::move(pFile)))
+        return false;
+
+    const IFormat::IAtlas* pAtlases = GetArray<IFormat::IAtlas>(m_pHeader->m_Atlases, m_pHeader->m_AtlasCount);
+
+    if (!pAtlases)
+        return false;
+
+    // add the pages of all the atlases to the container, the page contents are read later
+    for (std::uint64_t i = 0; i < m_pHeader->m_AtlasCount; ++i)
+        if (!CreatePages(pContainer, pAtlases[i].m_Pages, pAtlases[i].m_PageCount))
+            return false;
+
+    return ReadPending();
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentReader::ReadContent(TSP_Page* pPage, std::uint64_t handle)
+{
+    if (!pPage || !m_pHeader)
+        return false;
+
+    const IFormat::IPageContent* pContent = GetArray<IFormat::IPageContent>(IFormat::GetContentOffset(handle), 1);
+
+    if (!pContent)
+    {
+        M_LogCatErrorT(IO, L"Binary document - invalid page - " << pPage->GetName());
+        return false;
+    }
+
+    const IFormat::IComponent* pComponents = GetArray<IFormat::IComponent>(pContent->m_Components, pContent->m_ComponentCount);
+    const IFormat::IColumn*    pColumns    = GetArray<IFormat::IColumn>   (pContent->m_Columns,    pContent->m_ColumnCount);
+    const IFormat::IFormula*   pFormulas   = GetArray<IFormat::IFormula>  (pContent->m_Formulas,   pContent->m_FormulaCount);
+
+    if (!pComponents || !pColumns || !pFormulas)
+    {
+        M_LogCatErrorT(IO, L"Binary document - invalid page content - " << pPage->GetName());
+        return false;
+    }
+
+    const std::size_t count = std::size_t(pContent->m_ComponentCount);
+
+    std::vector<TSP_Component*> components;
+    components.reserve(count);
+
+    pPage->Reserve(count);
+
+    // create the components, in their container order, which is also their attribute row order
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const IFormat::IComponent& component   = pComponents[i];
+        const std::wstring         title       = GetString(component.m_Title);
+        const std::wstring         description = GetString(component.m_Description);
+        const std::wstring         comments    = GetString(component.m_Comments);
+
+        switch ((TSP_Item::IEType)component.m_Type)
+        {
+            case TSP_Item::IEType::IE_T_Box:
+                components.push_back(pPage->CreateAndAddBox(title, description, comments));
+                break;
+
+            case TSP_Item::IEType::IE_T_Process:
+            {
+                TSP_Process* pProcess = pPage->CreateAndAddProcess(title, description, comments);
+                components.push_back(pProcess);
+
+                if (!CreatePages(pProcess, component.m_Pages, component.m_PageCount))
+                    return false;
+
+                break;
+            }
+
+            case TSP_Item::IEType::IE_T_Activity:
+                components.push_back(pPage->CreateAndAddActivity(title, description, comments));
+                break;
+
+            case TSP_Item::IEType::IE_T_Link:
+                components.push_back(pPage->CreateAndAddLink(title, description, comments));
+                break;
+
+            case TSP_Item::IEType::IE_T_Message:
+                components.push_back(pPage->CreateAndAddMessage(title, description, comments));
+                break;
+
+            default:
+                M_LogCatErrorT(IO, L"Binary document - unknown component type - " << component.m_Type);
+                return false;
+        }
+    }
+
+    TSP_LinkGraph* pGraph = pPage->GetLinkGraph();
+
+    // attach the link ends, which are stored as box indexes
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const IFormat::IComponent& component = pComponents[i];
+
+        if (!component.m_Start && !component.m_End)
+            continue;
+
+        if (!components[i]->IsKindOf(TSP_Item::IEType::IE_T_Link) || component.m_Start > count || component.m_End > count)
+        {
+            M_LogCatErrorT(IO, L"Binary document - invalid link - " << pPage->GetName());
+            return false;
+        }
+
+        TSP_Component* pStart = component.m_Start ? components[component.m_Start - 1] : nullptr;
+        TSP_Component* pEnd   = component.m_End   ? components[component.m_End   - 1] : nullptr;
+
+        // the links may only be attached to boxes
+        if ((pStart && !pStart->IsKindOf(TSP_Item::IEType::IE_T_Box))                   ||
+            (pEnd   && !pEnd->IsKindOf(TSP_Item::IEType::IE_T_Box))                     ||
+            component.m_StartSide > std::uint32_t(TSP_LinkGraph::IESide::IE_S_Bottom) ||
+            component.m_EndSide   > std::uint32_t(TSP_LinkGraph::IESide::IE_S_Bottom))
+        {
+            M_LogCatErrorT(IO, L"Binary document - invalid link end - " << pPage->GetName());
+            return false;
+        }
+
+        if (pStart)
+            pGraph->SetStart(components[i]->GetUID(), pStart->GetUID(), (TSP_LinkGraph::IESide)component.m_StartSide);
+
+        if (pEnd)
+            pGraph->SetEnd(components[i]->GetUID(), pEnd->GetUID(), (TSP_LinkGraph::IESide)component.m_EndSide);
+    }
+
+    // read the attribute columns
+    for (std::uint64_t i = 0; i < pContent->m_ColumnCount; ++i)
+        if (!ReadColumn(pPage, pColumns[i], count))
+            return false;
+
+    // restore the formulas, their results were already read with the other values
+    for (std::uint64_t i = 0; i < pContent->m_FormulaCount; ++i)
+    {
+        const IFormat::IFormula& formula = pFormulas[i];
+        const char*              pName   = nullptr;
+        std::size_t              length  = 0;
+
+        if (formula.m_Component >= count || !GetString(formula.m_Key, pName, length))
+        {
+            M_LogCatErrorT(IO, L"Binary document - invalid formula - " << pPage->GetName());
+            return false;
+        }
+
+        const TSP_Attribute::IEKey key = TSP_AttributeSchema::Find(pName, length);
+
+        if (!TSP_Calculator::RestoreFormula(components[std::size_t(formula.m_Component)], key, GetString(formula.m_Formula)))
+            M_LogCatWarnT(IO, L"Binary document - could not restore formula - " << GetString(formula.m_Formula));
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentReader::ReadPages(const TSP_AttributeQuery::IPages& pages)
+{
+    TSP_ThreadPool*   pPool     = TSP_ThreadPool::Instance();
+    const std::size_t poolSlots = pPool->GetSlotCount();
+          std::size_t slotCount = pages.size() < poolSlots ? pages.size() : poolSlots;
+
+    // some documents should be filled on a single thread
+    if (!m_pDocument->CanReadPagesInParallel())
+        slotCount = 1;
+
+    std::atomic<std::size_t> nextPage(0);
+    std::atomic<bool>        success(true);
+
+    // each slot takes the next free page, so a large page doesn't leave the other slots idle. The calling
+    // thread also runs slots, so a single page never wakes a worker
+    pPool->Run([&](std::size_t)
+               {
+                   for (std::size_t index = nextPage++; index < pages.size(); index = nextPage++)
+                       if (pages[index] && !pages[index]->ReadContent())
+                           success = false;
+               },
+               slotCount);
+
+    // let the document complete the read pages on the calling thread, e.g. to create their views
+    m_pDocument->NotifyPagesRead(pages);
+
+    return success;
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentReader::OpenFile(std::unique_ptr<TSP_MappedFileBuffer> pFile)
+{
+    if (!pFile)
+        return false;
+
+    m_pFile   = std::move(pFile);
+    m_pData   = static_cast<const char*>(m_pFile->GetData());
+    m_Size    = m_pFile->GetSize();
+    m_pHeader = nullptr;
+    m_Pending.clear();
+
+    if (!IsBinary(m_pData, m_Size))
+        return false;
+
+    const IFormat::IHeader* pHeader = GetArray<IFormat::IHeader>(0, 1);
+
+    if (!pHeader)
+        return false;
+
+    // unknown version, or truncated file? NOTE the file may be longer than written, if an update
+    // failed before its header was replaced
+    if (pHeader->m_Version != IFormat::m_Version || pHeader->m_FileSize > m_Size)
+    {
+        M_LogCatErrorT(IO, L"Binary document - unsupported version or truncated file");
+        return false;
+    }
+
+    // keep a copy of the header, as it may be replaced while the document is updated in place. The
+    // data following the written content are ignored
+    m_Header = *pHeader;
+    m_Size   = std::size_t(m_Header.m_FileSize);
+
+    // the string table should be valid, as all the strings are read from it
+    if (!GetArray<IFormat::IString>(m_Header.m_Strings, m_Header.m_StringCount))
+        return false;
+
+    m_pHeader = &m_Header;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentReader::ReadPending()
+{
+    // read the pages containing formulas. NOTE this is required, as the formulas are registered in the
+    // calculator while read, and the calculator may itself access the pages which are still not read
+    // while it calculates. Their sub-process pages containing formulas are added to the pending list
+    // while they are read, so the pages are read level by level
+    while (!m_Pending.empty())
+    {
+        TSP_AttributeQuery::IPages pages;
+        pages.swap(m_Pending);
+
+        if (!ReadPages(pages))
+            return false;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentReader::GetString(std::uint64_t index, const char*& pStr, std::size_t& length) const
+{
+    if (index >= m_pHeader->m_StringCount)
+        return false;
+
+    // the string table was already checked while the file was opened
+    const IFormat::IString& str = reinterpret_cast<const IFormat::IString*>(m_pData + m_pHeader->m_Strings)[index];
+
+    if (str.m_Offset > m_Size || str.m_Length > m_Size - str.m_Offset)
+        return false;
+
+    pStr   = m_pData + str.m_Offset;
+    length = std::size_t(str.m_Length);
+
+    return true;
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_BinaryDocumentReader::GetString(std::uint64_t index) const
+{
+    const char* pStr   = nullptr;
+    std::size_t length = 0;
+
+    if (!GetString(index, pStr, length) || !length)
+        return L"";
+
+    std::wstring result;
+
+    if (!TSP_StringHelper::Utf8ToUtf16(pStr, length, result))
+        M_LogCatWarnT(IO, L"Binary document - invalid string - " << index);
+
+    return result;
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentReader::CreatePages(TSP_PageContainer* pContainer, std::uint64_t offset, std::uint64_t count)
+{
+    const IFormat::IPage* pPages = GetArray<IFormat::IPage>(offset, count);
+
+    if (!pPages)
+    {
+        M_LogCatErrorT(IO, L"Binary document - invalid page table");
+        return false;
+    }
+
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        TSP_Page* pPage = pContainer->CreateAndAddPage(GetString(pPages[i].m_Name));
+
+        pPage->SetContentSource(this, IFormat::ToHandle(pPages[i].m_Content, pPages[i].m_Flags));
+
+        // the pages containing formulas should be read while the document is opened
+        if (pPages[i].m_Flags & std::uint32_t(IFormat::IEPageFlag::IE_PF_Formulas))
+        {
+            // lock up the thread
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            m_Pending.push_back(pPage);
+        }
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentReader::ReadColumn(TSP_Page* pPage, const IFormat::IColumn& column, std::size_t rowCount)
+{
+    const char* pName  = nullptr;
+    std::size_t length = 0;
+
+    if (!GetString(column.m_Name, pName, length))
+        return false;
+
+    const TSP_Attribute::IEKey    key    = TSP_AttributeSchema::Find(pName, length);
+    const TSP_Attribute::IEFormat format = (TSP_Attribute::IEFormat)column.m_Format;
+
+    // unknown key, or key whose format changed since the file was written? Skip its values
+    if (key == TSP_Attribute::IEKey::IE_K_Unknown || TSP_AttributeSchema::GetFormat(key) != format)
+    {
+        M_LogCatWarnT(IO, L"Binary document - skipped attribute - " << GetString(column.m_Name));
+        return true;
+    }
+
+    const std::size_t    valueSize = IFormat::GetValueSize(format);
+    const std::uint64_t* pValidity = GetArray<std::uint64_t>(column.m_Validity, (rowCount + 63) >> 6);
+    const char*          pValues   = GetArray<char>(column.m_Values, std::uint64_t(rowCount) * valueSize);
+
+    if (!valueSize || !pValidity || !pValues)
+        return false;
+
+    TSP_AttributeStore* pStore = pPage->GetAttributes();
+
+    switch (format)
+    {
+        case TSP_Attribute::IEFormat::IE_String:
+        case TSP_Attribute::IEFormat::IE_UnicodeString:
+        {
+            const std::uint32_t* pIndexes = GetArray<std::uint32_t>(column.m_Values, rowCount);
+
+            if (!pIndexes)
+                return false;
+
+            for (std::size_t i = 0; i < rowCount; ++i)
+            {
+                if (!((pValidity[i >> 6] >> (i & 63)) & 1))
+                    continue;
+
+                // the UTF-8 strings are stored as is
+                if (format == TSP_Attribute::IEFormat::IE_String)
+                {
+                    const char* pStr   = nullptr;
+                    std::size_t strLen = 0;
+
+                    if (!GetString(pIndexes[i], pStr, strLen))
+                        return false;
+
+                    pStore->Set(i, key, TSP_Attribute(std::string(pStr, strLen)));
+                }
+                else
+                    pStore->Set(i, key, TSP_Attribute(GetString(pIndexes[i])));
+            }
+
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_DateTime:
+        {
+            const IFormat::IDateTime* pDates = GetArray<IFormat::IDateTime>(column.m_Values, rowCount);
+
+            if (!pDates)
+                return false;
+
+            for (std::size_t i = 0; i < rowCount; ++i)
+            {
+                if (!((pValidity[i >> 6] >> (i & 63)) & 1))
+                    continue;
+
+                std::tm dateTime = {};
+                dateTime.tm_sec   = pDates[i].m_Second;
+                dateTime.tm_min   = pDates[i].m_Minute;
+                dateTime.tm_hour  = pDates[i].m_Hour;
+                dateTime.tm_mday  = pDates[i].m_Day;
+                dateTime.tm_mon   = pDates[i].m_Month;
+                dateTime.tm_year  = pDates[i].m_Year;
+                dateTime.tm_wday  = pDates[i].m_WeekDay;
+                dateTime.tm_yday  = pDates[i].m_YearDay;
+                dateTime.tm_isdst = pDates[i].m_DST;
+
+                pStore->Set(i, key, TSP_Attribute(dateTime));
+            }
+
+            return true;
+        }
+
+        default:
+            // the numeric values are copied as is, without being converted
+            if (std::uint64_t(pValues - m_pData) % valueSize)
+                return false;
+
+            return pStore->SetColumn(key, pValues, pValidity);
+    }
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,202 @@
+/****************************************************************************
+ * ==> TSP_BinaryDocumentReader --------------------------------------------*
+ ****************************************************************************
+ * Description:  Binary document reader                                     *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// common classes
+#include "Common/TSP_MappedFileBuffer.h"
+
+// core classes
+#include "TSP_Page.h"
+#include "TSP_AttributeQuery.h"
+#include "TSP_BinaryDocumentFormat.h"
+
+// class prototypes
+class TSP_Document;
+class TSP_PageContainer;
+
+/**
+* Binary document reader, opens a document written in the binary format (see TSP_BinaryDocumentFormat)
+*@note The file is mapped in memory and read in place. While opened, only the atlases and their page
+*      list are created, each page content is read the first time the page is accessed. The pages
+*      containing formulas are read immediately, as the formulas depend on each other between pages.
+*      Each page content is a separate section of the file, so several pages may be read in parallel
+*@author Jean-Milost Reymond
+*/
+class TSP_BinaryDocumentReader : public TSP_Page::IContentSource
+{
+    public:
+        /**
+        * Constructor
+        *@param pDocument - document to fill, should be empty
+        */
+        TSP_BinaryDocumentReader(TSP_Document* pDocument);
+
+        /**
+        * Destructor
+        *@note The document pages still not read will remain empty, so the reader should be kept alive
+        *      as long as the document is opened
+        */
+        virtual ~TSP_BinaryDocumentReader();
+
+        /**
+        * Checks if a content is a binary document
+        *@param pData - content
+        *@param size - content size, in bytes
+        *@return true if the content starts with a binary document header, otherwise false
+        */
+        static bool IsBinary(const void* pData, std::size_t size);
+
+        /**
+        * Opens a document
+        *@param pFile - mapped document file, the reader takes its ownership
+        *@return true on success, otherwise false
+        */
+        virtual bool Open(std::unique_ptr<TSP_MappedFileBuffer> pFile);
+
+        /**
+        * Opens a document and adds its pages to a container of the document to fill
+        *@param pFile - mapped document file, the reader takes its ownership
+        *@param pContainer - container to add the pages to
+        *@return true on success, otherwise false
+        *@note The title and atlases of the opened document are ignored, its pages are added in their
+        *      atlas order. This allows to build a document from pages stored in separate files
+        */
+        virtual bool OpenPages(std::unique_ptr<TSP_MappedFileBuffer> pFile, TSP_PageContainer* pContainer);
+
+        /**
+        * Reads a page content
+        *@param pPage - page to fill, still empty
+        *@param handle - page content handle, see TSP_BinaryDocumentFormat::ToHandle()
+        *@return true on success, otherwise false
+        *@note Called by the page, the first time it is accessed. May be called from any thread
+        */
+        virtual bool ReadContent(TSP_Page* pPage, std::uint64_t handle);
+
+        /**
+        * Reads several pages
+        *@param pages - pages to read, the pages already read are skipped
+        *@return true on success, otherwise false
+        *@note The pages are read in parallel if the document allows it, each page is filled by a single
+        *      thread and its components are allocated in its own arena. The sub-process pages found while
+        *      reading aren't read
+        */
+        virtual bool ReadPages(const TSP_AttributeQuery::IPages& pages);
+
+    private:
+        typedef TSP_BinaryDocumentFormat IFormat;
+
+        TSP_Document*                         m_pDocument = nullptr;
+        std::unique_ptr<TSP_MappedFileBuffer> m_pFile;
+        const char*                           m_pData     = nullptr;
+        std::size_t                           m_Size      = 0;
+        IFormat::IHeader                      m_Header;
+        const IFormat::IHeader*               m_pHeader   = nullptr;
+        TSP_AttributeQuery::IPages            m_Pending;
+        std::mutex                            m_Mutex;
+
+        /**
+        * Gets a record array from the file
+        *@param offset - array offset
+        *@param count - record count
+        *@return the array, nullptr if it exceeds the file or isn't aligned
+        */
+        template <class T>
+        const T* GetArray(std::uint64_t offset, std::uint64_t count) const;
+
+        /**
+        * Maps the file and checks its header
+        *@param pFile - mapped document file, the reader takes its ownership
+        *@return true on success, otherwise false
+        */
+        bool OpenFile(std::unique_ptr<TSP_MappedFileBuffer> pFile);
+
+        /**
+        * Reads the pending pages, which contain formulas
+        *@return true on success, otherwise false
+        */
+        bool ReadPending();
+
+        /**
+        * Gets a string from the string table
+        *@param index - string index
+        *@param[out] pStr - string chars, in UTF-8 and not null terminated
+        *@param[out] length - string length, in bytes
+        *@return true on success, otherwise false
+        */
+        bool GetString(std::uint64_t index, const char*& pStr, std::size_t& length) const;
+
+        /**
+        * Gets a string from the string table
+        *@param index - string index
+        *@return the string, empty string if not found
+        */
+        std::wstring GetString(std::uint64_t index) const;
+
+        /**
+        * Creates the pages of a container, the pages are read when first accessed
+        *@param pContainer - container to add the pages to
+        *@param offset - page table offset
+        *@param count - page count
+        *@return true on success, otherwise false
+        *@note The pages containing formulas are added to the pending list, and are read before the
+        *      document is opened
+        */
+        bool CreatePages(TSP_PageContainer* pContainer, std::uint64_t offset, std::uint64_t count);
+
+        /**
+        * Reads an attribute column
+        *@param pPage - page owning the column
+        *@param column - column table entry
+        *@param rowCount - row count
+        *@return true on success, otherwise false
+        */
+        bool ReadColumn(TSP_Page* pPage, const IFormat::IColumn& column, std::size_t rowCount);
+};
+
+//---------------------------------------------------------------------------
+// TSP_BinaryDocumentReader
+//---------------------------------------------------------------------------
+template <class T>
+const T* TSP_BinaryDocumentReader::GetArray(std::uint64_t offset, std::uint64_t count) const
+{
+    // is array out of bounds, or not aligned?
+    if (offset > m_Size || count > (m_Size - offset) / sizeof(T) || offset % alignof(T))
+        return nullptr;
+
+    return reinterpret_cast<const T*>(m_pData + offset);
+}
+//---------------------------------------------------------------------------
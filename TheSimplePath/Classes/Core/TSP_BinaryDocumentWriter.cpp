@@ -0,0 +1,593 @@
+/****************************************************************************
+ * ==> TSP_BinaryDocumentWriter --------------------------------------------*
+ ****************************************************************************
+ * Description:  Binary document writer                                     *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_BinaryDocumentWriter.h"
+
+// std
+#include <cstring>
+
+// common classes
+#include "Common/TSP_StringHelper.h"
+
+// core classes
+#include "TSP_Document.h"
+#include "TSP_Process.h"
+#include "TSP_AttributeSchema.h"
+#include "TSP_Calculator.h"
+
+//---------------------------------------------------------------------------
+// TSP_BinaryDocumentWriter
+//---------------------------------------------------------------------------
+TSP_BinaryDocumentWriter::TSP_BinaryDocumentWriter(TSP_Buffer* pBuffer) :
+    m_pBuffer(pBuffer)
+{}
+//---------------------------------------------------------------------------
+TSP_BinaryDocumentWriter::~TSP_BinaryDocumentWriter()
+{}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentWriter::Write(const TSP_Document* pDocument)
+{
+    if (!pDocument || !m_pBuffer)
+        return false;
+
+    IFormat::IHeader header;
+    Begin(header, pDocument->GetTitle());
+
+    std::vector<IFormat::IAtlas> atlases;
+    WriteAtlases(pDocument, atlases);
+
+    return End(header, atlases);
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentWriter::Write(const TSP_Page* pPage)
+{
+    if (!pPage || !m_pBuffer)
+        return false;
+
+    IFormat::IHeader header;
+    Begin(header, L"");
+
+    IFormat::IPage page;
+    page.m_Name    = AddString(pPage->GetName());
+    page.m_Content = WritePage(pPage, page.m_Flags);
+
+    // the page is contained in a single unnamed atlas
+    std::vector<IFormat::IAtlas> atlases(1);
+    atlases[0].m_Name      = AddString(L"");
+    atlases[0].m_Pages     = Align();
+    atlases[0].m_PageCount = 1;
+
+    WriteData(&page, sizeof(IFormat::IPage));
+
+    return End(header, atlases);
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentWriter::Update(const TSP_Document*                      pDocument,
+                                      const void*                              pData,
+                                            std::size_t                        size,
+                                            std::uint64_t&                     offset,
+                                            TSP_BinaryDocumentFormat::IHeader& header)
+{
+    if (!pDocument || !m_pBuffer || !pData || size < sizeof(IFormat::IHeader))
+        return false;
+
+    IFormat::IHeader current;
+    std::memcpy(&current, pData, sizeof(IFormat::IHeader));
+
+    // not a binary document, or invalid header?
+    if (current.m_Magic    != IFormat::m_Magic                                                   ||
+        current.m_Version  != IFormat::m_Version                                                 ||
+        current.m_FileSize >  size                                                               ||
+        current.m_Strings  >  current.m_FileSize                                                 ||
+        current.m_Strings  %  IFormat::m_Alignment                                               ||
+        current.m_StringCount > (current.m_FileSize - current.m_Strings) / sizeof(IFormat::IString))
+        return false;
+
+    const std::uint64_t baseSize = current.m_BaseSize ? current.m_BaseSize : current.m_FileSize;
+
+    // the file grew too much since it was written in full? It should be written again, to release the
+    // page contents which were replaced since
+    if (current.m_FileSize > baseSize * m_MaxGrowth)
+        return false;
+
+    Reset();
+
+    // the new content is appended after the current one. NOTE the remains of a failed update, which
+    // may follow it, are overwritten
+    m_Offset          = current.m_FileSize;
+    m_pBaseStrings    = reinterpret_cast<const IFormat::IString*>(static_cast<const char*>(pData) + current.m_Strings);
+    m_BaseStringCount = current.m_StringCount;
+    m_Update          = true;
+
+    header.m_Magic    = IFormat::m_Magic;
+    header.m_Version  = IFormat::m_Version;
+    header.m_BaseSize = baseSize;
+    header.m_Title    = AddString(pDocument->GetTitle());
+
+    offset = m_Offset;
+
+    std::vector<IFormat::IAtlas> atlases;
+    WriteAtlases(pDocument, atlases);
+
+    const bool success = WriteTables(header, atlases);
+
+    // the current file content is no longer required
+    m_pBaseStrings    = nullptr;
+    m_BaseStringCount = 0;
+    m_Update          = false;
+
+    return success;
+}
+//---------------------------------------------------------------------------
+void TSP_BinaryDocumentWriter::Reset()
+{
+    m_Cache.clear();
+    m_Cache.reserve(m_CacheSize);
+    m_Strings.clear();
+    m_StringIndexes.clear();
+    m_PageHandles.clear();
+    m_pBaseStrings    = nullptr;
+    m_BaseStringCount = 0;
+    m_Offset          = 0;
+    m_Update          = false;
+    m_Failed          = false;
+}
+//---------------------------------------------------------------------------
+void TSP_BinaryDocumentWriter::Begin(IFormat::IHeader& header, const std::wstring& title)
+{
+    Reset();
+
+    header.m_Magic   = IFormat::m_Magic;
+    header.m_Version = IFormat::m_Version;
+    header.m_Title   = AddString(title);
+
+    // reserve the header place, it is written once all the offsets are known
+    WriteData(&header, sizeof(IFormat::IHeader));
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentWriter::End(IFormat::IHeader& header, const std::vector<IFormat::IAtlas>& atlases)
+{
+    if (!WriteTables(header, atlases))
+        return false;
+
+    // write the completed header
+    m_pBuffer->Seek(0, 0);
+
+    return (m_pBuffer->Write(&header, sizeof(IFormat::IHeader)) == sizeof(IFormat::IHeader));
+}
+//---------------------------------------------------------------------------
+void TSP_BinaryDocumentWriter::WriteAtlases(const TSP_Document* pDocument, std::vector<IFormat::IAtlas>& atlases)
+{
+    const std::size_t atlasCount = pDocument->GetAtlasCount();
+
+    atlases.resize(atlasCount);
+
+    // write the atlas pages
+    for (std::size_t i = 0; i < atlasCount; ++i)
+    {
+        const TSP_Atlas* pAtlas = pDocument->GetAtlas(i);
+        std::uint32_t    flags  = 0;
+
+        atlases[i].m_Name      = AddString(pAtlas->GetName());
+        atlases[i].m_Pages     = WritePages(pAtlas, flags);
+        atlases[i].m_PageCount = pAtlas->GetPageCount();
+    }
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentWriter::WriteTables(IFormat::IHeader& header, const std::vector<IFormat::IAtlas>& atlases)
+{
+    // write the atlas table
+    header.m_Atlases    = Align();
+    header.m_AtlasCount = atlases.size();
+
+    if (!atlases.empty())
+        WriteData(atlases.data(), atlases.size() * sizeof(IFormat::IAtlas));
+
+    WriteStrings(header);
+
+    header.m_FileSize = m_Offset;
+
+    Flush();
+
+    return !m_Failed;
+}
+//---------------------------------------------------------------------------
+std::uint32_t TSP_BinaryDocumentWriter::AddString(const std::string& str)
+{
+    IStringIndexes::const_iterator it = m_StringIndexes.find(str);
+
+    if (it != m_StringIndexes.end())
+        return it->second;
+
+    // while a file is updated, the new strings follow the strings it already contains
+    const std::uint32_t index = std::uint32_t(m_BaseStringCount + m_Strings.size());
+
+    m_Strings.push_back(str);
+    m_StringIndexes[str] = index;
+
+    return index;
+}
+//---------------------------------------------------------------------------
+std::uint32_t TSP_BinaryDocumentWriter::AddString(const std::wstring& str)
+{
+    return AddString(TSP_StringHelper::Utf16ToUtf8(str));
+}
+//---------------------------------------------------------------------------
+std::uint64_t TSP_BinaryDocumentWriter::WriteData(const void* pData, std::size_t size)
+{
+    const std::uint64_t offset = m_Offset;
+
+    m_Offset += size;
+
+    // not enough space in the cache? Write it first
+    if (m_Cache.size() + size > m_CacheSize)
+        Flush();
+
+    // large data is written directly
+    if (size > m_CacheSize)
+    {
+        if (m_pBuffer->Write(pData, size) != size)
+            m_Failed = true;
+
+        return offset;
+    }
+
+    const char* pChars = static_cast<const char*>(pData);
+    m_Cache.insert(m_Cache.end(), pChars, pChars + size);
+
+    return offset;
+}
+//---------------------------------------------------------------------------
+std::uint64_t TSP_BinaryDocumentWriter::Align()
+{
+    static const char padding[IFormat::m_Alignment] = {0};
+
+    const std::size_t remaining = std::size_t(m_Offset % IFormat::m_Alignment);
+
+    if (remaining)
+        WriteData(padding, IFormat::m_Alignment - remaining);
+
+    return m_Offset;
+}
+//---------------------------------------------------------------------------
+void TSP_BinaryDocumentWriter::Flush()
+{
+    if (m_Cache.empty())
+        return;
+
+    if (m_pBuffer->Write(m_Cache.data(), m_Cache.size()) != m_Cache.size())
+        m_Failed = true;
+
+    m_Cache.clear();
+}
+//---------------------------------------------------------------------------
+std::uint64_t TSP_BinaryDocumentWriter::WritePages(const TSP_PageContainer* pContainer, std::uint32_t& flags)
+{
+    const std::size_t           pageCount = pContainer->GetPageCount();
+    std::vector<IFormat::IPage> pages(pageCount);
+
+    flags = std::uint32_t(IFormat::IEPageFlag::IE_PF_None);
+
+    for (std::size_t i = 0; i < pageCount; ++i)
+    {
+        const TSP_Page*     pPage  = pContainer->GetPage(i);
+        const std::uint64_t handle = pPage->GetContentHandle();
+
+        pages[i].m_Name = AddString(pPage->GetName());
+
+        // unmodified page, already contained in the updated file? NOTE its content is referenced
+        // without being read, and its sub-process pages are also unmodified
+        if (m_Update && handle && !pPage->IsModified())
+        {
+            pages[i].m_Content = IFormat::GetContentOffset(handle);
+            pages[i].m_Flags   = IFormat::GetPageFlags(handle);
+        }
+        else
+        {
+            pages[i].m_Content = WritePage(pPage, pages[i].m_Flags);
+
+            TSP_Document::IPageHandle pageHandle;
+            pageHandle.m_UID    = pPage->GetUID();
+            pageHandle.m_Handle = IFormat::ToHandle(pages[i].m_Content, pages[i].m_Flags);
+
+            m_PageHandles.push_back(pageHandle);
+        }
+
+        flags |= pages[i].m_Flags;
+    }
+
+    const std::uint64_t offset = Align();
+
+    if (pageCount)
+        WriteData(pages.data(), pageCount * sizeof(IFormat::IPage));
+
+    return offset;
+}
+//---------------------------------------------------------------------------
+std::uint64_t TSP_BinaryDocumentWriter::WritePage(const TSP_Page* pPage, std::uint32_t& flags)
+{
+    const std::size_t                count  = pPage->GetCount();
+    const TSP_LinkGraph*             pGraph = pPage->GetLinkGraph();
+    std::vector<IFormat::IComponent> components(count);
+
+    flags = std::uint32_t(IFormat::IEPageFlag::IE_PF_None);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const TSP_Component* pComponent = pPage->GetAt(i);
+        IFormat::IComponent& component  = components[i];
+
+        component.m_Type        = std::uint32_t(pComponent->GetType());
+        component.m_Title       = AddString(pComponent->GetTitle());
+        component.m_Description = AddString(pComponent->GetDescription());
+        component.m_Comments    = AddString(pComponent->GetComments());
+
+        // the process pages are written before the page referencing them
+        if (pComponent->IsKindOf(TSP_Item::IEType::IE_T_Process))
+        {
+            const TSP_Process* pProcess     = static_cast<const TSP_Process*>(pComponent);
+            std::uint32_t      processFlags = 0;
+
+            component.m_Pages     = WritePages(pProcess, processFlags);
+            component.m_PageCount = pProcess->GetPageCount();
+
+            flags |= processFlags;
+        }
+        else
+        if (pComponent->IsKindOf(TSP_Item::IEType::IE_T_Link))
+        {
+            TSP_Item::IUID        box  = 0;
+            TSP_LinkGraph::IESide side = TSP_LinkGraph::IESide::IE_S_None;
+
+            // the link ends are stored as box indexes, the uids aren't kept between sessions
+            if (pGraph->GetStart(pComponent->GetUID(), box, side))
+            {
+                const TSP_Component* pBox = pPage->Get(box);
+
+                if (pBox)
+                {
+                    component.m_Start     = std::uint32_t(pBox->GetContainerIndex() + 1);
+                    component.m_StartSide = std::uint32_t(side);
+                }
+            }
+
+            if (pGraph->GetEnd(pComponent->GetUID(), box, side))
+            {
+                const TSP_Component* pBox = pPage->Get(box);
+
+                if (pBox)
+                {
+                    component.m_End     = std::uint32_t(pBox->GetContainerIndex() + 1);
+                    component.m_EndSide = std::uint32_t(side);
+                }
+            }
+        }
+    }
+
+    IFormat::IPageContent content;
+
+    // write the component table
+    content.m_Components     = Align();
+    content.m_ComponentCount = count;
+
+    if (count)
+        WriteData(components.data(), count * sizeof(IFormat::IComponent));
+
+    const TSP_AttributeStore*     pStore = pPage->GetAttributes();
+    std::vector<IFormat::IColumn> columns;
+
+    // write the attribute columns. NOTE the formula results are also written, so the formulas don't
+    // need to be calculated again when the page is read
+    for (std::size_t i = 1; i < (std::size_t)TSP_Attribute::IEKey::IE_K_Count; ++i)
+    {
+        IFormat::IColumn column;
+
+        if (WriteColumn(pStore, (TSP_Attribute::IEKey)i, count, column))
+            columns.push_back(column);
+    }
+
+    content.m_Columns     = Align();
+    content.m_ColumnCount = columns.size();
+
+    if (!columns.empty())
+        WriteData(columns.data(), columns.size() * sizeof(IFormat::IColumn));
+
+    std::vector<IFormat::IFormula> formulas;
+
+    // get the page formulas
+    for (std::size_t i = 0; i < count; ++i)
+        for (std::size_t j = 1; j < (std::size_t)TSP_Attribute::IEKey::IE_K_Count; ++j)
+        {
+            const TSP_Attribute::IEKey key     = (TSP_Attribute::IEKey)j;
+            const std::wstring         formula = TSP_Calculator::GetFormula(pPage->GetAt(i), key);
+
+            if (formula.empty())
+                continue;
+
+            IFormat::IFormula entry;
+            entry.m_Component = i;
+            entry.m_Key       = AddString(TSP_AttributeSchema::GetName(key));
+            entry.m_Formula   = AddString(formula);
+
+            formulas.push_back(entry);
+        }
+
+    content.m_Formulas     = Align();
+    content.m_FormulaCount = formulas.size();
+
+    if (!formulas.empty())
+    {
+        WriteData(formulas.data(), formulas.size() * sizeof(IFormat::IFormula));
+        flags |= std::uint32_t(IFormat::IEPageFlag::IE_PF_Formulas);
+    }
+
+    // write the page content, which references all the above
+    const std::uint64_t offset = Align();
+    WriteData(&content, sizeof(IFormat::IPageContent));
+
+    return offset;
+}
+//---------------------------------------------------------------------------
+template <class T>
+bool TSP_BinaryDocumentWriter::WriteValues(const TSP_AttributeStore* pStore, TSP_Attribute::IEKey key, std::size_t rowCount)
+{
+    const T* pValues = pStore->GetData<T>(key);
+
+    if (!pValues)
+        return false;
+
+    WriteData(pValues, rowCount * sizeof(T));
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_BinaryDocumentWriter::WriteColumn(const TSP_AttributeStore*  pStore,
+                                                 TSP_Attribute::IEKey key,
+                                                 std::size_t          rowCount,
+                                                 IFormat::IColumn&    column)
+{
+    const std::uint64_t* pValidity = pStore->GetValidity(key);
+
+    // no value was ever set for this key?
+    if (!pValidity || !rowCount)
+        return false;
+
+    const TSP_Attribute::IEFormat format = TSP_AttributeSchema::GetFormat(key);
+
+    // the format cannot be stored in a column?
+    if (!IFormat::GetValueSize(format))
+        return false;
+
+    column.m_Name     = AddString(TSP_AttributeSchema::GetName(key));
+    column.m_Format   = std::uint32_t(format);
+    column.m_Validity = Align();
+
+    WriteData(pValidity, ((rowCount + 63) >> 6) * sizeof(std::uint64_t));
+
+    column.m_Values = Align();
+
+    switch (format)
+    {
+        case TSP_Attribute::IEFormat::IE_Bool:   return WriteValues<std::uint8_t> (pStore, key, rowCount);
+        case TSP_Attribute::IEFormat::IE_Int8:   return WriteValues<std::int8_t>  (pStore, key, rowCount);
+        case TSP_Attribute::IEFormat::IE_UInt8:  return WriteValues<std::uint8_t> (pStore, key, rowCount);
+        case TSP_Attribute::IEFormat::IE_Int16:  return WriteValues<std::int16_t> (pStore, key, rowCount);
+        case TSP_Attribute::IEFormat::IE_UInt16: return WriteValues<std::uint16_t>(pStore, key, rowCount);
+        case TSP_Attribute::IEFormat::IE_Int32:  return WriteValues<std::int32_t> (pStore, key, rowCount);
+        case TSP_Attribute::IEFormat::IE_UInt32: return WriteValues<std::uint32_t>(pStore, key, rowCount);
+        case TSP_Attribute::IEFormat::IE_Int64:  return WriteValues<std::int64_t> (pStore, key, rowCount);
+        case TSP_Attribute::IEFormat::IE_UInt64: return WriteValues<std::uint64_t>(pStore, key, rowCount);
+        case TSP_Attribute::IEFormat::IE_Float:  return WriteValues<float>        (pStore, key, rowCount);
+        case TSP_Attribute::IEFormat::IE_Double: return WriteValues<double>       (pStore, key, rowCount);
+
+        case TSP_Attribute::IEFormat::IE_String:
+        {
+            const std::string* pValues = pStore->GetData<std::string>(key);
+
+            // the strings are written in the string table, the column contains their indexes
+            for (std::size_t i = 0; i < rowCount; ++i)
+            {
+                const std::uint32_t index = pStore->Has(i, key) ? AddString(pValues[i]) : 0;
+                WriteData(&index, sizeof(std::uint32_t));
+            }
+
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_UnicodeString:
+        {
+            const std::wstring* pValues = pStore->GetData<std::wstring>(key);
+
+            for (std::size_t i = 0; i < rowCount; ++i)
+            {
+                const std::uint32_t index = pStore->Has(i, key) ? AddString(pValues[i]) : 0;
+                WriteData(&index, sizeof(std::uint32_t));
+            }
+
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_DateTime:
+        {
+            const std::tm* pValues = pStore->GetData<std::tm>(key);
+
+            for (std::size_t i = 0; i < rowCount; ++i)
+            {
+                IFormat::IDateTime dateTime;
+                dateTime.m_Second  = pValues[i].tm_sec;
+                dateTime.m_Minute  = pValues[i].tm_min;
+                dateTime.m_Hour    = pValues[i].tm_hour;
+                dateTime.m_Day     = pValues[i].tm_mday;
+                dateTime.m_Month   = pValues[i].tm_mon;
+                dateTime.m_Year    = pValues[i].tm_year;
+                dateTime.m_WeekDay = pValues[i].tm_wday;
+                dateTime.m_YearDay = pValues[i].tm_yday;
+                dateTime.m_DST     = pValues[i].tm_isdst;
+
+                WriteData(&dateTime, sizeof(IFormat::IDateTime));
+            }
+
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+//---------------------------------------------------------------------------
+void TSP_BinaryDocumentWriter::WriteStrings(IFormat::IHeader& header)
+{
+    const std::size_t             count = m_Strings.size();
+    std::vector<IFormat::IString> strings(count);
+
+    header.m_Strings     = Align();
+    header.m_StringCount = m_BaseStringCount + count;
+
+    // while a file is updated, the table starts with its current strings, whose chars remain in place
+    if (m_BaseStringCount)
+        WriteData(m_pBaseStrings, std::size_t(m_BaseStringCount * sizeof(IFormat::IString)));
+
+    // the new string chars are written just after the string table
+    std::uint64_t offset = header.m_Strings + header.m_StringCount * sizeof(IFormat::IString);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        strings[i].m_Offset = offset;
+        strings[i].m_Length = m_Strings[i].length();
+
+        offset += m_Strings[i].length();
+    }
+
+    if (count)
+        WriteData(strings.data(), count * sizeof(IFormat::IString));
+
+    for (std::size_t i = 0; i < count; ++i)
+        if (!m_Strings[i].empty())
+            WriteData(m_Strings[i].data(), m_Strings[i].length());
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,247 @@
+/****************************************************************************
+ * ==> TSP_BinaryDocumentWriter --------------------------------------------*
+ ****************************************************************************
+ * Description:  Binary document writer                                     *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// common classes
+#include "Common/TSP_Buffer.h"
+
+// core classes
+#include "TSP_Attribute.h"
+#include "TSP_Document.h"
+#include "TSP_BinaryDocumentFormat.h"
+
+// class prototypes
+class TSP_PageContainer;
+class TSP_Page;
+class TSP_AttributeStore;
+
+/**
+* Binary document writer, writes a document in the binary format (see TSP_BinaryDocumentFormat)
+*@note The file is written in one pass, from its end to its start: the pages are written before the
+*      tables referencing them, and the header is written last, once all the offsets are known
+*@author Jean-Milost Reymond
+*/
+class TSP_BinaryDocumentWriter
+{
+    public:
+        /**
+        * Constructor
+        *@param pBuffer - buffer to write to, should be empty and support to seek back to its start
+        */
+        TSP_BinaryDocumentWriter(TSP_Buffer* pBuffer);
+
+        virtual ~TSP_BinaryDocumentWriter();
+
+        /**
+        * Writes a document
+        *@param pDocument - document to write
+        *@return true on success, otherwise false
+        */
+        virtual bool Write(const TSP_Document* pDocument);
+
+        /**
+        * Writes a single page as a document
+        *@param pPage - page to write, with the pages of the processes it contains
+        *@return true on success, otherwise false
+        *@note The written document contains an untitled document with a single unnamed atlas owning
+        *      the page. It contains no identifier, so two pages with the same content are written
+        *      identically, e.g. to be compared by hash
+        */
+        virtual bool Write(const TSP_Page* pPage);
+
+        /**
+        * Writes the document modifications, to be appended to the binary file the document was read
+        * from or last written to
+        *@param pDocument - document to write
+        *@param pData - current file content
+        *@param size - current file size, in bytes
+        *@param[out] offset - offset at which the buffer content should be written in the file
+        *@param[out] header - new file header, to write at the file start once the buffer content is written
+        *@return true on success, false on error or if the file should rather be written in full again
+        *@note Only the modified pages, and the pages whose content has no handle, are written. The
+        *      other pages are referenced where their content already is in the file. The file should
+        *      be written in full again once it grew too much, as the replaced contents are kept
+        */
+        virtual bool Update(const TSP_Document*                      pDocument,
+                            const void*                              pData,
+                                  std::size_t                        size,
+                                  std::uint64_t&                     offset,
+                                  TSP_BinaryDocumentFormat::IHeader& header);
+
+        /**
+        * Gets the content handles of the pages written by the last write or update
+        *@return the page content handles, valid in the written file
+        */
+        virtual inline const TSP_Document::IPageHandles& GetPageHandles() const;
+
+    private:
+        typedef TSP_BinaryDocumentFormat                       IFormat;
+        typedef std::vector<std::string>                       IStrings;
+        typedef std::unordered_map<std::string, std::uint32_t> IStringIndexes;
+
+        static const std::size_t   m_CacheSize = 1024 * 1024;
+        static const std::uint64_t m_MaxGrowth = 2;
+
+        TSP_Buffer*                m_pBuffer         = nullptr;
+        std::vector<char>          m_Cache;
+        std::uint64_t              m_Offset          = 0;
+        IStrings                   m_Strings;
+        IStringIndexes             m_StringIndexes;
+        const IFormat::IString*    m_pBaseStrings    = nullptr;
+        std::uint64_t              m_BaseStringCount = 0;
+        TSP_Document::IPageHandles m_PageHandles;
+        bool                       m_Update          = false;
+        bool                       m_Failed          = false;
+
+        /**
+        * Resets the writer state
+        */
+        void Reset();
+
+        /**
+        * Starts to write a document
+        *@param[out] header - document header to complete
+        *@param title - document title
+        */
+        void Begin(IFormat::IHeader& header, const std::wstring& title);
+
+        /**
+        * Ends to write a document
+        *@param[in, out] header - document header to complete and write
+        *@param atlases - atlas table
+        *@return true on success, otherwise false
+        */
+        bool End(IFormat::IHeader& header, const std::vector<IFormat::IAtlas>& atlases);
+
+        /**
+        * Writes the atlas pages
+        *@param pDocument - document owning the atlases
+        *@param[out] atlases - atlas table
+        */
+        void WriteAtlases(const TSP_Document* pDocument, std::vector<IFormat::IAtlas>& atlases);
+
+        /**
+        * Writes the atlas and string tables
+        *@param[in, out] header - document header to complete
+        *@param atlases - atlas table
+        *@return true on success, otherwise false
+        */
+        bool WriteTables(IFormat::IHeader& header, const std::vector<IFormat::IAtlas>& atlases);
+
+        /**
+        * Adds a string in the string table
+        *@param str - string to add
+        *@return the string index
+        *@note The identical strings are only stored once
+        */
+        std::uint32_t AddString(const std::string&  str);
+        std::uint32_t AddString(const std::wstring& str);
+
+        /**
+        * Writes data at the file end
+        *@param pData - data to write
+        *@param size - data size, in bytes
+        *@return the data offset
+        */
+        std::uint64_t WriteData(const void* pData, std::size_t size);
+
+        /**
+        * Pads the file end to the format alignment
+        *@return the aligned offset
+        */
+        std::uint64_t Align();
+
+        /**
+        * Writes the cached data to the buffer
+        */
+        void Flush();
+
+        /**
+        * Writes the pages of a container, followed by their page table
+        *@param pContainer - container owning the pages
+        *@param[out] flags - IE_PF_Formulas if one of the pages contains formulas, otherwise IE_PF_None
+        *@return the page table offset
+        *@note While a file is updated, the unmodified pages aren't written again
+        */
+        std::uint64_t WritePages(const TSP_PageContainer* pContainer, std::uint32_t& flags);
+
+        /**
+        * Writes a page content, preceded by the pages of the processes it contains
+        *@param pPage - page to write
+        *@param[out] flags - IE_PF_Formulas if the page or its sub-pages contain formulas, otherwise IE_PF_None
+        *@return the page content offset
+        */
+        std::uint64_t WritePage(const TSP_Page* pPage, std::uint32_t& flags);
+
+        /**
+        * Writes the values of an attribute column
+        *@param pStore - attribute store
+        *@param key - attribute key
+        *@param rowCount - row count
+        *@param[out] column - column table entry
+        *@return true if the column was written, false if it contains no value
+        */
+        bool WriteColumn(const TSP_AttributeStore*  pStore,
+                               TSP_Attribute::IEKey key,
+                               std::size_t          rowCount,
+                               IFormat::IColumn&    column);
+
+        /**
+        * Writes a numeric value array as is
+        *@param pStore - attribute store
+        *@param key - attribute key
+        *@param rowCount - row count
+        *@return true on success, otherwise false
+        */
+        template <class T>
+        bool WriteValues(const TSP_AttributeStore* pStore, TSP_Attribute::IEKey key, std::size_t rowCount);
+
+        /**
+        * Writes the string table
+        *@param[in, out] header - header to complete
+        */
+        void WriteStrings(IFormat::IHeader& header);
+};
+
+//---------------------------------------------------------------------------
+// TSP_BinaryDocumentWriter
+//---------------------------------------------------------------------------
+const TSP_Document::IPageHandles& TSP_BinaryDocumentWriter::GetPageHandles() const
+{
+    return m_PageHandles;
+}
+//---------------------------------------------------------------------------
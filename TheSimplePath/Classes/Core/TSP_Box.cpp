@@ -34,14 +34,18 @@
 //---------------------------------------------------------------------------
 TSP_Box::TSP_Box(TSP_Page* pOwner) :
     TSP_Component(pOwner)
-{}
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Box::TSP_Box(const std::wstring& title,
                  const std::wstring& description,
                  const std::wstring& comments,
                        TSP_Page*     pOwner) :
     TSP_Component(title, description, comments, pOwner)
-{}
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Box::~TSP_Box()
 {}
@@ -42,6 +42,8 @@
 class TSP_Box : public TSP_Component
 {
     public:
+        static const IEType m_ClassType = IEType::IE_T_Box;
+
         /**
         * Constructor
         *@param pOwner - component owner
@@ -0,0 +1,570 @@
+/****************************************************************************
+ * ==> TSP_Calculator ------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Calculated attributes engine                               *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_Calculator.h"
+
+// std
+#include <algorithm>
+#include <unordered_set>
+
+// common classes
+#include "Common\TSP_ThreadPool.h"
+
+// core classes
+#include "TSP_AttributeSchema.h"
+#include "TSP_Component.h"
+#include "TSP_Page.h"
+#include "TSP_Process.h"
+
+//---------------------------------------------------------------------------
+// Static members
+//---------------------------------------------------------------------------
+TSP_Calculator::IFormulas                TSP_Calculator::m_Formulas;
+TSP_Calculator::IDependents              TSP_Calculator::m_Dependents;
+std::atomic<std::size_t>                 TSP_Calculator::m_FormulaCount(0);
+std::mutex                               TSP_Calculator::m_Mutex;
+//---------------------------------------------------------------------------
+// TSP_Calculator::IResolver
+//---------------------------------------------------------------------------
+TSP_Calculator::IResolver::IResolver(const TSP_Component* pComponent) :
+    TSP_Expression::IResolver(),
+    m_pComponent(pComponent)
+{}
+//---------------------------------------------------------------------------
+TSP_Calculator::IResolver::~IResolver()
+{}
+//---------------------------------------------------------------------------
+bool TSP_Calculator::IResolver::Resolve(const TSP_Expression::IInstruction& instruction, double& value) const
+{
+    switch (instruction.m_OpCode)
+    {
+        case TSP_Expression::IEOpCode::IE_O_Value:
+        {
+            const TSP_Attribute attribute = m_pComponent->GetAttribute(instruction.m_Key);
+
+            if (attribute.GetFormat() == TSP_Attribute::IEFormat::IE_Undefined)
+                return false;
+
+            value = attribute.Get(0.0);
+            return true;
+        }
+
+        case TSP_Expression::IEOpCode::IE_O_ParentValue:
+        {
+            TSP_Item* pPage = m_pComponent->GetOwner();
+
+            if (!pPage || !pPage->IsKindOf(TSP_Item::IEType::IE_T_Page))
+                return false;
+
+            TSP_Item* pParent = static_cast<TSP_Page*>(pPage)->GetOwner();
+
+            // only a process may own the page of a component
+            if (!pParent || !pParent->IsKindOf(TSP_Item::IEType::IE_T_Process))
+                return false;
+
+            const TSP_Attribute attribute = static_cast<TSP_Process*>(pParent)->GetAttribute(instruction.m_Key);
+
+            if (attribute.GetFormat() == TSP_Attribute::IEFormat::IE_Undefined)
+                return false;
+
+            value = attribute.Get(0.0);
+            return true;
+        }
+
+        default:
+        {
+            // the aggregates are only available on the processes, which contain pages
+            if (!m_pComponent->IsKindOf(TSP_Item::IEType::IE_T_Process))
+                return false;
+
+            const TSP_Process*             pProcess = static_cast<const TSP_Process*>(m_pComponent);
+            TSP_AttributeStore::IAggregate aggregate;
+
+            for (std::size_t i = 0; i < pProcess->GetPageCount(); ++i)
+                aggregate.Merge(pProcess->GetPage(i)->GetAttributes()->Aggregate(instruction.m_Key));
+
+            switch (instruction.m_OpCode)
+            {
+                case TSP_Expression::IEOpCode::IE_O_Sum:   value = aggregate.m_Sum;          return true;
+                case TSP_Expression::IEOpCode::IE_O_Count: value = double(aggregate.m_Count); return true;
+                default:                                                                     break;
+            }
+
+            // the other aggregates are undefined without value
+            if (!aggregate.m_Count)
+                return false;
+
+            switch (instruction.m_OpCode)
+            {
+                case TSP_Expression::IEOpCode::IE_O_Min:     value = aggregate.m_Min;                          return true;
+                case TSP_Expression::IEOpCode::IE_O_Max:     value = aggregate.m_Max;                          return true;
+                case TSP_Expression::IEOpCode::IE_O_Average: value = aggregate.m_Sum / double(aggregate.m_Count); return true;
+                default:                                                                                        return false;
+            }
+        }
+    }
+}
+//---------------------------------------------------------------------------
+// TSP_Calculator
+//---------------------------------------------------------------------------
+bool TSP_Calculator::SetFormula(TSP_Component* pComponent, TSP_Attribute::IEKey key, const std::wstring& formula)
+{
+    std::unique_ptr<IFormula> pFormula = Create(pComponent, key, formula);
+
+    if (!pFormula)
+        return false;
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    // keep the previous formula, it should be restored if the new one is rejected
+    std::unique_ptr<IFormula> pPrevious   = Unregister(pFormula->m_Cell);
+    IFormula*                 pNewFormula = pFormula.get();
+
+    Register(std::move(pFormula));
+
+    // collect the formulas to calculate, starting from the new one
+    INodes nodes;
+    AddChangedNodes(*pNewFormula, nodes);
+
+    IFormulaList formulas;
+    formulas.push_back(pNewFormula);
+
+    // does the new formula depend on itself?
+    if (!Collect(nodes, formulas))
+    {
+        Unregister(pNewFormula->m_Cell);
+
+        if (pPrevious)
+            Register(std::move(pPrevious));
+
+        return false;
+    }
+
+    Calculate(formulas);
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Calculator::RestoreFormula(TSP_Component* pComponent, TSP_Attribute::IEKey key, const std::wstring& formula)
+{
+    std::unique_ptr<IFormula> pFormula = Create(pComponent, key, formula);
+
+    if (!pFormula)
+        return false;
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    // the cell already contains the formula result, so nothing is calculated
+    Unregister(pFormula->m_Cell);
+    Register(std::move(pFormula));
+
+    return true;
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_Calculator::GetFormula(const TSP_Component* pComponent, TSP_Attribute::IEKey key)
+{
+    if (!pComponent || !m_FormulaCount)
+        return L"";
+
+    INode cell;
+    cell.m_UID = pComponent->GetUID();
+    cell.m_Key = key;
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    IFormulas::const_iterator it = m_Formulas.find(cell);
+
+    if (it == m_Formulas.end())
+        return L"";
+
+    return it->second->m_Expression.GetFormula();
+}
+//---------------------------------------------------------------------------
+void TSP_Calculator::RemoveFormula(const TSP_Component* pComponent, TSP_Attribute::IEKey key)
+{
+    if (!pComponent || !m_FormulaCount)
+        return;
+
+    INode cell;
+    cell.m_UID = pComponent->GetUID();
+    cell.m_Key = key;
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    Unregister(cell);
+}
+//---------------------------------------------------------------------------
+void TSP_Calculator::RemoveFormulas(const TSP_Component* pComponent)
+{
+    if (!pComponent || !m_FormulaCount)
+        return;
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    for (std::size_t i = 1; i < (std::size_t)TSP_Attribute::IEKey::IE_K_Count; ++i)
+    {
+        INode cell;
+        cell.m_UID = pComponent->GetUID();
+        cell.m_Key = (TSP_Attribute::IEKey)i;
+
+        Unregister(cell);
+    }
+}
+//---------------------------------------------------------------------------
+void TSP_Calculator::NotifyChanged(const TSP_Component* pComponent, TSP_Attribute::IEKey key)
+{
+    // nothing to calculate? (this is the common case, e.g. while a document is loaded)
+    if (!pComponent || !m_FormulaCount)
+        return;
+
+    INodes nodes(2);
+    nodes[0].m_UID       = pComponent->GetUID();
+    nodes[0].m_Key       = key;
+    nodes[1].m_UID       = GetContainerUID(pComponent);
+    nodes[1].m_Key       = key;
+    nodes[1].m_Container = true;
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    IFormulaList formulas;
+    Collect(nodes, formulas);
+    Calculate(formulas);
+}
+//---------------------------------------------------------------------------
+void TSP_Calculator::NotifyContainerChanged(const TSP_Item* pContainer)
+{
+    if (!pContainer || !m_FormulaCount)
+        return;
+
+    INodes nodes;
+
+    // the removed components may have contained a value for any key
+    for (std::size_t i = 1; i < (std::size_t)TSP_Attribute::IEKey::IE_K_Count; ++i)
+    {
+        INode node;
+        node.m_UID       = pContainer->GetUID();
+        node.m_Key       = (TSP_Attribute::IEKey)i;
+        node.m_Container = true;
+
+        nodes.push_back(node);
+    }
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    IFormulaList formulas;
+    Collect(nodes, formulas);
+    Calculate(formulas);
+}
+//---------------------------------------------------------------------------
+TSP_Item::IUID TSP_Calculator::GetContainerUID(const TSP_Component* pComponent)
+{
+    TSP_Item* pPage = pComponent->GetOwner();
+
+    if (!pPage || !pPage->IsKindOf(TSP_Item::IEType::IE_T_Page))
+        return 0;
+
+    TSP_Item* pContainer = static_cast<TSP_Page*>(pPage)->GetOwner();
+
+    return pContainer ? pContainer->GetUID() : 0;
+}
+//---------------------------------------------------------------------------
+std::unique_ptr<TSP_Calculator::IFormula> TSP_Calculator::Create(TSP_Component* pComponent, TSP_Attribute::IEKey key, const std::wstring& formula)
+{
+    if (!pComponent)
+        return nullptr;
+
+    // the results are written in the key column, which should be numeric
+    switch (TSP_AttributeSchema::GetFormat(key))
+    {
+        case TSP_Attribute::IEFormat::IE_Undefined:
+        case TSP_Attribute::IEFormat::IE_String:
+        case TSP_Attribute::IEFormat::IE_UnicodeString:
+        case TSP_Attribute::IEFormat::IE_DateTime:
+        case TSP_Attribute::IEFormat::IE_Formula:
+            return nullptr;
+
+        default:
+            break;
+    }
+
+    TSP_Item* pPage = pComponent->GetOwner();
+
+    // the results are stored in the page containing the component
+    if (!pPage || !pPage->IsKindOf(TSP_Item::IEType::IE_T_Page) || !static_cast<TSP_Page*>(pPage)->Owns(pComponent))
+        return nullptr;
+
+    std::unique_ptr<IFormula> pFormula(new IFormula());
+
+    if (!pFormula->m_Expression.Compile(formula))
+        return nullptr;
+
+    pFormula->m_pComponent   = pComponent;
+    pFormula->m_Cell.m_UID   = pComponent->GetUID();
+    pFormula->m_Cell.m_Key   = key;
+    pFormula->m_ContainerUID = GetContainerUID(pComponent);
+
+    // get the nodes the formula depends on
+    for each (const TSP_Expression::IInstruction& instruction in pFormula->m_Expression.GetInstructions())
+    {
+        INode node;
+        node.m_Key = instruction.m_Key;
+
+        switch (instruction.m_OpCode)
+        {
+            case TSP_Expression::IEOpCode::IE_O_Constant:
+            case TSP_Expression::IEOpCode::IE_O_Add:
+            case TSP_Expression::IEOpCode::IE_O_Subtract:
+            case TSP_Expression::IEOpCode::IE_O_Multiply:
+            case TSP_Expression::IEOpCode::IE_O_Divide:
+            case TSP_Expression::IEOpCode::IE_O_Negate:
+                continue;
+
+            case TSP_Expression::IEOpCode::IE_O_Value:
+                node.m_UID = pComponent->GetUID();
+                break;
+
+            case TSP_Expression::IEOpCode::IE_O_ParentValue:
+                node.m_UID = pFormula->m_ContainerUID;
+                break;
+
+            default:
+                node.m_UID       = pComponent->GetUID();
+                node.m_Container = true;
+                break;
+        }
+
+        if (std::find(pFormula->m_Dependencies.begin(), pFormula->m_Dependencies.end(), node) == pFormula->m_Dependencies.end())
+            pFormula->m_Dependencies.push_back(node);
+    }
+
+    return pFormula;
+}
+//---------------------------------------------------------------------------
+void TSP_Calculator::Register(std::unique_ptr<IFormula> pFormula)
+{
+    // link the formula to the nodes it depends on
+    for each (const INode& node in pFormula->m_Dependencies)
+        m_Dependents[node].push_back(pFormula.get());
+
+    m_Formulas[pFormula->m_Cell] = std::move(pFormula);
+    ++m_FormulaCount;
+}
+//---------------------------------------------------------------------------
+std::unique_ptr<TSP_Calculator::IFormula> TSP_Calculator::Unregister(const INode& cell)
+{
+    IFormulas::iterator it = m_Formulas.find(cell);
+
+    if (it == m_Formulas.end())
+        return nullptr;
+
+    std::unique_ptr<IFormula> pFormula = std::move(it->second);
+
+    // unlink the formula from the nodes it depends on
+    for each (const INode& node in pFormula->m_Dependencies)
+    {
+        IDependents::iterator itDependents = m_Dependents.find(node);
+
+        if (itDependents == m_Dependents.end())
+            continue;
+
+        IFormulaList& dependents = itDependents->second;
+        dependents.erase(std::remove(dependents.begin(), dependents.end(), pFormula.get()), dependents.end());
+
+        if (dependents.empty())
+            m_Dependents.erase(itDependents);
+    }
+
+    m_Formulas.erase(it);
+    --m_FormulaCount;
+
+    return pFormula;
+}
+//---------------------------------------------------------------------------
+bool TSP_Calculator::Collect(const INodes& nodes, IFormulaList& formulas)
+{
+    std::unordered_set<IFormula*> visited(formulas.begin(), formulas.end());
+    INodes                        pending(nodes);
+
+    // search for all the formulas depending, directly or not, on the changed nodes
+    while (!pending.empty())
+    {
+        const INode node = pending.back();
+        pending.pop_back();
+
+        IDependents::const_iterator it = m_Dependents.find(node);
+
+        if (it == m_Dependents.end())
+            continue;
+
+        for each (IFormula* pFormula in it->second)
+            if (visited.insert(pFormula).second)
+            {
+                formulas.push_back(pFormula);
+                AddChangedNodes(*pFormula, pending);
+            }
+    }
+
+    if (formulas.empty())
+        return true;
+
+    // get which collected formula produces each node
+    IDependents producers;
+    INodes      changedNodes;
+
+    for each (IFormula* pFormula in formulas)
+    {
+        changedNodes.clear();
+        AddChangedNodes(*pFormula, changedNodes);
+
+        for each (const INode& node in changedNodes)
+            producers[node].push_back(pFormula);
+    }
+
+    // count the collected formulas each formula waits for
+    std::unordered_map<IFormula*, std::size_t>  waitCount;
+    std::unordered_map<IFormula*, IFormulaList> successors;
+
+    for each (IFormula* pFormula in formulas)
+    {
+        std::size_t& count = waitCount[pFormula];
+
+        pFormula->m_Level = 0;
+
+        for each (const INode& node in pFormula->m_Dependencies)
+        {
+            IDependents::const_iterator it = producers.find(node);
+
+            if (it == producers.end())
+                continue;
+
+            for each (IFormula* pProducer in it->second)
+            {
+                successors[pProducer].push_back(pFormula);
+                ++count;
+            }
+        }
+    }
+
+    // order the formulas by level, a formula level is higher than the level of all the formulas it waits for
+    IFormulaList ordered;
+    ordered.reserve(formulas.size());
+
+    for each (IFormula* pFormula in formulas)
+        if (!waitCount[pFormula])
+            ordered.push_back(pFormula);
+
+    for (std::size_t i = 0; i < ordered.size(); ++i)
+        for each (IFormula* pSuccessor in successors[ordered[i]])
+        {
+            pSuccessor->m_Level = std::max(pSuccessor->m_Level, ordered[i]->m_Level + 1);
+
+            if (!--waitCount[pSuccessor])
+                ordered.push_back(pSuccessor);
+        }
+
+    // some formulas are waiting for each other?
+    const bool acyclic = ordered.size() == formulas.size();
+
+    std::stable_sort(ordered.begin(), ordered.end(), [](const IFormula* pA, const IFormula* pB)
+    {
+        return pA->m_Level < pB->m_Level;
+    });
+
+    formulas.swap(ordered);
+    return acyclic;
+}
+//---------------------------------------------------------------------------
+void TSP_Calculator::Calculate(const IFormulaList& formulas)
+{
+    for (std::size_t first = 0; first < formulas.size();)
+    {
+        std::size_t last = first + 1;
+
+        // get the formulas of the same level, which don't depend on each other
+        while (last < formulas.size() && formulas[last]->m_Level == formulas[first]->m_Level)
+            ++last;
+
+        const std::size_t count = last - first;
+
+        auto calculate = [&formulas](std::size_t index)
+        {
+            IFormula* pFormula = formulas[index];
+            pFormula->m_Valid  = pFormula->m_Expression.Evaluate(IResolver(pFormula->m_pComponent), pFormula->m_Result);
+        };
+
+        // large level? Calculate it in parallel, the cells are only read meanwhile
+        if (count >= m_ParallelThreshold)
+        {
+            TSP_ThreadPool*   pPool     = TSP_ThreadPool::Instance();
+            const std::size_t maxSlots  = count / (m_ParallelThreshold / 2);
+            const std::size_t slotCount = std::min(pPool->GetSlotCount(), maxSlots);
+
+            std::atomic<std::size_t> next(first);
+
+            // each slot takes the next free formula, the calling thread runs slots as well
+            pPool->Run([&](std::size_t)
+                       {
+                           for (std::size_t index = next++; index < last; index = next++)
+                               calculate(index);
+                       },
+                       slotCount);
+        }
+        else
+            for (std::size_t i = first; i < last; ++i)
+                calculate(i);
+
+        // the columns aren't thread-safe, so the results are stored once the level is calculated
+        for (std::size_t i = first; i < last; ++i)
+            Store(*formulas[i]);
+
+        first = last;
+    }
+}
+//---------------------------------------------------------------------------
+void TSP_Calculator::Store(const IFormula& formula)
+{
+    TSP_Page*           pPage  = static_cast<TSP_Page*>(formula.m_pComponent->GetOwner());
+    TSP_AttributeStore* pStore = pPage->GetAttributes();
+    const std::size_t   row    = formula.m_pComponent->GetContainerIndex();
+
+    if (formula.m_Valid)
+        pStore->Set(row, formula.m_Cell.m_Key, TSP_Attribute(formula.m_Result));
+    else
+        pStore->Reset(row, formula.m_Cell.m_Key);
+
+    // the formula results are saved with the other values
+    formula.m_pComponent->SetModified();
+}
+//---------------------------------------------------------------------------
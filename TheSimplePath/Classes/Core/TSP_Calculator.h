@@ -0,0 +1,281 @@
+/****************************************************************************
+ * ==> TSP_Calculator ------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Calculated attributes engine                               *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// core classes
+#include "TSP_Item.h"
+#include "TSP_Attribute.h"
+#include "TSP_Expression.h"
+
+// class prototypes
+class TSP_Component;
+
+/**
+* Calculated attributes engine. Keeps the formulas set on the component attributes, and the graph
+* of the cells they depend on. When a cell changes, only the formulas depending on it, directly or
+* not, are recalculated, in dependency order. The formulas which don't depend on each other are
+* calculated in parallel
+*@note A cell is a key of a component. A formula may depend on the cells of its own component, of
+*      the process owning the component page, and on a key of all the components contained in the
+*      pages of its own process (see TSP_Expression)
+*@author Jean-Milost Reymond
+*/
+class TSP_Calculator
+{
+    public:
+        /**
+        * Sets a formula on a component attribute, and calculates it
+        *@param pComponent - component, should be contained in a page
+        *@param key - attribute key receiving the result, should have a numeric format
+        *@param formula - formula
+        *@return true on success, false if the formula is invalid or would depend on itself
+        */
+        static bool SetFormula(TSP_Component* pComponent, TSP_Attribute::IEKey key, const std::wstring& formula);
+
+        /**
+        * Restores a formula on a component attribute, without calculating it
+        *@param pComponent - component, should be contained in a page
+        *@param key - attribute key, should already contain the formula result
+        *@param formula - formula
+        *@return true on success, false if the formula is invalid
+        *@note Used while a document is read, the formulas were already calculated when the document was
+        *      written, so their results are just read with the other values. The formula should not depend
+        *      on itself, as it is not checked
+        */
+        static bool RestoreFormula(TSP_Component* pComponent, TSP_Attribute::IEKey key, const std::wstring& formula);
+
+        /**
+        * Gets the formula set on a component attribute
+        *@param pComponent - component
+        *@param key - attribute key
+        *@return the formula, empty string if the attribute has no formula
+        */
+        static std::wstring GetFormula(const TSP_Component* pComponent, TSP_Attribute::IEKey key);
+
+        /**
+        * Removes the formula set on a component attribute, the last calculated value is kept
+        *@param pComponent - component
+        *@param key - attribute key
+        */
+        static void RemoveFormula(const TSP_Component* pComponent, TSP_Attribute::IEKey key);
+
+        /**
+        * Removes all the formulas set on a component, without recalculating anything
+        *@param pComponent - component
+        *@note Called while the component is deleted
+        */
+        static void RemoveFormulas(const TSP_Component* pComponent);
+
+        /**
+        * Notifies that a component attribute changed, and recalculates the formulas depending on it
+        *@param pComponent - component
+        *@param key - changed attribute key
+        */
+        static void NotifyChanged(const TSP_Component* pComponent, TSP_Attribute::IEKey key);
+
+        /**
+        * Notifies that components or pages were removed from a container, and recalculates the
+        * formulas aggregating its components
+        *@param pContainer - container item, i.e. the item owning the pages
+        */
+        static void NotifyContainerChanged(const TSP_Item* pContainer);
+
+    private:
+        /**
+        * Dependency graph node, either a cell or all the cells of a key in the pages of a container
+        */
+        struct INode
+        {
+            TSP_Item::IUID       m_UID       = 0;
+            TSP_Attribute::IEKey m_Key       = TSP_Attribute::IEKey::IE_K_Unknown;
+            bool                 m_Container = false;
+
+            inline bool operator == (const INode& other) const;
+        };
+
+        /**
+        * Node hash function
+        */
+        struct INodeHash
+        {
+            inline std::size_t operator () (const INode& node) const;
+        };
+
+        typedef std::vector<INode> INodes;
+
+        /**
+        * Formula set on a cell
+        */
+        struct IFormula
+        {
+            TSP_Component* m_pComponent   = nullptr;
+            INode          m_Cell;
+            TSP_Item::IUID m_ContainerUID = 0;
+            TSP_Expression m_Expression;
+            INodes         m_Dependencies;
+            std::size_t    m_Level        = 0;
+            double         m_Result       = 0.0;
+            bool           m_Valid        = false;
+        };
+
+        typedef std::vector<IFormula*>                                          IFormulaList;
+        typedef std::unordered_map<INode, std::unique_ptr<IFormula>, INodeHash> IFormulas;
+        typedef std::unordered_map<INode, IFormulaList, INodeHash>              IDependents;
+
+        /**
+        * Resolves the references of a formula
+        */
+        class IResolver : public TSP_Expression::IResolver
+        {
+            public:
+                /**
+                * Constructor
+                *@param pComponent - component owning the formula
+                */
+                IResolver(const TSP_Component* pComponent);
+
+                virtual ~IResolver();
+
+                /**
+                * Resolves a reference
+                *@param instruction - instruction containing the reference
+                *@param[out] value - resolved value
+                *@return true on success, false if the value isn't available
+                */
+                virtual bool Resolve(const TSP_Expression::IInstruction& instruction, double& value) const;
+
+            private:
+                const TSP_Component* m_pComponent;
+        };
+
+        static const std::size_t m_ParallelThreshold = 512;
+
+        static IFormulas                m_Formulas;
+        static IDependents              m_Dependents;
+        static std::atomic<std::size_t> m_FormulaCount;
+        static std::mutex               m_Mutex;
+
+        /**
+        * Gets the uid of the container owning the page of a component
+        *@param pComponent - component
+        *@return the container uid, 0 if the component isn't contained in a page
+        */
+        static TSP_Item::IUID GetContainerUID(const TSP_Component* pComponent);
+
+        /**
+        * Creates a formula and gets the nodes it depends on
+        *@param pComponent - component, should be contained in a page
+        *@param key - attribute key receiving the result, should have a numeric format
+        *@param formula - formula
+        *@return the formula, nullptr if the formula is invalid
+        */
+        static std::unique_ptr<IFormula> Create(TSP_Component* pComponent, TSP_Attribute::IEKey key, const std::wstring& formula);
+
+        /**
+        * Adds a formula, the caller should lock the engine
+        *@param pFormula - formula to add
+        */
+        static void Register(std::unique_ptr<IFormula> pFormula);
+
+        /**
+        * Removes a formula, the caller should lock the engine
+        *@param cell - formula cell
+        *@return the removed formula, nullptr if the cell had no formula
+        */
+        static std::unique_ptr<IFormula> Unregister(const INode& cell);
+
+        /**
+        * Collects the formulas depending, directly or not, on nodes, the caller should lock the engine
+        *@param nodes - changed nodes
+        *@param[out] formulas - formulas depending on the nodes, in dependency order
+        *@return false if a formula depends on itself, otherwise true
+        */
+        static bool Collect(const INodes& nodes, IFormulaList& formulas);
+
+        /**
+        * Calculates formulas and stores their results, the caller should lock the engine
+        *@param formulas - formulas to calculate, in dependency order
+        */
+        static void Calculate(const IFormulaList& formulas);
+
+        /**
+        * Stores a formula result in its cell
+        *@param formula - formula
+        */
+        static void Store(const IFormula& formula);
+
+        /**
+        * Adds the nodes changing when a formula result changes
+        *@param formula - formula
+        *@param[in, out] nodes - nodes to add to
+        */
+        static inline void AddChangedNodes(const IFormula& formula, INodes& nodes);
+};
+
+//---------------------------------------------------------------------------
+// TSP_Calculator::INode
+//---------------------------------------------------------------------------
+bool TSP_Calculator::INode::operator == (const INode& other) const
+{
+    return m_UID == other.m_UID && m_Key == other.m_Key && m_Container == other.m_Container;
+}
+//---------------------------------------------------------------------------
+// TSP_Calculator::INodeHash
+//---------------------------------------------------------------------------
+std::size_t TSP_Calculator::INodeHash::operator () (const INode& node) const
+{
+    // the uid already combines a slot index and a generation, so mixing the key in its high bits is enough
+    const std::uint64_t hash = node.m_UID ^ (std::uint64_t((std::size_t)node.m_Key * 2 + node.m_Container) << 56);
+
+    return std::size_t(hash * 0x9E3779B97F4A7C15ull);
+}
+//---------------------------------------------------------------------------
+// TSP_Calculator
+//---------------------------------------------------------------------------
+void TSP_Calculator::AddChangedNodes(const IFormula& formula, INodes& nodes)
+{
+    INode container;
+    container.m_UID       = formula.m_ContainerUID;
+    container.m_Key       = formula.m_Cell.m_Key;
+    container.m_Container = true;
+
+    nodes.push_back(formula.m_Cell);
+    nodes.push_back(container);
+}
+//---------------------------------------------------------------------------
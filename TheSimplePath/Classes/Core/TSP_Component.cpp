@@ -29,8 +29,13 @@
 
 #include "TSP_Component.h"
 
+// std
+#include <cmath>
+
 // core classes
 #include "TSP_Page.h"
+#include "TSP_AttributeSchema.h"
+#include "TSP_Calculator.h"
 
 //---------------------------------------------------------------------------
 // TSP_Component
@@ -53,8 +58,7 @@ TSP_Component::TSP_Component(const std::wstring& title,
 //---------------------------------------------------------------------------
 TSP_Component::~TSP_Component()
 {
-    for each (auto pAttribute in m_Attributes)
-        delete pAttribute;
+    TSP_Calculator::RemoveFormulas(this);
 }
 //---------------------------------------------------------------------------
 std::wstring TSP_Component::GetTitle() const
@@ -65,6 +69,7 @@ std::wstring TSP_Component::GetTitle() const
 bool TSP_Component::SetTitle(const std::wstring& value)
 {
     m_Title = value;
+    SetModified();
     return true;
 }
 //---------------------------------------------------------------------------
@@ -76,6 +81,7 @@ std::wstring TSP_Component::GetDescription() const
 bool TSP_Component::SetDescription(const std::wstring& value)
 {
     m_Description = value;
+    SetModified();
     return true;
 }
 //---------------------------------------------------------------------------
@@ -87,6 +93,213 @@ std::wstring TSP_Component::GetComments() const
 bool TSP_Component::SetComments(const std::wstring& value)
 {
     m_Comments = value;
+    SetModified();
     return true;
 }
 //---------------------------------------------------------------------------
+TSP_Attribute TSP_Component::GetAttribute(TSP_Attribute::IEKey key) const
+{
+    TSP_Attribute attribute;
+
+    TSP_Page* pPage = GetAttributePage();
+
+    if (pPage)
+        pPage->GetAttributes()->Get(GetContainerIndex(), key, attribute);
+
+    return attribute;
+}
+//---------------------------------------------------------------------------
+bool TSP_Component::SetAttribute(TSP_Attribute::IEKey key, const TSP_Attribute& value)
+{
+    TSP_Page* pPage = GetAttributePage();
+
+    if (!pPage)
+        return false;
+
+    // formulas are calculated by the calculator, which stores their results in the page
+    if (value.IsFormula())
+    {
+        if (!TSP_Calculator::SetFormula(this, key, value.Get(std::wstring())))
+            return false;
+
+        SetModified();
+        return true;
+    }
+
+    // a value replaces the formula the attribute may contain
+    TSP_Calculator::RemoveFormula(this, key);
+
+    if (!pPage->GetAttributes()->Set(GetContainerIndex(), key, value))
+        return false;
+
+    SetModified();
+    TSP_Calculator::NotifyChanged(this, key);
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Component::HasAttribute(TSP_Attribute::IEKey key) const
+{
+    TSP_Page* pPage = GetAttributePage();
+
+    if (!pPage)
+        return false;
+
+    return pPage->GetAttributes()->Has(GetContainerIndex(), key);
+}
+//---------------------------------------------------------------------------
+void TSP_Component::ResetAttribute(TSP_Attribute::IEKey key)
+{
+    TSP_Page* pPage = GetAttributePage();
+
+    if (!pPage)
+        return;
+
+    TSP_Calculator::RemoveFormula(this, key);
+    pPage->GetAttributes()->Reset(GetContainerIndex(), key);
+    SetModified();
+    TSP_Calculator::NotifyChanged(this, key);
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_Component::GetFormula(TSP_Attribute::IEKey key) const
+{
+    return TSP_Calculator::GetFormula(this, key);
+}
+//---------------------------------------------------------------------------
+void TSP_Component::SetModified()
+{
+    // already marked? Its owners are also
+    if (IsModified())
+        return;
+
+    // the components created while their page content is read don't modify the document
+    if (m_pOwner && m_pOwner->IsKindOf(IEType::IE_T_Page) && static_cast<TSP_Page*>(m_pOwner)->IsReadingContent())
+        return;
+
+    TSP_Item::SetModified();
+
+    if (m_pOwner)
+        m_pOwner->SetModified();
+}
+//---------------------------------------------------------------------------
+bool TSP_Component::Save(TSP_JsonHelper::IBufferWriterW& writer) const
+{
+    return (writer.StartObject() && SaveMembers(writer) && writer.EndObject());
+}
+//---------------------------------------------------------------------------
+bool TSP_Component::SaveMembers(TSP_JsonHelper::IBufferWriterW& writer) const
+{
+    // write the component identification, the uid is only used to resolve the links in the file
+    if (!writer.Key(L"uid") || !writer.Uint64(GetUID()))
+        return false;
+
+    if (!writer.Key(L"type") || !writer.Uint(unsigned(GetType())))
+        return false;
+
+    if (!TSP_JsonHelper::WriteMember(writer, L"title",       m_Title)       ||
+        !TSP_JsonHelper::WriteMember(writer, L"description", m_Description) ||
+        !TSP_JsonHelper::WriteMember(writer, L"comments",    m_Comments))
+        return false;
+
+    TSP_Page* pPage = GetAttributePage();
+
+    if (!pPage)
+        return true;
+
+    const TSP_AttributeStore* pAttributes = pPage->GetAttributes();
+    const std::size_t         row         = GetContainerIndex();
+          std::wstring        formulas[(std::size_t)TSP_Attribute::IEKey::IE_K_Count];
+          bool                hasFormula  = false;
+
+    if (!writer.Key(L"attributes") || !writer.StartObject())
+        return false;
+
+    // write the values, the formula results are skipped as they are calculated again on load
+    for (std::size_t i = (std::size_t)TSP_Attribute::IEKey::IE_K_Unknown + 1; i < (std::size_t)TSP_Attribute::IEKey::IE_K_Count; ++i)
+    {
+        const TSP_Attribute::IEKey key = TSP_Attribute::IEKey(i);
+
+        formulas[i] = GetFormula(key);
+
+        if (!formulas[i].empty())
+        {
+            hasFormula = true;
+            continue;
+        }
+
+        TSP_Attribute attribute;
+
+        if (!pAttributes->Get(row, key, attribute))
+            continue;
+
+        if (!TSP_JsonHelper::WriteKey(writer, TSP_AttributeSchema::GetName(key)) || !SaveValue(writer, attribute))
+            return false;
+    }
+
+    if (!writer.EndObject())
+        return false;
+
+    if (!hasFormula)
+        return true;
+
+    if (!writer.Key(L"formulas") || !writer.StartObject())
+        return false;
+
+    for (std::size_t i = (std::size_t)TSP_Attribute::IEKey::IE_K_Unknown + 1; i < (std::size_t)TSP_Attribute::IEKey::IE_K_Count; ++i)
+        if (!formulas[i].empty())
+            if (!TSP_JsonHelper::WriteMember(writer, TSP_AttributeSchema::GetName(TSP_Attribute::IEKey(i)).c_str(), formulas[i]))
+                return false;
+
+    return writer.EndObject();
+}
+//---------------------------------------------------------------------------
+TSP_Page* TSP_Component::GetAttributePage() const
+{
+    if (!m_pOwner || !m_pOwner->IsKindOf(IEType::IE_T_Page))
+        return nullptr;
+
+    TSP_Page* pPage = static_cast<TSP_Page*>(m_pOwner);
+
+    // the attributes are only available while the component is contained in its page
+    if (!pPage->Owns(this))
+        return nullptr;
+
+    return pPage;
+}
+//---------------------------------------------------------------------------
+bool TSP_Component::SaveValue(TSP_JsonHelper::IBufferWriterW& writer, const TSP_Attribute& attribute)
+{
+    switch (attribute.GetFormat())
+    {
+        case TSP_Attribute::IEFormat::IE_Bool:
+            return writer.Bool(attribute.Get(false));
+
+        case TSP_Attribute::IEFormat::IE_Int8:
+        case TSP_Attribute::IEFormat::IE_Int16:
+        case TSP_Attribute::IEFormat::IE_Int32:
+        case TSP_Attribute::IEFormat::IE_Int64:
+            return writer.Int64(attribute.Get(std::int64_t()));
+
+        case TSP_Attribute::IEFormat::IE_UInt8:
+        case TSP_Attribute::IEFormat::IE_UInt16:
+        case TSP_Attribute::IEFormat::IE_UInt32:
+        case TSP_Attribute::IEFormat::IE_UInt64:
+            return writer.Uint64(attribute.Get(std::uint64_t()));
+
+        case TSP_Attribute::IEFormat::IE_Float:
+        case TSP_Attribute::IEFormat::IE_Double:
+        {
+            const double value = attribute.Get(0.0);
+
+            // json has no representation for the infinite and nan values
+            if (!std::isfinite(value))
+                return writer.Null();
+
+            return writer.Double(value);
+        }
+
+        default:
+            // the strings and dates are written in their text form
+            return TSP_JsonHelper::Write(writer, attribute.Get(std::wstring()));
+    }
+}
+//---------------------------------------------------------------------------
@@ -29,6 +29,9 @@
 
 #pragma once
 
+// common classes
+#include "Common/TSP_JsonHelper.h"
+
 // core classes
 #include "TSP_Item.h"
 #include "TSP_Attribute.h"
@@ -63,6 +66,12 @@ class TSP_Component : public TSP_Item
 
         virtual ~TSP_Component();
 
+        /**
+        * Gets the component owner
+        *@return the component owner
+        */
+        virtual inline TSP_Item* GetOwner() const;
+
         /**
         * Gets the title
         *@return the title
@@ -102,14 +111,99 @@ class TSP_Component : public TSP_Item
         */
         virtual bool SetComments(const std::wstring& value);
 
+        /**
+        * Gets an attribute
+        *@param key - attribute key
+        *@return the attribute, in the key declared format, empty attribute if the component has no value for the key
+        *@note The attributes are stored in the owning page columns, a component not added in a page has no attribute
+        */
+        virtual TSP_Attribute GetAttribute(TSP_Attribute::IEKey key) const;
+
+        /**
+        * Sets an attribute
+        *@param key - attribute key
+        *@param value - attribute value, converted to the key declared format, or formula
+        *@return true on success, otherwise false
+        *@note The formula result is calculated immediately, and again each time a value it depends
+        *      on changes. Setting a value replaces the formula
+        */
+        virtual bool SetAttribute(TSP_Attribute::IEKey key, const TSP_Attribute& value);
+
+        /**
+        * Checks if the component has a value for an attribute
+        *@param key - attribute key
+        *@return true if the component has a value, otherwise false
+        */
+        virtual bool HasAttribute(TSP_Attribute::IEKey key) const;
+
+        /**
+        * Removes the value of an attribute
+        *@param key - attribute key
+        */
+        virtual void ResetAttribute(TSP_Attribute::IEKey key);
+
+        /**
+        * Gets the formula set on an attribute
+        *@param key - attribute key
+        *@return the formula, empty string if the attribute contains no formula
+        */
+        virtual std::wstring GetFormula(TSP_Attribute::IEKey key) const;
+
+        /**
+        * Marks the component, and its page, as modified
+        *@note The components created while their page content is read aren't marked
+        */
+        virtual void SetModified();
+
+        /**
+        * Saves the component
+        *@param writer - json writer to save to
+        *@return true on success, otherwise false
+        */
+        virtual bool Save(TSP_JsonHelper::IBufferWriterW& writer) const;
+
+        /**
+        * Gets the component index in its page type bucket
+        *@return the component index in its page type bucket
+        */
+        virtual inline std::size_t GetBucketIndex() const;
+
+        /**
+        * Sets the component index in its page type bucket
+        *@param index - the component index in its page type bucket
+        *@note This function should only be called by the page owning the component
+        */
+        virtual inline void SetBucketIndex(std::size_t index);
+
     protected:
         TSP_Item* m_pOwner = nullptr;
 
+        /**
+        * Saves the component members, without the object enclosing them
+        *@param writer - json writer to save to
+        *@return true on success, otherwise false
+        */
+        virtual bool SaveMembers(TSP_JsonHelper::IBufferWriterW& writer) const;
+
     private:
-        TSP_Attributes m_Attributes;
-        std::wstring   m_Title; // FIXME attribute?
-        std::wstring   m_Description; // FIXME attribute?
-        std::wstring   m_Comments; // FIXME attribute?
+        std::wstring m_Title; // FIXME attribute?
+        std::wstring m_Description; // FIXME attribute?
+        std::wstring m_Comments; // FIXME attribute?
+        std::size_t  m_BucketIndex = 0;
+
+        /**
+        * Gets the page containing the component attributes
+        *@return the page, nullptr if the component doesn't belong to a page
+        */
+        TSP_Page* GetAttributePage() const;
+
+        /**
+        * Saves an attribute value
+        *@param writer - json writer to save to
+        *@param attribute - attribute to save
+        *@return true on success, otherwise false
+        */
+        static bool SaveValue(TSP_JsonHelper::IBufferWriterW& writer, const TSP_Attribute& attribute);
 
         // FIXME
         /*
@@ -120,3 +214,22 @@ class TSP_Component : public TSP_Item
         TSP_Components m_ExitingSide;
         */
 };
+
+//---------------------------------------------------------------------------
+// TSP_Component
+//---------------------------------------------------------------------------
+TSP_Item* TSP_Component::GetOwner() const
+{
+    return m_pOwner;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_Component::GetBucketIndex() const
+{
+    return m_BucketIndex;
+}
+//---------------------------------------------------------------------------
+void TSP_Component::SetBucketIndex(std::size_t index)
+{
+    m_BucketIndex = index;
+}
+//---------------------------------------------------------------------------
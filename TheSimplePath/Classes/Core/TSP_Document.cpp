@@ -29,13 +29,26 @@
 
 #include "TSP_Document.h"
 
+// std
+#include <cstring>
+
  // common classes
 #include "Common/TSP_StringHelper.h"
 #include "Common/TSP_FileHelper.h"
 #include "Common/TSP_JsonHelper.h"
-#include "Common/TSP_StdFileBuffer.h"
+#include "Common/TSP_ChunkedBuffer.h"
+#include "Common/TSP_MappedFileBuffer.h"
 #include "Common/TSP_Logger.h"
 
+// core classes
+#include "TSP_Process.h"
+#include "TSP_DocumentReader.h"
+#include "TSP_BinaryDocumentReader.h"
+#include "TSP_BinaryDocumentWriter.h"
+#include "TSP_Journal.h"
+#include "TSP_DocumentSaver.h"
+#include "TSP_RevisionStore.h"
+
 //---------------------------------------------------------------------------
 // TSP_Document
 //---------------------------------------------------------------------------
@@ -64,11 +77,31 @@ void TSP_Document::Close()
 
     m_Atlases.clear();
 
+    // the pages were deleted, so the files they were read from may be closed
+    m_BinaryReaders.clear();
+
     // reset values to default
     m_Title.clear();
+    m_FileName.clear();
+    m_Modified  = false;
     m_DocStatus = TSP_Document::IEDocStatus::IE_DS_Closed;
 }
 //---------------------------------------------------------------------------
+void TSP_Document::SetModified()
+{
+    m_Modified = true;
+}
+//---------------------------------------------------------------------------
+void TSP_Document::ClearModified()
+{
+    m_Modified = false;
+
+    // only the modified atlases may contain modified pages
+    for (std::size_t i = 0; i < m_Atlases.size(); ++i)
+        if (m_Atlases[i]->IsModified())
+            m_Atlases[i]->ClearModified();
+}
+//---------------------------------------------------------------------------
 TSP_Atlas* TSP_Document::CreateAtlas()
 {
     return new TSP_Atlas(this);
@@ -82,14 +115,14 @@ TSP_Atlas* TSP_Document::CreateAtlas(const std::wstring& name)
 TSP_Atlas* TSP_Document::CreateAndAddAtlas()
 {
     std::unique_ptr<TSP_Atlas> pAtlas(CreateAtlas());
-    m_Atlases.push_back(pAtlas.get());
+    AddAtlas(pAtlas.get());
     return pAtlas.release();
 }
 //---------------------------------------------------------------------------
 TSP_Atlas* TSP_Document::CreateAndAddAtlas(const std::wstring& name)
 {
     std::unique_ptr<TSP_Atlas> pAtlas(CreateAtlas(name));
-    m_Atlases.push_back(pAtlas.get());
+    AddAtlas(pAtlas.get());
     return pAtlas.release();
 }
 //---------------------------------------------------------------------------
@@ -102,19 +135,26 @@ void TSP_Document::RemoveAtlas(std::size_t index)
     // delete the atlas
     delete m_Atlases[index];
     m_Atlases.erase(m_Atlases.begin() + index);
+
+    // keep the atlas order, and update the next atlas indexes
+    for (std::size_t i = index; i < m_Atlases.size(); ++i)
+        m_Atlases[i]->SetContainerIndex(i);
+
+    SetModified();
 }
 //---------------------------------------------------------------------------
 void TSP_Document::RemoveAtlas(TSP_Atlas* pAtlas)
 {
-    // search for atlas to remove
-    for (std::size_t i = 0; i < m_Atlases.size(); ++i)
-        // found it?
-        if (m_Atlases[i] == pAtlas)
-        {
-            // remove the atlas and exit
-            RemoveAtlas(i);
-            return;
-        }
+    if (!pAtlas)
+        return;
+
+    const std::size_t index = pAtlas->GetContainerIndex();
+
+    // is atlas owned by this document?
+    if (index >= m_Atlases.size() || m_Atlases[index] != pAtlas)
+        return;
+
+    RemoveAtlas(index);
 }
 //---------------------------------------------------------------------------
 TSP_Atlas* TSP_Document::GetAtlas(std::size_t index) const
@@ -125,15 +165,22 @@ TSP_Atlas* TSP_Document::GetAtlas(std::size_t index) const
     return m_Atlases[index];
 }
 //---------------------------------------------------------------------------
-TSP_Atlas* TSP_Document::GetAtlas(const std::string& uid) const
+TSP_Atlas* TSP_Document::GetAtlasByUID(TSP_Item::IUID uid) const
 {
-    // search for atlas matching with the uid
-    for (IAtlases::const_iterator it = m_Atlases.begin(); it != m_Atlases.end(); ++it)
-        // found it?
-        if ((*it)->GetUID() == uid)
-            return (*it);
+    // search for the item matching with the uid
+    TSP_Item* pItem = TSP_Item::Find(uid);
 
-    return nullptr;
+    // found it?
+    if (!pItem)
+        return nullptr;
+
+    const std::size_t index = pItem->GetContainerIndex();
+
+    // is item an atlas of this document?
+    if (index >= m_Atlases.size() || m_Atlases[index] != pItem)
+        return nullptr;
+
+    return m_Atlases[index];
 }
 //---------------------------------------------------------------------------
 std::size_t TSP_Document::GetAtlasCount() const
@@ -141,73 +188,397 @@ std::size_t TSP_Document::GetAtlasCount() const
     return m_Atlases.size();
 }
 //---------------------------------------------------------------------------
+TSP_AttributeStore::IAggregate TSP_Document::Aggregate(TSP_Attribute::IEKey key) const
+{
+    TSP_AttributeQuery::IPages pages;
+
+    for (std::size_t i = 0; i < m_Atlases.size(); ++i)
+        m_Atlases[i]->GetAllPages(pages);
+
+    return TSP_AttributeQuery::Aggregate(pages, key);
+}
+//---------------------------------------------------------------------------
+TSP_AttributeStore::IAggregate TSP_Document::Aggregate(TSP_Attribute::IEKey key, double low, double high) const
+{
+    TSP_AttributeQuery::IPages pages;
+
+    for (std::size_t i = 0; i < m_Atlases.size(); ++i)
+        m_Atlases[i]->GetAllPages(pages);
+
+    return TSP_AttributeQuery::Aggregate(pages, key, low, high);
+}
+//---------------------------------------------------------------------------
+void TSP_Document::AddAtlas(TSP_Atlas* pAtlas)
+{
+    pAtlas->SetContainerIndex(m_Atlases.size());
+    m_Atlases.push_back(pAtlas);
+
+    SetModified();
+}
+//---------------------------------------------------------------------------
 bool TSP_Document::Load(const std::wstring fileName)
 {
-    M_LogT("Load document - " << fileName);
+    M_LogFmtT(IO, Info, "Load document - {}", fileName);
 
-    //m_Title
+    // open the source file, its content is mapped in memory instead of being read
+    std::unique_ptr<TSP_MappedFileBuffer> pFile(new TSP_MappedFileBuffer());
 
-    /*
-    for each (auto pAtlas in m_Atlases)
-        pAtlas->Load();
-    */
+    if (!pFile->Open(fileName, TSP_FileBuffer::IEMode::IE_M_Read))
+    {
+        M_LogCatErrorT(IO, L"Load document - could not open the file - " << fileName);
+        return false;
+    }
+
+    // close the previously opened document
+    if (GetStatus() != IEDocStatus::IE_DS_Closed)
+        Close();
+
+    SetStatus(IEDocStatus::IE_DS_Opening);
+
+    // revision? Its pages are stored in separate files, read later like a binary document pages
+    if (TSP_RevisionStore::IsRevision(pFile->GetData(), pFile->GetSize()))
+    {
+        pFile.reset();
+
+        if (!TSP_RevisionStore::Read(fileName, this))
+        {
+            M_LogCatErrorT(IO, L"Load document - invalid revision - " << fileName);
+            Close();
+            SetStatus(IEDocStatus::IE_DS_Error);
+            return false;
+        }
+
+        // the revision pages aren't contained in a document file, so the next save writes it in full
+        ClearModified();
+        m_FileName.clear();
+        SetStatus(IEDocStatus::IE_DS_Opened);
+
+        // the next modifications are recorded from the loaded revision
+        if (m_pJournal)
+            m_pJournal->Reset(fileName);
+
+        return true;
+    }
+
+    // binary document? Only its page list is read, the file remains opened to read the pages later
+    if (TSP_BinaryDocumentReader::IsBinary(pFile->GetData(), pFile->GetSize()))
+    {
+        std::unique_ptr<TSP_BinaryDocumentReader> pReader(new TSP_BinaryDocumentReader(this));
+
+        if (!pReader->Open(std::move(pFile)))
+        {
+            M_LogCatErrorT(IO, L"Load document - invalid document - " << fileName);
+            Close();
+            SetStatus(IEDocStatus::IE_DS_Error);
+            return false;
+        }
+
+        m_BinaryReaders.push_back(std::move(pReader));
+
+        // the document matches its file, which may be updated in place
+        ClearModified();
+        m_FileName = fileName;
+        SetStatus(IEDocStatus::IE_DS_Opened);
+
+        // the next modifications are recorded from the loaded document
+        if (m_pJournal)
+            m_pJournal->Reset(fileName);
+
+        return true;
+    }
+
+    // copy the json content. NOTE this copy is modified while parsed, as the reader decodes the
+    // strings in place
+    const std::size_t size = pFile->GetSize();
+    std::vector<char> content(size + 1);
+
+    // the whole content is copied at once, so it may be read ahead
+    pFile->Advise(TSP_MappedFileBuffer::IEAccess::IE_A_Sequential);
+
+    if (size)
+        std::memcpy(content.data(), pFile->GetData(), size);
+
+    content[size] = '\0';
+
+    pFile.reset();
+
+    TSP_DocumentReader reader(this);
+
+    // build the document while its content is parsed
+    if (!reader.Read(content.data()))
+    {
+        M_LogCatErrorT(IO, L"Load document - invalid document - " << fileName);
+        Close();
+        SetStatus(IEDocStatus::IE_DS_Error);
+        return false;
+    }
+
+    ClearModified();
+    m_FileName = fileName;
+    SetStatus(IEDocStatus::IE_DS_Opened);
+
+    // the next modifications are recorded from the loaded document
+    if (m_pJournal)
+        m_pJournal->Reset(fileName);
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Document::LoadPages(TSP_Atlas* pAtlas, const std::wstring& fileName)
+{
+    if (!pAtlas || pAtlas->GetOwner() != this)
+        return false;
+
+    std::unique_ptr<TSP_MappedFileBuffer> pFile(new TSP_MappedFileBuffer());
+
+    if (!pFile->Open(fileName, TSP_FileBuffer::IEMode::IE_M_Read))
+    {
+        M_LogCatErrorT(IO, L"Load pages - could not open the file - " << fileName);
+        return false;
+    }
+
+    std::unique_ptr<TSP_BinaryDocumentReader> pReader(new TSP_BinaryDocumentReader(this));
+
+    // the added pages are located in another file, so the next save writes the document in full
+    m_FileName.clear();
+
+    if (!pReader->OpenPages(std::move(pFile), pAtlas))
+    {
+        M_LogCatErrorT(IO, L"Load pages - invalid document - " << fileName);
+
+        // the pages already added may still be read from the file
+        m_BinaryReaders.push_back(std::move(pReader));
+        return false;
+    }
+
+    m_BinaryReaders.push_back(std::move(pReader));
 
     return true;
 }
 //---------------------------------------------------------------------------
-bool TSP_Document::Save(const std::wstring fileName) const
+bool TSP_Document::Save(const std::wstring fileName)
 {
-    M_LogT("Save document - " << fileName);
+    M_LogFmtT(IO, Info, "Save document - {}", fileName);
+
+    // nothing to save?
+    if (!IsModified() && fileName == m_FileName)
+        return true;
 
     if (TSP_FileHelper::FileExists(fileName))
     {
         // todo FIXME -cFeature -oJean: ask Qt to show a popup to overwrite the file and fail if user rejects the overwrite
     }
 
-    // create a json document
-    auto pJsonDoc = std::make_unique<TSP_JsonHelper::IDocumentW>();
-    pJsonDoc->SetObject();
+    IPageHandles handles;
+    bool         saved = false;
+
+    // binary document saved to its own file? Only its modifications are appended to it
+    if (IsBinary(fileName) && fileName == m_FileName)
+    {
+        TSP_ChunkedBuffer content;
+        TSP_ChunkedBuffer header;
+        std::uint64_t     offset = 0;
+
+        if (WriteUpdate(&content, offset, &header, &handles))
+        {
+            if (!TSP_DocumentSaver::UpdateFile(content, offset, header, fileName))
+            {
+                M_LogCatErrorT(IO, L"Save document - failed to update the file - " << fileName);
+                NotifySaveFailed();
+                return false;
+            }
 
-    // create document title value
-    TSP_JsonHelper::IValueW title;
-    title.SetString(TSP_JsonHelper::IStringRefW(m_Title.c_str()));
+            saved = true;
+        }
+        else
+            handles.clear();
+    }
 
-    // set document title
-    pJsonDoc->AddMember(L"title", title, pJsonDoc->GetAllocator());
+    if (!saved)
+    {
+        // the destination may be the opened file, so the pages still not read should be read before,
+        // otherwise they would be lost when the file is overwritten
+        if (!ReadAllPages())
+        {
+            M_LogCatErrorT(IO, L"Save document - some pages could not be read - " << fileName);
+            return false;
+        }
 
-    /*REM
-    TSP_JsonHelper::IValueW documentValue(rapidjson::kObjectType);
-    documentValue.AddMember(L"title2", TSP_JsonHelper::IStringRefW(L"m_Title2"), pJsonDoc->GetAllocator());
+        // the document is written in memory first, so the existing file isn't truncated if it fails,
+        // and the memory chunks are then written to the file at once
+        TSP_ChunkedBuffer buffer;
 
-    pJsonDoc->AddMember(L"document", documentValue, pJsonDoc->GetAllocator());
-    */
+        if (!Write(&buffer, IsBinary(fileName), &handles))
+        {
+            M_LogCatErrorT(IO, L"Save document - failed to write the document - " << fileName);
+            return false;
+        }
 
-    /*
-    for each (auto pAtlas in m_Atlases)
-        pAtlas->Save();
-    */
+        if (!TSP_DocumentSaver::WriteFile(buffer, fileName))
+        {
+            M_LogCatErrorT(IO, L"Save document - failed to write the file - " << fileName);
+            NotifySaveFailed();
+            return false;
+        }
+    }
+
+    ClearModified();
+    NotifySaved(fileName, handles);
+
+    // the saved modifications no longer need to be recovered
+    if (m_pJournal)
+        m_pJournal->Reset(fileName);
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Document::Write(TSP_Buffer* pBuffer, bool binary, IPageHandles* pHandles) const
+{
+    if (!pBuffer)
+        return false;
+
+    // binary document?
+    if (binary)
+    {
+        TSP_BinaryDocumentWriter writer(pBuffer);
+
+        if (!writer.Write(this))
+            return false;
+
+        if (pHandles)
+            *pHandles = writer.GetPageHandles();
+
+        return true;
+    }
+
+    // the document is streamed to the buffer while walking through it, no intermediate json document
+    // or string is built, and the output is written in large blocks through the stream cache
+    TSP_JsonHelper::IBufferStream  stream(pBuffer);
+    TSP_JsonHelper::IBufferWriterW writer(stream);
+
+    bool success = writer.StartObject()                                   &&
+                   TSP_JsonHelper::WriteMember(writer, L"title", m_Title) &&
+                   writer.Key(L"atlases")                                 &&
+                   writer.StartArray();
+
+    for (std::size_t i = 0; success && i < m_Atlases.size(); ++i)
+        success = m_Atlases[i]->Save(writer);
+
+    success = success && writer.EndArray() && writer.EndObject();
+
+    stream.Flush();
+
+    return success && !stream.HasFailed();
+}
+//---------------------------------------------------------------------------
+bool TSP_Document::WriteUpdate(TSP_Buffer*    pBuffer,
+                               std::uint64_t& offset,
+                               TSP_Buffer*    pHeader,
+                               IPageHandles*  pHandles) const
+{
+    if (!pBuffer || !pHeader)
+        return false;
 
-    TSP_JsonHelper::IStringBufferW       stringBuffer;
-    TSP_JsonHelper::IStringBufferWriterW stringBufferWriter(stringBuffer);
-    pJsonDoc->Accept(stringBufferWriter);
+    // the document doesn't match a binary file?
+    if (m_FileName.empty() || !IsBinary(m_FileName))
+        return false;
 
-    const wchar_t* pOutput = stringBuffer.GetString();
+    TSP_MappedFileBuffer file;
 
-    /*REM
-    std::ofstream ofs("output.json");
-    rapidjson::OStreamWrapper osw(ofs);
+    // the current file content is mapped, only its header and string table are read
+    if (!file.Open(m_FileName, TSP_FileBuffer::IEMode::IE_M_Read))
+        return false;
 
-    rapidjson::Writer<rapidjson::OStreamWrapper> writer(osw);
-    pJsonDoc->Accept(writer);
-    */
+    TSP_BinaryDocumentWriter          writer(pBuffer);
+    TSP_BinaryDocumentFormat::IHeader header;
 
-    /*
-    // write the json content to the file
-    auto pFileBuffer = std::make_unique<TSP_StdFileBuffer>;
-    pFileBuffer->Open(fileName, TSP_FileBuffer::IEMode::IE_M_Write);
-    pFileBuffer->Write(buffer.GetString(), buffer.GetSize());
-    */
+    if (!writer.Update(this, file.GetData(), file.GetSize(), offset, header))
+        return false;
+
+    if (pHeader->Write(&header, sizeof(header)) != sizeof(header))
+        return false;
+
+    if (pHandles)
+        *pHandles = writer.GetPageHandles();
 
     return true;
 }
 //---------------------------------------------------------------------------
+void TSP_Document::NotifySaved(const std::wstring& fileName, const IPageHandles& handles)
+{
+    m_FileName = fileName;
+
+    // the written pages are now located in the saved file. NOTE a page may have been deleted
+    // since it was written, if the document was saved in background
+    for (std::size_t i = 0; i < handles.size(); ++i)
+    {
+        TSP_Item* pItem = TSP_Item::Find(handles[i].m_UID);
+
+        if (pItem && pItem->GetType() == TSP_Item::IEType::IE_T_Page)
+            static_cast<TSP_Page*>(pItem)->SetContentHandle(handles[i].m_Handle);
+    }
+}
+//---------------------------------------------------------------------------
+void TSP_Document::NotifySaveFailed()
+{
+    // the file content is unknown, so it will be written again in full
+    m_FileName.clear();
+    SetModified();
+}
+//---------------------------------------------------------------------------
+bool TSP_Document::IsBinary(const std::wstring& fileName)
+{
+    return TSP_StringHelper::ToLowerCase(TSP_FileHelper::GetFileExtension(fileName)) == L"tspb";
+}
+//---------------------------------------------------------------------------
+bool TSP_Document::ReadAllPages() const
+{
+    if (m_BinaryReaders.empty())
+        return true;
+
+    TSP_AttributeQuery::IPages pages;
+
+    for (std::size_t i = 0; i < m_Atlases.size(); ++i)
+        for (std::size_t j = 0; j < m_Atlases[i]->GetPageCount(); ++j)
+            pages.push_back(m_Atlases[i]->GetPage(j));
+
+    bool success = true;
+
+    // the sub-process pages are only known once their parent page is read, so each level is read
+    // before the next one is collected
+    while (!pages.empty())
+    {
+        // NOTE each page is read from its own source, so any reader may dispatch them
+        success = m_BinaryReaders.front()->ReadPages(pages) && success;
+
+        TSP_AttributeQuery::IPages subPages;
+
+        for (std::size_t i = 0; i < pages.size(); ++i)
+        {
+            const std::size_t processCount = pages[i]->GetCountOf(TSP_Item::IEType::IE_T_Process);
+
+            for (std::size_t j = 0; j < processCount; ++j)
+            {
+                const TSP_Process* pProcess = static_cast<TSP_Process*>(pages[i]->GetOf(TSP_Item::IEType::IE_T_Process, j));
+
+                for (std::size_t k = 0; k < pProcess->GetPageCount(); ++k)
+                    subPages.push_back(pProcess->GetPage(k));
+            }
+        }
+
+        pages.swap(subPages);
+    }
+
+    m_BinaryReaders.clear();
+
+    return success;
+}
+//---------------------------------------------------------------------------
+bool TSP_Document::CanReadPagesInParallel() const
+{
+    return true;
+}
+//---------------------------------------------------------------------------
+void TSP_Document::NotifyPagesRead(const TSP_AttributeQuery::IPages&)
+{}
+//---------------------------------------------------------------------------
@@ -30,11 +30,19 @@
 #pragma once
 
  // std
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 // core classes
 #include "TSP_Atlas.h"
 #include "TSP_Page.h"
+#include "TSP_AttributeQuery.h"
+
+// class prototypes
+class TSP_BinaryDocumentReader;
+class TSP_Journal;
+class TSP_Buffer;
 
 /**
 * The main resource and process manager document
@@ -56,6 +64,17 @@ class TSP_Document
             IE_DS_Error
         };
 
+        /**
+        * Location of a page content in a binary document file
+        */
+        struct IPageHandle
+        {
+            TSP_Item::IUID m_UID    = 0;
+            std::uint64_t  m_Handle = 0;
+        };
+
+        typedef std::vector<IPageHandle> IPageHandles;
+
         TSP_Document();
 
         /**
@@ -101,6 +120,43 @@ class TSP_Document
         */
         virtual inline void SetTitle(const std::wstring& title);
 
+        /**
+        * Checks if the document was modified since it was loaded or saved
+        *@return true if the document was modified, otherwise false
+        */
+        virtual inline bool IsModified() const;
+
+        /**
+        * Marks the document as modified
+        *@note Called by the atlases when they, or their pages, are modified
+        */
+        virtual void SetModified();
+
+        /**
+        * Marks the document and all its items as unmodified
+        */
+        virtual void ClearModified();
+
+        /**
+        * Gets the file name the document was loaded from or last saved to
+        *@return the file name, empty if the document content doesn't match a file
+        */
+        virtual inline std::wstring GetFileName() const;
+
+        /**
+        * Gets the journal recording the document modifications
+        *@return the journal, nullptr if the modifications aren't recorded
+        */
+        virtual inline TSP_Journal* GetJournal() const;
+
+        /**
+        * Sets the journal recording the document modifications
+        *@param pJournal - the journal, nullptr to stop recording the modifications
+        *@note The journal isn't owned by the document, it is reset each time the document is loaded
+        *      or saved
+        */
+        virtual inline void SetJournal(TSP_Journal* pJournal);
+
         /**
         * Creates an atlas
         *@return newly created atlas
@@ -151,7 +207,7 @@ class TSP_Document
         *@param uid - atlas unique identifier to get
         *@return atlas, nullptr if not found or on error
         */
-        virtual TSP_Atlas* GetAtlas(const std::string& uid) const;
+        virtual TSP_Atlas* GetAtlasByUID(TSP_Item::IUID uid) const;
 
         /**
         * Gets atlas count
@@ -159,28 +215,142 @@ class TSP_Document
         */
         virtual std::size_t GetAtlasCount() const;
 
+        /**
+        * Aggregates the values of an attribute over all the document pages, including the sub-process pages
+        *@param key - attribute key
+        *@return the count of values, and for the numeric formats their sum, minimum and maximum
+        */
+        virtual TSP_AttributeStore::IAggregate Aggregate(TSP_Attribute::IEKey key) const;
+
+        /**
+        * Aggregates the values of an attribute contained in a range over all the document pages, including
+        * the sub-process pages
+        *@param key - attribute key
+        *@param low - lowest value to aggregate
+        *@param high - highest value to aggregate
+        *@return the count, sum, minimum and maximum of the values contained in the range
+        */
+        virtual TSP_AttributeStore::IAggregate Aggregate(TSP_Attribute::IEKey key, double low, double high) const;
+
         /**
         * Loads a document from a file
         *@param fileName - document file name
         *@return true on success, otherwise false
+        *@note The binary documents are opened without reading their pages, each page is read the first
+        *      time it is accessed. A revision file, written by TSP_RevisionStore, may also be loaded
         */
         // todo FIXME -cFeature -oJean: select a data type, see: https://doc.qt.io/qt-5/topics-data-storage.html
         virtual bool Load(const std::wstring fileName);
 
+        /**
+        * Loads the pages of a binary document file into an atlas of this document
+        *@param pAtlas - atlas to add the pages to, should belong to this document
+        *@param fileName - binary document file name
+        *@return true on success, otherwise false
+        *@note Like while a binary document is loaded, each page is read the first time it is accessed,
+        *      so the file remains opened until the document is closed or all its pages are read
+        */
+        virtual bool LoadPages(TSP_Atlas* pAtlas, const std::wstring& fileName);
+
+        /**
+        * Reads all the pages still not read from the opened binary files, and closes them
+        *@return true on success, otherwise false
+        *@note The pages are read level by level, the pages of a level being read in parallel. The file
+        *      should be closed before it may be overwritten
+        */
+        virtual bool ReadAllPages() const;
+
+        /**
+        * Checks if the document pages may be filled from several threads at once
+        *@return true if the pages may be filled in parallel, otherwise false
+        */
+        virtual bool CanReadPagesInParallel() const;
+
+        /**
+        * Notifies that pages were read from the opened binary files
+        *@param pages - read pages
+        *@note Called on the thread which requested the pages, once they are all read
+        */
+        virtual void NotifyPagesRead(const TSP_AttributeQuery::IPages& pages);
+
         /**
         * Saves a document to a file
-        *@param fileName - document file name
+        *@param fileName - document file name, the document is written in the binary format if its
+        *                  extension is .tspb, otherwise in json
         *@return true on success, otherwise false
+        *@note The file is written to a temporary file first, which then replaces it. A binary document
+        *      saved to the file it was loaded from is instead updated in place, only its modified pages
+        *      being appended to it. Nothing is written if the document wasn't modified. To save in
+        *      background, see TSP_DocumentSaver
         */
         // todo FIXME -cFeature -oJean: select a data type, see: https://doc.qt.io/qt-5/topics-data-storage.html
-        virtual bool Save(const std::wstring fileName) const;
+        virtual bool Save(const std::wstring fileName);
+
+        /**
+        * Writes the document content to a buffer
+        *@param pBuffer - buffer to write to
+        *@param binary - if true the document is written in the binary format, otherwise in json
+        *@param[out] pHandles - if not nullptr, receives the page content locations, binary format only
+        *@return true on success, otherwise false
+        *@note The pages still not read from the opened binary file aren't written, they should be
+        *      read before, see ReadAllPages()
+        */
+        virtual bool Write(TSP_Buffer* pBuffer, bool binary, IPageHandles* pHandles = nullptr) const;
+
+        /**
+        * Writes the document modifications to append to the binary file it was loaded from or last
+        * saved to
+        *@param pBuffer - buffer to write the content to append to
+        *@param[out] offset - file offset to write the content to
+        *@param pHeader - buffer to write the new file header to, to write at the file start once the
+        *                 content is written
+        *@param[out] pHandles - if not nullptr, receives the locations of the written page contents
+        *@return true on success, false if the file can't be updated and should be written in full
+        *@note The unmodified pages aren't written, nor read if they still weren't
+        */
+        virtual bool WriteUpdate(TSP_Buffer*    pBuffer,
+                                 std::uint64_t& offset,
+                                 TSP_Buffer*    pHeader,
+                                 IPageHandles*  pHandles = nullptr) const;
+
+        /**
+        * Notifies that the document was saved
+        *@param fileName - file name the document was saved to
+        *@param handles - locations of the page contents written to the file, binary format only
+        *@note The document should be marked as unmodified since it was written
+        */
+        virtual void NotifySaved(const std::wstring& fileName, const IPageHandles& handles);
+
+        /**
+        * Notifies that the document could not be saved
+        *@note The document is marked as modified, and its next save rewrites the file in full
+        */
+        virtual void NotifySaveFailed();
+
+        /**
+        * Checks if a document file name designates the binary format
+        *@param fileName - document file name
+        *@return true if the file extension is .tspb, otherwise false
+        */
+        static bool IsBinary(const std::wstring& fileName);
 
     private:
-        typedef std::vector<TSP_Atlas*> IAtlases;
+        typedef std::vector<TSP_Atlas*>                                IAtlases;
+        typedef std::vector<std::unique_ptr<TSP_BinaryDocumentReader>> IBinaryReaders;
+
+        IAtlases                                          m_Atlases;
+        std::wstring                                      m_Title;
+        IEDocStatus                                       m_DocStatus = IEDocStatus::IE_DS_Closed;
+        mutable IBinaryReaders                            m_BinaryReaders;
+        TSP_Journal*                                      m_pJournal  = nullptr;
+        std::wstring                                      m_FileName;
+        bool                                              m_Modified  = false;
 
-        IAtlases     m_Atlases;
-        std::wstring m_Title;
-        IEDocStatus  m_DocStatus = IEDocStatus::IE_DS_Closed;
+        /**
+        * Adds an atlas at the end of the atlas list
+        *@param pAtlas - atlas to add
+        */
+        void AddAtlas(TSP_Atlas* pAtlas);
 };
 
 //---------------------------------------------------------------------------
@@ -204,5 +374,26 @@ std::wstring TSP_Document::GetTitle() const
 void TSP_Document::SetTitle(const std::wstring& title)
 {
     m_Title = title;
+    SetModified();
+}
+//---------------------------------------------------------------------------
+bool TSP_Document::IsModified() const
+{
+    return m_Modified;
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_Document::GetFileName() const
+{
+    return m_FileName;
+}
+//---------------------------------------------------------------------------
+TSP_Journal* TSP_Document::GetJournal() const
+{
+    return m_pJournal;
+}
+//---------------------------------------------------------------------------
+void TSP_Document::SetJournal(TSP_Journal* pJournal)
+{
+    m_pJournal = pJournal;
 }
 //---------------------------------------------------------------------------
@@ -0,0 +1,593 @@
+/****************************************************************************
+ * ==> TSP_DocumentReader --------------------------------------------------*
+ ****************************************************************************
+ * Description:  Document reader, builds a document while parsing it        *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_DocumentReader.h"
+
+// std
+#include <cstring>
+
+// common classes
+#include "Common/TSP_StringHelper.h"
+#include "Common/TSP_Logger.h"
+
+// core classes
+#include "TSP_AttributeSchema.h"
+#include "TSP_Document.h"
+#include "TSP_Process.h"
+
+//---------------------------------------------------------------------------
+// TSP_DocumentReader
+//---------------------------------------------------------------------------
+TSP_DocumentReader::TSP_DocumentReader(TSP_Document* pDocument) :
+    m_pDocument(pDocument)
+{}
+//---------------------------------------------------------------------------
+TSP_DocumentReader::~TSP_DocumentReader()
+{}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::Read(char* pData)
+{
+    if (!m_pDocument || !pData)
+        return false;
+
+    m_Frames.clear();
+    m_LinkEnds.clear();
+    m_Formulas.clear();
+    m_UIDs.clear();
+    m_SkipDepth = 0;
+    m_DataSize  = std::strlen(pData);
+
+    // the root frame receives the document object
+    m_Frames.push_back(IFrame());
+
+    TSP_JsonHelper::IInsituStream stream(pData);
+    TSP_JsonHelper::IReader       reader;
+
+    // the iterative parser keeps its state on the heap, so a deeply nested content cannot overflow the stack
+    if (!reader.Parse<rapidjson::kParseInsituFlag | rapidjson::kParseIterativeFlag>(stream, *this))
+    {
+        M_LogCatErrorT(IO, L"Read document - invalid content - error " << (int)reader.GetParseErrorCode()
+                           << L" at offset "                           << reader.GetErrorOffset());
+        return false;
+    }
+
+    return Resolve();
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::Null()
+{
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::Bool(bool value)
+{
+    return ReadValue(TSP_Attribute(value));
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::Int(int value)
+{
+    return Int64(value);
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::Uint(unsigned value)
+{
+    return Uint64(value);
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::Int64(std::int64_t value)
+{
+    return ReadValue(TSP_Attribute(value));
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::Uint64(std::uint64_t value)
+{
+    if (m_SkipDepth)
+        return true;
+
+    if (m_Frames.back().m_Context == IEContext::IE_C_Attributes)
+        return ReadValue(TSP_Attribute(value));
+
+    return ReadNumber(value);
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::Double(double value)
+{
+    return ReadValue(TSP_Attribute(value));
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::RawNumber(const char*, rapidjson::SizeType, bool)
+{
+    // only called if the numbers are parsed as strings, which is never the case
+    return false;
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::String(const char* pStr, rapidjson::SizeType length, bool)
+{
+    if (m_SkipDepth)
+        return true;
+
+    IFrame& frame = m_Frames.back();
+
+    switch (frame.m_Context)
+    {
+        case IEContext::IE_C_Document:
+            if (m_Member == IEMember::IE_M_Title)
+                m_pDocument->SetTitle(TSP_StringHelper::Utf8ToUtf16(std::string(pStr, length)));
+
+            return true;
+
+        case IEContext::IE_C_Atlas:
+            if (m_Member == IEMember::IE_M_Name)
+                frame.m_pAtlas->SetName(TSP_StringHelper::Utf8ToUtf16(std::string(pStr, length)));
+
+            return true;
+
+        case IEContext::IE_C_Page:
+            if (m_Member == IEMember::IE_M_Name)
+                frame.m_pPage->SetName(TSP_StringHelper::Utf8ToUtf16(std::string(pStr, length)));
+
+            return true;
+
+        case IEContext::IE_C_Component:
+        {
+            std::wstring* pValue;
+
+            switch (m_Member)
+            {
+                case IEMember::IE_M_Title:       pValue = &m_Component.m_Title;       break;
+                case IEMember::IE_M_Description: pValue = &m_Component.m_Description; break;
+                case IEMember::IE_M_Comments:    pValue = &m_Component.m_Comments;    break;
+                default:                         return true;
+            }
+
+            *pValue = TSP_StringHelper::Utf8ToUtf16(std::string(pStr, length));
+
+            // the component was already created, e.g. if its texts follow its attributes
+            if (frame.m_pComponent)
+                switch (m_Member)
+                {
+                    case IEMember::IE_M_Title:       frame.m_pComponent->SetTitle(*pValue);       break;
+                    case IEMember::IE_M_Description: frame.m_pComponent->SetDescription(*pValue); break;
+                    default:                         frame.m_pComponent->SetComments(*pValue);    break;
+                }
+
+            return true;
+        }
+
+        case IEContext::IE_C_Attributes:
+            // the value is converted from its text form to the key declared format
+            return ReadValue(TSP_Attribute(std::string(pStr, length)));
+
+        case IEContext::IE_C_Formulas:
+        {
+            if (!TSP_AttributeSchema::IsValid(m_Key))
+                return true;
+
+            IFormula formula;
+            formula.m_pComponent = frame.m_pComponent;
+            formula.m_Key        = m_Key;
+            formula.m_Formula    = TSP_StringHelper::Utf8ToUtf16(std::string(pStr, length));
+
+            m_Formulas.push_back(std::move(formula));
+            return true;
+        }
+
+        default:
+            return true;
+    }
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::StartObject()
+{
+    if (m_SkipDepth)
+    {
+        ++m_SkipDepth;
+        return true;
+    }
+
+    IFrame& frame = m_Frames.back();
+    IFrame  child;
+
+    switch (frame.m_Context)
+    {
+        case IEContext::IE_C_Root:
+            child.m_Context = IEContext::IE_C_Document;
+            break;
+
+        case IEContext::IE_C_Atlases:
+            child.m_Context    = IEContext::IE_C_Atlas;
+            child.m_pAtlas     = m_pDocument->CreateAndAddAtlas();
+            child.m_pContainer = child.m_pAtlas;
+            break;
+
+        case IEContext::IE_C_Pages:
+            child.m_Context = IEContext::IE_C_Page;
+            child.m_pPage   = frame.m_pContainer->CreateAndAddPage();
+            break;
+
+        case IEContext::IE_C_Components:
+            child.m_Context = IEContext::IE_C_Component;
+            child.m_pPage   = frame.m_pPage;
+            m_Component     = IComponentInfo();
+            break;
+
+        case IEContext::IE_C_Component:
+        {
+            if (m_Member != IEMember::IE_M_Attributes && m_Member != IEMember::IE_M_Formulas &&
+                m_Member != IEMember::IE_M_Start      && m_Member != IEMember::IE_M_End)
+            {
+                m_SkipDepth = 1;
+                return true;
+            }
+
+            TSP_Component* pComponent = CreateComponent(frame);
+
+            if (!pComponent)
+                return false;
+
+            child.m_pPage      = frame.m_pPage;
+            child.m_pComponent = pComponent;
+
+            switch (m_Member)
+            {
+                case IEMember::IE_M_Attributes: child.m_Context = IEContext::IE_C_Attributes; break;
+                case IEMember::IE_M_Formulas:   child.m_Context = IEContext::IE_C_Formulas;   break;
+
+                default:
+                    // only the links have ends
+                    if (!pComponent->IsKindOf(TSP_Item::IEType::IE_T_Link))
+                    {
+                        m_SkipDepth = 1;
+                        return true;
+                    }
+
+                    child.m_Context   = IEContext::IE_C_LinkEnd;
+                    m_LinkEnd         = ILinkEnd();
+                    m_LinkEnd.m_pLink = static_cast<TSP_Link*>(pComponent);
+                    m_LinkEnd.m_Start = (m_Member == IEMember::IE_M_Start);
+                    break;
+            }
+
+            break;
+        }
+
+        default:
+            m_SkipDepth = 1;
+            return true;
+    }
+
+    // failed to create the item?
+    if ((child.m_Context == IEContext::IE_C_Atlas && !child.m_pAtlas) ||
+        (child.m_Context == IEContext::IE_C_Page  && !child.m_pPage))
+        return false;
+
+    m_Frames.push_back(child);
+    m_Member = IEMember::IE_M_Unknown;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::Key(const char* pStr, rapidjson::SizeType length, bool)
+{
+    if (m_SkipDepth)
+        return true;
+
+    switch (m_Frames.back().m_Context)
+    {
+        case IEContext::IE_C_Attributes:
+        case IEContext::IE_C_Formulas:
+            m_Key = TSP_AttributeSchema::Find(pStr, length);
+            break;
+
+        default:
+            m_Member = GetMember(pStr, length);
+            break;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::EndObject(rapidjson::SizeType)
+{
+    if (m_SkipDepth)
+    {
+        --m_SkipDepth;
+        return true;
+    }
+
+    IFrame& frame = m_Frames.back();
+
+    switch (frame.m_Context)
+    {
+        case IEContext::IE_C_Component:
+            // a component containing no attribute is only created once all its values are known
+            if (!CreateComponent(frame))
+                return false;
+
+            break;
+
+        case IEContext::IE_C_LinkEnd:
+            m_LinkEnds.push_back(m_LinkEnd);
+            break;
+
+        default:
+            break;
+    }
+
+    m_Frames.pop_back();
+    m_Member = IEMember::IE_M_Unknown;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::StartArray()
+{
+    if (m_SkipDepth)
+    {
+        ++m_SkipDepth;
+        return true;
+    }
+
+    IFrame& frame = m_Frames.back();
+    IFrame  child;
+
+    if (frame.m_Context == IEContext::IE_C_Document && m_Member == IEMember::IE_M_Atlases)
+        child.m_Context = IEContext::IE_C_Atlases;
+    else
+    if (frame.m_Context == IEContext::IE_C_Atlas && m_Member == IEMember::IE_M_Pages)
+    {
+        child.m_Context    = IEContext::IE_C_Pages;
+        child.m_pContainer = frame.m_pContainer;
+    }
+    else
+    if (frame.m_Context == IEContext::IE_C_Page && m_Member == IEMember::IE_M_Components)
+    {
+        child.m_Context = IEContext::IE_C_Components;
+        child.m_pPage   = frame.m_pPage;
+    }
+    else
+    if (frame.m_Context == IEContext::IE_C_Component && m_Member == IEMember::IE_M_Pages)
+    {
+        TSP_Component* pComponent = CreateComponent(frame);
+
+        if (!pComponent)
+            return false;
+
+        // only the processes contain pages
+        if (!pComponent->IsKindOf(TSP_Item::IEType::IE_T_Process))
+        {
+            m_SkipDepth = 1;
+            return true;
+        }
+
+        child.m_Context    = IEContext::IE_C_Pages;
+        child.m_pContainer = static_cast<TSP_Process*>(pComponent);
+    }
+    else
+    {
+        m_SkipDepth = 1;
+        return true;
+    }
+
+    m_Frames.push_back(child);
+    m_Member = IEMember::IE_M_Unknown;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::EndArray(rapidjson::SizeType)
+{
+    if (m_SkipDepth)
+    {
+        --m_SkipDepth;
+        return true;
+    }
+
+    m_Frames.pop_back();
+    m_Member = IEMember::IE_M_Unknown;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::ReadNumber(std::uint64_t value)
+{
+    IFrame& frame = m_Frames.back();
+
+    switch (frame.m_Context)
+    {
+        case IEContext::IE_C_Page:
+            // reserve the page memory before its components are read. NOTE the count is only a hint read
+            // from the file, each component takes at least 2 chars ({}), so never reserve more than the
+            // content may contain
+            if (m_Member == IEMember::IE_M_Count)
+                frame.m_pPage->Reserve(std::size_t(value < m_DataSize / 2 ? value : m_DataSize / 2));
+
+            return true;
+
+        case IEContext::IE_C_Component:
+            if (m_Member == IEMember::IE_M_UID)
+                m_Component.m_UID = value;
+            else
+            if (m_Member == IEMember::IE_M_Type && !frame.m_pComponent)
+            {
+                if (value >= std::uint64_t(TSP_Item::IEType::IE_T_Count))
+                    return false;
+
+                m_Component.m_Type = TSP_Item::IEType(value);
+            }
+
+            return true;
+
+        case IEContext::IE_C_LinkEnd:
+            if (m_Member == IEMember::IE_M_Box)
+                m_LinkEnd.m_Box = value;
+            else
+            if (m_Member == IEMember::IE_M_Side && value <= std::uint64_t(TSP_LinkGraph::IESide::IE_S_Bottom))
+                m_LinkEnd.m_Side = TSP_LinkGraph::IESide(value);
+
+            return true;
+
+        default:
+            return true;
+    }
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::ReadValue(const TSP_Attribute& value)
+{
+    if (m_SkipDepth)
+        return true;
+
+    const IFrame& frame = m_Frames.back();
+
+    if (frame.m_Context != IEContext::IE_C_Attributes || !TSP_AttributeSchema::IsValid(m_Key))
+        return true;
+
+    // the formulas are set once the whole content is read, so the values may be written directly in the
+    // page store, without notifying the calculator
+    frame.m_pPage->GetAttributes()->Set(frame.m_pComponent->GetContainerIndex(), m_Key, value);
+
+    return true;
+}
+//---------------------------------------------------------------------------
+TSP_Component* TSP_DocumentReader::CreateComponent(IFrame& frame)
+{
+    if (frame.m_pComponent)
+        return frame.m_pComponent;
+
+    TSP_Component* pComponent;
+
+    switch (m_Component.m_Type)
+    {
+        case TSP_Item::IEType::IE_T_Box:
+            pComponent = frame.m_pPage->CreateAndAddBox(m_Component.m_Title, m_Component.m_Description, m_Component.m_Comments);
+            break;
+
+        case TSP_Item::IEType::IE_T_Process:
+            pComponent = frame.m_pPage->CreateAndAddProcess(m_Component.m_Title, m_Component.m_Description, m_Component.m_Comments);
+            break;
+
+        case TSP_Item::IEType::IE_T_Activity:
+            pComponent = frame.m_pPage->CreateAndAddActivity(m_Component.m_Title, m_Component.m_Description, m_Component.m_Comments);
+            break;
+
+        case TSP_Item::IEType::IE_T_Link:
+            pComponent = frame.m_pPage->CreateAndAddLink(m_Component.m_Title, m_Component.m_Description, m_Component.m_Comments);
+            break;
+
+        case TSP_Item::IEType::IE_T_Message:
+            pComponent = frame.m_pPage->CreateAndAddMessage(m_Component.m_Title, m_Component.m_Description, m_Component.m_Comments);
+            break;
+
+        default:
+            M_LogCatErrorT(IO, L"Read document - unknown component type - " << (int)m_Component.m_Type);
+            return nullptr;
+    }
+
+    // keep the file unique identifier, to which the links refer
+    if (m_Component.m_UID)
+        m_UIDs[m_Component.m_UID] = pComponent->GetUID();
+
+    frame.m_pComponent = pComponent;
+
+    return pComponent;
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentReader::Resolve()
+{
+    // attach the link ends to their boxes
+    for (std::size_t i = 0; i < m_LinkEnds.size(); ++i)
+    {
+        const ILinkEnd&       linkEnd = m_LinkEnds[i];
+        IUIDs::const_iterator it      = m_UIDs.find(linkEnd.m_Box);
+
+        if (it == m_UIDs.end())
+        {
+            M_LogCatWarnT(IO, L"Read document - link attached to an unknown box - " << linkEnd.m_Box);
+            continue;
+        }
+
+        TSP_LinkGraph* pGraph = static_cast<TSP_Page*>(linkEnd.m_pLink->GetOwner())->GetLinkGraph();
+
+        if (linkEnd.m_Start)
+            pGraph->SetStart(linkEnd.m_pLink->GetUID(), it->second, linkEnd.m_Side);
+        else
+            pGraph->SetEnd(linkEnd.m_pLink->GetUID(), it->second, linkEnd.m_Side);
+    }
+
+    // set the formulas, which are calculated from the read values
+    for (std::size_t i = 0; i < m_Formulas.size(); ++i)
+    {
+        TSP_Attribute formula;
+        formula.SetFormula(m_Formulas[i].m_Formula);
+
+        if (!m_Formulas[i].m_pComponent->SetAttribute(m_Formulas[i].m_Key, formula))
+            M_LogCatWarnT(IO, L"Read document - invalid formula - " << m_Formulas[i].m_Formula);
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+TSP_DocumentReader::IEMember TSP_DocumentReader::GetMember(const char* pName, rapidjson::SizeType length)
+{
+    /**
+    * Member name
+    */
+    struct IName
+    {
+        IEMember    m_Member;
+        const char* m_pName;
+    };
+
+    static const IName names[] =
+    {
+        {IEMember::IE_M_Title,       "title"},
+        {IEMember::IE_M_Atlases,     "atlases"},
+        {IEMember::IE_M_UID,         "uid"},
+        {IEMember::IE_M_Name,        "name"},
+        {IEMember::IE_M_Pages,       "pages"},
+        {IEMember::IE_M_Count,       "count"},
+        {IEMember::IE_M_Components,  "components"},
+        {IEMember::IE_M_Type,        "type"},
+        {IEMember::IE_M_Description, "description"},
+        {IEMember::IE_M_Comments,    "comments"},
+        {IEMember::IE_M_Attributes,  "attributes"},
+        {IEMember::IE_M_Formulas,    "formulas"},
+        {IEMember::IE_M_Start,       "start"},
+        {IEMember::IE_M_End,         "end"},
+        {IEMember::IE_M_Box,         "box"},
+        {IEMember::IE_M_Side,        "side"}
+    };
+
+    for (std::size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+        if (std::strlen(names[i].m_pName) == length && !std::memcmp(names[i].m_pName, pName, length))
+            return names[i].m_Member;
+
+    return IEMember::IE_M_Unknown;
+}
+//---------------------------------------------------------------------------
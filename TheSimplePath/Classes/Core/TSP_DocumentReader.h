@@ -0,0 +1,236 @@
+/****************************************************************************
+ * ==> TSP_DocumentReader --------------------------------------------------*
+ ****************************************************************************
+ * Description:  Document reader, builds a document while parsing it        *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// common classes
+#include "Common/TSP_JsonHelper.h"
+
+// core classes
+#include "TSP_Item.h"
+#include "TSP_Attribute.h"
+#include "TSP_LinkGraph.h"
+
+// class prototypes
+class TSP_Document;
+class TSP_Atlas;
+class TSP_PageContainer;
+class TSP_Page;
+class TSP_Component;
+class TSP_Link;
+
+/**
+* Document reader, builds a document from its json content while the content is parsed
+*@note The content is parsed in place by an event based parser, so no intermediate json document is
+*      built, and the atlases, pages and components are created directly from the parser events
+*@author Jean-Milost Reymond
+*/
+class TSP_DocumentReader
+{
+    public:
+        /**
+        * Constructor
+        *@param pDocument - document to fill, should be empty
+        */
+        TSP_DocumentReader(TSP_Document* pDocument);
+
+        virtual ~TSP_DocumentReader();
+
+        /**
+        * Reads a document
+        *@param pData - json content, in UTF-8 and null terminated
+        *@return true on success, otherwise false
+        *@note The content is modified while parsed, as its strings are decoded in place
+        */
+        virtual bool Read(char* pData);
+
+        /**
+        * Parser events
+        *@note These functions are called by the parser, they should not be called from outside
+        */
+        bool Null();
+        bool Bool(bool value);
+        bool Int(int value);
+        bool Uint(unsigned value);
+        bool Int64(std::int64_t value);
+        bool Uint64(std::uint64_t value);
+        bool Double(double value);
+        bool RawNumber(const char* pStr, rapidjson::SizeType length, bool copy);
+        bool String(const char* pStr, rapidjson::SizeType length, bool copy);
+        bool StartObject();
+        bool Key(const char* pStr, rapidjson::SizeType length, bool copy);
+        bool EndObject(rapidjson::SizeType memberCount);
+        bool StartArray();
+        bool EndArray(rapidjson::SizeType elementCount);
+
+    private:
+        /**
+        * Content being read
+        */
+        enum class IEContext
+        {
+            IE_C_Root = 0,
+            IE_C_Document,
+            IE_C_Atlases,
+            IE_C_Atlas,
+            IE_C_Pages,
+            IE_C_Page,
+            IE_C_Components,
+            IE_C_Component,
+            IE_C_Attributes,
+            IE_C_Formulas,
+            IE_C_LinkEnd
+        };
+
+        /**
+        * Known object members
+        */
+        enum class IEMember
+        {
+            IE_M_Unknown = 0,
+            IE_M_Title,
+            IE_M_Atlases,
+            IE_M_UID,
+            IE_M_Name,
+            IE_M_Pages,
+            IE_M_Count,
+            IE_M_Components,
+            IE_M_Type,
+            IE_M_Description,
+            IE_M_Comments,
+            IE_M_Attributes,
+            IE_M_Formulas,
+            IE_M_Start,
+            IE_M_End,
+            IE_M_Box,
+            IE_M_Side
+        };
+
+        /**
+        * Content level, with the items it is read for
+        */
+        struct IFrame
+        {
+            IEContext          m_Context    = IEContext::IE_C_Root;
+            TSP_Atlas*         m_pAtlas     = nullptr;
+            TSP_PageContainer* m_pContainer = nullptr;
+            TSP_Page*          m_pPage      = nullptr;
+            TSP_Component*     m_pComponent = nullptr;
+        };
+
+        /**
+        * Component values read before the component can be created
+        */
+        struct IComponentInfo
+        {
+            std::uint64_t    m_UID  = 0;
+            TSP_Item::IEType m_Type = TSP_Item::IEType::IE_T_Unknown;
+            std::wstring     m_Title;
+            std::wstring     m_Description;
+            std::wstring     m_Comments;
+        };
+
+        /**
+        * Link end, attached once all the boxes are read
+        */
+        struct ILinkEnd
+        {
+            TSP_Link*             m_pLink = nullptr;
+            std::uint64_t         m_Box   = 0;
+            TSP_LinkGraph::IESide m_Side  = TSP_LinkGraph::IESide::IE_S_None;
+            bool                  m_Start = true;
+        };
+
+        /**
+        * Formula, set once all the values are read
+        */
+        struct IFormula
+        {
+            TSP_Component*       m_pComponent = nullptr;
+            TSP_Attribute::IEKey m_Key        = TSP_Attribute::IEKey::IE_K_Unknown;
+            std::wstring         m_Formula;
+        };
+
+        typedef std::vector<IFrame>                                IFrames;
+        typedef std::vector<ILinkEnd>                              ILinkEnds;
+        typedef std::vector<IFormula>                              IFormulas;
+        typedef std::unordered_map<std::uint64_t, TSP_Item::IUID> IUIDs;
+
+        TSP_Document*        m_pDocument = nullptr;
+        IFrames              m_Frames;
+        IComponentInfo       m_Component;
+        ILinkEnd             m_LinkEnd;
+        ILinkEnds            m_LinkEnds;
+        IFormulas            m_Formulas;
+        IUIDs                m_UIDs;
+        IEMember             m_Member    = IEMember::IE_M_Unknown;
+        TSP_Attribute::IEKey m_Key       = TSP_Attribute::IEKey::IE_K_Unknown;
+        std::size_t          m_SkipDepth = 0;
+        std::size_t          m_DataSize  = 0;
+
+        /**
+        * Reads an unsigned number
+        *@param value - value
+        *@return true on success, otherwise false
+        */
+        bool ReadNumber(std::uint64_t value);
+
+        /**
+        * Reads an attribute value
+        *@param value - value
+        *@return true on success, otherwise false
+        */
+        bool ReadValue(const TSP_Attribute& value);
+
+        /**
+        * Creates the component being read, if still not created
+        *@param frame - component frame
+        *@return the component, nullptr on error
+        */
+        TSP_Component* CreateComponent(IFrame& frame);
+
+        /**
+        * Attaches the link ends and sets the formulas, once the whole content is read
+        *@return true on success, otherwise false
+        */
+        bool Resolve();
+
+        /**
+        * Gets a member from its name
+        *@param pName - member name
+        *@param length - member name length
+        *@return the member, IE_M_Unknown if not found
+        */
+        static IEMember GetMember(const char* pName, rapidjson::SizeType length);
+};
@@ -0,0 +1,231 @@
+/****************************************************************************
+ * ==> TSP_DocumentSaver ---------------------------------------------------*
+ ****************************************************************************
+ * Description:  Saves a document in background                             *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_DocumentSaver.h"
+
+// common classes
+#include "Common/TSP_FileHelper.h"
+#include "Common/TSP_Logger.h"
+
+// core classes
+#include "TSP_Document.h"
+#include "TSP_Journal.h"
+
+//---------------------------------------------------------------------------
+// TSP_DocumentSaver
+//---------------------------------------------------------------------------
+TSP_DocumentSaver::TSP_DocumentSaver() :
+    m_Written(0),
+    m_State(IEState::IE_S_Idle)
+{}
+//---------------------------------------------------------------------------
+TSP_DocumentSaver::~TSP_DocumentSaver()
+{
+    Wait();
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentSaver::Start(const TSP_Document* pDocument, const std::wstring& fileName)
+{
+    if (!pDocument)
+        return false;
+
+    // only one save may run at once
+    if (m_State == IEState::IE_S_Saving)
+    {
+        M_LogCatWarnT(IO, L"Save document - a save is still running - " << fileName);
+        return false;
+    }
+
+    // release the previous save thread
+    Wait();
+
+    M_LogFmtT(IO, Info, "Save document in background - {}", fileName);
+
+    m_PageHandles.clear();
+    m_FileName = fileName;
+
+    // nothing to save?
+    if (!pDocument->IsModified() && fileName == pDocument->GetFileName())
+    {
+        m_Size    = 0;
+        m_Written = 0;
+        m_State   = IEState::IE_S_Saved;
+        return true;
+    }
+
+    std::unique_ptr<TSP_ChunkedBuffer> pSnapshot(new TSP_ChunkedBuffer());
+
+    // the journal position should match the snapshot, the modifications done after are kept
+    m_pJournal = pDocument->GetJournal();
+    m_Mark     = m_pJournal ? m_pJournal->GetMark() : 0;
+    m_Update   = false;
+
+    // binary document saved to its own file? Only its modifications are appended to it
+    if (TSP_Document::IsBinary(fileName) && fileName == pDocument->GetFileName())
+    {
+        std::unique_ptr<TSP_ChunkedBuffer> pHeader(new TSP_ChunkedBuffer());
+
+        if (pDocument->WriteUpdate(pSnapshot.get(), m_Offset, pHeader.get(), &m_PageHandles))
+        {
+            m_pHeader = std::move(pHeader);
+            m_Update  = true;
+        }
+        else
+        {
+            // the file should be written in full
+            pSnapshot.reset(new TSP_ChunkedBuffer());
+            m_PageHandles.clear();
+        }
+    }
+
+    if (!m_Update)
+    {
+        // the destination may be the opened file, so the pages still not read should be read before,
+        // otherwise they would be lost when the file is overwritten
+        if (!pDocument->ReadAllPages())
+        {
+            M_LogCatErrorT(IO, L"Save document - some pages could not be read - " << fileName);
+            m_State = IEState::IE_S_Failed;
+            return false;
+        }
+
+        // take the document snapshot
+        if (!pDocument->Write(pSnapshot.get(), TSP_Document::IsBinary(fileName), &m_PageHandles))
+        {
+            M_LogCatErrorT(IO, L"Save document - failed to write the document - " << fileName);
+            m_State = IEState::IE_S_Failed;
+            return false;
+        }
+    }
+
+    m_pSnapshot = std::move(pSnapshot);
+    m_Size      = m_pSnapshot->GetSize();
+    m_Written   = 0;
+    m_State     = IEState::IE_S_Saving;
+
+    try
+    {
+        m_Thread = std::thread(&TSP_DocumentSaver::Run, this);
+    }
+    catch (...)
+    {
+        // not enough resources to start a thread, so save on the calling thread
+        Run();
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentSaver::Wait()
+{
+    if (m_Thread.joinable())
+        m_Thread.join();
+
+    // the snapshot is no longer required
+    m_pSnapshot.reset();
+    m_pHeader.reset();
+
+    return m_State == IEState::IE_S_Saved;
+}
+//---------------------------------------------------------------------------
+TSP_DocumentSaver::IEState TSP_DocumentSaver::GetState() const
+{
+    return m_State;
+}
+//---------------------------------------------------------------------------
+double TSP_DocumentSaver::GetProgress() const
+{
+    switch (m_State)
+    {
+        case IEState::IE_S_Saving: return m_Size ? double(m_Written) / double(m_Size) : 0.0;
+        case IEState::IE_S_Saved:  return 1.0;
+        default:                   return 0.0;
+    }
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_DocumentSaver::GetFileName() const
+{
+    return m_FileName;
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentSaver::WriteFile(const TSP_ChunkedBuffer&         buffer,
+                                  const std::wstring&              fileName,
+                                        std::atomic<std::size_t>* pWritten)
+{
+    const std::wstring tempFileName = fileName + L".tmp";
+
+    // the content should be on the disk before the temporary file replaces the previous one
+    if (!buffer.WriteToFile(tempFileName, true, pWritten))
+    {
+        TSP_FileHelper::RemoveFile(tempFileName);
+        return false;
+    }
+
+    if (!TSP_FileHelper::RenameFile(tempFileName, fileName))
+    {
+        TSP_FileHelper::RemoveFile(tempFileName);
+        return false;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_DocumentSaver::UpdateFile(const TSP_ChunkedBuffer&         content,
+                                         std::uint64_t              offset,
+                                   const TSP_ChunkedBuffer&         header,
+                                   const std::wstring&              fileName,
+                                         std::atomic<std::size_t>* pWritten)
+{
+    // the content should be on the disk before the header designates it
+    if (!content.UpdateFile(fileName, offset, true, pWritten))
+        return false;
+
+    return header.UpdateFile(fileName, 0, true);
+}
+//---------------------------------------------------------------------------
+void TSP_DocumentSaver::Run()
+{
+    // NOTE the logger isn't used on this thread, the caller logs the result
+    const bool success = m_Update ? UpdateFile(*m_pSnapshot, m_Offset, *m_pHeader, m_FileName, &m_Written) :
+                                    WriteFile (*m_pSnapshot,                        m_FileName, &m_Written);
+
+    if (!success)
+    {
+        m_State = IEState::IE_S_Failed;
+        return;
+    }
+
+    // the saved modifications no longer need to be recovered. The journal is locked while rebased,
+    // so the modifications may be recorded meanwhile
+    if (m_pJournal)
+        m_pJournal->Rebase(m_FileName, m_Mark);
+
+    m_State = IEState::IE_S_Saved;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,181 @@
+/****************************************************************************
+ * ==> TSP_DocumentSaver ---------------------------------------------------*
+ ****************************************************************************
+ * Description:  Saves a document in background                             *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+// common classes
+#include "Common/TSP_ChunkedBuffer.h"
+
+// core classes
+#include "TSP_Document.h"
+
+// class prototypes
+class TSP_Journal;
+
+/**
+* Document saver, saves a document in background. The document is written in memory on the calling
+* thread, which is fast and gives a consistent snapshot of it, then the snapshot is written to the
+* file on a background thread while the document may still be modified
+*@note The file is written to a temporary file first, which then replaces it, so the file contains
+*      either its previous or its new content, even if the application crashes while it is saved.
+*      A binary document saved to its own file is instead updated in place, its modifications being
+*      appended to the file before its header is rewritten, so the file still contains its previous
+*      content if the application crashes before
+*@author Jean-Milost Reymond
+*/
+class TSP_DocumentSaver
+{
+    public:
+        /**
+        * Save states
+        */
+        enum class IEState
+        {
+            IE_S_Idle = 0,
+            IE_S_Saving,
+            IE_S_Saved,
+            IE_S_Failed
+        };
+
+        TSP_DocumentSaver();
+
+        /**
+        * Destructor
+        *@note Waits until the running save ends
+        */
+        virtual ~TSP_DocumentSaver();
+
+        /**
+        * Starts to save a document
+        *@param pDocument - document to save
+        *@param fileName - document file name, the document is written in the binary format if its
+        *                  extension is .tspb, otherwise in json
+        *@return true if the save started, false on error or if a save is still running
+        *@note The document may be modified as soon as this function returns, the modifications done
+        *      meanwhile remain recorded in the document journal. The document should be marked as
+        *      unmodified once the save started, and be notified about its result, see
+        *      TSP_Document::NotifySaved() and TSP_Document::NotifySaveFailed()
+        */
+        virtual bool Start(const TSP_Document* pDocument, const std::wstring& fileName);
+
+        /**
+        * Waits until the running save ends
+        *@return true if the document was saved, otherwise false
+        */
+        virtual bool Wait();
+
+        /**
+        * Gets the save state
+        *@return the save state
+        */
+        virtual IEState GetState() const;
+
+        /**
+        * Gets the save progress
+        *@return the save progress, between 0.0 and 1.0
+        */
+        virtual double GetProgress() const;
+
+        /**
+        * Gets the file name the document is saved to
+        *@return the file name
+        */
+        virtual std::wstring GetFileName() const;
+
+        /**
+        * Gets the locations of the page contents written to the file
+        *@return the page content locations, binary format only
+        *@note Valid once the document was saved
+        */
+        virtual inline const TSP_Document::IPageHandles& GetPageHandles() const;
+
+        /**
+        * Writes a buffer to a file, through a temporary file which then replaces it
+        *@param buffer - buffer to write
+        *@param fileName - file name
+        *@param[out] pWritten - if not nullptr, receives the written size while the file is written, in bytes
+        *@return true on success, otherwise false
+        */
+        static bool WriteFile(const TSP_ChunkedBuffer&         buffer,
+                              const std::wstring&              fileName,
+                                    std::atomic<std::size_t>* pWritten = nullptr);
+
+        /**
+        * Updates a file in place, the content is written first, then the header replaces the file start
+        *@param content - content to write
+        *@param offset - file offset to write the content to
+        *@param header - header to write at the file start
+        *@param fileName - file name
+        *@param[out] pWritten - if not nullptr, receives the written size while the file is written, in bytes
+        *@return true on success, otherwise false
+        *@note The file content is on the disk before its header is replaced, so the header always
+        *      designates a complete content
+        */
+        static bool UpdateFile(const TSP_ChunkedBuffer&         content,
+                                     std::uint64_t              offset,
+                               const TSP_ChunkedBuffer&         header,
+                               const std::wstring&              fileName,
+                                     std::atomic<std::size_t>* pWritten = nullptr);
+
+    private:
+        std::unique_ptr<TSP_ChunkedBuffer> m_pSnapshot;
+        std::unique_ptr<TSP_ChunkedBuffer> m_pHeader;
+        std::wstring                       m_FileName;
+        TSP_Document::IPageHandles         m_PageHandles;
+        TSP_Journal*                       m_pJournal = nullptr;
+        std::size_t                        m_Mark     = 0;
+        std::size_t                        m_Size     = 0;
+        std::uint64_t                      m_Offset   = 0;
+        bool                               m_Update   = false;
+        std::atomic<std::size_t>           m_Written;
+        std::atomic<IEState>               m_State;
+        std::thread                        m_Thread;
+
+        /**
+        * Writes the snapshot to the file, runs in the background thread
+        */
+        void Run();
+};
+
+//---------------------------------------------------------------------------
+// TSP_DocumentSaver
+//---------------------------------------------------------------------------
+const TSP_Document::IPageHandles& TSP_DocumentSaver::GetPageHandles() const
+{
+    return m_PageHandles;
+}
+//---------------------------------------------------------------------------
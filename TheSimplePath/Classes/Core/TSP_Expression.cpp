@@ -0,0 +1,422 @@
+/****************************************************************************
+ * ==> TSP_Expression ------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Compiled attribute expression                              *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_Expression.h"
+
+// std
+#include <cmath>
+
+// common classes
+#include "Common\TSP_NumberHelper.h"
+#include "Common\TSP_StringHelper.h"
+
+// core classes
+#include "TSP_AttributeSchema.h"
+
+//---------------------------------------------------------------------------
+// TSP_Expression::IResolver
+//---------------------------------------------------------------------------
+TSP_Expression::IResolver::IResolver()
+{}
+//---------------------------------------------------------------------------
+TSP_Expression::IResolver::~IResolver()
+{}
+//---------------------------------------------------------------------------
+// TSP_Expression::IParser
+//---------------------------------------------------------------------------
+TSP_Expression::IParser::IParser(const std::wstring& formula, IInstructions& instructions) :
+    m_Formula(formula),
+    m_Instructions(instructions)
+{}
+//---------------------------------------------------------------------------
+TSP_Expression::IParser::~IParser()
+{}
+//---------------------------------------------------------------------------
+bool TSP_Expression::IParser::Parse()
+{
+    if (!ParseExpression())
+        return false;
+
+    // the whole formula should be consumed
+    return !Peek();
+}
+//---------------------------------------------------------------------------
+bool TSP_Expression::IParser::ParseExpression()
+{
+    if (!ParseTerm())
+        return false;
+
+    while (true)
+        if (Accept(L'+'))
+        {
+            if (!ParseTerm())
+                return false;
+
+            Emit(IEOpCode::IE_O_Add);
+        }
+        else
+        if (Accept(L'-'))
+        {
+            if (!ParseTerm())
+                return false;
+
+            Emit(IEOpCode::IE_O_Subtract);
+        }
+        else
+            return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Expression::IParser::ParseTerm()
+{
+    if (!ParseUnary())
+        return false;
+
+    while (true)
+        if (Accept(L'*'))
+        {
+            if (!ParseUnary())
+                return false;
+
+            Emit(IEOpCode::IE_O_Multiply);
+        }
+        else
+        if (Accept(L'/'))
+        {
+            if (!ParseUnary())
+                return false;
+
+            Emit(IEOpCode::IE_O_Divide);
+        }
+        else
+            return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Expression::IParser::ParseUnary()
+{
+    // each nested parenthesis or sign recurses through this function, so only check the depth here
+    if (m_Nesting >= m_MaxNesting)
+        return false;
+
+    ++m_Nesting;
+
+    bool success;
+
+    if (Accept(L'-'))
+    {
+        success = ParseUnary();
+
+        if (success)
+            Emit(IEOpCode::IE_O_Negate);
+    }
+    else
+    if (Accept(L'+'))
+        success = ParseUnary();
+    else
+        success = ParsePrimary();
+
+    --m_Nesting;
+
+    return success;
+}
+//---------------------------------------------------------------------------
+bool TSP_Expression::IParser::ParsePrimary()
+{
+    if (Accept(L'('))
+        return ParseExpression() && Accept(L')');
+
+    const wchar_t c = Peek();
+
+    if ((c >= L'0' && c <= L'9') || c == L'.')
+        return ParseNumber();
+
+    return ParseReference();
+}
+//---------------------------------------------------------------------------
+bool TSP_Expression::IParser::ParseNumber()
+{
+    const std::size_t start = m_Pos;
+
+    // find the number end, the exponent may be followed by a sign
+    while (m_Pos < m_Formula.length())
+    {
+        const wchar_t c = m_Formula[m_Pos];
+
+        if ((c >= L'0' && c <= L'9') || c == L'.' || c == L'e' || c == L'E')
+            ++m_Pos;
+        else
+        if ((c == L'+' || c == L'-') && (m_Formula[m_Pos - 1] == L'e' || m_Formula[m_Pos - 1] == L'E'))
+            ++m_Pos;
+        else
+            break;
+    }
+
+    const wchar_t* pEnd = m_Formula.data() + m_Pos;
+    const wchar_t* pNext;
+    double         value;
+
+    if (TSP_NumberHelper::Parse(m_Formula.data() + start, pEnd, value, pNext) !=
+            TSP_NumberHelper::IEResult::IE_R_Success)
+        return false;
+
+    // the whole token should be a number, e.g. 1.2.3 or 1e are invalid
+    if (pNext != pEnd)
+        return false;
+
+    Emit(IEOpCode::IE_O_Constant, TSP_Attribute::IEKey::IE_K_Unknown, value);
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Expression::IParser::ParseReference()
+{
+    const std::size_t start = m_Pos;
+    std::wstring      name;
+
+    if (!ReadName(name))
+        return false;
+
+    // aggregate function?
+    if (Accept(L'('))
+    {
+        IEOpCode opCode;
+
+        if (name == L"sum")
+            opCode = IEOpCode::IE_O_Sum;
+        else
+        if (name == L"min")
+            opCode = IEOpCode::IE_O_Min;
+        else
+        if (name == L"max")
+            opCode = IEOpCode::IE_O_Max;
+        else
+        if (name == L"count")
+            opCode = IEOpCode::IE_O_Count;
+        else
+        if (name == L"avg")
+            opCode = IEOpCode::IE_O_Average;
+        else
+            return false;
+
+        TSP_Attribute::IEKey key;
+
+        if (!ReadKey(key) || !Accept(L')'))
+            return false;
+
+        Emit(opCode, key);
+        return true;
+    }
+
+    // value of the parent process?
+    if (name == L"parent" && Accept(L'.'))
+    {
+        TSP_Attribute::IEKey key;
+
+        if (!ReadKey(key))
+            return false;
+
+        Emit(IEOpCode::IE_O_ParentValue, key);
+        return true;
+    }
+
+    // value of the component itself, read the name again as a key
+    m_Pos = start;
+
+    TSP_Attribute::IEKey key;
+
+    if (!ReadKey(key))
+        return false;
+
+    Emit(IEOpCode::IE_O_Value, key);
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Expression::IParser::ReadName(std::wstring& name)
+{
+    Peek();
+
+    const std::size_t start = m_Pos;
+
+    while (m_Pos < m_Formula.length())
+    {
+        const wchar_t c = m_Formula[m_Pos];
+
+        if (TSP_StringHelper::IsASCIILetter(c) || c == L'_' || (m_Pos > start && c >= L'0' && c <= L'9'))
+            ++m_Pos;
+        else
+            break;
+    }
+
+    if (m_Pos == start)
+        return false;
+
+    name.resize(m_Pos - start);
+
+    // the names only contain ASCII chars, so they may be converted to lower case without locale
+    for (std::size_t i = 0; i < name.length(); ++i)
+    {
+        const wchar_t c = m_Formula[start + i];
+        name[i]         = (c >= L'A' && c <= L'Z') ? c + (L'a' - L'A') : c;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Expression::IParser::ReadKey(TSP_Attribute::IEKey& key)
+{
+    std::wstring name;
+
+    if (!ReadName(name))
+        return false;
+
+    key = TSP_AttributeSchema::Find(name);
+
+    return TSP_AttributeSchema::IsValid(key);
+}
+//---------------------------------------------------------------------------
+bool TSP_Expression::IParser::Accept(wchar_t c)
+{
+    if (Peek() != c)
+        return false;
+
+    ++m_Pos;
+    return true;
+}
+//---------------------------------------------------------------------------
+wchar_t TSP_Expression::IParser::Peek()
+{
+    while (m_Pos < m_Formula.length() && TSP_StringHelper::IsSpace(m_Formula[m_Pos]))
+        ++m_Pos;
+
+    return m_Pos < m_Formula.length() ? m_Formula[m_Pos] : L'\0';
+}
+//---------------------------------------------------------------------------
+void TSP_Expression::IParser::Emit(IEOpCode opCode, TSP_Attribute::IEKey key, double value)
+{
+    IInstruction instruction;
+    instruction.m_OpCode = opCode;
+    instruction.m_Key    = key;
+    instruction.m_Value  = value;
+
+    m_Instructions.push_back(instruction);
+
+    // update the stack depth the evaluation will need
+    switch (opCode)
+    {
+        case IEOpCode::IE_O_Add:
+        case IEOpCode::IE_O_Subtract:
+        case IEOpCode::IE_O_Multiply:
+        case IEOpCode::IE_O_Divide:
+            --m_Depth;
+            break;
+
+        case IEOpCode::IE_O_Negate:
+            break;
+
+        default:
+            ++m_Depth;
+
+            if (m_Depth > m_StackSize)
+                m_StackSize = m_Depth;
+
+            break;
+    }
+}
+//---------------------------------------------------------------------------
+// TSP_Expression
+//---------------------------------------------------------------------------
+TSP_Expression::TSP_Expression()
+{}
+//---------------------------------------------------------------------------
+TSP_Expression::~TSP_Expression()
+{}
+//---------------------------------------------------------------------------
+bool TSP_Expression::Compile(const std::wstring& formula)
+{
+    Clear();
+
+    IParser parser(formula, m_Instructions);
+
+    // the evaluation stack has a fixed size, so it never allocates
+    if (!parser.Parse() || parser.GetStackSize() > m_MaxStackSize)
+    {
+        Clear();
+        return false;
+    }
+
+    m_Formula = formula;
+    return true;
+}
+//---------------------------------------------------------------------------
+void TSP_Expression::Clear()
+{
+    m_Formula.clear();
+    m_Instructions.clear();
+}
+//---------------------------------------------------------------------------
+bool TSP_Expression::Evaluate(const IResolver& resolver, double& result) const
+{
+    if (m_Instructions.empty())
+        return false;
+
+    double      stack[m_MaxStackSize];
+    std::size_t depth = 0;
+
+    for each (const IInstruction& instruction in m_Instructions)
+        switch (instruction.m_OpCode)
+        {
+            case IEOpCode::IE_O_Constant:
+                stack[depth++] = instruction.m_Value;
+                break;
+
+            case IEOpCode::IE_O_Add:      --depth; stack[depth - 1] += stack[depth]; break;
+            case IEOpCode::IE_O_Subtract: --depth; stack[depth - 1] -= stack[depth]; break;
+            case IEOpCode::IE_O_Multiply: --depth; stack[depth - 1] *= stack[depth]; break;
+            case IEOpCode::IE_O_Negate:   stack[depth - 1] = -stack[depth - 1];      break;
+
+            case IEOpCode::IE_O_Divide:
+                --depth;
+
+                if (stack[depth] == 0.0)
+                    return false;
+
+                stack[depth - 1] /= stack[depth];
+                break;
+
+            default:
+                if (!resolver.Resolve(instruction, stack[depth]))
+                    return false;
+
+                ++depth;
+                break;
+        }
+
+    result = stack[0];
+
+    return std::isfinite(result);
+}
+//---------------------------------------------------------------------------
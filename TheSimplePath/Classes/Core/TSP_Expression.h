@@ -0,0 +1,258 @@
+/****************************************************************************
+ * ==> TSP_Expression ------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Compiled attribute expression                              *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// core classes
+#include "TSP_Attribute.h"
+
+/**
+* Attribute expression, compiled from a formula to a postfix instruction list. The formula may
+* contain numbers, the + - * / operators, parentheses and the following references:
+* - key:             value of the key on the same component, e.g. duration
+* - parent.key:      value of the key on the process owning the component page, e.g. parent.cost
+* - sum(key):        sum of the key values on the components of the process pages, also available
+*                    with the min, max, count and avg functions
+* The keys are named as in the attribute schema, e.g. sum(duration) * resources
+*@author Jean-Milost Reymond
+*/
+class TSP_Expression
+{
+    public:
+        /**
+        * Instruction operation code
+        */
+        enum class IEOpCode
+        {
+            IE_O_Constant,
+            IE_O_Value,
+            IE_O_ParentValue,
+            IE_O_Sum,
+            IE_O_Min,
+            IE_O_Max,
+            IE_O_Count,
+            IE_O_Average,
+            IE_O_Add,
+            IE_O_Subtract,
+            IE_O_Multiply,
+            IE_O_Divide,
+            IE_O_Negate
+        };
+
+        /**
+        * Instruction
+        */
+        struct IInstruction
+        {
+            IEOpCode             m_OpCode = IEOpCode::IE_O_Constant;
+            TSP_Attribute::IEKey m_Key    = TSP_Attribute::IEKey::IE_K_Unknown;
+            double               m_Value  = 0.0;
+        };
+
+        typedef std::vector<IInstruction> IInstructions;
+
+        /**
+        * Reference resolver, provides the referenced values while the expression is evaluated
+        */
+        class IResolver
+        {
+            public:
+                IResolver();
+                virtual ~IResolver();
+
+                /**
+                * Resolves a reference
+                *@param instruction - instruction containing the reference, one of the value or aggregate op codes
+                *@param[out] value - resolved value
+                *@return true on success, false if the value isn't available
+                */
+                virtual bool Resolve(const IInstruction& instruction, double& value) const = 0;
+        };
+
+        TSP_Expression();
+        virtual ~TSP_Expression();
+
+        /**
+        * Compiles a formula
+        *@param formula - formula to compile
+        *@return true on success, false if the formula is invalid, in this case the expression is cleared
+        */
+        virtual bool Compile(const std::wstring& formula);
+
+        /**
+        * Clears the expression
+        */
+        virtual void Clear();
+
+        /**
+        * Checks if the expression is empty
+        *@return true if the expression is empty, otherwise false
+        */
+        virtual inline bool IsEmpty() const;
+
+        /**
+        * Gets the compiled formula
+        *@return the compiled formula
+        */
+        virtual inline const std::wstring& GetFormula() const;
+
+        /**
+        * Gets the instructions
+        *@return the instructions
+        */
+        virtual inline const IInstructions& GetInstructions() const;
+
+        /**
+        * Evaluates the expression
+        *@param resolver - resolver providing the referenced values
+        *@param[out] result - expression result
+        *@return true on success, false if a referenced value is missing or the result is undefined,
+        *        e.g. on a division by zero
+        */
+        virtual bool Evaluate(const IResolver& resolver, double& result) const;
+
+    private:
+        /**
+        * Recursive descent parser, writes the instructions while it reads the formula
+        */
+        class IParser
+        {
+            public:
+                /**
+                * Constructor
+                *@param formula - formula to parse
+                *@param[out] instructions - instructions to write to
+                */
+                IParser(const std::wstring& formula, IInstructions& instructions);
+
+                virtual ~IParser();
+
+                /**
+                * Parses the formula
+                *@return true on success, otherwise false
+                */
+                virtual bool Parse();
+
+                /**
+                * Gets the highest stack depth needed to evaluate the instructions
+                *@return the highest stack depth
+                */
+                virtual inline std::size_t GetStackSize() const;
+
+            private:
+                const std::wstring& m_Formula;
+                IInstructions&      m_Instructions;
+                std::size_t         m_Pos       = 0;
+                std::size_t         m_Depth     = 0;
+                std::size_t         m_StackSize = 0;
+                std::size_t         m_Nesting   = 0;
+
+                bool ParseExpression();
+                bool ParseTerm();
+                bool ParseUnary();
+                bool ParsePrimary();
+                bool ParseNumber();
+                bool ParseReference();
+
+                /**
+                * Reads an identifier
+                *@param[out] name - identifier, in lower case
+                *@return true on success, otherwise false
+                */
+                bool ReadName(std::wstring& name);
+
+                /**
+                * Reads an attribute key
+                *@param[out] key - attribute key
+                *@return true on success, otherwise false
+                */
+                bool ReadKey(TSP_Attribute::IEKey& key);
+
+                /**
+                * Reads an expected char, after skipping the spaces
+                *@param c - expected char
+                *@return true if the char was read, otherwise false
+                */
+                bool Accept(wchar_t c);
+
+                /**
+                * Skips the spaces and gets the current char
+                *@return the current char, 0 at the formula end
+                */
+                wchar_t Peek();
+
+                /**
+                * Writes an instruction
+                *@param opCode - instruction op code
+                *@param key - referenced key, if any
+                *@param value - constant value, if any
+                */
+                void Emit(IEOpCode opCode, TSP_Attribute::IEKey key = TSP_Attribute::IEKey::IE_K_Unknown, double value = 0.0);
+        };
+
+        static const std::size_t m_MaxStackSize = 64;
+
+        // highest count of nested parentheses and signs, the parser is recursive and the formulas
+        // may come from untrusted files, so a crafted formula should not overflow the call stack
+        static const std::size_t m_MaxNesting = 256;
+
+        std::wstring  m_Formula;
+        IInstructions m_Instructions;
+};
+
+//---------------------------------------------------------------------------
+// TSP_Expression
+//---------------------------------------------------------------------------
+bool TSP_Expression::IsEmpty() const
+{
+    return m_Instructions.empty();
+}
+//---------------------------------------------------------------------------
+const std::wstring& TSP_Expression::GetFormula() const
+{
+    return m_Formula;
+}
+//---------------------------------------------------------------------------
+const TSP_Expression::IInstructions& TSP_Expression::GetInstructions() const
+{
+    return m_Instructions;
+}
+//---------------------------------------------------------------------------
+// TSP_Expression::IParser
+//---------------------------------------------------------------------------
+std::size_t TSP_Expression::IParser::GetStackSize() const
+{
+    return m_StackSize;
+}
+//---------------------------------------------------------------------------
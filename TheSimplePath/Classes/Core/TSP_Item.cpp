@@ -29,20 +29,112 @@
 
 #include "TSP_Item.h"
 
+// std
+#include <new>
+
+//---------------------------------------------------------------------------
+// Static members
+//---------------------------------------------------------------------------
+TSP_Item::IRegistry TSP_Item::m_Registry;
+std::mutex          TSP_Item::m_Mutex;
 //---------------------------------------------------------------------------
 // TSP_Item
 //---------------------------------------------------------------------------
 TSP_Item::TSP_Item()
 {
-    // use the pointer itself as unique identifier
-    m_UID = std::to_string(std::uintptr_t(this));
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    // register the item, the returned handle is used as unique identifier
+    m_UID = m_Registry.Add(this);
 }
 //---------------------------------------------------------------------------
 TSP_Item::~TSP_Item()
-{}
+{
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    // unregister the item, from now its unique identifier will never resolve again
+    m_Registry.Remove(m_UID);
+}
+//---------------------------------------------------------------------------
+TSP_Item* TSP_Item::Find(IUID uid)
+{
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    TSP_Item** ppItem = m_Registry.Get(uid);
+
+    return ppItem ? *ppItem : nullptr;
+}
+//---------------------------------------------------------------------------
+bool TSP_Item::IsKindOf(IEType type, IEType baseType)
+{
+    // an unknown base type is used by the untyped base classes, e.g. TSP_Component, which match any type
+    if (type == baseType || baseType == IEType::IE_T_Unknown)
+        return true;
+
+    switch (baseType)
+    {
+        case IEType::IE_T_Box:  return type == IEType::IE_T_Process || type == IEType::IE_T_Activity;
+        case IEType::IE_T_Link: return type == IEType::IE_T_Message;
+        default:                return false;
+    }
+}
+//---------------------------------------------------------------------------
+void TSP_Item::SetModified()
+{
+    m_Modified = true;
+}
+//---------------------------------------------------------------------------
+void TSP_Item::ClearModified()
+{
+    m_Modified = false;
+}
+//---------------------------------------------------------------------------
+void* TSP_Item::operator new(std::size_t size)
+{
+    return operator new(size, std::shared_ptr<TSP_MemoryArena>());
+}
+//---------------------------------------------------------------------------
+void* TSP_Item::operator new(std::size_t size, const std::shared_ptr<TSP_MemoryArena>& pArena)
+{
+    const std::size_t fullSize = m_HeaderSize + size;
+
+    // allocate the item and its header
+    char* pData = static_cast<char*>(pArena ? pArena->Allocate(fullSize) : ::operator new(fullSize));
+
+    // keep the allocation info, it will be needed to release the memory
+    IAllocHeader* pHeader = new (pData) IAllocHeader();
+    pHeader->m_pArena     = pArena;
+    pHeader->m_Size       = fullSize;
+
+    return pData + m_HeaderSize;
+}
+//---------------------------------------------------------------------------
+void TSP_Item::operator delete(void* pData)
+{
+    if (!pData)
+        return;
+
+    char*         pBlock  = static_cast<char*>(pData) - m_HeaderSize;
+    IAllocHeader* pHeader = reinterpret_cast<IAllocHeader*>(pBlock);
+
+    // take the arena ownership out of the header before its memory is released. NOTE if this item was
+    // the last user of an arena whose owner was already deleted, the arena is deleted on return
+    std::shared_ptr<TSP_MemoryArena> pArena = std::move(pHeader->m_pArena);
+    const std::size_t                size   = pHeader->m_Size;
+    pHeader->~IAllocHeader();
+
+    // return the memory where it was allocated from
+    if (pArena)
+        pArena->Release(pBlock, size);
+    else
+        ::operator delete(pBlock);
+}
 //---------------------------------------------------------------------------
-std::string TSP_Item::GetUID() const
+void TSP_Item::operator delete(void* pData, const std::shared_ptr<TSP_MemoryArena>&)
 {
-    return m_UID;
+    operator delete(pData);
 }
 //---------------------------------------------------------------------------
@@ -30,7 +30,16 @@
 #pragma once
 
 // std
-#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// common classes
+#include "Common/TSP_MemoryArena.h"
+
+// core classes
+#include "TSP_SlotMap.h"
 
 /**
 * Basic document item
@@ -39,6 +48,31 @@
 class TSP_Item
 {
     public:
+        /**
+        * Item unique identifier, 0 is never used by an item
+        *@note The identifier is a generational handle, so an identifier is never reused after its
+        *      item was deleted. It should only be converted to a string to be shared with the views
+        */
+        typedef TSP_SlotMap<TSP_Item*>::IHandle IUID;
+
+        /**
+        * Item type, allows to identify an item without relying on RTTI
+        */
+        enum class IEType : std::uint8_t
+        {
+            IE_T_Unknown = 0,
+            IE_T_Box,
+            IE_T_Process,
+            IE_T_Activity,
+            IE_T_Link,
+            IE_T_Message,
+            IE_T_Page,
+            IE_T_Atlas,
+            IE_T_Count
+        };
+
+        static const IEType m_ClassType = IEType::IE_T_Unknown;
+
         TSP_Item();
         virtual ~TSP_Item();
 
@@ -46,8 +80,163 @@ class TSP_Item
         * Gets the item unique identifier
         *@return the item unique identifier
         */
-        virtual std::string GetUID() const;
+        virtual inline IUID GetUID() const;
+
+        /**
+        * Gets the item type
+        *@return the item type
+        */
+        inline IEType GetType() const;
+
+        /**
+        * Checks if the item is of a type, or of a type derived from it
+        *@param type - type to check
+        *@return true if the item is of the type, otherwise false
+        */
+        inline bool IsKindOf(IEType type) const;
+
+        /**
+        * Checks if a type is the same as, or derived from, another type
+        *@param type - type to check
+        *@param baseType - base type to check against, IE_T_Unknown matches any type
+        *@return true if type is of the base type, otherwise false
+        */
+        static bool IsKindOf(IEType type, IEType baseType);
+
+        /**
+        * Gets the item index in its container
+        *@return the item index in its container
+        *@note This value is only meaningful for the container owning the item
+        */
+        virtual inline std::size_t GetContainerIndex() const;
+
+        /**
+        * Sets the item index in its container
+        *@param index - the item index in its container
+        *@note This function should only be called by the container owning the item
+        */
+        virtual inline void SetContainerIndex(std::size_t index);
+
+        /**
+        * Checks if the item was modified since the document was loaded or saved
+        *@return true if the item, or one of the items it contains, was modified, otherwise false
+        */
+        virtual inline bool IsModified() const;
+
+        /**
+        * Marks the item as modified
+        *@note The item owner is also marked, so a modified item is always reached through modified owners
+        */
+        virtual void SetModified();
+
+        /**
+        * Marks the item, and the modified items it contains, as unmodified
+        *@note Only the modified items are visited
+        */
+        virtual void ClearModified();
+
+        /**
+        * Finds an item from its unique identifier
+        *@param uid - item unique identifier to find
+        *@return the item, nullptr if not found
+        */
+        static TSP_Item* Find(IUID uid);
+
+        /**
+        * Allocates an item on the heap
+        *@param size - item size, in bytes
+        *@return allocated memory
+        */
+        static void* operator new(std::size_t size);
+
+        /**
+        * Allocates an item inside a memory arena
+        *@param size - item size, in bytes
+        *@param pArena - arena to allocate from, if nullptr the item is allocated on the heap
+        *@return allocated memory
+        *@note The item shares the arena ownership, so the arena remains alive until its last item is
+        *      released, even if the item was moved to a page or container owning another arena
+        */
+        static void* operator new(std::size_t size, const std::shared_ptr<TSP_MemoryArena>& pArena);
+
+        /**
+        * Releases an item memory, either to its arena or to the heap
+        *@param pData - item memory to release
+        */
+        static void operator delete(void* pData);
+
+        /**
+        * Releases an item memory if its constructor failed while allocated inside an arena
+        *@param pData - item memory to release
+        */
+        static void operator delete(void* pData, const std::shared_ptr<TSP_MemoryArena>&);
 
     protected:
-        std::string m_UID;
+        /**
+        * Sets the item type
+        *@param type - the item type
+        *@note Should be called by each constructor of a typed item, the most derived one wins
+        */
+        inline void SetType(IEType type);
+
+    private:
+        typedef TSP_SlotMap<TSP_Item*> IRegistry;
+
+        /**
+        * Allocation header, written in front of each item to know where to release it
+        */
+        struct IAllocHeader
+        {
+            std::shared_ptr<TSP_MemoryArena> m_pArena;
+            std::size_t                      m_Size = 0;
+        };
+
+        static const std::size_t m_HeaderSize = ((sizeof(IAllocHeader) + alignof(std::max_align_t) - 1) /
+                                                 alignof(std::max_align_t)) * alignof(std::max_align_t);
+
+        static IRegistry   m_Registry;
+        static std::mutex  m_Mutex;
+               IUID        m_UID            = IRegistry::m_NullHandle;
+               std::size_t m_ContainerIndex = 0;
+               IEType      m_Type           = IEType::IE_T_Unknown;
+               bool        m_Modified       = false;
 };
+
+//---------------------------------------------------------------------------
+// TSP_Item
+//---------------------------------------------------------------------------
+TSP_Item::IUID TSP_Item::GetUID() const
+{
+    return m_UID;
+}
+//---------------------------------------------------------------------------
+TSP_Item::IEType TSP_Item::GetType() const
+{
+    return m_Type;
+}
+//---------------------------------------------------------------------------
+bool TSP_Item::IsKindOf(IEType type) const
+{
+    return IsKindOf(m_Type, type);
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_Item::GetContainerIndex() const
+{
+    return m_ContainerIndex;
+}
+//---------------------------------------------------------------------------
+void TSP_Item::SetContainerIndex(std::size_t index)
+{
+    m_ContainerIndex = index;
+}
+//---------------------------------------------------------------------------
+bool TSP_Item::IsModified() const
+{
+    return m_Modified;
+}
+//---------------------------------------------------------------------------
+void TSP_Item::SetType(IEType type)
+{
+    m_Type = type;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,1528 @@
+/****************************************************************************
+ * ==> TSP_Journal ---------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Append-only journal of the document operations             *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_Journal.h"
+
+// std
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+// common classes
+#include "Common/TSP_StringHelper.h"
+#include "Common/TSP_FileHelper.h"
+#include "Common/TSP_MappedFileBuffer.h"
+#include "Common/TSP_Logger.h"
+
+// core classes
+#include "TSP_Document.h"
+#include "TSP_Atlas.h"
+#include "TSP_Page.h"
+#include "TSP_Process.h"
+#include "TSP_Link.h"
+#include "TSP_AttributeSchema.h"
+
+// system
+#if defined (_WIN32)
+    #ifndef UNICODE
+        #define UNICODE
+    #endif
+
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+//---------------------------------------------------------------------------
+// TSP_Journal::IRecord
+//---------------------------------------------------------------------------
+TSP_Journal::IRecord::IRecord(IEOperation operation)
+{
+    Write(std::uint8_t(operation));
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::IRecord::Write(std::uint8_t value)
+{
+    m_Data.push_back(char(value));
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::IRecord::Write(std::uint32_t value)
+{
+    Write(&value, sizeof(std::uint32_t));
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::IRecord::Write(const void* pData, std::size_t size)
+{
+    const char* pBytes = static_cast<const char*>(pData);
+    m_Data.insert(m_Data.end(), pBytes, pBytes + size);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::IRecord::Write(const std::string& value)
+{
+    Write(std::uint32_t(value.length()));
+    Write(value.data(), value.length());
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::IRecord::Write(const std::wstring& value)
+{
+    Write(TSP_StringHelper::Utf16ToUtf8(value));
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::IRecord::Write(const IPath& path)
+{
+    Write(std::uint32_t(path.size()));
+
+    if (!path.empty())
+        Write(path.data(), path.size() * sizeof(std::uint32_t));
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::IRecord::Write(const TSP_Attribute& value)
+{
+    const TSP_Attribute::IEFormat format = value.GetFormat();
+
+    Write(std::uint8_t(format));
+
+    // the values are written in the machine byte order, as the journal is only replayed where it was written
+    switch (format)
+    {
+        case TSP_Attribute::IEFormat::IE_Bool:
+            Write(std::uint8_t(value.Get(false) ? 1 : 0));
+            return;
+
+        case TSP_Attribute::IEFormat::IE_Int8:
+        {
+            const std::int8_t data = value.Get(std::int8_t(0));
+            Write(&data, sizeof(data));
+            return;
+        }
+
+        case TSP_Attribute::IEFormat::IE_UInt8:
+        {
+            const std::uint8_t data = value.Get(std::uint8_t(0));
+            Write(&data, sizeof(data));
+            return;
+        }
+
+        case TSP_Attribute::IEFormat::IE_Int16:
+        {
+            const std::int16_t data = value.Get(std::int16_t(0));
+            Write(&data, sizeof(data));
+            return;
+        }
+
+        case TSP_Attribute::IEFormat::IE_UInt16:
+        {
+            const std::uint16_t data = value.Get(std::uint16_t(0));
+            Write(&data, sizeof(data));
+            return;
+        }
+
+        case TSP_Attribute::IEFormat::IE_Int32:
+        {
+            const std::int32_t data = value.Get(std::int32_t(0));
+            Write(&data, sizeof(data));
+            return;
+        }
+
+        case TSP_Attribute::IEFormat::IE_UInt32:
+        {
+            const std::uint32_t data = value.Get(std::uint32_t(0));
+            Write(&data, sizeof(data));
+            return;
+        }
+
+        case TSP_Attribute::IEFormat::IE_Int64:
+        {
+            const std::int64_t data = value.Get(std::int64_t(0));
+            Write(&data, sizeof(data));
+            return;
+        }
+
+        case TSP_Attribute::IEFormat::IE_UInt64:
+        {
+            const std::uint64_t data = value.Get(std::uint64_t(0));
+            Write(&data, sizeof(data));
+            return;
+        }
+
+        case TSP_Attribute::IEFormat::IE_Float:
+        {
+            const float data = value.Get(0.0f);
+            Write(&data, sizeof(data));
+            return;
+        }
+
+        case TSP_Attribute::IEFormat::IE_Double:
+        {
+            const double data = value.Get(0.0);
+            Write(&data, sizeof(data));
+            return;
+        }
+
+        case TSP_Attribute::IEFormat::IE_String:
+            Write(value.Get(std::string()));
+            return;
+
+        case TSP_Attribute::IEFormat::IE_UnicodeString:
+        case TSP_Attribute::IEFormat::IE_Formula:
+            Write(value.Get(std::wstring()));
+            return;
+
+        case TSP_Attribute::IEFormat::IE_DateTime:
+        {
+            const std::tm      dateTime = value.Get(std::tm());
+            const std::int32_t fields[] =
+            {
+                dateTime.tm_sec,
+                dateTime.tm_min,
+                dateTime.tm_hour,
+                dateTime.tm_mday,
+                dateTime.tm_mon,
+                dateTime.tm_year,
+                dateTime.tm_wday,
+                dateTime.tm_yday,
+                dateTime.tm_isdst
+            };
+
+            Write(fields, sizeof(fields));
+            return;
+        }
+
+        default:
+            // no value, the attribute was reset
+            return;
+    }
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::IRecord::AppendTo(std::vector<char>& data) const
+{
+    const std::uint32_t size     = std::uint32_t(m_Data.size());
+    const std::uint32_t checksum = GetChecksum(m_Data.data(), m_Data.size());
+    const std::size_t   offset   = data.size();
+
+    // each record is preceded by its size and its checksum, to detect the incomplete records
+    data.resize(offset + m_HeaderSize);
+    std::memcpy(&data[offset],                         &size,     sizeof(std::uint32_t));
+    std::memcpy(&data[offset + sizeof(std::uint32_t)], &checksum, sizeof(std::uint32_t));
+    data.insert(data.end(), m_Data.begin(), m_Data.end());
+}
+//---------------------------------------------------------------------------
+// TSP_Journal::IReader
+//---------------------------------------------------------------------------
+TSP_Journal::IReader::IReader(const char* pData, std::size_t size) :
+    m_pData(pData),
+    m_Size(size)
+{}
+//---------------------------------------------------------------------------
+bool TSP_Journal::IReader::Read(std::uint8_t& value)
+{
+    return Read(&value, sizeof(std::uint8_t));
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::IReader::Read(std::uint32_t& value)
+{
+    return Read(&value, sizeof(std::uint32_t));
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::IReader::Read(void* pData, std::size_t size)
+{
+    if (size > m_Size)
+        return false;
+
+    std::memcpy(pData, m_pData, size);
+
+    m_pData += size;
+    m_Size  -= size;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::IReader::Read(std::string& value)
+{
+    std::uint32_t length;
+
+    if (!Read(length) || length > m_Size)
+        return false;
+
+    value.assign(m_pData, length);
+
+    m_pData += length;
+    m_Size  -= length;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::IReader::Read(std::wstring& value)
+{
+    std::string str;
+
+    if (!Read(str))
+        return false;
+
+    try
+    {
+        value = TSP_StringHelper::Utf8ToUtf16(str);
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::IReader::Read(IPath& path)
+{
+    std::uint32_t count;
+
+    if (!Read(count) || count > m_Size / sizeof(std::uint32_t))
+        return false;
+
+    path.resize(count);
+
+    return !count || Read(path.data(), count * sizeof(std::uint32_t));
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::IReader::Read(TSP_Attribute& value)
+{
+    std::uint8_t format;
+
+    if (!Read(format))
+        return false;
+
+    value.Clear();
+
+    switch ((TSP_Attribute::IEFormat)format)
+    {
+        case TSP_Attribute::IEFormat::IE_Undefined:
+            return true;
+
+        case TSP_Attribute::IEFormat::IE_Bool:
+        {
+            std::uint8_t data;
+
+            if (!Read(data))
+                return false;
+
+            value.Set(data != 0);
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_Int8:
+        {
+            std::int8_t data;
+
+            if (!Read(&data, sizeof(data)))
+                return false;
+
+            value.Set(data);
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_UInt8:
+        {
+            std::uint8_t data;
+
+            if (!Read(data))
+                return false;
+
+            value.Set(data);
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_Int16:
+        {
+            std::int16_t data;
+
+            if (!Read(&data, sizeof(data)))
+                return false;
+
+            value.Set(data);
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_UInt16:
+        {
+            std::uint16_t data;
+
+            if (!Read(&data, sizeof(data)))
+                return false;
+
+            value.Set(data);
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_Int32:
+        {
+            std::int32_t data;
+
+            if (!Read(&data, sizeof(data)))
+                return false;
+
+            value.Set(data);
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_UInt32:
+        {
+            std::uint32_t data;
+
+            if (!Read(data))
+                return false;
+
+            value.Set(data);
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_Int64:
+        {
+            std::int64_t data;
+
+            if (!Read(&data, sizeof(data)))
+                return false;
+
+            value.Set(data);
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_UInt64:
+        {
+            std::uint64_t data;
+
+            if (!Read(&data, sizeof(data)))
+                return false;
+
+            value.Set(data);
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_Float:
+        {
+            float data;
+
+            if (!Read(&data, sizeof(data)))
+                return false;
+
+            value.Set(data);
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_Double:
+        {
+            double data;
+
+            if (!Read(&data, sizeof(data)))
+                return false;
+
+            value.Set(data);
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_String:
+        {
+            std::string data;
+
+            if (!Read(data))
+                return false;
+
+            value.Set(std::move(data));
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_UnicodeString:
+        {
+            std::wstring data;
+
+            if (!Read(data))
+                return false;
+
+            value.Set(std::move(data));
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_Formula:
+        {
+            std::wstring formula;
+
+            if (!Read(formula))
+                return false;
+
+            value.SetFormula(formula);
+            return true;
+        }
+
+        case TSP_Attribute::IEFormat::IE_DateTime:
+        {
+            std::int32_t fields[9];
+
+            if (!Read(fields, sizeof(fields)))
+                return false;
+
+            std::tm dateTime = {};
+            dateTime.tm_sec   = fields[0];
+            dateTime.tm_min   = fields[1];
+            dateTime.tm_hour  = fields[2];
+            dateTime.tm_mday  = fields[3];
+            dateTime.tm_mon   = fields[4];
+            dateTime.tm_year  = fields[5];
+            dateTime.tm_wday  = fields[6];
+            dateTime.tm_yday  = fields[7];
+            dateTime.tm_isdst = fields[8];
+
+            value.Set(dateTime);
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+//---------------------------------------------------------------------------
+// TSP_Journal
+//---------------------------------------------------------------------------
+TSP_Journal::TSP_Journal()
+{}
+//---------------------------------------------------------------------------
+TSP_Journal::~TSP_Journal()
+{
+    Close();
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::Open(const std::wstring& fileName)
+{
+    // close the previously opened file
+    Close();
+
+    std::size_t validSize = 0;
+
+    // keep the valid records the file already contains
+    {
+        TSP_MappedFileBuffer file;
+
+        if (file.Open(fileName, TSP_FileBuffer::IEMode::IE_M_Read))
+        {
+            file.Advise(TSP_MappedFileBuffer::IEAccess::IE_A_Sequential);
+
+            validSize = GetValidSize(static_cast<const char*>(file.GetData()), file.GetSize());
+        }
+    }
+
+    #if defined (_WIN32)
+        HANDLE hFile = ::CreateFileW(fileName.c_str(),
+                                     GENERIC_WRITE,
+                                     FILE_SHARE_READ,
+                                     nullptr,
+                                     OPEN_ALWAYS,
+                                     FILE_ATTRIBUTE_NORMAL,
+                                     nullptr);
+
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            M_LogCatErrorT(IO, L"Journal - could not open the file - " << fileName);
+            return false;
+        }
+
+        LARGE_INTEGER offset;
+        offset.QuadPart = LONGLONG(validSize);
+
+        // remove the incomplete records, the next records are appended after the valid ones
+        if (!::SetFilePointerEx(hFile, offset, nullptr, FILE_BEGIN) || !::SetEndOfFile(hFile))
+        {
+            ::CloseHandle(hFile);
+            return false;
+        }
+
+        m_hFile = hFile;
+    #else
+        const int file = ::open(TSP_StringHelper::Utf16ToUtf8(fileName).c_str(), O_WRONLY | O_CREAT, 0644);
+
+        if (file < 0)
+        {
+            M_LogCatErrorT(IO, L"Journal - could not open the file - " << fileName);
+            return false;
+        }
+
+        // remove the incomplete records, the next records are appended after the valid ones
+        if (::ftruncate(file, off_t(validSize)) || ::lseek(file, off_t(validSize), SEEK_SET) < 0)
+        {
+            ::close(file);
+            return false;
+        }
+
+        m_File = file;
+    #endif
+
+    m_FileName = fileName;
+    m_Pending.clear();
+    m_Records.clear();
+    m_Position = 0;
+    m_MarkPos  = 0;
+    m_Added    = 0;
+    m_Written  = 0;
+    m_Marked   = false;
+    m_Replace  = false;
+    m_Stop     = false;
+    m_Failed   = false;
+
+    // a new journal starts with its header
+    if (!validSize)
+    {
+        m_Pending.resize(m_HeaderSize);
+        std::memcpy(&m_Pending[0],                     &m_Magic,   sizeof(std::uint32_t));
+        std::memcpy(&m_Pending[sizeof(std::uint32_t)], &m_Version, sizeof(std::uint32_t));
+        ++m_Added;
+    }
+
+    try
+    {
+        m_Thread = std::thread(&TSP_Journal::Flush, this);
+    }
+    catch (...)
+    {
+        M_LogCatErrorT(IO, L"Journal - could not start the writer thread");
+        Close();
+        return false;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::Close()
+{
+    if (m_Thread.joinable())
+    {
+        {
+            // lock up the thread
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            m_Stop = true;
+        }
+
+        // the writer thread writes the pending records before it stops
+        m_Signal.notify_all();
+        m_Thread.join();
+    }
+
+    #if defined (_WIN32)
+        if (m_hFile)
+        {
+            ::CloseHandle(m_hFile);
+            m_hFile = nullptr;
+        }
+    #else
+        if (m_File >= 0)
+        {
+            ::close(m_File);
+            m_File = -1;
+        }
+    #endif
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::IsOpened() const
+{
+    return m_Thread.joinable();
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::Reset(const std::wstring& baseFileName)
+{
+    Rebase(baseFileName, std::size_t(-1));
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_Journal::GetMark()
+{
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    // the records are only kept while a document is saved from a mark, as only the records added
+    // after it are required to rebase the journal
+    m_Records.clear();
+    m_MarkPos = m_Position;
+    m_Marked  = true;
+
+    return m_Position;
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::Rebase(const std::wstring& baseFileName, std::size_t mark)
+{
+    if (!IsOpened())
+        return;
+
+    IRecord record(IEOperation::IE_O_Base);
+    record.Write(baseFileName);
+
+    {
+        // lock up the thread
+        std::unique_lock<std::mutex> lock(m_Mutex);
+
+        // the records added before the mark are dropped, even if they were still not written
+        const std::size_t offset = !m_Marked         ? m_Records.size() :
+                                   mark < m_MarkPos ? 0                 :
+                                                      std::min(mark - m_MarkPos, m_Records.size());
+
+        // the journal is rewritten from its header
+        m_Pending.resize(m_HeaderSize);
+        std::memcpy(&m_Pending[0],                     &m_Magic,   sizeof(std::uint32_t));
+        std::memcpy(&m_Pending[sizeof(std::uint32_t)], &m_Version, sizeof(std::uint32_t));
+        record.AppendTo(m_Pending);
+        m_Pending.insert(m_Pending.end(), m_Records.begin() + offset, m_Records.end());
+
+        // the records are no longer required until the next mark
+        m_Records.clear();
+        m_Records.shrink_to_fit();
+        m_Marked  = false;
+        m_Replace = true;
+        ++m_Added;
+    }
+
+    m_Signal.notify_one();
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::Sync()
+{
+    if (!IsOpened())
+        return false;
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    const std::uint64_t added = m_Added;
+
+    m_Synced.wait(lock, [this, added]() { return m_Written >= added; });
+
+    if (m_Failed)
+    {
+        M_LogCatErrorT(IO, L"Journal - could not write the records");
+        return false;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::Replay(const std::wstring& fileName, TSP_Document* pDocument)
+{
+    if (!pDocument)
+        return false;
+
+    TSP_MappedFileBuffer file;
+
+    if (!file.Open(fileName, TSP_FileBuffer::IEMode::IE_M_Read))
+        return false;
+
+    // the records are read in order
+    file.Advise(TSP_MappedFileBuffer::IEAccess::IE_A_Sequential);
+
+    const char*       pData  = static_cast<const char*>(file.GetData());
+    const std::size_t size   = GetValidSize(pData, file.GetSize());
+          std::size_t offset = m_HeaderSize;
+          std::size_t count  = 0;
+
+    while (offset < size)
+    {
+        std::uint32_t recordSize;
+        std::memcpy(&recordSize, pData + offset, sizeof(std::uint32_t));
+
+        IReader      reader(pData + offset + m_HeaderSize, recordSize);
+        std::uint8_t operation;
+
+        offset += m_HeaderSize + recordSize;
+
+        if (!reader.Read(operation))
+            return false;
+
+        // the journal starts with the document the modifications are applied to
+        if (!count)
+        {
+            std::wstring baseFileName;
+
+            if ((IEOperation)operation != IEOperation::IE_O_Base || !reader.Read(baseFileName))
+            {
+                M_LogCatErrorT(IO, L"Journal - invalid journal - " << fileName);
+                return false;
+            }
+
+            // nothing was modified since the document was created or saved
+            if (offset >= size)
+                return false;
+
+            M_LogFmtT(IO, Info, "Journal - replaying the modifications - {}", fileName);
+
+            const bool success = baseFileName.empty() ? pDocument->Create() : pDocument->Load(baseFileName);
+
+            if (!success)
+            {
+                M_LogCatErrorT(IO, L"Journal - could not open the journal document - " << baseFileName);
+                return false;
+            }
+
+            ++count;
+            continue;
+        }
+
+        // the next operations depend on this one, so the replay stops on the first failure
+        if (!Apply(pDocument, reader, (IEOperation)operation))
+        {
+            M_LogCatErrorT(IO, L"Journal - could not replay the operation - " << count << L" - " << std::uint32_t(operation));
+            return false;
+        }
+
+        ++count;
+    }
+
+    return count > 1;
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::AddAtlas(const TSP_Atlas* pAtlas)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pAtlas, path);
+
+    if (!pJournal)
+        return;
+
+    IRecord record(IEOperation::IE_O_AddAtlas);
+    record.Write(pAtlas->GetName());
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::RemoveAtlas(const TSP_Atlas* pAtlas)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pAtlas, path);
+
+    if (!pJournal)
+        return;
+
+    IRecord record(IEOperation::IE_O_RemoveAtlas);
+    record.Write(path);
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::SetName(const TSP_Atlas* pAtlas)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pAtlas, path);
+
+    if (!pJournal)
+        return;
+
+    IRecord record(IEOperation::IE_O_SetAtlasName);
+    record.Write(path);
+    record.Write(pAtlas->GetName());
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::AddPage(const TSP_Page* pPage)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pPage, path);
+
+    if (!pJournal)
+        return;
+
+    // the page is added at the end of its container, so only the container path is required
+    path.pop_back();
+
+    IRecord record(IEOperation::IE_O_AddPage);
+    record.Write(path);
+    record.Write(pPage->GetName());
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::RemovePage(const TSP_Page* pPage)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pPage, path);
+
+    if (!pJournal)
+        return;
+
+    IRecord record(IEOperation::IE_O_RemovePage);
+    record.Write(path);
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::SetName(const TSP_Page* pPage)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pPage, path);
+
+    if (!pJournal)
+        return;
+
+    IRecord record(IEOperation::IE_O_SetPageName);
+    record.Write(path);
+    record.Write(pPage->GetName());
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::AddComponent(const TSP_Component* pComponent)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pComponent, path);
+
+    if (!pJournal)
+        return;
+
+    // the component is added at the end of its page, so only the page path is required
+    path.pop_back();
+
+    IRecord record(IEOperation::IE_O_AddComponent);
+    record.Write(path);
+    record.Write(std::uint8_t(pComponent->GetType()));
+    record.Write(pComponent->GetTitle());
+    record.Write(pComponent->GetDescription());
+    record.Write(pComponent->GetComments());
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::RemoveComponent(const TSP_Component* pComponent)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pComponent, path);
+
+    if (!pJournal)
+        return;
+
+    IRecord record(IEOperation::IE_O_RemoveComponent);
+    record.Write(path);
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::SetTitle(const TSP_Component* pComponent)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pComponent, path);
+
+    if (!pJournal)
+        return;
+
+    IRecord record(IEOperation::IE_O_SetTitle);
+    record.Write(path);
+    record.Write(pComponent->GetTitle());
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::SetDescription(const TSP_Component* pComponent)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pComponent, path);
+
+    if (!pJournal)
+        return;
+
+    IRecord record(IEOperation::IE_O_SetDescription);
+    record.Write(path);
+    record.Write(pComponent->GetDescription());
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::SetComments(const TSP_Component* pComponent)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pComponent, path);
+
+    if (!pJournal)
+        return;
+
+    IRecord record(IEOperation::IE_O_SetComments);
+    record.Write(path);
+    record.Write(pComponent->GetComments());
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::SetLinkEnd(const TSP_Link* pLink, bool isEnd)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pLink, path);
+
+    if (!pJournal)
+        return;
+
+    const TSP_Page*       pPage = static_cast<const TSP_Page*>(pLink->GetOwner());
+    TSP_Item::IUID        box   = 0;
+    TSP_LinkGraph::IESide side  = TSP_LinkGraph::IESide::IE_S_None;
+
+    if (isEnd)
+        pPage->GetLinkGraph()->GetEnd(pLink->GetUID(), box, side);
+    else
+        pPage->GetLinkGraph()->GetStart(pLink->GetUID(), box, side);
+
+    const TSP_Component* pBox = pPage->Get(box);
+
+    IRecord record(isEnd ? IEOperation::IE_O_SetLinkEnd : IEOperation::IE_O_SetLinkStart);
+    record.Write(path);
+
+    // the box is identified by its index in the link page, 0 if the link end isn't attached
+    record.Write(std::uint32_t(pBox ? pBox->GetContainerIndex() + 1 : 0));
+    record.Write(std::uint8_t(side));
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::SetAttribute(const TSP_Component* pComponent, TSP_Attribute::IEKey key)
+{
+    IPath        path;
+    TSP_Journal* pJournal = GetJournal(pComponent, path);
+
+    if (!pJournal)
+        return;
+
+    IRecord record(IEOperation::IE_O_SetAttribute);
+    record.Write(path);
+    record.Write(TSP_AttributeSchema::GetName(key));
+
+    const std::wstring formula = pComponent->GetFormula(key);
+
+    // the formula is recorded instead of its result, a reset attribute is recorded without value
+    if (!formula.empty())
+    {
+        TSP_Attribute attribute;
+        attribute.SetFormula(formula);
+        record.Write(attribute);
+    }
+    else
+    if (pComponent->HasAttribute(key))
+        record.Write(pComponent->GetAttribute(key));
+    else
+        record.Write(TSP_Attribute());
+
+    pJournal->Add(record);
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::Add(const IRecord& record)
+{
+    {
+        // lock up the thread
+        std::unique_lock<std::mutex> lock(m_Mutex);
+
+        if (m_Stop)
+            return;
+
+        const std::size_t offset = m_Pending.size();
+        record.AppendTo(m_Pending);
+        m_Position += m_Pending.size() - offset;
+
+        // the records added since the mark are also kept, to rebase the journal on the saved document
+        if (m_Marked)
+            m_Records.insert(m_Records.end(), m_Pending.begin() + offset, m_Pending.end());
+
+        ++m_Added;
+    }
+
+    m_Signal.notify_one();
+}
+//---------------------------------------------------------------------------
+void TSP_Journal::Flush()
+{
+    std::vector<char> records;
+
+    for (;;)
+    {
+        bool          replace;
+        std::uint64_t added;
+
+        {
+            // lock up the thread
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            m_Signal.wait(lock, [this]() { return m_Stop || m_Replace || !m_Pending.empty(); });
+
+            // stopped, and all the records were written?
+            if (!m_Replace && m_Pending.empty())
+                return;
+
+            records.swap(m_Pending);
+            replace   = m_Replace;
+            added     = m_Added;
+            m_Replace = false;
+        }
+
+        // the records added while these ones are written and synchronized will be grouped, and
+        // synchronized together on the next loop
+        const bool success = replace ? ReplaceFile(records.data(), records.size()) :
+                                       WriteToFile(records.data(), records.size());
+
+        {
+            // lock up the thread
+            std::unique_lock<std::mutex> lock(m_Mutex);
+
+            m_Written = added;
+
+            if (!success)
+                m_Failed = true;
+        }
+
+        m_Synced.notify_all();
+        records.clear();
+    }
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::WriteToFile(const char* pData, std::size_t size)
+{
+    #if defined (_WIN32)
+        while (size)
+        {
+            const DWORD toWrite = size > 0x40000000 ? 0x40000000 : DWORD(size);
+                  DWORD written = 0;
+
+            if (!::WriteFile(m_hFile, pData, toWrite, &written, nullptr))
+                return false;
+
+            pData += written;
+            size  -= written;
+        }
+
+        return ::FlushFileBuffers(m_hFile) != 0;
+    #else
+        while (size)
+        {
+            const ssize_t written = ::write(m_File, pData, size);
+
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                return false;
+            }
+
+            pData += written;
+            size  -= std::size_t(written);
+        }
+
+        // only the data are synchronized, not the file metadata which aren't required to read it
+        #if defined (__APPLE__)
+            return !::fsync(m_File);
+        #else
+            return !::fdatasync(m_File);
+        #endif
+    #endif
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::ReplaceFile(const char* pData, std::size_t size)
+{
+    const std::wstring tempFileName = m_FileName + L".tmp";
+
+    #if defined (_WIN32)
+        // the temporary file is renamed while it remains opened, to append the next records to it
+        HANDLE hFile = ::CreateFileW(tempFileName.c_str(),
+                                     GENERIC_WRITE,
+                                     FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                     nullptr,
+                                     CREATE_ALWAYS,
+                                     FILE_ATTRIBUTE_NORMAL,
+                                     nullptr);
+
+        if (hFile == INVALID_HANDLE_VALUE)
+            return false;
+
+        void* hJournal = m_hFile;
+        m_hFile        = hFile;
+
+        // the new content should be on the disk before it replaces the journal
+        if (!WriteToFile(pData, size))
+        {
+            ::CloseHandle(hFile);
+            TSP_FileHelper::RemoveFile(tempFileName);
+            m_hFile = hJournal;
+            return false;
+        }
+
+        // the journal can't be replaced while it's opened. NOTE if the rename fails, the next records
+        // are still appended to the temporary file, which remains complete
+        ::CloseHandle(hJournal);
+
+        return TSP_FileHelper::RenameFile(tempFileName, m_FileName);
+    #else
+        const int file = ::open(TSP_StringHelper::Utf16ToUtf8(tempFileName).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (file < 0)
+            return false;
+
+        const int journal = m_File;
+        m_File            = file;
+
+        // the new content should be on the disk before it replaces the journal
+        if (!WriteToFile(pData, size) || !TSP_FileHelper::RenameFile(tempFileName, m_FileName))
+        {
+            ::close(file);
+            TSP_FileHelper::RemoveFile(tempFileName);
+            m_File = journal;
+            return false;
+        }
+
+        // the next records are appended to the renamed file
+        ::close(journal);
+
+        return true;
+    #endif
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_Journal::GetValidSize(const char* pData, std::size_t size)
+{
+    if (!pData || size < m_HeaderSize)
+        return 0;
+
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::memcpy(&magic,   pData,                         sizeof(std::uint32_t));
+    std::memcpy(&version, pData + sizeof(std::uint32_t), sizeof(std::uint32_t));
+
+    if (magic != m_Magic || version != m_Version)
+        return 0;
+
+    std::size_t offset = m_HeaderSize;
+
+    // the records end on the first one which is incomplete, or whose content doesn't match its checksum
+    while (size - offset >= m_HeaderSize)
+    {
+        std::uint32_t recordSize;
+        std::uint32_t checksum;
+        std::memcpy(&recordSize, pData + offset,                         sizeof(std::uint32_t));
+        std::memcpy(&checksum,   pData + offset + sizeof(std::uint32_t), sizeof(std::uint32_t));
+
+        if (!recordSize || recordSize > size - offset - m_HeaderSize)
+            break;
+
+        if (GetChecksum(pData + offset + m_HeaderSize, recordSize) != checksum)
+            break;
+
+        offset += m_HeaderSize + recordSize;
+    }
+
+    return offset;
+}
+//---------------------------------------------------------------------------
+std::uint32_t TSP_Journal::GetChecksum(const char* pData, std::size_t size)
+{
+    // FNV-1a hash
+    std::uint32_t hash = 2166136261u;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= std::uint8_t(pData[i]);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+//---------------------------------------------------------------------------
+TSP_Journal* TSP_Journal::GetJournal(const TSP_Item* pItem, IPath& path)
+{
+    path.clear();
+
+    // walk up to the atlas, then to its document. Each item should be contained in its owner, e.g. a
+    // component whose properties are set before it is added is ignored, as it is recorded when added
+    while (pItem)
+    {
+        const std::size_t index = pItem->GetContainerIndex();
+
+        path.push_back(std::uint32_t(index));
+
+        if (pItem->IsKindOf(TSP_Item::IEType::IE_T_Atlas))
+        {
+            const TSP_Document* pDocument = static_cast<const TSP_Atlas*>(pItem)->GetOwner();
+
+            if (!pDocument || !pDocument->GetJournal() || pDocument->GetAtlas(index) != pItem)
+                return nullptr;
+
+            std::reverse(path.begin(), path.end());
+
+            return pDocument->GetJournal();
+        }
+
+        TSP_Item* pOwner;
+
+        if (pItem->IsKindOf(TSP_Item::IEType::IE_T_Page))
+        {
+            pOwner = static_cast<const TSP_Page*>(pItem)->GetOwner();
+
+            TSP_PageContainer* pContainer = GetContainer(pOwner);
+
+            if (!pContainer || pContainer->GetPage(index) != pItem)
+                return nullptr;
+        }
+        else
+        {
+            pOwner = static_cast<const TSP_Component*>(pItem)->GetOwner();
+
+            if (!pOwner || !pOwner->IsKindOf(TSP_Item::IEType::IE_T_Page) || static_cast<TSP_Page*>(pOwner)->GetAt(index) != pItem)
+                return nullptr;
+        }
+
+        pItem = pOwner;
+    }
+
+    return nullptr;
+}
+//---------------------------------------------------------------------------
+TSP_Item* TSP_Journal::Find(const TSP_Document* pDocument, const IPath& path)
+{
+    if (path.empty())
+        return nullptr;
+
+    TSP_Item* pItem = pDocument->GetAtlas(path[0]);
+
+    // the path alternates between the pages and the components they contain
+    for (std::size_t i = 1; pItem && i < path.size(); ++i)
+        if (i % 2)
+        {
+            TSP_PageContainer* pContainer = GetContainer(pItem);
+
+            pItem = pContainer ? pContainer->GetPage(path[i]) : nullptr;
+        }
+        else
+            pItem = static_cast<TSP_Page*>(pItem)->GetAt(path[i]);
+
+    return pItem;
+}
+//---------------------------------------------------------------------------
+TSP_PageContainer* TSP_Journal::GetContainer(TSP_Item* pItem)
+{
+    if (!pItem)
+        return nullptr;
+
+    if (pItem->IsKindOf(TSP_Item::IEType::IE_T_Atlas))
+        return static_cast<TSP_Atlas*>(pItem);
+
+    if (pItem->IsKindOf(TSP_Item::IEType::IE_T_Process))
+        return static_cast<TSP_Process*>(pItem);
+
+    return nullptr;
+}
+//---------------------------------------------------------------------------
+bool TSP_Journal::Apply(TSP_Document* pDocument, IReader& reader, IEOperation operation)
+{
+    IPath        path;
+    std::wstring text;
+
+    switch (operation)
+    {
+        case IEOperation::IE_O_AddAtlas:
+            return reader.Read(text) && pDocument->CreateAndAddAtlas(text);
+
+        case IEOperation::IE_O_RemoveAtlas:
+        case IEOperation::IE_O_SetAtlasName:
+        {
+            if (!reader.Read(path))
+                return false;
+
+            TSP_Item* pItem = Find(pDocument, path);
+
+            if (!pItem || !pItem->IsKindOf(TSP_Item::IEType::IE_T_Atlas))
+                return false;
+
+            TSP_Atlas* pAtlas = static_cast<TSP_Atlas*>(pItem);
+
+            if (operation == IEOperation::IE_O_RemoveAtlas)
+            {
+                pDocument->RemoveAtlas(pAtlas);
+                return true;
+            }
+
+            if (!reader.Read(text))
+                return false;
+
+            pAtlas->SetName(text);
+            return true;
+        }
+
+        case IEOperation::IE_O_AddPage:
+        {
+            if (!reader.Read(path) || !reader.Read(text))
+                return false;
+
+            TSP_PageContainer* pContainer = GetContainer(Find(pDocument, path));
+
+            return pContainer && pContainer->CreateAndAddPage(text);
+        }
+
+        case IEOperation::IE_O_RemovePage:
+        case IEOperation::IE_O_SetPageName:
+        {
+            if (!reader.Read(path))
+                return false;
+
+            TSP_Item* pItem = Find(pDocument, path);
+
+            if (!pItem || !pItem->IsKindOf(TSP_Item::IEType::IE_T_Page))
+                return false;
+
+            TSP_Page* pPage = static_cast<TSP_Page*>(pItem);
+
+            if (operation == IEOperation::IE_O_RemovePage)
+            {
+                TSP_PageContainer* pContainer = GetContainer(pPage->GetOwner());
+
+                if (!pContainer)
+                    return false;
+
+                pContainer->RemovePage(pPage);
+                return true;
+            }
+
+            if (!reader.Read(text))
+                return false;
+
+            pPage->SetName(text);
+            return true;
+        }
+
+        case IEOperation::IE_O_AddComponent:
+        {
+            std::uint8_t type;
+            std::wstring description;
+            std::wstring comments;
+
+            if (!reader.Read(path) || !reader.Read(type) || !reader.Read(text) || !reader.Read(description) || !reader.Read(comments))
+                return false;
+
+            TSP_Item* pItem = Find(pDocument, path);
+
+            if (!pItem || !pItem->IsKindOf(TSP_Item::IEType::IE_T_Page))
+                return false;
+
+            TSP_Page* pPage = static_cast<TSP_Page*>(pItem);
+
+            switch ((TSP_Item::IEType)type)
+            {
+                case TSP_Item::IEType::IE_T_Box:      return pPage->CreateAndAddBox     (text, description, comments);
+                case TSP_Item::IEType::IE_T_Process:  return pPage->CreateAndAddProcess (text, description, comments);
+                case TSP_Item::IEType::IE_T_Activity: return pPage->CreateAndAddActivity(text, description, comments);
+                case TSP_Item::IEType::IE_T_Link:     return pPage->CreateAndAddLink    (text, description, comments);
+                case TSP_Item::IEType::IE_T_Message:  return pPage->CreateAndAddMessage (text, description, comments);
+                default:                              return false;
+            }
+        }
+
+        case IEOperation::IE_O_RemoveComponent:
+        case IEOperation::IE_O_SetTitle:
+        case IEOperation::IE_O_SetDescription:
+        case IEOperation::IE_O_SetComments:
+        case IEOperation::IE_O_SetLinkStart:
+        case IEOperation::IE_O_SetLinkEnd:
+        case IEOperation::IE_O_SetAttribute:
+        {
+            // the path of a component has an odd length greater than 1, e.g. atlas, page, component
+            if (!reader.Read(path) || path.size() < 3 || !(path.size() % 2))
+                return false;
+
+            TSP_Item* pItem = Find(pDocument, path);
+
+            if (!pItem)
+                return false;
+
+            TSP_Component* pComponent = static_cast<TSP_Component*>(pItem);
+            TSP_Page*      pPage      = static_cast<TSP_Page*>(pComponent->GetOwner());
+
+            switch (operation)
+            {
+                case IEOperation::IE_O_RemoveComponent:
+                    pPage->Remove(pComponent);
+                    return true;
+
+                case IEOperation::IE_O_SetTitle:       return reader.Read(text) && pComponent->SetTitle(text);
+                case IEOperation::IE_O_SetDescription: return reader.Read(text) && pComponent->SetDescription(text);
+                case IEOperation::IE_O_SetComments:    return reader.Read(text) && pComponent->SetComments(text);
+
+                case IEOperation::IE_O_SetLinkStart:
+                case IEOperation::IE_O_SetLinkEnd:
+                {
+                    std::uint32_t boxIndex;
+                    std::uint8_t  side;
+
+                    if (!pComponent->IsKindOf(TSP_Item::IEType::IE_T_Link) || !reader.Read(boxIndex) || !reader.Read(side))
+                        return false;
+
+                    if (side > std::uint8_t(TSP_LinkGraph::IESide::IE_S_Bottom))
+                        return false;
+
+                    TSP_Item::IUID box = 0;
+
+                    // the box is identified by its index in the link page
+                    if (boxIndex)
+                    {
+                        TSP_Component* pBox = pPage->GetAt(boxIndex - 1);
+
+                        if (!pBox || !pBox->IsKindOf(TSP_Item::IEType::IE_T_Box))
+                            return false;
+
+                        box = pBox->GetUID();
+                    }
+
+                    if (operation == IEOperation::IE_O_SetLinkEnd)
+                        pPage->GetLinkGraph()->SetEnd(pComponent->GetUID(), box, (TSP_LinkGraph::IESide)side);
+                    else
+                        pPage->GetLinkGraph()->SetStart(pComponent->GetUID(), box, (TSP_LinkGraph::IESide)side);
+
+                    return true;
+                }
+
+                default:
+                {
+                    TSP_Attribute value;
+
+                    if (!reader.Read(text) || !reader.Read(value))
+                        return false;
+
+                    const TSP_Attribute::IEKey key = TSP_AttributeSchema::Find(text);
+
+                    // unknown key, e.g. removed since the journal was written
+                    if (key == TSP_Attribute::IEKey::IE_K_Unknown)
+                        return true;
+
+                    if (value.GetFormat() == TSP_Attribute::IEFormat::IE_Undefined)
+                    {
+                        pComponent->ResetAttribute(key);
+                        return true;
+                    }
+
+                    return pComponent->SetAttribute(key, value);
+                }
+            }
+        }
+
+        default:
+            return false;
+    }
+}
+//---------------------------------------------------------------------------
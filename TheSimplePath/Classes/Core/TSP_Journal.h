@@ -0,0 +1,407 @@
+/****************************************************************************
+ * ==> TSP_Journal ---------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Append-only journal of the document operations             *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// core classes
+#include "TSP_Item.h"
+#include "TSP_Attribute.h"
+#include "TSP_LinkGraph.h"
+
+// class prototypes
+class TSP_Document;
+class TSP_PageContainer;
+class TSP_Page;
+class TSP_Atlas;
+class TSP_Component;
+class TSP_Link;
+
+/**
+* Operation journal, records each document modification as a compact binary record appended to a
+* file. The records are written and synchronized on the disk by a background thread, the records
+* added while the previous ones are synchronized are grouped and synchronized together. After a
+* crash, the journal is replayed on the document it was started from, to recover the modifications
+* done since the document was last saved
+*@note The items are identified by their container index path from the document, e.g. atlas index,
+*      page index, component index, sub-process page index, ... As the operations are replayed in
+*      the same order on the same document, the paths are resolved to the same items
+*@author Jean-Milost Reymond
+*/
+class TSP_Journal
+{
+    public:
+        /**
+        * Operations
+        */
+        enum class IEOperation
+        {
+            IE_O_Base = 0,
+            IE_O_AddAtlas,
+            IE_O_RemoveAtlas,
+            IE_O_SetAtlasName,
+            IE_O_AddPage,
+            IE_O_RemovePage,
+            IE_O_SetPageName,
+            IE_O_AddComponent,
+            IE_O_RemoveComponent,
+            IE_O_SetTitle,
+            IE_O_SetDescription,
+            IE_O_SetComments,
+            IE_O_SetLinkStart,
+            IE_O_SetLinkEnd,
+            IE_O_SetAttribute,
+            IE_O_Count
+        };
+
+        TSP_Journal();
+        virtual ~TSP_Journal();
+
+        /**
+        * Opens the journal file, the records it already contains are kept
+        *@param fileName - journal file name, created if not exists
+        *@return true on success, otherwise false
+        *@note The incomplete record the file may end with, e.g. if the application crashed while it
+        *      was written, is removed
+        */
+        virtual bool Open(const std::wstring& fileName);
+
+        /**
+        * Closes the journal file, after the pending records were written
+        */
+        virtual void Close();
+
+        /**
+        * Checks if the journal file is opened
+        *@return true if the journal file is opened, otherwise false
+        */
+        virtual bool IsOpened() const;
+
+        /**
+        * Clears the journal, and starts it from a document
+        *@param baseFileName - document file the modifications are applied to, empty for a new document
+        *@note Called each time a document is created, loaded or saved
+        */
+        virtual void Reset(const std::wstring& baseFileName);
+
+        /**
+        * Gets the current journal position, and keeps the records added from it
+        *@return the journal position, to rebase the journal on a document saved from this position
+        *@note The records are only kept from the last mark until the journal is rebased, so a new mark
+        *      replaces the previous one
+        */
+        virtual std::size_t GetMark();
+
+        /**
+        * Clears the records added before a position, and starts the journal from a document
+        *@param baseFileName - document file the modifications are applied to
+        *@param mark - journal position the document was saved from, the records added after it are kept
+        *@note Used when the document was saved while it was still modified, e.g. in background. The
+        *      journal is rewritten in a temporary file, which replaces it once synchronized
+        */
+        virtual void Rebase(const std::wstring& baseFileName, std::size_t mark);
+
+        /**
+        * Waits until all the added records are synchronized on the disk
+        *@return true on success, false if the journal could not be written
+        */
+        virtual bool Sync();
+
+        /**
+        * Replays a journal file on a document
+        *@param fileName - journal file name
+        *@param pDocument - document to apply the modifications to, it is created or loaded from the
+        *                   journal base file first
+        *@return true if modifications were replayed, otherwise false
+        *@note The document should not be attached to a journal while replayed
+        */
+        static bool Replay(const std::wstring& fileName, TSP_Document* pDocument);
+
+        /**
+        * Records that an atlas was added
+        *@param pAtlas - added atlas
+        *@note Like all the record functions, does nothing if the item document has no journal
+        */
+        static void AddAtlas(const TSP_Atlas* pAtlas);
+
+        /**
+        * Records that an atlas will be removed
+        *@param pAtlas - atlas to remove, should still be contained in its document
+        */
+        static void RemoveAtlas(const TSP_Atlas* pAtlas);
+
+        /**
+        * Records an atlas name
+        *@param pAtlas - atlas whose name changed
+        */
+        static void SetName(const TSP_Atlas* pAtlas);
+
+        /**
+        * Records that a page was added
+        *@param pPage - added page
+        */
+        static void AddPage(const TSP_Page* pPage);
+
+        /**
+        * Records that a page will be removed
+        *@param pPage - page to remove, should still be contained in its container
+        */
+        static void RemovePage(const TSP_Page* pPage);
+
+        /**
+        * Records a page name
+        *@param pPage - page whose name changed
+        */
+        static void SetName(const TSP_Page* pPage);
+
+        /**
+        * Records that a component was added
+        *@param pComponent - added component
+        */
+        static void AddComponent(const TSP_Component* pComponent);
+
+        /**
+        * Records that a component will be removed
+        *@param pComponent - component to remove, should still be contained in its page
+        */
+        static void RemoveComponent(const TSP_Component* pComponent);
+
+        /**
+        * Records a component title
+        *@param pComponent - component whose title changed
+        */
+        static void SetTitle(const TSP_Component* pComponent);
+
+        /**
+        * Records a component description
+        *@param pComponent - component whose description changed
+        */
+        static void SetDescription(const TSP_Component* pComponent);
+
+        /**
+        * Records a component comments
+        *@param pComponent - component whose comments changed
+        */
+        static void SetComments(const TSP_Component* pComponent);
+
+        /**
+        * Records a link start or end
+        *@param pLink - link whose start or end changed
+        *@param isEnd - if true the link end changed, otherwise the link start
+        */
+        static void SetLinkEnd(const TSP_Link* pLink, bool isEnd);
+
+        /**
+        * Records a component attribute, its value or its formula
+        *@param pComponent - component whose attribute changed
+        *@param key - attribute key
+        */
+        static void SetAttribute(const TSP_Component* pComponent, TSP_Attribute::IEKey key);
+
+    private:
+        typedef std::vector<std::uint32_t> IPath;
+
+        /**
+        * Record, built before it is added to the journal
+        */
+        class IRecord
+        {
+            public:
+                std::vector<char> m_Data;
+
+                /**
+                * Constructor
+                *@param operation - record operation
+                */
+                IRecord(IEOperation operation);
+
+                /**
+                * Writes a value
+                *@param value - value to write
+                */
+                void Write(std::uint8_t         value);
+                void Write(std::uint32_t        value);
+                void Write(const void*          pData, std::size_t size);
+                void Write(const std::string&   value);
+                void Write(const std::wstring&  value);
+                void Write(const IPath&         path);
+                void Write(const TSP_Attribute& value);
+
+                /**
+                * Appends the record, preceded by its size and checksum, to the journal data
+                *@param[in, out] data - journal data to append to
+                */
+                void AppendTo(std::vector<char>& data) const;
+        };
+
+        /**
+        * Record reader
+        */
+        class IReader
+        {
+            public:
+                /**
+                * Constructor
+                *@param pData - record data
+                *@param size - record size, in bytes
+                */
+                IReader(const char* pData, std::size_t size);
+
+                /**
+                * Reads a value
+                *@param[out] value - read value
+                *@return true on success, false if the record is too short
+                */
+                bool Read(std::uint8_t&  value);
+                bool Read(std::uint32_t& value);
+                bool Read(void*          pData, std::size_t size);
+                bool Read(std::string&   value);
+                bool Read(std::wstring&  value);
+                bool Read(IPath&         path);
+                bool Read(TSP_Attribute& value);
+
+            private:
+                const char* m_pData = nullptr;
+                std::size_t m_Size  = 0;
+        };
+
+        static const std::uint32_t m_Magic   = 0x4a505354; // "TSPJ"
+        static const std::uint32_t m_Version = 1;
+
+        // size of the journal header, and of the header preceding each record
+        static const std::size_t m_HeaderSize = 2 * sizeof(std::uint32_t);
+
+        std::mutex              m_Mutex;
+        std::condition_variable m_Signal;
+        std::condition_variable m_Synced;
+        std::thread             m_Thread;
+        std::wstring            m_FileName;
+        std::vector<char>       m_Pending;
+        std::vector<char>       m_Records;
+        std::size_t             m_Position  = 0;
+        std::size_t             m_MarkPos   = 0;
+        std::uint64_t           m_Added     = 0;
+        std::uint64_t           m_Written   = 0;
+        bool                    m_Marked    = false;
+        bool                    m_Replace   = false;
+        bool                    m_Stop      = false;
+        bool                    m_Failed    = false;
+
+        #if defined (_WIN32)
+            void* m_hFile = nullptr;
+        #else
+            int   m_File  = -1;
+        #endif
+
+        /**
+        * Adds a record to the journal
+        *@param record - record to add
+        */
+        void Add(const IRecord& record);
+
+        /**
+        * Writes the pending records and synchronizes them on the disk, runs in the background thread
+        */
+        void Flush();
+
+        /**
+        * Appends data to the journal file
+        *@param pData - data to write
+        *@param size - data size, in bytes
+        *@return true on success, otherwise false
+        */
+        bool WriteToFile(const char* pData, std::size_t size);
+
+        /**
+        * Replaces the journal file content
+        *@param pData - new content
+        *@param size - new content size, in bytes
+        *@return true on success, otherwise false
+        *@note The content is written and synchronized in a temporary file, which is then renamed to
+        *      the journal file, so the journal contains either its previous or its new content
+        */
+        bool ReplaceFile(const char* pData, std::size_t size);
+
+        /**
+        * Gets the size of the valid records contained in a journal
+        *@param pData - journal content
+        *@param size - journal content size, in bytes
+        *@return the size of the valid content, 0 if the journal header is invalid
+        */
+        static std::size_t GetValidSize(const char* pData, std::size_t size);
+
+        /**
+        * Calculates a record checksum
+        *@param pData - record data
+        *@param size - record size, in bytes
+        *@return the checksum
+        */
+        static std::uint32_t GetChecksum(const char* pData, std::size_t size);
+
+        /**
+        * Gets the journal of an item document, and the item path
+        *@param pItem - item, an atlas, a page or a component
+        *@param[out] path - item path from its document
+        *@return the journal, nullptr if the item document has no journal or the item isn't contained
+        *        in a document
+        */
+        static TSP_Journal* GetJournal(const TSP_Item* pItem, IPath& path);
+
+        /**
+        * Finds an item from its path
+        *@param pDocument - document containing the item
+        *@param path - item path from the document
+        *@return the item, nullptr if not found
+        */
+        static TSP_Item* Find(const TSP_Document* pDocument, const IPath& path);
+
+        /**
+        * Gets an item as a page container
+        *@param pItem - item, an atlas or a process
+        *@return the page container, nullptr if the item doesn't contain pages
+        */
+        static TSP_PageContainer* GetContainer(TSP_Item* pItem);
+
+        /**
+        * Applies a record on a document
+        *@param pDocument - document to apply the record to
+        *@param reader - record reader, positioned after the operation
+        *@param operation - record operation
+        *@return true on success, otherwise false
+        */
+        static bool Apply(TSP_Document* pDocument, IReader& reader, IEOperation operation);
+};
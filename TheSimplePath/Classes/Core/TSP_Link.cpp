@@ -29,20 +29,63 @@
 
 #include "TSP_Link.h"
 
+// core classes
+#include "TSP_Page.h"
+
 //---------------------------------------------------------------------------
 // TSP_Link
 //---------------------------------------------------------------------------
 TSP_Link::TSP_Link(TSP_Page* pOwner) :
     TSP_Component(pOwner)
-{}
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Link::TSP_Link(const std::wstring& title,
                    const std::wstring& description,
                    const std::wstring& comments,
                          TSP_Page*     pOwner) :
     TSP_Component(title, description, comments, pOwner)
-{}
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Link::~TSP_Link()
 {}
 //---------------------------------------------------------------------------
+bool TSP_Link::SaveMembers(TSP_JsonHelper::IBufferWriterW& writer) const
+{
+    if (!TSP_Component::SaveMembers(writer))
+        return false;
+
+    // the link ends are kept in the owning page graph
+    if (!m_pOwner || !m_pOwner->IsKindOf(IEType::IE_T_Page))
+        return true;
+
+    const TSP_LinkGraph*        pGraph = static_cast<TSP_Page*>(m_pOwner)->GetLinkGraph();
+          IUID                  box    = 0;
+          TSP_LinkGraph::IESide side   = TSP_LinkGraph::IESide::IE_S_None;
+
+    if (pGraph->GetStart(GetUID(), box, side) && !SaveEnd(writer, L"start", box, side))
+        return false;
+
+    if (pGraph->GetEnd(GetUID(), box, side) && !SaveEnd(writer, L"end", box, side))
+        return false;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_Link::SaveEnd(TSP_JsonHelper::IBufferWriterW& writer, const wchar_t* pName, IUID box, TSP_LinkGraph::IESide side)
+{
+    if (!writer.Key(pName) || !writer.StartObject())
+        return false;
+
+    if (!writer.Key(L"box") || !writer.Uint64(box))
+        return false;
+
+    if (!writer.Key(L"side") || !writer.Uint(unsigned(side)))
+        return false;
+
+    return writer.EndObject();
+}
+//---------------------------------------------------------------------------
@@ -34,6 +34,7 @@
 
 // core classes
 #include "TSP_Component.h"
+#include "TSP_LinkGraph.h"
 
 /**
 * Link component
@@ -42,6 +43,8 @@
 class TSP_Link : public TSP_Component
 {
     public:
+        static const IEType m_ClassType = IEType::IE_T_Link;
+
         /**
         * Constructor
         *@param pOwner - component owner
@@ -61,4 +64,23 @@ class TSP_Link : public TSP_Component
                        TSP_Page*     pOwner);
 
         virtual ~TSP_Link();
+
+    protected:
+        /**
+        * Saves the link members, without the object enclosing them
+        *@param writer - json writer to save to
+        *@return true on success, otherwise false
+        */
+        virtual bool SaveMembers(TSP_JsonHelper::IBufferWriterW& writer) const;
+
+    private:
+        /**
+        * Saves a link end
+        *@param writer - json writer to save to
+        *@param pName - link end member name
+        *@param box - box unique identifier on which the link end is attached
+        *@param side - box side on which the link end is attached
+        *@return true on success, otherwise false
+        */
+        static bool SaveEnd(TSP_JsonHelper::IBufferWriterW& writer, const wchar_t* pName, IUID box, TSP_LinkGraph::IESide side);
 };
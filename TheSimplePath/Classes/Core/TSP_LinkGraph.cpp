@@ -0,0 +1,329 @@
+/****************************************************************************
+ * ==> TSP_LinkGraph -------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Graph indexing the links entering and exiting each box     *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_LinkGraph.h"
+
+// std
+#include <algorithm>
+
+//---------------------------------------------------------------------------
+// TSP_LinkGraph
+//---------------------------------------------------------------------------
+TSP_LinkGraph::TSP_LinkGraph()
+{}
+//---------------------------------------------------------------------------
+TSP_LinkGraph::TSP_LinkGraph(TSP_Item* pOwner) :
+    m_pOwner(pOwner)
+{}
+//---------------------------------------------------------------------------
+TSP_LinkGraph::~TSP_LinkGraph()
+{}
+//---------------------------------------------------------------------------
+void TSP_LinkGraph::SetStart(TSP_Item::IUID link, TSP_Item::IUID box, IESide side)
+{
+    SetLinkEnd(link, box, side, IEDirection::IE_D_Exiting);
+}
+//---------------------------------------------------------------------------
+void TSP_LinkGraph::SetEnd(TSP_Item::IUID link, TSP_Item::IUID box, IESide side)
+{
+    SetLinkEnd(link, box, side, IEDirection::IE_D_Entering);
+}
+//---------------------------------------------------------------------------
+bool TSP_LinkGraph::GetStart(TSP_Item::IUID link, TSP_Item::IUID& box, IESide& side) const
+{
+    ILinkEndsMap::const_iterator it = m_LinkEnds.find(link);
+
+    if (it == m_LinkEnds.end())
+        return false;
+
+    box  = it->second.m_Start.m_Box;
+    side = it->second.m_Start.m_Side;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+bool TSP_LinkGraph::GetEnd(TSP_Item::IUID link, TSP_Item::IUID& box, IESide& side) const
+{
+    ILinkEndsMap::const_iterator it = m_LinkEnds.find(link);
+
+    if (it == m_LinkEnds.end())
+        return false;
+
+    box  = it->second.m_End.m_Box;
+    side = it->second.m_End.m_Side;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+void TSP_LinkGraph::RemoveLink(TSP_Item::IUID link)
+{
+    ILinkEndsMap::iterator it = m_LinkEnds.find(link);
+
+    if (it == m_LinkEnds.end())
+        return;
+
+    // detach the link from its boxes
+    if (it->second.m_Start.m_Box)
+        Detach(it->second.m_Start.m_Box, link, IEDirection::IE_D_Exiting);
+
+    if (it->second.m_End.m_Box)
+        Detach(it->second.m_End.m_Box, link, IEDirection::IE_D_Entering);
+
+    m_LinkEnds.erase(it);
+
+    if (m_pOwner)
+        m_pOwner->SetModified();
+}
+//---------------------------------------------------------------------------
+void TSP_LinkGraph::RemoveBox(TSP_Item::IUID box, ILinks* pLinks)
+{
+    INodes::iterator it = m_Nodes.find(box);
+
+    if (it == m_Nodes.end())
+        return;
+
+    const INode& node = it->second;
+
+    // get the attached links. NOTE a link looping on the box has both its ends on it, so it is only
+    // added once, from its start
+    if (pLinks)
+        for (std::size_t i = 0; i < node.m_Count; ++i)
+        {
+            const IIncidence& incidence = m_Incidences[node.m_Offset + i];
+
+            if (incidence.m_Direction == IEDirection::IE_D_Entering)
+            {
+                ILinkEndsMap::const_iterator itEnds = m_LinkEnds.find(incidence.m_Link);
+
+                if (itEnds != m_LinkEnds.end() && itEnds->second.m_Start.m_Box == box)
+                    continue;
+            }
+
+            pLinks->push_back(incidence.m_Link);
+        }
+
+    // detach each link end attached to the box
+    for (std::size_t i = 0; i < node.m_Count; ++i)
+    {
+        const IIncidence& incidence = m_Incidences[node.m_Offset + i];
+
+        ILinkEndsMap::iterator itEnds = m_LinkEnds.find(incidence.m_Link);
+
+        if (itEnds == m_LinkEnds.end())
+            continue;
+
+        IEnd& end = incidence.m_Direction == IEDirection::IE_D_Exiting ? itEnds->second.m_Start :
+                                                                           itEnds->second.m_End;
+        end = IEnd();
+    }
+
+    m_Unused += node.m_Capacity;
+    m_Nodes.erase(it);
+
+    if (m_pOwner)
+        m_pOwner->SetModified();
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_LinkGraph::GetDegree(TSP_Item::IUID box) const
+{
+    INodes::const_iterator it = m_Nodes.find(box);
+
+    if (it == m_Nodes.end())
+        return 0;
+
+    return it->second.m_Count;
+}
+//---------------------------------------------------------------------------
+const TSP_LinkGraph::IIncidence* TSP_LinkGraph::GetIncidences(TSP_Item::IUID box) const
+{
+    INodes::const_iterator it = m_Nodes.find(box);
+
+    if (it == m_Nodes.end() || !it->second.m_Count)
+        return nullptr;
+
+    return &m_Incidences[it->second.m_Offset];
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_LinkGraph::GetLinks(TSP_Item::IUID  box,
+                                    IEDirection     direction,
+                                    IESide          side,
+                                    ILinks&         links) const
+{
+    INodes::const_iterator it = m_Nodes.find(box);
+
+    if (it == m_Nodes.end())
+        return 0;
+
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < it->second.m_Count; ++i)
+    {
+        const IIncidence& incidence = m_Incidences[it->second.m_Offset + i];
+
+        if (incidence.m_Direction != direction)
+            continue;
+
+        if (side != IESide::IE_S_None && incidence.m_Side != side)
+            continue;
+
+        links.push_back(incidence.m_Link);
+        ++count;
+    }
+
+    return count;
+}
+//---------------------------------------------------------------------------
+void TSP_LinkGraph::Clear()
+{
+    m_Nodes.clear();
+    m_LinkEnds.clear();
+    m_Incidences.clear();
+    m_Unused = 0;
+
+    if (m_pOwner)
+        m_pOwner->SetModified();
+}
+//---------------------------------------------------------------------------
+void TSP_LinkGraph::Compact()
+{
+    IIncidences incidences;
+    incidences.reserve(m_Incidences.size() - m_Unused);
+
+    // copy each range, keeping its room to grow
+    for (INodes::iterator it = m_Nodes.begin(); it != m_Nodes.end(); ++it)
+    {
+        INode&            node   = it->second;
+        const std::size_t offset = incidences.size();
+
+        incidences.insert(incidences.end(),
+                          m_Incidences.begin() + node.m_Offset,
+                          m_Incidences.begin() + node.m_Offset + node.m_Capacity);
+
+        node.m_Offset = offset;
+    }
+
+    m_Incidences.swap(incidences);
+    m_Unused = 0;
+}
+//---------------------------------------------------------------------------
+void TSP_LinkGraph::SetLinkEnd(TSP_Item::IUID link, TSP_Item::IUID box, IESide side, IEDirection direction)
+{
+    if (!link)
+        return;
+
+    ILinkEnds& ends = m_LinkEnds[link];
+    IEnd&      end  = direction == IEDirection::IE_D_Exiting ? ends.m_Start : ends.m_End;
+
+    // nothing to do if the link end doesn't change
+    if (end.m_Box == box && end.m_Side == side)
+        return;
+
+    if (m_pOwner)
+        m_pOwner->SetModified();
+
+    // detach the link end from its previous box
+    if (end.m_Box)
+        Detach(end.m_Box, link, direction);
+
+    end = IEnd();
+
+    if (!box)
+        return;
+
+    IIncidence incidence;
+    incidence.m_Link      = link;
+    incidence.m_Side      = side;
+    incidence.m_Direction = direction;
+
+    Attach(box, incidence);
+
+    end.m_Box  = box;
+    end.m_Side = side;
+}
+//---------------------------------------------------------------------------
+void TSP_LinkGraph::Attach(TSP_Item::IUID box, const IIncidence& incidence)
+{
+    INode& node = m_Nodes[box];
+
+    // no more room in the box range?
+    if (node.m_Count == node.m_Capacity)
+    {
+        // too much unused space? Compact the array before growing it
+        if (m_Unused && m_Unused >= m_Incidences.size() / 2)
+            Compact();
+
+        const std::uint32_t capacity = node.m_Capacity ? node.m_Capacity * 2 : 4;
+        const std::size_t   offset   = m_Incidences.size();
+
+        // move the range to the array end, with twice the room
+        m_Incidences.resize(offset + capacity);
+        std::copy(m_Incidences.begin() + node.m_Offset,
+                  m_Incidences.begin() + node.m_Offset + node.m_Count,
+                  m_Incidences.begin() + offset);
+
+        m_Unused        += node.m_Capacity;
+        node.m_Offset    = offset;
+        node.m_Capacity  = capacity;
+    }
+
+    m_Incidences[node.m_Offset + node.m_Count] = incidence;
+    ++node.m_Count;
+}
+//---------------------------------------------------------------------------
+void TSP_LinkGraph::Detach(TSP_Item::IUID box, TSP_Item::IUID link, IEDirection direction)
+{
+    INodes::iterator it = m_Nodes.find(box);
+
+    if (it == m_Nodes.end())
+        return;
+
+    INode& node = it->second;
+
+    // search for the incidence in the box range
+    for (std::size_t i = 0; i < node.m_Count; ++i)
+    {
+        IIncidence& incidence = m_Incidences[node.m_Offset + i];
+
+        if (incidence.m_Link != link || incidence.m_Direction != direction)
+            continue;
+
+        // move the last incidence to the removed one place
+        incidence = m_Incidences[node.m_Offset + node.m_Count - 1];
+        --node.m_Count;
+        break;
+    }
+
+    // release the range of a box without links
+    if (!node.m_Count)
+    {
+        m_Unused += node.m_Capacity;
+        m_Nodes.erase(it);
+    }
+}
+//---------------------------------------------------------------------------
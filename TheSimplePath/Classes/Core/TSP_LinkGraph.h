@@ -0,0 +1,241 @@
+/****************************************************************************
+ * ==> TSP_LinkGraph -------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Graph indexing the links entering and exiting each box     *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// core classes
+#include "TSP_Item.h"
+
+/**
+* Graph indexing the links entering and exiting each box of a page
+*@note The incidences of a box are kept in a contiguous range of a single array (CSR like), with some
+*      room left to grow. A range which becomes too small is moved to the array end, and the array is
+*      compacted when the unused space exceeds the used one
+*@author Jean-Milost Reymond
+*/
+class TSP_LinkGraph
+{
+    public:
+        /**
+        * Box side on which a link is attached
+        *@note This enum is linked with TSP_QmlBox::IEPosition, don't modify it without updating its twin
+        */
+        enum class IESide : std::uint8_t
+        {
+            IE_S_None = 0,
+            IE_S_Left,
+            IE_S_Top,
+            IE_S_Right,
+            IE_S_Bottom
+        };
+
+        /**
+        * Link direction, relatively to a box
+        */
+        enum class IEDirection : std::uint8_t
+        {
+            IE_D_Entering = 0,
+            IE_D_Exiting
+        };
+
+        /**
+        * Link incidence on a box
+        */
+        struct IIncidence
+        {
+            TSP_Item::IUID m_Link      = 0;
+            IESide         m_Side      = IESide::IE_S_None;
+            IEDirection    m_Direction = IEDirection::IE_D_Exiting;
+        };
+
+        typedef std::vector<TSP_Item::IUID> ILinks;
+
+        TSP_LinkGraph();
+
+        /**
+        * Constructor
+        *@param pOwner - item owning the graph, marked as modified when the graph changes
+        */
+        TSP_LinkGraph(TSP_Item* pOwner);
+
+        virtual ~TSP_LinkGraph();
+
+        /**
+        * Attaches the link start to a box, the link exits this box
+        *@param link - link unique identifier
+        *@param box - box unique identifier, if 0 the link start is only detached from its previous box
+        *@param side - box side on which the link is attached
+        */
+        virtual void SetStart(TSP_Item::IUID link, TSP_Item::IUID box, IESide side);
+
+        /**
+        * Attaches the link end to a box, the link enters this box
+        *@param link - link unique identifier
+        *@param box - box unique identifier, if 0 the link end is only detached from its previous box
+        *@param side - box side on which the link is attached
+        */
+        virtual void SetEnd(TSP_Item::IUID link, TSP_Item::IUID box, IESide side);
+
+        /**
+        * Gets the box and side the link starts from
+        *@param link - link unique identifier
+        *@param[out] box - box unique identifier, 0 if the link start isn't attached
+        *@param[out] side - box side on which the link is attached
+        *@return true if the link is known by the graph, otherwise false
+        */
+        virtual bool GetStart(TSP_Item::IUID link, TSP_Item::IUID& box, IESide& side) const;
+
+        /**
+        * Gets the box and side the link ends to
+        *@param link - link unique identifier
+        *@param[out] box - box unique identifier, 0 if the link end isn't attached
+        *@param[out] side - box side on which the link is attached
+        *@return true if the link is known by the graph, otherwise false
+        */
+        virtual bool GetEnd(TSP_Item::IUID link, TSP_Item::IUID& box, IESide& side) const;
+
+        /**
+        * Removes a link from the graph
+        *@param link - link unique identifier to remove
+        */
+        virtual void RemoveLink(TSP_Item::IUID link);
+
+        /**
+        * Removes a box from the graph, the links attached to it are detached
+        *@param box - box unique identifier to remove
+        *@param pLinks - if not nullptr, the list to which the detached links will be added, once each
+        */
+        virtual void RemoveBox(TSP_Item::IUID box, ILinks* pLinks = nullptr);
+
+        /**
+        * Gets the number of link ends attached to a box
+        *@param box - box unique identifier
+        *@return the number of link ends attached to the box
+        */
+        virtual std::size_t GetDegree(TSP_Item::IUID box) const;
+
+        /**
+        * Gets the link incidences of a box
+        *@param box - box unique identifier
+        *@return the incidences, GetDegree() items are contiguous from the returned one, nullptr if none
+        *@note The returned pointer is invalidated by the next graph modification
+        */
+        virtual const IIncidence* GetIncidences(TSP_Item::IUID box) const;
+
+        /**
+        * Gets the links attached to a box
+        *@param box - box unique identifier
+        *@param direction - link direction to get
+        *@param side - box side to get, IE_S_None for any side
+        *@param[out] links - list to which the matching links will be added
+        *@return the number of links which were added
+        */
+        virtual std::size_t GetLinks(TSP_Item::IUID  box,
+                                     IEDirection     direction,
+                                     IESide          side,
+                                     ILinks&         links) const;
+
+        /**
+        * Clears the graph
+        */
+        virtual void Clear();
+
+        /**
+        * Compacts the incidence array, removing the space left by the moved or deleted ranges
+        */
+        virtual void Compact();
+
+    private:
+        /**
+        * Box node, points to its incidence range
+        */
+        struct INode
+        {
+            std::size_t   m_Offset   = 0;
+            std::uint32_t m_Count    = 0;
+            std::uint32_t m_Capacity = 0;
+        };
+
+        /**
+        * Link end
+        */
+        struct IEnd
+        {
+            TSP_Item::IUID m_Box  = 0;
+            IESide         m_Side = IESide::IE_S_None;
+        };
+
+        /**
+        * Link start and end
+        */
+        struct ILinkEnds
+        {
+            IEnd m_Start;
+            IEnd m_End;
+        };
+
+        typedef std::unordered_map<TSP_Item::IUID, INode>     INodes;
+        typedef std::unordered_map<TSP_Item::IUID, ILinkEnds> ILinkEndsMap;
+        typedef std::vector<IIncidence>                       IIncidences;
+
+        TSP_Item*    m_pOwner = nullptr;
+        INodes       m_Nodes;
+        ILinkEndsMap m_LinkEnds;
+        IIncidences  m_Incidences;
+        std::size_t  m_Unused = 0;
+
+        /**
+        * Sets a link end
+        *@param link - link unique identifier
+        *@param box - box unique identifier, 0 to detach only
+        *@param side - box side
+        *@param direction - link direction relatively to the box
+        */
+        void SetLinkEnd(TSP_Item::IUID link, TSP_Item::IUID box, IESide side, IEDirection direction);
+
+        /**
+        * Attaches an incidence to a box
+        *@param box - box unique identifier
+        *@param incidence - incidence to attach
+        */
+        void Attach(TSP_Item::IUID box, const IIncidence& incidence);
+
+        /**
+        * Detaches a link incidence from a box
+        *@param box - box unique identifier
+        *@param link - link unique identifier
+        *@param direction - link direction relatively to the box
+        */
+        void Detach(TSP_Item::IUID box, TSP_Item::IUID link, IEDirection direction);
+};
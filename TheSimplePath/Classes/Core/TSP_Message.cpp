@@ -34,14 +34,18 @@
 //---------------------------------------------------------------------------
 TSP_Message::TSP_Message(TSP_Page* pOwner) :
     TSP_Link(pOwner)
-{}
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Message::TSP_Message(const std::wstring& title,
                          const std::wstring& description,
                          const std::wstring& comments,
                                TSP_Page*     pOwner) :
     TSP_Link(title, description, comments, pOwner)
-{}
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Message::~TSP_Message()
 {}
@@ -42,6 +42,8 @@
 class TSP_Message : public TSP_Link
 {
     public:
+        static const IEType m_ClassType = IEType::IE_T_Message;
+
         /**
         * Constructor
         *@param pOwner - component owner
@@ -29,25 +29,49 @@
 
 #include "TSP_Page.h"
 
+// std
+#include <algorithm>
+
 // core classes
 #include "TSP_Atlas.h"
+#include "TSP_Process.h"
+#include "TSP_Calculator.h"
 
+//---------------------------------------------------------------------------
+// TSP_Page::IContentSource
+//---------------------------------------------------------------------------
+TSP_Page::IContentSource::IContentSource()
+{}
+//---------------------------------------------------------------------------
+TSP_Page::IContentSource::~IContentSource()
+{}
 //---------------------------------------------------------------------------
 // TSP_Page
 //---------------------------------------------------------------------------
 TSP_Page::TSP_Page(TSP_Item* pOwner) :
     TSP_Item(),
-    m_pOwner(pOwner)
-{}
+    m_pOwner(pOwner),
+    m_LinkGraph(this),
+    m_pArena(std::make_shared<TSP_MemoryArena>(16384)),
+    m_pSource(nullptr)
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Page::TSP_Page(const std::wstring& name, TSP_Item* pOwner) :
     TSP_Item(),
     m_Name(name),
-    m_pOwner(pOwner)
-{}
+    m_pOwner(pOwner),
+    m_LinkGraph(this),
+    m_pArena(std::make_shared<TSP_MemoryArena>(16384)),
+    m_pSource(nullptr)
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Page::~TSP_Page()
 {
+    // release the components, the arena is deleted with the last of them
     for each (auto pComponent in m_Components)
         delete pComponent;
 }
@@ -56,8 +80,8 @@ TSP_Box* TSP_Page::CreateAndAddBox(const std::wstring& name,
                                    const std::wstring& description,
                                    const std::wstring& comments)
 {
-    std::unique_ptr<TSP_Box> pBox = std::make_unique<TSP_Box>(name, description, comments, this);
-    m_Components.push_back(pBox.get());
+    std::unique_ptr<TSP_Box> pBox(new (m_pArena) TSP_Box(name, description, comments, this));
+    Insert(pBox.get());
     return pBox.release();
 }
 //---------------------------------------------------------------------------
@@ -65,44 +89,253 @@ TSP_Link* TSP_Page::CreateAndAddLink(const std::wstring& name,
                                      const std::wstring& description,
                                      const std::wstring& comments)
 {
-    std::unique_ptr<TSP_Link> pLink = std::make_unique<TSP_Link>(name, description, comments, this);
-    m_Components.push_back(pLink.get());
+    std::unique_ptr<TSP_Link> pLink(new (m_pArena) TSP_Link(name, description, comments, this));
+    Insert(pLink.get());
     return pLink.release();
 }
 //---------------------------------------------------------------------------
-void TSP_Page::Remove(const std::string& uid)
+TSP_Process* TSP_Page::CreateAndAddProcess(const std::wstring& name,
+                                           const std::wstring& description,
+                                           const std::wstring& comments)
+{
+    std::unique_ptr<TSP_Process> pProcess(new (m_pArena) TSP_Process(name, description, comments, this));
+    Insert(pProcess.get());
+    return pProcess.release();
+}
+//---------------------------------------------------------------------------
+TSP_Activity* TSP_Page::CreateAndAddActivity(const std::wstring& name,
+                                             const std::wstring& description,
+                                             const std::wstring& comments)
+{
+    std::unique_ptr<TSP_Activity> pActivity(new (m_pArena) TSP_Activity(name, description, comments, this));
+    Insert(pActivity.get());
+    return pActivity.release();
+}
+//---------------------------------------------------------------------------
+TSP_Message* TSP_Page::CreateAndAddMessage(const std::wstring& name,
+                                           const std::wstring& description,
+                                           const std::wstring& comments)
+{
+    std::unique_ptr<TSP_Message> pMessage(new (m_pArena) TSP_Message(name, description, comments, this));
+    Insert(pMessage.get());
+    return pMessage.release();
+}
+//---------------------------------------------------------------------------
+void TSP_Page::SetContentSource(IContentSource* pSource, std::uint64_t handle)
+{
+    // lock up the thread
+    std::unique_lock<std::recursive_mutex> lock(m_SourceMutex);
+
+    m_SourceHandle = handle;
+    m_pSource.store(pSource, std::memory_order_release);
+}
+//---------------------------------------------------------------------------
+std::uint64_t TSP_Page::GetContentHandle() const
+{
+    // lock up the thread
+    std::unique_lock<std::recursive_mutex> lock(m_SourceMutex);
+
+    return m_SourceHandle;
+}
+//---------------------------------------------------------------------------
+void TSP_Page::SetContentHandle(std::uint64_t handle)
+{
+    // lock up the thread
+    std::unique_lock<std::recursive_mutex> lock(m_SourceMutex);
+
+    m_SourceHandle = handle;
+}
+//---------------------------------------------------------------------------
+void TSP_Page::SetModified()
+{
+    // already marked, or filled by its content source?
+    if (IsModified() || m_ReadingSource)
+        return;
+
+    TSP_Item::SetModified();
+
+    if (m_pOwner)
+        m_pOwner->SetModified();
+}
+//---------------------------------------------------------------------------
+void TSP_Page::ClearModified()
+{
+    TSP_Item::ClearModified();
+
+    // NOTE the components are accessed directly, a page whose content is still not read contains no
+    // modification
+    for (std::size_t i = 0; i < m_Components.size(); ++i)
+        if (m_Components[i]->IsModified())
+            m_Components[i]->ClearModified();
+}
+//---------------------------------------------------------------------------
+void TSP_Page::Reserve(std::size_t count)
+{
+    ReadContent();
+
+    if (count > m_Components.capacity())
+        m_Components.reserve(count);
+
+    m_Attributes.Reserve(count);
+}
+//---------------------------------------------------------------------------
+void TSP_Page::Remove(IUID uid)
 {
     TSP_Page::Remove(Get(uid));
 }
 //---------------------------------------------------------------------------
 void TSP_Page::Remove(TSP_Component* pComponent)
 {
-    if (!pComponent)
+    ReadContent();
+
+    // is component not owned by this page?
+    if (!Owns(pComponent))
         return;
 
-    for (std::size_t i = 0; i < m_Components.size(); ++i)
-        if (m_Components[i] == pComponent)
-        {
-            delete m_Components[i];
-            m_Components.erase(m_Components.begin() + i);
-            return;
-        }
+    const std::size_t index = pComponent->GetContainerIndex();
+
+    // move the last component to the removed one place, the attribute rows follow the same way
+    if (index != m_Components.size() - 1)
+    {
+        m_Components[index] = m_Components.back();
+        m_Components[index]->SetContainerIndex(index);
+    }
+
+    m_Components.pop_back();
+    m_Attributes.RemoveRow(index);
+
+    IComponents&      bucket      = m_Buckets[(std::size_t)pComponent->GetType()];
+    const std::size_t bucketIndex = pComponent->GetBucketIndex();
+
+    // remove the component from its type bucket, in the same way
+    if (bucketIndex != bucket.size() - 1)
+    {
+        bucket[bucketIndex] = bucket.back();
+        bucket[bucketIndex]->SetBucketIndex(bucketIndex);
+    }
+
+    bucket.pop_back();
+
+    // detach the component from the link graph
+    if (pComponent->IsKindOf(IEType::IE_T_Link))
+        m_LinkGraph.RemoveLink(pComponent->GetUID());
+    else
+    if (pComponent->IsKindOf(IEType::IE_T_Box))
+        m_LinkGraph.RemoveBox(pComponent->GetUID());
+
+    delete pComponent;
+
+    SetModified();
+
+    // the aggregates of the container no longer contain the component values
+    TSP_Calculator::NotifyContainerChanged(m_pOwner);
 }
 //---------------------------------------------------------------------------
-TSP_Component* TSP_Page::Get(const std::string& uid) const
+TSP_Component* TSP_Page::Get(IUID uid) const
 {
-    for each (auto pComponent in m_Components)
-        if (pComponent->GetUID() == uid)
-            return pComponent;
+    ReadContent();
+
+    // search for the item matching with the uid
+    TSP_Item* pItem = TSP_Item::Find(uid);
+
+    // found it?
+    if (!pItem)
+        return nullptr;
 
-    return nullptr;
+    const std::size_t index = pItem->GetContainerIndex();
+
+    // is item a component of this page?
+    if (index >= m_Components.size() || m_Components[index] != pItem)
+        return nullptr;
+
+    return m_Components[index];
+}
+//---------------------------------------------------------------------------
+TSP_Component* TSP_Page::GetAt(std::size_t index) const
+{
+    ReadContent();
+
+    if (index >= m_Components.size())
+        return nullptr;
+
+    return m_Components[index];
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_Page::GetCountOf(IEType type) const
+{
+    ReadContent();
+
+    if (type >= IEType::IE_T_Count)
+        return 0;
+
+    return m_Buckets[(std::size_t)type].size();
+}
+//---------------------------------------------------------------------------
+TSP_Component* TSP_Page::GetOf(IEType type, std::size_t index) const
+{
+    ReadContent();
+
+    if (type >= IEType::IE_T_Count)
+        return nullptr;
+
+    const IComponents& bucket = m_Buckets[(std::size_t)type];
+
+    if (index >= bucket.size())
+        return nullptr;
+
+    return bucket[index];
 }
 //---------------------------------------------------------------------------
 std::size_t TSP_Page::GetCount() const
 {
+    ReadContent();
     return m_Components.size();
 }
 //---------------------------------------------------------------------------
+bool TSP_Page::Owns(const TSP_Component* pComponent) const
+{
+    ReadContent();
+
+    if (!pComponent)
+        return false;
+
+    const std::size_t index = pComponent->GetContainerIndex();
+
+    return (index < m_Components.size() && m_Components[index] == pComponent);
+}
+//---------------------------------------------------------------------------
+bool TSP_Page::Save(TSP_JsonHelper::IBufferWriterW& writer) const
+{
+    if (!ReadContent())
+        return false;
+
+    if (!writer.StartObject())
+        return false;
+
+    if (!writer.Key(L"uid") || !writer.Uint64(GetUID()))
+        return false;
+
+    if (!TSP_JsonHelper::WriteMember(writer, L"name", m_Name))
+        return false;
+
+    // the component count allows the loader to reserve the page memory in one go
+    if (!writer.Key(L"count") || !writer.Uint64(m_Components.size()))
+        return false;
+
+    if (!writer.Key(L"components") || !writer.StartArray())
+        return false;
+
+    // write the components in their container order, which is also their attribute row order
+    for (std::size_t i = 0; i < m_Components.size(); ++i)
+        if (!m_Components[i]->Save(writer))
+            return false;
+
+    if (!writer.EndArray())
+        return false;
+
+    return writer.EndObject();
+}
+//---------------------------------------------------------------------------
 bool TSP_Page::Add(TSP_Component* pComponent)
 {
     // no component?
@@ -110,13 +343,63 @@ bool TSP_Page::Add(TSP_Component* pComponent)
         return false;
 
     // check if component was already added in component list
-    for each (auto pComp in m_Components)
-        if (pComponent == pComp)
-            return false;
+    if (Owns(pComponent))
+        return false;
 
     // add the component to component list
-    m_Components.push_back(pComponent);
+    Insert(pComponent);
 
     return true;
 }
 //---------------------------------------------------------------------------
+void TSP_Page::Insert(TSP_Component* pComponent)
+{
+    // the new components are added after the content still not read
+    ReadContent();
+
+    IComponents& bucket = m_Buckets[(std::size_t)pComponent->GetType()];
+
+    // reserve space first, so the component cannot be half added if the memory is exhausted. NOTE
+    // the capacity is grown geometrically, otherwise each insertion would reallocate the whole list
+    if (m_Components.size() == m_Components.capacity())
+        m_Components.reserve(std::max<std::size_t>(m_Components.size() * 2, 16));
+
+    if (bucket.size() == bucket.capacity())
+        bucket.reserve(std::max<std::size_t>(bucket.size() * 2, 16));
+
+    // add the component attribute row, which should match with its container index
+    m_Attributes.AddRow();
+
+    pComponent->SetContainerIndex(m_Components.size());
+    m_Components.push_back(pComponent);
+
+    pComponent->SetBucketIndex(bucket.size());
+    bucket.push_back(pComponent);
+
+    SetModified();
+}
+//---------------------------------------------------------------------------
+bool TSP_Page::ReadSourceContent() const
+{
+    // lock up the thread
+    std::unique_lock<std::recursive_mutex> lock(m_SourceMutex);
+
+    IContentSource* pSource = m_pSource.load(std::memory_order_relaxed);
+
+    // already read by another thread, or the page is accessed by its source while it is read?
+    if (!pSource || m_ReadingSource)
+        return true;
+
+    m_ReadingSource = true;
+
+    // the source fills the page through its usual functions
+    const bool success = pSource->ReadContent(const_cast<TSP_Page*>(this), m_SourceHandle);
+
+    m_ReadingSource = false;
+
+    // the content is read once, even if it failed, the page keeps what could be read
+    m_pSource.store(nullptr, std::memory_order_release);
+
+    return success;
+}
+//---------------------------------------------------------------------------
@@ -30,12 +30,22 @@
 #pragma once
 
 // std
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
 // core classes
 #include "TSP_Item.h"
 #include "TSP_Box.h"
+#include "TSP_Activity.h"
 #include "TSP_Link.h"
+#include "TSP_Message.h"
+#include "TSP_LinkGraph.h"
+#include "TSP_AttributeStore.h"
+
+// class prototypes
+class TSP_Process;
 
 /**
 * Document page
@@ -44,6 +54,26 @@
 class TSP_Page : public TSP_Item
 {
     public:
+        static const IEType m_ClassType = IEType::IE_T_Page;
+
+        /**
+        * Source from which the page content is read, the first time the page is accessed
+        */
+        class IContentSource
+        {
+            public:
+                IContentSource();
+                virtual ~IContentSource();
+
+                /**
+                * Reads the page content
+                *@param pPage - page to fill, still empty
+                *@param handle - content handle, as set with the source
+                *@return true on success, otherwise false
+                */
+                virtual bool ReadContent(TSP_Page* pPage, std::uint64_t handle) = 0;
+        };
+
         /**
         * Constructor
         *@param pOwner - the page owner
@@ -99,11 +129,100 @@ class TSP_Page : public TSP_Item
                                            const std::wstring& description,
                                            const std::wstring& comments);
 
+        /**
+        * Creates a process and adds it in page
+        *@param name - process name
+        *@param description - process description
+        *@param comments - process comments
+        *@return newly created process
+        */
+        virtual TSP_Process* CreateAndAddProcess(const std::wstring& name,
+                                                 const std::wstring& description,
+                                                 const std::wstring& comments);
+
+        /**
+        * Creates an activity and adds it in page
+        *@param name - activity name
+        *@param description - activity description
+        *@param comments - activity comments
+        *@return newly created activity
+        */
+        virtual TSP_Activity* CreateAndAddActivity(const std::wstring& name,
+                                                   const std::wstring& description,
+                                                   const std::wstring& comments);
+
+        /**
+        * Creates a message and adds it in page
+        *@param name - message name
+        *@param description - message description
+        *@param comments - message comments
+        *@return newly created message
+        */
+        virtual TSP_Message* CreateAndAddMessage(const std::wstring& name,
+                                                 const std::wstring& description,
+                                                 const std::wstring& comments);
+
+        /**
+        * Reserves memory for a given component count
+        *@param count - component count to reserve for
+        *@note Allows to add many components, e.g. while a document is loaded, without growing the
+        *      component list and the attribute columns several times
+        */
+        virtual void Reserve(std::size_t count);
+
+        /**
+        * Sets the source from which the page content will be read, the first time the page is accessed
+        *@param pSource - content source, should remain alive until the content is read or the page is deleted
+        *@param handle - content handle, passed back to the source
+        *@note Allows to open a large document without reading all its pages. The page should be empty
+        */
+        virtual void SetContentSource(IContentSource* pSource, std::uint64_t handle);
+
+        /**
+        * Reads the page content from its source, if still not done
+        *@return true on success or if the page has no pending content, otherwise false
+        *@note The page functions accessing the content call it, so it should only be called explicitly to
+        *      read the content in advance
+        */
+        inline bool ReadContent() const;
+
+        /**
+        * Checks if the page content is currently read from its source
+        *@return true if the page content is read, otherwise false
+        */
+        virtual inline bool IsReadingContent() const;
+
+        /**
+        * Gets the content handle
+        *@return the content handle, 0 if the page content has no known location
+        *@note The handle remains known once the content was read, it locates the page content in the
+        *      file the page was read from or last written to, so an unmodified page may be referenced
+        *      there instead of being written again
+        */
+        virtual std::uint64_t GetContentHandle() const;
+
+        /**
+        * Sets the content handle, after the page content was written
+        *@param handle - content handle, 0 if the page content has no known location
+        */
+        virtual void SetContentHandle(std::uint64_t handle);
+
+        /**
+        * Marks the page, and its owner, as modified
+        *@note The page isn't marked while its content is read from its source
+        */
+        virtual void SetModified();
+
+        /**
+        * Marks the page, and its modified components, as unmodified
+        */
+        virtual void ClearModified();
+
         /**
         * Removes a component
         *@param uid - component unique identifier to remove
         */
-        virtual void Remove(const std::string& uid);
+        virtual void Remove(IUID uid);
 
         /**
         * Removes a component
@@ -116,21 +235,73 @@ class TSP_Page : public TSP_Item
         *@param uid - component unique identifier to get
         *@return component, nullptr if not found or on error
         */
-        virtual TSP_Component* Get(const std::string& uid) const;
+        virtual TSP_Component* Get(IUID uid) const;
+
+        /**
+        * Gets a component from its container index
+        *@param index - component index, between 0 and GetCount() - 1
+        *@return component, nullptr if not found or on error
+        *@note The container index of a component is also its attribute row
+        */
+        virtual TSP_Component* GetAt(std::size_t index) const;
 
         /**
-        * Gets count of type
+        * Gets count of type, including the types derived from it
         *@return count of type
         */
         template <class T>
         std::size_t GetCountOf() const;
 
+        /**
+        * Gets count of an exact type
+        *@param type - component type to count
+        *@return count of type
+        */
+        virtual std::size_t GetCountOf(IEType type) const;
+
+        /**
+        * Gets a component of an exact type
+        *@param type - component type to get
+        *@param index - component index, between 0 and GetCountOf(type) - 1
+        *@return component, nullptr if not found or on error
+        */
+        virtual TSP_Component* GetOf(IEType type, std::size_t index) const;
+
         /**
         * Gets component count
         *@return component count
         */
         virtual std::size_t GetCount() const;
 
+        /**
+        * Checks if a component belongs to the page
+        *@param pComponent - component to check
+        *@return true if the component belongs to the page, otherwise false
+        */
+        virtual bool Owns(const TSP_Component* pComponent) const;
+
+        /**
+        * Gets the graph indexing the links attached to the page boxes
+        *@return the link graph
+        */
+        virtual inline TSP_LinkGraph* GetLinkGraph();
+        virtual inline const TSP_LinkGraph* GetLinkGraph() const;
+
+        /**
+        * Gets the column-wise store containing the attributes of the page components
+        *@return the attribute store
+        *@note The row of a component is its container index
+        */
+        virtual inline TSP_AttributeStore* GetAttributes();
+        virtual inline const TSP_AttributeStore* GetAttributes() const;
+
+        /**
+        * Saves the page and its components
+        *@param writer - json writer to save to
+        *@return true on success, otherwise false
+        */
+        virtual bool Save(TSP_JsonHelper::IBufferWriterW& writer) const;
+
     protected:
         /**
         * Adds a component in page
@@ -140,12 +311,40 @@ class TSP_Page : public TSP_Item
         */
         virtual bool Add(TSP_Component* pComponent);
 
+        /**
+        * Gets the arena in which the page components should be allocated
+        *@return the page arena
+        *@note The arena memory is released in one go when the page and all the components allocated
+        *      inside it are deleted
+        */
+        virtual inline const std::shared_ptr<TSP_MemoryArena>& GetArena() const;
+
     private:
         typedef std::vector<TSP_Component*> IComponents;
 
-        TSP_Item*    m_pOwner = nullptr;
-        IComponents  m_Components;
-        std::wstring m_Name;
+        /**
+        * Adds a component in the page component list and in its type bucket
+        *@param pComponent - component to add
+        */
+        void Insert(TSP_Component* pComponent);
+
+        /**
+        * Reads the page content from its source, the first time the page is accessed
+        *@return true on success or if the content was already read, otherwise false
+        */
+        bool ReadSourceContent() const;
+
+        TSP_Item*                            m_pOwner        = nullptr;
+        IComponents                          m_Components;
+        IComponents                          m_Buckets[(std::size_t)IEType::IE_T_Count];
+        TSP_LinkGraph                        m_LinkGraph;
+        TSP_AttributeStore                   m_Attributes;
+        std::shared_ptr<TSP_MemoryArena>     m_pArena;
+        std::wstring                         m_Name;
+        mutable std::atomic<IContentSource*> m_pSource;
+        std::uint64_t                        m_SourceHandle  = 0;
+        mutable std::recursive_mutex         m_SourceMutex;
+        mutable bool                         m_ReadingSource = false;
 };
 
 //---------------------------------------------------------------------------
@@ -164,16 +363,63 @@ std::wstring TSP_Page::GetName() const
 void TSP_Page::SetName(const std::wstring& name)
 {
     m_Name = name;
+    SetModified();
+}
+//---------------------------------------------------------------------------
+bool TSP_Page::ReadContent() const
+{
+    // the content was already read? (this is the common case, so no lock is required)
+    if (!m_pSource.load(std::memory_order_acquire))
+        return true;
+
+    return ReadSourceContent();
+}
+//---------------------------------------------------------------------------
+bool TSP_Page::IsReadingContent() const
+{
+    return m_ReadingSource;
+}
+//---------------------------------------------------------------------------
+TSP_LinkGraph* TSP_Page::GetLinkGraph()
+{
+    ReadContent();
+    return &m_LinkGraph;
+}
+//---------------------------------------------------------------------------
+const TSP_LinkGraph* TSP_Page::GetLinkGraph() const
+{
+    ReadContent();
+    return &m_LinkGraph;
+}
+//---------------------------------------------------------------------------
+TSP_AttributeStore* TSP_Page::GetAttributes()
+{
+    ReadContent();
+    return &m_Attributes;
+}
+//---------------------------------------------------------------------------
+const TSP_AttributeStore* TSP_Page::GetAttributes() const
+{
+    ReadContent();
+    return &m_Attributes;
+}
+//---------------------------------------------------------------------------
+const std::shared_ptr<TSP_MemoryArena>& TSP_Page::GetArena() const
+{
+    return m_pArena;
 }
 //---------------------------------------------------------------------------
 template <class T>
 std::size_t TSP_Page::GetCountOf() const
 {
+    ReadContent();
+
     std::size_t count = 0;
 
-    for each (auto pComponent in m_Components)
-        if (dynamic_cast<T*>(pComponent))
-            ++count;
+    // sum the buckets of all the types derived from the requested one
+    for (std::size_t i = 0; i < (std::size_t)IEType::IE_T_Count; ++i)
+        if (IsKindOf((IEType)i, T::m_ClassType))
+            count += m_Buckets[i].size();
 
     return count;
 }
@@ -34,11 +34,14 @@
 
 // core classes
 #include "TSP_Document.h"
+#include "TSP_Process.h"
+#include "TSP_Calculator.h"
 
 //---------------------------------------------------------------------------
 // TSP_PageContainer
 //---------------------------------------------------------------------------
-TSP_PageContainer::TSP_PageContainer()
+TSP_PageContainer::TSP_PageContainer() :
+    m_pPageArena(std::make_shared<TSP_MemoryArena>(8192))
 {}
 //---------------------------------------------------------------------------
 TSP_PageContainer::~TSP_PageContainer()
@@ -50,14 +53,14 @@ TSP_PageContainer::~TSP_PageContainer()
 TSP_Page* TSP_PageContainer::CreateAndAddPage()
 {
     std::unique_ptr<TSP_Page> pPage(CreatePage());
-    m_Pages.push_back(pPage.get());
+    AddPage(pPage.get());
     return pPage.release();
 }
 //---------------------------------------------------------------------------
 TSP_Page* TSP_PageContainer::CreateAndAddPage(const std::wstring& name)
 {
     std::unique_ptr<TSP_Page> pPage(CreatePage(name));
-    m_Pages.push_back(pPage.get());
+    AddPage(pPage.get());
     return pPage.release();
 }
 //---------------------------------------------------------------------------
@@ -67,22 +70,35 @@ void TSP_PageContainer::RemovePage(std::size_t index)
     if (index >= m_Pages.size())
         return;
 
+    TSP_Item* pOwner = m_Pages[index]->GetOwner();
+
     // delete the page
     delete m_Pages[index];
     m_Pages.erase(m_Pages.begin() + index);
+
+    if (pOwner)
+        pOwner->SetModified();
+
+    // the aggregates of the container no longer contain the page values
+    TSP_Calculator::NotifyContainerChanged(pOwner);
+
+    // the page order is shown to the user, so the next pages are shifted instead of swapped
+    for (std::size_t i = index; i < m_Pages.size(); ++i)
+        m_Pages[i]->SetContainerIndex(i);
 }
 //---------------------------------------------------------------------------
 void TSP_PageContainer::RemovePage(TSP_Page* pPage)
 {
-    // search for page to remove
-    for (std::size_t i = 0; i < m_Pages.size(); ++i)
-        // found it?
-        if (m_Pages[i] == pPage)
-        {
-            // remove the page and exit
-            RemovePage(i);
-            return;
-        }
+    if (!pPage)
+        return;
+
+    const std::size_t index = pPage->GetContainerIndex();
+
+    // is page owned by this container?
+    if (index >= m_Pages.size() || m_Pages[index] != pPage)
+        return;
+
+    RemovePage(index);
 }
 //---------------------------------------------------------------------------
 TSP_Page* TSP_PageContainer::GetPage(std::size_t index) const
@@ -93,13 +109,22 @@ TSP_Page* TSP_PageContainer::GetPage(std::size_t index) const
     return m_Pages[index];
 }
 //---------------------------------------------------------------------------
-TSP_Page* TSP_PageContainer::GetPage(const std::string& uid) const
+TSP_Page* TSP_PageContainer::GetPageByUID(TSP_Item::IUID uid) const
 {
-    for each (auto pPage in m_Pages)
-        if (pPage->GetUID() == uid)
-            return pPage;
+    // search for the item matching with the uid
+    TSP_Item* pItem = TSP_Item::Find(uid);
+
+    // found it?
+    if (!pItem)
+        return nullptr;
+
+    const std::size_t index = pItem->GetContainerIndex();
 
-    return nullptr;
+    // is item a page of this container?
+    if (index >= m_Pages.size() || m_Pages[index] != pItem)
+        return nullptr;
+
+    return m_Pages[index];
 }
 //---------------------------------------------------------------------------
 std::size_t TSP_PageContainer::GetPageCount() const
@@ -107,29 +132,64 @@ std::size_t TSP_PageContainer::GetPageCount() const
     return m_Pages.size();
 }
 //---------------------------------------------------------------------------
-bool TSP_PageContainer::Load()
+void TSP_PageContainer::GetAllPages(TSP_AttributeQuery::IPages& pages) const
+{
+    for (std::size_t i = 0; i < m_Pages.size(); ++i)
+    {
+        const TSP_Page* pPage = m_Pages[i];
+
+        pages.push_back(pPage);
+
+        const std::size_t processCount = pPage->GetCountOf(TSP_Item::IEType::IE_T_Process);
+
+        // add the pages of the processes the page contains
+        for (std::size_t j = 0; j < processCount; ++j)
+            static_cast<TSP_Process*>(pPage->GetOf(TSP_Item::IEType::IE_T_Process, j))->GetAllPages(pages);
+    }
+}
+//---------------------------------------------------------------------------
+TSP_AttributeStore::IAggregate TSP_PageContainer::Aggregate(TSP_Attribute::IEKey key) const
+{
+    TSP_AttributeQuery::IPages pages;
+    GetAllPages(pages);
+
+    return TSP_AttributeQuery::Aggregate(pages, key);
+}
+//---------------------------------------------------------------------------
+TSP_AttributeStore::IAggregate TSP_PageContainer::Aggregate(TSP_Attribute::IEKey key, double low, double high) const
 {
-    //m_NbrGen;
-    //m_Name
+    TSP_AttributeQuery::IPages pages;
+    GetAllPages(pages);
 
-    /*
-    for each (auto pModel in m_Models)
-        pModel->Load();
-    */
+    return TSP_AttributeQuery::Aggregate(pages, key, low, high);
+}
+//---------------------------------------------------------------------------
+void TSP_PageContainer::AddPage(TSP_Page* pPage)
+{
+    pPage->SetContainerIndex(m_Pages.size());
+    m_Pages.push_back(pPage);
 
-    return true;
+    // the container is modified, but not the page, which may still be filled by its content source
+    if (pPage->GetOwner())
+        pPage->GetOwner()->SetModified();
 }
 //---------------------------------------------------------------------------
-bool TSP_PageContainer::Save() const
+void TSP_PageContainer::ClearModifiedPages()
 {
-    //m_NbrGen;
-    //m_Name
+    for (std::size_t i = 0; i < m_Pages.size(); ++i)
+        if (m_Pages[i]->IsModified())
+            m_Pages[i]->ClearModified();
+}
+//---------------------------------------------------------------------------
+bool TSP_PageContainer::SavePages(TSP_JsonHelper::IBufferWriterW& writer) const
+{
+    if (!writer.StartArray())
+        return false;
 
-    /*
-    for each (auto pModel in m_Models)
-        pModel->Save();
-    */
+    for (std::size_t i = 0; i < m_Pages.size(); ++i)
+        if (!m_Pages[i]->Save(writer))
+            return false;
 
-    return true;
+    return writer.EndArray();
 }
 //---------------------------------------------------------------------------
@@ -30,11 +30,13 @@
 #pragma once
 
  // std
+#include <memory>
 #include <string>
 #include <vector>
 
 // core class
 #include "TSP_Page.h"
+#include "TSP_AttributeQuery.h"
 
 /**
 * Container which may contain pages
@@ -96,7 +98,7 @@ class TSP_PageContainer
         *@param uid - page unique identifier to get
         *@return page, nullptr if not found or on error
         */
-        virtual TSP_Page* GetPage(const std::string& uid) const;
+        virtual TSP_Page* GetPageByUID(TSP_Item::IUID uid) const;
 
         /**
         * Gets page count
@@ -105,20 +107,51 @@ class TSP_PageContainer
         virtual std::size_t GetPageCount() const;
 
         /**
-        * Loads a model from a file
-        *@return true on success, otherwise false
+        * Gets the container pages, and recursively the pages of the sub-processes they contain
+        *@param[in, out] pages - page list in which the pages are added
+        */
+        virtual void GetAllPages(TSP_AttributeQuery::IPages& pages) const;
+
+        /**
+        * Aggregates the values of an attribute over the container pages and their sub-process pages
+        *@param key - attribute key
+        *@return the count of values, and for the numeric formats their sum, minimum and maximum
+        */
+        virtual TSP_AttributeStore::IAggregate Aggregate(TSP_Attribute::IEKey key) const;
+
+        /**
+        * Aggregates the values of an attribute contained in a range over the container pages and their
+        * sub-process pages
+        *@param key - attribute key
+        *@param low - lowest value to aggregate
+        *@param high - highest value to aggregate
+        *@return the count, sum, minimum and maximum of the values contained in the range
         */
-        virtual bool Load();
+        virtual TSP_AttributeStore::IAggregate Aggregate(TSP_Attribute::IEKey key, double low, double high) const;
 
         /**
-        * Saves a model to a file
+        * Saves the container pages, as an array
+        *@param writer - json writer to save to
         *@return true on success, otherwise false
         */
-        virtual bool Save() const;
+        virtual bool SavePages(TSP_JsonHelper::IBufferWriterW& writer) const;
 
     protected:
         typedef std::vector<TSP_Page*> IPages;
 
-        IPages      m_Pages;
-        std::size_t m_NewPageNbGen =  0;
+        IPages                           m_Pages;
+        std::shared_ptr<TSP_MemoryArena> m_pPageArena;
+        std::size_t                      m_NewPageNbGen =  0;
+
+        /**
+        * Adds a page at the end of the page list
+        *@param pPage - page to add
+        *@note The container owner is marked as modified, the page itself isn't
+        */
+        void AddPage(TSP_Page* pPage);
+
+        /**
+        * Marks the modified pages as unmodified
+        */
+        void ClearModifiedPages();
 };
@@ -35,7 +35,9 @@
 TSP_Process::TSP_Process(TSP_Page* pOwner) :
     TSP_Box(pOwner),
     TSP_PageContainer()
-{}
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Process::TSP_Process(const std::wstring& title,
                          const std::wstring& description,
@@ -43,18 +45,34 @@ TSP_Process::TSP_Process(const std::wstring& title,
                                TSP_Page*     pOwner) :
     TSP_Box(title, description, comments, pOwner),
     TSP_PageContainer()
-{}
+{
+    SetType(m_ClassType);
+}
 //---------------------------------------------------------------------------
 TSP_Process::~TSP_Process()
 {}
 //---------------------------------------------------------------------------
 TSP_Page* TSP_Process::CreatePage()
 {
-    return new TSP_Page(this);
+    return new (m_pPageArena) TSP_Page(this);
 }
 //---------------------------------------------------------------------------
 TSP_Page* TSP_Process::CreatePage(const std::wstring& name)
 {
-    return new TSP_Page(name, this);
+    return new (m_pPageArena) TSP_Page(name, this);
+}
+//---------------------------------------------------------------------------
+void TSP_Process::ClearModified()
+{
+    TSP_Box::ClearModified();
+    ClearModifiedPages();
+}
+//---------------------------------------------------------------------------
+bool TSP_Process::SaveMembers(TSP_JsonHelper::IBufferWriterW& writer) const
+{
+    if (!TSP_Box::SaveMembers(writer))
+        return false;
+
+    return (writer.Key(L"pages") && SavePages(writer));
 }
 //---------------------------------------------------------------------------
@@ -43,6 +43,8 @@ class TSP_Process : public TSP_Box,
                     public TSP_PageContainer
 {
     public:
+        static const IEType m_ClassType = IEType::IE_T_Process;
+
         /**
         * Constructor
         *@param pOwner - the page owner
@@ -75,4 +77,17 @@ class TSP_Process : public TSP_Box,
         *@return newly created page
         */
         virtual TSP_Page* CreatePage(const std::wstring& name);
+
+        /**
+        * Marks the process, and its modified pages, as unmodified
+        */
+        virtual void ClearModified();
+
+    protected:
+        /**
+        * Saves the process members, without the object enclosing them
+        *@param writer - json writer to save to
+        *@return true on success, otherwise false
+        */
+        virtual bool SaveMembers(TSP_JsonHelper::IBufferWriterW& writer) const;
 };
@@ -0,0 +1,365 @@
+/****************************************************************************
+ * ==> TSP_RevisionStore ---------------------------------------------------*
+ ****************************************************************************
+ * Description:  Stores the document revisions                              *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#include "TSP_RevisionStore.h"
+
+// std
+#include <cstring>
+#include <ctime>
+
+// common classes
+#include "Common/TSP_StringHelper.h"
+#include "Common/TSP_FileHelper.h"
+#include "Common/TSP_NumberHelper.h"
+#include "Common/TSP_ChunkedBuffer.h"
+#include "Common/TSP_MappedFileBuffer.h"
+#include "Common/TSP_Logger.h"
+
+// core classes
+#include "TSP_Document.h"
+#include "TSP_BinaryDocumentWriter.h"
+#include "TSP_DocumentSaver.h"
+
+//---------------------------------------------------------------------------
+// TSP_RevisionStore
+//---------------------------------------------------------------------------
+TSP_RevisionStore::TSP_RevisionStore()
+{}
+//---------------------------------------------------------------------------
+TSP_RevisionStore::~TSP_RevisionStore()
+{}
+//---------------------------------------------------------------------------
+bool TSP_RevisionStore::Open(const std::wstring& dirName)
+{
+    Close();
+
+    if (dirName.empty())
+        return false;
+
+    const std::wstring pageDirName = GetPageDirName(dirName);
+
+    if (!TSP_FileHelper::CreateDir(dirName) || !TSP_FileHelper::CreateDir(pageDirName))
+    {
+        M_LogCatErrorT(IO, L"Revision store - could not create the directory - " << dirName);
+        return false;
+    }
+
+    TSP_FileHelper::IFileNamesW fileNames;
+
+    // get the already stored pages, their file name is their content hash
+    if (!TSP_FileHelper::GetDirContent(pageDirName, fileNames, false))
+        return false;
+
+    for (std::size_t i = 0; i < fileNames.size(); ++i)
+    {
+        TSP_HashHelper::IHash128 hash;
+
+        if (TSP_FileHelper::GetFileExtension(fileNames[i]) == L"tspb" &&
+            TSP_HashHelper::FromStr(TSP_FileHelper::GetStrippedFileName(fileNames[i]), hash))
+            m_PageNames.insert(TSP_HashHelper::ToStr(hash));
+    }
+
+    fileNames.clear();
+
+    // get the last revision number
+    if (!TSP_FileHelper::GetDirContent(dirName, fileNames, false))
+        return false;
+
+    for (std::size_t i = 0; i < fileNames.size(); ++i)
+    {
+        if (TSP_FileHelper::GetFileExtension(fileNames[i]) != L"tspr")
+            continue;
+
+        const std::size_t revision = TSP_NumberHelper::StrToNum(TSP_FileHelper::GetStrippedFileName(fileNames[i]), std::size_t(0));
+
+        if (revision > m_RevisionCount)
+            m_RevisionCount = revision;
+    }
+
+    m_DirName = dirName;
+
+    M_LogFmtT(IO, Info, "Revision store - opened - {} - {} revisions, {} pages", dirName, m_RevisionCount, m_PageNames.size());
+
+    return true;
+}
+//---------------------------------------------------------------------------
+void TSP_RevisionStore::Close()
+{
+    m_DirName.clear();
+    m_PageNames.clear();
+    m_RevisionCount = 0;
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_RevisionStore::GetRevisionFileName(std::size_t revision) const
+{
+    return TSP_FileHelper::AppendDelimiter(m_DirName) + std::to_wstring(revision) + L".tspr";
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_RevisionStore::AddRevision(const TSP_Document* pDocument)
+{
+    if (!IsOpened() || !pDocument)
+        return 0;
+
+    // the pages still not read would be written empty
+    if (!pDocument->ReadAllPages())
+    {
+        M_LogCatErrorT(IO, L"Revision store - some pages could not be read");
+        return 0;
+    }
+
+    TSP_ChunkedBuffer revision;
+
+    bool success = WriteValue(&revision, m_Magic)                           &&
+                   WriteValue(&revision, m_Version)                         &&
+                   WriteValue(&revision, std::int64_t(std::time(nullptr))) &&
+                   WriteString(&revision, pDocument->GetTitle())            &&
+                   WriteValue(&revision, std::uint32_t(pDocument->GetAtlasCount()));
+
+    std::size_t writtenCount = 0;
+    std::size_t pageCount    = 0;
+
+    for (std::size_t i = 0; success && i < pDocument->GetAtlasCount(); ++i)
+    {
+        const TSP_Atlas* pAtlas = pDocument->GetAtlas(i);
+
+        success = WriteString(&revision, pAtlas->GetName()) &&
+                  WriteValue(&revision, std::uint32_t(pAtlas->GetPageCount()));
+
+        for (std::size_t j = 0; success && j < pAtlas->GetPageCount(); ++j)
+        {
+            // write the page alone, so its content is identical in all the revisions it didn't change in
+            TSP_ChunkedBuffer        page;
+            TSP_BinaryDocumentWriter writer(&page);
+
+            if (!writer.Write(pAtlas->GetPage(j)))
+            {
+                M_LogCatErrorT(IO, L"Revision store - failed to write a page - " << pAtlas->GetPage(j)->GetName());
+                return 0;
+            }
+
+            const TSP_HashHelper::IHash128 hash     = TSP_HashHelper::Hash128(page.GetData(), page.GetSize());
+            const std::wstring             pageName = TSP_HashHelper::ToStr(hash);
+
+            // page content still not stored?
+            if (m_PageNames.find(pageName) == m_PageNames.end())
+            {
+                if (!TSP_DocumentSaver::WriteFile(page, GetPageFileName(m_DirName, hash)))
+                {
+                    M_LogCatErrorT(IO, L"Revision store - failed to write the page file - " << pageName);
+                    return 0;
+                }
+
+                m_PageNames.insert(pageName);
+                ++writtenCount;
+            }
+
+            success = WriteValue(&revision, hash.m_Low) && WriteValue(&revision, hash.m_High);
+            ++pageCount;
+        }
+    }
+
+    if (!success)
+    {
+        M_LogCatErrorT(IO, L"Revision store - failed to write the revision");
+        return 0;
+    }
+
+    // the revision ends with its own hash, to detect if it was damaged
+    const TSP_HashHelper::IHash128 checksum = TSP_HashHelper::Hash128(revision.GetData(), revision.GetSize());
+
+    if (!WriteValue(&revision, checksum.m_Low) || !WriteValue(&revision, checksum.m_High))
+        return 0;
+
+    const std::size_t  number   = m_RevisionCount + 1;
+    const std::wstring fileName = GetRevisionFileName(number);
+
+    if (!TSP_DocumentSaver::WriteFile(revision, fileName))
+    {
+        M_LogCatErrorT(IO, L"Revision store - failed to write the revision file - " << fileName);
+        return 0;
+    }
+
+    m_RevisionCount = number;
+
+    M_LogFmtT(IO, Info, "Revision store - revision added - {} - {} of {} pages written", number, writtenCount, pageCount);
+
+    return number;
+}
+//---------------------------------------------------------------------------
+bool TSP_RevisionStore::LoadRevision(std::size_t revision, TSP_Document* pDocument) const
+{
+    if (!IsOpened() || !pDocument || !revision || revision > m_RevisionCount)
+        return false;
+
+    return pDocument->Load(GetRevisionFileName(revision));
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_RevisionStore::GetDefaultDirName(const std::wstring& documentFileName)
+{
+    return documentFileName + L".revisions";
+}
+//---------------------------------------------------------------------------
+bool TSP_RevisionStore::IsRevision(const void* pData, std::size_t size)
+{
+    if (!pData || size < sizeof(std::uint32_t))
+        return false;
+
+    std::uint32_t magic;
+    std::memcpy(&magic, pData, sizeof(std::uint32_t));
+
+    return (magic == m_Magic);
+}
+//---------------------------------------------------------------------------
+bool TSP_RevisionStore::Read(const std::wstring& fileName, TSP_Document* pDocument)
+{
+    if (!pDocument)
+        return false;
+
+    TSP_MappedFileBuffer file;
+
+    if (!file.Open(fileName, TSP_FileBuffer::IEMode::IE_M_Read))
+        return false;
+
+    const char*       pData = static_cast<const char*>(file.GetData());
+    const std::size_t size  = file.GetSize();
+
+    if (!IsRevision(pData, size) || size < sizeof(TSP_HashHelper::IHash128))
+        return false;
+
+    const std::size_t              contentSize = size - sizeof(TSP_HashHelper::IHash128);
+    const TSP_HashHelper::IHash128 checksum    = TSP_HashHelper::Hash128(pData, contentSize);
+          TSP_HashHelper::IHash128 expected;
+
+    std::memcpy(&expected.m_Low,  pData + contentSize,                         sizeof(std::uint64_t));
+    std::memcpy(&expected.m_High, pData + contentSize + sizeof(std::uint64_t), sizeof(std::uint64_t));
+
+    // damaged revision?
+    if (checksum != expected)
+    {
+        M_LogCatErrorT(IO, L"Revision store - damaged revision - " << fileName);
+        return false;
+    }
+
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::int64_t  time;
+    std::wstring  title;
+    std::uint32_t atlasCount;
+
+    if (!ReadValue(&file, magic) || !ReadValue(&file, version) || version != m_Version)
+    {
+        M_LogCatErrorT(IO, L"Revision store - unsupported revision version - " << fileName);
+        return false;
+    }
+
+    if (!ReadValue(&file, time) || !ReadString(&file, title) || !ReadValue(&file, atlasCount))
+        return false;
+
+    pDocument->SetTitle(title);
+
+    // the pages are stored in the same store as the revision
+    std::wstring dirName = TSP_FileHelper::GetFileDir(fileName, false);
+
+    if (dirName.empty())
+        dirName = L".";
+
+    for (std::uint32_t i = 0; i < atlasCount; ++i)
+    {
+        std::wstring  name;
+        std::uint32_t pageCount;
+
+        if (!ReadString(&file, name) || !ReadValue(&file, pageCount))
+            return false;
+
+        TSP_Atlas* pAtlas = pDocument->CreateAndAddAtlas(name);
+
+        // add the pages, each one is read from its file when first accessed
+        for (std::uint32_t j = 0; j < pageCount; ++j)
+        {
+            TSP_HashHelper::IHash128 hash;
+
+            if (!ReadValue(&file, hash.m_Low) || !ReadValue(&file, hash.m_High))
+                return false;
+
+            if (!pDocument->LoadPages(pAtlas, GetPageFileName(dirName, hash)))
+            {
+                M_LogCatErrorT(IO, L"Revision store - missing or damaged page - " << TSP_HashHelper::ToStr(hash));
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_RevisionStore::GetPageDirName(const std::wstring& dirName)
+{
+    return TSP_FileHelper::AppendDelimiter(dirName) + L"pages";
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_RevisionStore::GetPageFileName(const std::wstring& dirName, const TSP_HashHelper::IHash128& hash)
+{
+    return TSP_FileHelper::AppendDelimiter(GetPageDirName(dirName)) + TSP_HashHelper::ToStr(hash) + L".tspb";
+}
+//---------------------------------------------------------------------------
+bool TSP_RevisionStore::WriteString(TSP_Buffer* pBuffer, const std::wstring& str)
+{
+    const std::string utf8 = TSP_StringHelper::Utf16ToUtf8(str);
+
+    if (!WriteValue(pBuffer, std::uint32_t(utf8.length())))
+        return false;
+
+    return (utf8.empty() || pBuffer->Write(utf8.data(), utf8.length()) == utf8.length());
+}
+//---------------------------------------------------------------------------
+bool TSP_RevisionStore::ReadString(TSP_Buffer* pBuffer, std::wstring& str)
+{
+    std::uint32_t length;
+
+    // the length should not exceed the remaining content, e.g. if it was damaged
+    if (!ReadValue(pBuffer, length) || length > pBuffer->GetSize() - pBuffer->GetOffset())
+        return false;
+
+    std::string utf8(length, '\0');
+
+    if (length && pBuffer->Read(&utf8[0], length) != length)
+        return false;
+
+    try
+    {
+        str = TSP_StringHelper::Utf8ToUtf16(utf8);
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,229 @@
+/****************************************************************************
+ * ==> TSP_RevisionStore ---------------------------------------------------*
+ ****************************************************************************
+ * Description:  Stores the document revisions                              *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+
+// common classes
+#include "Common/TSP_Buffer.h"
+#include "Common/TSP_HashHelper.h"
+
+// class prototypes
+class TSP_Document;
+
+/**
+* Revision store, keeps the revisions of a document in a directory. Each page is written as a separate
+* binary document (see TSP_BinaryDocumentWriter), named by the hash of its content, and each revision
+* is a small file listing the document title, its atlases and the hashes of their pages. The directory
+* contains:
+* - pages/<hash>.tspb, a file per page content, shared by all the revisions containing this content
+* - <number>.tspr, a file per revision, numbered from 1
+*@note A page is written only if no revision contained its content before, so adding a revision in
+*      which a few pages changed only writes these pages. A revision file may be opened like any
+*      document, see TSP_Document::Load(), its pages are then read from the page files when accessed
+*@author Jean-Milost Reymond
+*/
+class TSP_RevisionStore
+{
+    public:
+        TSP_RevisionStore();
+        virtual ~TSP_RevisionStore();
+
+        /**
+        * Opens the store
+        *@param dirName - store directory name, created if not exists
+        *@return true on success, otherwise false
+        */
+        virtual bool Open(const std::wstring& dirName);
+
+        /**
+        * Closes the store
+        */
+        virtual void Close();
+
+        /**
+        * Checks if the store is opened
+        *@return true if the store is opened, otherwise false
+        */
+        virtual inline bool IsOpened() const;
+
+        /**
+        * Gets the store directory name
+        *@return the store directory name, empty string if the store isn't opened
+        */
+        virtual inline std::wstring GetDirName() const;
+
+        /**
+        * Gets the revision count
+        *@return the revision count
+        */
+        virtual inline std::size_t GetRevisionCount() const;
+
+        /**
+        * Gets a revision file name
+        *@param revision - revision number, from 1 to the revision count
+        *@return the revision file name
+        */
+        virtual std::wstring GetRevisionFileName(std::size_t revision) const;
+
+        /**
+        * Adds a revision of a document
+        *@param pDocument - document to add
+        *@return the new revision number, 0 on error
+        *@note The pages still not read from the opened document files are read before
+        */
+        virtual std::size_t AddRevision(const TSP_Document* pDocument);
+
+        /**
+        * Loads a revision
+        *@param revision - revision number, from 1 to the revision count
+        *@param pDocument - document to load to
+        *@return true on success, otherwise false
+        */
+        virtual bool LoadRevision(std::size_t revision, TSP_Document* pDocument) const;
+
+        /**
+        * Gets the default store directory name of a document
+        *@param documentFileName - document file name
+        *@return the store directory name, located next to the document
+        */
+        static std::wstring GetDefaultDirName(const std::wstring& documentFileName);
+
+        /**
+        * Checks if a content is a revision
+        *@param pData - content
+        *@param size - content size, in bytes
+        *@return true if the content starts with a revision header, otherwise false
+        */
+        static bool IsRevision(const void* pData, std::size_t size);
+
+        /**
+        * Reads a revision
+        *@param fileName - revision file name, its pages are searched in the same store
+        *@param pDocument - document to fill, should be empty
+        *@return true on success, otherwise false
+        *@note Called by the document while loaded, see TSP_Document::Load()
+        */
+        static bool Read(const std::wstring& fileName, TSP_Document* pDocument);
+
+    private:
+        typedef std::unordered_set<std::wstring> IPageNames;
+
+        static const std::uint32_t m_Magic   = 0x52505354; // "TSPR"
+        static const std::uint32_t m_Version = 1;
+
+        std::wstring m_DirName;
+        IPageNames   m_PageNames;
+        std::size_t  m_RevisionCount = 0;
+
+        /**
+        * Gets the page directory name
+        *@param dirName - store directory name
+        *@return the page directory name
+        */
+        static std::wstring GetPageDirName(const std::wstring& dirName);
+
+        /**
+        * Gets a page file name
+        *@param dirName - store directory name
+        *@param hash - page content hash
+        *@return the page file name
+        */
+        static std::wstring GetPageFileName(const std::wstring& dirName, const TSP_HashHelper::IHash128& hash);
+
+        /**
+        * Writes a string to a buffer
+        *@param pBuffer - buffer to write to
+        *@param str - string to write, written as its UTF-8 length followed by its UTF-8 chars
+        *@return true on success, otherwise false
+        */
+        static bool WriteString(TSP_Buffer* pBuffer, const std::wstring& str);
+
+        /**
+        * Reads a string from a buffer
+        *@param pBuffer - buffer to read from
+        *@param[out] str - read string
+        *@return true on success, otherwise false
+        */
+        static bool ReadString(TSP_Buffer* pBuffer, std::wstring& str);
+
+        /**
+        * Writes a value to a buffer
+        *@param pBuffer - buffer to write to
+        *@param value - value to write, in the platform byte order
+        *@return true on success, otherwise false
+        */
+        template <class T>
+        static inline bool WriteValue(TSP_Buffer* pBuffer, T value);
+
+        /**
+        * Reads a value from a buffer
+        *@param pBuffer - buffer to read from
+        *@param[out] value - read value
+        *@return true on success, otherwise false
+        */
+        template <class T>
+        static inline bool ReadValue(TSP_Buffer* pBuffer, T& value);
+};
+
+//---------------------------------------------------------------------------
+// TSP_RevisionStore
+//---------------------------------------------------------------------------
+bool TSP_RevisionStore::IsOpened() const
+{
+    return !m_DirName.empty();
+}
+//---------------------------------------------------------------------------
+std::wstring TSP_RevisionStore::GetDirName() const
+{
+    return m_DirName;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_RevisionStore::GetRevisionCount() const
+{
+    return m_RevisionCount;
+}
+//---------------------------------------------------------------------------
+template <class T>
+bool TSP_RevisionStore::WriteValue(TSP_Buffer* pBuffer, T value)
+{
+    return (pBuffer->Write(&value, sizeof(T)) == sizeof(T));
+}
+//---------------------------------------------------------------------------
+template <class T>
+bool TSP_RevisionStore::ReadValue(TSP_Buffer* pBuffer, T& value)
+{
+    return (pBuffer->Read(&value, sizeof(T)) == sizeof(T));
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,333 @@
+/****************************************************************************
+ * ==> TSP_SlotMap ---------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Generational slot map                                      *
+ * Contained in: Core                                                       *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+* Generational slot map. Items are kept packed in a contiguous array and are reached through
+* a handle combining a slot index and a generation counter. Lookup, insertion and removal are
+* O(1), and a handle whose item was removed never resolves again, even if its slot is reused
+*@author Jean-Milost Reymond
+*/
+template <class T>
+class TSP_SlotMap
+{
+    public:
+        /**
+        * Item handle, low 32 bits contain the slot index, high 32 bits the slot generation
+        */
+        typedef std::uint64_t IHandle;
+
+        /**
+        * Handle which never resolves to an item
+        */
+        static const IHandle m_NullHandle = 0;
+
+        TSP_SlotMap();
+        virtual ~TSP_SlotMap();
+
+        /**
+        * Adds an item
+        *@param item - item to add
+        *@return the item handle
+        */
+        virtual IHandle Add(const T& item);
+
+        /**
+        * Removes an item
+        *@param handle - handle of the item to remove
+        *@return true on success, false if the handle is stale or invalid
+        *@note The last item is moved to the freed place, so the item order is not kept
+        */
+        virtual bool Remove(IHandle handle);
+
+        /**
+        * Gets an item
+        *@param handle - item handle
+        *@return the item, nullptr if the handle is stale or invalid
+        */
+        virtual T*       Get(IHandle handle);
+        virtual const T* Get(IHandle handle) const;
+
+        /**
+        * Checks if a handle resolves to an item
+        *@param handle - item handle
+        *@return true if the handle resolves to an item, otherwise false
+        */
+        virtual bool Contains(IHandle handle) const;
+
+        /**
+        * Gets the item at index in the packed item array
+        *@param index - item index
+        *@return the item
+        *@note Index validity isn't checked
+        */
+        virtual inline       T& GetAt(std::size_t index);
+        virtual inline const T& GetAt(std::size_t index) const;
+
+        /**
+        * Gets the handle of the item at index in the packed item array
+        *@param index - item index
+        *@return the item handle, m_NullHandle if index is out of bounds
+        */
+        virtual IHandle GetHandleAt(std::size_t index) const;
+
+        /**
+        * Gets the item count
+        *@return the item count
+        */
+        virtual inline std::size_t GetCount() const;
+
+        /**
+        * Reserves memory for a given item count
+        *@param count - item count to reserve for
+        */
+        virtual void Reserve(std::size_t count);
+
+        /**
+        * Clears the map
+        *@note All the handles previously returned become stale
+        */
+        virtual void Clear();
+
+    private:
+        /**
+        * Slot, contains the item index while used, or the next free slot while free
+        */
+        struct ISlot
+        {
+            std::uint32_t m_Index      = 0;
+            std::uint32_t m_Generation = 1;
+        };
+
+        typedef std::vector<ISlot>         ISlots;
+        typedef std::vector<T>             IItems;
+        typedef std::vector<std::uint32_t> IItemSlots;
+
+        static const std::uint32_t m_NoFreeSlot = 0xFFFFFFFF;
+
+        ISlots        m_Slots;
+        IItems        m_Items;
+        IItemSlots    m_ItemSlots;
+        std::uint32_t m_FreeSlot = m_NoFreeSlot;
+
+        /**
+        * Gets the slot matching with a handle
+        *@param handle - item handle
+        *@return slot index, m_NoFreeSlot if the handle is stale or invalid
+        */
+        std::uint32_t GetSlot(IHandle handle) const;
+};
+
+//---------------------------------------------------------------------------
+// TSP_SlotMap
+//---------------------------------------------------------------------------
+template <class T>
+TSP_SlotMap<T>::TSP_SlotMap()
+{}
+//---------------------------------------------------------------------------
+template <class T>
+TSP_SlotMap<T>::~TSP_SlotMap()
+{}
+//---------------------------------------------------------------------------
+template <class T>
+typename TSP_SlotMap<T>::IHandle TSP_SlotMap<T>::Add(const T& item)
+{
+    std::uint32_t slotIndex;
+
+    // is there a free slot to reuse?
+    if (m_FreeSlot != m_NoFreeSlot)
+    {
+        slotIndex  = m_FreeSlot;
+        m_FreeSlot = m_Slots[slotIndex].m_Index;
+    }
+    else
+    {
+        slotIndex = std::uint32_t(m_Slots.size());
+        m_Slots.push_back(ISlot());
+    }
+
+    // add the item at the end of the packed array
+    ISlot& slot  = m_Slots[slotIndex];
+    slot.m_Index = std::uint32_t(m_Items.size());
+    m_Items.push_back(item);
+    m_ItemSlots.push_back(slotIndex);
+
+    return (IHandle(slot.m_Generation) << 32) | slotIndex;
+}
+//---------------------------------------------------------------------------
+template <class T>
+bool TSP_SlotMap<T>::Remove(IHandle handle)
+{
+    const std::uint32_t slotIndex = GetSlot(handle);
+
+    // stale or invalid handle?
+    if (slotIndex == m_NoFreeSlot)
+        return false;
+
+          ISlot&        slot      = m_Slots[slotIndex];
+    const std::uint32_t itemIndex = slot.m_Index;
+    const std::uint32_t lastIndex = std::uint32_t(m_Items.size() - 1);
+
+    // move the last item to the freed place, and update its slot
+    if (itemIndex != lastIndex)
+    {
+        m_Items[itemIndex]                      = std::move(m_Items[lastIndex]);
+        m_ItemSlots[itemIndex]                  = m_ItemSlots[lastIndex];
+        m_Slots[m_ItemSlots[itemIndex]].m_Index = itemIndex;
+    }
+
+    m_Items.pop_back();
+    m_ItemSlots.pop_back();
+
+    // invalidate all the handles pointing to this slot, and add it to the free list. NOTE 0 is
+    // skipped to guarantee that a valid handle never equals m_NullHandle
+    if (!++slot.m_Generation)
+        slot.m_Generation = 1;
+
+    slot.m_Index = m_FreeSlot;
+    m_FreeSlot   = slotIndex;
+
+    return true;
+}
+//---------------------------------------------------------------------------
+template <class T>
+T* TSP_SlotMap<T>::Get(IHandle handle)
+{
+    const std::uint32_t slotIndex = GetSlot(handle);
+
+    if (slotIndex == m_NoFreeSlot)
+        return nullptr;
+
+    return &m_Items[m_Slots[slotIndex].m_Index];
+}
+//---------------------------------------------------------------------------
+template <class T>
+const T* TSP_SlotMap<T>::Get(IHandle handle) const
+{
+    const std::uint32_t slotIndex = GetSlot(handle);
+
+    if (slotIndex == m_NoFreeSlot)
+        return nullptr;
+
+    return &m_Items[m_Slots[slotIndex].m_Index];
+}
+//---------------------------------------------------------------------------
+template <class T>
+bool TSP_SlotMap<T>::Contains(IHandle handle) const
+{
+    return (GetSlot(handle) != m_NoFreeSlot);
+}
+//---------------------------------------------------------------------------
+template <class T>
+T& TSP_SlotMap<T>::GetAt(std::size_t index)
+{
+    return m_Items[index];
+}
+//---------------------------------------------------------------------------
+template <class T>
+const T& TSP_SlotMap<T>::GetAt(std::size_t index) const
+{
+    return m_Items[index];
+}
+//---------------------------------------------------------------------------
+template <class T>
+typename TSP_SlotMap<T>::IHandle TSP_SlotMap<T>::GetHandleAt(std::size_t index) const
+{
+    if (index >= m_ItemSlots.size())
+        return m_NullHandle;
+
+    const std::uint32_t slotIndex = m_ItemSlots[index];
+
+    return (IHandle(m_Slots[slotIndex].m_Generation) << 32) | slotIndex;
+}
+//---------------------------------------------------------------------------
+template <class T>
+std::size_t TSP_SlotMap<T>::GetCount() const
+{
+    return m_Items.size();
+}
+//---------------------------------------------------------------------------
+template <class T>
+void TSP_SlotMap<T>::Reserve(std::size_t count)
+{
+    m_Slots.reserve(count);
+    m_Items.reserve(count);
+    m_ItemSlots.reserve(count);
+}
+//---------------------------------------------------------------------------
+template <class T>
+void TSP_SlotMap<T>::Clear()
+{
+    // free all the used slots, bumping their generation so previous handles become stale
+    for (std::size_t i = 0; i < m_ItemSlots.size(); ++i)
+    {
+        const std::uint32_t slotIndex = m_ItemSlots[i];
+              ISlot&        slot      = m_Slots[slotIndex];
+
+        if (!++slot.m_Generation)
+            slot.m_Generation = 1;
+
+        slot.m_Index = m_FreeSlot;
+        m_FreeSlot   = slotIndex;
+    }
+
+    m_Items.clear();
+    m_ItemSlots.clear();
+}
+//---------------------------------------------------------------------------
+template <class T>
+std::uint32_t TSP_SlotMap<T>::GetSlot(IHandle handle) const
+{
+    const std::uint32_t slotIndex  = std::uint32_t(handle & 0xFFFFFFFF);
+    const std::uint32_t generation = std::uint32_t(handle >> 32);
+
+    // is slot out of bounds?
+    if (slotIndex >= m_Slots.size())
+        return m_NoFreeSlot;
+
+    const ISlot& slot = m_Slots[slotIndex];
+
+    // is handle stale?
+    if (slot.m_Generation != generation)
+        return m_NoFreeSlot;
+
+    // is slot free? NOTE this may only happen with a forged handle, because a free slot generation
+    // is always greater than the one of any handle given for it
+    if (slot.m_Index >= m_ItemSlots.size() || m_ItemSlots[slot.m_Index] != slotIndex)
+        return m_NoFreeSlot;
+
+    return slotIndex;
+}
+//---------------------------------------------------------------------------
@@ -66,12 +66,12 @@ void TSP_QmlAtlas::SetProxy(TSP_QmlAtlasProxy* pProxy)
 //---------------------------------------------------------------------------
 TSP_Page* TSP_QmlAtlas::CreatePage()
 {
-    return new TSP_QmlPage(this);
+    return new (m_pPageArena) TSP_QmlPage(this);
 }
 //---------------------------------------------------------------------------
 TSP_Page* TSP_QmlAtlas::CreatePage(const std::wstring& name)
 {
-    return new TSP_QmlPage(name, this);
+    return new (m_pPageArena) TSP_QmlPage(name, this);
 }
 //---------------------------------------------------------------------------
 TSP_Page* TSP_QmlAtlas::CreateAndAddPage()
@@ -149,7 +149,7 @@ void TSP_QmlAtlas::RemovePage(std::size_t index)
             return;
 
         // notify atlas proxy that a page was removed
-        m_pProxy->RemovePage(QString::fromStdString(pQmlPage->GetUID()));
+        m_pProxy->RemovePage(TSP_QmlProxy::UIDToQStr(pQmlPage->GetUID()));
 
         // remove the page from document
         TSP_PageContainer::RemovePage(index);
@@ -175,7 +175,7 @@ void TSP_QmlAtlas::RemovePage(TSP_Page* pPage)
             return;
 
         // notify atlas proxy that a page was removed
-        m_pProxy->RemovePage(QString::fromStdString(pQmlPage->GetUID()));
+        m_pProxy->RemovePage(TSP_QmlProxy::UIDToQStr(pQmlPage->GetUID()));
 
         // remove the page from document
         TSP_PageContainer::RemovePage(pPage);
@@ -191,22 +191,22 @@ TSP_Page* TSP_QmlAtlas::GetSelectedPage()
             return nullptr;
 
         // get currently selected owner unique identifier
-        const std::string selectedOwnerUID = m_pProxy->QuerySelectedPageOwnerUID().toStdString();
+        const TSP_Item::IUID selectedOwnerUID = TSP_QmlProxy::QStrToUID(m_pProxy->QuerySelectedPageOwnerUID());
 
         // is this atlas the currently selected one on the user interface?
-        if (selectedOwnerUID.empty() || selectedOwnerUID != GetUID())
+        if (!selectedOwnerUID || selectedOwnerUID != GetUID())
             // the selected page cannot be currently shown on the interface
             return nullptr;
 
         // queries the selected page unique identifier
-        m_SelectedPageUID = m_pProxy->QuerySelectedPageUID().toStdString();
+        m_SelectedPageUID = TSP_QmlProxy::QStrToUID(m_pProxy->QuerySelectedPageUID());
 
         // found it?
-        if (m_SelectedPageUID.empty())
+        if (!m_SelectedPageUID)
             return nullptr;
 
         // get the selected page
-        return GetPage(m_SelectedPageUID);
+        return GetPageByUID(m_SelectedPageUID);
     }
     M_CATCH_LOG
 
@@ -222,10 +222,10 @@ bool TSP_QmlAtlas::CreatePageView(TSP_Page* pPage)
         return false;
 
     // get page unique identifier
-    const std::string uid = pPage->GetUID();
+    const QString uid = TSP_QmlProxy::UIDToQStr(pPage->GetUID());
 
     // notify atlas proxy that a new page should be added
-    if (!m_pProxy->AddPage(QString::fromStdString(uid)))
+    if (!m_pProxy->AddPage(uid))
         return false;
 
     // get the page
@@ -235,7 +235,7 @@ bool TSP_QmlAtlas::CreatePageView(TSP_Page* pPage)
         return false;
 
     // get the newly added component proxy
-    TSP_QmlPageProxy* pProxy = static_cast<TSP_QmlPageProxy*>(TSP_QmlProxyDictionary::Instance()->GetProxy(uid));
+    TSP_QmlPageProxy* pProxy = static_cast<TSP_QmlPageProxy*>(TSP_QmlProxyDictionary::Instance()->GetProxy(uid.toStdString()));
 
     if (!pProxy)
         return false;
@@ -120,7 +120,7 @@ class TSP_QmlAtlas : public TSP_Atlas
 
     private:
         TSP_QmlAtlasProxy* m_pProxy = nullptr;
-        std::string        m_SelectedPageUID;
+        TSP_Item::IUID     m_SelectedPageUID = 0;
 
         /**
         * Creates a new page view and adds it to the user interface
@@ -29,6 +29,9 @@
 
 #include "TSP_QmlAtlasProxy.h"
 
+// core classes
+#include "Core/TSP_Journal.h"
+
 // qt classes
 #include "TSP_QmlAtlas.h"
 
@@ -57,6 +60,8 @@ void TSP_QmlAtlasProxy::setName(const QString& name)
 
     m_pAtlas->SetName(name.toStdWString());
 
+    TSP_Journal::SetName(m_pAtlas);
+
     emit nameChanged(name);
 }
 //---------------------------------------------------------------------------
@@ -45,8 +45,8 @@ class TSP_QmlBox : public TSP_Box
     public:
         /**
         * Connector position
-        *@note This enum is linked with the one located in TSP_Connector.
-        *      Don't modify it without updating its twin
+        *@note This enum is linked with the one located in TSP_Connector, and with
+        *      TSP_LinkGraph::IESide. Don't modify it without updating its twins
         */
         enum class IEPosition
         {
@@ -31,6 +31,7 @@
 
  // core classes
 #include "Core/TSP_Box.h"
+#include "Core/TSP_Journal.h"
 
 //---------------------------------------------------------------------------
 // TSP_QmlBoxProxy
@@ -73,6 +74,8 @@ void TSP_QmlBoxProxy::setTitle(const QString& title)
 
     m_pBox->SetTitle(title.toStdWString());
 
+    TSP_Journal::SetTitle(m_pBox);
+
     emit titleChanged(title);
 }
 //---------------------------------------------------------------------------
@@ -83,6 +86,8 @@ void TSP_QmlBoxProxy::setDescription(const QString& description)
 
     m_pBox->SetDescription(description.toStdWString());
 
+    TSP_Journal::SetDescription(m_pBox);
+
     emit descriptionChanged(description);
 }
 //---------------------------------------------------------------------------
@@ -93,6 +98,8 @@ void TSP_QmlBoxProxy::setComments(const QString& comments)
 
     m_pBox->SetComments(comments.toStdWString());
 
+    TSP_Journal::SetComments(m_pBox);
+
     emit commentsChanged(comments);
 }
 //---------------------------------------------------------------------------
@@ -104,6 +111,11 @@ TSP_Box* TSP_QmlBoxProxy::GetBox() const
 void TSP_QmlBoxProxy::SetBox(TSP_Box* pBox)
 {
     m_pBox = pBox;
+
+    // the box may already contain data, e.g. if it was read from a file
+    emit titleChanged(getTitle());
+    emit descriptionChanged(getDescription());
+    emit commentsChanged(getComments());
 }
 //---------------------------------------------------------------------------
 bool TSP_QmlBoxProxy::AddItem(const QString& type, const QString& uid)
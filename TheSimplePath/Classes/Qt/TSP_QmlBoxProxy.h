@@ -139,6 +139,7 @@ class TSP_QmlBoxProxy : public TSP_QmlProxy
         /**
         * Sets the linked box
         *@param pBox - the linked box
+        *@note The view is notified that the box title, description and comments changed
         */
         virtual void SetBox(TSP_Box* pBox);
 
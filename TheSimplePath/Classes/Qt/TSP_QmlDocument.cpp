@@ -36,8 +36,12 @@
 #include "Common/TSP_Exception.h"
 #include "Common/TSP_GlobalMacros.h"
 
+// core classes
+#include "Core/TSP_Journal.h"
+
 // qt classes
 #include "TSP_QmlAtlas.h"
+#include "TSP_QmlPage.h"
 #include "TSP_QmlProxyDictionary.h"
 
  // application
@@ -168,6 +172,13 @@ bool TSP_QmlDocument::Create()
 
         ++m_OpenedCount;
 
+        // the default content doesn't need to be saved
+        ClearModified();
+
+        // the next modifications are recorded from the new document default content
+        if (GetJournal())
+            GetJournal()->Reset(L"");
+
         SetStatus(TSP_Document::IEDocStatus::IE_DS_Opened);
 
         return true;
@@ -207,15 +218,60 @@ void TSP_QmlDocument::Close()
 
         // close the document itself
         TSP_Document::Close();
+
+        // the closed document modifications should no longer be recovered
+        if (GetJournal())
+            GetJournal()->Reset(L"");
     }
     M_CATCH_LOG
 }
 //---------------------------------------------------------------------------
+void TSP_QmlDocument::SetModified()
+{
+    // already modified?
+    if (IsModified())
+        return;
+
+    TSP_Document::SetModified();
+
+    // notify the user interface
+    if (m_pDocumentModel)
+        m_pDocumentModel->NotifyModified();
+}
+//---------------------------------------------------------------------------
+void TSP_QmlDocument::ClearModified()
+{
+    const bool modified = IsModified();
+
+    TSP_Document::ClearModified();
+
+    // notify the user interface
+    if (modified && m_pDocumentModel)
+        m_pDocumentModel->NotifyModified();
+}
+//---------------------------------------------------------------------------
 std::size_t TSP_QmlDocument::GetOpenedCount() const
 {
     return m_OpenedCount;
 }
 //---------------------------------------------------------------------------
+bool TSP_QmlDocument::CanReadPagesInParallel() const
+{
+    return true;
+}
+//---------------------------------------------------------------------------
+void TSP_QmlDocument::NotifyPagesRead(const TSP_AttributeQuery::IPages& pages)
+{
+    M_TRY
+    {
+        // called by the thread which requested the pages, i.e. the GUI thread, once they are all read
+        for each (const TSP_Page* pPage in pages)
+            if (pPage)
+                static_cast<TSP_QmlPage*>(const_cast<TSP_Page*>(pPage))->CreatePendingViews();
+    }
+    M_CATCH_LOG
+}
+//---------------------------------------------------------------------------
 TSP_Atlas* TSP_QmlDocument::CreateAtlas()
 {
     return new TSP_QmlAtlas(this);
@@ -305,7 +361,7 @@ void TSP_QmlDocument::RemoveAtlas(std::size_t index)
 
         // remove the atlas from the view
         m_pDocumentModel->beginRemoveAtlas();
-        m_pDocumentModel->removeAtlas(QString::fromStdString(pAtlas->GetUID()));
+        m_pDocumentModel->removeAtlas(TSP_QmlProxy::UIDToQStr(pAtlas->GetUID()));
         m_pDocumentModel->endRemoveAtlas();
 
         // remove atlas from the document
@@ -329,7 +385,7 @@ void TSP_QmlDocument::RemoveAtlas(TSP_Atlas* pAtlas)
 
         // remove the atlas from the view
         m_pDocumentModel->beginRemoveAtlas();
-        m_pDocumentModel->removeAtlas(QString::fromStdString(pAtlas->GetUID()));
+        m_pDocumentModel->removeAtlas(TSP_QmlProxy::UIDToQStr(pAtlas->GetUID()));
         m_pDocumentModel->endRemoveAtlas();
 
         // remove atlas from the document
@@ -346,10 +402,10 @@ TSP_Atlas* TSP_QmlDocument::GetSelectedAtlas() const
             return nullptr;
 
         // get the selected atlas unique identifier
-        const std::string atlasUID = m_pDocumentModel->QuerySelectedAtlasUID().toStdString();
+        const TSP_Item::IUID atlasUID = TSP_QmlProxy::QStrToUID(m_pDocumentModel->QuerySelectedAtlasUID());
 
         // get the atlas
-        return TSP_Document::GetAtlas(atlasUID);
+        return TSP_Document::GetAtlasByUID(atlasUID);
     }
     M_CATCH_LOG
 
@@ -371,10 +427,10 @@ bool TSP_QmlDocument::CreateAtlasView(TSP_Atlas* pAtlas)
         return false;
 
     // get atlas unique identifier
-    const std::string uid = pAtlas->GetUID();
+    const QString uid = TSP_QmlProxy::UIDToQStr(pAtlas->GetUID());
 
     // add atlas on the document view
-    m_pDocumentModel->addAtlas(QString::fromStdString(uid));
+    m_pDocumentModel->addAtlas(uid);
 
     // get the atlas
     TSP_QmlAtlas* pQmlAtlas = static_cast<TSP_QmlAtlas*>(pAtlas);
@@ -383,7 +439,7 @@ bool TSP_QmlDocument::CreateAtlasView(TSP_Atlas* pAtlas)
         return false;
 
     // get the newly added component proxy
-    TSP_QmlAtlasProxy* pProxy = static_cast<TSP_QmlAtlasProxy*>(TSP_QmlProxyDictionary::Instance()->GetProxy(uid));
+    TSP_QmlAtlasProxy* pProxy = static_cast<TSP_QmlAtlasProxy*>(TSP_QmlProxyDictionary::Instance()->GetProxy(uid.toStdString()));
 
     if (!pProxy)
         return false;
@@ -83,12 +83,36 @@ class TSP_QmlDocument : public TSP_Document
         */
         virtual void Close();
 
+        /**
+        * Marks the document as modified
+        */
+        virtual void SetModified();
+
+        /**
+        * Marks the document and all its items as unmodified
+        */
+        virtual void ClearModified();
+
         /**
         * Gets the opened count
         *@return the opened count
         */
         virtual std::size_t GetOpenedCount() const;
 
+        /**
+        * Checks if the document pages may be filled from several threads at once
+        *@return true, the qml components read from a page source are created without their views, which
+        *        are created once the pages are read, see NotifyPagesRead()
+        */
+        virtual bool CanReadPagesInParallel() const;
+
+        /**
+        * Notifies that pages were read from the opened binary files
+        *@param pages - read pages
+        *@note Creates the views of the read components, at once
+        */
+        virtual void NotifyPagesRead(const TSP_AttributeQuery::IPages& pages);
+
         /**
         * Creates an atlas
         *@return newly created atlas
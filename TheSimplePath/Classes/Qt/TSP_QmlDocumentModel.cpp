@@ -69,6 +69,14 @@ void TSP_QmlDocumentModel::setSelectedAtlasUID(QString uid)
     m_SelectedAtlasUID = uid;
 }
 //---------------------------------------------------------------------------
+bool TSP_QmlDocumentModel::getModified() const
+{
+    if (!m_pDocument)
+        return false;
+
+    return m_pDocument->IsModified();
+}
+//---------------------------------------------------------------------------
 bool TSP_QmlDocumentModel::CreateView()
 {
     if (!m_pDocument)
@@ -93,6 +101,14 @@ bool TSP_QmlDocumentModel::DeleteView()
     return true;
 }
 //---------------------------------------------------------------------------
+void TSP_QmlDocumentModel::NotifyModified()
+{
+    if (!m_pDocument)
+        return;
+
+    emit modifiedChanged(m_pDocument->IsModified());
+}
+//---------------------------------------------------------------------------
 TSP_QmlDocument* TSP_QmlDocumentModel::GetDocument() const
 {
     return m_pDocument;
@@ -50,6 +50,7 @@ class TSP_QmlDocumentModel : public QAbstractListModel
     public:
         Q_PROPERTY(int     docStatus        READ getDocStatus        WRITE setDocStatus        NOTIFY docStatusChanged);
         Q_PROPERTY(QString selectedAtlasUID READ getSelectedAtlasUID WRITE setSelectedAtlasUID NOTIFY selectedAtlasUIDChanged);
+        Q_PROPERTY(bool    modified         READ getModified                                   NOTIFY modifiedChanged);
 
     public slots:
         /**
@@ -76,6 +77,12 @@ class TSP_QmlDocumentModel : public QAbstractListModel
         */
         void setSelectedAtlasUID(QString uid);
 
+        /**
+        * Gets if the document was modified since it was loaded or saved
+        *@return true if the document was modified, otherwise false
+        */
+        bool getModified() const;
+
     signals:
         /**
         * Called when the document view should be created
@@ -118,6 +125,12 @@ class TSP_QmlDocumentModel : public QAbstractListModel
         */
         void selectedAtlasUIDChanged(const QString& uid);
 
+        /**
+        * Called when the document was modified, or saved
+        *@param modified - if true, the document was modified since it was loaded or saved
+        */
+        void modifiedChanged(bool modified);
+
     public:
         /**
         * Data roles
@@ -154,6 +167,11 @@ class TSP_QmlDocumentModel : public QAbstractListModel
         */
         virtual bool DeleteView();
 
+        /**
+        * Notifies the user interface that the document modified state changed
+        */
+        virtual void NotifyModified();
+
         /**
         * Notify that an atlas will be added
         */
@@ -31,6 +31,8 @@
 
  // core classes
 #include "Core/TSP_Link.h"
+#include "Core/TSP_Page.h"
+#include "Core/TSP_Journal.h"
 
 //---------------------------------------------------------------------------
 // TSP_QmlLinkProxy
@@ -73,6 +75,8 @@ void TSP_QmlLinkProxy::setTitle(const QString& title)
 
     m_pLink->SetTitle(title.toStdWString());
 
+    TSP_Journal::SetTitle(m_pLink);
+
     emit titleChanged(title);
 }
 //---------------------------------------------------------------------------
@@ -83,6 +87,8 @@ void TSP_QmlLinkProxy::setDescription(const QString& description)
 
     m_pLink->SetDescription(description.toStdWString());
 
+    TSP_Journal::SetDescription(m_pLink);
+
     emit descriptionChanged(description);
 }
 //---------------------------------------------------------------------------
@@ -93,6 +99,8 @@ void TSP_QmlLinkProxy::setComments(const QString& comments)
 
     m_pLink->SetComments(comments.toStdWString());
 
+    TSP_Journal::SetComments(m_pLink);
+
     emit commentsChanged(comments);
 }
 //---------------------------------------------------------------------------
@@ -104,5 +112,32 @@ TSP_Link* TSP_QmlLinkProxy::GetLink() const
 void TSP_QmlLinkProxy::SetLink(TSP_Link* pLink)
 {
     m_pLink = pLink;
+
+    // the link may already contain data, e.g. if it was read from a file
+    emit titleChanged(getTitle());
+    emit descriptionChanged(getDescription());
+    emit commentsChanged(getComments());
+}
+//---------------------------------------------------------------------------
+void TSP_QmlLinkProxy::onBoundToBox(const QString& boxUID, int position, bool isEnd)
+{
+    if (!m_pLink)
+        return;
+
+    TSP_Item* pOwner = m_pLink->GetOwner();
+
+    // is link owned by a page?
+    if (!pOwner || !pOwner->IsKindOf(TSP_Item::IEType::IE_T_Page))
+        return;
+
+    TSP_LinkGraph* pLinkGraph = static_cast<TSP_Page*>(pOwner)->GetLinkGraph();
+
+    // update the link end in the page link graph
+    if (isEnd)
+        pLinkGraph->SetEnd(m_pLink->GetUID(), QStrToUID(boxUID), (TSP_LinkGraph::IESide)position);
+    else
+        pLinkGraph->SetStart(m_pLink->GetUID(), QStrToUID(boxUID), (TSP_LinkGraph::IESide)position);
+
+    TSP_Journal::SetLinkEnd(m_pLink, isEnd);
 }
 //---------------------------------------------------------------------------
@@ -125,9 +125,18 @@ class TSP_QmlLinkProxy : public TSP_QmlProxy
         /**
         * Sets the linked link component
         *@param pLink - the linked link component
+        *@note The view is notified that the link title, description and comments changed
         */
         virtual void SetLink(TSP_Link* pLink);
 
+        /**
+        * Called when the link start or end was bound to a box connector on the user interface
+        *@param boxUID - box unique identifier
+        *@param position - connector position on the box
+        *@param isEnd - if true, the link end was bound, otherwise the link start
+        */
+        virtual Q_INVOKABLE void onBoundToBox(const QString& boxUID, int position, bool isEnd);
+
     private:
         TSP_Link* m_pLink = nullptr;
 };
@@ -39,6 +39,9 @@
 // qt classes
 #include "TSP_QmlAtlas.h"
 
+// qt
+#include <QMetaObject>
+
  //---------------------------------------------------------------------------
  // TSP_QmlPage
  //---------------------------------------------------------------------------
@@ -65,12 +68,34 @@ void TSP_QmlPage::SetProxy(TSP_QmlPageProxy* pProxy)
 //---------------------------------------------------------------------------
 bool TSP_QmlPage::IsAtlasPage() const
 {
-    return dynamic_cast<TSP_Atlas*>(GetOwner());
+    TSP_Item* pOwner = GetOwner();
+    return pOwner && pOwner->IsKindOf(IEType::IE_T_Atlas);
 }
 //---------------------------------------------------------------------------
 bool TSP_QmlPage::IsProcessPage() const
 {
-    return dynamic_cast<TSP_Process*>(GetOwner());
+    TSP_Item* pOwner = GetOwner();
+    return pOwner && pOwner->IsKindOf(IEType::IE_T_Process);
+}
+//---------------------------------------------------------------------------
+TSP_Process* TSP_QmlPage::CreateAndAddProcess(const std::wstring& name,
+                                              const std::wstring& description,
+                                              const std::wstring& comments)
+{
+    // not read from the page source?
+    if (!IsReadingContent())
+        return TSP_Page::CreateAndAddProcess(name, description, comments);
+
+    // the process pages are added by the source, so no default page is created
+    std::unique_ptr<TSP_QmlProcess> pProcess(new (GetArena()) TSP_QmlProcess(name, description, comments, this));
+
+    if (!TSP_Page::Add(pProcess.get()))
+        return nullptr;
+
+    TSP_QmlProcess* pQmlProcess = pProcess.release();
+    AddPendingView(pQmlProcess);
+
+    return pQmlProcess;
 }
 //---------------------------------------------------------------------------
 TSP_Process* TSP_QmlPage::CreateAndAddProcess(const std::wstring& name,
@@ -85,7 +110,7 @@ TSP_Process* TSP_QmlPage::CreateAndAddProcess(const std::wstring& name,
     if (IsProcessPage())
         return nullptr;
 
-    std::unique_ptr<TSP_QmlProcess> pProcess = std::make_unique<TSP_QmlProcess>(this);
+    std::unique_ptr<TSP_QmlProcess> pProcess(new (GetArena()) TSP_QmlProcess(this));
 
     // add a process on the page view
     if (!CreateBoxView(pProcess.get(), "process", x, y, width, height))
@@ -97,7 +122,7 @@ TSP_Process* TSP_QmlPage::CreateAndAddProcess(const std::wstring& name,
     // found it?
     if (!pProcessProxy)
     {
-        RemoveComponentView(QString::fromStdString(pProcess->GetUID()));
+        RemoveComponentView(TSP_QmlProxy::UIDToQStr(pProcess->GetUID()));
         return nullptr;
     }
 
@@ -112,20 +137,39 @@ TSP_Process* TSP_QmlPage::CreateAndAddProcess(const std::wstring& name,
     // succeeded?
     if (!pProcessPage)
     {
-        RemoveComponentView(QString::fromStdString(pProcess->GetUID()));
+        RemoveComponentView(TSP_QmlProxy::UIDToQStr(pProcess->GetUID()));
         return nullptr;
     }
 
     // add newly created process to page
     if (!TSP_Page::Add(pProcess.get()))
     {
-        RemoveComponentView(QString::fromStdString(pProcess->GetUID()));
+        RemoveComponentView(TSP_QmlProxy::UIDToQStr(pProcess->GetUID()));
         return nullptr;
     }
 
     return pProcess.release();
 }
 //---------------------------------------------------------------------------
+TSP_Box* TSP_QmlPage::CreateAndAddBox(const std::wstring& name,
+                                      const std::wstring& description,
+                                      const std::wstring& comments)
+{
+    // not read from the page source?
+    if (!IsReadingContent())
+        return TSP_Page::CreateAndAddBox(name, description, comments);
+
+    std::unique_ptr<TSP_QmlBox> pBox(new (GetArena()) TSP_QmlBox(name, description, comments, this));
+
+    if (!TSP_Page::Add(pBox.get()))
+        return nullptr;
+
+    TSP_QmlBox* pQmlBox = pBox.release();
+    AddPendingView(pQmlBox);
+
+    return pQmlBox;
+}
+//---------------------------------------------------------------------------
 TSP_Box* TSP_QmlPage::CreateAndAddBox(const std::wstring& name,
                                       const std::wstring& description,
                                       const std::wstring& comments,
@@ -134,7 +178,7 @@ TSP_Box* TSP_QmlPage::CreateAndAddBox(const std::wstring& name,
                                             int           width,
                                             int           height)
 {
-    std::unique_ptr<TSP_QmlBox> pBox = std::make_unique<TSP_QmlBox>(this);
+    std::unique_ptr<TSP_QmlBox> pBox(new (GetArena()) TSP_QmlBox(this));
 
     // add a box on the page view
     if (!CreateBoxView(pBox.get(), "box", x, y, width, height))
@@ -146,7 +190,7 @@ TSP_Box* TSP_QmlPage::CreateAndAddBox(const std::wstring& name,
     // found it?
     if (!pBoxProxy)
     {
-        RemoveComponentView(QString::fromStdString(pBox->GetUID()));
+        RemoveComponentView(TSP_QmlProxy::UIDToQStr(pBox->GetUID()));
         return nullptr;
     }
 
@@ -158,13 +202,33 @@ TSP_Box* TSP_QmlPage::CreateAndAddBox(const std::wstring& name,
     // add newly created box to page
     if (!TSP_Page::Add(pBox.get()))
     {
-        RemoveComponentView(QString::fromStdString(pBox->GetUID()));
+        RemoveComponentView(TSP_QmlProxy::UIDToQStr(pBox->GetUID()));
         return nullptr;
     }
 
     return pBox.release();
 }
 //---------------------------------------------------------------------------
+TSP_Link* TSP_QmlPage::CreateAndAddLink(const std::wstring& name,
+                                        const std::wstring& description,
+                                        const std::wstring& comments)
+{
+    // not read from the page source?
+    if (!IsReadingContent())
+        return TSP_Page::CreateAndAddLink(name, description, comments);
+
+    // the link ends are set in the page link graph by the source
+    std::unique_ptr<TSP_QmlLink> pLink(new (GetArena()) TSP_QmlLink(name, description, comments, this));
+
+    if (!TSP_Page::Add(pLink.get()))
+        return nullptr;
+
+    TSP_QmlLink* pQmlLink = pLink.release();
+    AddPendingView(pQmlLink);
+
+    return pQmlLink;
+}
+//---------------------------------------------------------------------------
 TSP_Link* TSP_QmlPage::CreateAndAddLink(const std::wstring&          name,
                                         const std::wstring&          description,
                                         const std::wstring&          comments,
@@ -177,7 +241,7 @@ TSP_Link* TSP_QmlPage::CreateAndAddLink(const std::wstring&          name,
                                               int                    width,
                                               int                    height)
 {
-    std::unique_ptr<TSP_QmlLink> pLink = std::make_unique<TSP_QmlLink>(this);
+    std::unique_ptr<TSP_QmlLink> pLink(new (GetArena()) TSP_QmlLink(this));
 
     // add a link on the page view
     if (!CreateLinkView(pLink.get(),
@@ -198,7 +262,7 @@ TSP_Link* TSP_QmlPage::CreateAndAddLink(const std::wstring&          name,
     // found it?
     if (!pLinkProxy)
     {
-        RemoveComponentView(QString::fromStdString(pLink->GetUID()));
+        RemoveComponentView(TSP_QmlProxy::UIDToQStr(pLink->GetUID()));
         return nullptr;
     }
 
@@ -210,19 +274,27 @@ TSP_Link* TSP_QmlPage::CreateAndAddLink(const std::wstring&          name,
     // add newly created link to page
     if (!TSP_Page::Add(pLink.get()))
     {
-        RemoveComponentView(QString::fromStdString(pLink->GetUID()));
+        RemoveComponentView(TSP_QmlProxy::UIDToQStr(pLink->GetUID()));
         return nullptr;
     }
 
+    // register the link ends in the page link graph
+    GetLinkGraph()->SetStart(pLink->GetUID(),
+                             TSP_QmlProxy::QStrToUID(QString::fromStdWString(startUID)),
+                             (TSP_LinkGraph::IESide)startPos);
+    GetLinkGraph()->SetEnd(pLink->GetUID(),
+                           TSP_QmlProxy::QStrToUID(QString::fromStdWString(endUID)),
+                           (TSP_LinkGraph::IESide)endPos);
+
     return pLink.release();
 }
 //---------------------------------------------------------------------------
-void TSP_QmlPage::Remove(const std::string& uid)
+void TSP_QmlPage::Remove(TSP_Item::IUID uid)
 {
-    if (uid.empty())
+    if (!uid)
         return;
 
-    RemoveComponentView(QString::fromStdString(uid));
+    RemoveComponentView(TSP_QmlProxy::UIDToQStr(uid));
     TSP_Page::Remove(uid);
 }
 //---------------------------------------------------------------------------
@@ -231,10 +303,88 @@ void TSP_QmlPage::Remove(TSP_Component* pComponent)
     if (!pComponent)
         return;
 
-    RemoveComponentView(QString::fromStdString(pComponent->GetUID()));
+    RemoveComponentView(TSP_QmlProxy::UIDToQStr(pComponent->GetUID()));
     TSP_Page::Remove(pComponent);
 }
 //---------------------------------------------------------------------------
+void TSP_QmlPage::CreatePendingViews()
+{
+    IUIDs pending;
+
+    {
+        // lock up the thread
+        std::unique_lock<std::mutex> lock(m_PendingMutex);
+
+        pending.swap(m_PendingViews);
+    }
+
+    if (pending.empty())
+        return;
+
+    // create the box and process views first, as the link views are attached to them
+    for each (TSP_Item::IUID uid in pending)
+    {
+        TSP_Component* pComponent = Get(uid);
+
+        // removed meanwhile?
+        if (!pComponent)
+            continue;
+
+        switch (pComponent->GetType())
+        {
+            case IEType::IE_T_Box:
+                if (!CreateBoxView(static_cast<TSP_QmlBox*>(pComponent), "box", -1, -1, 144, 93))
+                    M_LogErrorT("Create pending views - FAILED - box view could not be created");
+
+                break;
+
+            case IEType::IE_T_Process:
+            {
+                TSP_QmlProcess* pProcess = static_cast<TSP_QmlProcess*>(pComponent);
+
+                // the process pages were also added without their views
+                if (!CreateBoxView(pProcess, "process", -1, -1, -1, -1) || !pProcess->CreatePageViews())
+                    M_LogErrorT("Create pending views - FAILED - process view could not be created");
+
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    const TSP_LinkGraph* pGraph = GetLinkGraph();
+
+    for each (TSP_Item::IUID uid in pending)
+    {
+        TSP_Component* pComponent = Get(uid);
+
+        if (!pComponent || pComponent->GetType() != IEType::IE_T_Link)
+            continue;
+
+        TSP_Item::IUID        startUID  = 0;
+        TSP_Item::IUID        endUID    = 0;
+        TSP_LinkGraph::IESide startSide = TSP_LinkGraph::IESide::IE_S_None;
+        TSP_LinkGraph::IESide endSide   = TSP_LinkGraph::IESide::IE_S_None;
+
+        pGraph->GetStart(uid, startUID, startSide);
+        pGraph->GetEnd(uid, endUID, endSide);
+
+        if (!CreateLinkView(static_cast<TSP_QmlLink*>(pComponent),
+                            "link",
+                            startUID ? TSP_QmlProxy::UIDToQStr(startUID) : QString(),
+                            (TSP_QmlBox::IEPosition)startSide,
+                            endUID ? TSP_QmlProxy::UIDToQStr(endUID) : QString(),
+                            (TSP_QmlBox::IEPosition)endSide,
+                            -1,
+                            -1,
+                            100,
+                            50))
+            M_LogErrorT("Create pending views - FAILED - link view could not be created");
+    }
+}
+//---------------------------------------------------------------------------
 void TSP_QmlPage::RemoveComponentView(const QString& uid)
 {
     if (uid.isEmpty())
@@ -247,3 +397,30 @@ void TSP_QmlPage::RemoveComponentView(const QString& uid)
     m_pProxy->RemoveComponent(uid);
 }
 //---------------------------------------------------------------------------
+void TSP_QmlPage::AddPendingView(const TSP_Component* pComponent)
+{
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_PendingMutex);
+
+    m_PendingViews.push_back(pComponent->GetUID());
+
+    // the document creates the views once it read its pages, but a page may also be read when it's first
+    // accessed, e.g. by a query running on another thread. In this case the views are created later, by
+    // the GUI thread
+    if (m_PendingViews.size() == 1 && m_pProxy)
+    {
+        const TSP_Item::IUID uid = GetUID();
+
+        QMetaObject::invokeMethod(m_pProxy,
+                                  [uid]()
+                                  {
+                                      TSP_Item* pItem = TSP_Item::Find(uid);
+
+                                      // the page may have been deleted meanwhile
+                                      if (pItem && pItem->GetType() == TSP_Item::IEType::IE_T_Page)
+                                          static_cast<TSP_QmlPage*>(pItem)->CreatePendingViews();
+                                  },
+                                  Qt::QueuedConnection);
+    }
+}
+//---------------------------------------------------------------------------
@@ -29,6 +29,10 @@
 
 #pragma once
 
+// std
+#include <mutex>
+#include <vector>
+
 // core classes
 #include "Core/TSP_Page.h"
 
@@ -87,6 +91,18 @@ class TSP_QmlPage : public TSP_Page
         */
         virtual bool IsProcessPage() const;
 
+        /**
+        * Creates a process and adds it in page
+        *@param name - process name
+        *@param description - process description
+        *@param comments - process comments
+        *@return newly created process
+        *@note While the page content is read, the process view is created later, see CreatePendingViews()
+        */
+        virtual TSP_Process* CreateAndAddProcess(const std::wstring& name,
+                                                 const std::wstring& description,
+                                                 const std::wstring& comments);
+
         /**
         * Creates a process and adds it in page
         *@param name - process name
@@ -106,6 +122,18 @@ class TSP_QmlPage : public TSP_Page
                                                        int           width       = -1,
                                                        int           height      = -1);
 
+        /**
+        * Creates a box and adds it in page
+        *@param name - box name
+        *@param description - box description
+        *@param comments - box comments
+        *@return newly created box
+        *@note While the page content is read, the box view is created later, see CreatePendingViews()
+        */
+        virtual TSP_Box* CreateAndAddBox(const std::wstring& name,
+                                         const std::wstring& description,
+                                         const std::wstring& comments);
+
         /**
         * Creates a box and adds it in page
         *@param name - box name
@@ -125,6 +153,18 @@ class TSP_QmlPage : public TSP_Page
                                                int           width       =  144,
                                                int           height      =  93);
 
+        /**
+        * Creates a link and adds it in page
+        *@param name - link name
+        *@param description - link description
+        *@param comments - link comments
+        *@return newly created link
+        *@note While the page content is read, the link view is created later, see CreatePendingViews()
+        */
+        virtual TSP_Link* CreateAndAddLink(const std::wstring& name,
+                                           const std::wstring& description,
+                                           const std::wstring& comments);
+
         /**
         * Creates a link and adds it in page
         *@param name - link name
@@ -156,7 +196,7 @@ class TSP_QmlPage : public TSP_Page
         * Removes a component
         *@param uid - component unique identifier to remove
         */
-        virtual void Remove(const std::string& uid);
+        virtual void Remove(TSP_Item::IUID uid);
 
         /**
         * Removes a component
@@ -164,6 +204,13 @@ class TSP_QmlPage : public TSP_Page
         */
         virtual void Remove(TSP_Component* pComponent);
 
+        /**
+        * Creates the views of the components read from the page source
+        *@note The page may be read from any thread, so its components are created without their views,
+        *      which are all created afterwards by this function, on the GUI thread
+        */
+        virtual void CreatePendingViews();
+
     protected:
         /**
         * Creates a new box view and adds it to the user interface
@@ -209,7 +256,17 @@ class TSP_QmlPage : public TSP_Page
         void RemoveComponentView(const QString& uid);
 
     private:
+        typedef std::vector<TSP_Item::IUID> IUIDs;
+
         TSP_QmlPageProxy* m_pProxy = nullptr;
+        IUIDs             m_PendingViews;
+        std::mutex        m_PendingMutex;
+
+        /**
+        * Adds a component whose view should be created later, see CreatePendingViews()
+        *@param pComponent - component read from the page source
+        */
+        void AddPendingView(const TSP_Component* pComponent);
 };
 
 //---------------------------------------------------------------------------
@@ -225,7 +282,7 @@ bool TSP_QmlPage::CreateBoxView(T* pBox, const QString& type, int x, int y, int
         return false;
 
     // get box unique identifier
-    const std::string uid = pBox->GetUID();
+    const QString uid = TSP_QmlProxy::UIDToQStr(pBox->GetUID());
 
     // define the box position type
     TSP_QmlPageProxy::IEBoxPosition boxPos = TSP_QmlPageProxy::IEBoxPosition::IE_BP_Default;
@@ -235,11 +292,11 @@ bool TSP_QmlPage::CreateBoxView(T* pBox, const QString& type, int x, int y, int
         boxPos = TSP_QmlPageProxy::IEBoxPosition::IE_BP_Custom;
 
     // notify page proxy that a new box should be added
-    if (!m_pProxy->AddBox(type, QString::fromStdString(uid), boxPos, x, y, width, height))
+    if (!m_pProxy->AddBox(type, uid, boxPos, x, y, width, height))
         return false;
 
     // get the newly added component proxy
-    TSP_QmlBoxProxy* pProxy = static_cast<TSP_QmlBoxProxy*>(TSP_QmlProxyDictionary::Instance()->GetProxy(uid));
+    TSP_QmlBoxProxy* pProxy = static_cast<TSP_QmlBoxProxy*>(TSP_QmlProxyDictionary::Instance()->GetProxy(uid.toStdString()));
 
     if (!pProxy)
         return false;
@@ -270,11 +327,11 @@ bool TSP_QmlPage::CreateLinkView(      T*                     pLink,
         return false;
 
     // get link unique identifier
-    const std::string uid = pLink->GetUID();
+    const QString uid = TSP_QmlProxy::UIDToQStr(pLink->GetUID());
 
     // notify page proxy that a new link should be added
     if (!m_pProxy->AddLink(type,
-                           QString::fromStdString(pLink->GetUID()),
+                           uid,
                            startUID,
                            startPos,
                            endUID,
@@ -286,7 +343,7 @@ bool TSP_QmlPage::CreateLinkView(      T*                     pLink,
         return false;
 
     // get the newly added component proxy
-    TSP_QmlLinkProxy* pProxy = static_cast<TSP_QmlLinkProxy*>(TSP_QmlProxyDictionary::Instance()->GetProxy(uid));
+    TSP_QmlLinkProxy* pProxy = static_cast<TSP_QmlLinkProxy*>(TSP_QmlProxyDictionary::Instance()->GetProxy(uid.toStdString()));
 
     if (!pProxy)
         return false;
@@ -31,6 +31,8 @@
 
 // core classes
 #include "Core\TSP_Page.h"
+#include "Core\TSP_LinkGraph.h"
+#include "Core\TSP_Journal.h"
 
 // qt classes
 #include "TSP_QmlPage.h"
@@ -60,6 +62,8 @@ void TSP_QmlPageProxy::setName(const QString& name)
 
     m_pPage->SetName(name.toStdWString());
 
+    TSP_Journal::SetName(m_pPage);
+
     emit nameChanged(name);
 }
 //---------------------------------------------------------------------------
@@ -143,8 +147,11 @@ QString TSP_QmlPageProxy::onAddLinkStart(const QString& fromUID, int position)
     if (!pLink)
         return "";
 
+    TSP_Journal::AddComponent(pLink);
+    TSP_Journal::SetLinkEnd(pLink, false);
+
     // get newly added link unique identifier
-    return QString::fromStdString(pLink->GetUID());
+    return TSP_QmlProxy::UIDToQStr(pLink->GetUID());
 }
 //---------------------------------------------------------------------------
 void TSP_QmlPageProxy::onLinkAdded(bool success)
@@ -152,7 +159,18 @@ void TSP_QmlPageProxy::onLinkAdded(bool success)
     m_LinkAdded = success;
 }
 //---------------------------------------------------------------------------
-void TSP_QmlPageProxy::onDeleteBox(const QString& uid)
+int TSP_QmlPageProxy::getLinkCount(const QString& uid) const
+{
+    if (uid.isEmpty())
+        return 0;
+
+    if (!m_pPage)
+        return 0;
+
+    return int(m_pPage->GetLinkGraph()->GetDegree(QStrToUID(uid)));
+}
+//---------------------------------------------------------------------------
+void TSP_QmlPageProxy::onDeleteBox(const QString& uid, bool deleteLinks)
 {
     if (uid.isEmpty())
         return;
@@ -160,8 +178,28 @@ void TSP_QmlPageProxy::onDeleteBox(const QString& uid)
     if (!m_pPage)
         return;
 
+    const TSP_Item::IUID itemUID = QStrToUID(uid);
+
+    // do delete the attached links?
+    if (deleteLinks)
+    {
+        TSP_LinkGraph::ILinks links;
+
+        // detach the box from the link graph, and get its links
+        m_pPage->GetLinkGraph()->RemoveBox(itemUID, &links);
+
+        // remove the links from page, their views are removed with them
+        for each (auto link in links)
+        {
+            TSP_Journal::RemoveComponent(m_pPage->Get(link));
+            m_pPage->Remove(link);
+        }
+    }
+
+    TSP_Journal::RemoveComponent(m_pPage->Get(itemUID));
+
     // remove the box from page
-    m_pPage->Remove(uid.toStdString());
+    m_pPage->Remove(itemUID);
 }
 //---------------------------------------------------------------------------
 void TSP_QmlPageProxy::onDeleteLink(const QString& uid)
@@ -172,7 +210,11 @@ void TSP_QmlPageProxy::onDeleteLink(const QString& uid)
     if (!m_pPage)
         return;
 
+    const TSP_Item::IUID itemUID = QStrToUID(uid);
+
+    TSP_Journal::RemoveComponent(m_pPage->Get(itemUID));
+
     // remove the link from page
-    m_pPage->Remove(uid.toStdString());
+    m_pPage->Remove(itemUID);
 }
 //---------------------------------------------------------------------------
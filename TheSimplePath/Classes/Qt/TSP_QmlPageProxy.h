@@ -223,11 +223,19 @@ class TSP_QmlPageProxy : public TSP_QmlProxy
         */
         virtual Q_INVOKABLE void onLinkAdded(bool success);
 
+        /**
+        * Gets the number of link ends attached to a box
+        *@param uid - box unique identifier
+        *@return the number of link ends attached to the box
+        */
+        virtual Q_INVOKABLE int getLinkCount(const QString& uid) const;
+
         /**
         * Notify that a box should be deleted
         *@param uid - box unique identifier to delete
+        *@param deleteLinks - if true, the links attached to the box will also be deleted
         */
-        virtual Q_INVOKABLE void onDeleteBox(const QString& uid);
+        virtual Q_INVOKABLE void onDeleteBox(const QString& uid, bool deleteLinks);
 
         /**
         * Notify that a link should be deleted
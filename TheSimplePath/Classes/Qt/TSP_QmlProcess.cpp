@@ -68,12 +68,12 @@ void TSP_QmlProcess::SetProxy(TSP_QmlBoxProxy* pProxy)
 //---------------------------------------------------------------------------
 TSP_Page* TSP_QmlProcess::CreatePage()
 {
-    return new TSP_QmlPage(this);
+    return new (m_pPageArena) TSP_QmlPage(this);
 }
 //---------------------------------------------------------------------------
 TSP_Page* TSP_QmlProcess::CreatePage(const std::wstring& name)
 {
-    return new TSP_QmlPage(name, this);
+    return new (m_pPageArena) TSP_QmlPage(name, this);
 }
 //---------------------------------------------------------------------------
 TSP_Page* TSP_QmlProcess::CreateAndAddPage()
@@ -102,6 +102,13 @@ TSP_Page* TSP_QmlProcess::CreateAndAddPage(const std::wstring& name)
 {
     M_TRY
     {
+        TSP_Page* pOwner = static_cast<TSP_Page*>(GetOwner());
+
+        // the process is read from its owner page source? Its view will be created later, with the
+        // views of its pages
+        if (!m_pProxy && pOwner && pOwner->IsReadingContent())
+            return TSP_PageContainer::CreateAndAddPage(name);
+
         if (!m_pProxy)
         {
             M_LogErrorT("Create and add page - FAILED - box proxy is missing");
@@ -151,7 +158,7 @@ void TSP_QmlProcess::RemovePage(std::size_t index)
             return;
 
         // notify box proxy that a page was removed
-        m_pProxy->RemoveItem("page", QString::fromStdString(pQmlPage->GetUID()));
+        m_pProxy->RemoveItem("page", TSP_QmlProxy::UIDToQStr(pQmlPage->GetUID()));
 
         // remove the page from document
         TSP_PageContainer::RemovePage(index);
@@ -177,7 +184,7 @@ void TSP_QmlProcess::RemovePage(TSP_Page* pPage)
             return;
 
         // notify box proxy that a page was removed
-        m_pProxy->RemoveItem("page", QString::fromStdString(pQmlPage->GetUID()));
+        m_pProxy->RemoveItem("page", TSP_QmlProxy::UIDToQStr(pQmlPage->GetUID()));
 
         // remove the page from document
         TSP_PageContainer::RemovePage(pPage);
@@ -185,6 +192,24 @@ void TSP_QmlProcess::RemovePage(TSP_Page* pPage)
     M_CATCH_LOG
 }
 //---------------------------------------------------------------------------
+bool TSP_QmlProcess::CreatePageViews()
+{
+    bool success = true;
+
+    for (std::size_t i = 0; i < GetPageCount(); ++i)
+    {
+        TSP_QmlPage* pQmlPage = static_cast<TSP_QmlPage*>(GetPage(i));
+
+        if (pQmlPage && !pQmlPage->GetProxy() && !CreatePageView(pQmlPage))
+        {
+            M_LogErrorT("Create page views - FAILED - page view could not be created");
+            success = false;
+        }
+    }
+
+    return success;
+}
+//---------------------------------------------------------------------------
 bool TSP_QmlProcess::CreatePageView(TSP_Page* pPage)
 {
     if (!m_pProxy)
@@ -197,14 +222,14 @@ bool TSP_QmlProcess::CreatePageView(TSP_Page* pPage)
         return false;
 
     // get page unique identifier
-    const std::string uid = pPage->GetUID();
+    const QString uid = TSP_QmlProxy::UIDToQStr(pPage->GetUID());
 
     // notify box proxy that a new page should be added
-    if (!m_pProxy->AddItem("page", QString::fromStdString(uid)))
+    if (!m_pProxy->AddItem("page", uid))
         return false;
 
     // get the newly added component proxy
-    TSP_QmlPageProxy* pProxy = static_cast<TSP_QmlPageProxy*>(TSP_QmlProxyDictionary::Instance()->GetProxy(uid));
+    TSP_QmlPageProxy* pProxy = static_cast<TSP_QmlPageProxy*>(TSP_QmlProxyDictionary::Instance()->GetProxy(uid.toStdString()));
 
     if (!pProxy)
         return false;
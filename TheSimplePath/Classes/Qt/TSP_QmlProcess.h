@@ -103,9 +103,18 @@ class TSP_QmlProcess : public TSP_Process
         * Creates a new child page and adds it in this page
         *@param name - page name
         *@return newly added page
+        *@note While the process is read from its owner page source, it still has no view, so the page
+        *      view is created afterwards, see CreatePageViews()
         */
         virtual TSP_Page* CreateAndAddPage(const std::wstring& name);
 
+        /**
+        * Creates the views of the pages which still have none
+        *@return true on success, otherwise false
+        *@note Called once the process view was created, for the pages added while it was read
+        */
+        virtual bool CreatePageViews();
+
         /**
         * Removes a page
         *@param index - page index to remove
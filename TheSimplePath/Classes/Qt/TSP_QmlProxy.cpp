@@ -57,3 +57,20 @@ void TSP_QmlProxy::setUID(const QString& uid)
     TSP_QmlProxyDictionary::Instance()->Register(m_UID, this);
 }
 //---------------------------------------------------------------------------
+QString TSP_QmlProxy::UIDToQStr(TSP_Item::IUID uid)
+{
+    return QString::number(uid);
+}
+//---------------------------------------------------------------------------
+TSP_Item::IUID TSP_QmlProxy::QStrToUID(const QString& uid)
+{
+    bool                 ok     = false;
+    const TSP_Item::IUID result = uid.toULongLong(&ok);
+
+    // 0 is never used by an item, thus it may be returned for an invalid identifier
+    if (!ok)
+        return 0;
+
+    return result;
+}
+//---------------------------------------------------------------------------
@@ -29,6 +29,9 @@
 
 #pragma once
 
+// core classes
+#include "Core/TSP_Item.h"
+
 // qt
 #include <QObject>
 
@@ -72,6 +75,20 @@ class TSP_QmlProxy : public QObject
 
         virtual ~TSP_QmlProxy();
 
+        /**
+        * Converts an item unique identifier to a string which may be used on the qml side
+        *@param uid - item unique identifier to convert
+        *@return converted unique identifier
+        */
+        static QString UIDToQStr(TSP_Item::IUID uid);
+
+        /**
+        * Converts a unique identifier received from the qml side to an item unique identifier
+        *@param uid - unique identifier to convert
+        *@return converted item unique identifier, null handle if invalid
+        */
+        static TSP_Item::IUID QStrToUID(const QString& uid);
+
     private:
         std::string m_UID;
 };
@@ -205,16 +205,16 @@ std::string TSP_QmlProxyDictionary::GetUID(void* pProxy) const
 #ifdef _DEBUG
     void TSP_QmlProxyDictionary::Log() const
     {
-        M_Log("Qml proxy dictionary - dictionary content");
+        M_LogCatDebug(Proxy, "Qml proxy dictionary - dictionary content");
 
         for (IDictionary::const_iterator it = m_Dictionary.begin(); it != m_Dictionary.end(); ++it)
-            M_Log("Item - first - " << it->first << " - second (uid) - "
+            M_LogCatDebug(Proxy, "Item - first - " << it->first << " - second (uid) - "
                     << static_cast<TSP_QmlProxy*>(it->second)->getUID().toStdString());
 
-        M_Log("Qml proxy dictionary - reverse dictionary content");
+        M_LogCatDebug(Proxy, "Qml proxy dictionary - reverse dictionary content");
 
         for (IReverseDictionary::const_iterator it = m_ReverseDictionary.begin(); it != m_ReverseDictionary.end(); ++it)
-            M_Log("Item - first (uid) - " << static_cast<TSP_QmlProxy*>(it->first)->getUID().toStdString()
+            M_LogCatDebug(Proxy, "Item - first (uid) - " << static_cast<TSP_QmlProxy*>(it->first)->getUID().toStdString()
                     << " - second - " << it->second);
     }
 #endif
@@ -28,6 +28,10 @@
 
 #include "TSP_Application.h"
 
+// std
+#include <algorithm>
+#include <chrono>
+
 // common classes
 #include "Common\TSP_Logger.h"
 
@@ -38,8 +42,11 @@
 #include "Qt\TSP_QmlAtlasProxy.h"
 
 // qt
+#include <QDir>
+#include <QFile>
 #include <QIcon>
 #include <QQmlContext>
+#include <QStandardPaths>
 #include <qwinfunctions.h>
 
 // windows
@@ -49,6 +56,11 @@
     #define REDIRECT_QML_LOGS_TO_LOGGER
 #endif
 
+//---------------------------------------------------------------------------
+// Static members
+//---------------------------------------------------------------------------
+TSP_Application::IQmlLogLimits TSP_Application::m_QmlLogLimits;
+std::mutex                     TSP_Application::m_QmlLogMutex;
 //---------------------------------------------------------------------------
 // TSP_Application
 //---------------------------------------------------------------------------
@@ -69,8 +81,24 @@ TSP_Application::~TSP_Application()
     if (m_pEngine)
         delete m_pEngine;
 
+    // the running save still uses the document journal
+    if (m_pMainFormModel)
+        m_pMainFormModel->WaitForSave();
+
     if (m_pDocument)
+    {
+        m_pDocument->SetJournal(nullptr);
         delete m_pDocument;
+    }
+
+    // the pending records are written before the journal is closed
+    if (m_pJournal)
+    {
+        delete m_pJournal;
+
+        // the session ended normally, so there is nothing to recover on the next start
+        QFile::remove(m_JournalFileName);
+    }
 
     if (m_pPageListModel)
         delete m_pPageListModel;
@@ -148,6 +176,9 @@ int TSP_Application::Execute()
 
     m_pEngine->load(url);
 
+    // the document views are created by the interface, so the journal may only be replayed once loaded
+    InitializeJournal();
+
     M_LogT("Execute - initialization terminated successfully - now application starts");
 
     return m_pApp->exec();
@@ -194,21 +225,141 @@ void TSP_Application::InitializeQt(int argc, char* argv[])
     #endif
 }
 //---------------------------------------------------------------------------
+void TSP_Application::InitializeJournal()
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+
+    if (dir.isEmpty() || !QDir().mkpath(dir))
+    {
+        M_LogWarnT("Initialize journal - no application data location, the modifications will not be recorded");
+        return;
+    }
+
+    const QString fileName          = dir + "/TheSimplePath.tspj";
+    const QString recoveredFileName = dir + "/TheSimplePath.recovered.tspj";
+
+    // the previous session journal remains if the application crashed, its modifications are replayed.
+    // NOTE the document should not be attached to the journal while replayed
+    if (QFile::exists(fileName))
+    {
+        // keep a copy aside, in case the modifications could not be replayed
+        QFile::remove(recoveredFileName);
+        QFile::copy(fileName, recoveredFileName);
+
+        if (TSP_Journal::Replay(fileName.toStdWString(), m_pDocument))
+        {
+            M_LogT("Initialize journal - unsaved modifications recovered - " << fileName.toStdWString());
+        }
+        else
+        {
+            // a partially replayed document would no longer match the journal records
+            if (m_pDocument->GetStatus() != TSP_Document::IEDocStatus::IE_DS_Closed)
+            {
+                M_LogWarnT("Initialize journal - could not recover the modifications, journal kept - " << recoveredFileName.toStdWString());
+                m_pDocument->Close();
+            }
+
+            QFile::remove(fileName);
+        }
+    }
+
+    m_pJournal = new TSP_Journal();
+
+    if (!m_pJournal->Open(fileName.toStdWString()))
+    {
+        M_LogWarnT("Initialize journal - could not open the journal, the modifications will not be recorded");
+        delete m_pJournal;
+        m_pJournal = nullptr;
+        return;
+    }
+
+    m_JournalFileName = fileName;
+    m_pDocument->SetJournal(m_pJournal);
+}
+//---------------------------------------------------------------------------
 void TSP_Application::RedirectQmlLogs(QtMsgType type, const QMessageLogContext& context, const QString& msg)
 {
+    TSP_Logger::IELevel level;
+
+    switch (type)
+    {
+        case QtDebugMsg:    level = TSP_Logger::IELevel::IE_L_Debug;   break;
+        case QtInfoMsg:     level = TSP_Logger::IELevel::IE_L_Info;    break;
+        case QtWarningMsg:  level = TSP_Logger::IELevel::IE_L_Warning; break;
+        case QtCriticalMsg:
+        case QtFatalMsg:    level = TSP_Logger::IELevel::IE_L_Error;   break;
+        default:            level = TSP_Logger::IELevel::IE_L_Info;    break;
+    }
+
+    // the message is dropped before being formatted if its level is not logged
+    if (int(level) < M_LogMinLevel || !TSP_Logger::IsEnabled(TSP_Logger::IECategory::IE_C_Qml, level))
+        return;
+
+    const char*       pCategory  = context.category ? context.category : "";
+          std::size_t suppressed = 0;
+
+    // bulk operations may log a message per item, which would spend more time to format the logs than
+    // to process the items. The warnings and errors are always logged, as a fatal message is the last
+    // one logged before the application aborts
+    if (level < TSP_Logger::IELevel::IE_L_Warning && !CanLogQml(pCategory, suppressed))
+        return;
+
+    if (suppressed)
+        M_LogCatWarnT(Qml, "Qml - " << suppressed << " messages were suppressed - category - " << pCategory);
+
     const std::wstring message = msg.toStdWString();
     const std::string  file(context.file     ? context.file     : "");
     const std::string  func(context.function ? context.function : "");
 
     // redirect qml log to application log
-    switch (type)
+    switch (level)
     {
-        case QtDebugMsg:
-        case QtInfoMsg:     M_LogT     ("Qml - " << message << " - " << file << ":" << context.line << ", " << func); break;
-        case QtWarningMsg:  M_LogWarnT ("Qml - " << message << " - " << file << ":" << context.line << ", " << func); break;
-        case QtCriticalMsg:
-        case QtFatalMsg:    M_LogErrorT("Qml - " << message << " - " << file << ":" << context.line << ", " << func); break;
-        default:            M_LogT     ("Qml - " << message << " - " << file << ":" << context.line << ", " << func); break;
+        case TSP_Logger::IELevel::IE_L_Debug:   M_LogCatDebugT(Qml, "Qml - " << message << " - " << file << ":" << context.line << ", " << func); break;
+        case TSP_Logger::IELevel::IE_L_Warning: M_LogCatWarnT (Qml, "Qml - " << message << " - " << file << ":" << context.line << ", " << func); break;
+        case TSP_Logger::IELevel::IE_L_Error:   M_LogCatErrorT(Qml, "Qml - " << message << " - " << file << ":" << context.line << ", " << func); break;
+        default:                                M_LogCatT     (Qml, "Qml - " << message << " - " << file << ":" << context.line << ", " << func); break;
     }
 }
 //---------------------------------------------------------------------------
+bool TSP_Application::CanLogQml(const char* pCategory, std::size_t& suppressed)
+{
+    const std::int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>
+            (std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    // lock up the thread
+    std::unique_lock<std::mutex> lock(m_QmlLogMutex);
+
+    IQmlLogLimits::iterator it = std::find_if(m_QmlLogLimits.begin(), m_QmlLogLimits.end(),
+            [pCategory](const IQmlLogLimit& limit)
+            {
+                return limit.m_Category == pCategory;
+            });
+
+    // first message of the category?
+    if (it == m_QmlLogLimits.end())
+    {
+        IQmlLogLimit limit;
+        limit.m_Category = pCategory;
+        limit.m_Tokens   = double(m_QmlLogBurst);
+        limit.m_Time     = now;
+
+        it = m_QmlLogLimits.insert(m_QmlLogLimits.end(), limit);
+    }
+
+    // refill the tokens since the previous message
+    it->m_Tokens = std::min(double(m_QmlLogBurst), it->m_Tokens + double(now - it->m_Time) * double(m_QmlLogRate) / 1000.0);
+    it->m_Time   = now;
+
+    if (it->m_Tokens < 1.0)
+    {
+        ++it->m_Suppressed;
+        return false;
+    }
+
+    it->m_Tokens     -= 1.0;
+    suppressed        = it->m_Suppressed;
+    it->m_Suppressed  = 0;
+
+    return true;
+}
+//---------------------------------------------------------------------------
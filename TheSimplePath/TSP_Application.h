@@ -29,12 +29,19 @@
 #pragma once
 
 // std
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <vector>
 
 // qt
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 
+// core classes
+#include "Core\TSP_Journal.h"
+
 // qt classes
 #include "Qt\TSP_QmlDocument.h"
 
@@ -102,11 +109,33 @@ class TSP_Application
         virtual int Execute();
 
     private:
+        /**
+        * Qml log rate limit of a logging category, the messages are only logged while the category
+        * has remaining tokens, which are refilled over time
+        */
+        struct IQmlLogLimit
+        {
+            std::string  m_Category;
+            double       m_Tokens     = 0.0;
+            std::int64_t m_Time       = 0; // last refill time, in milliseconds
+            std::size_t  m_Suppressed = 0;
+        };
+
+        typedef std::vector<IQmlLogLimit> IQmlLogLimits;
+
+        static const std::size_t m_QmlLogRate  = 20;  // messages per second
+        static const std::size_t m_QmlLogBurst = 100; // max messages logged at once
+
+        static IQmlLogLimits m_QmlLogLimits;
+        static std::mutex    m_QmlLogMutex;
+
         QGuiApplication*       m_pApp           = nullptr;
         QQmlApplicationEngine* m_pEngine        = nullptr;
         TSP_QmlDocument*       m_pDocument      = nullptr;
         TSP_MainFormModel*     m_pMainFormModel = nullptr;
         TSP_PageListModel*     m_pPageListModel = nullptr;
+        TSP_Journal*           m_pJournal       = nullptr;
+        QString                m_JournalFileName;
         std::wstring           m_URL;
         int                    m_IconID         = 0;
 
@@ -117,8 +146,26 @@ class TSP_Application
         */
         void InitializeQt(int argc, char* argv[]);
 
+        /**
+        * Opens the journal recording the document modifications
+        *@note The journal left by the previous session, i.e. if the application crashed, is replayed on
+        *      the document, which is then recorded further by the same journal. A copy of it is kept
+        *      aside, in case its modifications could not be recovered
+        */
+        void InitializeJournal();
+
         /**
         * Redirects qml logs to application logger
+        *@note The messages are dropped before being formatted if the qml category level is disabled,
+        *      or, for the debug and info messages, if their logging category exceeded its rate limit
         */
         static void RedirectQmlLogs(QtMsgType type, const QMessageLogContext& context, const QString& msg);
+
+        /**
+        * Checks if a qml message may be logged, according to the rate limit of its logging category
+        *@param pCategory - qml logging category
+        *@param[out] suppressed - number of messages suppressed in the category since the last logged one
+        *@return true if the message may be logged, otherwise false
+        */
+        static bool CanLogQml(const char* pCategory, std::size_t& suppressed);
 };
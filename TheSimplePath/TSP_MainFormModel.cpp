@@ -31,6 +31,10 @@
 // common classes
 #include "Common/TSP_GlobalMacros.h"
 
+// core classes
+#include "Core/TSP_Process.h"
+#include "Core/TSP_Journal.h"
+
 // qt classes
 #include "Qt/TSP_QmlDocument.h"
 #include "Qt/TSP_QmlAtlas.h"
@@ -42,6 +46,7 @@
 
 // qt
 #include <QSize>
+#include <QUrl>
 
 // windows
 #include <windows.h>
@@ -52,10 +57,16 @@
 TSP_MainFormModel::TSP_MainFormModel(TSP_Application* pApp, QObject* pParent) :
     QObject(pParent),
     m_pApp(pApp)
-{}
+{
+    // the save progress is polled from the gui thread, so the signals reach qml safely
+    m_SaveTimer.setInterval(50);
+    connect(&m_SaveTimer, &QTimer::timeout, this, &TSP_MainFormModel::OnSaveTimer);
+}
 //---------------------------------------------------------------------------
 TSP_MainFormModel::~TSP_MainFormModel()
-{}
+{
+    WaitForSave();
+}
 //---------------------------------------------------------------------------
 int TSP_MainFormModel::getPageWidth() const
 {
@@ -145,12 +156,59 @@ void TSP_MainFormModel::onCloseDocumentClicked()
             return;
         }
 
+        // the document can't be closed while it is saved
+        WaitForSave();
+
         // close the document
         pDoc->Close();
     }
     M_CATCH_QT_MSG
 }
 //---------------------------------------------------------------------------
+void TSP_MainFormModel::onSaveDocumentClicked(const QString& fileName)
+{
+    M_TRY
+    {
+        // get document
+        TSP_QmlDocument* pDoc = GetDocument();
+
+        // no document?
+        if (!pDoc)
+        {
+            M_LogErrorT("onSaveDocumentClicked - FAILED - no document defined");
+            emit saveFinished(false, fileName);
+            return;
+        }
+
+        // the file dialogs select the file as an url
+        const QUrl url(fileName);
+
+        // start to save the document
+        if (!m_Saver.Start(pDoc, (url.isLocalFile() ? url.toLocalFile() : fileName).toStdWString()))
+        {
+            //: Save document error dialog title
+            //% "Save document"
+            const QString title = qtTrId("id-error-save-doc-title");
+
+            //: Save document error dialog message
+            //% "Failed to save the document."
+            const QString msg = qtTrId("id-error-save-doc-msg");
+
+            showError(title, msg);
+            emit saveFinished(false, fileName);
+            return;
+        }
+
+        // the modifications done from now will be saved the next time
+        pDoc->ClearModified();
+
+        emit saveProgress(0.0);
+
+        m_SaveTimer.start();
+    }
+    M_CATCH_QT_MSG
+}
+//---------------------------------------------------------------------------
 void TSP_MainFormModel::onAddBoxClicked()
 {
     M_TRY
@@ -170,7 +228,9 @@ void TSP_MainFormModel::onAddBoxClicked()
         const QString defProcessTitle = qtTrId("id-new-box-title");
 
         // add box
-        if (!pSelectedPage->CreateAndAddBox(defProcessTitle.toStdWString()))
+        TSP_Box* pBox = pSelectedPage->CreateAndAddBox(defProcessTitle.toStdWString());
+
+        if (!pBox)
         {
             //: Create box error dialog title
             //% "Create new box"
@@ -181,7 +241,10 @@ void TSP_MainFormModel::onAddBoxClicked()
             const QString msg = qtTrId("id-error-create-box-msg");
 
             showError(title, msg);
+            return;
         }
+
+        TSP_Journal::AddComponent(pBox);
     }
     M_CATCH_QT_MSG
 }
@@ -206,7 +269,9 @@ void TSP_MainFormModel::onAddProcessClicked()
         const QString defProcessTitle = qtTrId("id-new-process-title");
 
         // add process
-        if (!pSelectedPage->CreateAndAddProcess(defProcessTitle.toStdWString()))
+        TSP_Process* pProcess = pSelectedPage->CreateAndAddProcess(defProcessTitle.toStdWString());
+
+        if (!pProcess)
         {
             //: Create process error dialog title
             //% "Create new process"
@@ -217,7 +282,86 @@ void TSP_MainFormModel::onAddProcessClicked()
             const QString msg = qtTrId("id-error-create-process-msg");
 
             showError(title, msg);
+            return;
         }
+
+        TSP_Journal::AddComponent(pProcess);
+
+        // the process page is created with the process, but should be replayed as a separate operation
+        for (std::size_t i = 0; i < pProcess->GetPageCount(); ++i)
+            TSP_Journal::AddPage(pProcess->GetPage(i));
+    }
+    M_CATCH_QT_MSG
+}
+//---------------------------------------------------------------------------
+void TSP_MainFormModel::WaitForSave()
+{
+    // no running save?
+    if (!m_SaveTimer.isActive())
+        return;
+
+    // end the save and notify the result
+    m_Saver.Wait();
+    OnSaveTimer();
+}
+//---------------------------------------------------------------------------
+void TSP_MainFormModel::OnSaveTimer()
+{
+    M_TRY
+    {
+        switch (m_Saver.GetState())
+        {
+            case TSP_DocumentSaver::IEState::IE_S_Saving:
+                emit saveProgress(m_Saver.GetProgress());
+                return;
+
+            case TSP_DocumentSaver::IEState::IE_S_Saved:
+            case TSP_DocumentSaver::IEState::IE_S_Failed:
+                break;
+
+            default:
+                m_SaveTimer.stop();
+                return;
+        }
+
+        m_SaveTimer.stop();
+
+        // release the save thread and its snapshot
+        const bool    success  = m_Saver.Wait();
+        const QString fileName = QString::fromStdWString(m_Saver.GetFileName());
+
+        // notify the document, so its next save may only append its modifications to the file
+        TSP_QmlDocument* pDoc = GetDocument();
+
+        if (pDoc)
+        {
+            if (success)
+                pDoc->NotifySaved(m_Saver.GetFileName(), m_Saver.GetPageHandles());
+            else
+                pDoc->NotifySaveFailed();
+        }
+
+        if (success)
+        {
+            M_LogT(L"Document saved - " << m_Saver.GetFileName());
+            emit saveProgress(1.0);
+        }
+        else
+        {
+            M_LogErrorT(L"Save document - FAILED - " << m_Saver.GetFileName());
+
+            //: Save document error dialog title
+            //% "Save document"
+            const QString title = qtTrId("id-error-save-doc-title");
+
+            //: Save document error dialog message
+            //% "Failed to save the document."
+            const QString msg = qtTrId("id-error-save-doc-msg");
+
+            showError(title, msg, fileName);
+        }
+
+        emit saveFinished(success, fileName);
     }
     M_CATCH_QT_MSG
 }
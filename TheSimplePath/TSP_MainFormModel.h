@@ -34,6 +34,10 @@
 // qt
 #include <QObject>
 #include <QPageSize>
+#include <QTimer>
+
+// core classes
+#include "Core/TSP_DocumentSaver.h"
 
 // class prototypes
 class TSP_Application;
@@ -58,6 +62,19 @@ class TSP_MainFormModel : public QObject
         */
         void showErrorDialog(const QString& title, const QString& msg, const QString& detailedMsg);
 
+        /**
+        * Called while the document is saved
+        *@param progress - save progress, between 0.0 and 1.0
+        */
+        void saveProgress(double progress);
+
+        /**
+        * Called when the document save ended
+        *@param success - if true, the document was saved
+        *@param fileName - saved file name
+        */
+        void saveFinished(bool success, const QString& fileName);
+
     public:
         /**
         * Constructor
@@ -98,6 +115,13 @@ class TSP_MainFormModel : public QObject
         */
         virtual Q_INVOKABLE void onCloseDocumentClicked();
 
+        /**
+        * Called when the save document button was clicked on the user interface
+        *@param fileName - file name or local file url to save to
+        *@note The document is saved in background, see saveProgress() and saveFinished()
+        */
+        virtual Q_INVOKABLE void onSaveDocumentClicked(const QString& fileName);
+
         /**
         * Called when the add process button was clicked on the user interface
         */
@@ -108,9 +132,22 @@ class TSP_MainFormModel : public QObject
         */
         virtual Q_INVOKABLE void onAddProcessClicked();
 
+        /**
+        * Waits until the running document save ends
+        *@note Should be called before the document is deleted
+        */
+        virtual void WaitForSave();
+
     private:
-        TSP_Application* m_pApp      = nullptr;
-        QPageSize        m_PageSize;
+        TSP_Application*  m_pApp      = nullptr;
+        QPageSize         m_PageSize;
+        TSP_DocumentSaver m_Saver;
+        QTimer            m_SaveTimer;
+
+        /**
+        * Called while the document is saved
+        */
+        void OnSaveTimer();
 
         /**
         * Get document
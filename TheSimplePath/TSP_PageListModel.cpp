@@ -35,6 +35,9 @@
 #include "Common/TSP_Exception.h"
 #include "Common/TSP_GlobalMacros.h"
 
+// core classes
+#include "Core/TSP_Journal.h"
+
 // qt classes
 #include "Qt/TSP_QmlDocument.h"
 #include "Qt/TSP_QmlAtlas.h"
@@ -70,7 +73,7 @@ QString TSP_PageListModel::queryPageOwnerUID() const
     if (!m_pPageOwner)
         return QString();
 
-    return QString::fromStdString(m_pPageOwner->GetUID());
+    return TSP_QmlProxy::UIDToQStr(m_pPageOwner->GetUID());
 }
 //---------------------------------------------------------------------------
 void TSP_PageListModel::onAddPageClicked()
@@ -162,7 +165,7 @@ bool TSP_PageListModel::addPage()
     }
 
     // get page owner as atlas
-    TSP_QmlAtlas* pQmlAtlas = dynamic_cast<TSP_QmlAtlas*>(m_pPageOwner);
+    TSP_QmlAtlas* pQmlAtlas = GetOwnerAtlas();
 
     // succeeded?
     if (pQmlAtlas)
@@ -183,6 +186,8 @@ bool TSP_PageListModel::addPage()
 
         endInsertRows();
 
+        TSP_Journal::AddPage(pQmlPage);
+
         return true;
     }
 
@@ -219,7 +224,7 @@ bool TSP_PageListModel::deletePage()
     }
 
     // get page owner as atlas
-    TSP_QmlAtlas* pQmlAtlas = dynamic_cast<TSP_QmlAtlas*>(m_pPageOwner);
+    TSP_QmlAtlas* pQmlAtlas = GetOwnerAtlas();
 
     // succeeded?
     if (pQmlAtlas)
@@ -232,6 +237,8 @@ bool TSP_PageListModel::deletePage()
 
         beginRemoveRows(QModelIndex(), m_SelectedPageItem, m_SelectedPageItem);
 
+        TSP_Journal::RemovePage(pQmlAtlas->GetPage(m_SelectedPageItem));
+
         // remove the selected page from the selected atlas
         pQmlAtlas->RemovePage(m_SelectedPageItem);
 
@@ -269,7 +276,7 @@ TSP_Page* TSP_PageListModel::GetPage(int index) const
         return nullptr;
 
     // get page owner as atlas
-    TSP_QmlAtlas* pQmlAtlas = dynamic_cast<TSP_QmlAtlas*>(m_pPageOwner);
+    TSP_QmlAtlas* pQmlAtlas = GetOwnerAtlas();
 
     // found it?
     if (pQmlAtlas)
@@ -318,7 +325,7 @@ QString TSP_PageListModel::GetSelectedPageUID() const
         return QString();
 
     // return page unique identifier
-    return QString::fromStdString(pPage->GetUID());
+    return TSP_QmlProxy::UIDToQStr(pPage->GetUID());
 }
 //---------------------------------------------------------------------------
 void TSP_PageListModel::onPageSelected(int index)
@@ -352,7 +359,7 @@ int TSP_PageListModel::rowCount(const QModelIndex& pParent) const
         return 0;
 
     // get page owner as atlas
-    TSP_QmlAtlas* pQmlAtlas = dynamic_cast<TSP_QmlAtlas*>(m_pPageOwner);
+    TSP_QmlAtlas* pQmlAtlas = GetOwnerAtlas();
 
     // found it?
     if (pQmlAtlas)
@@ -394,6 +401,19 @@ TSP_QmlDocument* TSP_PageListModel::GetDocument() const
     return m_pApp->GetDocument();
 }
 //---------------------------------------------------------------------------
+TSP_QmlAtlas* TSP_PageListModel::GetOwnerAtlas() const
+{
+    if (!m_pPageOwner)
+        return nullptr;
+
+    // check the owner type tag, this function is called by the view on each refresh
+    switch (m_pPageOwner->GetType())
+    {
+        case TSP_Item::IEType::IE_T_Atlas: return static_cast<TSP_QmlAtlas*>(m_pPageOwner);
+        default:                           return nullptr;
+    }
+}
+//---------------------------------------------------------------------------
 void TSP_PageListModel::ShowError(const QString& title, const QString& msg)
 {
     // no application?
@@ -39,6 +39,7 @@
 // class prototype
 class TSP_Application;
 class TSP_QmlDocument;
+class TSP_QmlAtlas;
 
 /**
 * Page list model
@@ -194,6 +195,12 @@ class TSP_PageListModel : public QAbstractListModel
         */
         TSP_QmlDocument* GetDocument() const;
 
+        /**
+        * Gets the page owner as atlas
+        *@return the page owner as atlas, nullptr if the page owner isn't an atlas
+        */
+        TSP_QmlAtlas* GetOwnerAtlas() const;
+
         /**
         * Shows an error message to user
         *@param title - error title
@@ -0,0 +1,295 @@
+/****************************************************************************
+ * ==> TSP_BinaryDocumentTest ----------------------------------------------*
+ ****************************************************************************
+ * Description:  Binary document round trip tests                           *
+ * Contained in: Tests                                                      *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// core classes
+#include "Core\TSP_Document.h"
+#include "Core\TSP_Atlas.h"
+#include "Core\TSP_Box.h"
+#include "Core\TSP_Link.h"
+#include "Core\TSP_Process.h"
+
+// tests
+#include "TSP_Test.h"
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+const wchar_t* g_BinaryFileName  = L"TSP_BinaryDocumentTest.tspb";
+const wchar_t* g_BinaryCopyName  = L"TSP_BinaryDocumentTest_Copy.tspb";
+const wchar_t* g_BinaryJsonName  = L"TSP_BinaryDocumentTest.json";
+const char*    g_BinaryFileNameA =  "TSP_BinaryDocumentTest.tspb";
+const char*    g_BinaryCopyNameA =  "TSP_BinaryDocumentTest_Copy.tspb";
+const char*    g_BinaryJsonNameA =  "TSP_BinaryDocumentTest.json";
+//---------------------------------------------------------------------------
+// TSP_BinaryTestDocument
+//---------------------------------------------------------------------------
+/**
+* Document without user interface
+*/
+class TSP_BinaryTestDocument : public TSP_Document
+{
+    public:
+        virtual bool Create()
+        {
+            return true;
+        }
+};
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Reads a whole file
+*@param pFileName - file name
+*@return the file content, empty if the file could not be read
+*/
+static std::string ReadBinaryTestFile(const char* pFileName)
+{
+    std::FILE* pFile = std::fopen(pFileName, "rb");
+
+    if (!pFile)
+        return std::string();
+
+    std::string content;
+    char        buffer[4096];
+
+    while (const std::size_t read = std::fread(buffer, 1, sizeof(buffer), pFile))
+        content.append(buffer, read);
+
+    std::fclose(pFile);
+
+    return content;
+}
+//---------------------------------------------------------------------------
+/**
+* Writes a whole file
+*@param pFileName - file name
+*@param content - file content
+*/
+static void WriteBinaryTestFile(const char* pFileName, const std::string& content)
+{
+    std::FILE* pFile = std::fopen(pFileName, "wb");
+
+    if (!pFile)
+        return;
+
+    std::fwrite(content.data(), 1, content.length(), pFile);
+    std::fclose(pFile);
+}
+//---------------------------------------------------------------------------
+/**
+* Fills a document with all the item types and attribute formats
+*@param document - document to fill
+*/
+static void FillBinaryTestDocument(TSP_Document& document)
+{
+    document.SetTitle(L"Binary \"document\" \x00E9\x20AC");
+
+    TSP_Atlas* pAtlas = document.CreateAndAddAtlas(L"Atlas");
+    TSP_Page*  pPage  = pAtlas->CreateAndAddPage(L"Page");
+    TSP_Box*   pStart = pPage->CreateAndAddBox(L"Start", L"Multi\nline", L"");
+    TSP_Box*   pEnd   = pPage->CreateAndAddActivity(L"End", L"", L"Comments");
+    TSP_Link*  pLink  = pPage->CreateAndAddLink(L"Link", L"", L"");
+
+    pPage->CreateAndAddMessage(L"Message", L"", L"");
+    pPage->GetLinkGraph()->SetStart(pLink->GetUID(), pStart->GetUID(), TSP_LinkGraph::IESide::IE_S_Right);
+    pPage->GetLinkGraph()->SetEnd  (pLink->GetUID(), pEnd->GetUID(),   TSP_LinkGraph::IESide::IE_S_Left);
+
+    std::tm startDate = {};
+    startDate.tm_year = 124;
+    startDate.tm_mon  = 2;
+    startDate.tm_mday = 5;
+    startDate.tm_hour = 7;
+
+    TSP_Attribute cost;
+    cost.SetFormula(L"duration * resources");
+
+    pStart->SetAttribute(TSP_Attribute::IEKey::IE_K_Duration,  TSP_Attribute(2.5));
+    pStart->SetAttribute(TSP_Attribute::IEKey::IE_K_Owner,     TSP_Attribute(std::wstring(L"J\x00E9" L"an")));
+    pStart->SetAttribute(TSP_Attribute::IEKey::IE_K_Resources, TSP_Attribute(std::uint32_t(4)));
+    pStart->SetAttribute(TSP_Attribute::IEKey::IE_K_StartDate, TSP_Attribute(startDate));
+    pStart->SetAttribute(TSP_Attribute::IEKey::IE_K_Cost,      cost);
+    pEnd->SetAttribute  (TSP_Attribute::IEKey::IE_K_Frequency, TSP_Attribute(std::int32_t(-3)));
+
+    TSP_Process* pProcess = pPage->CreateAndAddProcess(L"Process", L"", L"");
+    TSP_Page*    pSubPage = pProcess->CreateAndAddPage(L"Sub page");
+
+    pSubPage->CreateAndAddBox(L"Inner", L"", L"")->SetAttribute(TSP_Attribute::IEKey::IE_K_Duration, TSP_Attribute(5.0));
+
+    TSP_Attribute sum;
+    sum.SetFormula(L"sum(duration) * 2");
+
+    pProcess->SetAttribute(TSP_Attribute::IEKey::IE_K_Cost, sum);
+
+    // enough pages and components to be read lazily, and in parallel
+    TSP_Page* pLargePage = pAtlas->CreateAndAddPage(L"Large page");
+
+    for (std::size_t i = 0; i < 500; ++i)
+        pLargePage->CreateAndAddBox(L"Box " + std::to_wstring(i), L"", L"")->SetAttribute(TSP_Attribute::IEKey::IE_K_Duration,
+                                                                                           TSP_Attribute(double(i)));
+
+    document.CreateAndAddAtlas(L"Empty atlas");
+}
+//---------------------------------------------------------------------------
+// Tests
+//---------------------------------------------------------------------------
+M_Test(BinaryDocument_RoundTrip)
+{
+    TSP_BinaryTestDocument source;
+    FillBinaryTestDocument(source);
+
+    M_Check(source.Save(g_BinaryFileName));
+
+    TSP_BinaryTestDocument document;
+
+    if (!M_Check(document.Load(g_BinaryFileName)))
+        return;
+
+    M_Check(document.GetStatus()     == TSP_Document::IEDocStatus::IE_DS_Opened);
+    M_Check(document.GetTitle()      == source.GetTitle());
+    M_Check(document.GetAtlasCount() == 2);
+
+    TSP_Atlas* pAtlas = document.GetAtlas(0);
+
+    if (!M_Check(pAtlas && pAtlas->GetPageCount() == 2))
+        return;
+
+    TSP_Page* pPage = pAtlas->GetPage(0);
+
+    M_Check(pPage->GetName()  == L"Page");
+    M_Check(pPage->GetCount() == 5);
+
+    TSP_Component* pStart   = pPage->GetOf(TSP_Item::IEType::IE_T_Box,      0);
+    TSP_Component* pEnd     = pPage->GetOf(TSP_Item::IEType::IE_T_Activity, 0);
+    TSP_Component* pLink    = pPage->GetOf(TSP_Item::IEType::IE_T_Link,     0);
+    TSP_Component* pProcess = pPage->GetOf(TSP_Item::IEType::IE_T_Process,  0);
+
+    if (!M_Check(pStart && pEnd && pLink && pProcess))
+        return;
+
+    M_Check(pStart->GetTitle()       == L"Start");
+    M_Check(pStart->GetDescription() == L"Multi\nline");
+    M_Check(pEnd->GetComments()      == L"Comments");
+
+    // the link ends are restored on the restored boxes
+    TSP_Item::IUID        box  = 0;
+    TSP_LinkGraph::IESide side = TSP_LinkGraph::IESide::IE_S_None;
+
+    M_Check(pPage->GetLinkGraph()->GetStart(pLink->GetUID(), box, side) && box == pStart->GetUID() &&
+            side == TSP_LinkGraph::IESide::IE_S_Right);
+    M_Check(pPage->GetLinkGraph()->GetEnd(pLink->GetUID(), box, side) && box == pEnd->GetUID() &&
+            side == TSP_LinkGraph::IESide::IE_S_Left);
+
+    // all the attribute formats, and the formulas which remain calculated
+    M_Check(pStart->GetAttribute(TSP_Attribute::IEKey::IE_K_Duration).Get(0.0)                == 2.5);
+    M_Check(pStart->GetAttribute(TSP_Attribute::IEKey::IE_K_Owner).Get(std::wstring())        == L"J\x00E9" L"an");
+    M_Check(pStart->GetAttribute(TSP_Attribute::IEKey::IE_K_Resources).Get(std::uint32_t(0))  == 4);
+    M_Check(pStart->GetAttribute(TSP_Attribute::IEKey::IE_K_StartDate).Get(std::tm()).tm_hour == 7);
+    M_Check(pEnd->GetAttribute(TSP_Attribute::IEKey::IE_K_Frequency).Get(std::int32_t(0))     == -3);
+    M_Check(pStart->GetFormula(TSP_Attribute::IEKey::IE_K_Cost)                               == L"duration * resources");
+    M_Check(pStart->GetAttribute(TSP_Attribute::IEKey::IE_K_Cost).Get(0.0)                    == 10.0);
+    M_Check(pProcess->GetAttribute(TSP_Attribute::IEKey::IE_K_Cost).Get(0.0)                  == 10.0);
+
+    pStart->SetAttribute(TSP_Attribute::IEKey::IE_K_Duration, TSP_Attribute(3.0));
+    M_Check(pStart->GetAttribute(TSP_Attribute::IEKey::IE_K_Cost).Get(0.0) == 12.0);
+
+    // the lazily read pages
+    M_Check(document.ReadAllPages());
+    M_Check(pAtlas->GetPage(1)->GetCount() == 500);
+    M_Check(document.Aggregate(TSP_Attribute::IEKey::IE_K_Duration).m_Sum ==
+            source.Aggregate(TSP_Attribute::IEKey::IE_K_Duration).m_Sum + 0.5);
+
+    std::remove(g_BinaryFileNameA);
+}
+//---------------------------------------------------------------------------
+M_Test(BinaryDocument_JsonRoundTrip)
+{
+    TSP_BinaryTestDocument source;
+    FillBinaryTestDocument(source);
+
+    // json -> binary -> binary copy, the copy should be identical
+    M_Check(source.Save(g_BinaryJsonName));
+
+    TSP_BinaryTestDocument fromJson;
+    M_Check(fromJson.Load(g_BinaryJsonName));
+    M_Check(fromJson.Save(g_BinaryFileName));
+
+    TSP_BinaryTestDocument fromBinary;
+    M_Check(fromBinary.Load(g_BinaryFileName));
+    M_Check(fromBinary.Save(g_BinaryCopyName));
+
+    const std::string binary = ReadBinaryTestFile(g_BinaryFileNameA);
+
+    M_Check(!binary.empty());
+    M_Check(binary == ReadBinaryTestFile(g_BinaryCopyNameA));
+
+    // the document still opened from the file may overwrite it
+    M_Check(fromBinary.Save(g_BinaryFileName));
+
+    TSP_BinaryTestDocument overwritten;
+    M_Check(overwritten.Load(g_BinaryFileName));
+    M_Check(overwritten.ReadAllPages());
+    M_Check(overwritten.Aggregate(TSP_Attribute::IEKey::IE_K_Duration).m_Sum ==
+            source.Aggregate(TSP_Attribute::IEKey::IE_K_Duration).m_Sum);
+
+    std::remove(g_BinaryFileNameA);
+    std::remove(g_BinaryCopyNameA);
+    std::remove(g_BinaryJsonNameA);
+}
+//---------------------------------------------------------------------------
+M_Test(BinaryDocument_Truncated)
+{
+    TSP_BinaryTestDocument source;
+    FillBinaryTestDocument(source);
+
+    M_Check(source.Save(g_BinaryFileName));
+
+    const std::string content = ReadBinaryTestFile(g_BinaryFileNameA);
+
+    if (!M_Check(content.length() > 64))
+        return;
+
+    // a truncated file should be rejected, not partially loaded
+    WriteBinaryTestFile(g_BinaryFileNameA, content.substr(0, content.length() - 10));
+
+    TSP_BinaryTestDocument document;
+    M_Check(!document.Load(g_BinaryFileName));
+    M_Check(document.GetStatus() == TSP_Document::IEDocStatus::IE_DS_Error);
+
+    std::remove(g_BinaryFileNameA);
+
+    TSP_BinaryTestDocument missing;
+    M_Check(!missing.Load(g_BinaryFileName));
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,195 @@
+/****************************************************************************
+ * ==> TSP_CaseMappingTest -------------------------------------------------*
+ ****************************************************************************
+ * Description:  Case mapping and folding tests, for each instruction set   *
+ * Contained in: Tests                                                      *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <string>
+
+// common classes
+#include "Common\TSP_StringHelper.h"
+
+// tests
+#include "TSP_Test.h"
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+// ASCII, latin, greek and cyrillic chars
+const wchar_t g_CaseMappingUpper[] = L"THE QUICK FOX 123 \x00C9\x00C7\x00C0 \x0391\x0392\x03A3 \x0416\x0419\x0401";
+const wchar_t g_CaseMappingLower[] = L"the quick fox 123 \x00E9\x00E7\x00E0 \x03B1\x03B2\x03C3 \x0436\x0439\x0451";
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Repeats a text, long enough to be converted by blocks
+*@param text - text to repeat
+*@return the repeated text
+*/
+template <class T>
+static std::basic_string<T> RepeatCaseMappingTestText(const std::basic_string<T>& text)
+{
+    std::basic_string<T> result;
+
+    for (std::size_t i = 0; i < 8; ++i)
+        result += text;
+
+    return result;
+}
+//---------------------------------------------------------------------------
+/**
+* Runs a test for each instruction set supported by the processor
+*@param test - test to run
+*/
+template <class T>
+static void ForEachCaseMappingInstructionSet(const T& test)
+{
+    const TSP_StringHelper::IEInstructionSet previous  = TSP_StringHelper::GetInstructionSet();
+    const TSP_StringHelper::IEInstructionSet supported = TSP_StringHelper::GetSupportedInstructionSet();
+
+    for (std::size_t i = 0; i <= std::size_t(supported); ++i)
+    {
+        M_Check(TSP_StringHelper::SetInstructionSet(TSP_StringHelper::IEInstructionSet(i)) == TSP_StringHelper::IEInstructionSet(i));
+        test();
+    }
+
+    TSP_StringHelper::SetInstructionSet(previous);
+}
+//---------------------------------------------------------------------------
+// Tests
+//---------------------------------------------------------------------------
+M_Test(CaseMapping_Wide)
+{
+    ForEachCaseMappingInstructionSet([]()
+    {
+        const std::wstring upper = RepeatCaseMappingTestText<wchar_t>(g_CaseMappingUpper);
+        const std::wstring lower = RepeatCaseMappingTestText<wchar_t>(g_CaseMappingLower);
+
+        M_Check(TSP_StringHelper::ToLowerCase(upper) == lower);
+        M_Check(TSP_StringHelper::ToUpperCase(lower) == upper);
+        M_Check(TSP_StringHelper::FoldCase(upper)    == lower);
+        M_Check(TSP_StringHelper::FoldCase(lower)    == lower);
+
+        std::wstring str = upper;
+        TSP_StringHelper::ToLowerCase_InPlace(str);
+        M_Check(str == lower);
+
+        TSP_StringHelper::ToUpperCase_InPlace(str);
+        M_Check(str == upper);
+
+        TSP_StringHelper::FoldCase_InPlace(str);
+        M_Check(str == lower);
+
+        // the converted strings are appended
+        std::wstring appended = L"X";
+        TSP_StringHelper::ToLowerCase(upper.data(), upper.length(), appended);
+        M_Check(appended == L"X" + lower);
+
+        M_Check(TSP_StringHelper::ToLowerCase(std::wstring()).empty());
+    });
+}
+//---------------------------------------------------------------------------
+M_Test(CaseMapping_Utf8)
+{
+    ForEachCaseMappingInstructionSet([]()
+    {
+        const std::string upper = RepeatCaseMappingTestText(TSP_StringHelper::Utf16ToUtf8(g_CaseMappingUpper));
+        const std::string lower = RepeatCaseMappingTestText(TSP_StringHelper::Utf16ToUtf8(g_CaseMappingLower));
+
+        M_Check(TSP_StringHelper::ToLowerCase(upper) == lower);
+        M_Check(TSP_StringHelper::ToUpperCase(lower) == upper);
+        M_Check(TSP_StringHelper::FoldCase(upper)    == lower);
+
+        std::string str = upper;
+        TSP_StringHelper::ToLowerCase_InPlace(str);
+        M_Check(str == lower);
+
+        TSP_StringHelper::ToUpperCase_InPlace(str);
+        M_Check(str == upper);
+
+        TSP_StringHelper::FoldCase_InPlace(str);
+        M_Check(str == lower);
+
+        std::string appended = "X";
+        TSP_StringHelper::FoldCase(upper.data(), upper.length(), appended);
+        M_Check(appended == "X" + lower);
+    });
+}
+//---------------------------------------------------------------------------
+M_Test(CaseMapping_FinalSigma)
+{
+    ForEachCaseMappingInstructionSet([]()
+    {
+        // the final sigma is already lower case, but is folded as the sigma
+        M_Check(TSP_StringHelper::ToLowerCase(std::wstring(L"\x03C2")) == L"\x03C2");
+        M_Check(TSP_StringHelper::ToUpperCase(std::wstring(L"\x03C2")) == L"\x03A3");
+        M_Check(TSP_StringHelper::FoldCase(std::wstring(L"\x03C2")) == L"\x03C3");
+
+        M_Check(TSP_StringHelper::ToLowerCase(std::string("\xCF\x82")) == "\xCF\x82");
+        M_Check(TSP_StringHelper::FoldCase(std::string("\xCF\x82")) == "\xCF\x83");
+        M_Check(TSP_StringHelper::FoldCase(std::string("\xCE\xA3\xCF\x83\xCF\x82")) == "\xCF\x83\xCF\x83\xCF\x83");
+    });
+}
+//---------------------------------------------------------------------------
+M_Test(CaseMapping_LengthChange)
+{
+    ForEachCaseMappingInstructionSet([]()
+    {
+        // U+023A is 2 bytes long in UTF-8, its lower case U+2C65 is 3 bytes long
+        const std::string upper = RepeatCaseMappingTestText<char>("A\xC8\xBA");
+        const std::string lower = RepeatCaseMappingTestText<char>("a\xE2\xB1\xA5");
+
+        M_Check(TSP_StringHelper::ToLowerCase(upper) == lower);
+        M_Check(TSP_StringHelper::ToUpperCase(lower) == upper);
+
+        std::string str = upper;
+        TSP_StringHelper::ToLowerCase_InPlace(str);
+        M_Check(str == lower);
+
+        M_Check(TSP_StringHelper::ToLowerCase(std::wstring(L"\x023A")) == L"\x2C65");
+    });
+}
+//---------------------------------------------------------------------------
+M_Test(CaseMapping_InvalidUtf8)
+{
+    ForEachCaseMappingInstructionSet([]()
+    {
+        // the invalid sequences are kept as is, the valid chars around them are converted
+        const std::string invalid  = RepeatCaseMappingTestText<char>("A\xC3" "B\xFF" "C\xC3\x89");
+        const std::string expected = RepeatCaseMappingTestText<char>("a\xC3" "b\xFF" "c\xC3\xA9");
+
+        M_Check(TSP_StringHelper::ToLowerCase(invalid) == expected);
+        M_Check(TSP_StringHelper::FoldCase(invalid)    == expected);
+
+        std::string str = invalid;
+        TSP_StringHelper::ToLowerCase_InPlace(str);
+        M_Check(str == expected);
+
+        M_Check(TSP_StringHelper::ToLowerCase(std::string("\xC3")) == "\xC3");
+    });
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,112 @@
+/****************************************************************************
+ * ==> TSP_HashHelperTest --------------------------------------------------*
+ ****************************************************************************
+ * Description:  Hash helper tests, against the MurmurHash3 reference       *
+ *               vectors                                                    *
+ * Contained in: Tests                                                      *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <cstring>
+#include <string>
+
+// common classes
+#include "Common\TSP_HashHelper.h"
+
+// tests
+#include "TSP_Test.h"
+
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Hashes a string
+*@param pStr - string to hash
+*@param seed - hash seed
+*@return the hash
+*/
+static TSP_HashHelper::IHash128 HashTestStr(const char* pStr, std::uint64_t seed = 0)
+{
+    return TSP_HashHelper::Hash128(pStr, std::strlen(pStr), seed);
+}
+//---------------------------------------------------------------------------
+// Tests
+//---------------------------------------------------------------------------
+M_Test(HashHelper_Hash128)
+{
+    // the reference values are the ones computed by the MurmurHash3_x64_128() function of SMHasher,
+    // the first 8 output bytes being the low part
+    M_Check(HashTestStr("").m_Low  == 0x0000000000000000ULL);
+    M_Check(HashTestStr("").m_High == 0x0000000000000000ULL);
+
+    M_Check(HashTestStr("a").m_Low  == 0x85555565f6597889ULL);
+    M_Check(HashTestStr("a").m_High == 0xe6b53a48510e895aULL);
+
+    M_Check(HashTestStr("The quick brown fox jumps over the lazy dog").m_Low  == 0xe34bbc7bbc071b6cULL);
+    M_Check(HashTestStr("The quick brown fox jumps over the lazy dog").m_High == 0x7a433ca9c49a9347ULL);
+
+    M_Check(HashTestStr("The quick brown fox jumps over the lazy cog").m_Low  == 0x658ca970ff85269aULL);
+    M_Check(HashTestStr("The quick brown fox jumps over the lazy cog").m_High == 0x43fee3eaa68e5c3eULL);
+
+    // exactly one block, and one block followed by a single tail byte
+    M_Check(HashTestStr("0123456789abcdef").m_Low   == 0x4be06d94cf4ad1a7ULL);
+    M_Check(HashTestStr("0123456789abcdef").m_High  == 0x87c35b5c63a708daULL);
+    M_Check(HashTestStr("0123456789abcdefg").m_Low  == 0x8e32612daa45f9deULL);
+    M_Check(HashTestStr("0123456789abcdefg").m_High == 0x0800f4c206c372eeULL);
+
+    M_Check(HashTestStr("Hello, world!", 123).m_Low  == 0x421c8c738743acadULL);
+    M_Check(HashTestStr("Hello, world!", 123).m_High == 0xf19732fdd373c3f5ULL);
+
+    M_Check(HashTestStr("a") != HashTestStr("a", 1));
+}
+//---------------------------------------------------------------------------
+M_Test(HashHelper_ToStr)
+{
+    const TSP_HashHelper::IHash128 hash = HashTestStr("The quick brown fox jumps over the lazy dog");
+
+    // the high part is written first
+    M_Check(TSP_HashHelper::ToStr(hash)                       == L"7a433ca9c49a9347e34bbc7bbc071b6c");
+    M_Check(TSP_HashHelper::ToStr(TSP_HashHelper::IHash128()) == L"00000000000000000000000000000000");
+
+    TSP_HashHelper::IHash128 converted;
+
+    M_Check(TSP_HashHelper::FromStr(L"7a433ca9c49a9347e34bbc7bbc071b6c", converted) && converted == hash);
+    M_Check(TSP_HashHelper::FromStr(L"7A433CA9C49A9347E34BBC7BBC071B6C", converted) && converted == hash);
+}
+//---------------------------------------------------------------------------
+M_Test(HashHelper_FromStr_Invalid)
+{
+    const TSP_HashHelper::IHash128 hash = HashTestStr("a");
+          TSP_HashHelper::IHash128 converted = hash;
+
+    // the hash is unchanged on failure
+    M_Check(!TSP_HashHelper::FromStr(L"",                                  converted));
+    M_Check(!TSP_HashHelper::FromStr(L"7a433ca9c49a9347e34bbc7bbc071b6",   converted));
+    M_Check(!TSP_HashHelper::FromStr(L"7a433ca9c49a9347e34bbc7bbc071b6c0", converted));
+    M_Check(!TSP_HashHelper::FromStr(L"7a433ca9c49a9347e34bbc7bbc071b6g",  converted));
+    M_Check(!TSP_HashHelper::FromStr(L"7a433ca9c49a9347 e34bbc7bbc071b6",  converted));
+    M_Check(converted == hash);
+}
+//---------------------------------------------------------------------------
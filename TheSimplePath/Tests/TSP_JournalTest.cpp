@@ -0,0 +1,332 @@
+/****************************************************************************
+ * ==> TSP_JournalTest -----------------------------------------------------*
+ ****************************************************************************
+ * Description:  Operation journal replay and truncation tests              *
+ * Contained in: Tests                                                      *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <cstdio>
+#include <string>
+
+// core classes
+#include "Core\TSP_Document.h"
+#include "Core\TSP_Atlas.h"
+#include "Core\TSP_Box.h"
+#include "Core\TSP_Process.h"
+#include "Core\TSP_Journal.h"
+
+// tests
+#include "TSP_Test.h"
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+const wchar_t* g_JournalFileName      = L"TSP_JournalTest.tspj";
+const wchar_t* g_JournalDocFileName   = L"TSP_JournalTest.json";
+const char*    g_JournalFileNameA     =  "TSP_JournalTest.tspj";
+const char*    g_JournalTempFileNameA =  "TSP_JournalTest.tspj.tmp";
+const char*    g_JournalDocFileNameA  =  "TSP_JournalTest.json";
+//---------------------------------------------------------------------------
+// TSP_JournalTestDocument
+//---------------------------------------------------------------------------
+/**
+* Document without user interface, created with a root atlas
+*/
+class TSP_JournalTestDocument : public TSP_Document
+{
+    public:
+        virtual bool Create()
+        {
+            Close();
+            CreateAndAddAtlas(L"Root");
+            SetStatus(IEDocStatus::IE_DS_Opened);
+            ClearModified();
+
+            if (GetJournal())
+                GetJournal()->Reset(L"");
+
+            return true;
+        }
+};
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Reads a whole file
+*@param pFileName - file name
+*@return the file content, empty if the file could not be read
+*/
+static std::string ReadJournalTestFile(const char* pFileName)
+{
+    std::FILE* pFile = std::fopen(pFileName, "rb");
+
+    if (!pFile)
+        return std::string();
+
+    std::string content;
+    char        buffer[4096];
+
+    while (const std::size_t read = std::fread(buffer, 1, sizeof(buffer), pFile))
+        content.append(buffer, read);
+
+    std::fclose(pFile);
+
+    return content;
+}
+//---------------------------------------------------------------------------
+/**
+* Writes a whole file
+*@param pFileName - file name
+*@param content - file content
+*/
+static void WriteJournalTestFile(const char* pFileName, const std::string& content)
+{
+    std::FILE* pFile = std::fopen(pFileName, "wb");
+
+    if (!pFile)
+        return;
+
+    std::fwrite(content.data(), 1, content.length(), pFile);
+    std::fclose(pFile);
+}
+//---------------------------------------------------------------------------
+/**
+* Records modifications of all kinds on a new document
+*@param journal - journal to record to
+*/
+static void RecordJournalTestModifications(TSP_Journal& journal)
+{
+    TSP_JournalTestDocument document;
+    document.SetJournal(&journal);
+    document.Create();
+
+    TSP_Page* pPage = document.GetAtlas(0)->CreateAndAddPage(L"Page");
+    TSP_Journal::AddPage(pPage);
+
+    TSP_Box* pBox = pPage->CreateAndAddBox(L"Box", L"", L"");
+    TSP_Journal::AddComponent(pBox);
+
+    pBox->SetTitle(L"T\x00EFtle");
+    TSP_Journal::SetTitle(pBox);
+
+    pBox->SetAttribute(TSP_Attribute::IEKey::IE_K_Duration, TSP_Attribute(2.0));
+    TSP_Journal::SetAttribute(pBox, TSP_Attribute::IEKey::IE_K_Duration);
+
+    TSP_Attribute cost;
+    cost.SetFormula(L"duration * 3");
+    pBox->SetAttribute(TSP_Attribute::IEKey::IE_K_Cost, cost);
+    TSP_Journal::SetAttribute(pBox, TSP_Attribute::IEKey::IE_K_Cost);
+
+    TSP_Process* pProcess = pPage->CreateAndAddProcess(L"Process", L"", L"");
+    TSP_Journal::AddComponent(pProcess);
+
+    TSP_Page* pSubPage = pProcess->CreateAndAddPage(L"Sub page");
+    TSP_Journal::AddPage(pSubPage);
+
+    pPage->SetName(L"Renamed");
+    TSP_Journal::SetName(pPage);
+
+    // the last record, used by the truncation tests
+    pBox->SetComments(L"Last");
+    TSP_Journal::SetComments(pBox);
+
+    journal.Sync();
+    document.SetJournal(nullptr);
+}
+//---------------------------------------------------------------------------
+// Tests
+//---------------------------------------------------------------------------
+M_Test(Journal_Replay)
+{
+    std::remove(g_JournalFileNameA);
+
+    {
+        TSP_Journal journal;
+
+        if (!M_Check(journal.Open(g_JournalFileName)))
+            return;
+
+        RecordJournalTestModifications(journal);
+    }
+
+    TSP_JournalTestDocument document;
+
+    if (!M_Check(TSP_Journal::Replay(g_JournalFileName, &document)))
+        return;
+
+    TSP_Atlas* pAtlas = document.GetAtlas(0);
+
+    if (!M_Check(pAtlas && pAtlas->GetPageCount() == 1))
+        return;
+
+    TSP_Page* pPage = pAtlas->GetPage(0);
+
+    M_Check(pPage->GetName() == L"Renamed");
+
+    TSP_Component* pBox     = pPage->GetOf(TSP_Item::IEType::IE_T_Box,     0);
+    TSP_Component* pProcess = pPage->GetOf(TSP_Item::IEType::IE_T_Process, 0);
+
+    if (!M_Check(pBox && pProcess))
+        return;
+
+    M_Check(pBox->GetTitle()                                               == L"T\x00EFtle");
+    M_Check(pBox->GetComments()                                            == L"Last");
+    M_Check(pBox->GetAttribute(TSP_Attribute::IEKey::IE_K_Duration).Get(0.0) == 2.0);
+    M_Check(pBox->GetFormula(TSP_Attribute::IEKey::IE_K_Cost)                == L"duration * 3");
+    M_Check(pBox->GetAttribute(TSP_Attribute::IEKey::IE_K_Cost).Get(0.0)     == 6.0);
+    M_Check(static_cast<TSP_Process*>(pProcess)->GetPageCount()              == 1);
+
+    std::remove(g_JournalFileNameA);
+}
+//---------------------------------------------------------------------------
+M_Test(Journal_Truncated)
+{
+    std::remove(g_JournalFileNameA);
+
+    {
+        TSP_Journal journal;
+
+        if (!M_Check(journal.Open(g_JournalFileName)))
+            return;
+
+        RecordJournalTestModifications(journal);
+    }
+
+    const std::string content = ReadJournalTestFile(g_JournalFileNameA);
+
+    // a record torn by a crash is ignored, the previous ones are replayed
+    WriteJournalTestFile(g_JournalFileNameA, content.substr(0, content.length() - 3));
+
+    {
+        TSP_JournalTestDocument document;
+
+        if (M_Check(TSP_Journal::Replay(g_JournalFileName, &document)))
+        {
+            TSP_Component* pBox = document.GetAtlas(0)->GetPage(0)->GetOf(TSP_Item::IEType::IE_T_Box, 0);
+
+            M_Check(document.GetAtlas(0)->GetPage(0)->GetName() == L"Renamed");
+            M_Check(pBox && pBox->GetComments().empty());
+        }
+    }
+
+    // reopening the journal removes the torn record, the next records follow the valid ones
+    {
+        TSP_Journal journal;
+
+        if (!M_Check(journal.Open(g_JournalFileName)))
+            return;
+
+        journal.Close();
+
+        M_Check(ReadJournalTestFile(g_JournalFileNameA).length() < content.length() - 3);
+    }
+
+    // garbage following the last record is ignored
+    WriteJournalTestFile(g_JournalFileNameA, content + std::string("\x10\0\0\0garbage", 11));
+
+    {
+        TSP_JournalTestDocument document;
+
+        if (M_Check(TSP_Journal::Replay(g_JournalFileName, &document)))
+        {
+            TSP_Component* pBox = document.GetAtlas(0)->GetPage(0)->GetOf(TSP_Item::IEType::IE_T_Box, 0);
+            M_Check(pBox && pBox->GetComments() == L"Last");
+        }
+    }
+
+    // an invalid header isn't replayed
+    WriteJournalTestFile(g_JournalFileNameA, "not a journal");
+
+    {
+        TSP_JournalTestDocument document;
+        M_Check(!TSP_Journal::Replay(g_JournalFileName, &document));
+    }
+
+    std::remove(g_JournalFileNameA);
+}
+//---------------------------------------------------------------------------
+M_Test(Journal_Rebase)
+{
+    std::remove(g_JournalFileNameA);
+    std::remove(g_JournalDocFileNameA);
+
+    TSP_Journal journal;
+
+    if (!M_Check(journal.Open(g_JournalFileName)))
+        return;
+
+    TSP_JournalTestDocument document;
+    document.SetJournal(&journal);
+    document.Create();
+
+    TSP_Journal::AddPage(document.GetAtlas(0)->CreateAndAddPage(L"Saved"));
+
+    // the document is saved from the mark, while it's still modified
+    const std::size_t mark = journal.GetMark();
+
+    document.SetJournal(nullptr);
+    M_Check(document.Save(g_JournalDocFileName));
+    document.SetJournal(&journal);
+
+    TSP_Journal::AddPage(document.GetAtlas(0)->CreateAndAddPage(L"During save"));
+
+    journal.Rebase(g_JournalDocFileName, mark);
+
+    TSP_Journal::AddPage(document.GetAtlas(0)->CreateAndAddPage(L"After save"));
+
+    M_Check(journal.Sync());
+
+    // the journal was replaced by its temporary file
+    M_Check(ReadJournalTestFile(g_JournalTempFileNameA).empty());
+
+    // the saved document is loaded, and only the modifications done after the mark are replayed
+    {
+        TSP_JournalTestDocument replayed;
+
+        if (M_Check(TSP_Journal::Replay(g_JournalFileName, &replayed)) && M_Check(replayed.GetAtlas(0)->GetPageCount() == 3))
+        {
+            M_Check(replayed.GetAtlas(0)->GetPage(0)->GetName() == L"Saved");
+            M_Check(replayed.GetAtlas(0)->GetPage(1)->GetName() == L"During save");
+            M_Check(replayed.GetAtlas(0)->GetPage(2)->GetName() == L"After save");
+        }
+    }
+
+    // once reset, nothing remains to replay
+    journal.Reset(g_JournalDocFileName);
+    M_Check(journal.Sync());
+
+    {
+        TSP_JournalTestDocument replayed;
+        M_Check(!TSP_Journal::Replay(g_JournalFileName, &replayed));
+    }
+
+    document.SetJournal(nullptr);
+    journal.Close();
+
+    std::remove(g_JournalFileNameA);
+    std::remove(g_JournalDocFileNameA);
+}
+//---------------------------------------------------------------------------
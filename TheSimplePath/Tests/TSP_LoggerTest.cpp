@@ -0,0 +1,165 @@
+/****************************************************************************
+ * ==> TSP_LoggerTest ------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Logger tests, on the binary log decoding                   *
+ * Contained in: Tests                                                      *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <cstdio>
+#include <string>
+
+// common classes
+#include "Common\TSP_Logger.h"
+
+// tests
+#include "TSP_Test.h"
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+const wchar_t* g_LoggerBinFileName        = L"TSP_LoggerTest.tspl";
+const wchar_t* g_LoggerTruncatedFileName  = L"TSP_LoggerTest_Truncated.tspl";
+const wchar_t* g_LoggerTextFileName       = L"TSP_LoggerTest.txt";
+const char*    g_LoggerBinFileNameA       =  "TSP_LoggerTest.tspl";
+const char*    g_LoggerTruncatedFileNameA =  "TSP_LoggerTest_Truncated.tspl";
+const char*    g_LoggerTextFileNameA      =  "TSP_LoggerTest.txt";
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Writes a binary log containing formatted messages of all the argument kinds
+*@param fileName - log file name
+*/
+static void WriteLoggerTestBinaryLog(const std::wstring& fileName)
+{
+    TSP_Logger::IHeader header;
+    header.m_Name = L"TSP_Tests";
+
+    TSP_Logger::Instance()->Open(header, fileName, TSP_Logger::IEFileFormat::IE_FF_Binary);
+
+    M_LogFmtT(IO, Info, "Save {} pages in {} ms - {} - {} - {}", 12, 3.5, "\xC3\xA9\xE2\x82\xAC" "ok", std::wstring(L"wide"), true);
+    M_LogFmt(Core, Warning, "no args");
+    M_LogFmt(Core, Error, "neg {} u {} extra {} {}", -5, 7u);
+    M_LogT("text " << 5);
+
+    TSP_Logger::Instance()->Close();
+}
+//---------------------------------------------------------------------------
+/**
+* Reads a whole file
+*@param pFileName - file name
+*@return the file content, empty if the file could not be read
+*/
+static std::string ReadLoggerTestFile(const char* pFileName)
+{
+    std::FILE* pFile = std::fopen(pFileName, "rb");
+
+    if (!pFile)
+        return std::string();
+
+    std::string content;
+    char        buffer[4096];
+
+    while (const std::size_t read = std::fread(buffer, 1, sizeof(buffer), pFile))
+        content.append(buffer, read);
+
+    std::fclose(pFile);
+
+    return content;
+}
+//---------------------------------------------------------------------------
+// Tests
+//---------------------------------------------------------------------------
+M_Test(Logger_Decode)
+{
+    WriteLoggerTestBinaryLog(g_LoggerBinFileName);
+
+    std::wstring log;
+
+    if (!M_Check(TSP_Logger::Decode(g_LoggerBinFileName, log)))
+        return;
+
+    M_Check(log.find(L"TSP_Tests")                                           != std::wstring::npos);
+    M_Check(log.find(L"Save 12 pages in 3.5 ms - \x00E9\x20AC" L"ok - wide - 1") != std::wstring::npos);
+    M_Check(log.find(L"<warning>no args</warning>")                          != std::wstring::npos);
+    M_Check(log.find(L"<error>neg -5 u 7 extra {} {}</error>")               != std::wstring::npos);
+    M_Check(log.find(L"text 5")                                              != std::wstring::npos);
+    M_Check(log.find(L"Log end.")                                            != std::wstring::npos);
+    M_Check(log.find(L"truncated")                                           == std::wstring::npos);
+
+    std::remove(g_LoggerBinFileNameA);
+}
+//---------------------------------------------------------------------------
+M_Test(Logger_Decode_Truncated)
+{
+    WriteLoggerTestBinaryLog(g_LoggerBinFileName);
+
+    const std::string content = ReadLoggerTestFile(g_LoggerBinFileNameA);
+
+    if (!M_Check(content.length() > 7))
+        return;
+
+    // the last record is cut, the previous ones are still decoded
+    std::FILE* pFile = std::fopen(g_LoggerTruncatedFileNameA, "wb");
+
+    if (!M_Check(pFile))
+        return;
+
+    std::fwrite(content.data(), 1, content.length() - 7, pFile);
+    std::fclose(pFile);
+
+    std::wstring log;
+
+    if (M_Check(TSP_Logger::Decode(g_LoggerTruncatedFileName, log)))
+    {
+        M_Check(log.find(L"<warning>no args</warning>") != std::wstring::npos);
+        M_Check(log.find(L"truncated")                  != std::wstring::npos);
+        M_Check(log.find(L"Log end.")                   == std::wstring::npos);
+    }
+
+    std::remove(g_LoggerBinFileNameA);
+    std::remove(g_LoggerTruncatedFileNameA);
+}
+//---------------------------------------------------------------------------
+M_Test(Logger_Decode_TextLog)
+{
+    TSP_Logger::IHeader header;
+    header.m_Name = L"TSP_Tests";
+
+    TSP_Logger::Instance()->Open(header, g_LoggerTextFileName);
+    M_LogFmt(Core, Info, "text log {}", 1);
+    TSP_Logger::Instance()->Close();
+
+    // a text log isn't a binary log
+    std::wstring log;
+    M_Check(!TSP_Logger::Decode(g_LoggerTextFileName, log));
+
+    // neither is a missing file
+    M_Check(!TSP_Logger::Decode(L"TSP_LoggerTest_Missing.tspl", log));
+
+    std::remove(g_LoggerTextFileNameA);
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,197 @@
+/****************************************************************************
+ * ==> TSP_Test ------------------------------------------------------------*
+ ****************************************************************************
+ * Description:  Unit test registry, checks and runner                      *
+ * Contained in: Tests                                                      *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <vector>
+
+/**
+* Unit test registry, checks and runner
+*@note The tests are built in a single console program, against the TSP_Classes library. Each test
+*      file declares its tests with M_Test(), the runner runs them all, or only those whose name
+*      contains the filter passed on the command line. The failures are written on the standard output
+*@author Jean-Milost Reymond
+*/
+class TSP_Test
+{
+    public:
+        /**
+        * Test function
+        */
+        typedef void (*ITest)();
+
+        /**
+        * Registers a test when the program starts, see M_Test()
+        */
+        class IRegistrar
+        {
+            public:
+                /**
+                * Constructor
+                *@param pName - test name
+                *@param test - test function
+                */
+                inline IRegistrar(const char* pName, ITest test);
+        };
+
+        /**
+        * Checks a condition, and reports a failure if the condition isn't met
+        *@param condition - condition to check
+        *@param pCondition - condition text
+        *@param pFileName - source file containing the check
+        *@param line - source line containing the check
+        *@return the condition
+        *@note The test continues after a failed check, so all the failures it contains are reported
+        */
+        static inline bool Check(bool condition, const char* pCondition, const char* pFileName, int line);
+
+        /**
+        * Runs the registered tests
+        *@param filter - only the tests whose name contains this filter are run, all if empty
+        *@return the failed test count
+        */
+        static inline std::size_t Run(const std::string& filter);
+
+    private:
+        /**
+        * Registered test
+        */
+        struct IEntry
+        {
+            const char* m_pName = nullptr;
+            ITest       m_Test  = nullptr;
+        };
+
+        typedef std::vector<IEntry> IEntries;
+
+        static inline std::size_t m_CheckFailures = 0;
+
+        /**
+        * Gets the registered tests
+        *@return the registered tests
+        *@note The tests are registered while the static objects are initialized, in any order, so the
+        *      registry is created on its first use
+        */
+        static inline IEntries& GetEntries();
+};
+
+//---------------------------------------------------------------------------
+// Test macros
+//---------------------------------------------------------------------------
+/**
+* Declares and registers a test
+*@param name - test name, should be unique in the program
+*/
+#define M_Test(name)\
+    static void name();\
+    static const TSP_Test::IRegistrar g_##name##_Registrar(#name, name);\
+    static void name()
+
+/**
+* Checks a condition in a test
+*@param condition - condition to check
+*/
+#define M_Check(condition) TSP_Test::Check((condition), #condition, __FILE__, __LINE__)
+
+//---------------------------------------------------------------------------
+// TSP_Test::IRegistrar
+//---------------------------------------------------------------------------
+TSP_Test::IRegistrar::IRegistrar(const char* pName, ITest test)
+{
+    IEntry entry;
+    entry.m_pName = pName;
+    entry.m_Test  = test;
+
+    GetEntries().push_back(entry);
+}
+//---------------------------------------------------------------------------
+// TSP_Test
+//---------------------------------------------------------------------------
+bool TSP_Test::Check(bool condition, const char* pCondition, const char* pFileName, int line)
+{
+    if (condition)
+        return true;
+
+    std::printf("    FAILED - %s - %s(%d)\n", pCondition, pFileName, line);
+    ++m_CheckFailures;
+
+    return false;
+}
+//---------------------------------------------------------------------------
+std::size_t TSP_Test::Run(const std::string& filter)
+{
+    std::size_t runCount    = 0;
+    std::size_t failedCount = 0;
+
+    for each (const IEntry& entry in GetEntries())
+    {
+        if (!filter.empty() && std::string(entry.m_pName).find(filter) == std::string::npos)
+            continue;
+
+        std::printf("%s\n", entry.m_pName);
+
+        const std::size_t checkFailures = m_CheckFailures;
+
+        try
+        {
+            entry.m_Test();
+        }
+        catch (const std::exception& e)
+        {
+            std::printf("    FAILED - exception caught - %s\n", e.what());
+            ++m_CheckFailures;
+        }
+        catch (...)
+        {
+            std::printf("    FAILED - unknown exception caught\n");
+            ++m_CheckFailures;
+        }
+
+        if (m_CheckFailures != checkFailures)
+            ++failedCount;
+
+        ++runCount;
+    }
+
+    std::printf("%zu tests run, %zu failed\n", runCount, failedCount);
+
+    return failedCount;
+}
+//---------------------------------------------------------------------------
+TSP_Test::IEntries& TSP_Test::GetEntries()
+{
+    static IEntries entries;
+    return entries;
+}
+//---------------------------------------------------------------------------
@@ -0,0 +1,225 @@
+/****************************************************************************
+ * ==> TSP_TranscodeTest ---------------------------------------------------*
+ ****************************************************************************
+ * Description:  UTF-8 and UTF-16 conversions tests, for each instruction   *
+ *               set                                                        *
+ * Contained in: Tests                                                      *
+ * Developer:    Jean-Milost Reymond                                        *
+ ****************************************************************************
+ * MIT License - The Simple Path                                            *
+ *                                                                          *
+ * Permission is hereby granted, free of charge, to any person obtaining a  *
+ * copy of this software and associated documentation files (the            *
+ * "Software"), to deal in the Software without restriction, including      *
+ * without limitation the rights to use, copy, modify, merge, publish,      *
+ * distribute, sub-license, and/or sell copies of the Software, and to      *
+ * permit persons to whom the Software is furnished to do so, subject to    *
+ * the following conditions:                                                *
+ *                                                                          *
+ * The above copyright notice and this permission notice shall be included  *
+ * in all copies or substantial portions of the Software.                   *
+ *                                                                          *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS  *
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF               *
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.   *
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY     *
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,     *
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
+ ****************************************************************************/
+
+// std
+#include <stdexcept>
+#include <string>
+
+// common classes
+#include "Common\TSP_StringHelper.h"
+
+// tests
+#include "TSP_Test.h"
+
+//---------------------------------------------------------------------------
+// Global constants
+//---------------------------------------------------------------------------
+// latin, CJK and emoji chars, in UTF-8 and UTF-16
+const char     g_TranscodeUtf8[]  = "A\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80";
+const char16_t g_TranscodeUtf16[] = {0x0041, 0x00E9, 0x4E2D, 0xD83D, 0xDE00, 0};
+//---------------------------------------------------------------------------
+// Global functions
+//---------------------------------------------------------------------------
+/**
+* Builds a text long enough to be converted by blocks, with the non-ASCII chars both inside
+* and between the ASCII runs
+*@param chars - chars to insert between the ASCII runs
+*@return the text
+*/
+template <class T>
+static std::basic_string<T> BuildTranscodeTestText(const std::basic_string<T>& chars)
+{
+    std::basic_string<T> text;
+
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        text += chars;
+
+        // 37 ASCII chars, so the next chars are never aligned on a block
+        for (std::size_t j = 0; j < 37 + i; ++j)
+            text += T('a' + j % 26);
+    }
+
+    return text + chars;
+}
+//---------------------------------------------------------------------------
+/**
+* Checks that an invalid UTF-8 string is rejected, alone and after a long ASCII run
+*@param invalid - invalid UTF-8 sequence
+*@return true if the string was rejected, otherwise false
+*/
+static bool CheckTranscodeInvalidUtf8(const std::string& invalid)
+{
+    const std::string texts[] = {invalid, BuildTranscodeTestText<char>("0123456789") + invalid + "end"};
+
+    for each (const auto& text in texts)
+    {
+        std::u16string utf16 = u"keep";
+        std::wstring   wide  = L"keep";
+
+        if (TSP_StringHelper::Utf8ToUtf16(text.data(), text.length(), utf16) || utf16 != u"keep")
+            return false;
+
+        if (TSP_StringHelper::Utf8ToUtf16(text.data(), text.length(), wide) || wide != L"keep")
+            return false;
+
+        try
+        {
+            TSP_StringHelper::Utf8ToUtf16(text);
+            return false;
+        }
+        catch (const std::range_error&)
+        {}
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+/**
+* Checks that an invalid UTF-16 string is rejected, alone and after a long ASCII run
+*@param invalid - invalid UTF-16 sequence
+*@return true if the string was rejected, otherwise false
+*/
+static bool CheckTranscodeInvalidUtf16(const std::u16string& invalid)
+{
+    const std::u16string texts[] = {invalid, BuildTranscodeTestText<char16_t>(u"0123456789") + invalid + u"end"};
+
+    for each (const auto& text in texts)
+    {
+        std::string utf8 = "keep";
+
+        if (TSP_StringHelper::Utf16ToUtf8(text.data(), text.length(), utf8) || utf8 != "keep")
+            return false;
+    }
+
+    return true;
+}
+//---------------------------------------------------------------------------
+/**
+* Runs a test for each instruction set supported by the processor
+*@param test - test to run
+*/
+template <class T>
+static void ForEachTranscodeInstructionSet(const T& test)
+{
+    const TSP_StringHelper::IEInstructionSet previous  = TSP_StringHelper::GetInstructionSet();
+    const TSP_StringHelper::IEInstructionSet supported = TSP_StringHelper::GetSupportedInstructionSet();
+
+    for (std::size_t i = 0; i <= std::size_t(supported); ++i)
+    {
+        M_Check(TSP_StringHelper::SetInstructionSet(TSP_StringHelper::IEInstructionSet(i)) == TSP_StringHelper::IEInstructionSet(i));
+        test();
+    }
+
+    TSP_StringHelper::SetInstructionSet(previous);
+}
+//---------------------------------------------------------------------------
+// Tests
+//---------------------------------------------------------------------------
+M_Test(Transcode_RoundTrip)
+{
+    ForEachTranscodeInstructionSet([]()
+    {
+        const std::string    utf8  = BuildTranscodeTestText<char>(g_TranscodeUtf8);
+        const std::u16string utf16 = BuildTranscodeTestText<char16_t>(g_TranscodeUtf16);
+
+        std::u16string convertedUtf16;
+        M_Check(TSP_StringHelper::Utf8ToUtf16(utf8.data(), utf8.length(), convertedUtf16));
+        M_Check(convertedUtf16 == utf16);
+
+        std::string convertedUtf8;
+        M_Check(TSP_StringHelper::Utf16ToUtf8(utf16.data(), utf16.length(), convertedUtf8));
+        M_Check(convertedUtf8 == utf8);
+
+        // the wide strings, UTF-16 or UTF-32 depending on the platform, do the same round trip
+        const std::wstring wide = TSP_StringHelper::Utf8ToUtf16(utf8);
+        M_Check(wide.length()                            == TSP_StringHelper::GetWideLength(utf8.data(), utf8.length()));
+        M_Check(TSP_StringHelper::Utf16ToUtf8(wide)      == utf8);
+        M_Check(TSP_StringHelper::Utf8ToUtf16(utf8)[1]   == L'\x00E9');
+
+        // the converted strings are appended
+        std::u16string appended = u"x";
+        M_Check(TSP_StringHelper::Utf8ToUtf16(g_TranscodeUtf8, sizeof(g_TranscodeUtf8) - 1, appended));
+        M_Check(appended == u"x" + std::u16string(g_TranscodeUtf16));
+
+        // empty strings
+        M_Check(TSP_StringHelper::Utf8ToUtf16(std::string()).empty());
+        M_Check(TSP_StringHelper::Utf16ToUtf8(std::wstring()).empty());
+    });
+}
+//---------------------------------------------------------------------------
+M_Test(Transcode_Lengths)
+{
+    ForEachTranscodeInstructionSet([]()
+    {
+        const std::string    utf8  = BuildTranscodeTestText<char>(g_TranscodeUtf8);
+        const std::u16string utf16 = BuildTranscodeTestText<char16_t>(g_TranscodeUtf16);
+
+        M_Check(TSP_StringHelper::GetUtf16Length(g_TranscodeUtf8, sizeof(g_TranscodeUtf8) - 1) == 5);
+        M_Check(TSP_StringHelper::GetUtf16Length(utf8.data(), utf8.length())                   == utf16.length());
+        M_Check(TSP_StringHelper::GetUtf8Length(g_TranscodeUtf16, 5)                           == 10);
+        M_Check(TSP_StringHelper::GetUtf8Length(utf16.data(), utf16.length())                  == utf8.length());
+
+        const std::wstring wide = TSP_StringHelper::Utf8ToUtf16(utf8);
+        M_Check(TSP_StringHelper::GetUtf8Length(wide.data(), wide.length()) == utf8.length());
+    });
+}
+//---------------------------------------------------------------------------
+M_Test(Transcode_InvalidUtf8)
+{
+    ForEachTranscodeInstructionSet([]()
+    {
+        // truncated sequence, lone continuation byte, overlong encoding, encoded surrogate,
+        // out of range code point and invalid byte
+        M_Check(CheckTranscodeInvalidUtf8("\xC3"));
+        M_Check(CheckTranscodeInvalidUtf8("\xE4\xB8"));
+        M_Check(CheckTranscodeInvalidUtf8("\x80"));
+        M_Check(CheckTranscodeInvalidUtf8("\xC0\xAF"));
+        M_Check(CheckTranscodeInvalidUtf8("\xE0\x80\xAF"));
+        M_Check(CheckTranscodeInvalidUtf8("\xED\xA0\x80"));
+        M_Check(CheckTranscodeInvalidUtf8("\xF4\x90\x80\x80"));
+        M_Check(CheckTranscodeInvalidUtf8("\xFF"));
+        M_Check(CheckTranscodeInvalidUtf8("\xC3" "a"));
+    });
+}
+//---------------------------------------------------------------------------
+M_Test(Transcode_InvalidUtf16)
+{
+    ForEachTranscodeInstructionSet([]()
+    {
+        // lone high surrogate, at the end and followed by an ASCII char, lone low surrogate,
+        // and swapped surrogates
+        M_Check(CheckTranscodeInvalidUtf16(std::u16string(1, char16_t(0xD83D))));
+        M_Check(CheckTranscodeInvalidUtf16(std::u16string(1, char16_t(0xD83D)) + u"a"));
+        M_Check(CheckTranscodeInvalidUtf16(std::u16string(1, char16_t(0xDE00))));
+        M_Check(CheckTranscodeInvalidUtf16(std::u16string(1, char16_t(0xDE00)) + char16_t(0xD83D)));
+    });
+}
+//---------------------------------------------------------------------------
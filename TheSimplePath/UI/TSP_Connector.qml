@@ -1,3 +1,4 @@
+import QtQml 2.15
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Templates 2.15 as T
@@ -31,7 +32,6 @@ T.Control
 
     // advanced properties
     property var  m_Box:         undefined
-    property var  m_Links:       []
     property real m_ScaleFactor: 1
     property int  m_Position:    TSP_Connector.IEPosition.IE_P_None
 
@@ -41,6 +41,16 @@ T.Control
     width: Styles.m_ConnectorWidth
     height: Styles.m_ConnectorHeight
 
+    /**
+    * Connector logging category, the bulk operations are only logged on debug level
+    */
+    LoggingCategory
+    {
+        id: lcConnector
+        name: "tsp.qml.connector"
+        defaultLogLevel: LoggingCategory.Info
+    }
+
     /**
     * Connector rectangle
     */
@@ -79,8 +89,8 @@ T.Control
             // add a new link and start to drag it
             if (m_Page && m_Box)
             {
-                console.log("Connector - adding a new link - start box - " + m_Box.objectName +
-                            " - start connector - "                        + ctConnector.objectName);
+                console.debug(lcConnector, "Connector - adding a new link - start box - " + m_Box.objectName +
+                                           " - start connector - "                        + ctConnector.objectName);
 
                 // send signal to notify that a new link should be added from this connector
                 m_AddingLinkItem = m_Page.startAddLink(ctConnector);
@@ -131,14 +141,14 @@ T.Control
                 // found a valid target connector?
                 if (targetConn && targetConn.visible && targetConn.m_Box.boxProxy.uid !== m_Box.boxProxy.uid)
                 {
-                    console.log("Connector - link added successfully - name - " + m_AddingLinkItem.objectName);
+                    console.debug(lcConnector, "Connector - link added successfully - name - " + m_AddingLinkItem.objectName);
 
                     // yes, attach the new link to it
                     m_AddingLinkItem.bindTo(targetConn);
                 }
                 else
                 {
-                    console.log("Connector - link adding - CANCELED");
+                    console.debug(lcConnector, "Connector - link adding - CANCELED");
 
                     // no, remove the currently adding link
                     doRemoveLink = true;
@@ -164,7 +174,6 @@ T.Control
             // do remove the link?
             if (doRemoveLink)
             {
-                m_AddingLinkItem.unbindLinkFromBox(m_Box);
                 m_Page.deleteLink(m_AddingLinkItem);
 
                 // emit signal that link adding was canceled
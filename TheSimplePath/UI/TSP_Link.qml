@@ -517,9 +517,9 @@ Item
         if (!m_From)
             return;
 
-        // unbind link from parent box, if previously binded
-        unbindLinkFromBox(m_From.m_Box);
-        m_From.m_Links.push(this);
+        // notify the link proxy, which will update the page link graph. NOTE the link is detached from
+        // its previous box, if any, by the graph
+        linkProxy.onBoundToBox(m_From.m_Box.boxProxy.uid, m_From.m_Position, false);
     }
 
     /**
@@ -531,39 +531,9 @@ Item
         if (!m_To)
             return;
 
-        // unbind link from parent box, if previously binded
-        unbindLinkFromBox(m_To.m_Box);
-        m_To.m_Links.push(this);
-    }
-
-    /**
-    * Unbinds a link from a box
-    *@param {TSP_Box} box - box for which the link should be unbind
-    */
-    function unbindLinkFromBox(box)
-    {
-        if (!box)
-            return 0;
-
-        // remove all existing link instance from left connector
-        for (let i = box.leftConnector.m_Links.length - 1; i >= 0; --i)
-            if (box.leftConnector.m_Links[i] === this)
-                box.leftConnector.m_Links.splice(i, 1);
-
-        // remove all existing link instance from top connector
-        for (let i = box.topConnector.m_Links.length - 1; i >= 0; --i)
-            if (box.topConnector.m_Links[i] === this)
-                box.topConnector.m_Links.splice(i, 1);
-
-        // remove all existing link instance from right connector
-        for (let i = box.rightConnector.m_Links.length - 1; i >= 0; --i)
-            if (box.rightConnector.m_Links[i] === this)
-                box.rightConnector.m_Links.splice(i, 1);
-
-        // remove all existing link instance from bottom connector
-        for (let i = box.bottomConnector.m_Links.length - 1; i >= 0; --i)
-            if (box.bottomConnector.m_Links[i] === this)
-                box.bottomConnector.m_Links.splice(i, 1);
+        // notify the link proxy, which will update the page link graph. NOTE the link is detached from
+        // its previous box, if any, by the graph
+        linkProxy.onBoundToBox(m_To.m_Box.boxProxy.uid, m_To.m_Position, true);
     }
 
     /**
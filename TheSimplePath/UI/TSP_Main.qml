@@ -19,6 +19,8 @@ ApplicationWindow
     property var               m_MainFormModel:    tspMainFormModel
     property real              m_PageListMinWidth: 0.1 // minimum width the page list view may take, in percent (between 0.0 and 1.0)
     property real              m_PageListMaxWidth: 0.9 // maximum width the page list view may take, in percent (between 0.0 and 1.0)
+    property string            m_DocName:          ""  // opened document name, empty if no document is opened
+    property bool              m_Saving:           false // if true, the document is saved in background
 
     // common properties
     id: wiMainWnd
@@ -47,6 +49,30 @@ ApplicationWindow
         }
     }
 
+    /**
+    * Save document dialog
+    */
+    FileDialog
+    {
+        // common properties
+        id: fdSaveDocument
+        objectName: "fdSaveDocument"
+        title: qsTrId("save-document")
+        selectExisting: false
+        nameFilters: [qsTrId("binary-document-filter") + " (*.tspb)", qsTrId("json-document-filter") + " (*.json)"]
+        visible: false
+
+        /// called when user selected the file to save to
+        onAccepted:
+        {
+            if (!m_MainFormModel)
+                return;
+
+            m_Saving = true;
+            m_MainFormModel.onSaveDocumentClicked(fileUrl.toString());
+        }
+    }
+
     /**
     * Toolbox
     */
@@ -105,6 +131,29 @@ ApplicationWindow
             }
         }
 
+        /**
+        * Save document button
+        */
+        Button
+        {
+            // common properties
+            id: btSaveDocument
+            objectName: "btSaveDocument"
+            anchors.left: btCloseDocument.right
+            anchors.top: parent.top
+            anchors.bottom: parent.bottom
+            text: qsTrId("save-document")
+            enabled: m_DocName.length > 0 && !m_Saving
+
+            /// called when button is clicked
+            onClicked:
+            {
+                console.log("GUI - Save document clicked");
+
+                fdSaveDocument.open();
+            }
+        }
+
         /**
         * Add process button
         */
@@ -113,7 +162,7 @@ ApplicationWindow
             // common properties
             id: btAddProcess
             objectName: "btAddProcess"
-            anchors.left: btCloseDocument.right
+            anchors.left: btSaveDocument.right
             anchors.top: parent.top
             anchors.bottom: parent.bottom
             text: qsTrId("add-process")
@@ -151,6 +200,23 @@ ApplicationWindow
                     m_MainFormModel.onAddBoxClicked();
             }
         }
+
+        /**
+        * Save progress bar
+        */
+        ProgressBar
+        {
+            // common properties
+            id: pbSaveProgress
+            objectName: "pbSaveProgress"
+            anchors.left: btAddbox.right
+            anchors.leftMargin: 5
+            anchors.verticalCenter: parent.verticalCenter
+            from: 0.0
+            to: 1.0
+            value: 0.0
+            visible: m_Saving
+        }
     }
 
     /**
@@ -254,6 +320,27 @@ ApplicationWindow
             mdError.detailedText = detailedMsg;
             mdError.open();
         }
+
+        /**
+        * Called while the document is saved
+        *@param {number} progress - save progress, between 0.0 and 1.0
+        */
+        function onSaveProgress(progress)
+        {
+            pbSaveProgress.value = progress;
+        }
+
+        /**
+        * Called when the document save ended
+        *@param {boolean} success - if true, the document was saved
+        *@param {string} fileName - saved file name
+        */
+        function onSaveFinished(success, fileName)
+        {
+            m_Saving = false;
+
+            console.log("GUI - Save document " + (success ? "succeeded" : "failed") + " - " + fileName);
+        }
     }
 
     /**
@@ -285,7 +372,8 @@ ApplicationWindow
             }
 
             // update the form title
-            title = qsTrId("app-name") + " - " + name;
+            m_DocName = name;
+            updateTitle(tspDocumentModel.modified);
         }
 
         /**
@@ -296,8 +384,34 @@ ApplicationWindow
             deleteDocumentView();
 
             // update the form title
+            m_DocName = "";
+            updateTitle(false);
+        }
+
+        /**
+        * Called when the document was modified, or saved
+        *@param {boolean} modified - if true, the document was modified since it was loaded or saved
+        */
+        function onModifiedChanged(modified)
+        {
+            // mark the modified document in the form title
+            updateTitle(modified);
+        }
+    }
+
+    /**
+    * Updates the form title
+    *@param {boolean} modified - if true, the opened document was modified since it was loaded or saved
+    */
+    function updateTitle(modified)
+    {
+        if (!m_DocName.length)
+        {
             title = qsTrId("app-name");
+            return;
         }
+
+        title = qsTrId("app-name") + " - " + m_DocName + (modified ? " *" : "");
     }
 
     /**
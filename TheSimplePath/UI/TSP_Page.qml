@@ -1,3 +1,4 @@
+import QtQml 2.15
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Dialogs 1.1
@@ -58,6 +59,16 @@ T.Control
     id:         ctPageView
     objectName: "ctPageView"
 
+    /**
+    * Page logging category, the bulk operations are only logged on debug level
+    */
+    LoggingCategory
+    {
+        id: lcPage
+        name: "tsp.qml.page"
+        defaultLogLevel: LoggingCategory.Info
+    }
+
     /**
     * Question message dialog asking to user if the associated links should be deleted with the box
     */
@@ -554,10 +565,7 @@ T.Control
             console.log("Delete selected component - box - " + selectedItem.boxProxy.uid);
 
             // is box connected to something?
-            if (selectedItem.leftConnector.m_Links.length  ||
-                selectedItem.topConnector.m_Links.length   ||
-                selectedItem.rightConnector.m_Links.length ||
-                selectedItem.bottomConnector.m_Links.length)
+            if (ppPageProxy.getLinkCount(selectedItem.boxProxy.uid))
             {
                 console.log("Delete selected component - box - several links attached - confirm with user");
 
@@ -845,7 +853,7 @@ T.Control
                 return undefined;
             }
 
-            console.log("Add box - succeeded - new item - " + item.objectName);
+            console.debug(lcPage, "Add box - succeeded - new item - " + item.objectName);
 
             return item;
         }
@@ -929,7 +937,7 @@ T.Control
                 // emit signal that link was added
                 linkAdded(item);
 
-                console.log("Add link - succeeded - new item - " + item.objectName);
+                console.debug(lcPage, "Add link - succeeded - new item - " + item.objectName);
             }
 
             return item;
@@ -993,28 +1001,8 @@ T.Control
         if (!box)
             return;
 
-        // do delete attached links?
-        if (doDelAttachedLinks)
-        {
-            // delete left links
-            for (let i = box.leftConnector.m_Links.length - 1; i >= 0; --i)
-                deleteLink(box.leftConnector.m_Links[i]);
-
-            // delete top links
-            for (let i = box.topConnector.m_Links.length - 1; i >= 0; --i)
-                deleteLink(box.topConnector.m_Links[i]);
-
-            // delete right links
-            for (let i = box.rightConnector.m_Links.length - 1; i >= 0; --i)
-                deleteLink(box.rightConnector.m_Links[i]);
-
-            // delete bottom links
-            for (let i = box.bottomConnector.m_Links.length - 1; i >= 0; --i)
-                deleteLink(box.bottomConnector.m_Links[i]);
-        }
-
-        // delete box
-        ppPageProxy.onDeleteBox(box.boxProxy.uid);
+        // delete box, the attached links are found and deleted from the page link graph
+        ppPageProxy.onDeleteBox(box.boxProxy.uid, doDelAttachedLinks);
     }
 
     /**
@@ -1026,14 +1014,7 @@ T.Control
         if (!link)
             return;
 
-        // unbind link from start box
-        if (link.m_From)
-            link.unbindLinkFromBox(link.m_From.m_Box);
-
-        // unbind link from end box
-        if (link.m_To)
-            link.unbindLinkFromBox(link.m_To.m_Box);
-
+        // delete link, it is also detached from its boxes in the page link graph
         ppPageProxy.onDeleteLink(link.linkProxy.uid);
     }
 
@@ -1050,7 +1031,7 @@ T.Control
         if (!component)
             return;
 
-        console.log("Remove component - uid - " + uid);
+        console.debug(lcPage, "Remove component - uid - " + uid);
 
         let componentName;
         let index = -1;
@@ -1099,8 +1080,8 @@ T.Control
 
         // log deleted component
         if (componentName && componentName.length)
-            console.log("Remove component - item was removed - item name - " + componentName);
+            console.debug(lcPage, "Remove component - item was removed - item name - " + componentName);
 
-        console.log("Remove component - succeeded");
+        console.debug(lcPage, "Remove component - succeeded");
     }
 }
@@ -26,13 +26,16 @@
  * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                   *
  ****************************************************************************/
 
+// std
+#include <cstring>
+
 // main classes
 #include "TSP_GlobalSettings.h"
 #include "TSP_Application.h"
 
 // common classes
-#include "Common\TSP_StdFileBuffer.h"
 #include "Common\TSP_Logger.h"
+#include "Common\TSP_StdFileBuffer.h"
 
 // qt classes
 #ifdef _DEBUG
@@ -55,9 +58,60 @@
 
 // todo FIXME -cFeature -oJean: To generate a documentation from the source code, see: https://doc.qt.io/qt-5/01-qdoc-manual.html
 
+//---------------------------------------------------------------------------
+/**
+* Decodes a binary log file, the decoded log is written next to it, in a .txt file
+*@param fileName - binary log file name
+*@return success or error code
+*/
+int DecodeLog(const std::wstring& fileName)
+{
+    // the log file may be damaged or crafted, so decoding it should never abort the application
+    try
+    {
+        std::wstring log;
+
+        if (!TSP_Logger::Decode(fileName, log))
+            return -1;
+
+        TSP_StdFileBuffer file;
+
+        if (!file.Open(fileName + L".txt", TSP_FileBuffer::IEMode::IE_M_Write))
+            return -1;
+
+        const std::string data = TSP_StringHelper::Utf16ToUtf8(log);
+
+        if (file.Write(data.data(), data.length()) != data.length())
+            return -1;
+    }
+    catch (...)
+    {
+        return -1;
+    }
+
+    return 0;
+}
 //---------------------------------------------------------------------------
 int main(int argc, char *argv[])
 {
+    bool binaryLog = false;
+
+    // parse the command line. The -decodelog <file> option decodes a binary log file and exits, the
+    // -binarylog option writes the log in binary mode, which should be decoded offline
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "-decodelog"))
+        {
+            if (i + 1 >= argc)
+                return -1;
+
+            return DecodeLog(QString::fromLocal8Bit(argv[i + 1]).toStdWString());
+        }
+        else
+        if (!std::strcmp(argv[i], "-binarylog"))
+            binaryLog = true;
+    }
+
     // initialize memory leaks detection structures
     #ifdef LOG_MEMORY_LEAKS
         if (!SUCCEEDED(::CoInitialize(nullptr)))
@@ -73,12 +127,31 @@ int main(int argc, char *argv[])
 
     try
     {
+        QString logDir = "Logs";
+
+        // check if log dir exists, creates one close to the application executable file if not
+        if (!QDir(logDir).exists())
+        {
+            QDir().mkdir(logDir);
+
+            // should exists now
+            if (!QDir(logDir).exists())
+                return -1;
+        }
+
+        const TSP_Logger::IEFileFormat fileFormat = binaryLog ? TSP_Logger::IEFileFormat::IE_FF_Binary :
+                                                                TSP_Logger::IEFileFormat::IE_FF_Text;
+
+        // build the log file name
+        const std::wstring fileName = logDir.toStdWString() + L"\\" +
+                TSP_Logger::Instance()->GetFileName(TSP_GlobalSettings::m_AppName, binaryLog ? L".tsplog" : L".txt");
+
         TSP_Logger::IHeader header;
         header.m_Name    = TSP_GlobalSettings::m_AppName;
         header.m_Version = TSP_GlobalSettings::m_AppVersion;
 
-        // open the logger
-        TSP_Logger::Instance()->Open(header);
+        // open the logger, the messages are written to the log file while the application runs
+        TSP_Logger::Instance()->Open(header, fileName, fileFormat);
     }
     catch (...)
     {
@@ -100,31 +173,8 @@ int main(int argc, char *argv[])
 
     try
     {
-        // close the logger
+        // close the logger, and write its last messages
         TSP_Logger::Instance()->Close();
-
-        QString logDir = "Logs";
-
-        // check if log dir exists, creates one close to the application executable file if not
-        if (!QDir(logDir).exists())
-        {
-            QDir().mkdir(logDir);
-
-            // should exists now
-            if (!QDir(logDir).exists())
-                return -1;
-        }
-
-        // build the log file name
-        const std::wstring fileName = logDir.toStdWString() + L"\\" + TSP_Logger::Instance()->GetFileName(TSP_GlobalSettings::m_AppName);
-
-        // open a file buffer to write the log
-        auto pFileBuffer = std::make_unique<TSP_StdFileBuffer>();
-        pFileBuffer->Open(fileName, TSP_FileBuffer::IEMode::IE_M_Write);
-
-        // write the log to file
-        const std::string log = TSP_StringHelper::Utf16ToUtf8(TSP_Logger::Instance()->Get());
-        pFileBuffer->Write(log.c_str(), log.length());
     }
     catch (...)
     {